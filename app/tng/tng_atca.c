@@ -78,6 +78,11 @@ const atcacert_def_t* tng_map_get_device_cert_def(int index)
 }
 
 ATCA_STATUS tng_get_device_cert_def(const atcacert_def_t **cert_def)
+{
+    return tng_get_device_cert_def_ext(atcab_get_device(), cert_def);
+}
+
+ATCA_STATUS tng_get_device_cert_def_ext(ATCADevice device, const atcacert_def_t **cert_def)
 {
     ATCA_STATUS status;
     char otpcode[32];
@@ -88,7 +93,7 @@ ATCA_STATUS tng_get_device_cert_def(const atcacert_def_t **cert_def)
         return ATCA_BAD_PARAM;
     }
 
-    status = atcab_read_zone(ATCA_ZONE_OTP, 0, 0, 0, (uint8_t*)otpcode, 32);
+    status = atcab_read_zone_ext(device, ATCA_ZONE_OTP, 0, 0, 0, (uint8_t*)otpcode, 32);
     if (ATCA_SUCCESS == status)
     {
         for (i = 0; i < g_tng_cert_def_cnt; i++)
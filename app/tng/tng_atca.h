@@ -60,6 +60,15 @@ const atcacert_def_t* tng_map_get_device_cert_def(int index);
 
 ATCA_STATUS tng_get_device_cert_def(const atcacert_def_t **cert_def);
 
+/** \brief Get the TNG device certificate definition of a specific device.
+ *
+ * \param[in]  device    Device context to identify.
+ * \param[out] cert_def  TNG device certificate defnition is returned here.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS tng_get_device_cert_def_ext(ATCADevice device, const atcacert_def_t **cert_def);
+
 /** \brief Uses GenKey command to calculate the public key from the primary
  *         device public key.
  *
@@ -31,6 +31,10 @@
 #include "tngtls_cert_def_1_signer.h"
 #include "tng_root_cert.h"
 
+#if ATCA_CA_SUPPORT
+#define TNG_ATCACERT_CHAIN_LOCS_MAX     (16)
+#endif
+
 int tng_atcacert_max_device_cert_size(size_t* max_cert_size)
 {
     int ret = ATCACERT_E_WRONG_CERT_DEF;
@@ -247,3 +251,194 @@ int tng_atcacert_root_public_key(uint8_t* public_key)
 
     return ATCACERT_E_SUCCESS;
 }
+
+#if ATCA_CA_SUPPORT
+/** \brief Build a certificate from device data that has already been read */
+static int tng_atcacert_build_cert(const atcacert_def_t*        cert_def,
+                                   const uint8_t*               ca_public_key,
+                                   const atcacert_device_loc_t* device_locs,
+                                   const uint8_t* const*        device_data,
+                                   size_t                       device_locs_count,
+                                   uint8_t*                     cert,
+                                   size_t*                      cert_size)
+{
+    atcacert_build_state_t build_state;
+    int ret;
+    size_t i;
+
+    ret = atcacert_cert_build_start(&build_state, cert_def, cert, cert_size, ca_public_key);
+    for (i = 0; i < device_locs_count && ATCACERT_E_SUCCESS == ret; i++)
+    {
+        ret = atcacert_cert_build_process(&build_state, &device_locs[i], device_data[i]);
+    }
+    if (ATCACERT_E_SUCCESS == ret)
+    {
+        ret = atcacert_cert_build_finish(&build_state);
+    }
+
+    return ret;
+}
+
+/** \brief Read every device location of the signer and device certificates.
+ *         The locations of both certificates are planned together so anything
+ *         they share, such as the signer public key, is read once.
+ */
+static int tng_atcacert_read_chain_data(ATCADevice             device,
+                                        const atcacert_def_t*  cert_def,
+                                        atcacert_device_loc_t* device_locs,
+                                        const uint8_t**        device_data,
+                                        size_t*                device_locs_count,
+                                        uint8_t*               data,
+                                        size_t                 data_max)
+{
+    calib_read_range_t ranges[TNG_ATCACERT_CHAIN_LOCS_MAX];
+    uint8_t public_key[ATCA_PUB_KEY_SIZE];
+    size_t range_count = 0;
+    size_t data_size = 0;
+    size_t zone_size;
+    int ret;
+    size_t i;
+
+    *device_locs_count = 0;
+    ret = atcacert_get_device_locs(cert_def->ca_cert_def, device_locs, device_locs_count, TNG_ATCACERT_CHAIN_LOCS_MAX, ATCA_BLOCK_SIZE);
+    if (ATCACERT_E_SUCCESS == ret)
+    {
+        ret = atcacert_get_device_locs(cert_def, device_locs, device_locs_count, TNG_ATCACERT_CHAIN_LOCS_MAX, ATCA_BLOCK_SIZE);
+    }
+    if (ATCACERT_E_SUCCESS != ret)
+    {
+        return ret;
+    }
+
+    for (i = 0; i < *device_locs_count; i++)
+    {
+        atcacert_device_loc_t* loc = &device_locs[i];
+
+        if (DEVZONE_DATA == loc->zone && loc->is_genkey)
+        {
+            if (loc->offset + loc->count > ATCA_PUB_KEY_SIZE)
+            {
+                return ATCACERT_E_BAD_PARAMS;
+            }
+        }
+        else
+        {
+            /* Locations are rounded to whole blocks which can run past the end of a slot */
+            if (ATCA_SUCCESS != (ret = calib_get_zone_size(device, loc->zone, loc->slot, &zone_size)))
+            {
+                return ret;
+            }
+            if (loc->offset + loc->count > zone_size)
+            {
+                if (loc->offset > zone_size)
+                {
+                    return ATCACERT_E_BAD_PARAMS;
+                }
+                loc->count = (uint16_t)(zone_size - loc->offset);
+            }
+
+            ranges[range_count].zone = loc->zone;
+            ranges[range_count].slot = loc->slot;
+            ranges[range_count].offset = loc->offset;
+            ranges[range_count].length = loc->count;
+            ranges[range_count].data = &data[data_size];
+            range_count++;
+        }
+
+        if (data_size + loc->count > data_max)
+        {
+            return ATCACERT_E_BUFFER_TOO_SMALL;
+        }
+        device_data[i] = &data[data_size];
+        data_size += loc->count;
+    }
+
+    ret = calib_read_ranges(device, ranges, range_count);
+    for (i = 0; i < *device_locs_count && ATCA_SUCCESS == ret; i++)
+    {
+        if (DEVZONE_DATA == device_locs[i].zone && device_locs[i].is_genkey)
+        {
+            if (ATCA_SUCCESS == (ret = calib_get_pubkey(device, device_locs[i].slot, public_key)))
+            {
+                memcpy(&data[device_data[i] - data], &public_key[device_locs[i].offset], device_locs[i].count);
+            }
+        }
+    }
+
+    return ret;
+}
+
+int tng_atcacert_read_chain(uint8_t* root_cert, size_t* root_cert_size,
+                            uint8_t* signer_cert, size_t* signer_cert_size,
+                            uint8_t* device_cert, size_t* device_cert_size)
+{
+    static uint8_t data[TNG_ATCACERT_CHAIN_SCRATCH_SIZE];
+
+    return tng_atcacert_read_chain_ext(atcab_get_device(), root_cert, root_cert_size, signer_cert, signer_cert_size,
+                                       device_cert, device_cert_size, data, sizeof(data));
+}
+
+int tng_atcacert_read_chain_ext(ATCADevice device,
+                                uint8_t* root_cert, size_t* root_cert_size,
+                                uint8_t* signer_cert, size_t* signer_cert_size,
+                                uint8_t* device_cert, size_t* device_cert_size,
+                                uint8_t* scratch, size_t scratch_size)
+{
+    atcacert_device_loc_t device_locs[TNG_ATCACERT_CHAIN_LOCS_MAX];
+    const uint8_t* device_data[TNG_ATCACERT_CHAIN_LOCS_MAX];
+    uint8_t ca_public_key[ATCA_PUB_KEY_SIZE];
+    const atcacert_def_t* cert_def = NULL;
+    size_t device_locs_count = 0;
+    int awake_status;
+    int ret;
+
+    if (device == NULL || signer_cert == NULL || signer_cert_size == NULL || device_cert == NULL || device_cert_size == NULL
+        || scratch == NULL)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    if (root_cert != NULL)
+    {
+        if (ATCACERT_E_SUCCESS != (ret = tng_atcacert_root_cert(root_cert, root_cert_size)))
+        {
+            return ret;
+        }
+    }
+
+    /* Every read for the chain in one awake window */
+    if (ATCA_SUCCESS != (ret = calib_keep_awake_begin(device)))
+    {
+        return ret;
+    }
+    if (ATCA_SUCCESS == (ret = tng_get_device_cert_def_ext(device, &cert_def)))
+    {
+        ret = tng_atcacert_read_chain_data(device, cert_def, device_locs, device_data, &device_locs_count,
+                                           scratch, scratch_size);
+    }
+    awake_status = calib_keep_awake_end(device);
+    if (ATCA_SUCCESS == ret)
+    {
+        ret = awake_status;
+    }
+    if (ATCA_SUCCESS != ret)
+    {
+        return ret;
+    }
+
+    /* The signer is signed by the root and the device by the signer */
+    ret = tng_atcacert_build_cert(cert_def->ca_cert_def, &g_cryptoauth_root_ca_002_cert[CRYPTOAUTH_ROOT_CA_002_PUBLIC_KEY_OFFSET],
+                                  device_locs, device_data, device_locs_count, signer_cert, signer_cert_size);
+    if (ATCACERT_E_SUCCESS == ret)
+    {
+        ret = atcacert_get_subj_public_key(cert_def->ca_cert_def, signer_cert, *signer_cert_size, ca_public_key);
+    }
+    if (ATCACERT_E_SUCCESS == ret)
+    {
+        ret = tng_atcacert_build_cert(cert_def, ca_public_key, device_locs, device_data, device_locs_count,
+                                      device_cert, device_cert_size);
+    }
+
+    return ret;
+}
+#endif
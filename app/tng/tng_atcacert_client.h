@@ -39,6 +39,10 @@ extern "C" {
  * @{
  */
 
+/** Scratch space in bytes tng_atcacert_read_chain_ext() needs for the device
+ *  data of the TNG and TFLEX chains once rounded to blocks */
+#define TNG_ATCACERT_CHAIN_SCRATCH_SIZE (512)
+
 /** \brief Return the maximum possible certificate size in bytes for a TNG
  *         device certificate. Certificate can be variable size, so this
  *         gives an appropriate buffer size when reading the certificate.
@@ -146,6 +150,61 @@ int tng_atcacert_root_cert(uint8_t* cert, size_t* cert_size);
  */
 int tng_atcacert_root_public_key(uint8_t* public_key);
 
+/**
+ * \brief Reads the whole certificate chain of a TNG device.
+ *
+ * The device locations of the signer and device certificates are planned
+ * together, every location is read once with the device kept awake for all of
+ * the reads and both certificates are then built from the data. This is much
+ * quicker than tng_atcacert_read_signer_cert() followed by
+ * tng_atcacert_read_device_cert().
+ *
+ * \param[out]   root_cert         Buffer to receive the root certificate (DER
+ *                                 format). Set to NULL to skip it.
+ * \param[in,out] root_cert_size    As input, the size of the root_cert buffer.
+ *                                 As output, the size of the root certificate.
+ * \param[out]   signer_cert       Buffer to receive the signer certificate.
+ * \param[in,out] signer_cert_size  As input, the size of the signer_cert buffer.
+ *                                 As output, the size of the signer certificate.
+ * \param[out]   device_cert       Buffer to receive the device certificate.
+ * \param[in,out] device_cert_size  As input, the size of the device_cert buffer.
+ *                                 As output, the size of the device certificate.
+ *
+ * This uses the global device and a static read buffer so only one thread may
+ * call it at a time. Use tng_atcacert_read_chain_ext() to read from several
+ * devices concurrently.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int tng_atcacert_read_chain(uint8_t* root_cert, size_t* root_cert_size,
+                            uint8_t* signer_cert, size_t* signer_cert_size,
+                            uint8_t* device_cert, size_t* device_cert_size);
+
+/**
+ * \brief Reads the whole certificate chain of a specific TNG device.
+ *
+ * All state lives in the arguments so threads may read the chains of
+ * different devices at the same time.
+ *
+ * \param[in]    device            Device context to read the chain from.
+ * \param[out]   root_cert         Root certificate, see tng_atcacert_read_chain().
+ * \param[in,out] root_cert_size    Size of the root certificate.
+ * \param[out]   signer_cert       Signer certificate, see tng_atcacert_read_chain().
+ * \param[in,out] signer_cert_size  Size of the signer certificate.
+ * \param[out]   device_cert       Device certificate, see tng_atcacert_read_chain().
+ * \param[in,out] device_cert_size  Size of the device certificate.
+ * \param[in]    scratch           Buffer used to hold the data read from the device.
+ * \param[in]    scratch_size      Size of the scratch buffer in bytes.
+ *                                 TNG_ATCACERT_CHAIN_SCRATCH_SIZE always does.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int tng_atcacert_read_chain_ext(ATCADevice device,
+                                uint8_t* root_cert, size_t* root_cert_size,
+                                uint8_t* signer_cert, size_t* signer_cert_size,
+                                uint8_t* device_cert, size_t* device_cert_size,
+                                uint8_t* scratch, size_t scratch_size);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -331,30 +331,108 @@ ATCA_STATUS atcab_sleep(void)
     return status;
 }
 
+/** \brief Starts a keep-awake session in which the device is left awake
+ *         between commands rather than idled after each one. The device is
+ *         idled and woken again when needed to stay clear of the watchdog and
+ *         once the session ends with atcab_keep_awake_end_ext.
+ *  \param[in] device  Device context pointer
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_keep_awake_begin_ext(ATCADevice device)
+{
+    ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
+
+    if (atcab_is_ca_device(dev_type))
+    {
+#if ATCA_CA_SUPPORT
+        status = calib_keep_awake_begin(device);
+#endif
+    }
+    else if (atcab_is_ta_device(dev_type))
+    {
+#if ATCA_TA_SUPPORT
+        status = ATCA_SUCCESS;
+#endif
+    }
+    else
+    {
+        status = ATCA_NOT_INITIALIZED;
+    }
+
+    return status;
+}
+
+/** \brief Starts a keep-awake session on the default device
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_keep_awake_begin(void)
+{
+    return atcab_keep_awake_begin_ext(_gDevice);
+}
+
+/** \brief Ends a keep-awake session started with atcab_keep_awake_begin_ext
+ *  \param[in] device  Device context pointer
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_keep_awake_end_ext(ATCADevice device)
+{
+    ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
+
+    if (atcab_is_ca_device(dev_type))
+    {
+#if ATCA_CA_SUPPORT
+        status = calib_keep_awake_end(device);
+#endif
+    }
+    else if (atcab_is_ta_device(dev_type))
+    {
+#if ATCA_TA_SUPPORT
+        status = ATCA_SUCCESS;
+#endif
+    }
+    else
+    {
+        status = ATCA_NOT_INITIALIZED;
+    }
+
+    return status;
+}
+
+/** \brief Ends a keep-awake session on the default device
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_keep_awake_end(void)
+{
+    return atcab_keep_awake_end_ext(_gDevice);
+}
+
 /** \brief Gets the size of the specified zone in bytes.
  *
- * \param[in]  zone  Zone to get size information from. Config(0), OTP(1), or
- *                   Data(2) which requires a slot.
- * \param[in]  slot  If zone is Data(2), the slot to query for size.
- * \param[out] size  Zone size is returned here.
+ * \param[in]  device  Device context pointer
+ * \param[in]  zone    Zone to get size information from. Config(0), OTP(1), or
+ *                     Data(2) which requires a slot.
+ * \param[in]  slot    If zone is Data(2), the slot to query for size.
+ * \param[out] size    Zone size is returned here.
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_get_zone_size(uint8_t zone, uint16_t slot, size_t* size)
+ATCA_STATUS atcab_get_zone_size_ext(ATCADevice device, uint8_t zone, uint16_t slot, size_t* size)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_get_zone_size(_gDevice, zone, slot,  size);
+        status = calib_get_zone_size(device, zone, slot,  size);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_get_zone_size(_gDevice, zone, slot, size);
+        status = talib_get_zone_size(device, zone, slot, size);
 #endif
     }
     else
@@ -364,6 +442,20 @@ ATCA_STATUS atcab_get_zone_size(uint8_t zone, uint16_t slot, size_t* size)
     return status;
 }
 
+/** \brief Gets the size of the specified zone in bytes.
+ *
+ * \param[in]  zone  Zone to get size information from. Config(0), OTP(1), or
+ *                   Data(2) which requires a slot.
+ * \param[in]  slot  If zone is Data(2), the slot to query for size.
+ * \param[out] size  Zone size is returned here.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_get_zone_size(uint8_t zone, uint16_t slot, size_t* size)
+{
+    return atcab_get_zone_size_ext(_gDevice, zone, slot, size);
+}
+
 /* AES commands */
 /** \brief Compute the AES-128 encrypt, decrypt, or GFM calculation.
  *  \param[in]  mode     The mode for the AES command.
@@ -533,6 +625,7 @@ ATCA_STATUS atcab_aes_gfm(const uint8_t* h, const uint8_t* input, uint8_t* outpu
 /** \brief Initialize context for AES GCM operation with an existing IV, which
  *         is common when starting a decrypt operation.
  *
+ * \param[in]  device  Device context pointer
  * \param[in] ctx           AES GCM context to be initialized.
  * \param[in] key_id        Key location. Can either be a slot number or
  *                          ATCA_TEMPKEY_KEYID for TempKey.
@@ -543,15 +636,15 @@ ATCA_STATUS atcab_aes_gfm(const uint8_t* h, const uint8_t* input, uint8_t* outpu
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_aes_gcm_init(atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, const uint8_t* iv, size_t iv_size)
+ATCA_STATUS atcab_aes_gcm_init_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, const uint8_t* iv, size_t iv_size)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_aes_gcm_init(_gDevice, ctx, key_id, key_block, iv, iv_size);
+        status = calib_aes_gcm_init(device, ctx, key_id, key_block, iv, iv_size);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -565,6 +658,24 @@ ATCA_STATUS atcab_aes_gcm_init(atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t
     return status;
 }
 
+/** \brief Initialize context for AES GCM operation with an existing IV, which
+ *         is common when starting a decrypt operation.
+ *
+ * \param[in] ctx           AES GCM context to be initialized.
+ * \param[in] key_id        Key location. Can either be a slot number or
+ *                          ATCA_TEMPKEY_KEYID for TempKey.
+ * \param[in] key_block     Index of the 16-byte block to use within the key
+ *                          location for the actual key.
+ * \param[in] iv            Initialization vector.
+ * \param[in] iv_size       Size of IV in bytes. Standard is 12 bytes.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_aes_gcm_init(atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, const uint8_t* iv, size_t iv_size)
+{
+    return atcab_aes_gcm_init_ext(_gDevice, ctx, key_id, key_block, iv, iv_size);
+}
+
 /** \brief Initialize context for AES GCM operation with a IV composed of a
  *         random and optional fixed(free) field, which is common when
  *         starting an encrypt operation.
@@ -616,21 +727,22 @@ ATCA_STATUS atcab_aes_gcm_init_rand(atca_aes_gcm_ctx_t* ctx, uint16_t key_id, ui
  * function. When there is AAD to include, this should be called before
  * atcab_aes_gcm_encrypt_update() or atcab_aes_gcm_decrypt_update().
  *
+ * \param[in]  device  Device context pointer
  * \param[in] ctx       AES GCM context
  * \param[in] aad       Additional authenticated data to be added
  * \param[in] aad_size  Size of aad in bytes
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_aes_gcm_aad_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* aad, uint32_t aad_size)
+ATCA_STATUS atcab_aes_gcm_aad_update_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* aad, uint32_t aad_size)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_aes_gcm_aad_update(_gDevice, ctx, aad, aad_size);
+        status = calib_aes_gcm_aad_update(device, ctx, aad, aad_size);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -644,10 +756,30 @@ ATCA_STATUS atcab_aes_gcm_aad_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* aad
     return status;
 }
 
+/** \brief Process Additional Authenticated Data (AAD) using GCM mode and a
+ *         key within the ATECC608 device.
+ *
+ * This can be called multiple times. atcab_aes_gcm_init() or
+ * atcab_aes_gcm_init_rand() should be called before the first use of this
+ * function. When there is AAD to include, this should be called before
+ * atcab_aes_gcm_encrypt_update() or atcab_aes_gcm_decrypt_update().
+ *
+ * \param[in] ctx       AES GCM context
+ * \param[in] aad       Additional authenticated data to be added
+ * \param[in] aad_size  Size of aad in bytes
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_aes_gcm_aad_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* aad, uint32_t aad_size)
+{
+    return atcab_aes_gcm_aad_update_ext(_gDevice, ctx, aad, aad_size);
+}
+
 /** \brief Encrypt data using GCM mode and a key within the ATECC608 device.
  *         atcab_aes_gcm_init() or atcab_aes_gcm_init_rand() should be called
  *         before the first use of this function.
  *
+ * \param[in]  device  Device context pointer
  * \param[in]  ctx             AES GCM context structure.
  * \param[in]  plaintext       Plaintext to be encrypted (16 bytes).
  * \param[in]  plaintext_size  Size of plaintext in bytes.
@@ -655,15 +787,15 @@ ATCA_STATUS atcab_aes_gcm_aad_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* aad
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_aes_gcm_encrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* plaintext, uint32_t plaintext_size, uint8_t* ciphertext)
+ATCA_STATUS atcab_aes_gcm_encrypt_update_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* plaintext, uint32_t plaintext_size, uint8_t* ciphertext)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_aes_gcm_encrypt_update(_gDevice, ctx, plaintext, plaintext_size, ciphertext);
+        status = calib_aes_gcm_encrypt_update(device, ctx, plaintext, plaintext_size, ciphertext);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -677,23 +809,40 @@ ATCA_STATUS atcab_aes_gcm_encrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t*
     return status;
 }
 
+/** \brief Encrypt data using GCM mode and a key within the ATECC608 device.
+ *         atcab_aes_gcm_init() or atcab_aes_gcm_init_rand() should be called
+ *         before the first use of this function.
+ *
+ * \param[in]  ctx             AES GCM context structure.
+ * \param[in]  plaintext       Plaintext to be encrypted (16 bytes).
+ * \param[in]  plaintext_size  Size of plaintext in bytes.
+ * \param[out] ciphertext      Encrypted data is returned here.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_aes_gcm_encrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* plaintext, uint32_t plaintext_size, uint8_t* ciphertext)
+{
+    return atcab_aes_gcm_encrypt_update_ext(_gDevice, ctx, plaintext, plaintext_size, ciphertext);
+}
+
 /** \brief Complete a GCM encrypt operation returning the authentication tag.
  *
+ * \param[in]  device  Device context pointer
  * \param[in]  ctx       AES GCM context structure.
  * \param[out] tag       Authentication tag is returned here.
  * \param[in]  tag_size  Tag size in bytes (12 to 16 bytes).
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_aes_gcm_encrypt_finish(atca_aes_gcm_ctx_t* ctx, uint8_t* tag, size_t tag_size)
+ATCA_STATUS atcab_aes_gcm_encrypt_finish_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, uint8_t* tag, size_t tag_size)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_aes_gcm_encrypt_finish(_gDevice, ctx, tag, tag_size);
+        status = calib_aes_gcm_encrypt_finish(device, ctx, tag, tag_size);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -707,10 +856,24 @@ ATCA_STATUS atcab_aes_gcm_encrypt_finish(atca_aes_gcm_ctx_t* ctx, uint8_t* tag,
     return status;
 }
 
+/** \brief Complete a GCM encrypt operation returning the authentication tag.
+ *
+ * \param[in]  ctx       AES GCM context structure.
+ * \param[out] tag       Authentication tag is returned here.
+ * \param[in]  tag_size  Tag size in bytes (12 to 16 bytes).
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_aes_gcm_encrypt_finish(atca_aes_gcm_ctx_t* ctx, uint8_t* tag, size_t tag_size)
+{
+    return atcab_aes_gcm_encrypt_finish_ext(_gDevice, ctx, tag, tag_size);
+}
+
 /** \brief Decrypt data using GCM mode and a key within the ATECC608 device.
  *         atcab_aes_gcm_init() or atcab_aes_gcm_init_rand() should be called
  *         before the first use of this function.
  *
+ * \param[in]  device  Device context pointer
  * \param[in]  ctx              AES GCM context structure.
  * \param[in]  ciphertext       Ciphertext to be decrypted.
  * \param[in]  ciphertext_size  Size of ciphertext in bytes.
@@ -718,15 +881,15 @@ ATCA_STATUS atcab_aes_gcm_encrypt_finish(atca_aes_gcm_ctx_t* ctx, uint8_t* tag,
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_aes_gcm_decrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* ciphertext, uint32_t ciphertext_size, uint8_t* plaintext)
+ATCA_STATUS atcab_aes_gcm_decrypt_update_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* ciphertext, uint32_t ciphertext_size, uint8_t* plaintext)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_aes_gcm_decrypt_update(_gDevice, ctx, ciphertext, ciphertext_size, plaintext);
+        status = calib_aes_gcm_decrypt_update(device, ctx, ciphertext, ciphertext_size, plaintext);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -740,8 +903,25 @@ ATCA_STATUS atcab_aes_gcm_decrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t*
     return status;
 }
 
+/** \brief Decrypt data using GCM mode and a key within the ATECC608 device.
+ *         atcab_aes_gcm_init() or atcab_aes_gcm_init_rand() should be called
+ *         before the first use of this function.
+ *
+ * \param[in]  ctx              AES GCM context structure.
+ * \param[in]  ciphertext       Ciphertext to be decrypted.
+ * \param[in]  ciphertext_size  Size of ciphertext in bytes.
+ * \param[out] plaintext        Decrypted data is returned here.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_aes_gcm_decrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* ciphertext, uint32_t ciphertext_size, uint8_t* plaintext)
+{
+    return atcab_aes_gcm_decrypt_update_ext(_gDevice, ctx, ciphertext, ciphertext_size, plaintext);
+}
+
 /** \brief Complete a GCM decrypt operation verifying the authentication tag.
  *
+ * \param[in]  device  Device context pointer
  * \param[in]  ctx          AES GCM context structure.
  * \param[in]  tag          Expected authentication tag.
  * \param[in]  tag_size     Size of tag in bytes (12 to 16 bytes).
@@ -749,15 +929,15 @@ ATCA_STATUS atcab_aes_gcm_decrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t*
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_aes_gcm_decrypt_finish(atca_aes_gcm_ctx_t* ctx, const uint8_t* tag, size_t tag_size, bool* is_verified)
+ATCA_STATUS atcab_aes_gcm_decrypt_finish_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* tag, size_t tag_size, bool* is_verified)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_aes_gcm_decrypt_finish(_gDevice, ctx, tag, tag_size, is_verified);
+        status = calib_aes_gcm_decrypt_finish(device, ctx, tag, tag_size, is_verified);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -771,6 +951,20 @@ ATCA_STATUS atcab_aes_gcm_decrypt_finish(atca_aes_gcm_ctx_t* ctx, const uint8_t*
     return status;
 }
 
+/** \brief Complete a GCM decrypt operation verifying the authentication tag.
+ *
+ * \param[in]  ctx          AES GCM context structure.
+ * \param[in]  tag          Expected authentication tag.
+ * \param[in]  tag_size     Size of tag in bytes (12 to 16 bytes).
+ * \param[out] is_verified  Returns whether or not the tag verified.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_aes_gcm_decrypt_finish(atca_aes_gcm_ctx_t* ctx, const uint8_t* tag, size_t tag_size, bool* is_verified)
+{
+    return atcab_aes_gcm_decrypt_finish_ext(_gDevice, ctx, tag, tag_size, is_verified);
+}
+
 /* CheckMAC command */
 
 /** \brief Compares a MAC response with input values
@@ -1228,6 +1422,7 @@ ATCA_STATUS atcab_genkey_base(uint8_t mode, uint16_t key_id, const uint8_t* othe
 /** \brief Issues GenKey command, which generates a new random private key in
  *          slot/handle and returns the public key.
  *
+ * \param[in]  device  Device context pointer
  * \param[in]  key_id      Slot number where an ECC private key is configured.
  *                         Can also be ATCA_TEMPKEY_KEYID to generate a private
  *                         key in TempKey.
@@ -1238,21 +1433,21 @@ ATCA_STATUS atcab_genkey_base(uint8_t mode, uint16_t key_id, const uint8_t* othe
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_genkey(uint16_t key_id, uint8_t* public_key)
+ATCA_STATUS atcab_genkey_ext(ATCADevice device, uint16_t key_id, uint8_t* public_key)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_genkey(_gDevice, key_id, public_key);
+        status = calib_genkey(device, key_id, public_key);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_genkey_compat(_gDevice, key_id, public_key);
+        status = talib_genkey_compat(device, key_id, public_key);
 #endif
     }
     else
@@ -1262,6 +1457,24 @@ ATCA_STATUS atcab_genkey(uint16_t key_id, uint8_t* public_key)
     return status;
 }
 
+/** \brief Issues GenKey command, which generates a new random private key in
+ *          slot/handle and returns the public key.
+ *
+ * \param[in]  key_id      Slot number where an ECC private key is configured.
+ *                         Can also be ATCA_TEMPKEY_KEYID to generate a private
+ *                         key in TempKey.
+ * \param[out] public_key  Public key will be returned here. Format will be
+ *                         the X and Y integers in big-endian format.
+ *                         64 bytes for P256 curve. Set to NULL if public key
+ *                         isn't required.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_genkey(uint16_t key_id, uint8_t* public_key)
+{
+    return atcab_genkey_ext(_gDevice, key_id, public_key);
+}
+
 /** \brief Uses GenKey command to calculate the public key from an existing
  *          private key in a slot.
  *
@@ -1384,24 +1597,25 @@ ATCA_STATUS atcab_info_base(uint8_t mode, uint16_t param2, uint8_t* out_data)
 }
 
 /** \brief Use the Info command to get the device revision (DevRev).
+ *  \param[in]  device  Device context pointer
  *  \param[out] revision  Device revision is returned here (4 bytes).
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_info(uint8_t* revision)
+ATCA_STATUS atcab_info_ext(ATCADevice device, uint8_t* revision)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_info(_gDevice, revision);
+        status = calib_info(device, revision);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_info_compat(_gDevice, revision);
+        status = talib_info_compat(device, revision);
 #endif
     }
     else
@@ -1411,6 +1625,15 @@ ATCA_STATUS atcab_info(uint8_t* revision)
     return status;
 }
 
+/** \brief Use the Info command to get the device revision (DevRev).
+ *  \param[out] revision  Device revision is returned here (4 bytes).
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_info(uint8_t* revision)
+{
+    return atcab_info_ext(_gDevice, revision);
+}
+
 /** \brief Use the Info command to set the persistent latch state for an
  *          ATECC608 device.
  *
@@ -1555,12 +1778,13 @@ ATCA_STATUS atcab_lock(uint8_t mode, uint16_t summary_crc)
 
 /** \brief Unconditionally (no CRC required) lock the config zone.
  *
+ *  \param[in] device  Device context pointer
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_lock_config_zone(void)
+ATCA_STATUS atcab_lock_config_zone_ext(ATCADevice device)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -1568,19 +1792,19 @@ ATCA_STATUS atcab_lock_config_zone(void)
         if (ECC204 == dev_type)
         {
 #if defined(ATCA_ECC204_SUPPORT)
-            status = calib_ecc204_lock_config_zone(_gDevice);
+            status = calib_ecc204_lock_config_zone(device);
 #endif
         }
         else
         {
-            status = calib_lock_config_zone(_gDevice);
+            status = calib_lock_config_zone(device);
         }
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_lock_config(_gDevice);
+        status = talib_lock_config(device);
 #endif
     }
     else
@@ -1590,6 +1814,15 @@ ATCA_STATUS atcab_lock_config_zone(void)
     return status;
 }
 
+/** \brief Unconditionally (no CRC required) lock the config zone.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_lock_config_zone(void)
+{
+    return atcab_lock_config_zone_ext(_gDevice);
+}
+
 /** \brief Lock the config zone with summary CRC.
  *
  *  The CRC is calculated over the entire config zone contents. 48 bytes for TA100,
@@ -1629,23 +1862,24 @@ ATCA_STATUS atcab_lock_config_zone_crc(uint16_t summary_crc)
  *
  *	ConfigZone must be locked and DataZone must be unlocked for the zone to be successfully locked.
  *
+ *  \param[in] device  Device context pointer
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_lock_data_zone(void)
+ATCA_STATUS atcab_lock_data_zone_ext(ATCADevice device)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_lock_data_zone(_gDevice);
+        status = calib_lock_data_zone(device);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_lock_setup(_gDevice);
+        status = talib_lock_setup(device);
 #endif
     }
     else
@@ -1655,6 +1889,18 @@ ATCA_STATUS atcab_lock_data_zone(void)
     return status;
 }
 
+/** \brief Unconditionally (no CRC required) lock the data zone (slots and OTP).
+ *         for CryptoAuth devices and lock the setup for Trust Anchor device.
+ *
+ *	ConfigZone must be locked and DataZone must be unlocked for the zone to be successfully locked.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_lock_data_zone(void)
+{
+    return atcab_lock_data_zone_ext(_gDevice);
+}
+
 /** \brief Lock the data zone (slots and OTP) with summary CRC.
  *
  *  The CRC is calculated over the concatenated contents of all the slots and
@@ -1693,14 +1939,15 @@ ATCA_STATUS atcab_lock_data_zone_crc(uint16_t summary_crc)
  *         an individual handle in shared data element on an Trust Anchor device
  *         (for Trust Anchor devices).
  *
+ *  \param[in]  device  Device context pointer
  *  \param[in] slot  Slot to be locked in data zone.
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_lock_data_slot(uint16_t slot)
+ATCA_STATUS atcab_lock_data_slot_ext(ATCADevice device, uint16_t slot)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -1708,19 +1955,19 @@ ATCA_STATUS atcab_lock_data_slot(uint16_t slot)
         if (ECC204 == dev_type)
         {
 #if defined(ATCA_ECC204_SUPPORT)
-            status = calib_ecc204_lock_data_slot(_gDevice, slot);
+            status = calib_ecc204_lock_data_slot(device, slot);
 #endif
         }
         else
         {
-            status = calib_lock_data_slot(_gDevice, slot);
+            status = calib_lock_data_slot(device, slot);
         }
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_lock_handle(_gDevice, slot);
+        status = talib_lock_handle(device, slot);
 #endif
     }
     else
@@ -1730,15 +1977,30 @@ ATCA_STATUS atcab_lock_data_slot(uint16_t slot)
     return status;
 }
 
-// MAC command functions
-
-/** \brief Executes MAC command, which computes a SHA-256 digest of a key
- *          stored in the device, a challenge, and other information on the
- *          device.
- *
- *	\param[in]  mode       Controls which fields within the device are used in
- *                         the message
- *	\param[in]  key_id     Key in the CryptoAuth device to use for the MAC
+/** \brief Lock an individual slot in the data zone on an ATECC device. Not
+ *         available for ATSHA devices. Slot must be configured to be slot
+ *         lockable (KeyConfig.Lockable=1) (for cryptoauth devices) or Lock
+ *         an individual handle in shared data element on an Trust Anchor device
+ *         (for Trust Anchor devices).
+ *
+ *  \param[in] slot  Slot to be locked in data zone.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_lock_data_slot(uint16_t slot)
+{
+    return atcab_lock_data_slot_ext(_gDevice, slot);
+}
+
+// MAC command functions
+
+/** \brief Executes MAC command, which computes a SHA-256 digest of a key
+ *          stored in the device, a challenge, and other information on the
+ *          device.
+ *
+ *	\param[in]  mode       Controls which fields within the device are used in
+ *                         the message
+ *	\param[in]  key_id     Key in the CryptoAuth device to use for the MAC
  *	\param[in]  challenge  Challenge message (32 bytes). May be NULL if mode
  *                         indicates a challenge isn't required.
  *	\param[out] digest     MAC response is returned here (32 bytes).
@@ -2073,6 +2335,7 @@ ATCA_STATUS atcab_random(uint8_t* rand_out)
  *   When reading a slot or OTP, data zone must be locked and the slot
  *   configuration must not be secret for a slot to be successfully read.
  *
+ *  \param[in]  device  Device context pointer
  *  \param[in]  zone    Zone to be read from device. Options are
  *                      ATCA_ZONE_CONFIG, ATCA_ZONE_OTP, or ATCA_ZONE_DATA.
  *  \param[in]  slot    Slot number for data zone and ignored for other zones.
@@ -2084,10 +2347,10 @@ ATCA_STATUS atcab_random(uint8_t* rand_out)
  *
  *  returns ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_read_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t* data, uint8_t len)
+ATCA_STATUS atcab_read_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t* data, uint8_t len)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -2095,12 +2358,12 @@ ATCA_STATUS atcab_read_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
         if (ECC204 == dev_type)
         {
 #if defined(ATCA_ECC204_SUPPORT)
-            status = calib_ecc204_read_zone(_gDevice, zone, slot, block, offset, data, len);
+            status = calib_ecc204_read_zone(device, zone, slot, block, offset, data, len);
 #endif
         }
         else
         {
-            status = calib_read_zone(_gDevice, zone, slot, block, offset, data, len);
+            status = calib_read_zone(device, zone, slot, block, offset, data, len);
         }
 #endif
     }
@@ -2115,6 +2378,28 @@ ATCA_STATUS atcab_read_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
     return status;
 }
 
+/** \brief Executes Read command, which reads either 4 or 32 bytes of data from
+ *          a given slot, configuration zone, or the OTP zone.
+ *
+ *   When reading a slot or OTP, data zone must be locked and the slot
+ *   configuration must not be secret for a slot to be successfully read.
+ *
+ *  \param[in]  zone    Zone to be read from device. Options are
+ *                      ATCA_ZONE_CONFIG, ATCA_ZONE_OTP, or ATCA_ZONE_DATA.
+ *  \param[in]  slot    Slot number for data zone and ignored for other zones.
+ *  \param[in]  block   32 byte block index within the zone.
+ *  \param[in]  offset  4 byte work index within the block. Ignored for 32 byte
+ *                      reads.
+ *  \param[out] data    Read data is returned here.
+ *  \param[in]  len     Length of the data to be read. Must be either 4 or 32.
+ *
+ *  returns ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_read_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t* data, uint8_t len)
+{
+    return atcab_read_zone_ext(_gDevice, zone, slot, block, offset, data, len);
+}
+
 /** \brief Executes Read command, which reads the configuration zone to see if
  *          the specified zone is locked.
  *
@@ -2169,13 +2454,14 @@ ATCA_STATUS atcab_is_locked(uint8_t zone, bool* is_locked)
 
 /** \brief This function check whether configuration zone is locked or not
  *
+ *  \param[in]  device  Device context pointer
  *  \param[out] is_locked  Lock state returned here. True if locked.
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_is_config_locked(bool* is_locked)
+ATCA_STATUS atcab_is_config_locked_ext(ATCADevice device, bool* is_locked)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -2183,19 +2469,19 @@ ATCA_STATUS atcab_is_config_locked(bool* is_locked)
         if (ECC204 == dev_type)
         {
 #if defined(ATCA_ECC204_SUPPORT)
-            status = calib_ecc204_is_locked(_gDevice, ATCA_ECC204_ZONE_CONFIG, is_locked);
+            status = calib_ecc204_is_locked(device, ATCA_ECC204_ZONE_CONFIG, is_locked);
 #endif
         }
         else
         {
-            status = calib_is_locked(_gDevice, LOCK_ZONE_CONFIG, is_locked);
+            status = calib_is_locked(device, LOCK_ZONE_CONFIG, is_locked);
         }
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_is_config_locked(_gDevice, is_locked);
+        status = talib_is_config_locked(device, is_locked);
 #endif
     }
     else
@@ -2205,15 +2491,26 @@ ATCA_STATUS atcab_is_config_locked(bool* is_locked)
     return status;
 }
 
+/** \brief This function check whether configuration zone is locked or not
+ *
+ *  \param[out] is_locked  Lock state returned here. True if locked.
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_is_config_locked(bool* is_locked)
+{
+    return atcab_is_config_locked_ext(_gDevice, is_locked);
+}
+
 /** \brief This function check whether data/setup zone is locked or not
  *
+ *  \param[in]  device  Device context pointer
  *  \param[out] is_locked  Lock state returned here. True if locked.
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_is_data_locked(bool* is_locked)
+ATCA_STATUS atcab_is_data_locked_ext(ATCADevice device, bool* is_locked)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -2221,19 +2518,19 @@ ATCA_STATUS atcab_is_data_locked(bool* is_locked)
 #if defined(ATCA_ECC204_SUPPORT)
         if (ECC204 == dev_type)
         {
-            status = calib_ecc204_is_locked(_gDevice, ATCA_ECC204_ZONE_DATA, is_locked);
+            status = calib_ecc204_is_locked(device, ATCA_ECC204_ZONE_DATA, is_locked);
         }
         else
 #endif
         {
-            status = calib_is_locked(_gDevice, LOCK_ZONE_DATA, is_locked);
+            status = calib_is_locked(device, LOCK_ZONE_DATA, is_locked);
         }
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_is_setup_locked(_gDevice, is_locked);
+        status = talib_is_setup_locked(device, is_locked);
 #endif
     }
     else
@@ -2243,27 +2540,38 @@ ATCA_STATUS atcab_is_data_locked(bool* is_locked)
     return status;
 }
 
+/** \brief This function check whether data/setup zone is locked or not
+ *
+ *  \param[out] is_locked  Lock state returned here. True if locked.
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_is_data_locked(bool* is_locked)
+{
+    return atcab_is_data_locked_ext(_gDevice, is_locked);
+}
+
 /** \brief This function check whether slot/handle is locked or not
  *
+ *  \param[in]  device  Device context pointer
  *  \param[in]  slot       Slot to query for locked
  *  \param[out] is_locked  Lock state returned here. True if locked.
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_is_slot_locked(uint16_t slot, bool* is_locked)
+ATCA_STATUS atcab_is_slot_locked_ext(ATCADevice device, uint16_t slot, bool* is_locked)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_is_slot_locked(_gDevice, slot, is_locked);
+        status = calib_is_slot_locked(device, slot, is_locked);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_is_handle_locked(_gDevice, slot, is_locked);
+        status = talib_is_handle_locked(device, slot, is_locked);
 #endif
     }
     else
@@ -2273,6 +2581,17 @@ ATCA_STATUS atcab_is_slot_locked(uint16_t slot, bool* is_locked)
     return status;
 }
 
+/** \brief This function check whether slot/handle is locked or not
+ *
+ *  \param[in]  slot       Slot to query for locked
+ *  \param[out] is_locked  Lock state returned here. True if locked.
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_is_slot_locked(uint16_t slot, bool* is_locked)
+{
+    return atcab_is_slot_locked_ext(_gDevice, slot, is_locked);
+}
+
 
 /** \brief Check to see if the key is a private key or not
  *
@@ -2320,6 +2639,7 @@ ATCA_STATUS atcab_is_private(uint16_t slot, bool* is_private)
  * This function will issue the Read command as many times as is required to
  * read the requested data.
  *
+ *  \param[in]  device  Device context pointer
  *  \param[in]  zone    Zone to read data from. Option are ATCA_ZONE_CONFIG(0),
  *                      ATCA_ZONE_OTP(1), or ATCA_ZONE_DATA(2).
  *  \param[in]  slot    Slot number to read from if zone is ATCA_ZONE_DATA(2).
@@ -2330,10 +2650,10 @@ ATCA_STATUS atcab_is_private(uint16_t slot, bool* is_private)
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset, uint8_t* data, size_t length)
+ATCA_STATUS atcab_read_bytes_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset, uint8_t* data, size_t length)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -2341,19 +2661,19 @@ ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset, ui
         if (ECC204 == dev_type)
         {
 #if defined(ATCA_ECC204_SUPPORT)
-            status = calib_ecc204_read_bytes_zone(_gDevice, zone, slot, offset, data, length);
+            status = calib_ecc204_read_bytes_zone(device, zone, slot, offset, data, length);
 #endif
         }
         else
         {
-            status = calib_read_bytes_zone(_gDevice, zone, slot, offset, data, length);
+            status = calib_read_bytes_zone(device, zone, slot, offset, data, length);
         }
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_read_bytes_zone(_gDevice, zone, slot, offset, data, length);
+        status = talib_read_bytes_zone(device, zone, slot, offset, data, length);
 #endif
     }
     else
@@ -2363,16 +2683,38 @@ ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset, ui
     return status;
 }
 
+/** \brief Used to read an arbitrary number of bytes from any zone configured
+ *          for clear reads.
+ *
+ * This function will issue the Read command as many times as is required to
+ * read the requested data.
+ *
+ *  \param[in]  zone    Zone to read data from. Option are ATCA_ZONE_CONFIG(0),
+ *                      ATCA_ZONE_OTP(1), or ATCA_ZONE_DATA(2).
+ *  \param[in]  slot    Slot number to read from if zone is ATCA_ZONE_DATA(2).
+ *                      Ignored for all other zones.
+ *  \param[in]  offset  Byte offset within the zone to read from.
+ *  \param[out] data    Read data is returned here.
+ *  \param[in]  length  Number of bytes to read starting from the offset.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset, uint8_t* data, size_t length)
+{
+    return atcab_read_bytes_zone_ext(_gDevice, zone, slot, offset, data, length);
+}
+
 /** \brief This function returns serial number of the device.
  *
+ *  \param[in]  device         Device context pointer
  *  \param[out] serial_number  9 byte serial number is returned here.
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
+ATCA_STATUS atcab_read_serial_number_ext(ATCADevice device, uint8_t* serial_number)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -2380,19 +2722,19 @@ ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
         if (ECC204 == dev_type)
         {
 #if defined(ATCA_ECC204_SUPPORT)
-            status = calib_ecc204_read_serial_number(_gDevice, serial_number);
+            status = calib_ecc204_read_serial_number(device, serial_number);
 #endif
         }
         else
         {
-            status = calib_read_serial_number(_gDevice, serial_number);
+            status = calib_read_serial_number(device, serial_number);
         }
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_info_serial_number_compat(_gDevice, serial_number);
+        status = talib_info_serial_number_compat(device, serial_number);
 #endif
     }
     else
@@ -2402,6 +2744,17 @@ ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
     return status;
 }
 
+/** \brief This function returns serial number of the device.
+ *
+ *  \param[out] serial_number  9 byte serial number is returned here.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
+{
+    return atcab_read_serial_number_ext(_gDevice, serial_number);
+}
+
 /** \brief Executes Read command to read an ECC P256 public key from a slot
  *          configured for clear reads.
  *
@@ -2463,6 +2816,7 @@ ATCA_STATUS atcab_read_pubkey(uint16_t slot, uint8_t* public_key)
 /** \brief Executes Read command to read a 64 byte ECDSA P256 signature from a
  *          slot configured for clear reads.
  *
+ *  \param[in]  device  Device context pointer
  *  \param[in]  slot  Slot number to read from. Only slots 8 to 15 are large
  *                    enough for a signature.
  *  \param[out] sig   Signature will be returned here (64 bytes). Format will be
@@ -2470,21 +2824,21 @@ ATCA_STATUS atcab_read_pubkey(uint16_t slot, uint8_t* public_key)
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_read_sig(uint16_t slot, uint8_t* sig)
+ATCA_STATUS atcab_read_sig_ext(ATCADevice device, uint16_t slot, uint8_t* sig)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_read_sig(_gDevice, slot, sig);
+        status = calib_read_sig(device, slot, sig);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_read_sig_compat(_gDevice, slot, sig);
+        status = talib_read_sig_compat(device, slot, sig);
 #endif
     }
     else
@@ -2494,19 +2848,35 @@ ATCA_STATUS atcab_read_sig(uint16_t slot, uint8_t* sig)
     return status;
 }
 
+/** \brief Executes Read command to read a 64 byte ECDSA P256 signature from a
+ *          slot configured for clear reads.
+ *
+ *  \param[in]  slot  Slot number to read from. Only slots 8 to 15 are large
+ *                    enough for a signature.
+ *  \param[out] sig   Signature will be returned here (64 bytes). Format will be
+ *                    the 32 byte R and S big-endian integers concatenated.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_read_sig(uint16_t slot, uint8_t* sig)
+{
+    return atcab_read_sig_ext(_gDevice, slot, sig);
+}
+
 /** \brief Executes Read command to read the complete device configuration
  *          zone.
  *
+ *  \param[in]  device       Device context pointer
  *  \param[out] config_data  Configuration zone data is returned here. 88 bytes
  *                           for ATSHA devices, 128 bytes for ATECC devices and
  *                           48 bytes for Trust Anchor devices.
  *
  *  \returns ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_read_config_zone(uint8_t* config_data)
+ATCA_STATUS atcab_read_config_zone_ext(ATCADevice device, uint8_t* config_data)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -2514,19 +2884,19 @@ ATCA_STATUS atcab_read_config_zone(uint8_t* config_data)
         if (ECC204 == dev_type)
         {
 #if defined(ATCA_ECC204_SUPPORT)
-            status = calib_ecc204_read_config_zone(_gDevice, config_data);
+            status = calib_ecc204_read_config_zone(device, config_data);
 #endif
         }
         else
         {
-            status = calib_read_config_zone(_gDevice, config_data);
+            status = calib_read_config_zone(device, config_data);
         }
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_read_config_zone(_gDevice, config_data);
+        status = talib_read_config_zone(device, config_data);
 #endif
     }
     else
@@ -2536,6 +2906,20 @@ ATCA_STATUS atcab_read_config_zone(uint8_t* config_data)
     return status;
 }
 
+/** \brief Executes Read command to read the complete device configuration
+ *          zone.
+ *
+ *  \param[out] config_data  Configuration zone data is returned here. 88 bytes
+ *                           for ATSHA devices, 128 bytes for ATECC devices and
+ *                           48 bytes for Trust Anchor devices.
+ *
+ *  \returns ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_read_config_zone(uint8_t* config_data)
+{
+    return atcab_read_config_zone_ext(_gDevice, config_data);
+}
+
 /** \brief Compares a specified configuration zone with the configuration zone
  *          currently on the device.
  *
@@ -2792,23 +3176,24 @@ ATCA_STATUS atcab_sha_base(uint8_t mode, uint16_t length, const uint8_t* data_in
 }
 
 /** \brief Executes SHA command to initialize SHA-256 calculation engine
+ *  \param[in] device  Device context pointer
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_sha_start(void)
+ATCA_STATUS atcab_sha_start_ext(ATCADevice device)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_sha_start(_gDevice);
+        status = calib_sha_start(device);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_sha_start(_gDevice);
+        status = talib_sha_start(device);
 #endif
     }
     else
@@ -2818,6 +3203,14 @@ ATCA_STATUS atcab_sha_start(void)
     return status;
 }
 
+/** \brief Executes SHA command to initialize SHA-256 calculation engine
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_sha_start(void)
+{
+    return atcab_sha_start_ext(_gDevice);
+}
+
 /** \brief Executes SHA command to add 64 bytes of message data to the current
  *          context.
  *
@@ -2886,6 +3279,7 @@ ATCA_STATUS atcab_sha_end(uint8_t* digest, uint16_t length, const uint8_t* messa
 /** \brief Executes SHA command to read the SHA-256 context back. Only for
  *          ATECC608 with SHA-256 contexts. HMAC not supported.
  *
+ *  \param[in]  device  Device context pointer
  *  \param[out]   context       Context data is returned here.
  *  \param[in,out] context_size  As input, the size of the context buffer in
  *                              bytes. As output, the size of the returned
@@ -2893,21 +3287,21 @@ ATCA_STATUS atcab_sha_end(uint8_t* digest, uint16_t length, const uint8_t* messa
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_sha_read_context(uint8_t* context, uint16_t* context_size)
+ATCA_STATUS atcab_sha_read_context_ext(ATCADevice device, uint8_t* context, uint16_t* context_size)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_sha_read_context(_gDevice, context, context_size);
+        status = calib_sha_read_context(device, context, context_size);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_sha_read_context(_gDevice, context, context_size);
+        status = talib_sha_read_context(device, context, context_size);
 #endif
     }
     else
@@ -2917,29 +3311,45 @@ ATCA_STATUS atcab_sha_read_context(uint8_t* context, uint16_t* context_size)
     return status;
 }
 
+/** \brief Executes SHA command to read the SHA-256 context back. Only for
+ *          ATECC608 with SHA-256 contexts. HMAC not supported.
+ *
+ *  \param[out]   context       Context data is returned here.
+ *  \param[in,out] context_size  As input, the size of the context buffer in
+ *                              bytes. As output, the size of the returned
+ *                              context data.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_sha_read_context(uint8_t* context, uint16_t* context_size)
+{
+    return atcab_sha_read_context_ext(_gDevice, context, context_size);
+}
+
 /** \brief Executes SHA command to write (restore) a SHA-256 context into the
  *          the device. Only supported for ATECC608 with SHA-256 contexts.
  *
+ *  \param[in]  device  Device context pointer
  *  \param[in] context       Context data to be restored.
  *  \param[in] context_size  Size of the context data in bytes.
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_sha_write_context(const uint8_t* context, uint16_t context_size)
+ATCA_STATUS atcab_sha_write_context_ext(ATCADevice device, const uint8_t* context, uint16_t context_size)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_sha_write_context(_gDevice, context, context_size);
+        status = calib_sha_write_context(device, context, context_size);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_sha_write_context(_gDevice, context, context_size);
+        status = talib_sha_write_context(device, context, context_size);
 #endif
     }
     else
@@ -2949,6 +3359,19 @@ ATCA_STATUS atcab_sha_write_context(const uint8_t* context, uint16_t context_siz
     return status;
 }
 
+/** \brief Executes SHA command to write (restore) a SHA-256 context into the
+ *          the device. Only supported for ATECC608 with SHA-256 contexts.
+ *
+ *  \param[in] context       Context data to be restored.
+ *  \param[in] context_size  Size of the context data in bytes.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_sha_write_context(const uint8_t* context, uint16_t context_size)
+{
+    return atcab_sha_write_context_ext(_gDevice, context, context_size);
+}
+
 /** \brief Use the SHA command to compute a SHA-256 digest.
  *
  * \param[in]  length   Size of message parameter in bytes.
@@ -3013,6 +3436,48 @@ ATCA_STATUS atcab_hw_sha2_256(const uint8_t* data, size_t data_size, uint8_t* di
     return status;
 }
 
+/** \brief Sets where atcab_hw_sha2_256 hashes messages on the given device.
+ *
+ * \param[in] device     Device context pointer
+ * \param[in] policy     Where messages of at least threshold bytes are hashed
+ * \param[in] threshold  Messages shorter than this are hashed by the device
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_sha_set_offload_ext(ATCADevice device, atca_sha_offload_t policy, uint32_t threshold)
+{
+    ATCA_STATUS status = ATCA_UNIMPLEMENTED;
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
+
+    if (atcab_is_ca_device(dev_type))
+    {
+#if ATCA_CA_SUPPORT
+        status = calib_sha_set_offload(device, policy, threshold);
+#endif
+    }
+    else if (atcab_is_ta_device(dev_type))
+    {
+        status = ATCA_UNIMPLEMENTED;
+    }
+    else
+    {
+        status = ATCA_NOT_INITIALIZED;
+    }
+    return status;
+}
+
+/** \brief Sets where atcab_hw_sha2_256 hashes messages on the default device.
+ *
+ * \param[in] policy     Where messages of at least threshold bytes are hashed
+ * \param[in] threshold  Messages shorter than this are hashed by the device
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_sha_set_offload(atca_sha_offload_t policy, uint32_t threshold)
+{
+    return atcab_sha_set_offload_ext(_gDevice, policy, threshold);
+}
+
 /** \brief Initialize a SHA context for performing a hardware SHA-256 operation
  *          on a device. Note that only one SHA operation can be run at a time.
  *
@@ -3045,21 +3510,22 @@ ATCA_STATUS atcab_hw_sha2_256_init(atca_sha256_ctx_t* ctx)
 /** \brief Add message data to a SHA context for performing a hardware SHA-256
  *          operation on a device.
  *
+ * \param[in]  device  Device context pointer
  * \param[in] ctx        SHA256 context
  * \param[in] data       Message data to be added to hash.
  * \param[in] data_size  Size of data in bytes.
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size)
+ATCA_STATUS atcab_hw_sha2_256_update_ext(ATCADevice device, atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_hw_sha2_256_update(_gDevice, ctx, data, data_size);
+        status = calib_hw_sha2_256_update(device, ctx, data, data_size);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -3073,23 +3539,38 @@ ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data
     return status;
 }
 
+/** \brief Add message data to a SHA context for performing a hardware SHA-256
+ *          operation on a device.
+ *
+ * \param[in] ctx        SHA256 context
+ * \param[in] data       Message data to be added to hash.
+ * \param[in] data_size  Size of data in bytes.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size)
+{
+    return atcab_hw_sha2_256_update_ext(_gDevice, ctx, data, data_size);
+}
+
 /** \brief Finish SHA-256 digest for a SHA context for performing a hardware
  *          SHA-256 operation on a device.
  *
+ * \param[in]  device  Device context pointer
  * \param[in]  ctx     SHA256 context
  * \param[out] digest  SHA256 digest is returned here (32 bytes)
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_hw_sha2_256_finish(atca_sha256_ctx_t* ctx, uint8_t* digest)
+ATCA_STATUS atcab_hw_sha2_256_finish_ext(ATCADevice device, atca_sha256_ctx_t* ctx, uint8_t* digest)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_hw_sha2_256_finish(_gDevice, ctx, digest);
+        status = calib_hw_sha2_256_finish(device, ctx, digest);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -3103,22 +3584,36 @@ ATCA_STATUS atcab_hw_sha2_256_finish(atca_sha256_ctx_t* ctx, uint8_t* digest)
     return status;
 }
 
+/** \brief Finish SHA-256 digest for a SHA context for performing a hardware
+ *          SHA-256 operation on a device.
+ *
+ * \param[in]  ctx     SHA256 context
+ * \param[out] digest  SHA256 digest is returned here (32 bytes)
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_hw_sha2_256_finish(atca_sha256_ctx_t* ctx, uint8_t* digest)
+{
+    return atcab_hw_sha2_256_finish_ext(_gDevice, ctx, digest);
+}
+
 /** \brief Executes SHA command to start an HMAC/SHA-256 operation
  *
+ * \param[in] device    Device context pointer
  * \param[in] ctx       HMAC/SHA-256 context
  * \param[in] key_slot  Slot key id to use for the HMAC calculation
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_sha_hmac_init(atca_hmac_sha256_ctx_t* ctx, uint16_t key_slot)
+ATCA_STATUS atcab_sha_hmac_init_ext(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, uint16_t key_slot)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_sha_hmac_init(_gDevice, ctx, key_slot);
+        status = calib_sha_hmac_init(device, ctx, key_slot);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -3132,24 +3627,37 @@ ATCA_STATUS atcab_sha_hmac_init(atca_hmac_sha256_ctx_t* ctx, uint16_t key_slot)
     return status;
 }
 
+/** \brief Executes SHA command to start an HMAC/SHA-256 operation
+ *
+ * \param[in] ctx       HMAC/SHA-256 context
+ * \param[in] key_slot  Slot key id to use for the HMAC calculation
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_sha_hmac_init(atca_hmac_sha256_ctx_t* ctx, uint16_t key_slot)
+{
+    return atcab_sha_hmac_init_ext(_gDevice, ctx, key_slot);
+}
+
 /** \brief Executes SHA command to add an arbitrary amount of message data to
  *          a HMAC/SHA-256 operation.
  *
+ * \param[in] device     Device context pointer
  * \param[in] ctx        HMAC/SHA-256 context
  * \param[in] data       Message data to add
  * \param[in] data_size  Size of message data in bytes
  *
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_sha_hmac_update(atca_hmac_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size)
+ATCA_STATUS atcab_sha_hmac_update_ext(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_sha_hmac_update(_gDevice, ctx, data, data_size);
+        status = calib_sha_hmac_update(device, ctx, data, data_size);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -3163,8 +3671,23 @@ ATCA_STATUS atcab_sha_hmac_update(atca_hmac_sha256_ctx_t* ctx, const uint8_t* da
     return status;
 }
 
+/** \brief Executes SHA command to add an arbitrary amount of message data to
+ *          a HMAC/SHA-256 operation.
+ *
+ * \param[in] ctx        HMAC/SHA-256 context
+ * \param[in] data       Message data to add
+ * \param[in] data_size  Size of message data in bytes
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_sha_hmac_update(atca_hmac_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size)
+{
+    return atcab_sha_hmac_update_ext(_gDevice, ctx, data, data_size);
+}
+
 /** \brief Executes SHA command to complete a HMAC/SHA-256 operation.
  *
+ * \param[in]  device  Device context pointer
  * \param[in]  ctx     HMAC/SHA-256 context
  * \param[out] digest  HMAC/SHA-256 result is returned here (32 bytes).
  * \param[in]  target  Where to save the digest internal to the device.
@@ -3175,15 +3698,15 @@ ATCA_STATUS atcab_sha_hmac_update(atca_hmac_sha256_ctx_t* ctx, const uint8_t* da
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_sha_hmac_finish(atca_hmac_sha256_ctx_t* ctx, uint8_t* digest, uint8_t target)
+ATCA_STATUS atcab_sha_hmac_finish_ext(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, uint8_t* digest, uint8_t target)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_sha_hmac_finish(_gDevice, ctx, digest, target);
+        status = calib_sha_hmac_finish(device, ctx, digest, target);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
@@ -3197,6 +3720,19 @@ ATCA_STATUS atcab_sha_hmac_finish(atca_hmac_sha256_ctx_t* ctx, uint8_t* digest,
     return status;
 }
 
+/** \brief Executes SHA command to complete a HMAC/SHA-256 operation.
+ *
+ * \param[in]  ctx     HMAC/SHA-256 context
+ * \param[out] digest  HMAC/SHA-256 result is returned here (32 bytes).
+ * \param[in]  target  Where to save the digest internal to the device.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_sha_hmac_finish(atca_hmac_sha256_ctx_t* ctx, uint8_t* digest, uint8_t target)
+{
+    return atcab_sha_hmac_finish_ext(_gDevice, ctx, digest, target);
+}
+
 
 
 /** \brief Use the SHA command to compute an HMAC/SHA-256 operation.
@@ -3363,6 +3899,84 @@ ATCA_STATUS atcab_sign(uint16_t key_id, const uint8_t* msg, uint8_t* signature)
     return atcab_sign_ext(_gDevice, key_id, msg, signature);
 }
 
+/** \brief Signs a batch of 32-byte external messages using the private key in
+ *          the specified slot. CryptoAuth devices are kept awake across the
+ *          batch rather than being idled and woken for every message.
+ *
+ *  \param[in]  device       Device context pointer
+ *  \param[in]  key_id       Slot of the private key to be used to sign the
+ *                           messages.
+ *  \param[in]  msgs         Messages to be signed, 32 bytes each (count * 32
+ *                           bytes).
+ *  \param[in]  count        Number of messages
+ *  \param[out] signatures   Signatures are returned here, 64 bytes each
+ *                           (count * 64 bytes).
+ *  \param[out] item_status  Optional array of count entries receiving the
+ *                           result for each message.
+ *
+ * \return ATCA_SUCCESS if every message was signed, otherwise the first error
+ *         encountered.
+ */
+ATCA_STATUS atcab_sign_batch_ext(ATCADevice device, uint16_t key_id, const uint8_t* msgs, size_t count, uint8_t* signatures,
+                                 ATCA_STATUS* item_status)
+{
+    ATCA_STATUS status;
+    ATCA_STATUS item;
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
+    size_t i;
+
+    if (atcab_is_ca_device(dev_type) && ECC204 != dev_type)
+    {
+#ifdef ATCA_ECC_SUPPORT
+        return calib_sign_batch(device, key_id, msgs, count, signatures, item_status);
+#endif
+    }
+
+    if (!msgs || !signatures)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    /* Devices without a batch implementation sign each message in turn */
+    status = ATCA_SUCCESS;
+    for (i = 0; i < count; i++)
+    {
+        item = atcab_sign_ext(device, key_id, &msgs[i * ATCA_SHA256_DIGEST_SIZE], &signatures[i * ATCA_ECCP256_SIG_SIZE]);
+        if (item_status)
+        {
+            item_status[i] = item;
+        }
+        if (ATCA_SUCCESS == status)
+        {
+            status = item;
+        }
+    }
+
+    return status;
+}
+
+/** \brief Signs a batch of 32-byte external messages using the private key in
+ *          the specified slot. CryptoAuth devices are kept awake across the
+ *          batch rather than being idled and woken for every message.
+ *
+ *  \param[in]  key_id       Slot of the private key to be used to sign the
+ *                           messages.
+ *  \param[in]  msgs         Messages to be signed, 32 bytes each (count * 32
+ *                           bytes).
+ *  \param[in]  count        Number of messages
+ *  \param[out] signatures   Signatures are returned here, 64 bytes each
+ *                           (count * 64 bytes).
+ *  \param[out] item_status  Optional array of count entries receiving the
+ *                           result for each message.
+ *
+ * \return ATCA_SUCCESS if every message was signed, otherwise the first error
+ *         encountered.
+ */
+ATCA_STATUS atcab_sign_batch(uint16_t key_id, const uint8_t* msgs, size_t count, uint8_t* signatures, ATCA_STATUS* item_status)
+{
+    return atcab_sign_batch_ext(_gDevice, key_id, msgs, count, signatures, item_status);
+}
+
 /** \brief Executes Sign command to sign an internally generated message.
  *
  *  \param[in]  key_id         Slot of the private key to be used to sign the
@@ -3838,6 +4452,7 @@ ATCA_STATUS atcab_write(uint8_t zone, uint16_t address, const uint8_t* value, co
 /** \brief Executes the Write command, which writes either 4 or 32 bytes of
  *          data into a device zone.
  *
+ *  \param[in]  device  Device context pointer
  *  \param[in] zone    Device zone to write to (0=config, 1=OTP, 2=data).
  *  \param[in] slot    If writing to the data zone, it is the slot to write to,
  *                     otherwise it should be 0.
@@ -3849,10 +4464,10 @@ ATCA_STATUS atcab_write(uint8_t zone, uint16_t address, const uint8_t* value, co
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t* data, uint8_t len)
+ATCA_STATUS atcab_write_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t* data, uint8_t len)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -3860,19 +4475,19 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
         if (ECC204 == dev_type)
         {
 #if defined(ATCA_ECC204_SUPPORT)
-            status = calib_ecc204_write_zone(_gDevice, zone, slot, block, offset, data, len);
+            status = calib_ecc204_write_zone(device, zone, slot, block, offset, data, len);
 #endif
         }
         else
         {
-            status = calib_write_zone(_gDevice, zone, slot, block, offset, data, len);
+            status = calib_write_zone(device, zone, slot, block, offset, data, len);
         }
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_write_zone(_gDevice, zone, slot, block, offset, data, len);
+        status = talib_write_zone(device, zone, slot, block, offset, data, len);
 #endif
     }
     else
@@ -3882,6 +4497,25 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
     return status;
 }
 
+/** \brief Executes the Write command, which writes either 4 or 32 bytes of
+ *          data into a device zone.
+ *
+ *  \param[in] zone    Device zone to write to (0=config, 1=OTP, 2=data).
+ *  \param[in] slot    If writing to the data zone, it is the slot to write to,
+ *                     otherwise it should be 0.
+ *  \param[in] block   32-byte block to write to.
+ *  \param[in] offset  4-byte word within the specified block to write to. If
+ *                     performing a 32-byte write, this should be 0.
+ *  \param[in] data    Data to be written.
+ *  \param[in] len     Number of bytes to be written. Must be either 4 or 32.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t* data, uint8_t len)
+{
+    return atcab_write_zone_ext(_gDevice, zone, slot, block, offset, data, len);
+}
+
 /** \brief Executes the Write command, which writes data into the
  *          configuration, otp, or data zones with a given byte offset and
  *          length. Offset and length must be multiples of a word (4 bytes).
@@ -3890,6 +4524,7 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
  * unlocked, only 32-byte writes are allowed to slots and OTP and the offset
  * and length must be multiples of 32 or the write will fail.
  *
+ *  \param[in]  device  Device context pointer
  *  \param[in] zone          Zone to write data to: ATCA_ZONE_CONFIG(0),
  *                           ATCA_ZONE_OTP(1), or ATCA_ZONE_DATA(2).
  *  \param[in] slot          If zone is ATCA_ZONE_DATA(2), the slot number to
@@ -3902,10 +4537,10 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t* data, size_t length)
+ATCA_STATUS atcab_write_bytes_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t* data, size_t length)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -3913,19 +4548,19 @@ ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_by
         if (ECC204 == dev_type)
         {
 #if defined(ATCA_ECC204_SUPPORT)
-            status = calib_ecc204_write_bytes_zone(_gDevice, zone, slot, offset_bytes, data, length);
+            status = calib_ecc204_write_bytes_zone(device, zone, slot, offset_bytes, data, length);
 #endif
         }
         else
         {
-            status = calib_write_bytes_zone(_gDevice, zone, slot, offset_bytes, data, length);
+            status = calib_write_bytes_zone(device, zone, slot, offset_bytes, data, length);
         }
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_write_bytes_zone(_gDevice, zone, slot, offset_bytes, data, length);
+        status = talib_write_bytes_zone(device, zone, slot, offset_bytes, data, length);
 #endif
     }
     else
@@ -3935,9 +4570,35 @@ ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_by
     return status;
 }
 
+/** \brief Executes the Write command, which writes data into the
+ *          configuration, otp, or data zones with a given byte offset and
+ *          length. Offset and length must be multiples of a word (4 bytes).
+ *
+ * Config zone must be unlocked for writes to that zone. If data zone is
+ * unlocked, only 32-byte writes are allowed to slots and OTP and the offset
+ * and length must be multiples of 32 or the write will fail.
+ *
+ *  \param[in] zone          Zone to write data to: ATCA_ZONE_CONFIG(0),
+ *                           ATCA_ZONE_OTP(1), or ATCA_ZONE_DATA(2).
+ *  \param[in] slot          If zone is ATCA_ZONE_DATA(2), the slot number to
+ *                           write to. Ignored for all other zones.
+ *  \param[in] offset_bytes  Byte offset within the zone to write to. Must be
+ *                           a multiple of a word (4 bytes).
+ *  \param[in] data          Data to be written.
+ *  \param[in] length        Number of bytes to be written. Must be a multiple
+ *                           of a word (4 bytes).
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t* data, size_t length)
+{
+    return atcab_write_bytes_zone_ext(_gDevice, zone, slot, offset_bytes, data, length);
+}
+
 /** \brief Uses the write command to write a public key to a slot in the
  *         proper format.
  *
+ *  \param[in]  device  Device context pointer
  *  \param[in] slot        Slot number to write. Only slots 8 to 15 are large
  *                         enough to store a public key.
  *  \param[in] public_key  Public key to write into the slot specified. X and Y
@@ -3946,21 +4607,21 @@ ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_by
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_write_pubkey(uint16_t slot, const uint8_t* public_key)
+ATCA_STATUS atcab_write_pubkey_ext(ATCADevice device, uint16_t slot, const uint8_t* public_key)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
 #if ATCA_CA_SUPPORT
-        status = calib_write_pubkey(_gDevice, slot, public_key);
+        status = calib_write_pubkey(device, slot, public_key);
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_write_pubkey_compat(_gDevice, slot, public_key);
+        status = talib_write_pubkey_compat(device, slot, public_key);
 #endif
     }
     else
@@ -3970,6 +4631,22 @@ ATCA_STATUS atcab_write_pubkey(uint16_t slot, const uint8_t* public_key)
     return status;
 }
 
+/** \brief Uses the write command to write a public key to a slot in the
+ *         proper format.
+ *
+ *  \param[in] slot        Slot number to write. Only slots 8 to 15 are large
+ *                         enough to store a public key.
+ *  \param[in] public_key  Public key to write into the slot specified. X and Y
+ *                         integers in big-endian format. 64 bytes for P256
+ *                         curve.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_write_pubkey(uint16_t slot, const uint8_t* public_key)
+{
+    return atcab_write_pubkey_ext(_gDevice, slot, public_key);
+}
+
 /** \brief Executes the Write command, which writes the configuration zone.
  *
  *  First 16 bytes are skipped as they are not writable. LockValue and
@@ -3979,16 +4656,17 @@ ATCA_STATUS atcab_write_pubkey(uint16_t slot, const uint8_t* public_key)
  *  This command may fail if UserExtra and/or Selector bytes have
  *  already been set to non-zero values.
  *
+ *  \param[in]  device  Device context pointer
  *  \param[in] config_data  Data to the config zone data. This should be 88
  *                          bytes for SHA devices and 128 bytes for ECC
  *                          devices.
  *
  *  \returns ATCA_SUCCESS on success, otherwise an error code.
  */
-ATCA_STATUS atcab_write_config_zone(const uint8_t* config_data)
+ATCA_STATUS atcab_write_config_zone_ext(ATCADevice device, const uint8_t* config_data)
 {
     ATCA_STATUS status = ATCA_UNIMPLEMENTED;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(device);
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -3996,19 +4674,19 @@ ATCA_STATUS atcab_write_config_zone(const uint8_t* config_data)
         if (ECC204 == dev_type)
         {
 #if defined(ATCA_ECC204_SUPPORT)
-            status = calib_ecc204_write_config_zone(_gDevice, config_data);
+            status = calib_ecc204_write_config_zone(device, config_data);
 #endif
         }
         else
         {
-            status = calib_write_config_zone(_gDevice, config_data);
+            status = calib_write_config_zone(device, config_data);
         }
 #endif
     }
     else if (atcab_is_ta_device(dev_type))
     {
 #if ATCA_TA_SUPPORT
-        status = talib_write_config_zone(_gDevice, config_data);
+        status = talib_write_config_zone(device, config_data);
 #endif
     }
     else
@@ -4018,6 +4696,26 @@ ATCA_STATUS atcab_write_config_zone(const uint8_t* config_data)
     return status;
 }
 
+/** \brief Executes the Write command, which writes the configuration zone.
+ *
+ *  First 16 bytes are skipped as they are not writable. LockValue and
+ *  LockConfig are also skipped and can only be changed via the Lock
+ *  command.
+ *
+ *  This command may fail if UserExtra and/or Selector bytes have
+ *  already been set to non-zero values.
+ *
+ *  \param[in] config_data  Data to the config zone data. This should be 88
+ *                          bytes for SHA devices and 128 bytes for ECC
+ *                          devices.
+ *
+ *  \returns ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_write_config_zone(const uint8_t* config_data)
+{
+    return atcab_write_config_zone_ext(_gDevice, config_data);
+}
+
 /** \brief Executes the Write command, which performs an encrypted write of
  *          a 32 byte block into given slot.
  *
@@ -91,6 +91,8 @@ ATCA_STATUS atcab_aes_ctr_block(atca_aes_ctr_ctx_t* ctx, const uint8_t* input, u
 ATCA_STATUS atcab_aes_ctr_encrypt_block(atca_aes_ctr_ctx_t* ctx, const uint8_t* plaintext, uint8_t* ciphertext);
 ATCA_STATUS atcab_aes_ctr_decrypt_block(atca_aes_ctr_ctx_t* ctx, const uint8_t* ciphertext, uint8_t* plaintext);
 ATCA_STATUS atcab_aes_ctr_increment(atca_aes_ctr_ctx_t* ctx);
+ATCA_STATUS atcab_aes_ctr_bulk_init(atca_aes_ctr_bulk_ctx_t* ctx, const atca_aes_ctr_ctx_t* ctr_ctx);
+ATCA_STATUS atcab_aes_ctr_bulk(atca_aes_ctr_bulk_ctx_t* ctx, const uint8_t* input, uint8_t* output, size_t length);
 
 ATCA_STATUS atcab_aes_ccm_init_ext(ATCADevice device, atca_aes_ccm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, uint8_t* iv, size_t iv_size, size_t aad_size, size_t text_size, size_t tag_size);
 ATCA_STATUS atcab_aes_ccm_init(atca_aes_ccm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, uint8_t* iv, size_t iv_size, size_t aad_size, size_t text_size, size_t tag_size);
@@ -113,8 +115,13 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 #define atcab_wakeup()                          calib_wakeup(_gDevice)
 #define atcab_idle()                            calib_idle(_gDevice)
 #define atcab_sleep()                           calib_sleep(_gDevice)
+#define atcab_keep_awake_begin()                calib_keep_awake_begin(_gDevice)
+#define atcab_keep_awake_begin_ext              calib_keep_awake_begin
+#define atcab_keep_awake_end()                  calib_keep_awake_end(_gDevice)
+#define atcab_keep_awake_end_ext                calib_keep_awake_end
 #define _atcab_exit(...)                         _calib_exit(_gDevice, __VA_ARGS__)
 #define atcab_get_zone_size(...)                calib_get_zone_size(_gDevice, __VA_ARGS__)
+#define atcab_get_zone_size_ext                 calib_get_zone_size
 
 
 // AES command functions
@@ -126,12 +133,18 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 #define atcab_aes_gfm(...)                      calib_aes_gfm(_gDevice, __VA_ARGS__)
 
 #define atcab_aes_gcm_init(...)                 calib_aes_gcm_init(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_init_ext                  calib_aes_gcm_init
 #define atcab_aes_gcm_init_rand(...)            calib_aes_gcm_init_rand(_gDevice, __VA_ARGS__)
 #define atcab_aes_gcm_aad_update(...)           calib_aes_gcm_aad_update(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_aad_update_ext            calib_aes_gcm_aad_update
 #define atcab_aes_gcm_encrypt_update(...)       calib_aes_gcm_encrypt_update(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_encrypt_update_ext        calib_aes_gcm_encrypt_update
 #define atcab_aes_gcm_encrypt_finish(...)       calib_aes_gcm_encrypt_finish(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_encrypt_finish_ext        calib_aes_gcm_encrypt_finish
 #define atcab_aes_gcm_decrypt_update(...)       calib_aes_gcm_decrypt_update(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_decrypt_update_ext        calib_aes_gcm_decrypt_update
 #define atcab_aes_gcm_decrypt_finish(...)       calib_aes_gcm_decrypt_finish(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_decrypt_finish_ext        calib_aes_gcm_decrypt_finish
 
 // CheckMAC command functions
 #define atcab_checkmac(...)                     calib_checkmac(_gDevice, __VA_ARGS__)
@@ -158,6 +171,7 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 // GenKey command functions
 #define atcab_genkey_base(...)                  calib_genkey_base(_gDevice, __VA_ARGS__)
 #define atcab_genkey(...)                       calib_genkey(_gDevice, __VA_ARGS__)
+#define atcab_genkey_ext                        calib_genkey
 #define atcab_get_pubkey(...)                   calib_get_pubkey(_gDevice, __VA_ARGS__)
 #define atcab_get_pubkey_ext                    calib_get_pubkey
 
@@ -167,6 +181,7 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 // Info command functions
 #define atcab_info_base(...)                    calib_info_base(_gDevice, __VA_ARGS__)
 #define atcab_info(...)                         calib_info(_gDevice, __VA_ARGS__)
+#define atcab_info_ext                          calib_info
 #define atcab_info_get_latch(...)               calib_info_get_latch(_gDevice, __VA_ARGS__)
 #define atcab_info_set_latch(...)               calib_info_set_latch(_gDevice, __VA_ARGS__)
 
@@ -176,10 +191,13 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 // Lock command functions
 #define atcab_lock(...)                          calib_lock(_gDevice, __VA_ARGS__)
 #define atcab_lock_config_zone()                 calib_lock_config_zone(_gDevice)
+#define atcab_lock_config_zone_ext              calib_lock_config_zone
 #define atcab_lock_config_zone_crc(...)          calib_lock_config_zone_crc(_gDevice, __VA_ARGS__)
 #define atcab_lock_data_zone()                   calib_lock_data_zone(_gDevice)
+#define atcab_lock_data_zone_ext                calib_lock_data_zone
 #define atcab_lock_data_zone_crc(...)            calib_lock_data_zone_crc(_gDevice, __VA_ARGS__)
 #define atcab_lock_data_slot(...)                calib_lock_data_slot(_gDevice, __VA_ARGS__)
+#define atcab_lock_data_slot_ext                calib_lock_data_slot
 
 // MAC command functions
 #define atcab_mac(...)                          calib_mac(_gDevice, __VA_ARGS__)
@@ -202,18 +220,26 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 
 // Read command functions
 #define atcab_read_zone(...)                    calib_read_zone(_gDevice, __VA_ARGS__)
+#define atcab_read_zone_ext                     calib_read_zone
 #define atcab_is_locked(...)                    calib_is_locked(_gDevice, __VA_ARGS__)
 #define atcab_is_config_locked(...)             calib_is_locked(_gDevice, LOCK_ZONE_CONFIG, __VA_ARGS__)
+#define atcab_is_config_locked_ext(device, ...) calib_is_locked(device, LOCK_ZONE_CONFIG, __VA_ARGS__)
 #define atcab_is_data_locked(...)               calib_is_locked(_gDevice, LOCK_ZONE_DATA, __VA_ARGS__)
+#define atcab_is_data_locked_ext(device, ...)   calib_is_locked(device, LOCK_ZONE_DATA, __VA_ARGS__)
 #define atcab_is_slot_locked(...)               calib_is_slot_locked(_gDevice, __VA_ARGS__)
+#define atcab_is_slot_locked_ext                calib_is_slot_locked
 #define atcab_is_private(...)                   calib_is_private(_gDevice, __VA_ARGS__)
 #define atcab_is_private_ext                    calib_is_private
 #define atcab_read_bytes_zone(...)              calib_read_bytes_zone(_gDevice, __VA_ARGS__)
+#define atcab_read_bytes_zone_ext               calib_read_bytes_zone
 #define atcab_read_serial_number(...)           calib_read_serial_number(_gDevice, __VA_ARGS__)
+#define atcab_read_serial_number_ext            calib_read_serial_number
 #define atcab_read_pubkey(...)                  calib_read_pubkey(_gDevice, __VA_ARGS__)
 #define atcab_read_pubkey_ext                   calib_read_pubkey
 #define atcab_read_sig(...)                     calib_read_sig(_gDevice, __VA_ARGS__)
+#define atcab_read_sig_ext                      calib_read_sig
 #define atcab_read_config_zone(...)             calib_read_config_zone(_gDevice, __VA_ARGS__)
+#define atcab_read_config_zone_ext              calib_read_config_zone
 #define atcab_cmp_config_zone(...)              calib_cmp_config_zone(_gDevice, __VA_ARGS__)
 #define atcab_read_enc(...)                     calib_read_enc(_gDevice, __VA_ARGS__)
 
@@ -228,18 +254,28 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 // SHA command functions
 #define atcab_sha_base(...)                     calib_sha_base(_gDevice, __VA_ARGS__)
 #define atcab_sha_start()                       calib_sha_start(_gDevice)
+#define atcab_sha_start_ext                     calib_sha_start
 #define atcab_sha_update(...)                   calib_sha_update(_gDevice, __VA_ARGS__)
 #define atcab_sha_end(...)                      calib_sha_end(_gDevice, __VA_ARGS__)
 #define atcab_sha_read_context(...)             calib_sha_read_context(_gDevice, __VA_ARGS__)
+#define atcab_sha_read_context_ext              calib_sha_read_context
 #define atcab_sha_write_context(...)            calib_sha_write_context(_gDevice, __VA_ARGS__)
+#define atcab_sha_write_context_ext             calib_sha_write_context
 #define atcab_sha(...)                          calib_sha(_gDevice, __VA_ARGS__)
 #define atcab_hw_sha2_256(...)                  calib_hw_sha2_256(_gDevice, __VA_ARGS__)
 #define atcab_hw_sha2_256_init(...)             calib_hw_sha2_256_init(_gDevice, __VA_ARGS__)
 #define atcab_hw_sha2_256_update(...)           calib_hw_sha2_256_update(_gDevice, __VA_ARGS__)
+#define atcab_hw_sha2_256_update_ext            calib_hw_sha2_256_update
 #define atcab_hw_sha2_256_finish(...)           calib_hw_sha2_256_finish(_gDevice, __VA_ARGS__)
+#define atcab_hw_sha2_256_finish_ext            calib_hw_sha2_256_finish
+#define atcab_sha_set_offload(...)              calib_sha_set_offload(_gDevice, __VA_ARGS__)
+#define atcab_sha_set_offload_ext               calib_sha_set_offload
 #define atcab_sha_hmac_init(...)                calib_sha_hmac_init(_gDevice, __VA_ARGS__)
 #define atcab_sha_hmac_update(...)              calib_sha_hmac_update(_gDevice, __VA_ARGS__)
 #define atcab_sha_hmac_finish(...)              calib_sha_hmac_finish(_gDevice, __VA_ARGS__)
+#define atcab_sha_hmac_init_ext                 calib_sha_hmac_init
+#define atcab_sha_hmac_update_ext               calib_sha_hmac_update
+#define atcab_sha_hmac_finish_ext               calib_sha_hmac_finish
 #define atcab_sha_hmac(...)                     calib_sha_hmac(_gDevice, __VA_ARGS__)
 #define atcab_sha_hmac_ext                      calib_sha_hmac
 #define SHA_CONTEXT_MAX_SIZE                    (99)
@@ -248,6 +284,8 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 #define atcab_sign_base(...)                    calib_sign_base(_gDevice, __VA_ARGS__)
 #define atcab_sign(...)                         calib_sign(_gDevice, __VA_ARGS__)
 #define atcab_sign_ext                          calib_sign
+#define atcab_sign_batch(...)                   calib_sign_batch(_gDevice, __VA_ARGS__)
+#define atcab_sign_batch_ext                    calib_sign_batch
 #define atcab_sign_internal(...)                calib_sign_internal(_gDevice, __VA_ARGS__)
 
 // UpdateExtra command functions
@@ -267,9 +305,13 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 // Write command functions
 #define atcab_write(...)                        calib_write(_gDevice, __VA_ARGS__)
 #define atcab_write_zone(...)                   calib_write_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_zone_ext                    calib_write_zone
 #define atcab_write_bytes_zone(...)             calib_write_bytes_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_bytes_zone_ext              calib_write_bytes_zone
 #define atcab_write_pubkey(...)                 calib_write_pubkey(_gDevice, __VA_ARGS__)
+#define atcab_write_pubkey_ext                  calib_write_pubkey
 #define atcab_write_config_zone(...)            calib_write_config_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_config_zone_ext             calib_write_config_zone
 #define atcab_write_enc(...)                    calib_write_enc(_gDevice, __VA_ARGS__)
 #define atcab_write_config_counter(...)         calib_write_config_counter(_gDevice, __VA_ARGS__)
 
@@ -278,8 +320,13 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 #define atcab_wakeup(...)                       (0)
 #define atcab_idle(...)                         (0)
 #define atcab_sleep(...)                        (0)
+#define atcab_keep_awake_begin(...)             (0)
+#define atcab_keep_awake_begin_ext(...)         (0)
+#define atcab_keep_awake_end(...)               (0)
+#define atcab_keep_awake_end_ext(...)           (0)
 #define _atcab_exit(...)                        (1)
 #define atcab_get_zone_size(...)                talib_get_zone_size(_gDevice, __VA_ARGS__)
+#define atcab_get_zone_size_ext                 talib_get_zone_size
 //#define atcab_get_addr(...)                     (1)
 
 // AES command functions
@@ -291,12 +338,18 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 #define atcab_aes_gfm(...)                      (1)
 
 #define atcab_aes_gcm_init(...)                 (1)
+#define atcab_aes_gcm_init_ext(...)             (1)
 #define atcab_aes_gcm_init_rand(...)            (1)
 #define atcab_aes_gcm_aad_update(...)           (1)
+#define atcab_aes_gcm_aad_update_ext(...)       (1)
 #define atcab_aes_gcm_encrypt_update(...)       (1)
+#define atcab_aes_gcm_encrypt_update_ext(...)   (1)
 #define atcab_aes_gcm_encrypt_finish(...)       (1)
+#define atcab_aes_gcm_encrypt_finish_ext(...)   (1)
 #define atcab_aes_gcm_decrypt_update(...)       (1)
+#define atcab_aes_gcm_decrypt_update_ext(...)   (1)
 #define atcab_aes_gcm_decrypt_finish(...)       (1)
+#define atcab_aes_gcm_decrypt_finish_ext(...)   (1)
 
 // CheckMAC command functions
 #define atcab_checkmac(...)                     (1)
@@ -323,6 +376,7 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 // GenKey command functions
 #define atcab_genkey_base(...)                  (ATCA_UNIMPLEMENTED)
 #define atcab_genkey(...)                       talib_genkey_compat(_gDevice, __VA_ARGS__)
+#define atcab_genkey_ext                        talib_genkey_compat
 #define atcab_get_pubkey(...)                   talib_get_pubkey_compat(_gDevice, __VA_ARGS__)
 #define atcab_get_pubkey_ext                    talib_get_pubkey_compat
 
@@ -332,6 +386,7 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 // Info command functions
 #define atcab_info_base(...)                    talib_info_base(_gDevice, __VA_ARGS__)
 #define atcab_info(...)                         talib_info_compat(_gDevice, __VA_ARGS__)
+#define atcab_info_ext                          talib_info_compat
 #define atcab_info_get_latch(...)               (1)
 #define atcab_info_set_latch(...)               (1)
 //#define atcab_info_get_latch(...)               talib_info_get_latch(_gDevice, __VA_ARGS__)
@@ -343,10 +398,13 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 // Lock command functions
 #define atcab_lock(...)                         (1)
 #define atcab_lock_config_zone()                talib_lock_config(_gDevice)
+#define atcab_lock_config_zone_ext              talib_lock_config
 #define atcab_lock_config_zone_crc(...)         talib_lock_config_with_crc(_gDevice, __VA_ARGS__)
 #define atcab_lock_data_zone()                  talib_lock_setup(_gDevice)
+#define atcab_lock_data_zone_ext                talib_lock_setup
 #define atcab_lock_data_zone_crc(...)           (1)
 #define atcab_lock_data_slot(...)               talib_lock_handle(_gDevice, __VA_ARGS__)
+#define atcab_lock_data_slot_ext                talib_lock_handle
 
 // MAC command functions
 #define atcab_mac(...)                          (ATCA_UNIMPLEMENTED)
@@ -368,18 +426,26 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 
 // Read command functions
 #define atcab_read_zone(...)                    (ATCA_UNIMPLEMENTED)
+#define atcab_read_zone_ext(...)                (ATCA_UNIMPLEMENTED)
 #define atcab_is_locked(...)                    talib_is_locked_compat(_gDevice, __VA_ARGS__)
 #define atcab_is_config_locked(...)             talib_is_config_locked(_gDevice, __VA_ARGS__)
+#define atcab_is_config_locked_ext              talib_is_config_locked
 #define atcab_is_data_locked(...)               talib_is_setup_locked(_gDevice, __VA_ARGS__)
+#define atcab_is_data_locked_ext                talib_is_setup_locked
 #define atcab_is_slot_locked(...)               talib_is_handle_locked(_gDevice, __VA_ARGS__)
+#define atcab_is_slot_locked_ext                talib_is_handle_locked
 #define atcab_is_private(...)                   talib_is_private(_gDevice, __VA_ARGS__)
 #define atcab_is_private_ext                    talib_is_private
 #define atcab_read_bytes_zone(...)              talib_read_bytes_zone(_gDevice, __VA_ARGS__)
+#define atcab_read_bytes_zone_ext               talib_read_bytes_zone
 #define atcab_read_serial_number(...)           talib_info_serial_number_compat(_gDevice, __VA_ARGS__)
+#define atcab_read_serial_number_ext            talib_info_serial_number_compat
 #define atcab_read_pubkey(...)                  talib_read_pubkey_compat(_gDevice, __VA_ARGS__)
 #define atcab_read_pubkey_ext                   talib_read_pubkey_compat
 #define atcab_read_sig(...)                     talib_read_sig_compat(_gDevice, __VA_ARGS__)
+#define atcab_read_sig_ext                      talib_read_sig_compat
 #define atcab_read_config_zone(...)             talib_read_config_zone(_gDevice, __VA_ARGS__)
+#define atcab_read_config_zone_ext              talib_read_config_zone
 #define atcab_cmp_config_zone(...)              talib_cmp_config_zone(_gDevice, __VA_ARGS__)
 #define atcab_read_enc(...)                     (ATCA_UNIMPLEMENTED)
 
@@ -394,18 +460,28 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 // SHA command functions
 #define atcab_sha_base(...)                     talib_sha_base_compat(_gDevice, __VA_ARGS__)
 #define atcab_sha_start()                       talib_sha_start(_gDevice)
+#define atcab_sha_start_ext                     talib_sha_start
 #define atcab_sha_update(...)                   talib_sha_update_compat(_gDevice, __VA_ARGS__)
 #define atcab_sha_end(...)                      talib_sha_end_compat(_gDevice, __VA_ARGS__)
 #define atcab_sha_read_context(...)             talib_sha_read_context(_gDevice, __VA_ARGS__)
+#define atcab_sha_read_context_ext              talib_sha_read_context
 #define atcab_sha_write_context(...)            talib_sha_write_context(_gDevice, __VA_ARGS__)
+#define atcab_sha_write_context_ext             talib_sha_write_context
 #define atcab_sha(...)                          talib_sha(_gDevice, __VA_ARGS__)
 #define atcab_hw_sha2_256(...)                  (1)
 #define atcab_hw_sha2_256_init(...)             (1)
 #define atcab_hw_sha2_256_update(...)           (1)
+#define atcab_hw_sha2_256_update_ext(...)       (1)
 #define atcab_hw_sha2_256_finish(...)           (1)
+#define atcab_hw_sha2_256_finish_ext(...)       (1)
+#define atcab_sha_set_offload(...)              (ATCA_UNIMPLEMENTED)
+#define atcab_sha_set_offload_ext(...)          (ATCA_UNIMPLEMENTED)
 #define atcab_sha_hmac_init(...)                (ATCA_UNIMPLEMENTED)
 #define atcab_sha_hmac_update(...)              (ATCA_UNIMPLEMENTED)
 #define atcab_sha_hmac_finish(...)              (ATCA_UNIMPLEMENTED)
+#define atcab_sha_hmac_init_ext(...)            (ATCA_UNIMPLEMENTED)
+#define atcab_sha_hmac_update_ext(...)          (ATCA_UNIMPLEMENTED)
+#define atcab_sha_hmac_finish_ext(...)          (ATCA_UNIMPLEMENTED)
 #define atcab_sha_hmac(...)                     talib_hmac_compat(_gDevice, __VA_ARGS__)
 #define atcab_sha_hmac_ext                      talib_hmac_compat
 #define SHA_CONTEXT_MAX_SIZE                    (109)
@@ -414,6 +490,8 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 #define atcab_sign_base(...)                    (1)
 #define atcab_sign(...)                         talib_sign_compat(_gDevice, __VA_ARGS__)
 #define atcab_sign_ext                          talib_sign_compat
+#define atcab_sign_batch(...)                   (ATCA_UNIMPLEMENTED)
+#define atcab_sign_batch_ext(...)               (ATCA_UNIMPLEMENTED)
 #define atcab_sign_internal(...)                (1)
 
 // UpdateExtra command functions
@@ -433,9 +511,13 @@ ATCA_STATUS atcab_pbkdf2_sha256(const uint32_t iter, const uint16_t slot, const
 // Write command functions
 #define atcab_write(...)                        (ATCA_UNIMPLEMENTED)
 #define atcab_write_zone(...)                   talib_write_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_zone_ext                    talib_write_zone
 #define atcab_write_bytes_zone(...)             talib_write_bytes_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_bytes_zone_ext              talib_write_bytes_zone
 #define atcab_write_pubkey(...)                 talib_write_pubkey_compat(_gDevice, __VA_ARGS__)
+#define atcab_write_pubkey_ext                  talib_write_pubkey_compat
 #define atcab_write_config_zone(...)            talib_write_config_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_config_zone_ext             talib_write_config_zone
 #define atcab_write_enc(...)                    (ATCA_UNIMPLEMENTED)
 #define atcab_write_config_counter(...)         (ATCA_UNIMPLEMENTED)
 
@@ -448,8 +530,13 @@ ATCA_STATUS _atcab_exit(void);
 ATCA_STATUS atcab_wakeup(void);
 ATCA_STATUS atcab_idle(void);
 ATCA_STATUS atcab_sleep(void);
+ATCA_STATUS atcab_keep_awake_begin(void);
+ATCA_STATUS atcab_keep_awake_begin_ext(ATCADevice device);
+ATCA_STATUS atcab_keep_awake_end(void);
+ATCA_STATUS atcab_keep_awake_end_ext(ATCADevice device);
 //ATCA_STATUS atcab_get_addr(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint16_t* addr);
 ATCA_STATUS atcab_get_zone_size(uint8_t zone, uint16_t slot, size_t* size);
+ATCA_STATUS atcab_get_zone_size_ext(ATCADevice device, uint8_t zone, uint16_t slot, size_t* size);
 
 // AES command functions
 ATCA_STATUS atcab_aes(uint8_t mode, uint16_t key_id, const uint8_t* aes_in, uint8_t* aes_out);
@@ -461,13 +548,19 @@ ATCA_STATUS atcab_aes_gfm(const uint8_t* h, const uint8_t* input, uint8_t* outpu
 
 /* AES GCM */
 ATCA_STATUS atcab_aes_gcm_init(atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, const uint8_t* iv, size_t iv_size);
+ATCA_STATUS atcab_aes_gcm_init_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, const uint8_t* iv, size_t iv_size);
 ATCA_STATUS atcab_aes_gcm_init_rand(atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, size_t rand_size,
                                     const uint8_t* free_field, size_t free_field_size, uint8_t* iv);
 ATCA_STATUS atcab_aes_gcm_aad_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* aad, uint32_t aad_size);
+ATCA_STATUS atcab_aes_gcm_aad_update_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* aad, uint32_t aad_size);
 ATCA_STATUS atcab_aes_gcm_encrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* plaintext, uint32_t plaintext_size, uint8_t* ciphertext);
+ATCA_STATUS atcab_aes_gcm_encrypt_update_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* plaintext, uint32_t plaintext_size, uint8_t* ciphertext);
 ATCA_STATUS atcab_aes_gcm_encrypt_finish(atca_aes_gcm_ctx_t* ctx, uint8_t* tag, size_t tag_size);
+ATCA_STATUS atcab_aes_gcm_encrypt_finish_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, uint8_t* tag, size_t tag_size);
 ATCA_STATUS atcab_aes_gcm_decrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* ciphertext, uint32_t ciphertext_size, uint8_t* plaintext);
+ATCA_STATUS atcab_aes_gcm_decrypt_update_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* ciphertext, uint32_t ciphertext_size, uint8_t* plaintext);
 ATCA_STATUS atcab_aes_gcm_decrypt_finish(atca_aes_gcm_ctx_t* ctx, const uint8_t* tag, size_t tag_size, bool* is_verified);
+ATCA_STATUS atcab_aes_gcm_decrypt_finish_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* tag, size_t tag_size, bool* is_verified);
 
 /* CheckMAC command */
 ATCA_STATUS atcab_checkmac(uint8_t mode, uint16_t key_id, const uint8_t* challenge, const uint8_t* response, const uint8_t* other_data);
@@ -500,6 +593,7 @@ ATCA_STATUS atcab_gendig(uint8_t zone, uint16_t key_id, const uint8_t* other_dat
 // GenKey command functions
 ATCA_STATUS atcab_genkey_base(uint8_t mode, uint16_t key_id, const uint8_t* other_data, uint8_t* public_key);
 ATCA_STATUS atcab_genkey(uint16_t key_id, uint8_t* public_key);
+ATCA_STATUS atcab_genkey_ext(ATCADevice device, uint16_t key_id, uint8_t* public_key);
 ATCA_STATUS atcab_get_pubkey(uint16_t key_id, uint8_t* public_key);
 ATCA_STATUS atcab_get_pubkey_ext(ATCADevice device, uint16_t key_id, uint8_t* public_key);
 
@@ -509,6 +603,7 @@ ATCA_STATUS atcab_hmac(uint8_t mode, uint16_t key_id, uint8_t* digest);
 // Info command functions
 ATCA_STATUS atcab_info_base(uint8_t mode, uint16_t param2, uint8_t* out_data);
 ATCA_STATUS atcab_info(uint8_t* revision);
+ATCA_STATUS atcab_info_ext(ATCADevice device, uint8_t* revision);
 ATCA_STATUS atcab_info_set_latch(bool state);
 ATCA_STATUS atcab_info_get_latch(bool* state);
 
@@ -518,10 +613,13 @@ ATCA_STATUS atcab_kdf(uint8_t mode, uint16_t key_id, const uint32_t details, con
 // Lock command functions
 ATCA_STATUS atcab_lock(uint8_t mode, uint16_t summary_crc);
 ATCA_STATUS atcab_lock_config_zone(void);
+ATCA_STATUS atcab_lock_config_zone_ext(ATCADevice device);
 ATCA_STATUS atcab_lock_config_zone_crc(uint16_t summary_crc);
 ATCA_STATUS atcab_lock_data_zone(void);
+ATCA_STATUS atcab_lock_data_zone_ext(ATCADevice device);
 ATCA_STATUS atcab_lock_data_zone_crc(uint16_t summary_crc);
 ATCA_STATUS atcab_lock_data_slot(uint16_t slot);
+ATCA_STATUS atcab_lock_data_slot_ext(ATCADevice device, uint16_t slot);
 
 // MAC command functions
 ATCA_STATUS atcab_mac(uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest);
@@ -547,18 +645,26 @@ ATCA_STATUS atcab_random_ext(ATCADevice device, uint8_t* rand_out);
 
 // Read command functions
 ATCA_STATUS atcab_read_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t* data, uint8_t len);
+ATCA_STATUS atcab_read_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t* data, uint8_t len);
 ATCA_STATUS atcab_is_locked(uint8_t zone, bool* is_locked);
 ATCA_STATUS atcab_is_config_locked(bool* is_locked);
+ATCA_STATUS atcab_is_config_locked_ext(ATCADevice device, bool* is_locked);
 ATCA_STATUS atcab_is_data_locked(bool* is_locked);
+ATCA_STATUS atcab_is_data_locked_ext(ATCADevice device, bool* is_locked);
 ATCA_STATUS atcab_is_slot_locked(uint16_t slot, bool* is_locked);
+ATCA_STATUS atcab_is_slot_locked_ext(ATCADevice device, uint16_t slot, bool* is_locked);
 ATCA_STATUS atcab_is_private_ext(ATCADevice device, uint16_t slot, bool* is_private);
 ATCA_STATUS atcab_is_private(uint16_t slot, bool* is_private);
 ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset, uint8_t* data, size_t length);
+ATCA_STATUS atcab_read_bytes_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset, uint8_t* data, size_t length);
 ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number);
+ATCA_STATUS atcab_read_serial_number_ext(ATCADevice device, uint8_t* serial_number);
 ATCA_STATUS atcab_read_pubkey(uint16_t slot, uint8_t* public_key);
 ATCA_STATUS atcab_read_pubkey_ext(ATCADevice device, uint16_t slot, uint8_t* public_key);
 ATCA_STATUS atcab_read_sig(uint16_t slot, uint8_t* sig);
+ATCA_STATUS atcab_read_sig_ext(ATCADevice device, uint16_t slot, uint8_t* sig);
 ATCA_STATUS atcab_read_config_zone(uint8_t* config_data);
+ATCA_STATUS atcab_read_config_zone_ext(ATCADevice device, uint8_t* config_data);
 ATCA_STATUS atcab_cmp_config_zone(uint8_t* config_data, bool* same_config);
 
 #if defined(ATCA_USE_CONSTANT_HOST_NONCE)
@@ -578,19 +684,29 @@ ATCA_STATUS atcab_selftest(uint8_t mode, uint16_t param2, uint8_t* result);
 #define SHA_CONTEXT_MAX_SIZE                    (109)
 ATCA_STATUS atcab_sha_base(uint8_t mode, uint16_t length, const uint8_t* data_in, uint8_t* data_out, uint16_t* data_out_size);
 ATCA_STATUS atcab_sha_start(void);
+ATCA_STATUS atcab_sha_start_ext(ATCADevice device);
 ATCA_STATUS atcab_sha_update(const uint8_t* message);
 ATCA_STATUS atcab_sha_end(uint8_t* digest, uint16_t length, const uint8_t* message);
 ATCA_STATUS atcab_sha_read_context(uint8_t* context, uint16_t* context_size);
+ATCA_STATUS atcab_sha_read_context_ext(ATCADevice device, uint8_t* context, uint16_t* context_size);
 ATCA_STATUS atcab_sha_write_context(const uint8_t* context, uint16_t context_size);
+ATCA_STATUS atcab_sha_write_context_ext(ATCADevice device, const uint8_t* context, uint16_t context_size);
 ATCA_STATUS atcab_sha(uint16_t length, const uint8_t* message, uint8_t* digest);
 ATCA_STATUS atcab_hw_sha2_256(const uint8_t* data, size_t data_size, uint8_t* digest);
 
 ATCA_STATUS atcab_hw_sha2_256_init(atca_sha256_ctx_t* ctx);
 ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
+ATCA_STATUS atcab_hw_sha2_256_update_ext(ATCADevice device, atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
 ATCA_STATUS atcab_hw_sha2_256_finish(atca_sha256_ctx_t* ctx, uint8_t* digest);
+ATCA_STATUS atcab_hw_sha2_256_finish_ext(ATCADevice device, atca_sha256_ctx_t* ctx, uint8_t* digest);
+ATCA_STATUS atcab_sha_set_offload(atca_sha_offload_t policy, uint32_t threshold);
+ATCA_STATUS atcab_sha_set_offload_ext(ATCADevice device, atca_sha_offload_t policy, uint32_t threshold);
 ATCA_STATUS atcab_sha_hmac_init(atca_hmac_sha256_ctx_t* ctx, uint16_t key_slot);
 ATCA_STATUS atcab_sha_hmac_update(atca_hmac_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
 ATCA_STATUS atcab_sha_hmac_finish(atca_hmac_sha256_ctx_t* ctx, uint8_t* digest, uint8_t target);
+ATCA_STATUS atcab_sha_hmac_init_ext(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, uint16_t key_slot);
+ATCA_STATUS atcab_sha_hmac_update_ext(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
+ATCA_STATUS atcab_sha_hmac_finish_ext(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, uint8_t* digest, uint8_t target);
 
 ATCA_STATUS atcab_sha_hmac(const uint8_t* data, size_t data_size, uint16_t key_slot, uint8_t* digest, uint8_t target);
 ATCA_STATUS atcab_sha_hmac_ext(ATCADevice device, const uint8_t* data, size_t data_size, uint16_t key_slot, uint8_t* digest, uint8_t target);
@@ -599,6 +715,9 @@ ATCA_STATUS atcab_sha_hmac_ext(ATCADevice device, const uint8_t* data, size_t da
 ATCA_STATUS atcab_sign_base(uint8_t mode, uint16_t key_id, uint8_t* signature);
 ATCA_STATUS atcab_sign(uint16_t key_id, const uint8_t* msg, uint8_t* signature);
 ATCA_STATUS atcab_sign_ext(ATCADevice device, uint16_t key_id, const uint8_t* msg, uint8_t* signature);
+ATCA_STATUS atcab_sign_batch(uint16_t key_id, const uint8_t* msgs, size_t count, uint8_t* signatures, ATCA_STATUS* item_status);
+ATCA_STATUS atcab_sign_batch_ext(ATCADevice device, uint16_t key_id, const uint8_t* msgs, size_t count, uint8_t* signatures,
+                                 ATCA_STATUS* item_status);
 ATCA_STATUS atcab_sign_internal(uint16_t key_id, bool is_invalidate, bool is_full_sn, uint8_t* signature);
 
 /* UpdateExtra command */
@@ -619,9 +738,13 @@ ATCA_STATUS atcab_verify_invalidate(uint16_t key_id, const uint8_t* signature, c
 /* Write command functions */
 ATCA_STATUS atcab_write(uint8_t zone, uint16_t address, const uint8_t* value, const uint8_t* mac);
 ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t* data, uint8_t len);
+ATCA_STATUS atcab_write_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t* data, uint8_t len);
 ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t* data, size_t length);
+ATCA_STATUS atcab_write_bytes_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t* data, size_t length);
 ATCA_STATUS atcab_write_pubkey(uint16_t slot, const uint8_t* public_key);
+ATCA_STATUS atcab_write_pubkey_ext(ATCADevice device, uint16_t slot, const uint8_t* public_key);
 ATCA_STATUS atcab_write_config_zone(const uint8_t* config_data);
+ATCA_STATUS atcab_write_config_zone_ext(ATCADevice device, const uint8_t* config_data);
 
 #if defined(ATCA_USE_CONSTANT_HOST_NONCE)
 ATCA_STATUS atcab_write_enc(uint16_t key_id, uint8_t block, const uint8_t* data, const uint8_t* enc_key, const uint16_t enc_key_id);
@@ -70,7 +70,7 @@ ATCAIfaceCfg cfg_ateccx08a_swi_default = {
 };
 #endif
 
-#if defined(ATCA_ECC_SUPPORT) && defined(ATCA_HAL_KIT_CDC)
+#if defined(ATCA_ECC_SUPPORT) && (defined(ATCA_HAL_KIT_CDC) || defined(ATCA_HAL_KIT_UART))
 /** \brief default configuration for Kit protocol over the device's async interface */
 ATCAIfaceCfg cfg_ateccx08a_kitcdc_default = {
     .iface_type             = ATCA_UART_IFACE,
@@ -134,7 +134,7 @@ ATCAIfaceCfg cfg_atsha20xa_swi_default = {
 };
 #endif
 
-#if defined(ATCA_SHA_SUPPORT) && defined(ATCA_HAL_KIT_CDC)
+#if defined(ATCA_SHA_SUPPORT) && (defined(ATCA_HAL_KIT_CDC) || defined(ATCA_HAL_KIT_UART))
 /** \brief default configuration for Kit protocol over the device's async interface */
 ATCAIfaceCfg cfg_atsha20xa_kitcdc_default = {
     .iface_type            = ATCA_UART_IFACE,
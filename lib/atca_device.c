@@ -105,6 +105,21 @@ ATCA_STATUS initATCADevice(ATCAIfaceCfg *cfg, ATCADevice ca_dev)
         return status;
     }
 
+    ca_dev->keep_awake = 0;
+    ca_dev->awake_budget_msec = 0;
+    ca_dev->awake_msec = 0;
+#ifdef ATCA_HAL_CLOCK
+    ca_dev->awake_time = 0;
+#endif
+    ca_dev->sha_offload = 0;
+    ca_dev->sha_offload_threshold = 0;
+
+#ifdef ATCA_POLL_ADAPTIVE
+    /* Execution times are learned again for whatever device this now is */
+    memset(ca_dev->poll_estimates, 0, sizeof(ca_dev->poll_estimates));
+    ca_dev->poll_replace_idx = 0;
+#endif
+
     return ATCA_SUCCESS;
 }
 
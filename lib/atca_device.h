@@ -140,6 +140,20 @@ typedef enum
     ATCA_DEVICE_STATE_ACTIVE
 } ATCADeviceState;
 
+#ifdef ATCA_POLL_ADAPTIVE
+#ifndef ATCA_POLL_ADAPTIVE_ENTRIES
+#define ATCA_POLL_ADAPTIVE_ENTRIES      (12)
+#endif
+
+/** \brief Learned completion time of a command used to schedule polling
+ */
+typedef struct
+{
+    uint8_t  opcode;                    /**< Command opcode (0 for an unused entry) */
+    uint16_t estimate;                  /**< Expected completion time in 1/8 msec units */
+} atca_poll_estimate_t;
+#endif
+
 
 /** \brief atca_device is the C object backing ATCADevice.  See the atca_device.h file for
  * details on the ATCADevice methods
@@ -160,6 +174,20 @@ struct atca_device
 
     uint16_t options;                   /**< Nested command details parameter */
 
+    uint8_t  keep_awake;                /**< Nesting count of keep-awake sessions */
+    uint16_t awake_budget_msec;         /**< Device time allowed after a wake in a keep-awake session - 0 for the default */
+    uint32_t awake_msec;                /**< Device time in msec since the device was last woken */
+#ifdef ATCA_HAL_CLOCK
+    uint32_t awake_time;                /**< hal_get_time_ms when the device was last woken */
+#endif
+
+    uint8_t  sha_offload;               /**< atca_sha_offload_t policy of calib_hw_sha2_256 */
+    uint32_t sha_offload_threshold;     /**< Messages shorter than this are always hashed by the device */
+
+#ifdef ATCA_POLL_ADAPTIVE
+    atca_poll_estimate_t poll_estimates[ATCA_POLL_ADAPTIVE_ENTRIES]; /**< Per command polling schedule */
+    uint8_t              poll_replace_idx;                           /**< Next entry to reuse when the schedule is full */
+#endif
 };
 
 typedef struct atca_device * ATCADevice;
@@ -336,7 +336,8 @@ bool atca_iface_is_kit(ATCAIface ca_iface)
 
     if (ca_iface && ca_iface->mIfaceCFG)
     {
-        if (ATCA_HID_IFACE == ca_iface->mIfaceCFG->iface_type || ATCA_KIT_IFACE == ca_iface->mIfaceCFG->iface_type)
+        if (ATCA_HID_IFACE == ca_iface->mIfaceCFG->iface_type || ATCA_KIT_IFACE == ca_iface->mIfaceCFG->iface_type
+            || ATCA_UART_IFACE == ca_iface->mIfaceCFG->iface_type)
         {
             ret = true;
         }
@@ -0,0 +1,589 @@
+/**
+ * \file
+ * \brief Routes requests across several CryptoAuth devices so they execute
+ *        concurrently
+ *
+ * Every device has a queue of requests. Requests are placed on the queue with
+ * the least expected device time outstanding and atca_router_run executes the
+ * commands at the head of every queue at the same time with the asynchronous
+ * calib API, sleeping until the next response is due on any device.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include "atca_router.h"
+
+#if ATCA_CA_SUPPORT
+
+/** \brief Expected time a command takes on a device */
+static uint32_t atca_router_cmd_cost(ATCADevice device, uint8_t opcode)
+{
+#if defined(ATCA_POLL_ADAPTIVE)
+    uint32_t estimate;
+
+    if (ATCA_SUCCESS == calib_poll_get_estimate(device, opcode, &estimate))
+    {
+        return estimate;
+    }
+#endif
+#if defined(ATCA_NO_POLL) || defined(ATCA_POLL_ADAPTIVE)
+    if (ATCA_SUCCESS == calib_get_execution_time(opcode, device))
+    {
+        return device->execution_time_msec;
+    }
+#else
+    ((void)device);
+    ((void)opcode);
+#endif
+    return 1;
+}
+
+/** \brief Check if two devices are addressed on the same I2C bus */
+static bool atca_router_same_bus(ATCADevice a, ATCADevice b)
+{
+    const ATCAIfaceCfg* cfg_a = a->mIface.mIfaceCFG;
+    const ATCAIfaceCfg* cfg_b = b->mIface.mIfaceCFG;
+
+    return cfg_a && cfg_b && (ATCA_I2C_IFACE == cfg_a->iface_type) && (ATCA_I2C_IFACE == cfg_b->iface_type)
+           && (cfg_a->atcai2c.bus == cfg_b->atcai2c.bus) && (cfg_a->cfg_data == cfg_b->cfg_data);
+}
+
+/** \brief Expected time a request takes on a device */
+static uint32_t atca_router_req_cost(ATCADevice device, atca_router_op_t op)
+{
+    switch (op)
+    {
+    case ATCA_ROUTER_SIGN:
+        return atca_router_cmd_cost(device, ATCA_RANDOM) + atca_router_cmd_cost(device, ATCA_NONCE)
+               + atca_router_cmd_cost(device, ATCA_SIGN);
+    case ATCA_ROUTER_ECDH:
+        return atca_router_cmd_cost(device, ATCA_ECDH);
+    default:
+        return atca_router_cmd_cost(device, ATCA_RANDOM);
+    }
+}
+
+/** \brief Build the packet for the current stage of a request
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS atca_router_build(atca_router_worker_t* worker, atca_router_req_t* req)
+{
+    ATCAPacket* packet = &worker->packet;
+    ATCADeviceType device_type = atcab_get_device_type_ext(worker->device);
+    bool msgdigbuf = (ATECC608 == device_type);
+
+    switch (req->op)
+    {
+    case ATCA_ROUTER_SIGN:
+        if (0 == req->stage)
+        {
+            // Make sure RNG has updated its seed
+            packet->param1 = RANDOM_SEED_UPDATE;
+            packet->param2 = 0x0000;
+            return atRandom(device_type, packet);
+        }
+        else if (1 == req->stage)
+        {
+            // Use the Message Digest Buffer for the ATECC608
+            packet->param1 = NONCE_MODE_PASSTHROUGH | (msgdigbuf ? NONCE_MODE_TARGET_MSGDIGBUF : NONCE_MODE_TARGET_TEMPKEY);
+            packet->param2 = 0x0000;
+            memcpy(packet->data, req->input, ATCA_SHA256_DIGEST_SIZE);
+            return atNonce(device_type, packet);
+        }
+        else
+        {
+            packet->param1 = SIGN_MODE_EXTERNAL | (msgdigbuf ? SIGN_MODE_SOURCE_MSGDIGBUF : SIGN_MODE_SOURCE_TEMPKEY);
+            packet->param2 = req->key_id;
+            return atSign(device_type, packet);
+        }
+
+    case ATCA_ROUTER_ECDH:
+        packet->param1 = ECDH_PREFIX_MODE;
+        packet->param2 = req->key_id;
+        memcpy(packet->data, req->input, ATCA_PUB_KEY_SIZE);
+        return atECDH(device_type, packet);
+
+    case ATCA_ROUTER_RANDOM:
+        packet->param1 = RANDOM_SEED_UPDATE;
+        packet->param2 = 0x0000;
+        return atRandom(device_type, packet);
+
+    default:
+        return ATCA_TRACE(ATCA_BAD_PARAM, "Unknown router operation");
+    }
+}
+
+/** \brief Handle a completed command - returns true once the whole request is complete */
+static bool atca_router_step(atca_router_worker_t* worker, atca_router_req_t* req, ATCA_STATUS status)
+{
+    const uint8_t* rsp = &worker->packet.data[ATCA_RSP_DATA_IDX];
+    uint8_t count = worker->packet.data[ATCA_COUNT_IDX];
+
+    if (ATCA_SUCCESS == status)
+    {
+        switch (req->op)
+        {
+        case ATCA_ROUTER_SIGN:
+            if (req->stage < 2)
+            {
+                req->stage++;
+                return false;
+            }
+            if (count < ATCA_SIG_SIZE + 3)
+            {
+                status = ATCA_TRACE(ATCA_RX_FAIL, "Unexpected response size");
+                break;
+            }
+            memcpy(req->output, rsp, ATCA_SIG_SIZE);
+            break;
+
+        case ATCA_ROUTER_ECDH:
+            if (count < ATCA_KEY_SIZE + 3)
+            {
+                status = ATCA_TRACE(ATCA_RX_FAIL, "Unexpected response size");
+                break;
+            }
+            memcpy(req->output, rsp, ATCA_KEY_SIZE);
+            break;
+
+        default:
+            if (count != RANDOM_RSP_SIZE)
+            {
+                status = ATCA_TRACE(ATCA_RX_FAIL, "Unexpected response size");
+                break;
+            }
+            memcpy(req->output, rsp, RANDOM_NUM_SIZE);
+            break;
+        }
+    }
+
+    req->status = status;
+    return true;
+}
+
+/** \brief Remove the request at the head of a worker's queue and report it */
+static void atca_router_complete(atca_router_worker_t* worker)
+{
+    atca_router_req_t* req = worker->head;
+
+    worker->head = req->next;
+    if (!worker->head)
+    {
+        worker->tail = NULL;
+    }
+    worker->load = (worker->load > req->cost) ? worker->load - req->cost : 0;
+    worker->completed++;
+    req->next = NULL;
+
+    if (req->callback)
+    {
+        req->callback(req);
+    }
+}
+
+/** \brief Start the next command for a worker if it is not already busy */
+static void atca_router_start(atca_router_worker_t* worker)
+{
+    ATCA_STATUS status;
+
+    while (!worker->busy && worker->head)
+    {
+        if (ATCA_SUCCESS == (status = atca_router_build(worker, worker->head)))
+        {
+            status = calib_async_submit(&worker->cmd, worker->device, &worker->packet, NULL, NULL);
+        }
+
+        if (ATCA_SUCCESS == status)
+        {
+            worker->busy = true;
+            if (worker->shared_bus)
+            {
+                /* Polls before the command can be done take the bus from the other devices */
+                (void)calib_async_defer(&worker->cmd, atca_router_cmd_cost(worker->device, worker->packet.opcode));
+            }
+        }
+        else
+        {
+            worker->head->status = status;
+            atca_router_complete(worker);
+        }
+    }
+}
+
+/** \brief Initialize a router with no devices
+ *  \param[out] router  Router to initialize
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_router_init(atca_router_t* router)
+{
+    if (!router)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    memset(router, 0, sizeof(*router));
+    return hal_create_mutex(&router->mutex, NULL);
+}
+
+/** \brief Release a router and the devices it created. Queued requests are
+ *         abandoned.
+ *  \param[in] router  Router to release
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_router_release(atca_router_t* router)
+{
+    size_t i;
+
+    if (!router)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    for (i = 0; i < router->count; i++)
+    {
+#ifndef ATCA_NO_HEAP
+        if (router->workers[i].owned)
+        {
+            (void)atcab_release_ext(&router->workers[i].device);
+        }
+#endif
+        router->workers[i].device = NULL;
+    }
+    router->count = 0;
+
+    if (router->mutex)
+    {
+        (void)hal_destroy_mutex(router->mutex);
+        router->mutex = NULL;
+    }
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Add an initialized device to the router. The caller keeps ownership
+ *         of the device but must not use it directly while the router is in use.
+ *  \param[in] router  Router to add the device to
+ *  \param[in] device  Device to add
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_router_add_device(atca_router_t* router, ATCADevice device)
+{
+    ATCA_STATUS status;
+
+    if (!router || !device)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (ATCA_SUCCESS != (status = hal_lock_mutex(router->mutex)))
+    {
+        return status;
+    }
+
+    if (router->count < ATCA_ROUTER_MAX_DEVICES)
+    {
+        atca_router_worker_t* worker = &router->workers[router->count];
+        size_t i;
+
+        memset(worker, 0, sizeof(*worker));
+        worker->device = device;
+        for (i = 0; i < router->count; i++)
+        {
+            if (atca_router_same_bus(router->workers[i].device, device))
+            {
+                router->workers[i].shared_bus = true;
+                worker->shared_bus = true;
+            }
+        }
+        router->count++;
+    }
+    else
+    {
+        status = ATCA_TRACE(ATCA_ALLOC_FAILURE, "Router is full");
+    }
+
+    (void)hal_unlock_mutex(router->mutex);
+
+    return status;
+}
+
+#ifndef ATCA_NO_HEAP
+/** \brief Create a device from an interface configuration and add it to the
+ *         router. The device is released with the router.
+ *  \param[in] router  Router to add the device to
+ *  \param[in] cfg     Interface configuration - must remain valid while the
+ *                     router is in use
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_router_add_cfg(atca_router_t* router, ATCAIfaceCfg* cfg)
+{
+    ATCA_STATUS status;
+    ATCADevice device = NULL;
+
+    if (!router || !cfg)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (ATCA_SUCCESS != (status = atcab_init_ext(&device, cfg)))
+    {
+        (void)atcab_release_ext(&device);
+        return ATCA_TRACE(status, "Device initialization failed");
+    }
+
+    if (ATCA_SUCCESS != (status = atca_router_add_device(router, device)))
+    {
+        (void)atcab_release_ext(&device);
+        return status;
+    }
+
+    router->workers[router->count - 1].owned = true;
+
+    return ATCA_SUCCESS;
+}
+#endif
+
+/** \brief Queue a request on the device with the least outstanding work.
+ *         Requests execute when atca_router_run is called.
+ *  \param[in] router  Router to queue the request on
+ *  \param[in] req     Request with op, key_id, input, output and optionally
+ *                     callback and user_data set
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_router_submit(atca_router_t* router, atca_router_req_t* req)
+{
+    ATCA_STATUS status;
+    atca_router_worker_t* worker = NULL;
+    size_t i;
+
+    if (!router || !req || !req->output || (ATCA_ROUTER_RANDOM != req->op && !req->input))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (ATCA_SUCCESS != (status = hal_lock_mutex(router->mutex)))
+    {
+        return status;
+    }
+
+    for (i = 0; i < router->count; i++)
+    {
+        if (!worker || router->workers[i].load < worker->load)
+        {
+            worker = &router->workers[i];
+            req->device_idx = i;
+        }
+    }
+
+    if (worker)
+    {
+        req->status = ATCA_RX_NO_RESPONSE;
+        req->stage = 0;
+        req->cost = atca_router_req_cost(worker->device, req->op);
+        req->next = NULL;
+
+        if (worker->tail)
+        {
+            worker->tail->next = req;
+        }
+        else
+        {
+            worker->head = req;
+        }
+        worker->tail = req;
+        worker->load += req->cost;
+    }
+    else
+    {
+        status = ATCA_TRACE(ATCA_NO_DEVICES, "No devices added to the router");
+    }
+
+    (void)hal_unlock_mutex(router->mutex);
+
+    return status;
+}
+
+/** \brief Execute queued requests on all devices concurrently until every
+ *         queue is empty. Requests may be submitted from other threads while
+ *         this runs. Only one thread runs the router at a time - if another
+ *         thread is already running it this waits for that thread to finish
+ *         and then runs whatever is still queued.
+ *  \param[in] router  Router to run
+ *  \return ATCA_SUCCESS on success, otherwise an error code. The result of
+ *          each request is held in its status.
+ */
+ATCA_STATUS atca_router_run(atca_router_t* router)
+{
+    ATCA_STATUS status;
+    atca_router_worker_t* worker;
+    uint32_t delay = 0;
+    bool pending;
+    size_t i;
+
+    if (!router)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    /* Requests only execute from the thread that runs the router */
+    while (1)
+    {
+        if (ATCA_SUCCESS != (status = hal_lock_mutex(router->mutex)))
+        {
+            return status;
+        }
+        if (!router->running)
+        {
+            router->running = true;
+            break;
+        }
+        (void)hal_unlock_mutex(router->mutex);
+        atca_delay_ms(ATCA_POLLING_FREQUENCY_TIME_MSEC);
+    }
+
+    do
+    {
+        pending = false;
+        for (i = 0; i < router->count; i++)
+        {
+            worker = &router->workers[i];
+
+            if (worker->busy && ATCA_RX_NO_RESPONSE != (status = calib_async_poll(&worker->cmd, delay)))
+            {
+                worker->busy = false;
+                if (atca_router_step(worker, worker->head, status))
+                {
+                    atca_router_complete(worker);
+                }
+            }
+
+            atca_router_start(worker);
+            pending |= worker->busy;
+        }
+
+        if (pending)
+        {
+            /* Sleep until the earliest poll that is due */
+            delay = ATCA_POLLING_MAX_TIME_MSEC;
+            for (i = 0; i < router->count; i++)
+            {
+                worker = &router->workers[i];
+                if (worker->busy && calib_async_get_delay(&worker->cmd) < delay)
+                {
+                    delay = calib_async_get_delay(&worker->cmd);
+                }
+            }
+
+            (void)hal_unlock_mutex(router->mutex);
+            atca_delay_ms(delay);
+            if (ATCA_SUCCESS != (status = hal_lock_mutex(router->mutex)))
+            {
+                router->running = false;
+                return status;
+            }
+        }
+    }
+    while (pending);
+
+    router->running = false;
+    (void)hal_unlock_mutex(router->mutex);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Run a single request through the router and wait for the result.
+ *         Safe to call from several threads at once - the request is either
+ *         executed by the thread already running the router or by this one
+ *         once that thread has finished.
+ */
+static ATCA_STATUS atca_router_execute(atca_router_t* router, atca_router_req_t* req)
+{
+    ATCA_STATUS status;
+
+    if (ATCA_SUCCESS == (status = atca_router_submit(router, req)))
+    {
+        if (ATCA_SUCCESS == (status = atca_router_run(router)))
+        {
+            status = req->status;
+        }
+    }
+    return status;
+}
+
+/** \brief Sign a 32 byte digest on the least loaded device
+ *  \param[in]  router     Router to execute the request on
+ *  \param[in]  key_id     Slot of the private key
+ *  \param[in]  msg        32 byte digest to sign
+ *  \param[out] signature  64 byte signature (R and S)
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_router_sign(atca_router_t* router, uint16_t key_id, const uint8_t* msg, uint8_t* signature)
+{
+    atca_router_req_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.op = ATCA_ROUTER_SIGN;
+    req.key_id = key_id;
+    req.input = msg;
+    req.output = signature;
+
+    return atca_router_execute(router, &req);
+}
+
+/** \brief ECDH with a private key on the least loaded device
+ *  \param[in]  router      Router to execute the request on
+ *  \param[in]  key_id      Slot of the private key
+ *  \param[in]  public_key  64 byte peer public key (X and Y)
+ *  \param[out] pms         32 byte premaster secret
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_router_ecdh(atca_router_t* router, uint16_t key_id, const uint8_t* public_key, uint8_t* pms)
+{
+    atca_router_req_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.op = ATCA_ROUTER_ECDH;
+    req.key_id = key_id;
+    req.input = public_key;
+    req.output = pms;
+
+    return atca_router_execute(router, &req);
+}
+
+/** \brief Get 32 random bytes from the least loaded device
+ *  \param[in]  router    Router to execute the request on
+ *  \param[out] rand_out  32 bytes of random data
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atca_router_random(atca_router_t* router, uint8_t* rand_out)
+{
+    atca_router_req_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.op = ATCA_ROUTER_RANDOM;
+    req.output = rand_out;
+
+    return atca_router_execute(router, &req);
+}
+
+#endif /* ATCA_CA_SUPPORT */
@@ -0,0 +1,137 @@
+/**
+ * \file
+ * \brief Routes requests across several CryptoAuth devices so they execute
+ *        concurrently
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#ifndef ATCA_ROUTER_H_
+#define ATCA_ROUTER_H_
+
+#include "cryptoauthlib.h"
+
+/** \defgroup atca_router_ Multi-device request router (atca_router_)
+ *
+ * The router owns a set of devices, each with its own queue of requests.
+ * New requests go to the device with the least outstanding work and the
+ * commands for every device are run concurrently from a single thread using
+ * the asynchronous calib API. Work is measured in the expected execution
+ * time of each command.
+ *
+ * Devices at different addresses on the same I2C bus compute independently,
+ * so the router interleaves their commands on the bus. A command on a shared
+ * bus isn't polled until its expected execution time has passed, leaving the
+ * bus free to send commands to and read responses from the other devices.
+ *
+ * Any thread may submit requests, run the router or call the blocking
+ * wrappers. Only one thread at a time executes the queued requests and the
+ * others wait for it, so the devices are never driven from two threads.
+ * @{
+ */
+
+#if ATCA_CA_SUPPORT
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ATCA_ROUTER_MAX_DEVICES
+#define ATCA_ROUTER_MAX_DEVICES     (8)
+#endif
+
+typedef enum
+{
+    ATCA_ROUTER_SIGN,       /**< ECDSA sign of a 32 byte digest with a private key slot */
+    ATCA_ROUTER_ECDH,       /**< ECDH with a private key slot returning the premaster secret */
+    ATCA_ROUTER_RANDOM      /**< 32 random bytes */
+} atca_router_op_t;
+
+typedef struct atca_router_req atca_router_req_t;
+typedef void (*atca_router_cb_t)(atca_router_req_t* req);
+
+/** \brief A request queued on the router. The caller owns the memory, which
+ *         must remain valid until the request completes.
+ */
+struct atca_router_req
+{
+    atca_router_op_t   op;          /**< Operation to perform */
+    uint16_t           key_id;      /**< Key slot for sign and ECDH */
+    const uint8_t*     input;       /**< Digest to sign (32 bytes) or peer public key (64 bytes) */
+    uint8_t*           output;      /**< Signature (64 bytes), premaster secret or random (32 bytes) */
+    atca_router_cb_t   callback;    /**< Optional function called once the request completes */
+    void*              user_data;   /**< Caller context for the callback */
+
+    ATCA_STATUS        status;      /**< ATCA_RX_NO_RESPONSE while queued or executing then the result */
+    size_t             device_idx;  /**< Device the request was routed to */
+    uint8_t            stage;       /**< Command within the operation being executed */
+    uint32_t           cost;        /**< Expected device time in msec */
+    atca_router_req_t* next;
+};
+
+/** \brief A device with its queue of requests */
+typedef struct
+{
+    ATCADevice         device;
+    bool               owned;       /**< Device was created by the router */
+    atca_router_req_t* head;        /**< Request executing or next to execute */
+    atca_router_req_t* tail;
+    uint32_t           load;        /**< Expected device time in msec of the queued requests */
+    uint32_t           completed;   /**< Requests completed by the device */
+    bool               busy;        /**< A command is executing */
+    bool               shared_bus;  /**< Other devices of the router are on the same bus */
+    ATCAPacket         packet;
+    calib_async_cmd_t  cmd;
+} atca_router_worker_t;
+
+typedef struct
+{
+    atca_router_worker_t workers[ATCA_ROUTER_MAX_DEVICES];
+    size_t               count;
+    void*                mutex;
+    bool                 running;   /**< A thread is executing the queued requests */
+} atca_router_t;
+
+ATCA_STATUS atca_router_init(atca_router_t* router);
+ATCA_STATUS atca_router_release(atca_router_t* router);
+ATCA_STATUS atca_router_add_device(atca_router_t* router, ATCADevice device);
+#ifndef ATCA_NO_HEAP
+ATCA_STATUS atca_router_add_cfg(atca_router_t* router, ATCAIfaceCfg* cfg);
+#endif
+
+ATCA_STATUS atca_router_submit(atca_router_t* router, atca_router_req_t* req);
+ATCA_STATUS atca_router_run(atca_router_t* router);
+
+ATCA_STATUS atca_router_sign(atca_router_t* router, uint16_t key_id, const uint8_t* msg, uint8_t* signature);
+ATCA_STATUS atca_router_ecdh(atca_router_t* router, uint16_t key_id, const uint8_t* public_key, uint8_t* pms);
+ATCA_STATUS atca_router_random(atca_router_t* router, uint8_t* rand_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATCA_CA_SUPPORT */
+
+/** @} */
+
+#endif /* ATCA_ROUTER_H_ */
@@ -93,7 +93,7 @@ SIZE_OF_API_S(atca_device)
 SIZE_OF_API_T(ATCADeviceType)
 
 /* calib_execution.h */
-#ifdef ATCA_NO_POLL
+#if defined(ATCA_NO_POLL) || defined(ATCA_POLL_ADAPTIVE)
 #include "calib/calib_execution.h"
 SIZE_OF_API_T(device_execution_time_t)
 #endif
@@ -0,0 +1,424 @@
+/**
+ * \file
+ * \brief Cache of certificates rebuilt from the device so they don't have to
+ *        be read and rebuilt for every request.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include "atcacert_cache.h"
+#include "atcacert_client.h"
+#include "cryptoauthlib.h"
+#include "crypto/atca_crypto_sw_sha2.h"
+
+#ifdef ATCA_CERT_CACHE
+
+#define ATCACERT_CACHE_FILE_MAGIC       (0x31434341)    /* "ACC1" */
+
+typedef struct atcacert_cache_entry_s
+{
+    uint8_t              in_use;
+    uint32_t             last_used;
+    atcacert_cache_key_t key;
+    uint16_t             cert_size;
+    uint8_t              cert[ATCACERT_CACHE_CERT_MAX_SIZE];
+} atcacert_cache_entry_t;
+
+typedef struct atcacert_cache_file_header_s
+{
+    uint32_t magic;
+    uint32_t entry_count;
+    uint32_t entry_size;
+} atcacert_cache_file_header_t;
+
+static atcacert_cache_entry_t atcacert_cache_entries[ATCACERT_CACHE_ENTRIES];
+static atcacert_cache_stats_t atcacert_cache_stats;
+static uint32_t atcacert_cache_use_count;
+static void* atcacert_cache_mutex;
+static uint32_t atcacert_cache_users;
+
+/* The entries are only touched with the lock held - until atcacert_cache_init
+   creates it the cache is not used at all */
+static bool atcacert_cache_lock(void)
+{
+    return atcacert_cache_mutex && ATCA_SUCCESS == hal_lock_mutex(atcacert_cache_mutex);
+}
+
+static void atcacert_cache_unlock(void)
+{
+    (void)hal_unlock_mutex(atcacert_cache_mutex);
+}
+
+int atcacert_cache_init(void)
+{
+    if (!atcacert_cache_mutex && ATCA_SUCCESS != hal_create_mutex(&atcacert_cache_mutex, NULL))
+    {
+        atcacert_cache_mutex = NULL;
+        return ATCACERT_E_ERROR;
+    }
+    atcacert_cache_users++;
+
+    return ATCACERT_E_SUCCESS;
+}
+
+void atcacert_cache_release(void)
+{
+    if (atcacert_cache_users && 0 == --atcacert_cache_users)
+    {
+        (void)hal_destroy_mutex(atcacert_cache_mutex);
+        atcacert_cache_mutex = NULL;
+    }
+}
+
+bool atcacert_cache_enabled(void)
+{
+    return NULL != atcacert_cache_mutex;
+}
+
+/* The definition is hashed field by field in a fixed byte order so neither
+   padding nor the width of an enum changes the key */
+static void atcacert_cache_hash_u16(atcac_sha2_256_ctx* ctx, uint16_t value)
+{
+    uint8_t bytes[2];
+
+    bytes[0] = (uint8_t)(value & 0xFF);
+    bytes[1] = (uint8_t)(value >> 8);
+    (void)atcac_sw_sha2_256_update(ctx, bytes, sizeof(bytes));
+}
+
+static void atcacert_cache_hash_u8(atcac_sha2_256_ctx* ctx, uint8_t value)
+{
+    (void)atcac_sw_sha2_256_update(ctx, &value, sizeof(value));
+}
+
+static void atcacert_cache_hash_device_loc(atcac_sha2_256_ctx* ctx, const atcacert_device_loc_t* loc)
+{
+    atcacert_cache_hash_u8(ctx, (uint8_t)loc->zone);
+    atcacert_cache_hash_u8(ctx, loc->slot);
+    atcacert_cache_hash_u8(ctx, loc->is_genkey);
+    atcacert_cache_hash_u16(ctx, loc->offset);
+    atcacert_cache_hash_u16(ctx, loc->count);
+}
+
+static void atcacert_cache_hash_cert_loc(atcac_sha2_256_ctx* ctx, const atcacert_cert_loc_t* loc)
+{
+    atcacert_cache_hash_u16(ctx, loc->offset);
+    atcacert_cache_hash_u16(ctx, loc->count);
+}
+
+static void atcacert_cache_hash_element(atcac_sha2_256_ctx* ctx, const atcacert_cert_element_t* element)
+{
+    const char* id_end = memchr(element->id, 0, sizeof(element->id));
+    size_t id_len = id_end ? (size_t)(id_end - element->id) : sizeof(element->id);
+    size_t i;
+
+    /* Nothing past the end of the id string is part of the element */
+    atcacert_cache_hash_u8(ctx, (uint8_t)id_len);
+    (void)atcac_sw_sha2_256_update(ctx, (const uint8_t*)element->id, id_len);
+    atcacert_cache_hash_device_loc(ctx, &element->device_loc);
+    atcacert_cache_hash_cert_loc(ctx, &element->cert_loc);
+    for (i = 0; i < ATCA_MAX_TRANSFORMS; i++)
+    {
+        atcacert_cache_hash_u8(ctx, (uint8_t)element->transforms[i]);
+    }
+}
+
+int atcacert_cache_get_key(ATCADevice            device,
+                           const atcacert_def_t* cert_def,
+                           const uint8_t         ca_public_key[64],
+                           atcacert_cache_key_t* key)
+{
+    atcac_sha2_256_ctx ctx;
+    uint8_t has_ca_key = ca_public_key ? 1 : 0;
+    size_t i;
+    int ret;
+
+    if (!device || !cert_def || !key || cert_def->comp_cert_dev_loc.count > sizeof(key->comp_cert))
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    memset(key, 0, sizeof(*key));
+
+    /* Every field that decides how the certificate is rebuilt */
+    (void)atcac_sw_sha2_256_init(&ctx);
+    atcacert_cache_hash_u8(&ctx, (uint8_t)cert_def->type);
+    atcacert_cache_hash_u8(&ctx, cert_def->template_id);
+    atcacert_cache_hash_u8(&ctx, cert_def->chain_id);
+    atcacert_cache_hash_u8(&ctx, cert_def->private_key_slot);
+    atcacert_cache_hash_u8(&ctx, (uint8_t)cert_def->sn_source);
+    atcacert_cache_hash_device_loc(&ctx, &cert_def->cert_sn_dev_loc);
+    atcacert_cache_hash_u8(&ctx, (uint8_t)cert_def->issue_date_format);
+    atcacert_cache_hash_u8(&ctx, (uint8_t)cert_def->expire_date_format);
+    atcacert_cache_hash_cert_loc(&ctx, &cert_def->tbs_cert_loc);
+    atcacert_cache_hash_u8(&ctx, cert_def->expire_years);
+    atcacert_cache_hash_device_loc(&ctx, &cert_def->public_key_dev_loc);
+    atcacert_cache_hash_device_loc(&ctx, &cert_def->comp_cert_dev_loc);
+    for (i = 0; i < STDCERT_NUM_ELEMENTS; i++)
+    {
+        atcacert_cache_hash_cert_loc(&ctx, &cert_def->std_cert_elements[i]);
+    }
+    atcacert_cache_hash_u8(&ctx, cert_def->cert_elements ? cert_def->cert_elements_count : 0);
+    for (i = 0; cert_def->cert_elements && i < cert_def->cert_elements_count; i++)
+    {
+        atcacert_cache_hash_element(&ctx, &cert_def->cert_elements[i]);
+    }
+    atcacert_cache_hash_u16(&ctx, cert_def->cert_template ? cert_def->cert_template_size : 0);
+    if (cert_def->cert_template)
+    {
+        (void)atcac_sw_sha2_256_update(&ctx, cert_def->cert_template, cert_def->cert_template_size);
+    }
+    (void)atcac_sw_sha2_256_update(&ctx, &has_ca_key, sizeof(has_ca_key));
+    if (ca_public_key)
+    {
+        (void)atcac_sw_sha2_256_update(&ctx, ca_public_key, 64);
+    }
+    (void)atcac_sw_sha2_256_finish(&ctx, key->def_id);
+
+    if (ATCA_SUCCESS != (ret = atcab_read_serial_number_ext(device, key->serial_num)))
+    {
+        return ret;
+    }
+
+    return atcacert_read_device_loc_ext(device, &cert_def->comp_cert_dev_loc, key->comp_cert);
+}
+
+int atcacert_cache_get(const atcacert_cache_key_t* key,
+                       uint8_t*                    cert,
+                       size_t*                     cert_size)
+{
+    int ret = ATCACERT_E_ELEM_MISSING;
+    size_t i;
+
+    if (!key || !cert || !cert_size)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    if (!atcacert_cache_lock())
+    {
+        return ATCACERT_E_ELEM_MISSING;
+    }
+    for (i = 0; i < ATCACERT_CACHE_ENTRIES; i++)
+    {
+        atcacert_cache_entry_t* entry = &atcacert_cache_entries[i];
+
+        if (entry->in_use && !memcmp(&entry->key, key, sizeof(*key)))
+        {
+            atcacert_cache_stats.hits++;
+            entry->last_used = ++atcacert_cache_use_count;
+
+            if (*cert_size < entry->cert_size)
+            {
+                ret = ATCACERT_E_BUFFER_TOO_SMALL;
+            }
+            else
+            {
+                memcpy(cert, entry->cert, entry->cert_size);
+                *cert_size = entry->cert_size;
+                ret = ATCACERT_E_SUCCESS;
+            }
+            break;
+        }
+    }
+
+    if (ATCACERT_E_ELEM_MISSING == ret)
+    {
+        atcacert_cache_stats.misses++;
+    }
+    atcacert_cache_unlock();
+
+    return ret;
+}
+
+int atcacert_cache_put(const atcacert_cache_key_t* key,
+                       const uint8_t*              cert,
+                       size_t                      cert_size)
+{
+    atcacert_cache_entry_t* entry = &atcacert_cache_entries[0];
+    size_t i;
+
+    if (!key || !cert || !cert_size || cert_size > ATCACERT_CACHE_CERT_MAX_SIZE)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    if (!atcacert_cache_lock())
+    {
+        return ATCACERT_E_ERROR;
+    }
+
+    /* Reuse the entry of an older version of the same certificate, a free
+       entry or the one used least recently */
+    for (i = 0; i < ATCACERT_CACHE_ENTRIES; i++)
+    {
+        atcacert_cache_entry_t* candidate = &atcacert_cache_entries[i];
+
+        if (candidate->in_use && !memcmp(candidate->key.serial_num, key->serial_num, sizeof(key->serial_num))
+            && !memcmp(candidate->key.def_id, key->def_id, sizeof(key->def_id)))
+        {
+            entry = candidate;
+            break;
+        }
+        if (!candidate->in_use)
+        {
+            if (entry->in_use)
+            {
+                entry = candidate;
+            }
+        }
+        else if (entry->in_use && candidate->last_used < entry->last_used)
+        {
+            entry = candidate;
+        }
+    }
+
+    memcpy(&entry->key, key, sizeof(*key));
+    memcpy(entry->cert, cert, cert_size);
+    entry->cert_size = (uint16_t)cert_size;
+    entry->last_used = ++atcacert_cache_use_count;
+    entry->in_use = 1;
+
+    atcacert_cache_unlock();
+
+    return ATCACERT_E_SUCCESS;
+}
+
+void atcacert_cache_clear(void)
+{
+    if (atcacert_cache_lock())
+    {
+        memset(atcacert_cache_entries, 0, sizeof(atcacert_cache_entries));
+        atcacert_cache_unlock();
+    }
+}
+
+void atcacert_cache_get_stats(atcacert_cache_stats_t* stats)
+{
+    if (stats)
+    {
+        if (atcacert_cache_lock())
+        {
+            *stats = atcacert_cache_stats;
+            atcacert_cache_unlock();
+        }
+        else
+        {
+            memset(stats, 0, sizeof(*stats));
+        }
+    }
+}
+
+void atcacert_cache_reset_stats(void)
+{
+    if (atcacert_cache_lock())
+    {
+        memset(&atcacert_cache_stats, 0, sizeof(atcacert_cache_stats));
+        atcacert_cache_unlock();
+    }
+}
+
+int atcacert_cache_save(const char* filename)
+{
+    atcacert_cache_file_header_t header = { ATCACERT_CACHE_FILE_MAGIC, ATCACERT_CACHE_ENTRIES, sizeof(atcacert_cache_entry_t) };
+    int ret = ATCACERT_E_ERROR;
+    FILE* fp;
+
+    if (!filename)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    if (!atcacert_cache_lock())
+    {
+        return ATCACERT_E_ERROR;
+    }
+    if (NULL != (fp = fopen(filename, "wb")))
+    {
+        if (1 == fwrite(&header, sizeof(header), 1, fp)
+            && 1 == fwrite(atcacert_cache_entries, sizeof(atcacert_cache_entries), 1, fp))
+        {
+            ret = ATCACERT_E_SUCCESS;
+        }
+        if (fclose(fp))
+        {
+            ret = ATCACERT_E_ERROR;
+        }
+    }
+    atcacert_cache_unlock();
+
+    return ret;
+}
+
+int atcacert_cache_load(const char* filename)
+{
+    atcacert_cache_file_header_t header;
+    int ret = ATCACERT_E_ERROR;
+    FILE* fp;
+    size_t i;
+
+    if (!filename)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    if (!atcacert_cache_lock())
+    {
+        return ATCACERT_E_ERROR;
+    }
+    if (NULL != (fp = fopen(filename, "rb")))
+    {
+        /* Only a file written by a build with the same cache layout is used */
+        if (1 == fread(&header, sizeof(header), 1, fp) && ATCACERT_CACHE_FILE_MAGIC == header.magic
+            && ATCACERT_CACHE_ENTRIES == header.entry_count && sizeof(atcacert_cache_entry_t) == header.entry_size)
+        {
+            if (1 == fread(atcacert_cache_entries, sizeof(atcacert_cache_entries), 1, fp))
+            {
+                ret = ATCACERT_E_SUCCESS;
+            }
+            else
+            {
+                memset(atcacert_cache_entries, 0, sizeof(atcacert_cache_entries));
+            }
+        }
+        fclose(fp);
+    }
+
+    /* Continue the recency order of the loaded entries */
+    for (i = 0; ATCACERT_E_SUCCESS == ret && i < ATCACERT_CACHE_ENTRIES; i++)
+    {
+        if (atcacert_cache_entries[i].cert_size > ATCACERT_CACHE_CERT_MAX_SIZE)
+        {
+            atcacert_cache_entries[i].in_use = 0;
+        }
+        if (atcacert_cache_entries[i].last_used > atcacert_cache_use_count)
+        {
+            atcacert_cache_use_count = atcacert_cache_entries[i].last_used;
+        }
+    }
+    atcacert_cache_unlock();
+
+    return ret;
+}
+
+#endif /* ATCA_CERT_CACHE */
@@ -0,0 +1,180 @@
+/**
+ * \file
+ * \brief Cache of certificates rebuilt from the device so they don't have to
+ *        be read and rebuilt for every request.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#ifndef ATCACERT_CACHE_H
+#define ATCACERT_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "cryptoauthlib.h"
+#include "atcacert_def.h"
+
+// Inform function naming when compiling in C++
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup atcacert_ Certificate manipulation methods (atcacert_)
+ *
+   @{ */
+
+#ifdef ATCA_CERT_CACHE
+
+/** Number of certificates kept by the cache */
+#ifndef ATCACERT_CACHE_ENTRIES
+#define ATCACERT_CACHE_ENTRIES          (4)
+#endif
+
+/** Largest certificate in bytes the cache will keep */
+#ifndef ATCACERT_CACHE_CERT_MAX_SIZE
+#define ATCACERT_CACHE_CERT_MAX_SIZE    (1024)
+#endif
+
+/** Size of the compressed certificate stored on the device */
+#define ATCACERT_CACHE_COMP_CERT_SIZE   (72)
+
+/**
+ * \brief Identifies a certificate on a particular device. Certificates are
+ *        matched on the device serial number, a digest of the certificate
+ *        definition and CA public key used to rebuild it and the contents of the
+ *        compressed certificate slot, which change whenever the certificate is
+ *        rewritten.
+ */
+typedef struct atcacert_cache_key_s
+{
+    uint8_t serial_num[ATCA_SERIAL_NUM_SIZE];
+    uint8_t def_id[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t comp_cert[ATCACERT_CACHE_COMP_CERT_SIZE];
+} atcacert_cache_key_t;
+
+typedef struct atcacert_cache_stats_s
+{
+    uint32_t hits;      //!< Certificates returned from the cache
+    uint32_t misses;    //!< Certificates that had to be rebuilt from the device
+} atcacert_cache_stats_t;
+
+/**
+ * \brief Create the lock that guards the cache. Certificates are only cached
+ *        once this has been called, until the matching
+ *        atcacert_cache_release(). Calls are counted so the library and the
+ *        application may each hold the cache, but init and release themselves
+ *        are meant for start up and shut down and are not thread safe.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_cache_init(void);
+
+/** \brief Release a hold taken by atcacert_cache_init(). The lock is removed,
+ *         and the cache is no longer used, once every hold is released. */
+void atcacert_cache_release(void);
+
+/** \brief Check if the cache is in use - atcacert_cache_init() was called. */
+bool atcacert_cache_enabled(void);
+
+/**
+ * \brief Read the device serial number and compressed certificate that
+ *        identify a certificate in the cache.
+ *
+ * \param[in]  device         Device the certificate is read from.
+ * \param[in]  cert_def       Certificate definition.
+ * \param[in]  ca_public_key  CA public key passed to atcacert_read_cert (may be NULL).
+ * \param[out] key            Cache key is returned here.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_cache_get_key(ATCADevice            device,
+                           const atcacert_def_t* cert_def,
+                           const uint8_t         ca_public_key[64],
+                           atcacert_cache_key_t* key);
+
+/**
+ * \brief Get a certificate from the cache.
+ *
+ * \param[in]     key        Cache key from atcacert_cache_get_key().
+ * \param[out]    cert       Buffer to receive the certificate.
+ * \param[in,out] cert_size  As input, the size of the cert buffer in bytes.
+ *                           As output, the size of the certificate returned in cert in bytes.
+ *
+ * \return ATCACERT_E_SUCCESS on a hit, ATCACERT_E_ELEM_MISSING if the
+ *         certificate is not in the cache, otherwise an error code.
+ */
+int atcacert_cache_get(const atcacert_cache_key_t* key,
+                       uint8_t*                    cert,
+                       size_t*                     cert_size);
+
+/**
+ * \brief Add a certificate to the cache replacing the least recently used
+ *        entry if the cache is full.
+ *
+ * \param[in] key        Cache key from atcacert_cache_get_key().
+ * \param[in] cert       Certificate rebuilt from the device.
+ * \param[in] cert_size  Size of the certificate in bytes.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_cache_put(const atcacert_cache_key_t* key,
+                       const uint8_t*              cert,
+                       size_t                      cert_size);
+
+/** \brief Remove every certificate from the cache. Needed if a device location
+ *         used by a certificate other than the compressed certificate (e.g. a
+ *         signer public key) is changed outside of atcacert_write_cert. */
+void atcacert_cache_clear(void);
+
+void atcacert_cache_get_stats(atcacert_cache_stats_t* stats);
+void atcacert_cache_reset_stats(void);
+
+/**
+ * \brief Save the cached certificates to a file so they survive a restart.
+ *        Entries are still validated against the device when they are used.
+ *
+ * \param[in] filename  File to write.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_cache_save(const char* filename);
+
+/**
+ * \brief Replace the cache contents with certificates saved by
+ *        atcacert_cache_save().
+ *
+ * \param[in] filename  File to read.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_cache_load(const char* filename);
+
+#endif /* ATCA_CERT_CACHE */
+
+/** @} */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -30,6 +30,7 @@
 
 #include <stdlib.h>
 #include "atcacert_client.h"
+#include "atcacert_cache.h"
 #include "atcacert_der.h"
 #include "atcacert_pem.h"
 #include "cryptoauthlib.h"
@@ -56,8 +57,9 @@ int atcacert_get_response(uint8_t       device_private_key_slot,
     return atcab_sign(device_private_key_slot, challenge, response);
 }
 
-int atcacert_read_device_loc(const atcacert_device_loc_t* device_loc,
-                             uint8_t*                     data)
+int atcacert_read_device_loc_ext(ATCADevice                   device,
+                                 const atcacert_device_loc_t* device_loc,
+                                 uint8_t*                     data)
 {
     int ret = 0;
 
@@ -69,7 +71,7 @@ int atcacert_read_device_loc(const atcacert_device_loc_t* device_loc,
             return ATCACERT_E_BAD_PARAMS;
         }
 
-        ret = atcab_get_pubkey(device_loc->slot, public_key);
+        ret = atcab_get_pubkey_ext(device, device_loc->slot, public_key);
         if (ret != ATCA_SUCCESS)
         {
             return ret;
@@ -80,7 +82,7 @@ int atcacert_read_device_loc(const atcacert_device_loc_t* device_loc,
     {
         size_t count = device_loc->count;
         size_t zone_size;
-        ret = atcab_get_zone_size(device_loc->zone, device_loc->slot, &zone_size);
+        ret = atcab_get_zone_size_ext(device, device_loc->zone, device_loc->slot, &zone_size);
         if (ret != ATCA_SUCCESS)
         {
             return ret;
@@ -94,7 +96,8 @@ int atcacert_read_device_loc(const atcacert_device_loc_t* device_loc,
             count = zone_size - device_loc->offset;
         }
 
-        ret = atcab_read_bytes_zone(
+        ret = atcab_read_bytes_zone_ext(
+            device,
             device_loc->zone,
             device_loc->slot,
             device_loc->offset,
@@ -109,16 +112,74 @@ int atcacert_read_device_loc(const atcacert_device_loc_t* device_loc,
     return ATCACERT_E_SUCCESS;
 }
 
-int atcacert_read_cert(const atcacert_def_t* cert_def,
-                       const uint8_t         ca_public_key[64],
-                       uint8_t*              cert,
-                       size_t*               cert_size)
+int atcacert_read_device_loc(const atcacert_device_loc_t* device_loc,
+                             uint8_t*                     data)
+{
+    return atcacert_read_device_loc_ext(atcab_get_device(), device_loc, data);
+}
+
+/* atcacert_merge_device_loc only compares a new location against those already
+   in the list, so a location that bridges two earlier ones leaves them apart.
+   Join any locations of the same zone and slot that touch or overlap as long as
+   the result still fits in max_count bytes. */
+static void atcacert_coalesce_device_locs(atcacert_device_loc_t* device_locs,
+                                          size_t*                device_locs_count,
+                                          size_t                 max_count)
+{
+    bool merged = true;
+    size_t i;
+    size_t j;
+
+    while (merged)
+    {
+        merged = false;
+        for (i = 0; i < *device_locs_count && !merged; i++)
+        {
+            for (j = i + 1; j < *device_locs_count && !merged; j++)
+            {
+                atcacert_device_loc_t* a = &device_locs[i];
+                const atcacert_device_loc_t* b = &device_locs[j];
+                size_t a_end = (size_t)a->offset + a->count;
+                size_t b_end = (size_t)b->offset + b->count;
+                size_t offset = a->offset < b->offset ? a->offset : b->offset;
+                size_t end = a_end > b_end ? a_end : b_end;
+
+                if (a->zone != b->zone || b->offset > a_end || a->offset > b_end || end - offset > max_count)
+                {
+                    continue;
+                }
+                if (a->zone == DEVZONE_DATA && (a->slot != b->slot || a->is_genkey != b->is_genkey))
+                {
+                    continue;
+                }
+
+                a->offset = (uint16_t)offset;
+                a->count = (uint16_t)(end - offset);
+                memmove(&device_locs[j], &device_locs[j + 1], (*device_locs_count - j - 1) * sizeof(device_locs[0]));
+                (*device_locs_count)--;
+                merged = true;
+            }
+        }
+    }
+}
+
+int atcacert_read_cert_ext(ATCADevice            device,
+                           const atcacert_def_t* cert_def,
+                           const uint8_t         ca_public_key[64],
+                           uint8_t*              cert,
+                           size_t*               cert_size,
+                           uint8_t*              scratch,
+                           size_t                scratch_size)
 {
     int ret = 0;
     atcacert_device_loc_t device_locs[16];
     size_t device_locs_count = 0;
     size_t i = 0;
     atcacert_build_state_t build_state;
+#ifdef ATCA_CERT_CACHE
+    atcacert_cache_key_t cache_key;
+    bool cacheable = false;
+#endif
 
     if (cert_def == NULL || cert_size == NULL)
     {
@@ -127,8 +188,27 @@ int atcacert_read_cert(const atcacert_def_t* cert_def,
 
     if (cert == NULL)
     {
-        return atcacert_read_cert_size(cert_def, cert_size);
+        return atcacert_read_cert_size_ext(device, cert_def, cert_size);
+    }
+
+    if (device == NULL || scratch == NULL)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+#ifdef ATCA_CERT_CACHE
+    /* A certificate that is already cached only costs the reads of the serial
+       number and the compressed certificate to validate it */
+    if (atcacert_cache_enabled() && ATCACERT_E_SUCCESS == atcacert_cache_get_key(device, cert_def, ca_public_key, &cache_key))
+    {
+        cacheable = true;
+        ret = atcacert_cache_get(&cache_key, cert, cert_size);
+        if (ATCACERT_E_ELEM_MISSING != ret)
+        {
+            return ret;
+        }
     }
+#endif
 
     ret = atcacert_get_device_locs(
         cert_def,
@@ -140,6 +220,7 @@ int atcacert_read_cert(const atcacert_def_t* cert_def,
     {
         return ret;
     }
+    atcacert_coalesce_device_locs(device_locs, &device_locs_count, scratch_size);
 
     ret = atcacert_cert_build_start(&build_state, cert_def, cert, cert_size, ca_public_key);
     if (ret != ATCACERT_E_SUCCESS)
@@ -149,14 +230,18 @@ int atcacert_read_cert(const atcacert_def_t* cert_def,
 
     for (i = 0; i < device_locs_count; i++)
     {
-        static uint8_t data[416];
-        ret = atcacert_read_device_loc(&device_locs[i], data);
+        if (device_locs[i].count > scratch_size)
+        {
+            return ATCACERT_E_BUFFER_TOO_SMALL;
+        }
+
+        ret = atcacert_read_device_loc_ext(device, &device_locs[i], scratch);
         if (ret != ATCACERT_E_SUCCESS)
         {
             return ret;
         }
 
-        ret = atcacert_cert_build_process(&build_state, &device_locs[i], data);
+        ret = atcacert_cert_build_process(&build_state, &device_locs[i], scratch);
         if (ret != ATCACERT_E_SUCCESS)
         {
             return ret;
@@ -169,19 +254,38 @@ int atcacert_read_cert(const atcacert_def_t* cert_def,
         return ret;
     }
 
+#ifdef ATCA_CERT_CACHE
+    if (cacheable)
+    {
+        (void)atcacert_cache_put(&cache_key, cert, *cert_size);
+    }
+#endif
+
     return ATCACERT_E_SUCCESS;
 }
 
-int atcacert_write_cert(const atcacert_def_t* cert_def,
-                        const uint8_t*        cert,
-                        size_t                cert_size)
+int atcacert_read_cert(const atcacert_def_t* cert_def,
+                       const uint8_t         ca_public_key[64],
+                       uint8_t*              cert,
+                       size_t*               cert_size)
+{
+    static uint8_t data[ATCACERT_READ_SCRATCH_SIZE];
+
+    return atcacert_read_cert_ext(atcab_get_device(), cert_def, ca_public_key, cert, cert_size, data, sizeof(data));
+}
+
+int atcacert_write_cert_ext(ATCADevice            device,
+                            const atcacert_def_t* cert_def,
+                            const uint8_t*        cert,
+                            size_t                cert_size)
 {
     int ret = 0;
     atcacert_device_loc_t device_locs[16];
     size_t device_locs_count = 0;
     size_t i = 0;
+    uint8_t data[416];
 
-    if (cert_def == NULL || cert == NULL)
+    if (device == NULL || cert_def == NULL || cert == NULL)
     {
         return ATCACERT_E_BAD_PARAMS;
     }
@@ -201,7 +305,6 @@ int atcacert_write_cert(const atcacert_def_t* cert_def,
     {
         int end_block;
         int start_block;
-        static uint8_t data[416];
         int block;
 
         if (device_locs[i].zone == DEVZONE_CONFIG)
@@ -223,7 +326,8 @@ int atcacert_write_cert(const atcacert_def_t* cert_def,
         end_block = floor_div((int)(device_locs[i].offset + device_locs[i].count) - 1, ATCA_BLOCK_SIZE);
         for (block = start_block; block <= end_block; block++)
         {
-            ret = atcab_write_zone(
+            ret = atcab_write_zone_ext(
+                device,
                 device_locs[i].zone,
                 device_locs[i].slot,
                 (uint8_t)block,
@@ -240,6 +344,13 @@ int atcacert_write_cert(const atcacert_def_t* cert_def,
     return ATCACERT_E_SUCCESS;
 }
 
+int atcacert_write_cert(const atcacert_def_t* cert_def,
+                        const uint8_t*        cert,
+                        size_t                cert_size)
+{
+    return atcacert_write_cert_ext(atcab_get_device(), cert_def, cert, cert_size);
+}
+
 int atcacert_create_csr_pem(const atcacert_def_t* csr_def, char* csr, size_t* csr_size)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
@@ -369,12 +480,12 @@ int atcacert_create_csr(const atcacert_def_t* csr_def, uint8_t* csr, size_t* csr
     return status;
 }
 
-int atcacert_read_subj_key_id(const atcacert_def_t* cert_def, uint8_t subj_key_id[20])
+int atcacert_read_subj_key_id_ext(ATCADevice device, const atcacert_def_t* cert_def, uint8_t subj_key_id[20])
 {
     int ret = ATCACERT_E_DECODING_ERROR;
     uint8_t subj_public_key[72];
 
-    if (cert_def == NULL || subj_key_id == NULL)
+    if (device == NULL || cert_def == NULL || subj_key_id == NULL)
     {
         return ATCACERT_E_BAD_PARAMS;
     }
@@ -384,15 +495,15 @@ int atcacert_read_subj_key_id(const atcacert_def_t* cert_def, uint8_t subj_key_i
         if (cert_def->public_key_dev_loc.is_genkey)
         {
             /* generate the key */
-            ret = atcab_get_pubkey(cert_def->public_key_dev_loc.slot, subj_public_key);
+            ret = atcab_get_pubkey_ext(device, cert_def->public_key_dev_loc.slot, subj_public_key);
         }
         else
         {
             /* Load the public key from a slot */
-            ret = atcab_read_bytes_zone(cert_def->public_key_dev_loc.zone,
-                                        cert_def->public_key_dev_loc.slot,
-                                        cert_def->public_key_dev_loc.offset,
-                                        subj_public_key, cert_def->public_key_dev_loc.count);
+            ret = atcab_read_bytes_zone_ext(device, cert_def->public_key_dev_loc.zone,
+                                            cert_def->public_key_dev_loc.slot,
+                                            cert_def->public_key_dev_loc.offset,
+                                            subj_public_key, cert_def->public_key_dev_loc.count);
 
             /* IF the public key is stored in device public key format */
             if ((ATCA_SUCCESS == ret) && (72 == cert_def->public_key_dev_loc.count))
@@ -410,21 +521,27 @@ int atcacert_read_subj_key_id(const atcacert_def_t* cert_def, uint8_t subj_key_i
     return ret;
 }
 
-int atcacert_read_cert_size(const atcacert_def_t* cert_def,
-                            size_t*               cert_size)
+int atcacert_read_subj_key_id(const atcacert_def_t* cert_def, uint8_t subj_key_id[20])
+{
+    return atcacert_read_subj_key_id_ext(atcab_get_device(), cert_def, subj_key_id);
+}
+
+int atcacert_read_cert_size_ext(ATCADevice            device,
+                                const atcacert_def_t* cert_def,
+                                size_t*               cert_size)
 {
     uint8_t buffer[75];
     size_t buflen = sizeof(buffer);
     int ret = ATCACERT_E_SUCCESS;
 
-    if (!cert_def || !cert_size)
+    if (!device || !cert_def || !cert_size)
     {
         return ATCACERT_E_BAD_PARAMS;
     }
 
     if (ATCACERT_E_SUCCESS == ret)
     {
-        ret = atcab_read_sig(cert_def->comp_cert_dev_loc.slot, &buffer[8]);
+        ret = atcab_read_sig_ext(device, cert_def->comp_cert_dev_loc.slot, &buffer[8]);
     }
 
     if (ATCACERT_E_SUCCESS == ret)
@@ -439,3 +556,9 @@ int atcacert_read_cert_size(const atcacert_def_t* cert_def,
 
     return ret;
 }
+
+int atcacert_read_cert_size(const atcacert_def_t* cert_def,
+                            size_t*               cert_size)
+{
+    return atcacert_read_cert_size_ext(atcab_get_device(), cert_def, cert_size);
+}
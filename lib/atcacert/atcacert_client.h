@@ -33,6 +33,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "cryptoauthlib.h"
 #include "atcacert_def.h"
 
 // Inform function naming when compiling in C++
@@ -48,6 +49,10 @@ extern "C" {
  *
    @{ */
 
+/** Scratch space in bytes atcacert_read_cert_ext() needs to read the largest
+ *  device location (a full 416 byte data slot) */
+#define ATCACERT_READ_SCRATCH_SIZE      (416)
+
 /** \brief Read the data from a device location.
  *
  * \param[in]  device_loc  Device location to read data from.
@@ -58,6 +63,18 @@ extern "C" {
 int atcacert_read_device_loc(const atcacert_device_loc_t* device_loc,
                              uint8_t*                     data);
 
+/** \brief Read the data from a device location of a specific device.
+ *
+ * \param[in]  device      Device context to read from.
+ * \param[in]  device_loc  Device location to read data from.
+ * \param[out] data        Data read is returned here.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_read_device_loc_ext(ATCADevice                   device,
+                                 const atcacert_device_loc_t* device_loc,
+                                 uint8_t*                     data);
+
 /**
  * \brief Reads the certificate specified by the certificate definition from the
  *        ATECC508A device.
@@ -78,6 +95,10 @@ int atcacert_read_device_loc(const atcacert_device_loc_t* device_loc,
  * \param[in,out] cert_size      As input, the size of the cert buffer in bytes.
  *                              As output, the size of the certificate returned in cert in bytes.
  *
+ * This uses the global device and a static read buffer so only one thread may
+ * call it at a time. Use atcacert_read_cert_ext() to read from several devices
+ * concurrently.
+ *
  * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
  */
 int atcacert_read_cert(const atcacert_def_t* cert_def,
@@ -85,6 +106,40 @@ int atcacert_read_cert(const atcacert_def_t* cert_def,
                        uint8_t*              cert,
                        size_t*               cert_size);
 
+/**
+ * \brief Reads the certificate specified by the certificate definition from a
+ *        specific device.
+ *
+ * All state lives in the arguments so threads may read certificates from
+ * different devices at the same time. Device locations that are adjacent in
+ * the same zone are merged so each is read with as few commands as possible.
+ *
+ * \param[in]    device         Device context to read the certificate from.
+ * \param[in]    cert_def       Certificate definition, see atcacert_read_cert().
+ * \param[in]    ca_public_key  CA public key, see atcacert_read_cert().
+ * \param[out]   cert           Buffer to received the certificate.
+ * \param[in,out] cert_size     As input, the size of the cert buffer in bytes.
+ *                              As output, the size of the certificate returned in cert in bytes.
+ * \param[in]    scratch        Buffer used to hold the data read from the device.
+ * \param[in]    scratch_size   Size of the scratch buffer in bytes. Every device location
+ *                              of the cert_def has to fit, ATCACERT_READ_SCRATCH_SIZE always
+ *                              does.
+ *
+ * With ATCA_CERT_CACHE the certificate is kept in the cache only while
+ * atcacert_cache_init() holds its lock - otherwise every call rebuilds the
+ * certificate from the device. The PKCS11 library holds the cache between
+ * C_Initialize and C_Finalize.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_read_cert_ext(ATCADevice            device,
+                           const atcacert_def_t* cert_def,
+                           const uint8_t         ca_public_key[64],
+                           uint8_t*              cert,
+                           size_t*               cert_size,
+                           uint8_t*              scratch,
+                           size_t                scratch_size);
+
 /**
  * \brief Take a full certificate and write it to the ATECC508A device according to the
  *        certificate definition.
@@ -100,6 +155,22 @@ int atcacert_write_cert(const atcacert_def_t* cert_def,
                         const uint8_t*        cert,
                         size_t                cert_size);
 
+/**
+ * \brief Take a full certificate and write it to a specific device according to the
+ *        certificate definition.
+ *
+ * \param[in] device     Device context to write the certificate to.
+ * \param[in] cert_def   Certificate definition, see atcacert_write_cert().
+ * \param[in] cert       Full certificate to be stored.
+ * \param[in] cert_size  Size of the full certificate in bytes.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_write_cert_ext(ATCADevice            device,
+                            const atcacert_def_t* cert_def,
+                            const uint8_t*        cert,
+                            size_t                cert_size);
+
 /**
  * \brief Creates a CSR specified by the CSR definition from the ATECC508A device.
  *        This process involves reading the dynamic CSR data from the device and combining it
@@ -155,6 +226,20 @@ int atcacert_get_response(uint8_t       device_private_key_slot,
 int atcacert_read_subj_key_id(const atcacert_def_t * cert_def,
                               uint8_t                subj_key_id[20]);
 
+/**
+ * \brief Reads the subject key ID based on a certificate definition from a
+ *        specific device.
+ *
+ * \param[in]  device       Device context to read the public key from.
+ * \param[in]  cert_def     Certificate definition
+ * \param[out] subj_key_id  Subject key ID is returned in this buffer. 20 bytes.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_read_subj_key_id_ext(ATCADevice             device,
+                                  const atcacert_def_t * cert_def,
+                                  uint8_t                subj_key_id[20]);
+
 /** \brief Return the actual certificate size in bytes for a given
  *         cert def. Certificate can be variable size, so this gives the
  *         absolute buffer size when reading the certificates.
@@ -167,6 +252,19 @@ int atcacert_read_subj_key_id(const atcacert_def_t * cert_def,
 int atcacert_read_cert_size(const atcacert_def_t* cert_def,
                             size_t*               cert_size);
 
+/** \brief Return the actual certificate size in bytes for a given cert def
+ *         read from a specific device.
+ *
+ * \param[in]  device         Device context to read the signature from.
+ * \param[in]  cert_def       Certificate definition to find a max size for.
+ * \param[out] cert_size      Certificate size will be returned here in bytes.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_read_cert_size_ext(ATCADevice            device,
+                                const atcacert_def_t* cert_def,
+                                size_t*               cert_size);
+
 /** @} */
 #ifdef __cplusplus
 }
@@ -1569,6 +1569,58 @@ int atcacert_get_tbs_digest(const atcacert_def_t* cert_def,
     return ret;
 }
 
+int atcacert_get_tbs_digests(const atcacert_def_t* const* cert_defs,
+                             const uint8_t* const*        certs,
+                             const size_t*                cert_sizes,
+                             size_t                       count,
+                             uint8_t*                     tbs_digests)
+{
+    int ret = ATCACERT_E_SUCCESS;
+    const uint8_t* tbs[ATCACERT_TBS_DIGEST_BATCH];
+    size_t tbs_size[ATCACERT_TBS_DIGEST_BATCH];
+    size_t done = 0;
+
+    if (count && (cert_defs == NULL || certs == NULL || cert_sizes == NULL || tbs_digests == NULL))
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    while (done < count)
+    {
+        size_t batch = count - done;
+        size_t i;
+
+        if (batch > ATCACERT_TBS_DIGEST_BATCH)
+        {
+            batch = ATCACERT_TBS_DIGEST_BATCH;
+        }
+
+        for (i = 0; i < batch; i++)
+        {
+            if (cert_defs[done + i] == NULL || certs[done + i] == NULL)
+            {
+                return ATCACERT_E_BAD_PARAMS;
+            }
+
+            ret = atcacert_get_tbs(cert_defs[done + i], certs[done + i], cert_sizes[done + i], &tbs[i], &tbs_size[i]);
+            if (ret != ATCACERT_E_SUCCESS)
+            {
+                return ret;
+            }
+        }
+
+        ret = atcac_sw_sha2_256_multi(tbs, tbs_size, batch, &tbs_digests[done * ATCA_SHA2_256_DIGEST_SIZE]);
+        if (ret != ATCACERT_E_SUCCESS)
+        {
+            return ret;
+        }
+
+        done += batch;
+    }
+
+    return ret;
+}
+
 int atcacert_set_cert_element(const atcacert_def_t*      cert_def,
                               const atcacert_cert_loc_t* cert_loc,
                               uint8_t*                   cert,
@@ -48,6 +48,11 @@
 
 #define ATCA_MAX_TRANSFORMS 2
 
+#ifndef ATCACERT_TBS_DIGEST_BATCH
+/** Certificates hashed together by atcacert_get_tbs_digests */
+#define ATCACERT_TBS_DIGEST_BATCH   16
+#endif
+
 
 /** \defgroup atcacert_ Certificate manipulation methods (atcacert_)
  *
@@ -666,6 +671,28 @@ int atcacert_get_tbs_digest(const atcacert_def_t * cert_def,
                             size_t                 cert_size,
                             uint8_t                tbs_digest[32]);
 
+/**
+ * \brief Get the SHA256 digests of the TBS data of several certificates.
+ *
+ * The digests are computed together, which is faster than calling
+ * atcacert_get_tbs_digest() for each certificate when the software SHA256
+ * can hash several messages at once.
+ *
+ * \param[in]  cert_defs    Certificate definition for each certificate.
+ * \param[in]  certs        Certificates to get the TBS digests for.
+ * \param[in]  cert_sizes   Size of each certificate in bytes.
+ * \param[in]  count        Number of certificates.
+ * \param[out] tbs_digests  TBS data digests will be returned here. 32 bytes
+ *                          for each certificate.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_get_tbs_digests(const atcacert_def_t* const* cert_defs,
+                             const uint8_t* const*        certs,
+                             const size_t*                cert_sizes,
+                             size_t                       count,
+                             uint8_t*                     tbs_digests);
+
 /**
  * \brief Sets an element in a certificate. The data_size must match the size in cert_loc.
  *
@@ -62,6 +62,10 @@ int atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
     }
 
     ret = atcac_sw_ecdsa_verify_p256(tbs_digest, signature, ca_public_key);
+    if (ret == ATCA_FUNC_FAIL)
+    {
+        return ATCACERT_E_VERIFY_FAILED;
+    }
     if (ret != ATCACERT_E_SUCCESS)
     {
         return ret;
@@ -72,6 +76,84 @@ int atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
 
 
 
+int atcacert_verify_certs_sw(const atcacert_def_t* const* cert_defs,
+                             const uint8_t* const*        certs,
+                             const size_t*                cert_sizes,
+                             const uint8_t* const*        ca_public_keys,
+                             size_t                       count,
+                             int*                         results)
+{
+    uint8_t tbs_digests[ATCA_ECC_P256_VERIFY_BATCH][32];
+    uint8_t signatures[ATCA_ECC_P256_VERIFY_BATCH][64];
+    const uint8_t* msgs[ATCA_ECC_P256_VERIFY_BATCH];
+    const uint8_t* sigs[ATCA_ECC_P256_VERIFY_BATCH];
+    int verify_results[ATCA_ECC_P256_VERIFY_BATCH];
+    int first_fail = ATCACERT_E_SUCCESS;
+    int ret;
+    size_t done;
+    size_t chunk;
+    size_t i;
+
+    if (count && (cert_defs == NULL || certs == NULL || cert_sizes == NULL || ca_public_keys == NULL))
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+    for (i = 0; i < count; i++)
+    {
+        if (cert_defs[i] == NULL || certs[i] == NULL || ca_public_keys[i] == NULL)
+        {
+            return ATCACERT_E_BAD_PARAMS;
+        }
+    }
+
+    for (done = 0; done < count; done += chunk)
+    {
+        chunk = count - done;
+        if (chunk > ATCA_ECC_P256_VERIFY_BATCH)
+        {
+            chunk = ATCA_ECC_P256_VERIFY_BATCH;
+        }
+
+        ret = atcacert_get_tbs_digests(&cert_defs[done], &certs[done], &cert_sizes[done], chunk, &tbs_digests[0][0]);
+        if (ret != ATCACERT_E_SUCCESS)
+        {
+            return ret;
+        }
+
+        for (i = 0; i < chunk; i++)
+        {
+            ret = atcacert_get_signature(cert_defs[done + i], certs[done + i], cert_sizes[done + i], signatures[i]);
+            if (ret != ATCACERT_E_SUCCESS)
+            {
+                return ret;
+            }
+            msgs[i] = tbs_digests[i];
+            sigs[i] = signatures[i];
+        }
+
+        (void)atcac_sw_ecdsa_verify_p256_batch(msgs, sigs, &ca_public_keys[done], chunk, verify_results);
+        for (i = 0; i < chunk; i++)
+        {
+            if (verify_results[i] == ATCA_FUNC_FAIL)
+            {
+                verify_results[i] = ATCACERT_E_VERIFY_FAILED;
+            }
+            if (first_fail == ATCACERT_E_SUCCESS)
+            {
+                first_fail = verify_results[i];
+            }
+            if (results)
+            {
+                results[done + i] = verify_results[i];
+            }
+        }
+    }
+
+    return first_fail;
+}
+
+
+
 int atcacert_gen_challenge_sw(uint8_t challenge[32])
 {
     if (challenge == NULL)
@@ -93,5 +175,10 @@ int atcacert_verify_response_sw(const uint8_t device_public_key[64],
         return ATCACERT_E_BAD_PARAMS;
     }
 
-    return atcac_sw_ecdsa_verify_p256(challenge, response, device_public_key);
+    if (atcac_sw_ecdsa_verify_p256(challenge, response, device_public_key) != ATCA_SUCCESS)
+    {
+        return ATCACERT_E_VERIFY_FAILED;
+    }
+
+    return ATCACERT_E_SUCCESS;
 }
\ No newline at end of file
@@ -49,7 +49,7 @@ extern "C" {
 
 /**
  * \brief Verify a certificate against its certificate authority's public key using software crypto
- *        functions.The function is currently not implemented.
+ *        functions.
  *
  * \param[in] cert_def       Certificate definition describing how to extract the TBS and signature
  *                           components from the certificate specified.
@@ -59,7 +59,8 @@ extern "C" {
  *                           certificate. Formatted as the 32 byte X and Y integers concatenated
  *                           together (64 bytes total).
  *
- * \return ATCA_UNIMPLEMENTED , as the function is currently not implemented.
+ * \return ATCACERT_E_SUCCESS if the verify succeeds, ATCACERT_E_VERIFY_FAILED if it fails, otherwise an
+ *         error code.
  */
 int atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
                             const uint8_t*        cert,
@@ -68,6 +69,34 @@ int atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
 
 
 
+/**
+ * \brief Verify several certificates against the public keys of their certificate authorities
+ *        using software crypto functions.
+ *
+ * The digests and signatures are processed together, which is faster than calling
+ * atcacert_verify_cert_sw() for each certificate, in particular for a chain or a set of
+ * certificates issued by the same authority.
+ *
+ * \param[in]  cert_defs       Certificate definition of each certificate.
+ * \param[in]  certs           Certificates to verify.
+ * \param[in]  cert_sizes      Size of each certificate in bytes.
+ * \param[in]  ca_public_keys  The ECC P256 public key of the certificate authority that signed
+ *                             each certificate. 64 bytes each.
+ * \param[in]  count           Number of certificates.
+ * \param[out] results         Optional result of each verify as for atcacert_verify_cert_sw().
+ *
+ * \return ATCACERT_E_SUCCESS if every verify succeeds, otherwise the result of the first
+ *         certificate that failed or an error code.
+ */
+int atcacert_verify_certs_sw(const atcacert_def_t* const* cert_defs,
+                             const uint8_t* const*        certs,
+                             const size_t*                cert_sizes,
+                             const uint8_t* const*        ca_public_keys,
+                             size_t                       count,
+                             int*                         results);
+
+
+
 /**
  * \brief Generate a random challenge to be sent to the client using a software PRNG.The function is currently not implemented.
  *
@@ -81,7 +110,7 @@ int atcacert_gen_challenge_sw(uint8_t challenge[32]);
 
 
 /**
- * \brief Verify a client's response to a challenge using software crypto functions.The function is currently not implemented.
+ * \brief Verify a client's response to a challenge using software crypto functions.
  *
  * The challenge-response protocol is an ECDSA Sign and Verify. This performs an ECDSA verify on the
  * response returned by the client, verifying the client has the private key counter-part to the
@@ -92,7 +121,8 @@ int atcacert_gen_challenge_sw(uint8_t challenge[32]);
  * \param[in] challenge          Challenge that was sent to the client. 32 bytes.
  * \param[in] response           Response returned from the client to be verified. 64 bytes.
  *
- * \return ATCA_UNIMPLEMENTED , as the function is currently not implemented.
+ * \return ATCACERT_E_SUCCESS if the verify succeeds, ATCACERT_E_VERIFY_FAILED if it fails, otherwise an
+ *         error code.
  */
 int atcacert_verify_response_sw(const uint8_t device_public_key[64],
                                 const uint8_t challenge[32],
@@ -129,6 +129,15 @@ ATCA_STATUS calib_wakeup(ATCADevice device)
             status = ATCA_SUCCESS;
         }
 #endif
+        if (ATCA_SUCCESS == status)
+        {
+            /* The watchdog has been running since the wake pulse */
+            device->device_state = ATCA_DEVICE_STATE_ACTIVE;
+            device->awake_msec = (atca_iface_get_wake_delay(iface) + 999u) / 1000u;
+#ifdef ATCA_HAL_CLOCK
+            device->awake_time = hal_get_time_ms() - device->awake_msec;
+#endif
+        }
     }
 
     return status;
@@ -162,6 +171,10 @@ ATCA_STATUS calib_idle(ATCADevice device)
         }
     }
 #endif
+    if (ATCA_SUCCESS == status)
+    {
+        device->device_state = ATCA_DEVICE_STATE_IDLE;
+    }
     return status;
 }
 
@@ -186,6 +199,10 @@ ATCA_STATUS calib_sleep(ATCADevice device)
         status = atsend(&device->mIface, atcab_get_device_address(device), &command, 1);
     }
 #endif
+    if (ATCA_SUCCESS == status)
+    {
+        device->device_state = ATCA_DEVICE_STATE_SLEEP;
+    }
     return status;
 }
 
@@ -121,8 +121,20 @@ ATCA_STATUS calib_priv_write(ATCADevice device, uint16_t key_id, const uint8_t p
 ATCA_STATUS calib_random(ATCADevice device, uint8_t* rand_out);
 
 // Read command functions
+
+/** \brief A range of a zone to read with calib_read_ranges */
+typedef struct
+{
+    uint8_t  zone;      /**< ATCA_ZONE_CONFIG, ATCA_ZONE_OTP or ATCA_ZONE_DATA */
+    uint16_t slot;      /**< Slot for ATCA_ZONE_DATA, ignored otherwise */
+    size_t   offset;    /**< Byte offset within the zone or slot */
+    size_t   length;    /**< Number of bytes to read */
+    uint8_t* data;      /**< Read data is returned here */
+} calib_read_range_t;
+
 ATCA_STATUS calib_read_zone(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len);
 ATCA_STATUS calib_read_bytes_zone(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset, uint8_t *data, size_t length);
+ATCA_STATUS calib_read_ranges(ATCADevice device, const calib_read_range_t* ranges, size_t count);
 ATCA_STATUS calib_read_serial_number(ATCADevice device, uint8_t* serial_number);
 ATCA_STATUS calib_read_pubkey(ATCADevice device, uint16_t slot, uint8_t *public_key);
 ATCA_STATUS calib_read_sig(ATCADevice device, uint16_t slot, uint8_t *sig);
@@ -160,6 +172,14 @@ typedef struct atca_sha256_ctx
 
 typedef atca_sha256_ctx_t atca_hmac_sha256_ctx_t;
 
+/** \brief Where calib_hw_sha2_256 hashes a message */
+typedef enum
+{
+    ATCA_SHA_OFFLOAD_DEVICE = 0,    /**< Every block is passed to the device SHA engine */
+    ATCA_SHA_OFFLOAD_HOST,          /**< Hashed on the host with atcac_sw_sha2_256 */
+    ATCA_SHA_OFFLOAD_HYBRID         /**< Hashed on the host then loaded into TempKey where the device SHA leaves its digest */
+} atca_sha_offload_t;
+
 ATCA_STATUS calib_sha_base(ATCADevice device, uint8_t mode, uint16_t length, const uint8_t* data_in, uint8_t* data_out, uint16_t* data_out_size);
 ATCA_STATUS calib_sha_start(ATCADevice device);
 ATCA_STATUS calib_sha_update(ATCADevice device, const uint8_t* message);
@@ -171,6 +191,8 @@ ATCA_STATUS calib_hw_sha2_256(ATCADevice device, const uint8_t * data, size_t da
 ATCA_STATUS calib_hw_sha2_256_init(ATCADevice device, atca_sha256_ctx_t* ctx);
 ATCA_STATUS calib_hw_sha2_256_update(ATCADevice device, atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
 ATCA_STATUS calib_hw_sha2_256_finish(ATCADevice device, atca_sha256_ctx_t* ctx, uint8_t* digest);
+ATCA_STATUS calib_sha_set_offload(ATCADevice device, atca_sha_offload_t policy, uint32_t threshold);
+atca_sha_offload_t calib_sha_get_offload(ATCADevice device, size_t data_size);
 ATCA_STATUS calib_sha_hmac_init(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, uint16_t key_slot);
 ATCA_STATUS calib_sha_hmac_update(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
 ATCA_STATUS calib_sha_hmac_finish(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, uint8_t* digest, uint8_t target);
@@ -179,6 +201,8 @@ ATCA_STATUS calib_sha_hmac(ATCADevice device, const uint8_t * data, size_t data_
 // Sign command functions
 ATCA_STATUS calib_sign_base(ATCADevice device, uint8_t mode, uint16_t key_id, uint8_t *signature);
 ATCA_STATUS calib_sign(ATCADevice device, uint16_t key_id, const uint8_t *msg, uint8_t *signature);
+ATCA_STATUS calib_sign_batch(ATCADevice device, uint16_t key_id, const uint8_t *msgs, size_t count,
+                             uint8_t *signatures, ATCA_STATUS *item_status);
 ATCA_STATUS calib_sign_internal(ATCADevice device, uint16_t key_id, bool is_invalidate, bool is_full_sn, uint8_t *signature);
 // ECC204 Sign command functions
 ATCA_STATUS calib_ecc204_sign(ATCADevice device, uint16_t key_id, const uint8_t* msg, uint8_t* signature);
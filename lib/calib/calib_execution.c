@@ -6,7 +6,9 @@
  * This implementation wraps Polling and No polling (simple wait) schemes into
  * a single method and use it across the library. Polling is used by default,
  * however, by defining the ATCA_NO_POLL symbol the code will instead wait an
- * estimated max execution time before requesting the result.
+ * estimated max execution time before requesting the result. Defining
+ * ATCA_POLL_ADAPTIVE schedules the first poll from the learned completion time
+ * of each command and backs off the polling interval after that.
  *
  * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
  *
@@ -39,7 +41,7 @@
 #endif
 
 
-#ifdef ATCA_NO_POLL
+#if defined(ATCA_NO_POLL) || defined(ATCA_POLL_ADAPTIVE)
 // *INDENT-OFF* - Preserve time formatting from the code formatter
 /*Execution times for ATSHA204A supported commands...*/
 static const device_execution_time_t device_execution_time_204[] = {
@@ -209,7 +211,7 @@ static const device_execution_time_t device_execution_time_ecc204[] = {
 // *INDENT-ON*
 #endif
 
-#ifdef ATCA_NO_POLL
+#if defined(ATCA_NO_POLL) || defined(ATCA_POLL_ADAPTIVE)
 /** \brief return the typical execution time for the given command
  *  \param[in] opcode  Opcode value of the command
  *  \param[in] ca_cmd  Command object for which the execution times are associated
@@ -294,6 +296,124 @@ ATCA_STATUS calib_get_execution_time(uint8_t opcode, ATCADevice device)
 }
 #endif
 
+#ifdef ATCA_POLL_ADAPTIVE
+/** \brief Find the polling schedule entry for a command. New entries are
+ *         seeded from the execution time tables and replace the oldest entry
+ *         once the schedule is full.
+ */
+static atca_poll_estimate_t* calib_poll_get_entry(ATCADevice device, uint8_t opcode)
+{
+    atca_poll_estimate_t* entry = NULL;
+    uint8_t i;
+
+    for (i = 0; i < ATCA_POLL_ADAPTIVE_ENTRIES; i++)
+    {
+        if (opcode == device->poll_estimates[i].opcode)
+        {
+            return &device->poll_estimates[i];
+        }
+        else if (!entry && !device->poll_estimates[i].opcode)
+        {
+            entry = &device->poll_estimates[i];
+        }
+    }
+
+    if (!entry)
+    {
+        entry = &device->poll_estimates[device->poll_replace_idx];
+        device->poll_replace_idx = (uint8_t)((device->poll_replace_idx + 1) % ATCA_POLL_ADAPTIVE_ENTRIES);
+    }
+
+    entry->opcode = opcode;
+    if (ATCA_SUCCESS == calib_get_execution_time(opcode, device))
+    {
+        entry->estimate = (uint16_t)(device->execution_time_msec << 3);
+    }
+    else
+    {
+        /* Unknown command - start from the fixed polling schedule */
+        entry->estimate = (uint16_t)((ATCA_POLLING_INIT_TIME_MSEC + ATCA_POLLING_GUARD_TIME_MSEC) << 3);
+    }
+
+    return entry;
+}
+
+/** \brief Time to wait after sending a command before the first poll for the
+ *         response. This is just ahead of the expected completion time.
+ *  \param[in] device  Device context pointer
+ *  \param[in] opcode  Opcode of the command that was sent
+ *  \return delay in milliseconds
+ */
+uint32_t calib_poll_initial_delay(ATCADevice device, uint8_t opcode)
+{
+    uint32_t expected = ((uint32_t)calib_poll_get_entry(device, opcode)->estimate + 7) >> 3;
+
+    if (expected > ATCA_POLLING_INIT_TIME_MSEC + ATCA_POLLING_GUARD_TIME_MSEC)
+    {
+        return expected - ATCA_POLLING_GUARD_TIME_MSEC;
+    }
+    return ATCA_POLLING_INIT_TIME_MSEC;
+}
+
+/** \brief Interval to the next poll after the device did not respond
+ *  \param[in] poll_delay  Interval used for the poll that was just missed
+ *  \return delay in milliseconds
+ */
+uint32_t calib_poll_next_delay(uint32_t poll_delay)
+{
+    poll_delay *= 2;
+    return (poll_delay > ATCA_POLLING_BACKOFF_MAX_MSEC) ? ATCA_POLLING_BACKOFF_MAX_MSEC : poll_delay;
+}
+
+/** \brief Update the learned completion time of a command
+ *  \param[in] device  Device context pointer
+ *  \param[in] opcode  Opcode of the command that completed
+ *  \param[in] waited  Total time in msec waited before the response arrived
+ *  \param[in] misses  Number of polls the device did not respond to
+ */
+void calib_poll_update(ATCADevice device, uint8_t opcode, uint32_t waited, uint32_t misses)
+{
+    atca_poll_estimate_t* entry = calib_poll_get_entry(device, opcode);
+    int32_t estimate = entry->estimate;
+
+    if (!misses)
+    {
+        /* The command was already complete at the first poll so how early it
+           finished is unknown - pull the schedule in until a poll is missed */
+        estimate -= estimate >> 3;
+    }
+    else
+    {
+        /* Move a quarter of the way towards the observed completion time */
+        if (waited > ATCA_POLLING_MAX_TIME_MSEC)
+        {
+            waited = ATCA_POLLING_MAX_TIME_MSEC;
+        }
+        estimate += ((int32_t)(waited << 3) - estimate) / 4;
+    }
+
+    entry->estimate = (uint16_t)((estimate < 8) ? 8 : estimate);
+}
+
+/** \brief Get the time the scheduler currently expects a command to take
+ *  \param[in]  device         Device context pointer
+ *  \param[in]  opcode         Opcode of the command
+ *  \param[out] estimate_msec  Expected completion time in milliseconds
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_poll_get_estimate(ATCADevice device, uint8_t opcode, uint32_t* estimate_msec)
+{
+    if (!device || !estimate_msec)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    *estimate_msec = ((uint32_t)calib_poll_get_entry(device, opcode)->estimate + 7) >> 3;
+
+    return ATCA_SUCCESS;
+}
+#endif
+
 ATCA_STATUS calib_execute_send(ATCADevice device, uint8_t device_address, uint8_t* txdata, uint16_t txlength)
 {
     ATCA_STATUS status = ATCA_COMM_FAIL;
@@ -418,6 +538,230 @@ ATCA_STATUS calib_execute_receive(ATCADevice device, uint8_t device_address, uin
     return status;
 }
 
+/** \brief Time in msec since the device was last woken. With a platform clock
+ *         this includes the time the host spent between commands, otherwise
+ *         only the time waited for commands is counted.
+ */
+static uint32_t calib_awake_elapsed(ATCADevice device)
+{
+#ifdef ATCA_HAL_CLOCK
+    uint32_t elapsed = hal_get_time_ms() - device->awake_time;
+
+    return (elapsed > device->awake_msec) ? elapsed : device->awake_msec;
+#else
+    return device->awake_msec;
+#endif
+}
+
+/** \brief Wakes up the device if required and sends the command packet
+ *  \param[in] packet         Packet to be sent
+ *  \param[in] device         CryptoAuthentication device to send the command to.
+ *  \param[in] expected_msec  Time the command is expected to take
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS calib_execute_start(ATCAPacket* packet, ATCADevice device, uint32_t expected_msec)
+{
+    ATCA_STATUS status;
+    uint8_t device_address = atcab_get_device_address(device);
+    int retries = atca_iface_get_retries(&device->mIface);
+
+    /* A device kept awake is idled and woken again before the command could
+       run into the watchdog. Idle keeps TempKey and the message digest buffer */
+    if (device->keep_awake && ATCA_DEVICE_STATE_ACTIVE == device->device_state
+        && calib_awake_elapsed(device) + expected_msec > (device->awake_budget_msec ? device->awake_budget_msec : ATCA_AWAKE_BUDGET_MSEC))
+    {
+        (void)calib_idle(device);
+        device->device_state = ATCA_DEVICE_STATE_IDLE;
+    }
+
+    do
+    {
+        if (ATCA_DEVICE_STATE_ACTIVE != device->device_state)
+        {
+            status = calib_wakeup(device);
+        }
+
+        /* Send the command packet to the device */
+        if (ATCA_I2C_IFACE == device->mIface.mIfaceCFG->iface_type)
+        {
+            packet->_reserved = 0x03;
+        }
+        else if (ATCA_SWI_IFACE == device->mIface.mIfaceCFG->iface_type)
+        {
+            packet->_reserved = CALIB_SWI_FLAG_CMD;
+        }
+        if (ATCA_RX_NO_RESPONSE == (status = calib_execute_send(device, device_address, (uint8_t*)packet, packet->txsize + 1)))
+        {
+            device->device_state = ATCA_DEVICE_STATE_UNKNOWN;
+        }
+        else
+        {
+            retries = 0;
+        }
+
+    }
+    while (0 < retries--);
+
+    return status;
+}
+
+/** \brief Attempts once to receive the response to a command
+ *  \param[in]  packet  Packet the response is placed in
+ *  \param[in]  device  CryptoAuthentication device the command was sent to
+ *  \param[out] rxsize  Number of bytes received
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS calib_execute_poll(ATCAPacket* packet, ATCADevice device, uint16_t* rxsize)
+{
+    memset(packet->data, 0, sizeof(packet->data));
+    // receive the response
+    *rxsize = sizeof(packet->data);
+
+    return calib_execute_receive(device, atcab_get_device_address(device), packet->data, rxsize);
+}
+
+/** \brief Checks the response to a command and puts the device into the
+ *         idle state unless it is being kept awake
+ *  \param[in] packet       Packet holding the response
+ *  \param[in] device       CryptoAuthentication device the command was sent to
+ *  \param[in] status       Result of sending the command and receiving the response
+ *  \param[in] rxsize       Number of bytes received
+ *  \param[in] waited_msec  Time waited for the command to complete
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS calib_execute_finish(ATCAPacket* packet, ATCADevice device, ATCA_STATUS status, uint16_t rxsize,
+                                        uint32_t waited_msec)
+{
+    device->awake_msec += waited_msec;
+
+    do
+    {
+        if (status != ATCA_SUCCESS)
+        {
+            break;
+        }
+
+        // Check response size
+        if (rxsize < 4)
+        {
+            if (rxsize > 0)
+            {
+                status = ATCA_RX_FAIL;
+            }
+            else
+            {
+                status = ATCA_RX_NO_RESPONSE;
+            }
+            break;
+        }
+
+        if ((status = atCheckCrc(packet->data)) != ATCA_SUCCESS)
+        {
+            break;
+        }
+
+        if ((status = isATCAError(packet->data)) != ATCA_SUCCESS)
+        {
+            break;
+        }
+    }
+    while (0);
+
+    // Skip Idle for ECC204 device and while a complete response shows a device kept awake is still awake
+    if (ECC204 != device->mIface.mIfaceCFG->devtype && (!device->keep_awake || rxsize < 4))
+    {
+        (void)calib_idle(device);
+        device->device_state = ATCA_DEVICE_STATE_IDLE;
+    }
+
+    return status;
+}
+
+/** \brief Starts a keep-awake session. Until the matching
+ *         calib_keep_awake_end the device is left awake after each command
+ *         instead of being idled, so the next command does not have to wake
+ *         it again. Sessions may be nested.
+ *
+ * Time is tracked from the last wake. When the next command could run past
+ * the session budget (calib_keep_awake_set_budget) the device is idled and
+ * woken before it is sent, which restarts the watchdog. Idle keeps TempKey and
+ * the message digest buffer so commands that depend on each other are not
+ * affected.
+ *
+ * Where the platform has a clock (ATCA_HAL_CLOCK) the time is measured, so
+ * the host may take as long as it likes between commands. Otherwise only the
+ * time spent waiting for commands is counted and the caller must keep the
+ * host time between commands in a session well inside the watchdog period.
+ *
+ *  \param[in] device  CryptoAuthentication device to keep awake
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_keep_awake_begin(ATCADevice device)
+{
+    if (!device)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (UINT8_MAX == device->keep_awake)
+    {
+        return ATCA_TRACE(ATCA_INVALID_SIZE, "Too many nested keep-awake sessions");
+    }
+    device->keep_awake++;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Ends a keep-awake session started with calib_keep_awake_begin. The
+ *         device is idled once the outermost session ends.
+ *  \param[in] device  CryptoAuthentication device being kept awake
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_keep_awake_end(ATCADevice device)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    if (!device)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (!device->keep_awake)
+    {
+        return ATCA_TRACE(ATCA_NOT_INITIALIZED, "No keep-awake session to end");
+    }
+
+    if (0 == --device->keep_awake && ATCA_DEVICE_STATE_ACTIVE == device->device_state
+        && ECC204 != device->mIface.mIfaceCFG->devtype)
+    {
+        status = calib_idle(device);
+    }
+
+    return status;
+}
+
+/** \brief Sets how much device time a keep-awake session allows after a wake
+ *         before the device is idled and woken again. This should stay below
+ *         the watchdog period (~1.3s by default). Without a platform clock
+ *         (ATCA_HAL_CLOCK) it must also leave room for the host time between
+ *         commands, which is then not measured.
+ *  \param[in] device       CryptoAuthentication device
+ *  \param[in] budget_msec  Budget in milliseconds - 0 restores
+ *                          ATCA_AWAKE_BUDGET_MSEC
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_keep_awake_set_budget(ATCADevice device, uint16_t budget_msec)
+{
+    if (!device)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    device->awake_budget_msec = budget_msec;
+
+    return ATCA_SUCCESS;
+}
+
 /** \brief Wakes up device, sends the packet, waits for command completion,
  *         receives response, and puts the device into the idle state.
  *
@@ -433,9 +777,12 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
     ATCA_STATUS status;
     uint32_t execution_or_wait_time;
     uint32_t max_delay_count;
-    uint16_t rxsize;
-    uint8_t device_address = atcab_get_device_address(device);
-    int retries = 1;
+    uint16_t rxsize = 0;
+    uint32_t waited = 0;
+#ifdef ATCA_POLL_ADAPTIVE
+    uint32_t poll_delay = ATCA_POLLING_FREQUENCY_TIME_MSEC;
+    uint32_t misses = 0;
+#endif
 
     do
     {
@@ -446,57 +793,43 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
         }
         execution_or_wait_time = device->execution_time_msec;
         max_delay_count = 0;
+#elif defined(ATCA_POLL_ADAPTIVE)
+        execution_or_wait_time = calib_poll_initial_delay(device, packet->opcode);
+        max_delay_count = ATCA_POLLING_MAX_TIME_MSEC;
 #else
         execution_or_wait_time = ATCA_POLLING_INIT_TIME_MSEC;
         max_delay_count = ATCA_POLLING_MAX_TIME_MSEC / ATCA_POLLING_FREQUENCY_TIME_MSEC;
 #endif
-        retries = atca_iface_get_retries(&device->mIface);
-        do
-        {
-            if (ATCA_DEVICE_STATE_ACTIVE != device->device_state)
-            {
-                if (ATCA_SUCCESS == (status = calib_wakeup(device)))
-                {
-                    device->device_state = ATCA_DEVICE_STATE_ACTIVE;
-                }
-            }
-
-            /* Send the command packet to the device */
-            if (ATCA_I2C_IFACE == device->mIface.mIfaceCFG->iface_type)
-            {
-                packet->_reserved = 0x03;
-            }
-            else if (ATCA_SWI_IFACE == device->mIface.mIfaceCFG->iface_type)
-            {
-                packet->_reserved = CALIB_SWI_FLAG_CMD;
-            }
-            if (ATCA_RX_NO_RESPONSE == (status = calib_execute_send(device, device_address, (uint8_t*)packet, packet->txsize + 1)))
-            {
-                device->device_state = ATCA_DEVICE_STATE_UNKNOWN;
-            }
-            else
-            {
-                retries = 0;
-            }
-
-        }
-        while (0 < retries--);
 
-        if (ATCA_SUCCESS != status)
+        if (ATCA_SUCCESS != (status = calib_execute_start(packet, device, execution_or_wait_time)))
         {
             break;
         }
 
         // Delay for execution time or initial wait before polling
         atca_delay_ms(execution_or_wait_time);
+        waited = execution_or_wait_time;
 
+#if defined(ATCA_POLL_ADAPTIVE) && !defined(ATCA_NO_POLL)
+        // Poll with an increasing interval until the max polling time (held in max_delay_count)
         do
         {
-            memset(packet->data, 0, sizeof(packet->data));
-            // receive the response
-            rxsize = sizeof(packet->data);
+            if (ATCA_SUCCESS == (status = calib_execute_poll(packet, device, &rxsize)))
+            {
+                calib_poll_update(device, packet->opcode, waited, misses);
+                break;
+            }
 
-            if (ATCA_SUCCESS == (status = calib_execute_receive(device, device_address, packet->data, &rxsize)))
+            atca_delay_ms(poll_delay);
+            waited += poll_delay;
+            misses++;
+            poll_delay = calib_poll_next_delay(poll_delay);
+        }
+        while (waited < max_delay_count);
+#else
+        do
+        {
+            if (ATCA_SUCCESS == (status = calib_execute_poll(packet, device, &rxsize)))
             {
                 break;
             }
@@ -504,46 +837,233 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
 #ifndef ATCA_NO_POLL
             // delay for polling frequency time
             atca_delay_ms(ATCA_POLLING_FREQUENCY_TIME_MSEC);
+            waited += ATCA_POLLING_FREQUENCY_TIME_MSEC;
 #endif
         }
         while (max_delay_count-- > 0);
+#endif
+    }
+    while (0);
 
-        if (status != ATCA_SUCCESS)
-        {
-            break;
-        }
+    return calib_execute_finish(packet, device, status, rxsize, waited);
+}
 
-        // Check response size
-        if (rxsize < 4)
+/** \brief Wakes up the device and sends a command without waiting for it to
+ *         complete. The command is then completed with calib_async_poll,
+ *         calib_async_wait or calib_async_service.
+ *
+ * The device must not be given any other command until this one completes.
+ *
+ * \param[out] cmd        Context tracking the command
+ * \param[in]  device     CryptoAuthentication device to send the command to
+ * \param[in]  packet     Packet built with one of the calib_command.c
+ *                        builders. The response is placed in its data buffer
+ *                        so it must remain valid until the command completes.
+ * \param[in]  callback   Optional function called once the command completes
+ * \param[in]  user_data  Passed through to the callback in cmd->user_data
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_async_submit(calib_async_cmd_t* cmd, ATCADevice device, ATCAPacket* packet,
+                               calib_async_cb_t callback, void* user_data)
+{
+    ATCA_STATUS status;
+
+    if (!cmd || !device || !packet)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->device = device;
+    cmd->packet = packet;
+    cmd->callback = callback;
+    cmd->user_data = user_data;
+    cmd->poll_delay = ATCA_POLLING_FREQUENCY_TIME_MSEC;
+
+#ifdef ATCA_NO_POLL
+    if ((status = calib_get_execution_time(packet->opcode, device)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+    cmd->due_msec = device->execution_time_msec;
+#elif defined(ATCA_POLL_ADAPTIVE)
+    cmd->due_msec = calib_poll_initial_delay(device, packet->opcode);
+#else
+    cmd->due_msec = ATCA_POLLING_INIT_TIME_MSEC;
+#endif
+
+    if (ATCA_SUCCESS != (status = calib_execute_start(packet, device, cmd->due_msec)))
+    {
+        cmd->status = calib_execute_finish(packet, device, status, 0, 0);
+        return cmd->status;
+    }
+
+    cmd->status = ATCA_RX_NO_RESPONSE;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Advances a submitted command. The response is only requested from
+ *         the device once the poll is due so this can be called as often as
+ *         convenient.
+ *
+ * \param[in,out] cmd           Context of a submitted command
+ * \param[in]     elapsed_msec  Time since the command was submitted or since
+ *                              the previous call for it
+ *
+ * \return ATCA_RX_NO_RESPONSE while the command is executing, otherwise the
+ *         result of the command (also held in cmd->status).
+ */
+ATCA_STATUS calib_async_poll(calib_async_cmd_t* cmd, uint32_t elapsed_msec)
+{
+    ATCA_STATUS status;
+    uint16_t rxsize = 0;
+
+    if (!cmd || !cmd->device)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (ATCA_RX_NO_RESPONSE != cmd->status)
+    {
+        return cmd->status;
+    }
+
+    cmd->waited_msec += elapsed_msec;
+    if (cmd->waited_msec < cmd->due_msec)
+    {
+        return ATCA_RX_NO_RESPONSE;
+    }
+
+    if (ATCA_SUCCESS == (status = calib_execute_poll(cmd->packet, cmd->device, &rxsize)))
+    {
+#if defined(ATCA_POLL_ADAPTIVE) && !defined(ATCA_NO_POLL)
+        calib_poll_update(cmd->device, cmd->packet->opcode, cmd->waited_msec, cmd->misses);
+#endif
+    }
+#ifndef ATCA_NO_POLL
+    else if (cmd->waited_msec < ATCA_POLLING_MAX_TIME_MSEC)
+    {
+        cmd->misses++;
+        cmd->due_msec = cmd->waited_msec + cmd->poll_delay;
+#ifdef ATCA_POLL_ADAPTIVE
+        cmd->poll_delay = calib_poll_next_delay(cmd->poll_delay);
+#endif
+        return ATCA_RX_NO_RESPONSE;
+    }
+#endif
+
+    cmd->status = calib_execute_finish(cmd->packet, cmd->device, status, rxsize, cmd->waited_msec);
+
+    if (cmd->callback)
+    {
+        cmd->callback(cmd);
+    }
+
+    return cmd->status;
+}
+
+/** \brief Holds off the first poll of a submitted command until it has been
+ *         executing for at least the given time. Used when polls are not
+ *         free, e.g. when other devices on the same bus could use it instead.
+ *  \param[in,out] cmd   Context of a submitted command
+ *  \param[in]     msec  Time since the command was sent of the first poll
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_async_defer(calib_async_cmd_t* cmd, uint32_t msec)
+{
+    if (!cmd)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (ATCA_RX_NO_RESPONSE == cmd->status && 0 == cmd->misses && cmd->due_msec < msec)
+    {
+        cmd->due_msec = msec;
+    }
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Time until a submitted command should next be polled
+ *  \param[in] cmd  Context of a submitted command
+ *  \return delay in milliseconds - 0 if a poll is due or the command has completed
+ */
+uint32_t calib_async_get_delay(const calib_async_cmd_t* cmd)
+{
+    if (!cmd || ATCA_RX_NO_RESPONSE != cmd->status || cmd->waited_msec >= cmd->due_msec)
+    {
+        return 0;
+    }
+    return cmd->due_msec - cmd->waited_msec;
+}
+
+/** \brief Blocks until a submitted command completes
+ *  \param[in,out] cmd  Context of a submitted command
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_async_wait(calib_async_cmd_t* cmd)
+{
+    return calib_async_service(&cmd, 1);
+}
+
+/** \brief Drives a set of submitted commands, typically one per device, to
+ *         completion from a single thread. The thread sleeps until the next
+ *         poll is due on any of the devices.
+ *
+ * \param[in,out] cmds   Array of submitted commands
+ * \param[in]     count  Number of commands in the array
+ *
+ * \return ATCA_SUCCESS if every command succeeded, otherwise the first error
+ *         encountered. The result of each command is held in its status.
+ */
+ATCA_STATUS calib_async_service(calib_async_cmd_t** cmds, size_t count)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint32_t delay;
+    bool pending;
+    size_t i;
+
+    if (!cmds)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    delay = 0;
+    do
+    {
+        pending = false;
+        for (i = 0; i < count; i++)
         {
-            if (rxsize > 0)
-            {
-                status = ATCA_RX_FAIL;
-            }
-            else
+            if (cmds[i] && ATCA_RX_NO_RESPONSE == calib_async_poll(cmds[i], delay))
             {
-                status = ATCA_RX_NO_RESPONSE;
+                pending = true;
             }
-            break;
-        }
-
-        if ((status = atCheckCrc(packet->data)) != ATCA_SUCCESS)
-        {
-            break;
         }
 
-        if ((status = isATCAError(packet->data)) != ATCA_SUCCESS)
+        if (pending)
         {
-            break;
+            /* Sleep until the earliest poll that is due */
+            delay = ATCA_POLLING_MAX_TIME_MSEC;
+            for (i = 0; i < count; i++)
+            {
+                if (cmds[i] && ATCA_RX_NO_RESPONSE == cmds[i]->status && calib_async_get_delay(cmds[i]) < delay)
+                {
+                    delay = calib_async_get_delay(cmds[i]);
+                }
+            }
+            atca_delay_ms(delay);
         }
     }
-    while (0);
+    while (pending);
 
-    // Skip Idle for ECC204 device
-    if (ECC204 != device->mIface.mIfaceCFG->devtype)
+    for (i = 0; i < count; i++)
     {
-        (void)calib_idle(device);
-        device->device_state = ATCA_DEVICE_STATE_IDLE;
+        if (cmds[i] && ATCA_SUCCESS == status)
+        {
+            status = cmds[i]->status;
+        }
     }
 
     return status;
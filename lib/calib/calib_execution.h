@@ -53,7 +53,7 @@ extern "C" {
 #define CALIB_SWI_FLAG_IDLE     0xBB    //!< flag requesting to go into Idle mode
 #define CALIB_SWI_FLAG_SLEEP    0xCC    //!< flag requesting to go into Sleep mode
 
-#ifdef ATCA_NO_POLL
+#if defined(ATCA_NO_POLL) || defined(ATCA_POLL_ADAPTIVE)
 /** \brief Structure to hold the device execution time and the opcode for the
  *         corresponding command
  */
@@ -66,11 +66,47 @@ typedef struct
 ATCA_STATUS calib_get_execution_time(uint8_t opcode, ATCADevice device);
 #endif
 
+#ifdef ATCA_POLL_ADAPTIVE
+uint32_t calib_poll_initial_delay(ATCADevice device, uint8_t opcode);
+uint32_t calib_poll_next_delay(uint32_t poll_delay);
+void calib_poll_update(ATCADevice device, uint8_t opcode, uint32_t waited, uint32_t misses);
+ATCA_STATUS calib_poll_get_estimate(ATCADevice device, uint8_t opcode, uint32_t* estimate_msec);
+#endif
+
 #ifndef ATCA_HAL_LEGACY_API
 ATCA_STATUS calib_execute_receive(ATCADevice device, uint8_t device_address, uint8_t* rxdata, uint16_t* rxlength);
 #endif
 
 ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device);
+ATCA_STATUS calib_keep_awake_begin(ATCADevice device);
+ATCA_STATUS calib_keep_awake_end(ATCADevice device);
+ATCA_STATUS calib_keep_awake_set_budget(ATCADevice device, uint16_t budget_msec);
+
+/* Asynchronous command execution */
+typedef struct calib_async_cmd calib_async_cmd_t;
+typedef void (*calib_async_cb_t)(calib_async_cmd_t* cmd);
+
+/** \brief Tracks a command submitted with calib_async_submit */
+struct calib_async_cmd
+{
+    ATCADevice       device;        /**< Device the command was sent to */
+    ATCAPacket*      packet;        /**< Command packet - holds the response once complete */
+    ATCA_STATUS      status;        /**< ATCA_RX_NO_RESPONSE while executing then the result */
+    uint32_t         waited_msec;   /**< Time since the command was sent */
+    uint32_t         due_msec;      /**< Time since the command was sent the next poll is due */
+    uint32_t         poll_delay;    /**< Interval to the poll after the next one */
+    uint32_t         misses;        /**< Polls made while the device was busy */
+    calib_async_cb_t callback;      /**< Called once the command completes */
+    void*            user_data;     /**< Caller context for the callback */
+};
+
+ATCA_STATUS calib_async_submit(calib_async_cmd_t* cmd, ATCADevice device, ATCAPacket* packet,
+                               calib_async_cb_t callback, void* user_data);
+ATCA_STATUS calib_async_poll(calib_async_cmd_t* cmd, uint32_t elapsed_msec);
+ATCA_STATUS calib_async_defer(calib_async_cmd_t* cmd, uint32_t msec);
+uint32_t calib_async_get_delay(const calib_async_cmd_t* cmd);
+ATCA_STATUS calib_async_wait(calib_async_cmd_t* cmd);
+ATCA_STATUS calib_async_service(calib_async_cmd_t** cmds, size_t count);
 
 #ifdef __cplusplus
 }
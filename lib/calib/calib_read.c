@@ -543,123 +543,241 @@ ATCA_STATUS calib_read_pubkey(ATCADevice device, uint16_t slot, uint8_t *public_
     return status;
 }
 
-/** \brief Used to read an arbitrary number of bytes from any zone configured
- *          for clear reads.
- *
- * This function will issue the Read command as many times as is required to
- * read the requested data.
- *
- *  \param[in]  device  Device context pointer
- *  \param[in]  zone    Zone to read data from. Option are ATCA_ZONE_CONFIG(0),
- *                      ATCA_ZONE_OTP(1), or ATCA_ZONE_DATA(2).
- *  \param[in]  slot    Slot number to read from if zone is ATCA_ZONE_DATA(2).
- *                      Ignored for all other zones.
- *  \param[in]  offset  Byte offset within the zone to read from.
- *  \param[out] data    Read data is returned here.
- *  \param[in]  length  Number of bytes to read starting from the offset.
- *
- *  \return ATCA_SUCCESS on success, otherwise an error code.
- */
-ATCA_STATUS calib_read_bytes_zone(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset, uint8_t *data, size_t length)
+/* A Read command in a read plan. Units sort by zone, slot and address so a
+   plan is executed in address order. Word reads set CALIB_READ_UNIT_WORD in
+   the word index, block reads leave it 0. */
+#define CALIB_READ_UNIT_WORD            (0x80)
+#define CALIB_READ_UNIT(zone, slot, block, word) \
+    (((uint32_t)(zone) << 24) | ((uint32_t)(slot) << 16) | ((uint32_t)(block) << 8) | (uint32_t)(word))
+
+/** \brief Check a range can be read and get the size of its zone */
+static ATCA_STATUS calib_read_range_check(ATCADevice device, const calib_read_range_t* range, size_t* zone_size)
 {
-    ATCA_STATUS status = ATCA_GEN_FAIL;
-    size_t zone_size = 0;
-    uint8_t read_buf[32];
-    size_t data_idx = 0;
-    size_t cur_block = 0;
-    size_t cur_offset = 0;
-    uint8_t read_size = ATCA_BLOCK_SIZE;
-    size_t read_buf_idx = 0;
-    size_t copy_length = 0;
-    size_t read_offset = 0;
+    ATCA_STATUS status;
 
-    if (zone != ATCA_ZONE_CONFIG && zone != ATCA_ZONE_OTP && zone != ATCA_ZONE_DATA)
+    if (range->zone != ATCA_ZONE_CONFIG && range->zone != ATCA_ZONE_OTP && range->zone != ATCA_ZONE_DATA)
     {
         return ATCA_TRACE(ATCA_BAD_PARAM, "Invalid zone received");
     }
-    if (zone == ATCA_ZONE_DATA && slot > 15)
+    if (range->zone == ATCA_ZONE_DATA && range->slot > 15)
     {
         return ATCA_TRACE(ATCA_BAD_PARAM, "Invalid slot received");
     }
-    if (length == 0)
+    if (range->length == 0)
     {
+        *zone_size = 0;
         return ATCA_SUCCESS;  // Always succeed reading 0 bytes
     }
-    if (data == NULL)
+    if (range->data == NULL)
     {
         return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
     }
+    if (ATCA_SUCCESS != (status = calib_get_zone_size(device, range->zone, range->slot, zone_size)))
+    {
+        return ATCA_TRACE(status, "calib_get_zone_size - failed");
+    }
+    if (range->offset + range->length > *zone_size)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "Invalid parameter received"); // Can't read past the end of a zone
+    }
 
-    do
+    return ATCA_SUCCESS;
+}
+
+/** \brief Find the first Read command a range needs after the unit in after
+ *         (or its first one if after is NULL). Blocks are read whole unless
+ *         they would run past the end of the zone, then word by word.
+ */
+static bool calib_read_range_next(const calib_read_range_t* range, size_t zone_size, const uint32_t* after, uint32_t* unit)
+{
+    uint16_t slot = (ATCA_ZONE_DATA == range->zone) ? range->slot : 0;
+    size_t end = range->offset + range->length;
+    size_t block;
+    size_t word;
+
+    for (block = range->offset / ATCA_BLOCK_SIZE; block * ATCA_BLOCK_SIZE < end; block++)
     {
-        if (ATCA_SUCCESS != (status = calib_get_zone_size(device, zone, slot, &zone_size)))
+        size_t block_start = block * ATCA_BLOCK_SIZE;
+
+        if (zone_size - block_start >= ATCA_BLOCK_SIZE)
         {
-            ATCA_TRACE(status, "calib_get_zone_size - failed");
-            break;
+            *unit = CALIB_READ_UNIT(range->zone, slot, block, 0);
+            if (!after || *unit > *after)
+            {
+                return true;
+            }
+            continue;
         }
-        if (offset + length > zone_size)
+
+        word = (range->offset > block_start) ? (range->offset - block_start) / ATCA_WORD_SIZE : 0;
+        for (; block_start + word * ATCA_WORD_SIZE < end; word++)
         {
-            return ATCA_TRACE(ATCA_BAD_PARAM, "Invalid parameter received"); // Can't read past the end of a zone
+            *unit = CALIB_READ_UNIT(range->zone, slot, block, CALIB_READ_UNIT_WORD | word);
+            if (!after || *unit > *after)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/** \brief Copy the data of a Read command into every range it covers */
+static void calib_read_range_scatter(const calib_read_range_t* ranges, size_t count, uint32_t unit, const uint8_t* read_buf)
+{
+    uint8_t zone = (uint8_t)(unit >> 24);
+    uint16_t slot = (uint16_t)((unit >> 16) & 0xFF);
+    size_t start = ((unit >> 8) & 0xFF) * ATCA_BLOCK_SIZE;
+    size_t size = ATCA_BLOCK_SIZE;
+    size_t i;
+
+    if (unit & CALIB_READ_UNIT_WORD)
+    {
+        start += (unit & ~CALIB_READ_UNIT_WORD & 0xFF) * ATCA_WORD_SIZE;
+        size = ATCA_WORD_SIZE;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        const calib_read_range_t* range = &ranges[i];
+        size_t first;
+        size_t last;
 
+        if (range->zone != zone || (ATCA_ZONE_DATA == zone && range->slot != slot) || 0 == range->length)
+        {
+            continue;
         }
-        cur_block = offset / ATCA_BLOCK_SIZE;
 
-        while (data_idx < length)
+        first = (range->offset > start) ? range->offset : start;
+        last = (range->offset + range->length < start + size) ? range->offset + range->length : start + size;
+        if (first < last)
         {
-            if (read_size == ATCA_BLOCK_SIZE && zone_size - cur_block * ATCA_BLOCK_SIZE < ATCA_BLOCK_SIZE)
-            {
-                // We have less than a block to read and can't read past the end of the zone, switch to word reads
-                read_size = ATCA_WORD_SIZE;
-                cur_offset = ((data_idx + offset) / ATCA_WORD_SIZE) % (ATCA_BLOCK_SIZE / ATCA_WORD_SIZE);
-            }
+            memcpy(&range->data[first - range->offset], &read_buf[first - start], last - first);
+        }
+    }
+}
 
-            // Read next chunk of data
-            if (ATCA_SUCCESS != (status = calib_read_zone(device, zone, slot, (uint8_t)cur_block, (uint8_t)cur_offset, read_buf, read_size)))
-            {
-                ATCA_TRACE(status, "calib_read_zone - falied");
-                break;
-            }
+/** \brief Reads several ranges of the config, OTP or data zones.
+ *
+ * The ranges are planned together so any block or word they share is read
+ * only once, the Read commands are issued in address order and the device is
+ * kept awake between them rather than woken and idled for each one.
+ *
+ *  \param[in]  device  Device context pointer
+ *  \param[in]  ranges  Ranges to read. Ranges may overlap.
+ *  \param[in]  count   Number of ranges.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_read_ranges(ATCADevice device, const calib_read_range_t* ranges, size_t count)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCA_STATUS awake_status;
+    uint8_t read_buf[ATCA_BLOCK_SIZE];
+    size_t zone_size = 0;
+    uint32_t last = 0;
+    uint32_t next = 0;
+    uint32_t unit = 0;
+    bool started = false;
+    bool found;
+    size_t i;
+
+    if ((device == NULL) || (ranges == NULL && count > 0))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
 
-            // Calculate where in the read buffer we need data from
-            read_offset = cur_block * ATCA_BLOCK_SIZE + cur_offset * ATCA_WORD_SIZE;
-            if (read_offset < offset)
-            {
-                read_buf_idx = offset - read_offset;  // Read data starts before the requested chunk
-            }
-            else
-            {
-                read_buf_idx = 0;                     // Read data is within the requested chunk
+    for (i = 0; i < count; i++)
+    {
+        if (ATCA_SUCCESS != (status = calib_read_range_check(device, &ranges[i], &zone_size)))
+        {
+            return status;
+        }
+    }
 
-            }
-            // Calculate how much data from the read buffer we want to copy
-            if (length - data_idx < read_size - read_buf_idx)
-            {
-                copy_length = length - data_idx;
-            }
-            else
-            {
-                copy_length = read_size - read_buf_idx;
-            }
+    if (ATCA_SUCCESS != (status = calib_keep_awake_begin(device)))
+    {
+        return status;
+    }
 
-            memcpy(&data[data_idx], &read_buf[read_buf_idx], copy_length);
-            data_idx += copy_length;
-            if (read_size == ATCA_BLOCK_SIZE)
+    do
+    {
+        /* The next command is the lowest unit any range still needs */
+        found = false;
+        for (i = 0; i < count; i++)
+        {
+            if (0 == ranges[i].length)
             {
-                cur_block += 1;
+                continue;
             }
-            else
+            (void)calib_get_zone_size(device, ranges[i].zone, ranges[i].slot, &zone_size);
+            if (calib_read_range_next(&ranges[i], zone_size, started ? &last : NULL, &unit) && (!found || unit < next))
             {
-                cur_offset += 1;
+                next = unit;
+                found = true;
             }
         }
-        if (status != ATCA_SUCCESS)
+        if (!found)
         {
             break;
         }
+
+        if (next & CALIB_READ_UNIT_WORD)
+        {
+            status = calib_read_zone(device, (uint8_t)(next >> 24), (uint16_t)((next >> 16) & 0xFF), (uint8_t)((next >> 8) & 0xFF),
+                                     (uint8_t)(next & ~CALIB_READ_UNIT_WORD & 0xFF), read_buf, ATCA_WORD_SIZE);
+        }
+        else
+        {
+            status = calib_read_zone(device, (uint8_t)(next >> 24), (uint16_t)((next >> 16) & 0xFF), (uint8_t)((next >> 8) & 0xFF),
+                                     0, read_buf, ATCA_BLOCK_SIZE);
+        }
+        if (ATCA_SUCCESS != status)
+        {
+            ATCA_TRACE(status, "calib_read_zone - failed");
+            break;
+        }
+
+        calib_read_range_scatter(ranges, count, next, read_buf);
+        last = next;
+        started = true;
     }
-    while (false);
+    while (true);
 
-    return status;
+    awake_status = calib_keep_awake_end(device);
+
+    return (ATCA_SUCCESS != status) ? status : awake_status;
+}
+
+/** \brief Used to read an arbitrary number of bytes from any zone configured
+ *          for clear reads.
+ *
+ * This function will issue the Read command as many times as is required to
+ * read the requested data, keeping the device awake between them.
+ *
+ *  \param[in]  device  Device context pointer
+ *  \param[in]  zone    Zone to read data from. Option are ATCA_ZONE_CONFIG(0),
+ *                      ATCA_ZONE_OTP(1), or ATCA_ZONE_DATA(2).
+ *  \param[in]  slot    Slot number to read from if zone is ATCA_ZONE_DATA(2).
+ *                      Ignored for all other zones.
+ *  \param[in]  offset  Byte offset within the zone to read from.
+ *  \param[out] data    Read data is returned here.
+ *  \param[in]  length  Number of bytes to read starting from the offset.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_read_bytes_zone(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset, uint8_t *data, size_t length)
+{
+    calib_read_range_t range;
+
+    range.zone = zone;
+    range.slot = slot;
+    range.offset = offset;
+    range.length = length;
+    range.data = data;
+
+    return calib_read_ranges(device, &range, 1);
 }
 
 #if defined(ATCA_ECC204_SUPPORT)
@@ -33,6 +33,7 @@
  */
 
 #include "cryptoauthlib.h"
+#include "crypto/atca_crypto_sw_sha2.h"
 
 typedef struct
 {
@@ -351,7 +352,8 @@ ATCA_STATUS calib_hw_sha2_256_finish(ATCADevice device, atca_sha256_ctx_t* ctx,
     return ATCA_SUCCESS;
 }
 
-/** \brief Use the SHA command to compute a SHA-256 digest.
+/** \brief Use the SHA command to compute a SHA-256 digest. Large messages
+ *          can be hashed on the host instead - see calib_sha_set_offload.
  *
  * \param[in]  device     Device context pointer
  * \param[in]  data       Message data to be hashed.
@@ -364,6 +366,25 @@ ATCA_STATUS calib_hw_sha2_256(ATCADevice device, const uint8_t * data, size_t da
 {
     ATCA_STATUS status = ATCA_SUCCESS;
     atca_sha256_ctx_t ctx;
+    atca_sha_offload_t offload = calib_sha_get_offload(device, data_size);
+
+    if (ATCA_SHA_OFFLOAD_DEVICE != offload)
+    {
+        if (ATCA_SUCCESS != (status = (ATCA_STATUS)atcac_sw_sha2_256(data, data_size, digest)))
+        {
+            return ATCA_TRACE(status, "atcac_sw_sha2_256 - failed");
+        }
+
+        /* Leave the device holding the digest as the SHA command would */
+        if (ATCA_SHA_OFFLOAD_HYBRID == offload)
+        {
+            if (ATCA_SUCCESS != (status = calib_nonce_load(device, NONCE_MODE_TARGET_TEMPKEY, digest, ATCA_SHA256_DIGEST_SIZE)))
+            {
+                return ATCA_TRACE(status, "calib_nonce_load - failed");
+            }
+        }
+        return ATCA_SUCCESS;
+    }
 
     if (ATCA_SUCCESS != (status = calib_hw_sha2_256_init(device, &ctx)))
     {
@@ -383,6 +404,53 @@ ATCA_STATUS calib_hw_sha2_256(ATCADevice device, const uint8_t * data, size_t da
     return ATCA_SUCCESS;
 }
 
+/** \brief Sets where calib_hw_sha2_256 hashes messages. Passing every block
+ *         over the bus costs a command per 64 bytes so hashing on the host
+ *         is far faster for anything but short messages. The streaming
+ *         calib_hw_sha2_256_init/update/finish functions always use the
+ *         device as the message size isn't known when they start.
+ *
+ * \param[in] device     Device context pointer
+ * \param[in] policy     Where messages of at least threshold bytes are hashed
+ * \param[in] threshold  Messages shorter than this are hashed by the device
+ *                       whatever the policy - 0 applies the policy to all
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_sha_set_offload(ATCADevice device, atca_sha_offload_t policy, uint32_t threshold)
+{
+    if (NULL == device)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+    if (policy > ATCA_SHA_OFFLOAD_HYBRID)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "Invalid offload policy");
+    }
+
+    device->sha_offload = (uint8_t)policy;
+    device->sha_offload_threshold = threshold;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Where calib_hw_sha2_256 hashes a message of the given size
+ *
+ * \param[in] device     Device context pointer
+ * \param[in] data_size  Size of the message in bytes
+ *
+ * \return The policy that applies to the message
+ */
+atca_sha_offload_t calib_sha_get_offload(ATCADevice device, size_t data_size)
+{
+    if (NULL == device || data_size < device->sha_offload_threshold)
+    {
+        return ATCA_SHA_OFFLOAD_DEVICE;
+    }
+
+    return (atca_sha_offload_t)device->sha_offload;
+}
+
 /** \brief Executes SHA command to start an HMAC/SHA-256 operation
  *
  * \param[in]  device   Device context pointer
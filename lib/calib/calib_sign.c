@@ -148,6 +148,90 @@ ATCA_STATUS calib_sign(ATCADevice device, uint16_t key_id, const uint8_t *msg, u
     return status;
 }
 
+/** \brief Signs a batch of 32-byte external messages with the private key in
+ *          the specified slot. The device is held awake across the batch so
+ *          the RNG seed update is done once and each message only costs a
+ *          Nonce and Sign command, without an idle and wake between them.
+ *
+ *  \param[in]  device       Device context pointer
+ *  \param[in]  key_id       Slot of the private key to be used to sign the
+ *                           messages.
+ *  \param[in]  msgs         Messages to be signed, 32 bytes each one after
+ *                           the other (count * 32 bytes).
+ *  \param[in]  count        Number of messages
+ *  \param[out] signatures   Signatures are returned here, 64 bytes each in the
+ *                           same order as the messages (count * 64 bytes).
+ *  \param[out] item_status  Optional array of count entries receiving the
+ *                           result for each message. Signing carries on past
+ *                           a failed message.
+ *
+ * \return ATCA_SUCCESS if every message was signed, otherwise the first error
+ *         encountered.
+ */
+ATCA_STATUS calib_sign_batch(ATCADevice device, uint16_t key_id, const uint8_t *msgs, size_t count,
+                             uint8_t *signatures, ATCA_STATUS *item_status)
+{
+    ATCA_STATUS status;
+    ATCA_STATUS seed_status;
+    ATCA_STATUS item;
+    uint8_t nonce_target = NONCE_MODE_TARGET_TEMPKEY;
+    uint8_t sign_source = SIGN_MODE_SOURCE_TEMPKEY;
+    size_t i;
+
+    if ((device == NULL) || (msgs == NULL) || (signatures == NULL))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (ATECC608 == device->mIface.mIfaceCFG->devtype)
+    {
+        // Use the Message Digest Buffer for the ATECC608
+        nonce_target = NONCE_MODE_TARGET_MSGDIGBUF;
+        sign_source = SIGN_MODE_SOURCE_MSGDIGBUF;
+    }
+
+    if ((status = calib_keep_awake_begin(device)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+
+    // Make sure RNG has updated its seed
+    if ((seed_status = calib_random(device, NULL)) != ATCA_SUCCESS)
+    {
+        ATCA_TRACE(seed_status, "calib_random - failed");
+    }
+    status = seed_status;
+
+    for (i = 0; i < count; i++)
+    {
+        item = seed_status;
+        if (ATCA_SUCCESS == item)
+        {
+            if ((item = calib_nonce_load(device, nonce_target, &msgs[i * ATCA_SHA256_DIGEST_SIZE], ATCA_SHA256_DIGEST_SIZE)) != ATCA_SUCCESS)
+            {
+                ATCA_TRACE(item, "calib_nonce_load - failed");
+            }
+            else if ((item = calib_sign_base(device, SIGN_MODE_EXTERNAL | sign_source, key_id, &signatures[i * ATCA_SIG_SIZE])) != ATCA_SUCCESS)
+            {
+                ATCA_TRACE(item, "calib_sign_base - failed");
+            }
+        }
+
+        if (item_status)
+        {
+            item_status[i] = item;
+        }
+        if (ATCA_SUCCESS == status)
+        {
+            status = item;
+        }
+    }
+
+    (void)calib_keep_awake_end(device);
+
+    return status;
+}
+
 /** \brief Executes Sign command to sign an internally generated message.
  *
  *  \param[in]  device         Device context pointer
@@ -57,6 +57,25 @@ typedef struct atca_aes_ctr_ctx
 }atca_aes_ctr_ctx_t;
 
 
+#ifndef ATCA_AES_CTR_BULK_BLOCKS
+#define ATCA_AES_CTR_BULK_BLOCKS    (4)
+#endif
+
+typedef struct atca_aes_ctr_bulk_ctx
+{
+    atca_aes_ctr_ctx_t ctr;                                                      //!< CTR context. Its counter block is the next one to encrypt.
+    uint8_t            keystream[ATCA_AES_CTR_BULK_BLOCKS][ATCA_AES128_BLOCK_SIZE]; //!< Keystream computed ahead of the data it is used on.
+    uint8_t            head;                                                     //!< Index of the keystream block being used.
+    uint8_t            count;                                                    //!< Number of keystream blocks ready.
+    uint8_t            offset;                                                   //!< Bytes of the head keystream block already used.
+#if ATCA_CA_SUPPORT
+    bool               busy;                                                     //!< A keystream block is being computed.
+    ATCAPacket         packet;                                                   //!< AES command being executed.
+    calib_async_cmd_t  cmd;                                                      //!< Tracks the AES command being executed.
+#endif
+} atca_aes_ctr_bulk_ctx_t;
+
+
 typedef struct atca_aes_cbcmac_ctx
 {
     atca_aes_cbc_ctx_t cbc_ctx;                       //!< CBC context
@@ -279,3 +279,209 @@ ATCA_STATUS atcab_aes_ctr_decrypt_block(atca_aes_ctr_ctx_t* ctx, const uint8_t*
     return atcab_aes_ctr_block(ctx, ciphertext, plaintext);
 }
 
+
+/** \brief Initialize a context for processing data of any length with AES
+ *         CTR mode. Keystream blocks are computed ahead of the data and kept
+ *         between calls so the data may be split anywhere.
+ *
+ * \param[out] ctx      AES CTR bulk context to be initialized.
+ * \param[in]  ctr_ctx  AES CTR context set up with atcab_aes_ctr_init() or
+ *                      atcab_aes_ctr_init_rand(). Processing starts at its
+ *                      counter block.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_aes_ctr_bulk_init(atca_aes_ctr_bulk_ctx_t* ctx, const atca_aes_ctr_ctx_t* ctr_ctx)
+{
+    if (ctx == NULL || ctr_ctx == NULL)
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    memcpy(&ctx->ctr, ctr_ctx, sizeof(ctx->ctr));
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Check if a keystream block is being computed */
+static bool atcab_aes_ctr_bulk_busy(const atca_aes_ctr_bulk_ctx_t* ctx)
+{
+#if ATCA_CA_SUPPORT
+    return ctx->busy;
+#else
+    ((void)ctx);
+    return false;
+#endif
+}
+
+/** \brief Start computing the keystream block for the current counter. On
+ *         CryptoAuth devices the AES command is left executing so the
+ *         keystream already computed can be used in the meantime.
+ */
+static ATCA_STATUS atcab_aes_ctr_bulk_start(atca_aes_ctr_bulk_ctx_t* ctx)
+{
+    ATCA_STATUS status;
+    uint8_t tail = (uint8_t)((ctx->head + ctx->count) % ATCA_AES_CTR_BULK_BLOCKS);
+
+#if ATCA_CA_SUPPORT
+    ATCADeviceType device_type = atcab_get_device_type_ext(ctx->ctr.device);
+
+    if (atcab_is_ca_device(device_type))
+    {
+        ctx->packet.param1 = AES_MODE_ENCRYPT | (AES_MODE_KEY_BLOCK_MASK & (ctx->ctr.key_block << AES_MODE_KEY_BLOCK_POS));
+        ctx->packet.param2 = ctx->ctr.key_id;
+        memcpy(ctx->packet.data, ctx->ctr.cb, AES_DATA_SIZE);
+
+        if (ATCA_SUCCESS != (status = atAES(device_type, &ctx->packet)))
+        {
+            return ATCA_TRACE(status, "atAES - failed");
+        }
+        if (ATCA_SUCCESS != (status = calib_async_submit(&ctx->cmd, ctx->ctr.device, &ctx->packet, NULL, NULL)))
+        {
+            return ATCA_TRACE(status, "calib_async_submit - failed");
+        }
+        ctx->busy = true;
+        return ATCA_SUCCESS;
+    }
+#endif
+
+    if (ATCA_SUCCESS != (status = atcab_aes_encrypt_ext(ctx->ctr.device, ctx->ctr.key_id, ctx->ctr.key_block, ctx->ctr.cb, ctx->keystream[tail])))
+    {
+        return status;
+    }
+    ctx->count++;
+
+    return atcab_aes_ctr_increment(&ctx->ctr);
+}
+
+/** \brief Wait for the keystream block being computed and add it to the
+ *         ones ready
+ */
+static ATCA_STATUS atcab_aes_ctr_bulk_finish(atca_aes_ctr_bulk_ctx_t* ctx)
+{
+#if ATCA_CA_SUPPORT
+    ATCA_STATUS status;
+    uint8_t tail = (uint8_t)((ctx->head + ctx->count) % ATCA_AES_CTR_BULK_BLOCKS);
+
+    if (ctx->busy)
+    {
+        ctx->busy = false;
+        if (ATCA_SUCCESS != (status = calib_async_wait(&ctx->cmd)))
+        {
+            return ATCA_TRACE(status, "AES command failed");
+        }
+        if (ctx->packet.data[ATCA_COUNT_IDX] < (3 + AES_DATA_SIZE))
+        {
+            return ATCA_TRACE(ATCA_RX_FAIL, "Unexpected response size");
+        }
+        memcpy(ctx->keystream[tail], &ctx->packet.data[ATCA_RSP_DATA_IDX], AES_DATA_SIZE);
+        ctx->count++;
+
+        return atcab_aes_ctr_increment(&ctx->ctr);
+    }
+#else
+    ((void)ctx);
+#endif
+    return ATCA_SUCCESS;
+}
+
+/** \brief Process data of any length using CTR mode and a key within the
+ *         device. Encryption and decryption are the same operation.
+ *
+ * The device is kept awake for the whole buffer rather than being woken and
+ * idled for each block. On CryptoAuth devices the next keystream block is
+ * computed while the current one is XORed with the data. Up to
+ * ATCA_AES_CTR_BULK_BLOCKS keystream blocks computed ahead of the data are
+ * kept for the next call.
+ *
+ * \param[in,out] ctx     AES CTR bulk context from atcab_aes_ctr_bulk_init().
+ * \param[in]     input   Data to be processed.
+ * \param[out]    output  Processed data is returned here. May be the same
+ *                        buffer as input.
+ * \param[in]     length  Number of bytes to process.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcab_aes_ctr_bulk(atca_aes_ctr_bulk_ctx_t* ctx, const uint8_t* input, uint8_t* output, size_t length)
+{
+    ATCA_STATUS status;
+    ATCA_STATUS finish_status;
+    const uint8_t* keystream;
+    size_t count;
+    size_t i;
+
+    if (ctx == NULL || ((input == NULL || output == NULL) && length > 0))
+    {
+        return ATCA_TRACE(ATCA_BAD_PARAM, "NULL pointer received");
+    }
+
+    if (0 == length)
+    {
+        return ATCA_SUCCESS;
+    }
+
+    if (ATCA_SUCCESS != (status = atcab_keep_awake_begin_ext(ctx->ctr.device)))
+    {
+        return status;
+    }
+
+    while (ATCA_SUCCESS == status && length > 0)
+    {
+        if (0 == ctx->count)
+        {
+            // No keystream ready - compute the next block and wait for it
+            if (!atcab_aes_ctr_bulk_busy(ctx))
+            {
+                status = atcab_aes_ctr_bulk_start(ctx);
+            }
+            if (ATCA_SUCCESS == status)
+            {
+                status = atcab_aes_ctr_bulk_finish(ctx);
+            }
+            continue;
+        }
+
+        // Compute the next block while the ready keystream is used
+        if (!atcab_aes_ctr_bulk_busy(ctx) && ctx->count < ATCA_AES_CTR_BULK_BLOCKS)
+        {
+            if (ATCA_SUCCESS != (status = atcab_aes_ctr_bulk_start(ctx)))
+            {
+                break;
+            }
+        }
+
+        keystream = &ctx->keystream[ctx->head][ctx->offset];
+        count = ATCA_AES128_BLOCK_SIZE - ctx->offset;
+        if (count > length)
+        {
+            count = length;
+        }
+        for (i = 0; i < count; i++)
+        {
+            output[i] = input[i] ^ keystream[i];
+        }
+        input += count;
+        output += count;
+        length -= count;
+
+        ctx->offset = (uint8_t)(ctx->offset + count);
+        if (ATCA_AES128_BLOCK_SIZE == ctx->offset)
+        {
+            ctx->offset = 0;
+            ctx->head = (uint8_t)((ctx->head + 1) % ATCA_AES_CTR_BULK_BLOCKS);
+            ctx->count--;
+        }
+    }
+
+    // Keep the block computed ahead for the next call
+    finish_status = atcab_aes_ctr_bulk_finish(ctx);
+    if (ATCA_SUCCESS == status)
+    {
+        status = finish_status;
+    }
+
+    (void)atcab_keep_awake_end_ext(ctx->ctr.device);
+
+    return status;
+}
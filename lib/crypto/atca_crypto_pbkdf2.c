@@ -28,7 +28,156 @@
 
 #include "cryptoauthlib.h"
 
+#if ATCA_ENABLE_SHA256_IMPL
+#include "hashes/sha2_routines.h"
+
+/* Output blocks derived together */
+#define ATCAC_PBKDF2_LANES      (8)
+
+/** \brief Password as an HMAC-SHA256 key: the hash states after the inner and
+ *         outer padded keys, which start every HMAC of the derivation */
+typedef struct
+{
+    sw_sha256_ctx inner;
+    sw_sha256_ctx outer;
+} atcac_pbkdf2_key;
+
+static void atcac_pbkdf2_key_init(atcac_pbkdf2_key* key, const uint8_t* password, size_t password_len)
+{
+    uint8_t pad[ATCA_SHA256_BLOCK_SIZE];
+    size_t i;
+
+    memset(pad, 0, sizeof(pad));
+    if (password_len > ATCA_SHA256_BLOCK_SIZE)
+    {
+        sw_sha256(password, (unsigned int)password_len, pad);
+    }
+    else
+    {
+        memcpy(pad, password, password_len);
+    }
+
+    for (i = 0; i < sizeof(pad); i++)
+    {
+        pad[i] ^= 0x36;
+    }
+    sw_sha256_init(&key->inner);
+    sw_sha256_update(&key->inner, pad, sizeof(pad));
+
+    for (i = 0; i < sizeof(pad); i++)
+    {
+        pad[i] ^= 0x36 ^ 0x5C;
+    }
+    sw_sha256_init(&key->outer);
+    sw_sha256_update(&key->outer, pad, sizeof(pad));
+}
+
+/** \brief Formats a block for a digest that follows a padded key. Both hashes
+ *         of an iteration are over 96 bytes so the block only differs in the
+ *         digest. */
+static void atcac_pbkdf2_block_init(uint8_t block[ATCA_SHA256_BLOCK_SIZE])
+{
+    memset(block, 0, ATCA_SHA256_BLOCK_SIZE);
+    block[ATCA_SHA256_DIGEST_SIZE] = 0x80;
+    block[ATCA_SHA256_BLOCK_SIZE - 2] = (uint8_t)(((ATCA_SHA256_BLOCK_SIZE + ATCA_SHA256_DIGEST_SIZE) * 8) >> 8);
+}
+
+static void atcac_pbkdf2_store(uint8_t digest[ATCA_SHA256_DIGEST_SIZE], const uint32_t hash[8])
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        digest[i * 4 + 0] = (uint8_t)(hash[i] >> 24);
+        digest[i * 4 + 1] = (uint8_t)(hash[i] >> 16);
+        digest[i * 4 + 2] = (uint8_t)(hash[i] >> 8);
+        digest[i * 4 + 3] = (uint8_t)(hash[i]);
+    }
+}
+
+/** \brief Derives several output blocks together. The iterations of each
+ *         block only hash one block for the inner and one for the outer HMAC
+ *         starting from the key states, and the blocks of the output are
+ *         independent so they are hashed side by side.
+ */
+static void atcac_pbkdf2_sha256_blocks(
+    const atcac_pbkdf2_key* key,
+    const uint32_t          iter,
+    const uint8_t*          salt,
+    const size_t            salt_len,
+    uint32_t                counter,
+    uint32_t                count,
+    uint8_t*                result
+    )
+{
+    sw_sha256_ctx inner[ATCAC_PBKDF2_LANES];
+    sw_sha256_ctx outer[ATCAC_PBKDF2_LANES];
+    sw_sha256_ctx* inner_ctx[ATCAC_PBKDF2_LANES];
+    sw_sha256_ctx* outer_ctx[ATCAC_PBKDF2_LANES];
+    uint8_t inner_block[ATCAC_PBKDF2_LANES][ATCA_SHA256_BLOCK_SIZE];
+    uint8_t outer_block[ATCAC_PBKDF2_LANES][ATCA_SHA256_BLOCK_SIZE];
+    const uint8_t* inner_blocks[ATCAC_PBKDF2_LANES];
+    const uint8_t* outer_blocks[ATCAC_PBKDF2_LANES];
+    uint32_t i, j, lane;
+
+    for (lane = 0; lane < count; lane++)
+    {
+        uint32_t temp_u32 = ATCA_UINT32_HOST_TO_BE(counter + lane);
+
+        inner_ctx[lane] = &inner[lane];
+        outer_ctx[lane] = &outer[lane];
+        inner_blocks[lane] = inner_block[lane];
+        outer_blocks[lane] = outer_block[lane];
+        atcac_pbkdf2_block_init(inner_block[lane]);
+        atcac_pbkdf2_block_init(outer_block[lane]);
+
+        /* U1 = HMAC(password, salt || counter) */
+        inner[lane] = key->inner;
+        sw_sha256_update(&inner[lane], salt, (uint32_t)salt_len);
+        sw_sha256_update(&inner[lane], (uint8_t*)&temp_u32, 4);
+        sw_sha256_final(&inner[lane], outer_block[lane]);
+
+        outer[lane] = key->outer;
+        sw_sha256_update(&outer[lane], outer_block[lane], ATCA_SHA256_DIGEST_SIZE);
+        sw_sha256_final(&outer[lane], inner_block[lane]);
+
+        memcpy(&result[lane * ATCA_SHA256_DIGEST_SIZE], inner_block[lane], ATCA_SHA256_DIGEST_SIZE);
+    }
+
+    /* Un = HMAC(password, Un-1) */
+    for (i = 1; i < iter; i++)
+    {
+        for (lane = 0; lane < count; lane++)
+        {
+            memcpy(inner[lane].hash, key->inner.hash, sizeof(inner[lane].hash));
+        }
+        sw_sha256_process_multi(inner_ctx, inner_blocks, count);
+
+        for (lane = 0; lane < count; lane++)
+        {
+            atcac_pbkdf2_store(outer_block[lane], inner[lane].hash);
+            memcpy(outer[lane].hash, key->outer.hash, sizeof(outer[lane].hash));
+        }
+        sw_sha256_process_multi(outer_ctx, outer_blocks, count);
+
+        for (lane = 0; lane < count; lane++)
+        {
+            uint8_t* t = &result[lane * ATCA_SHA256_DIGEST_SIZE];
+
+            atcac_pbkdf2_store(inner_block[lane], outer[lane].hash);
+            for (j = 0; j < ATCA_SHA256_DIGEST_SIZE; j++)
+            {
+                t[j] ^= inner_block[lane][j];
+            }
+        }
+    }
+}
+#endif
+
 /** \brief Calculate a PBKDF2 hash of a given password and salt
+ *
+ *  With the software SHA256 implementation the HMAC key setup is done once for
+ *  the whole derivation rather than for every iteration.
  *
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
@@ -42,6 +191,41 @@ ATCA_STATUS atcac_pbkdf2_sha256(
     size_t          result_len      /**< [in] Length of the key to derive */
     )
 {
+#if ATCA_ENABLE_SHA256_IMPL
+    atcac_pbkdf2_key key;
+    uint8_t blocks[ATCAC_PBKDF2_LANES * ATCA_SHA256_DIGEST_SIZE];
+    uint32_t counter = 1;
+
+    if (NULL == password || 0 == password_len || (NULL == salt && salt_len) || NULL == result || 0 == result_len)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    atcac_pbkdf2_key_init(&key, password, password_len);
+
+    while (0 < result_len)
+    {
+        size_t block_count = (result_len + ATCA_SHA256_DIGEST_SIZE - 1) / ATCA_SHA256_DIGEST_SIZE;
+        size_t copy_len;
+
+        if (block_count > ATCAC_PBKDF2_LANES)
+        {
+            block_count = ATCAC_PBKDF2_LANES;
+        }
+
+        atcac_pbkdf2_sha256_blocks(&key, iter, salt, salt_len, counter, (uint32_t)block_count, blocks);
+
+        copy_len = block_count * ATCA_SHA256_DIGEST_SIZE;
+        copy_len = (result_len < copy_len) ? result_len : copy_len;
+        memcpy(result, blocks, copy_len);
+
+        result_len -= copy_len;
+        result += copy_len;
+        counter += (uint32_t)block_count;
+    }
+
+    return ATCA_SUCCESS;
+#else
     ATCA_STATUS status = ATCA_BAD_PARAM;
     atcac_hmac_sha256_ctx ctx;
     uint32_t i, j;
@@ -110,6 +294,7 @@ ATCA_STATUS atcac_pbkdf2_sha256(
         }
     }
     return status;
+#endif
 }
 
 /** \brief Calculate a PBKDF2 password hash using a stored key inside a device. The key length is
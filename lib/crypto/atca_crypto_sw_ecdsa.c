@@ -1,7 +1,12 @@
 /**
  * \file
- * \brief API wrapper for software ECDSA verify.  Currently unimplemented but could be
- *        implemented via a 3rd party library such as MicroECC.
+ * \brief Software ECDSA P-256 verify.
+ *
+ * Arithmetic is on 32 bit limbs: field products use the fast reduction for
+ * the NIST prime and scalar products Montgomery multiplication. The generator
+ * is multiplied with a fixed-base comb table that is built on first use and
+ * the public key with a width-5 NAF of its odd multiples. Both share a single
+ * doubling chain (Shamir's trick).
  *
  * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
  *
@@ -28,21 +33,1325 @@
 
 
 #include "atca_crypto_sw_ecdsa.h"
+#include <string.h>
+
+#define P256_WORDS          (8)
+#define P256_BITS           (256)
+
+/* Bits of the scalar covered by each tooth of the generator comb */
+#define P256_COMB_SPACING   ((P256_BITS + ATCA_ECC_P256_COMB_TEETH - 1) / ATCA_ECC_P256_COMB_TEETH)
+#define P256_COMB_POINTS    ((1 << ATCA_ECC_P256_COMB_TEETH) - 1)
+
+/* Odd multiples of the public key used by its NAF */
+#define P256_WNAF_WIDTH     (5)
+
+/** \brief Modulus with its Montgomery constants */
+typedef struct
+{
+    uint32_t m[P256_WORDS];         //!< Modulus
+    uint32_t m_inv;                 //!< -m^-1 mod 2^32
+    uint32_t one[P256_WORDS];       //!< R mod m
+    uint32_t rr[P256_WORDS];        //!< R^2 mod m
+} p256_mod_t;
+
+/** \brief Point in Jacobian coordinates, infinity when z is zero */
+typedef struct
+{
+    uint32_t x[P256_WORDS];
+    uint32_t y[P256_WORDS];
+    uint32_t z[P256_WORDS];
+} p256_point_t;
+
+/* Curve constants, least significant word first */
+static const uint32_t p256_p[P256_WORDS] = {
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF
+};
+static const uint32_t p256_b[P256_WORDS] = {
+    0x27D2604B, 0x3BCE3C3E, 0xCC53B0F6, 0x651D06B0, 0x769886BC, 0xB3EBBD55, 0xAA3A93E7, 0x5AC635D8
+};
+static const uint32_t p256_one[P256_WORDS] = { 1 };
+
+/* Group order with its Montgomery constants */
+static const p256_mod_t p256_n = {
+    { 0xFC632551, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF },
+    0xEE00BC4F,
+    { 0x039CDAAF, 0x0C46353D, 0x58E8617B, 0x43190552, 0x00000000, 0x00000000, 0xFFFFFFFF, 0x00000000 },
+    { 0xBE79EEA2, 0x83244C95, 0x49BD6FA6, 0x4699799C, 0x2B6BEC59, 0x2845B239, 0xF3D95620, 0x66E12D94 }
+};
+
+/* Affine generator comb. Entry k - 1 is the sum of 2^(j * spacing) G over the
+   bits j set in k. Kept constant so concurrent verifies never build it. */
+#if ATCA_ECC_P256_COMB_TEETH == 4
+static const uint32_t p256_comb[P256_COMB_POINTS][2][P256_WORDS] = {
+    {
+        { 0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2 },
+        { 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2 }
+    },
+    {
+        { 0x8E14DB63, 0x90E75CB4, 0xAD651F7E, 0x29493BAA, 0x326E25DE, 0x8492592E, 0x2811AAA5, 0x0FA822BC },
+        { 0x5F462EE7, 0xE4112454, 0x50FE82F5, 0x34B1A650, 0xB3DF188B, 0x6F4AD4BC, 0xF5DBA80D, 0xBFF44AE8 }
+    },
+    {
+        { 0x097992AF, 0x93391CE2, 0x0D35F1FA, 0xE96C98FD, 0x95E02789, 0xB257C0DE, 0x89D6726F, 0x300A4BBC },
+        { 0xC08127A0, 0xAA54A291, 0xA9D806A5, 0x5BB1EEAD, 0xFF1E3C6F, 0x7F1DDB25, 0xD09B4644, 0x72AAC7E0 }
+    },
+    {
+        { 0xD789BD85, 0x57C84FC9, 0xC297EAC3, 0xFC35FF7D, 0x88C6766E, 0xFB982FD5, 0xEEDB5E67, 0x447D739B },
+        { 0x72E25B32, 0x0C7E33C9, 0xA7FAE500, 0x3D349B95, 0x3A4AAFF7, 0xE12E9D95, 0x834131EE, 0x2D4825AB }
+    },
+    {
+        { 0x2A1D367F, 0x13949C93, 0x1A0A11B7, 0xEF7FBD2B, 0xB91DFC60, 0xDDC6068B, 0x8A9C72FF, 0xEF951932 },
+        { 0x7376D8A8, 0x196035A7, 0x95CA1740, 0x23183B08, 0x022C219C, 0xC1EE9807, 0x7DBB2C9B, 0x611E9FC3 }
+    },
+    {
+        { 0x0B57F4BC, 0xCAE2B192, 0xC6C9BC36, 0x2936DF5E, 0xE11238BF, 0x7DEA6482, 0x7B51F5D8, 0x55066379 },
+        { 0x348A964C, 0x44FFE216, 0xDBDEFBE1, 0x9FB3D576, 0x8D9D50E5, 0x0AFA4001, 0x8AECB851, 0x15716484 }
+    },
+    {
+        { 0xFC5CDE01, 0xE48ECAFF, 0x0D715F26, 0x7CCD84E7, 0xF43E4391, 0xA2E8F483, 0xB21141EA, 0xEB5D7745 },
+        { 0x731A3479, 0xCAC917E2, 0x2844B645, 0x85F22CFE, 0x58006CEE, 0x0990E6A1, 0xDBECC17B, 0xEAFD72EB }
+    },
+    {
+        { 0x313728BE, 0x6CF20FFB, 0xA3C6B94A, 0x96439591, 0x44315FC5, 0x2736FF83, 0xA7849276, 0xA6D39677 },
+        { 0xC357F5F4, 0xF2BAB833, 0x2284059B, 0x824A920C, 0x2D27ECDF, 0x66B8BABD, 0x9B0B8816, 0x674F8474 }
+    },
+    {
+        { 0x677C8A3E, 0x2DF48C04, 0x0203A56B, 0x74E02F08, 0xB8C7FEDB, 0x31855F7D, 0x72C9DDAD, 0x4E769E76 },
+        { 0xB824BBB0, 0xA4C36165, 0x3B9122A5, 0xFB9AE16F, 0x06947281, 0x1EC00572, 0xDE830663, 0x42B99082 }
+    },
+    {
+        { 0xDDA868B9, 0x6EF95150, 0x9C0CE131, 0xD1F89E79, 0x08A1C478, 0x7FDC1CA0, 0x1C6CE04D, 0x78878EF6 },
+        { 0x1FE0D976, 0x9C62B912, 0xBDE08D4F, 0x6ACE570E, 0x12309DEF, 0xDE53142C, 0x7B72C321, 0xB6CB3F5D }
+    },
+    {
+        { 0xC31A3573, 0x7F991ED2, 0xD54FB496, 0x5B82DD5B, 0x812FFCAE, 0x595C5220, 0x716B1287, 0x0C88BC4D },
+        { 0x5F48ACA8, 0x3A57BF63, 0xDF2564F3, 0x7C8181F4, 0x9C04E6AA, 0x18D1B5B3, 0xF3901DC6, 0xDD5DDEA3 }
+    },
+    {
+        { 0x3E72AD0C, 0xE96A79FB, 0x42BA792F, 0x43A0A28C, 0x083E49F3, 0xEFE0A423, 0x6B317466, 0x68F344AF },
+        { 0x3FB24D4A, 0xCDFE17DB, 0x71F5C626, 0x668BFC22, 0x24D67FF3, 0x604ED93C, 0xF8540A20, 0x31B9C405 }
+    },
+    {
+        { 0xA2582E7F, 0xD36B4789, 0x4EC39C28, 0x0D1A1014, 0xEDBAD7A0, 0x663C62C3, 0x6F461DB9, 0x4052BF4B },
+        { 0x188D25EB, 0x235A27C3, 0x99BFCC5B, 0xE724F339, 0x71D70CC8, 0x862BE6BD, 0x90B0FC61, 0xFECF4D51 }
+    },
+    {
+        { 0xA1D4CFAC, 0x74346C10, 0x8526A7A4, 0xAFDF5CC0, 0xF62BFF7A, 0x123202A8, 0xC802E41A, 0x1EDDBAE2 },
+        { 0xD603F844, 0x8FA0AF2D, 0x4C701917, 0x36E06B7E, 0x73DB33A0, 0x0C45F452, 0x560EBCFC, 0x43104D86 }
+    },
+    {
+        { 0x0D1D78E5, 0x9615B511, 0x25C4744B, 0x66B0DE32, 0x6AAF363A, 0x0A4A46FB, 0x84F7A21C, 0xB48E26B4 },
+        { 0x21A01B2D, 0x06EBB0F6, 0x8B7B0F98, 0xC004E404, 0xFED6F668, 0x64131BCD, 0x4D4D3DAB, 0xFAC01540 }
+    }
+};
+#elif ATCA_ECC_P256_COMB_TEETH == 5
+static const uint32_t p256_comb[P256_COMB_POINTS][2][P256_WORDS] = {
+    {
+        { 0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2 },
+        { 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2 }
+    },
+    {
+        { 0x071E5C83, 0xEEA6BC92, 0x8542A0BE, 0x8BD27F19, 0x2A58E5B1, 0x20A845B7, 0x5026D73F, 0x54CCC941 },
+        { 0x140916A1, 0xCFD08EF7, 0x5D8EE496, 0x929E0BCC, 0xDAD2BF22, 0x3A8F8715, 0xB4514532, 0x1C433F45 }
+    },
+    {
+        { 0x04BAC870, 0xF7D24BB7, 0x3A23C6AB, 0x593A09A0, 0xF94C9D1D, 0xDFCC2358, 0x297BED02, 0x3CFA0F87 },
+        { 0x40F26940, 0xCE98A30B, 0x0248A8AF, 0x62121C0D, 0x8309AF9B, 0xA758AA80, 0x70BE12C6, 0xE4E37694 }
+    },
+    {
+        { 0x3ECCA7E0, 0xC739A5EA, 0x6743333E, 0xA7D2C98F, 0x224D9428, 0x0FEF6335, 0x5C792A0C, 0x7EF2EE3C },
+        { 0x552AC094, 0x302B22DD, 0xDFBD3D20, 0x81B21450, 0xD5E609DB, 0xA4F67F51, 0x30ACC011, 0xAFB68627 }
+    },
+    {
+        { 0x86EF7D7D, 0xDD37E3FF, 0x088B86DB, 0xF6D77C27, 0x254C5491, 0x28FE9A4F, 0x6DF0FD5E, 0xD6690337 },
+        { 0xADDAD596, 0x9FF04992, 0x9E4373F9, 0xF3D1A7AF, 0xDF074167, 0xA13E9578, 0xE6D13D22, 0x20E2A53C }
+    },
+    {
+        { 0xB0879605, 0xD7B86AEE, 0xBE3C7265, 0xA424EC2D, 0x12F01E9E, 0x276203C2, 0xB77E46E9, 0xB666FAC5 },
+        { 0x3BF0C52D, 0xF431BB1A, 0x726CD8B6, 0xEF46A44A, 0xEE3DE5A9, 0xEB5ABC19, 0x90246904, 0x38AAA380 }
+    },
+    {
+        { 0x525D6ABF, 0xAEBFD735, 0x96BEA25A, 0xC302F8F4, 0x544920A4, 0xDB82B3EA, 0x02EADB2E, 0x621C75D1 },
+        { 0x9EF485F0, 0x8939DC4C, 0x57C46D63, 0x225D03D8, 0x522D7F70, 0x4FDAC96F, 0xB4FA649D, 0xD7C4A4FE }
+    },
+    {
+        { 0x943E832A, 0x9C762EF1, 0x1786DF70, 0x07E50AB0, 0x2589F18E, 0x90F573A8, 0xA7C2A51A, 0x0D2BF28B },
+        { 0x5B20D37C, 0x48263AF1, 0x60551446, 0x27EC9DB9, 0x94B4E7ED, 0x7087A10A, 0x13BD00AC, 0x0CAC3F43 }
+    },
+    {
+        { 0xC0B9372A, 0x8BC659AA, 0xEDD9583F, 0xF7659958, 0x8C267D88, 0x9F05F94A, 0xC99A739D, 0x00DC46E7 },
+        { 0xDF55D0F2, 0x4AF50A00, 0x8156BF6A, 0xB5EB202D, 0x5228C111, 0x40D1E3AB, 0x45793424, 0x0312A557 }
+    },
+    {
+        { 0x9E6486E0, 0x9D90CDA8, 0x1C7522C0, 0xC8A820BD, 0x08DCD7AB, 0x867C5580, 0x882A7892, 0x3C510CE2 },
+        { 0x646D54C6, 0x0E283334, 0xEDA4E046, 0x33392776, 0x5BA997B0, 0xC3A7FC08, 0x5ACF053F, 0xD35E620F }
+    },
+    {
+        { 0x7EB8CFEE, 0x8D9692F7, 0x0D8C013D, 0x05E3F223, 0x84E32E59, 0x76347A52, 0x15B0A1E5, 0x3C53E290 },
+        { 0xFAE798D4, 0x538B7DA5, 0x00D23591, 0x1B9F1BD1, 0x9A08693F, 0x11A9F072, 0x140EFEB3, 0xD30E7CDA }
+    },
+    {
+        { 0x4DD6C004, 0x81DEC926, 0xDAD210D5, 0xBFED14FE, 0xB96B9911, 0x39F9FF69, 0x29C2024D, 0x02FD7B73 },
+        { 0x715D29FC, 0x50CFCEB8, 0x0C236311, 0xB682B999, 0xC7797831, 0x00F34ADD, 0x59927DF3, 0x42EBD3CB }
+    },
+    {
+        { 0xF8E8F683, 0x6DFCF787, 0x3F7FBE90, 0x13D72B7A, 0x2DF232CF, 0xFD426D94, 0x5FE39AAD, 0xED84BB42 },
+        { 0x732995FC, 0x023E67A1, 0x355430E3, 0x67DD0A8E, 0x97A1D703, 0x0CF83B61, 0x583C33F2, 0xA3233455 }
+    },
+    {
+        { 0x68142904, 0x27014AB4, 0x00CFA617, 0xFB500882, 0x7009B958, 0x6745FF87, 0xD449242D, 0x9E9889BC },
+        { 0x575616C8, 0x035B613B, 0x138E99E2, 0x00855156, 0x292E6AA0, 0x94C0D24B, 0x7E79B3A2, 0xD9BA5B68 }
+    },
+    {
+        { 0x5F165D99, 0xCEBBBC7B, 0x8A4EEE61, 0x50CC51C1, 0x1B4D0D1F, 0xB31D2353, 0x66382ADA, 0x95E18452 },
+        { 0x0A839B5B, 0xACAD4F81, 0x4142FF0F, 0xA0A2A96E, 0x1F4FA12F, 0x3EAA8289, 0x6B0FB8F3, 0x68D68C8F }
+    },
+    {
+        { 0x839BB85F, 0x320F09C3, 0xA050E62C, 0x0101FB06, 0x9AD53458, 0x557582C9, 0x1666432B, 0x55D5398D },
+        { 0x4FED936F, 0xF7F63118, 0x1833D9E1, 0xD90D6A7F, 0x8EBAA72A, 0x059C6A9E, 0x49FF8E2D, 0x576E2290 }
+    },
+    {
+        { 0x51BBB3F1, 0x9311A269, 0x8D0F4F65, 0xE80F26BD, 0x6BECCBB9, 0x9D3DC334, 0x101E5DE4, 0x54E244D5 },
+        { 0xF1B19E28, 0xB3AD4C6E, 0x58C2E3B7, 0x4334FBC0, 0x35DF9C25, 0x19BD4107, 0xEC106EB6, 0xD6BBEC0E }
+    },
+    {
+        { 0xE5046DC5, 0x788251C7, 0xF179327B, 0x12839B95, 0x4A8CB46E, 0xF1C05D98, 0x3C00736B, 0x443737CD },
+        { 0x12CD8FE5, 0xA760A456, 0x0817BDD9, 0x797489DE, 0xF42C23E8, 0xC56EB80A, 0xE6FE7AF5, 0x83719DD7 }
+    },
+    {
+        { 0x3FEFCFC8, 0xE8881A83, 0xB9B5290B, 0xAEA3C9E0, 0x771E4688, 0x10B37ECD, 0xD4D021B6, 0xEE0816A3 },
+        { 0xB3A8CAA1, 0x8E9929BF, 0xC105F2D1, 0x48915DCF, 0xDB49019F, 0x3A5FDF82, 0xAD9006E1, 0xC4A438E3 }
+    },
+    {
+        { 0x87DE4B29, 0x5DB9620F, 0xD91ECB2E, 0xD7420C18, 0x32ACF105, 0x301BA1B2, 0x7853A937, 0xDB96BB0C },
+        { 0xC359AC34, 0xD84BFEF6, 0x64852A1D, 0xAB80CEF0, 0xB9DA1717, 0x3FBEE4D3, 0x7A13222C, 0xB325074E }
+    },
+    {
+        { 0xE83AD2C9, 0x5D6DC503, 0xAED035BE, 0xCA9F7A1D, 0xCBD21E33, 0x552788AC, 0xE09CB9F0, 0x8699DD31 },
+        { 0x329BF961, 0x38584196, 0xB82A5AF9, 0x4CB20E96, 0xC72C78C1, 0x24199908, 0xE92859B7, 0x16E65484 }
+    },
+    {
+        { 0x052FDE29, 0x6A201C4B, 0x0031DBB4, 0x6C897123, 0x16C1DA96, 0x4A759982, 0x2CC67214, 0xEEC0B975 },
+        { 0x812C864E, 0xB908B9F1, 0x8439F6BA, 0x367FB66A, 0xF966F329, 0x789D664B, 0xF7F1D283, 0xE02AF770 }
+    },
+    {
+        { 0xDB3038DD, 0xA20A2C70, 0xE99D5C7C, 0x5F0B46D5, 0x4B600B83, 0xC9B97D37, 0x3DF3245E, 0x186C7F79 },
+        { 0x4F1CE57F, 0x2AF72460, 0x91E2D8ED, 0x9249897F, 0x8D2EA797, 0x8139B36A, 0x9AB58913, 0x9C428DB8 }
+    },
+    {
+        { 0x6471AAA0, 0xB4A196FB, 0x1B6B9730, 0xDCBAB650, 0x295B57D2, 0x7AFCCC8A, 0x4E33A65D, 0xEE2280F4 },
+        { 0x890FCD12, 0xC47A0803, 0x82604F6B, 0x4E98A98D, 0xED5FBBD2, 0x0D598F06, 0xA6A1EB84, 0xCE46EC91 }
+    },
+    {
+        { 0x4BE6458D, 0x1F1E4F3F, 0x595E6547, 0x5F72CC22, 0x271A93F1, 0x5BC5341E, 0x58A5F263, 0xC62E155C },
+        { 0x58BA7FF4, 0x5F6F845A, 0x7E36A6AD, 0x67E1F7DC, 0xEEAA4D04, 0xD33A7657, 0x18267E4E, 0xFF9F2322 }
+    },
+    {
+        { 0x4A53789F, 0xD369F11F, 0x3696B437, 0xC7876FB6, 0x0BABA29A, 0xA0E8F0A7, 0x32F6E514, 0xA0318A5F },
+        { 0x11775A08, 0x5C4A43D1, 0x362EEBB1, 0x418C507C, 0x09A325AA, 0xFD08903F, 0xF0EEBB3A, 0xF320B8FC }
+    },
+    {
+        { 0xC7644C1D, 0xE33F0255, 0xBB9002D8, 0x4030ECC3, 0xF4646F9F, 0xA4486916, 0x959C44FA, 0x5E677D0C },
+        { 0xD88B9144, 0xE2E7D7D0, 0x6248F91F, 0x5D93A86F, 0x02993AEA, 0xE33D0BD5, 0x3100D31E, 0x449F0CE6 }
+    },
+    {
+        { 0x73CF2678, 0x3FCD925A, 0xA6D0AFC7, 0x34CA923B, 0x3067791F, 0x9011091D, 0x5A7941E4, 0x8C568874 },
+        { 0xFC339800, 0x34D37180, 0x595C51F4, 0x7744316B, 0xE88C6420, 0xF2DDB693, 0x5BAD14D2, 0xFB3A48B1 }
+    },
+    {
+        { 0xFDAAB256, 0x52DF1588, 0x3127354C, 0x68C0CD44, 0xA591F853, 0x2A849471, 0x93D0CB92, 0xE4DA88E9 },
+        { 0x1639C624, 0x6D1EA35D, 0x263707BA, 0x60FE2A36, 0xD0F3BC51, 0x97FC50DE, 0x10062E80, 0xF7FA4D15 }
+    },
+    {
+        { 0x024C168D, 0xC429A113, 0x3FEAA272, 0xB6C935FB, 0xE639EC09, 0xB58A6071, 0xF9C13DE7, 0x4B59253A },
+        { 0xFBFB8955, 0x6D2D68F2, 0x50723FE2, 0xF0064C12, 0x01F185F5, 0xE85D7820, 0x7FA79C93, 0xAA0307BF }
+    },
+    {
+        { 0x5B696527, 0x2E75A266, 0x5A00169C, 0x1A2530B0, 0x4286FB42, 0x76C4C180, 0x8E831D5B, 0x825F0194 },
+        { 0xEF703739, 0xDBF0A11F, 0xCE5B106A, 0x106F9BC4, 0x24111150, 0x61794C4F, 0xBC723A17, 0x435872FE }
+    }
+};
+#elif ATCA_ECC_P256_COMB_TEETH == 6
+static const uint32_t p256_comb[P256_COMB_POINTS][2][P256_WORDS] = {
+    {
+        { 0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2 },
+        { 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2 }
+    },
+    {
+        { 0xB049E7CD, 0xCD013F88, 0xE57FDC00, 0xE8F9257A, 0xFC3A9301, 0x3BE71969, 0x58CFF937, 0x987F256D },
+        { 0x6EFA35D6, 0xB7254BBC, 0x07AAFFDB, 0x47B46052, 0x0007E39E, 0xE860EBD6, 0x94EC505C, 0x8E926956 }
+    },
+    {
+        { 0x5A1C3FB1, 0x59DB167C, 0xBF318EB2, 0x98B3CE2A, 0xD2BC2FA6, 0x2DF1C41E, 0x6ED1B2AF, 0xEFCC2C43 },
+        { 0x97B25513, 0x17FE07F1, 0x3734A589, 0x46824533, 0xED34F543, 0xA5384A77, 0x8D9F3863, 0xF3684F9C }
+    },
+    {
+        { 0xBF780C2C, 0xFDC73E83, 0x2D666817, 0xFFDC6794, 0x02436893, 0xC14B66DD, 0x0D54650C, 0x6EEC9567 },
+        { 0xEDBFCD32, 0x089EC1A1, 0x3A07FF89, 0x79AB6615, 0x65EA0105, 0xFC281DE0, 0x997732C2, 0x14BB5350 }
+    },
+    {
+        { 0x7318188E, 0xAEC90264, 0xCA167099, 0x410BEC28, 0x099C202B, 0xBF664D2F, 0x55FA625C, 0x13CCCA34 },
+        { 0x05421C0C, 0xAA84C231, 0x6CDB0D71, 0x6B647521, 0xFB216A5E, 0xE90446B1, 0xAF46893D, 0x4B5BA5A5 }
+    },
+    {
+        { 0x4862C5DB, 0xACA2FA08, 0xA1717F8A, 0xDDFFC222, 0xE4E09FD2, 0xAB839A14, 0x980330F5, 0xF86A9078 },
+        { 0xC1DD7DCC, 0x6890F24C, 0xEA6EFD98, 0xF75DCCFA, 0xFF9A093B, 0xBA2612B8, 0x2568653C, 0x20347D0C }
+    },
+    {
+        { 0xCBDB1C78, 0xD3B22809, 0x30F6CDA4, 0x5591C8EB, 0xBFE80F8B, 0xB6E28740, 0x40E7E7E7, 0x0F74342A },
+        { 0x351C51F2, 0xD2968E87, 0xF5E17B5E, 0x65C5C581, 0x9D994E2E, 0x6F58F02A, 0xF5C1EC07, 0x531C0B00 }
+    },
+    {
+        { 0x1A6B665E, 0xEB042121, 0xA7F6803A, 0x802F779E, 0x3C0804C3, 0x47501F2A, 0x4945A1D4, 0xA263919B },
+        { 0x30BCDCFB, 0x9EE40400, 0x4C00EFE2, 0xAC3F83DF, 0xE60D60C5, 0x2E9D3C9D, 0x2AED20FC, 0x873200BD }
+    },
+    {
+        { 0x8B21AA51, 0x2B52C47D, 0x5A7E870D, 0x0F503629, 0x88B45127, 0xBAA92814, 0xC402E050, 0x27D6451E },
+        { 0x5567432D, 0x5C96EC14, 0x0F4150C7, 0xCDEB9829, 0xCDEEF566, 0x5D91740C, 0x1BE9E583, 0x2A58FA5E }
+    },
+    {
+        { 0x5788C0F6, 0xD8142DFF, 0x247FDE25, 0x89BF5229, 0x14E2280F, 0x5C971DDB, 0x09904E3F, 0x785B7E91 },
+        { 0x2E7E6F0B, 0x445E4519, 0x4CE293DD, 0x8789440E, 0xC797BE30, 0x96B84F57, 0xFA3EA32D, 0x6B44059D }
+    },
+    {
+        { 0x2195A979, 0x73B7C550, 0xB8DD5813, 0x2D7ED474, 0xE104E9AC, 0xC0B9ECD2, 0xA2BD0ED8, 0xDC90D975 },
+        { 0x4DD6EB2E, 0x9FB55203, 0xC01DFDE8, 0x50D554BB, 0xF0977A30, 0x4CFD3277, 0x815374C4, 0xC87CE232 }
+    },
+    {
+        { 0xCF9A3CA9, 0xE4B541B6, 0x08B49B2F, 0x1C650587, 0xF552641E, 0xB95F91B3, 0x5C301277, 0xBDDC23AC },
+        { 0x04DABA43, 0x519D0700, 0x8450CFA2, 0xC003DCC3, 0x4E48EFDE, 0x73A1C8F5, 0x5B04F761, 0x7D0CA942 }
+    },
+    {
+        { 0x1703406D, 0xCB4DC35B, 0x75DAC54C, 0x4FD3AFC9, 0x29F02878, 0x112321EB, 0xAD6B225F, 0xAFB18D2F },
+        { 0xF1776A67, 0xDDF58273, 0xF6B96C2F, 0x96889755, 0x22208FFB, 0x31A8D663, 0xFCCA4877, 0x5ED81C10 }
+    },
+    {
+        { 0xE834A3C4, 0xFF0E1F34, 0x1C4AB236, 0x0D59B6AE, 0x015A211B, 0x10EB194A, 0x3892DDC5, 0xED6E13E0 },
+        { 0xFB3F678D, 0xAC88DF04, 0x544026A9, 0x6F0FBF44, 0x619CECBA, 0xCDE8CD7A, 0x80D9A8CC, 0x02F322E5 }
+    },
+    {
+        { 0x336AAF40, 0x2DC61E1B, 0x4251F5B7, 0x897E87BD, 0x6511B370, 0x2FB32023, 0x2341F499, 0x460FA9CF },
+        { 0xCBAF01A7, 0x03E63B79, 0x44157434, 0x937E123F, 0x809E4A1A, 0x9D59226E, 0x41775E62, 0x18D6F63A }
+    },
+    {
+        { 0xA9AA52DF, 0x3CD5F4E4, 0xB42A627F, 0x18C452B1, 0xD991ECE6, 0x6DBC4189, 0x7F608BF7, 0x45A511C9 },
+        { 0x125EC16C, 0x7B52BD12, 0xD22955CE, 0x5A919B27, 0xCB625AD2, 0x3FE3337F, 0x73EA9B6D, 0x73BE0EC7 }
+    },
+    {
+        { 0x016476EA, 0xC6E4B6D0, 0xD4EC2510, 0x71B9A7E5, 0xCBE490D2, 0x1975B71E, 0xB52ACD25, 0xDF6B472F },
+        { 0x784055EB, 0xF1738716, 0xB87D399E, 0xCCC7B0B3, 0x1BB51119, 0x3C9A1337, 0xA88FD593, 0xB42639E1 }
+    },
+    {
+        { 0xC219C20B, 0x86A38D54, 0xB50A4733, 0xAFCDD2CA, 0x72096638, 0xF4CF8797, 0x24CE0E94, 0xD949CAA2 },
+        { 0x96F9AE13, 0x678664AE, 0xC984DE46, 0x00EF5BA9, 0x8D549567, 0x622ABC7F, 0x57DB924D, 0x673ED500 }
+    },
+    {
+        { 0x20B4D697, 0x41E94206, 0x29FA0DF9, 0xA10FD0D9, 0x76022C38, 0xF11EB0A7, 0xA5621C63, 0xFFCB7DDC },
+        { 0x0927965A, 0x24E37B1B, 0xBD2C199E, 0x8D9FC102, 0x907F3F85, 0x862DE75E, 0x5A9C778E, 0xD3985129 }
+    },
+    {
+        { 0xB56BC451, 0x48D63748, 0xA939440A, 0x0544DE81, 0x664EC19C, 0xDA24EB0B, 0x41F42BF6, 0x4FB6E562 },
+        { 0x66BB5D6B, 0x21B2C80E, 0xD25BD41B, 0xA4123924, 0xBCE2D418, 0x6F95F5F2, 0x4D6D91D8, 0xA9232776 }
+    },
+    {
+        { 0xF119B8CC, 0x546A08E7, 0x8AFC696A, 0x03B7D523, 0x459F70B4, 0x0A896132, 0xA86A9116, 0x57A46257 },
+        { 0xBB314C65, 0xFAA56FEF, 0x74795C6D, 0xF4E61F40, 0x437850D6, 0x1A3C5652, 0x6621EC11, 0x7C4B127D }
+    },
+    {
+        { 0xE83CFA35, 0x6DD25E26, 0x1FF3BDDC, 0x61E44DA0, 0x121733FA, 0xB7B67B02, 0xFCD798CA, 0x7C48F60D },
+        { 0x090F5154, 0x244D234A, 0x8CAE33BB, 0x93B7F2FB, 0x426D1516, 0x158BF2F6, 0xA801E86E, 0xA8A947A8 }
+    },
+    {
+        { 0x56C8815E, 0xF41E0307, 0x7D37A2F1, 0xBAF647E3, 0xFEFAFBF5, 0x7791EB36, 0x35B7F606, 0x158262FB },
+        { 0x32DCE9E5, 0xF6C32255, 0x361B4780, 0x6C7CD4CE, 0x3F85288F, 0xE5BE5E70, 0xC98E624A, 0x4C281AA3 }
+    },
+    {
+        { 0x7FD58AE5, 0x9D7F749E, 0x37EA57A2, 0xC78BA263, 0x4F5AB5B7, 0xB5C05127, 0x5F2D643B, 0x6FD3F54D },
+        { 0x2116B8CE, 0x3428E311, 0x71B28987, 0xC52D1D24, 0x8299421F, 0x87F70BE9, 0x64F49798, 0x0A5FD098 }
+    },
+    {
+        { 0x4D6A3DEF, 0x5B2911DD, 0xB96008F1, 0x4BEDD07C, 0xE36E7D64, 0xEE748A6F, 0x4BBF5CF4, 0xBFC49934 },
+        { 0x8E74750F, 0x55C6F62D, 0x48919902, 0x22639F87, 0x958A248F, 0xFA01AA94, 0xED51AA40, 0x2743AE8A }
+    },
+    {
+        { 0xE76CCBC0, 0x75EA69CB, 0xA762DEB7, 0xC9736051, 0xAF2BFF4C, 0xA720D4C6, 0xBE6D6DBA, 0x8E4C7B10 },
+        { 0x2F128433, 0xAF5C0EFE, 0xA1FE85EC, 0x834CBF1F, 0x2685F018, 0xD321C5A6, 0x717A5340, 0xB5B09CF6 }
+    },
+    {
+        { 0x86EB7815, 0x9CDDA821, 0xCE413265, 0x8C003612, 0x91B577F5, 0x8BCE1FAB, 0x488F730C, 0x0F3F29FF },
+        { 0xE6960D55, 0xEBB08063, 0xAECBF467, 0x1A9699E2, 0x4CE5761B, 0x6B1564A4, 0x81382996, 0x08F00EA5 }
+    },
+    {
+        { 0x96BF8EA5, 0x6C10CDD2, 0xE8CD868F, 0xE28C488A, 0x46442D00, 0xBA9226C3, 0xFA1F864B, 0x9125CAED },
+        { 0x2E21B4AF, 0xF33BD66E, 0x68DBE58C, 0x12DC5537, 0xE5353044, 0xD9B85123, 0x07BC6B60, 0xF4925BDE }
+    },
+    {
+        { 0x70514A21, 0x0D17FF39, 0xDADD80EE, 0xD2A7B5BA, 0x8126C8C4, 0x941E33C3, 0x1D57C1DE, 0xB9E156D0 },
+        { 0xEA8105AD, 0x220D500D, 0x0202F3AE, 0x6A2AA462, 0x3DC96356, 0x450056AB, 0x452142C3, 0x506AB6AA }
+    },
+    {
+        { 0x1B20D599, 0xE0CB1029, 0x10A5FBA0, 0x7B1ED83D, 0x04007713, 0x7D5FB32B, 0x79C82639, 0x93BAB590 },
+        { 0x49B97D9D, 0x977FA5A6, 0x3551254A, 0xA3592333, 0xA9F7A3EB, 0x8F277388, 0xE3026E2C, 0x36ABA935 }
+    },
+    {
+        { 0xC05131CD, 0xF197735B, 0x22BEB567, 0x05650768, 0xF7F55B1F, 0xDBF2B189, 0x132C2614, 0xAA144C82 },
+        { 0xB3822251, 0xF41CBE14, 0xFFD0AFBE, 0xB1CE72B2, 0x844743FA, 0x01A14D18, 0x923739B8, 0xC1D89FE3 }
+    },
+    {
+        { 0x0B79847D, 0xF0F679F1, 0x6BB19BE6, 0x3719A8B6, 0xDC7F43D5, 0x2DDB6C3D, 0xDA0982E2, 0x2800043A },
+        { 0x908D9EDA, 0xFE5B0083, 0xB8513AE9, 0xA87058DB, 0x84A4DC3B, 0xB6C07965, 0x67E82909, 0x0F991746 }
+    },
+    {
+        { 0x5F3F5B80, 0x12416A5C, 0xDA522422, 0x58E903DB, 0x4291867E, 0x18CC80F1, 0x7A152C2B, 0xB2035CF8 },
+        { 0x95C80EDE, 0x71125691, 0xAF97C5B0, 0xBFE02568, 0x8A14E493, 0x603E1DC5, 0x749680DE, 0xF12F359C }
+    },
+    {
+        { 0x6AA2B49D, 0x1CAAB0BA, 0x6F7FC502, 0x6A75A768, 0x57EA120F, 0x6A5EA5A8, 0xDB6BDF96, 0x998CD5F9 },
+        { 0x467184A9, 0xD2D7BA4C, 0x25C03723, 0xBE178E54, 0xBC389EF3, 0x6BFC1707, 0x7B7D9FB3, 0x3256A8A0 }
+    },
+    {
+        { 0xFEA77B0C, 0x40429D1B, 0x595E9A31, 0x4651A4DC, 0xE712693A, 0x8900AAB1, 0x84BF612D, 0x90EA7767 },
+        { 0x0D02F2B6, 0xBDD10425, 0xFB4D594F, 0xF5583BCC, 0x5BA7B6A1, 0x75754462, 0x101E86F4, 0xD1A321D3 }
+    },
+    {
+        { 0x5AC0B3DB, 0x7A2F10B2, 0xF0B98928, 0xE6DEFFA0, 0xE6B0B01A, 0xB4B2939B, 0x0A3F2CA8, 0xA03E1D52 },
+        { 0x2CBEAD24, 0xFC779531, 0xD30FA3F9, 0xE8362908, 0xF23B00BB, 0x6F29D6F4, 0xEBB82E0A, 0xEA1AD22F }
+    },
+    {
+        { 0xE62DA069, 0x6890B26C, 0x7C586265, 0xA5702319, 0x865672AB, 0xE64E19BF, 0xA07D9893, 0xA66503F5 },
+        { 0x21FE4743, 0xE4DEB7C0, 0x7D7100BE, 0x3BAE847D, 0xE17B1D29, 0x1769FCA7, 0x320AFC60, 0xADBA60EC }
+    },
+    {
+        { 0x89806E19, 0x74814E1C, 0xF9EC85DE, 0x9135FC8D, 0x09AFD25B, 0x0EE660A6, 0x6740A284, 0x943DE3B7 },
+        { 0x622227D9, 0xDBA0327F, 0xD4C486E8, 0xA524C6D6, 0x7134581A, 0x217FB779, 0xE4254A7E, 0xAFA3B65F }
+    },
+    {
+        { 0xC4E48158, 0xA3C9D614, 0xAE8FC508, 0xB26B4A98, 0x38B68E18, 0x44EF8BE0, 0xDB271FCD, 0xBE9CF596 },
+        { 0x8E6F95AD, 0x737B653E, 0x9B9E4D0A, 0x73DBE6FF, 0xA4139F59, 0x4B772A8C, 0x66C67E8A, 0xA1F335E5 }
+    },
+    {
+        { 0x2D00715B, 0x0ABFA3EE, 0xC8297B47, 0xF3F65DC1, 0x00669E85, 0x4199B659, 0x23C09567, 0x7588DF7F },
+        { 0x868D3227, 0xABDF62FA, 0x8099A8FC, 0xA0844D34, 0x3BABBC72, 0x3361B9C0, 0x6D5BF03B, 0xBB0357A4 }
+    },
+    {
+        { 0xF77CF152, 0xC0B161FB, 0x8CE30043, 0x243C4FED, 0x050E20DF, 0xB1B4A2D0, 0xC34999AE, 0x5A61A286 },
+        { 0x70214EB7, 0x8C7BAF68, 0xF2C261FE, 0x975BCA7D, 0x1ED91AE8, 0x03C6DF31, 0xA1380D38, 0xE8CFAAAD }
+    },
+    {
+        { 0x016F613C, 0xA6BCC84D, 0xC2EC4E56, 0xAE5CE038, 0xF8BE76B4, 0xAD80F035, 0x84642DD4, 0x00456C5C },
+        { 0xDE3648C8, 0x0EF7079F, 0x68D0A170, 0x7BF0B3AB, 0x56C684E3, 0xA85C96B8, 0x91D65C88, 0xFD39B0F2 }
+    },
+    {
+        { 0x966D28DD, 0xC79E3178, 0x89F8A2C1, 0x67BA8686, 0x4ACF8D42, 0xAF1F9C6D, 0xE0847F7D, 0x2D2B4273 },
+        { 0x69130CEC, 0x1D9E1A90, 0x9383E7B5, 0x95CB10FD, 0x44CC71AE, 0x73438A26, 0x1EE4EA49, 0x37EAEB10 }
+    },
+    {
+        { 0x620C767B, 0x2A675B54, 0x5AE6598E, 0xF1235F08, 0x48A35E9B, 0x3CF6A1CD, 0xD8A1B5F8, 0xF11A113E },
+        { 0x1742A887, 0xA401985D, 0xB6A73D9B, 0x3F83BD07, 0x82736067, 0x3C7307A0, 0x1F12FBB6, 0x64A1A66D }
+    },
+    {
+        { 0xD84A37DE, 0x1C12B5CB, 0xC7B1EA1A, 0x56D66DB4, 0x2CE31E9A, 0x852BE420, 0xE40FAF48, 0x17BE9C2D },
+        { 0x38CC8797, 0x735B3CCB, 0x34B1093E, 0x1F8D9D80, 0xE75B81C0, 0xD8CC6E86, 0x3FDBE697, 0x6914BF94 }
+    },
+    {
+        { 0x0CCF3981, 0x422618C9, 0x8DAB3936, 0x7F5F9610, 0x8E0A6A28, 0xCA4AB750, 0xD5BAB133, 0x8266E2FE },
+        { 0xAB5500F6, 0xFAA7545B, 0x5D994D86, 0xA91EDAEB, 0x67FB462D, 0x0A5B194B, 0x287178CE, 0x089CFD68 }
+    },
+    {
+        { 0x00B16F35, 0x54B44D33, 0x002D5707, 0x59988EF3, 0xD0494F94, 0x256FE1EB, 0x7F710DE4, 0xAEF84169 },
+        { 0x8BD49604, 0xCA38FB1F, 0xBFA0B15C, 0xAEC9DAAE, 0x642CF6DD, 0x1551365E, 0x160E8FFF, 0x75B8B0FA }
+    },
+    {
+        { 0x01FEEA35, 0xB2466027, 0x317C61F1, 0xEA17F580, 0x786AACEB, 0x8D71EABA, 0x1CC47DAB, 0x7DE7454A },
+        { 0xFF1B1266, 0x10B69D62, 0xB9AB079C, 0xE22CC59B, 0x42B2D441, 0x9A57E43F, 0xE8C85F85, 0x22340FEC }
+    },
+    {
+        { 0xEDAB9CB9, 0x6033D113, 0xE69D45EE, 0x1DF87BA3, 0xE4D65A03, 0x93436236, 0x3F98A508, 0x5893F6F9 },
+        { 0xAAD54FAB, 0xB3832E15, 0x6BC7365E, 0x3277FF0D, 0x200C4FB8, 0xE8301118, 0xD4E9384D, 0x26E471BC }
+    },
+    {
+        { 0x68C28F39, 0x1C1DD91A, 0xF35669CA, 0xFA494334, 0x51ABB743, 0x77B40ABD, 0xE7873A25, 0xEE7400BA },
+        { 0xED2309D9, 0xF15D9BF5, 0x3DA8785A, 0x8A90D13F, 0x1BE8B67D, 0x7E4FB96C, 0xCAE9ED81, 0x196C1BA4 }
+    },
+    {
+        { 0xC52427D8, 0x3276C5A4, 0xF5A34B64, 0x66958243, 0xF36E0D92, 0x04166798, 0xC6E9E63F, 0x43E33927 },
+        { 0xF0CA8D2B, 0x899AED76, 0x0AF50DD8, 0x43B89CDE, 0x5951E13B, 0x805EA21E, 0x28413043, 0xE210DAA4 }
+    },
+    {
+        { 0x98A174FC, 0xE17F627B, 0x4DFA285E, 0x5EBCE1FF, 0x54C5F925, 0xC95FE23D, 0x3188BA78, 0x5EA59A09 },
+        { 0x2D2D8163, 0x6615BB54, 0x5DB03D95, 0x37BE4A1E, 0x4FC47762, 0xC51B5692, 0xD142931D, 0xB994CA42 }
+    },
+    {
+        { 0x0758035B, 0xCE46A165, 0xE070A0C9, 0xB33DF1AD, 0x686934C9, 0xBF01FB38, 0xF0F16ED0, 0x1CBA6257 },
+        { 0xEE93409C, 0xE538A9B6, 0x4A6B38DA, 0xD82429A1, 0xA5C215B1, 0x1488770D, 0x891D7658, 0x4ADE1F8E }
+    },
+    {
+        { 0x51A03105, 0xBF93CDA8, 0x7BE433ED, 0xB14F4A60, 0xFA1C97A1, 0x0AA4C4C3, 0xBCED726E, 0xFE1A6375 },
+        { 0x0409C304, 0x4DB68287, 0xEBF37AF4, 0x08FB9622, 0xF6ABDFF4, 0x677003EC, 0x3FB7CC37, 0xE6B2E872 }
+    },
+    {
+        { 0x27ADE63F, 0xFE702B4B, 0xA105673A, 0x5DF11A33, 0xA362B9CE, 0x0D33CB80, 0x855BB209, 0xA7BB42F5 },
+        { 0xC95FE575, 0xFDCC6096, 0x2351DEC6, 0xFF0E08D7, 0xBB6A5B28, 0xA3323FF5, 0x89F7A2AB, 0x2CAA2DAE }
+    },
+    {
+        { 0x51FF89BB, 0x252566B6, 0xDB973DDC, 0x453C333E, 0xD83F2CC2, 0xFBCD5A09, 0x3121DBD5, 0x187818EC },
+        { 0x3B46B949, 0xAEA1B45F, 0x55F753E0, 0x42314623, 0xB09991FA, 0xD59AB00B, 0x0AE0C8D7, 0xEE05650D }
+    },
+    {
+        { 0x2DA7EB49, 0x2096D676, 0xFB775E41, 0x6E04768E, 0xAF24F76C, 0xC3349C3D, 0xDE0C90F6, 0xE6DB6CCA },
+        { 0xA416FD87, 0x98AA01F5, 0x781EC427, 0x84C3270B, 0x021034B2, 0x37680F04, 0x654BF735, 0xEB90FE3C }
+    },
+    {
+        { 0xE4976DD8, 0xEAF7623C, 0xE29BD0B4, 0x92528B1A, 0x645CEC2A, 0x78158ECD, 0xB11325E9, 0x3265EAD8 },
+        { 0xC04780B7, 0x1CA27AF8, 0x2465867D, 0x14EF0845, 0x2FEEFE38, 0xB45C1887, 0x5D8730E9, 0x7C4D96BC }
+    },
+    {
+        { 0xB3571976, 0x8E35BF16, 0x346864E7, 0xE2EB0C63, 0x7E9B6C7F, 0x2B7B57E0, 0x70B35A98, 0x3157CF6F },
+        { 0x5AC49EA5, 0xFEC24C14, 0x6B1A32AE, 0xC20C5690, 0x345FA335, 0xEAEF7B4E, 0x4077475F, 0xB4C9655D }
+    },
+    {
+        { 0x6C38B3DA, 0x3C3D8C9B, 0x754433E3, 0x80818302, 0xE29E542A, 0xFE68AB07, 0xD12CBB2C, 0x81A25A61 },
+        { 0x8F685647, 0x559948A7, 0x83A56574, 0xE14EBCF6, 0x7A77DB0F, 0x1A606632, 0x0892CE93, 0xF49D838F }
+    },
+    {
+        { 0xFCF866B9, 0xF3F4E3FE, 0xE18B0AD5, 0x152A0807, 0x1B9B2E7B, 0x2EC4C706, 0xDADD006F, 0x41D7E92B },
+        { 0x1D4B6EF7, 0xFF0A8A79, 0xB2AA2F47, 0x02344DFF, 0x357A0681, 0x1726D704, 0xC1BC85F4, 0x4CE6BB77 }
+    },
+    {
+        { 0x8916A00D, 0x651EBB86, 0x001E908D, 0xBA4D2DA9, 0x1684FCB0, 0x5F2B68E6, 0x10AC6EDF, 0xC3FF8D75 },
+        { 0xF5C49A61, 0x6997E3EA, 0xB1A4DC68, 0x8F4FF372, 0xC95C2DB2, 0xBEA7CE04, 0x9D10F761, 0x2ACCB4F4 }
+    },
+    {
+        { 0xAFCC2BEF, 0xB9E437F4, 0x3ADA2B53, 0x4F1FB2D6, 0xBB580C9A, 0xE6C0E12D, 0x33C7546D, 0x25183734 },
+        { 0xBFD92FB9, 0xAB12D90F, 0xA185AE46, 0x2CB9B9B3, 0x9CE6F49F, 0x2A0C7A7E, 0xB48F21F2, 0x531F307F }
+    }
+};
+#else
+#error "ATCA_ECC_P256_COMB_TEETH must be from 4 to 6"
+#endif
+
+static void bn_from_bytes(uint32_t r[P256_WORDS], const uint8_t bytes[ATCA_ECC_P256_FIELD_SIZE])
+{
+    int i;
+
+    for (i = 0; i < P256_WORDS; i++)
+    {
+        const uint8_t* b = &bytes[(P256_WORDS - 1 - i) * 4];
+        r[i] = ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+    }
+}
+
+static int bn_is_zero(const uint32_t a[P256_WORDS])
+{
+    uint32_t acc = 0;
+    int i;
+
+    for (i = 0; i < P256_WORDS; i++)
+    {
+        acc |= a[i];
+    }
+    return 0 == acc;
+}
+
+static int bn_cmp(const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+    int i;
+
+    for (i = P256_WORDS - 1; i >= 0; i--)
+    {
+        if (a[i] != b[i])
+        {
+            return (a[i] > b[i]) ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+static uint32_t bn_add(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+    uint64_t c = 0;
+    int i;
+
+    for (i = 0; i < P256_WORDS; i++)
+    {
+        c += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    return (uint32_t)c;
+}
+
+static uint32_t bn_sub(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+    uint64_t c = 0;
+    int i;
+
+    for (i = 0; i < P256_WORDS; i++)
+    {
+        c = (uint64_t)a[i] - b[i] - c;
+        r[i] = (uint32_t)c;
+        c = (c >> 32) & 1;
+    }
+    return (uint32_t)c;
+}
+
+static void mod_add(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS], const uint32_t m[P256_WORDS])
+{
+    if (bn_add(r, a, b) || bn_cmp(r, m) >= 0)
+    {
+        (void)bn_sub(r, r, m);
+    }
+}
+
+static void mod_sub(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS], const uint32_t m[P256_WORDS])
+{
+    if (bn_sub(r, a, b))
+    {
+        (void)bn_add(r, r, m);
+    }
+}
+
+/** \brief r = a * b / R mod m */
+static void mont_mul(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS], const p256_mod_t* m)
+{
+    uint32_t t[P256_WORDS + 2];
+    uint64_t c;
+    uint32_t u;
+    int i, j;
 
-/** \brief return software generated ECDSA verification result and the function is currently not implemented
+    memset(t, 0, sizeof(t));
+    for (i = 0; i < P256_WORDS; i++)
+    {
+        c = 0;
+        for (j = 0; j < P256_WORDS; j++)
+        {
+            c += (uint64_t)t[j] + (uint64_t)a[j] * b[i];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[P256_WORDS];
+        t[P256_WORDS] = (uint32_t)c;
+        t[P256_WORDS + 1] = (uint32_t)(c >> 32);
+
+        u = t[0] * m->m_inv;
+        c = ((uint64_t)t[0] + (uint64_t)u * m->m[0]) >> 32;
+        for (j = 1; j < P256_WORDS; j++)
+        {
+            c += (uint64_t)t[j] + (uint64_t)u * m->m[j];
+            t[j - 1] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[P256_WORDS];
+        t[P256_WORDS - 1] = (uint32_t)c;
+        t[P256_WORDS] = t[P256_WORDS + 1] + (uint32_t)(c >> 32);
+    }
+
+    if (t[P256_WORDS] || bn_cmp(t, m->m) >= 0)
+    {
+        (void)bn_sub(t, t, m->m);
+    }
+    memcpy(r, t, P256_WORDS * sizeof(uint32_t));
+}
+
+/** \brief r = a^-1 in Montgomery form, by raising a to m - 2 */
+static void mont_inv(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const p256_mod_t* m)
+{
+    uint32_t e[P256_WORDS];
+    uint32_t x[P256_WORDS];
+    const uint32_t two[P256_WORDS] = { 2 };
+    int i;
+
+    (void)bn_sub(e, m->m, two);
+    memcpy(x, m->one, sizeof(x));
+    for (i = P256_BITS - 1; i >= 0; i--)
+    {
+        mont_mul(x, x, x, m);
+        if ((e[i / 32] >> (i % 32)) & 1)
+        {
+            mont_mul(x, x, a, m);
+        }
+    }
+    memcpy(r, x, sizeof(x));
+}
+
+/** \brief r = a * b mod p using the fast reduction for the NIST prime */
+static void fe_mul(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+    uint32_t c[2 * P256_WORDS];
+    int64_t w[P256_WORDS];
+    int64_t acc;
+    uint64_t t;
+    int i, j;
+
+    memset(c, 0, sizeof(c));
+    for (i = 0; i < P256_WORDS; i++)
+    {
+        t = 0;
+        for (j = 0; j < P256_WORDS; j++)
+        {
+            t += (uint64_t)c[i + j] + (uint64_t)a[i] * b[j];
+            c[i + j] = (uint32_t)t;
+            t >>= 32;
+        }
+        c[i + P256_WORDS] = (uint32_t)t;
+    }
+
+    /* FIPS 186-4 D.2.3: s1 + 2 s2 + 2 s3 + s4 + s5 - d1 - d2 - d3 - d4 per word */
+    w[0] = (int64_t)c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+    w[1] = (int64_t)c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+    w[2] = (int64_t)c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+    w[3] = (int64_t)c[3] + 2 * (int64_t)c[11] + 2 * (int64_t)c[12] + c[13] - c[15] - c[8] - c[9];
+    w[4] = (int64_t)c[4] + 2 * (int64_t)c[12] + 2 * (int64_t)c[13] + c[14] - c[9] - c[10];
+    w[5] = (int64_t)c[5] + 2 * (int64_t)c[13] + 2 * (int64_t)c[14] + c[15] - c[10] - c[11];
+    w[6] = (int64_t)c[6] + 3 * (int64_t)c[14] + 2 * (int64_t)c[15] + c[13] - c[8] - c[9];
+    w[7] = (int64_t)c[7] + 3 * (int64_t)c[15] + c[8] - c[10] - c[11] - c[12] - c[13];
+
+    acc = 0;
+    for (i = 0; i < P256_WORDS; i++)
+    {
+        acc += w[i];
+        r[i] = (uint32_t)acc;
+        acc >>= 32;
+    }
+
+    /* Fold the small signed carry back in */
+    while (acc > 0)
+    {
+        acc -= bn_sub(r, r, p256_p);
+    }
+    while (acc < 0)
+    {
+        acc += bn_add(r, r, p256_p);
+    }
+    if (bn_cmp(r, p256_p) >= 0)
+    {
+        (void)bn_sub(r, r, p256_p);
+    }
+}
+
+/** \brief r = a^-1 mod p, by raising a to p - 2 */
+static void fe_inv(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS])
+{
+    uint32_t e[P256_WORDS];
+    uint32_t x[P256_WORDS];
+    const uint32_t two[P256_WORDS] = { 2 };
+    int i;
+
+    (void)bn_sub(e, p256_p, two);
+    memcpy(x, p256_one, sizeof(x));
+    for (i = P256_BITS - 1; i >= 0; i--)
+    {
+        fe_mul(x, x, x);
+        if ((e[i / 32] >> (i % 32)) & 1)
+        {
+            fe_mul(x, x, a);
+        }
+    }
+    memcpy(r, x, sizeof(x));
+}
+
+/** \brief P = 2P with a = -3 */
+static void point_double(p256_point_t* pt)
+{
+    const uint32_t* p = p256_p;
+    uint32_t delta[P256_WORDS], gamma[P256_WORDS], beta[P256_WORDS], alpha[P256_WORDS], t[P256_WORDS];
+
+    fe_mul(delta, pt->z, pt->z);
+    fe_mul(gamma, pt->y, pt->y);
+    fe_mul(beta, pt->x, gamma);
+
+    mod_sub(t, pt->x, delta, p);
+    mod_add(alpha, pt->x, delta, p);
+    fe_mul(alpha, alpha, t);
+    mod_add(t, alpha, alpha, p);
+    mod_add(alpha, alpha, t, p);
+
+    /* Z3 = (Y + Z)^2 - gamma - delta */
+    mod_add(t, pt->y, pt->z, p);
+    fe_mul(t, t, t);
+    mod_sub(t, t, gamma, p);
+    mod_sub(pt->z, t, delta, p);
+
+    /* X3 = alpha^2 - 8 beta */
+    mod_add(beta, beta, beta, p);
+    mod_add(beta, beta, beta, p);
+    fe_mul(t, alpha, alpha);
+    mod_sub(t, t, beta, p);
+    mod_sub(pt->x, t, beta, p);
+
+    /* Y3 = alpha (4 beta - X3) - 8 gamma^2 */
+    mod_sub(beta, beta, pt->x, p);
+    fe_mul(t, alpha, beta);
+    fe_mul(gamma, gamma, gamma);
+    mod_add(gamma, gamma, gamma, p);
+    mod_add(gamma, gamma, gamma, p);
+    mod_add(gamma, gamma, gamma, p);
+    mod_sub(pt->y, t, gamma, p);
+}
+
+/** \brief P = P + (x, y) for an affine point, negated when neg is set */
+static void point_add_affine(p256_point_t* pt, const uint32_t x[P256_WORDS], const uint32_t y[P256_WORDS], int neg)
+{
+    const uint32_t* p = p256_p;
+    uint32_t y2[P256_WORDS], zz[P256_WORDS], u2[P256_WORDS], s2[P256_WORDS], h[P256_WORDS], r[P256_WORDS];
+    uint32_t hh[P256_WORDS], hhh[P256_WORDS], v[P256_WORDS];
+
+    if (neg)
+    {
+        (void)bn_sub(y2, p, y);
+    }
+    else
+    {
+        memcpy(y2, y, sizeof(y2));
+    }
+
+    if (bn_is_zero(pt->z))
+    {
+        memcpy(pt->x, x, sizeof(pt->x));
+        memcpy(pt->y, y2, sizeof(pt->y));
+        memcpy(pt->z, p256_one, sizeof(pt->z));
+        return;
+    }
+
+    fe_mul(zz, pt->z, pt->z);
+    fe_mul(u2, x, zz);
+    fe_mul(s2, y2, pt->z);
+    fe_mul(s2, s2, zz);
+    mod_sub(h, u2, pt->x, p);
+    mod_sub(r, s2, pt->y, p);
+
+    if (bn_is_zero(h))
+    {
+        if (bn_is_zero(r))
+        {
+            point_double(pt);
+        }
+        else
+        {
+            memset(pt, 0, sizeof(*pt));
+        }
+        return;
+    }
+
+    fe_mul(hh, h, h);
+    fe_mul(hhh, h, hh);
+    fe_mul(v, pt->x, hh);
+
+    /* X3 = r^2 - H^3 - 2V */
+    fe_mul(pt->x, r, r);
+    mod_sub(pt->x, pt->x, hhh, p);
+    mod_sub(pt->x, pt->x, v, p);
+    mod_sub(pt->x, pt->x, v, p);
+
+    /* Y3 = r (V - X3) - Y1 H^3 */
+    mod_sub(v, v, pt->x, p);
+    fe_mul(v, r, v);
+    fe_mul(hhh, pt->y, hhh);
+    mod_sub(pt->y, v, hhh, p);
+
+    /* Z3 = Z1 H */
+    fe_mul(pt->z, pt->z, h);
+}
+
+/** \brief Converts points to affine coordinates with a single inversion.
+ *         Points at infinity are not allowed. */
+static void points_to_affine(uint32_t (*affine)[2][P256_WORDS], p256_point_t* pts, size_t count, uint32_t (*scratch)[P256_WORDS])
+{
+    uint32_t inv[P256_WORDS], zi[P256_WORDS], zi2[P256_WORDS];
+    size_t i;
+
+    /* scratch[i] = z0 * ... * zi */
+    memcpy(scratch[0], pts[0].z, sizeof(scratch[0]));
+    for (i = 1; i < count; i++)
+    {
+        fe_mul(scratch[i], scratch[i - 1], pts[i].z);
+    }
+    fe_inv(inv, scratch[count - 1]);
+
+    for (i = count; i-- > 0;)
+    {
+        if (i > 0)
+        {
+            fe_mul(zi, inv, scratch[i - 1]);
+            fe_mul(inv, inv, pts[i].z);
+        }
+        else
+        {
+            memcpy(zi, inv, sizeof(zi));
+        }
+        fe_mul(zi2, zi, zi);
+        fe_mul(affine[i][0], pts[i].x, zi2);
+        fe_mul(zi2, zi2, zi);
+        fe_mul(affine[i][1], pts[i].y, zi2);
+    }
+}
+
+/** \brief Width-w NAF of a scalar below the group order, least significant
+ *         digit first. Returns the number of digits. */
+static int scalar_wnaf(int8_t naf[P256_BITS + 1], const uint32_t scalar[P256_WORDS])
+{
+    uint32_t k[P256_WORDS + 1];
+    int len = 0;
+    int i;
+
+    memcpy(k, scalar, P256_WORDS * sizeof(uint32_t));
+    k[P256_WORDS] = 0;
+    memset(naf, 0, P256_BITS + 1);
+
+    while (!bn_is_zero(k) || k[P256_WORDS])
+    {
+        if (k[0] & 1)
+        {
+            int d = (int)(k[0] & ((1u << P256_WNAF_WIDTH) - 1));
+            uint64_t c;
+
+            if (d >= (1 << (P256_WNAF_WIDTH - 1)))
+            {
+                d -= 1 << P256_WNAF_WIDTH;
+            }
+            naf[len] = (int8_t)d;
+
+            /* k -= d, which only carries for a negative digit as a positive
+               one is the low bits of k */
+            c = (uint64_t)k[0] - (uint64_t)(int64_t)d;
+            k[0] = (uint32_t)c;
+            for (i = 1; i <= P256_WORDS && d < 0 && (c >> 32); i++)
+            {
+                c = (uint64_t)k[i] + 1;
+                k[i] = (uint32_t)c;
+            }
+        }
+        len++;
+
+        for (i = 0; i < P256_WORDS; i++)
+        {
+            k[i] = (k[i] >> 1) | (k[i + 1] << 31);
+        }
+        k[P256_WORDS] >>= 1;
+    }
+    return len;
+}
+
+/** \brief Reads a public key and checks it is on the curve */
+static int p256_load_key(uint32_t q[2][P256_WORDS], const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
+{
+    const uint32_t* p = p256_p;
+    uint32_t lhs[P256_WORDS], rhs[P256_WORDS];
+
+    bn_from_bytes(q[0], public_key);
+    bn_from_bytes(q[1], &public_key[ATCA_ECC_P256_FIELD_SIZE]);
+    if (bn_cmp(q[0], p) >= 0 || bn_cmp(q[1], p) >= 0)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    /* y^2 = x^3 - 3x + b */
+    fe_mul(lhs, q[1], q[1]);
+    fe_mul(rhs, q[0], q[0]);
+    fe_mul(rhs, rhs, q[0]);
+    mod_sub(rhs, rhs, q[0], p);
+    mod_sub(rhs, rhs, q[0], p);
+    mod_sub(rhs, rhs, q[0], p);
+    mod_add(rhs, rhs, p256_b, p);
+
+    return (bn_cmp(lhs, rhs) == 0) ? ATCA_SUCCESS : ATCA_BAD_PARAM;
+}
+
+/** \brief Builds the odd multiples Q, 3Q, 5Q, ... of several keys. The
+ *         points of all the keys share the inversions that make them affine.
+ *
+ * \param[out] tables   ATCA_ECC_P256_WNAF_POINTS points for each key
+ * \param[in]  keys     Affine keys
+ * \param[in]  count    Number of keys
+ * \param[in]  pts      Scratch for ATCA_ECC_P256_WNAF_POINTS points per key
+ * \param[in]  scratch  Scratch for ATCA_ECC_P256_WNAF_POINTS values per key
+ */
+static void p256_key_tables(uint32_t (*tables)[2][P256_WORDS], uint32_t (*keys)[2][P256_WORDS], size_t count,
+                            p256_point_t* pts, uint32_t (*scratch)[P256_WORDS])
+{
+    size_t i, j;
+
+    /* 2Q of every key, made affine into the start of the tables */
+    for (j = 0; j < count; j++)
+    {
+        memcpy(pts[j].x, keys[j][0], sizeof(pts[j].x));
+        memcpy(pts[j].y, keys[j][1], sizeof(pts[j].y));
+        memcpy(pts[j].z, p256_one, sizeof(pts[j].z));
+        point_double(&pts[j]);
+    }
+    points_to_affine(tables, pts, count, scratch);
+
+    for (j = count; j-- > 0;)
+    {
+        p256_point_t* multiples = &pts[j * ATCA_ECC_P256_WNAF_POINTS];
+        uint32_t twice[2][P256_WORDS];
+
+        memcpy(twice, tables[j], sizeof(twice));
+        memcpy(multiples[0].x, keys[j][0], sizeof(multiples[0].x));
+        memcpy(multiples[0].y, keys[j][1], sizeof(multiples[0].y));
+        memcpy(multiples[0].z, p256_one, sizeof(multiples[0].z));
+        for (i = 1; i < ATCA_ECC_P256_WNAF_POINTS; i++)
+        {
+            multiples[i] = multiples[i - 1];
+            point_add_affine(&multiples[i], twice[0], twice[1], 0);
+        }
+    }
+    points_to_affine(tables, pts, count * ATCA_ECC_P256_WNAF_POINTS, scratch);
+}
+
+/** \brief Reads a signature and the digest, checking the signature values are
+ *         in 1..n-1 */
+static int p256_load_sig(uint32_t r[P256_WORDS], uint32_t s[P256_WORDS], uint32_t e[P256_WORDS],
+                         const uint8_t msg[ATCA_ECC_P256_FIELD_SIZE],
+                         const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE])
+{
+    const p256_mod_t* n = &p256_n;
+
+    bn_from_bytes(r, signature);
+    bn_from_bytes(s, &signature[ATCA_ECC_P256_FIELD_SIZE]);
+    if (bn_is_zero(r) || bn_is_zero(s) || bn_cmp(r, n->m) >= 0 || bn_cmp(s, n->m) >= 0)
+    {
+        return ATCA_FUNC_FAIL;
+    }
+
+    bn_from_bytes(e, msg);
+    if (bn_cmp(e, n->m) >= 0)
+    {
+        (void)bn_sub(e, e, n->m);
+    }
+    return ATCA_SUCCESS;
+}
+
+/** \brief Checks u1 G + u2 Q has x equal to r mod n
+ *
+ * \param[in] table  Odd multiples of Q
+ * \param[in] e      Digest reduced mod n
+ * \param[in] r      Signature r
+ * \param[in] w      s^-1 in Montgomery form so multiplying by it leaves plain
+ *                   u1 and u2
+ */
+static int p256_verify(const uint32_t (*table)[2][P256_WORDS], const uint32_t e[P256_WORDS],
+                       const uint32_t r[P256_WORDS], const uint32_t w[P256_WORDS])
+{
+    const uint32_t* p = p256_p;
+    const p256_mod_t* n = &p256_n;
+    uint32_t u1[P256_WORDS], u2[P256_WORDS], x[P256_WORDS];
+    uint32_t zz[P256_WORDS], t[P256_WORDS];
+    int8_t naf[P256_BITS + 1];
+    p256_point_t pt;
+    int len;
+    int i, j;
+
+    mont_mul(u1, e, w, n);
+    mont_mul(u2, r, w, n);
+
+    /* u1 G + u2 Q sharing one doubling chain. The comb adds for the
+       generator fall in the last spacing steps. */
+    len = scalar_wnaf(naf, u2);
+    if (len < P256_COMB_SPACING)
+    {
+        len = P256_COMB_SPACING;
+    }
+    memset(&pt, 0, sizeof(pt));
+    for (i = len - 1; i >= 0; i--)
+    {
+        if (!bn_is_zero(pt.z))
+        {
+            point_double(&pt);
+        }
+
+        if (naf[i] > 0)
+        {
+            point_add_affine(&pt, table[naf[i] / 2][0], table[naf[i] / 2][1], 0);
+        }
+        else if (naf[i] < 0)
+        {
+            point_add_affine(&pt, table[-naf[i] / 2][0], table[-naf[i] / 2][1], 1);
+        }
+
+        if (i < P256_COMB_SPACING)
+        {
+            int comb = 0;
+
+            for (j = 0; j < ATCA_ECC_P256_COMB_TEETH; j++)
+            {
+                int bit = i + j * P256_COMB_SPACING;
+
+                if (bit < P256_BITS && ((u1[bit / 32] >> (bit % 32)) & 1))
+                {
+                    comb |= 1 << j;
+                }
+            }
+            if (comb)
+            {
+                point_add_affine(&pt, p256_comb[comb - 1][0], p256_comb[comb - 1][1], 0);
+            }
+        }
+    }
+
+    if (bn_is_zero(pt.z))
+    {
+        return ATCA_FUNC_FAIL;
+    }
+
+    /* x = X / Z^2 must equal r mod n, checked without an inversion as
+       r Z^2 = X for r and, when it is still below p, r + n */
+    fe_mul(zz, pt.z, pt.z);
+    memcpy(x, r, sizeof(x));
+    for (i = 0; i < 2; i++)
+    {
+        if (i > 0 && (bn_add(x, x, n->m) || bn_cmp(x, p) >= 0))
+        {
+            break;
+        }
+        fe_mul(t, x, zz);
+        if (0 == bn_cmp(t, pt.x))
+        {
+            return ATCA_SUCCESS;
+        }
+    }
+
+    return ATCA_FUNC_FAIL;
+}
+
+/** \brief Prepares a public key for verification. The key is checked to be
+ *         a point on the curve.
+ * \param[out] key         Prepared key
+ * \param[in]  public_key  X and Y coordinates of the public key
+ * \return ATCA_SUCCESS on success, ATCA_BAD_PARAM if the key is not on the
+ *         curve.
+ */
+int atcac_sw_ecdsa_verify_p256_init(atcac_sw_ecdsa_p256_key* key,
+                                    const uint8_t            public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
+{
+    p256_point_t pts[ATCA_ECC_P256_WNAF_POINTS];
+    uint32_t scratch[ATCA_ECC_P256_WNAF_POINTS][P256_WORDS];
+    uint32_t q[1][2][P256_WORDS];
+    int ret;
+
+    if (NULL == key || NULL == public_key)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (ATCA_SUCCESS == (ret = p256_load_key(q[0], public_key)))
+    {
+        p256_key_tables(key->table, q, 1, pts, scratch);
+    }
+    return ret;
+}
+
+/** \brief Verifies an ECDSA P-256 signature with a prepared public key.
+ * \param[in] key        Key prepared by atcac_sw_ecdsa_verify_p256_init()
+ * \param[in] msg        Digest that was signed
+ * \param[in] signature  R and S of the signature
+ * \return ATCA_SUCCESS if the signature is valid, ATCA_FUNC_FAIL if it is
+ *         not, otherwise an error code.
+ */
+int atcac_sw_ecdsa_verify_p256_key(const atcac_sw_ecdsa_p256_key* key,
+                                   const uint8_t                  msg[ATCA_ECC_P256_FIELD_SIZE],
+                                   const uint8_t                  signature[ATCA_ECC_P256_SIGNATURE_SIZE])
+{
+    const p256_mod_t* n = &p256_n;
+    uint32_t r[P256_WORDS], s[P256_WORDS], e[P256_WORDS], w[P256_WORDS];
+    int ret;
+
+    if (NULL == key || NULL == msg || NULL == signature)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (ATCA_SUCCESS == (ret = p256_load_sig(r, s, e, msg, signature)))
+    {
+        mont_mul(w, s, n->rr, n);
+        mont_inv(w, w, n);
+        ret = p256_verify(key->table, e, r, w);
+    }
+    return ret;
+}
+
+/** \brief Verifies an ECDSA P-256 signature in software.
  * \param[in] msg         ptr to message or challenge
  * \param[in] signature   ptr to the signature to verify
  * \param[in] public_key  ptr to public key of device which signed the challenge
- * return ATCA_UNIMPLEMENTED , as the function is currently not implemented
+ * \return ATCA_SUCCESS if the signature is valid, ATCA_FUNC_FAIL if it is
+ *         not, otherwise an error code.
  */
 
 int atcac_sw_ecdsa_verify_p256(const uint8_t msg[ATCA_ECC_P256_FIELD_SIZE],
                                const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
                                const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
 {
-    (void)msg;
-    (void)signature;
-    (void)public_key;
+    atcac_sw_ecdsa_p256_key key;
+    int ret;
+
+    if (NULL == msg || NULL == signature || NULL == public_key)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    ret = atcac_sw_ecdsa_verify_p256_init(&key, public_key);
+    if (ATCA_SUCCESS == ret)
+    {
+        ret = atcac_sw_ecdsa_verify_p256_key(&key, msg, signature);
+    }
+    return ret;
+}
+
+/** \brief Verifies up to ATCA_ECC_P256_VERIFY_BATCH signatures */
+static int p256_verify_chunk(const uint8_t* const* msgs, const uint8_t* const* signatures,
+                             const uint8_t* const* public_keys, size_t count, int* results)
+{
+    const p256_mod_t* n = &p256_n;
+    p256_point_t pts[ATCA_ECC_P256_VERIFY_BATCH * ATCA_ECC_P256_WNAF_POINTS];
+    uint32_t scratch[ATCA_ECC_P256_VERIFY_BATCH * ATCA_ECC_P256_WNAF_POINTS][P256_WORDS];
+    uint32_t tables[ATCA_ECC_P256_VERIFY_BATCH * ATCA_ECC_P256_WNAF_POINTS][2][P256_WORDS];
+    uint32_t keys[ATCA_ECC_P256_VERIFY_BATCH][2][P256_WORDS];
+    uint32_t r[ATCA_ECC_P256_VERIFY_BATCH][P256_WORDS];
+    uint32_t s[ATCA_ECC_P256_VERIFY_BATCH][P256_WORDS];
+    uint32_t e[ATCA_ECC_P256_VERIFY_BATCH][P256_WORDS];
+    uint32_t inv[P256_WORDS];
+    size_t key_idx[ATCA_ECC_P256_VERIFY_BATCH];
+    size_t key_count = 0;
+    size_t valid[ATCA_ECC_P256_VERIFY_BATCH];
+    size_t valid_count = 0;
+    size_t i, j;
+    int ret = ATCA_SUCCESS;
+
+    for (i = 0; i < count; i++)
+    {
+        /* The same key appearing more than once, such as a CA key for a
+           chain of certificates, is prepared once */
+        for (j = 0; j < i; j++)
+        {
+            if (ATCA_SUCCESS == results[j] && 0 == memcmp(public_keys[i], public_keys[j], ATCA_ECC_P256_PUBLIC_KEY_SIZE))
+            {
+                break;
+            }
+        }
+        if (j < i)
+        {
+            key_idx[i] = key_idx[j];
+        }
+        else
+        {
+            key_idx[i] = key_count;
+            if (ATCA_SUCCESS != (results[i] = p256_load_key(keys[key_count], public_keys[i])))
+            {
+                ret = ATCA_FUNC_FAIL;
+                continue;
+            }
+            key_count++;
+        }
+
+        if (ATCA_SUCCESS != (results[i] = p256_load_sig(r[i], s[i], e[i], msgs[i], signatures[i])))
+        {
+            ret = ATCA_FUNC_FAIL;
+            continue;
+        }
+        valid[valid_count++] = i;
+    }
+
+    if (key_count > 0)
+    {
+        p256_key_tables(tables, keys, key_count, pts, scratch);
+    }
+
+    /* Invert every s with one inversion: scratch[k] = s0 ... sk */
+    for (i = 0; i < valid_count; i++)
+    {
+        mont_mul(s[valid[i]], s[valid[i]], n->rr, n);
+        if (i == 0)
+        {
+            memcpy(scratch[0], s[valid[0]], sizeof(scratch[0]));
+        }
+        else
+        {
+            mont_mul(scratch[i], scratch[i - 1], s[valid[i]], n);
+        }
+    }
+    if (valid_count > 0)
+    {
+        mont_inv(inv, scratch[valid_count - 1], n);
+    }
+    for (i = valid_count; i-- > 0;)
+    {
+        uint32_t w[P256_WORDS];
+
+        if (i > 0)
+        {
+            mont_mul(w, inv, scratch[i - 1], n);
+            mont_mul(inv, inv, s[valid[i]], n);
+        }
+        else
+        {
+            memcpy(w, inv, sizeof(w));
+        }
+
+        j = valid[i];
+        if (ATCA_SUCCESS != (results[j] = p256_verify(&tables[key_idx[j] * ATCA_ECC_P256_WNAF_POINTS], e[j], r[j], w)))
+        {
+            ret = ATCA_FUNC_FAIL;
+        }
+    }
+
+    return ret;
+}
+
+/** \brief Verifies many ECDSA P-256 signatures. The public keys and the
+ *         inversions of the signatures are prepared together, which costs
+ *         less than preparing each on its own, and each signature still gets
+ *         its own result.
+ *
+ * \param[in]  msgs         Digest that was signed for each signature
+ * \param[in]  signatures   R and S of each signature
+ * \param[in]  public_keys  X and Y coordinates of the key for each signature
+ * \param[in]  count        Number of signatures
+ * \param[out] results      Optional result of each signature as for
+ *                          atcac_sw_ecdsa_verify_p256()
+ * \return ATCA_SUCCESS if every signature is valid, ATCA_FUNC_FAIL if any is
+ *         not, otherwise an error code.
+ */
+int atcac_sw_ecdsa_verify_p256_batch(const uint8_t* const* msgs,
+                                     const uint8_t* const* signatures,
+                                     const uint8_t* const* public_keys,
+                                     size_t                count,
+                                     int*                  results)
+{
+    int chunk_results[ATCA_ECC_P256_VERIFY_BATCH];
+    int ret = ATCA_SUCCESS;
+    size_t done;
+    size_t i;
+
+    if (count && (NULL == msgs || NULL == signatures || NULL == public_keys))
+    {
+        return ATCA_BAD_PARAM;
+    }
+    for (i = 0; i < count; i++)
+    {
+        if (NULL == msgs[i] || NULL == signatures[i] || NULL == public_keys[i])
+        {
+            return ATCA_BAD_PARAM;
+        }
+    }
+
+    for (done = 0; done < count; done += i)
+    {
+        i = count - done;
+        if (i > ATCA_ECC_P256_VERIFY_BATCH)
+        {
+            i = ATCA_ECC_P256_VERIFY_BATCH;
+        }
+
+        if (ATCA_SUCCESS != p256_verify_chunk(&msgs[done], &signatures[done], &public_keys[done], i, chunk_results))
+        {
+            ret = ATCA_FUNC_FAIL;
+        }
+        if (results)
+        {
+            memcpy(&results[done], chunk_results, i * sizeof(chunk_results[0]));
+        }
+    }
 
-    return ATCA_UNIMPLEMENTED;
+    return ret;
 }
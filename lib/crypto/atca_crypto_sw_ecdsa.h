@@ -46,6 +46,28 @@
 #define ATCA_ECC_P256_PUBLIC_KEY_SIZE  (ATCA_ECC_P256_FIELD_SIZE * 2)
 #define ATCA_ECC_P256_SIGNATURE_SIZE   (ATCA_ECC_P256_FIELD_SIZE * 2)
 
+#ifndef ATCA_ECC_P256_COMB_TEETH
+/** Generator comb teeth from 4 to 6. The constant comb holds 2^teeth - 1
+ *  points of 64 bytes. */
+#define ATCA_ECC_P256_COMB_TEETH       (6)
+#endif
+
+/** Odd multiples of a public key kept for verification */
+#define ATCA_ECC_P256_WNAF_POINTS      (8)
+
+#ifndef ATCA_ECC_P256_VERIFY_BATCH
+/** Signatures prepared together by atcac_sw_ecdsa_verify_p256_batch. Each
+ *  takes about 1.6KB of stack. */
+#define ATCA_ECC_P256_VERIFY_BATCH     (8)
+#endif
+
+/** \brief Public key prepared for verification. Keep one for keys that verify
+ *         many signatures, such as CA keys, to skip the preparation. */
+typedef struct
+{
+    uint32_t table[ATCA_ECC_P256_WNAF_POINTS][2][8];   //!< Affine odd multiples of the key
+} atcac_sw_ecdsa_p256_key;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -53,6 +75,16 @@ extern "C" {
 int atcac_sw_ecdsa_verify_p256(const uint8_t msg[ATCA_ECC_P256_FIELD_SIZE],
                                const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
                                const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE]);
+int atcac_sw_ecdsa_verify_p256_init(atcac_sw_ecdsa_p256_key* key,
+                                    const uint8_t            public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE]);
+int atcac_sw_ecdsa_verify_p256_key(const atcac_sw_ecdsa_p256_key* key,
+                                   const uint8_t                  msg[ATCA_ECC_P256_FIELD_SIZE],
+                                   const uint8_t                  signature[ATCA_ECC_P256_SIGNATURE_SIZE]);
+int atcac_sw_ecdsa_verify_p256_batch(const uint8_t* const* msgs,
+                                     const uint8_t* const* signatures,
+                                     const uint8_t* const* public_keys,
+                                     size_t                count,
+                                     int*                  results);
 
 #ifdef __cplusplus
 }
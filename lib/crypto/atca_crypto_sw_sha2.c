@@ -203,6 +203,41 @@ int atcac_sw_sha2_256(const uint8_t* data, size_t data_size, uint8_t digest[ATCA
     return ATCA_SUCCESS;
 }
 
+/** \brief Computes the SHA256 digests of many independent messages in one
+ *         call. With the software implementation several messages are hashed
+ *         at once on processors with vector units.
+ * \param[in]  data       array of pointers to the messages to hash
+ * \param[in]  data_size  array of the message sizes
+ * \param[in]  count      number of messages
+ * \param[out] digests    count digests of ATCA_SHA2_256_DIGEST_SIZE bytes
+ *                        one after another
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+int atcac_sw_sha2_256_multi(const uint8_t* const* data, const size_t* data_size, size_t count, uint8_t* digests)
+{
+    int ret = ATCA_SUCCESS;
+
+    if (count && (NULL == data || NULL == data_size || NULL == digests))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+#if ATCA_ENABLE_SHA256_IMPL
+    sw_sha256_multi(data, data_size, count, digests);
+#else
+    {
+        size_t i;
+
+        for (i = 0; i < count && ATCA_SUCCESS == ret; i++)
+        {
+            ret = atcac_sw_sha2_256(data[i], data_size[i], &digests[i * ATCA_SHA2_256_DIGEST_SIZE]);
+        }
+    }
+#endif
+
+    return ret;
+}
+
 /** \brief Implements SHA256 HMAC-Counter per  NIST SP 800-108 used for KDF like operations */
 ATCA_STATUS atcac_sha256_hmac_counter(
     atcac_hmac_sha256_ctx* ctx,
@@ -27,11 +27,42 @@
 
 #include <string.h>
 #include "sha2_routines.h"
+#include "atca_config.h"
 #include "atca_compiler.h"
 #define rotate_right(value, places) ((value >> places) | (value << (32 - places)))
 
+/* Processor SHA-256 instructions are used when the compiler can target them
+   and the processor running the library reports them */
+#if defined(ATCA_SHA256_ACCEL) && (defined(__GNUC__) || defined(__clang__))
+#if defined(__x86_64__) || defined(__i386__)
+#define SW_SHA256_SHA_NI
+#define SW_SHA256_AVX2
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && (defined(__linux__) || defined(__APPLE__))
+#define SW_SHA256_ARMV8
+#define SW_SHA256_NEON
+#include <arm_neon.h>
+#ifdef __linux__
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+#endif
+
+static const uint32_t sw_sha256_k[] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
 /**
- * \brief Processes whole blocks (64 bytes) of data.
+ * \brief Processes whole blocks (64 bytes) of data in portable C.
  *
  * \param[in] ctx          SHA256 hash context
  * \param[in] blocks       Raw blocks to be processed
@@ -48,17 +79,6 @@ static void sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_
         uint8_t  w_byte[SHA256_BLOCK_SIZE * sizeof(uint32_t)];
     } w_union;
 
-    static const uint32_t k[] = {
-        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-    };
-
     // Loop through all the blocks to process
     for (block = 0; block < block_count; block++)
     {
@@ -117,7 +137,7 @@ static void sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_
                  ^ rotate_right(rotate_register[4], 25);
             ch = (rotate_register[4] & rotate_register[5])
                  ^ (~rotate_register[4] & rotate_register[6]);
-            t1 = rotate_register[7] + s1 + ch + k[i] + w_union.w_word[i];
+            t1 = rotate_register[7] + s1 + ch + sw_sha256_k[i] + w_union.w_word[i];
 
             rotate_register[7] = rotate_register[6];
             rotate_register[6] = rotate_register[5];
@@ -137,6 +157,255 @@ static void sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_
     }
 }
 
+#ifdef SW_SHA256_SHA_NI
+/**
+ * \brief Processes whole blocks (64 bytes) of data with the x86 SHA extensions.
+ *
+ * \param[in] ctx          SHA256 hash context
+ * \param[in] blocks       Raw blocks to be processed
+ * \param[in] block_count  Number of 64-byte blocks to process
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sw_sha256_process_sha_ni(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_t block_count)
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, abef_save, cdgh_save, tmp;
+    __m128i msg[4];
+    uint32_t block;
+    int i;
+
+    /* The instructions keep the state as ABEF and CDGH */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&ctx->hash[0]), 0xB1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&ctx->hash[4]), 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (block = 0; block < block_count; block++)
+    {
+        const uint8_t* cur_msg_block = &blocks[block * SHA256_BLOCK_SIZE];
+
+        abef_save = state0;
+        cdgh_save = state1;
+
+        for (i = 0; i < 4; i++)
+        {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&cur_msg_block[i * 16]), byte_swap);
+        }
+
+        /* Four rounds at a time while the words four groups ahead are scheduled */
+        for (i = 0; i < 16; i++)
+        {
+            tmp = _mm_add_epi32(msg[i & 3], _mm_loadu_si128((const __m128i*)&sw_sha256_k[i * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, tmp);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(tmp, 0x0E));
+
+            if (i < 12)
+            {
+                tmp = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                tmp = _mm_add_epi32(tmp, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                msg[i & 3] = _mm_sha256msg2_epu32(tmp, msg[(i + 3) & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128((__m128i*)&ctx->hash[0], _mm_blend_epi16(tmp, state1, 0xF0));
+    _mm_storeu_si128((__m128i*)&ctx->hash[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+
+/** \brief Whether the processor has the SHA extensions and the SSE levels they need */
+static int sw_sha256_has_sha_ni(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSSE3) || !(ecx & bit_SSE4_1))
+    {
+        return 0;
+    }
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    {
+        return 0;
+    }
+    return (ebx & (1u << 29)) ? 1 : 0;
+}
+#endif
+
+#ifdef SW_SHA256_ARMV8
+/**
+ * \brief Processes whole blocks (64 bytes) of data with the ARMv8 cryptography
+ *        extensions.
+ *
+ * \param[in] ctx          SHA256 hash context
+ * \param[in] blocks       Raw blocks to be processed
+ * \param[in] block_count  Number of 64-byte blocks to process
+ */
+#ifdef __clang__
+__attribute__((target("sha2")))
+#else
+__attribute__((target("+crypto")))
+#endif
+static void sw_sha256_process_armv8(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_t block_count)
+{
+    uint32x4_t state0 = vld1q_u32(&ctx->hash[0]);
+    uint32x4_t state1 = vld1q_u32(&ctx->hash[4]);
+    uint32x4_t abcd_save, efgh_save, tmp, abcd;
+    uint32x4_t msg[4];
+    uint32_t block;
+    int i;
+
+    for (block = 0; block < block_count; block++)
+    {
+        const uint8_t* cur_msg_block = &blocks[block * SHA256_BLOCK_SIZE];
+
+        abcd_save = state0;
+        efgh_save = state1;
+
+        for (i = 0; i < 4; i++)
+        {
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&cur_msg_block[i * 16])));
+        }
+
+        /* Four rounds at a time while the words four groups ahead are scheduled */
+        for (i = 0; i < 16; i++)
+        {
+            tmp = vaddq_u32(msg[i & 3], vld1q_u32(&sw_sha256_k[i * 4]));
+            abcd = state0;
+            state0 = vsha256hq_u32(state0, state1, tmp);
+            state1 = vsha256h2q_u32(state1, abcd, tmp);
+
+            if (i < 12)
+            {
+                msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]), msg[(i + 2) & 3], msg[(i + 3) & 3]);
+            }
+        }
+
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
+    }
+
+    vst1q_u32(&ctx->hash[0], state0);
+    vst1q_u32(&ctx->hash[4], state1);
+}
+
+/** \brief Whether the processor has the ARMv8 SHA-256 instructions */
+static int sw_sha256_has_armv8(void)
+{
+#ifdef __linux__
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) ? 1 : 0;
+#else
+    /* Every 64 bit Apple processor has them */
+    return 1;
+#endif
+}
+#endif
+
+typedef void (*sw_sha256_process_fn)(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_t block_count);
+
+/* Block function picked on first use - every thread picks the same one so
+   the unsynchronized update is harmless */
+static sw_sha256_process_fn sw_sha256_process_impl;
+static sw_sha256_impl_t sw_sha256_active_impl;
+
+/**
+ * \brief Selects the implementation used to process SHA256 blocks. Normally
+ *        the fastest one the processor supports is picked on first use; this
+ *        lets tests and benchmarks compare them.
+ *
+ * \param[in] impl  Implementation to use - SW_SHA256_IMPL_AUTO for the
+ *                  fastest available
+ *
+ * \return 0 on success, -1 if the implementation isn't available
+ */
+int sw_sha256_select(sw_sha256_impl_t impl)
+{
+    if (SW_SHA256_IMPL_AUTO == impl)
+    {
+#ifdef SW_SHA256_SHA_NI
+        if (sw_sha256_has_sha_ni())
+        {
+            impl = SW_SHA256_IMPL_SHA_NI;
+        }
+#endif
+#ifdef SW_SHA256_ARMV8
+        if (sw_sha256_has_armv8())
+        {
+            impl = SW_SHA256_IMPL_ARMV8;
+        }
+#endif
+        if (SW_SHA256_IMPL_AUTO == impl)
+        {
+            impl = SW_SHA256_IMPL_PORTABLE;
+        }
+    }
+
+    switch (impl)
+    {
+    case SW_SHA256_IMPL_PORTABLE:
+        sw_sha256_process_impl = sw_sha256_process;
+        break;
+#ifdef SW_SHA256_SHA_NI
+    case SW_SHA256_IMPL_SHA_NI:
+        if (!sw_sha256_has_sha_ni())
+        {
+            return -1;
+        }
+        sw_sha256_process_impl = sw_sha256_process_sha_ni;
+        break;
+#endif
+#ifdef SW_SHA256_ARMV8
+    case SW_SHA256_IMPL_ARMV8:
+        if (!sw_sha256_has_armv8())
+        {
+            return -1;
+        }
+        sw_sha256_process_impl = sw_sha256_process_armv8;
+        break;
+#endif
+    default:
+        return -1;
+    }
+    sw_sha256_active_impl = impl;
+
+    return 0;
+}
+
+/**
+ * \brief Returns the implementation processing SHA256 blocks, selecting it if
+ *        nothing has been hashed yet.
+ */
+sw_sha256_impl_t sw_sha256_get_impl(void)
+{
+    if (NULL == sw_sha256_process_impl)
+    {
+        (void)sw_sha256_select(SW_SHA256_IMPL_AUTO);
+    }
+    return sw_sha256_active_impl;
+}
+
+/**
+ * \brief Processes whole blocks (64 bytes) of data with the selected
+ *        implementation.
+ *
+ * \param[in] ctx          SHA256 hash context
+ * \param[in] blocks       Raw blocks to be processed
+ * \param[in] block_count  Number of 64-byte blocks to process
+ */
+static void sw_sha256_blocks(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_t block_count)
+{
+    if (NULL == sw_sha256_process_impl)
+    {
+        (void)sw_sha256_select(SW_SHA256_IMPL_AUTO);
+    }
+    if (block_count > 0)
+    {
+        sw_sha256_process_impl(ctx, blocks, block_count);
+    }
+}
+
 /**
  * \brief Intialize the software SHA256.
  *
@@ -183,12 +452,12 @@ void sw_sha256_update(sw_sha256_ctx* ctx, const uint8_t* msg, uint32_t msg_size)
     }
 
     // Process the current block
-    sw_sha256_process(ctx, ctx->block, 1);
+    sw_sha256_blocks(ctx, ctx->block, 1);
 
     // Process any additional blocks
     msg_size -= copy_size; // Adjust to the remaining message bytes
     block_count = msg_size / SHA256_BLOCK_SIZE;
-    sw_sha256_process(ctx, &msg[copy_size], block_count);
+    sw_sha256_blocks(ctx, &msg[copy_size], block_count);
 
     // Save any remaining data
     ctx->total_msg_size += (block_count + 1) * SHA256_BLOCK_SIZE;
@@ -228,7 +497,7 @@ void sw_sha256_final(sw_sha256_ctx* ctx, uint8_t digest[SHA256_DIGEST_SIZE])
     ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits >> 8);
     ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits >> 0);
 
-    sw_sha256_process(ctx, ctx->block, ctx->block_size / SHA256_BLOCK_SIZE);
+    sw_sha256_blocks(ctx, ctx->block, ctx->block_size / SHA256_BLOCK_SIZE);
 
     // All blocks have been processed.
     // Concatenate the hashes to produce digest, MSB of every hash first.
@@ -254,4 +523,440 @@ void sw_sha256(const uint8_t* message, unsigned int len, uint8_t digest[SHA256_D
     sw_sha256_init(&ctx);
     sw_sha256_update(&ctx, message, len);
     sw_sha256_final(&ctx, digest);
-}
\ No newline at end of file
+}
+
+#if defined(SW_SHA256_AVX2) || defined(SW_SHA256_NEON)
+/* Independent messages hashed side by side in the lanes of vector registers */
+#define SW_SHA256_LANES_MAX     (8)
+
+typedef void (*sw_sha256_lanes_fn)(uint32_t hash[8][SW_SHA256_LANES_MAX], const uint8_t* const blocks[SW_SHA256_LANES_MAX]);
+
+/** \brief A message being hashed in one lane */
+typedef struct
+{
+    const uint8_t* msg;                             //!< Next complete block of the message
+    uint32_t       msg_blocks;                      //!< Complete blocks left in the message
+    uint32_t       tail_blocks;                     //!< Padded blocks left in tail
+    const uint8_t* tail_next;                       //!< Next padded block
+    uint8_t        tail[SHA256_BLOCK_SIZE * 2];     //!< End of the message with its padding
+    uint8_t*       digest;
+} sw_sha256_lane;
+
+/* Block processed by lanes with no message */
+static const uint8_t sw_sha256_idle_block[SHA256_BLOCK_SIZE] = { 0 };
+
+static uint32_t sw_sha256_load32(const uint8_t* p)
+{
+    uint32_t value;
+
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+#endif
+
+#ifdef SW_SHA256_AVX2
+#define SW_SHA256_AVX2_ROTR(x, n)   _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+/**
+ * \brief Processes one block for each of eight messages with AVX2.
+ *
+ * \param[in,out] hash    Hash state of each lane - hash[word][lane]
+ * \param[in]     blocks  Block to process for each lane
+ */
+__attribute__((target("avx2")))
+static void sw_sha256_lanes_avx2(uint32_t hash[8][SW_SHA256_LANES_MAX], const uint8_t* const blocks[SW_SHA256_LANES_MAX])
+{
+    const __m256i byte_swap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                              12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i w[16];
+    __m256i r[8];
+    __m256i s0, s1, t1, t2;
+    int i;
+
+    for (i = 0; i < 16; i++)
+    {
+        w[i] = _mm256_shuffle_epi8(_mm256_setr_epi32(
+                                       (int)sw_sha256_load32(&blocks[0][i * 4]), (int)sw_sha256_load32(&blocks[1][i * 4]),
+                                       (int)sw_sha256_load32(&blocks[2][i * 4]), (int)sw_sha256_load32(&blocks[3][i * 4]),
+                                       (int)sw_sha256_load32(&blocks[4][i * 4]), (int)sw_sha256_load32(&blocks[5][i * 4]),
+                                       (int)sw_sha256_load32(&blocks[6][i * 4]), (int)sw_sha256_load32(&blocks[7][i * 4])), byte_swap);
+    }
+    for (i = 0; i < 8; i++)
+    {
+        r[i] = _mm256_loadu_si256((const __m256i*)hash[i]);
+    }
+
+    for (i = 0; i < 64; i++)
+    {
+        if (i >= 16)
+        {
+            s0 = w[(i - 15) & 15];
+            s0 = _mm256_xor_si256(_mm256_xor_si256(SW_SHA256_AVX2_ROTR(s0, 7), SW_SHA256_AVX2_ROTR(s0, 18)), _mm256_srli_epi32(s0, 3));
+            s1 = w[(i - 2) & 15];
+            s1 = _mm256_xor_si256(_mm256_xor_si256(SW_SHA256_AVX2_ROTR(s1, 17), SW_SHA256_AVX2_ROTR(s1, 19)), _mm256_srli_epi32(s1, 10));
+            w[i & 15] = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], s0), _mm256_add_epi32(w[(i - 7) & 15], s1));
+        }
+
+        s1 = _mm256_xor_si256(_mm256_xor_si256(SW_SHA256_AVX2_ROTR(r[4], 6), SW_SHA256_AVX2_ROTR(r[4], 11)), SW_SHA256_AVX2_ROTR(r[4], 25));
+        t1 = _mm256_xor_si256(_mm256_and_si256(r[4], r[5]), _mm256_andnot_si256(r[4], r[6]));
+        t1 = _mm256_add_epi32(_mm256_add_epi32(r[7], s1), _mm256_add_epi32(t1, w[i & 15]));
+        t1 = _mm256_add_epi32(t1, _mm256_set1_epi32((int)sw_sha256_k[i]));
+        s0 = _mm256_xor_si256(_mm256_xor_si256(SW_SHA256_AVX2_ROTR(r[0], 2), SW_SHA256_AVX2_ROTR(r[0], 13)), SW_SHA256_AVX2_ROTR(r[0], 22));
+        t2 = _mm256_xor_si256(_mm256_and_si256(r[0], _mm256_xor_si256(r[1], r[2])), _mm256_and_si256(r[1], r[2]));
+        t2 = _mm256_add_epi32(s0, t2);
+
+        r[7] = r[6];
+        r[6] = r[5];
+        r[5] = r[4];
+        r[4] = _mm256_add_epi32(r[3], t1);
+        r[3] = r[2];
+        r[2] = r[1];
+        r[1] = r[0];
+        r[0] = _mm256_add_epi32(t1, t2);
+    }
+
+    for (i = 0; i < 8; i++)
+    {
+        _mm256_storeu_si256((__m256i*)hash[i], _mm256_add_epi32(r[i], _mm256_loadu_si256((const __m256i*)hash[i])));
+    }
+}
+#endif
+
+#ifdef SW_SHA256_NEON
+#define SW_SHA256_NEON_ROTR(x, n)   vsriq_n_u32(vshlq_n_u32(x, 32 - (n)), x, n)
+
+/**
+ * \brief Processes one block for each of four messages with NEON.
+ *
+ * \param[in,out] hash    Hash state of each lane - hash[word][lane]
+ * \param[in]     blocks  Block to process for each lane
+ */
+static void sw_sha256_lanes_neon(uint32_t hash[8][SW_SHA256_LANES_MAX], const uint8_t* const blocks[SW_SHA256_LANES_MAX])
+{
+    uint32x4_t w[16];
+    uint32x4_t r[8];
+    uint32x4_t s0, s1, t1, t2;
+    uint32_t word[4];
+    int i;
+    int j;
+
+    for (i = 0; i < 16; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            word[j] = sw_sha256_load32(&blocks[j][i * 4]);
+        }
+        w[i] = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(vld1q_u32(word))));
+    }
+    for (i = 0; i < 8; i++)
+    {
+        r[i] = vld1q_u32(hash[i]);
+    }
+
+    for (i = 0; i < 64; i++)
+    {
+        if (i >= 16)
+        {
+            s0 = w[(i - 15) & 15];
+            s0 = veorq_u32(veorq_u32(SW_SHA256_NEON_ROTR(s0, 7), SW_SHA256_NEON_ROTR(s0, 18)), vshrq_n_u32(s0, 3));
+            s1 = w[(i - 2) & 15];
+            s1 = veorq_u32(veorq_u32(SW_SHA256_NEON_ROTR(s1, 17), SW_SHA256_NEON_ROTR(s1, 19)), vshrq_n_u32(s1, 10));
+            w[i & 15] = vaddq_u32(vaddq_u32(w[i & 15], s0), vaddq_u32(w[(i - 7) & 15], s1));
+        }
+
+        s1 = veorq_u32(veorq_u32(SW_SHA256_NEON_ROTR(r[4], 6), SW_SHA256_NEON_ROTR(r[4], 11)), SW_SHA256_NEON_ROTR(r[4], 25));
+        t1 = veorq_u32(vandq_u32(r[4], r[5]), vbicq_u32(r[6], r[4]));
+        t1 = vaddq_u32(vaddq_u32(r[7], s1), vaddq_u32(t1, w[i & 15]));
+        t1 = vaddq_u32(t1, vdupq_n_u32(sw_sha256_k[i]));
+        s0 = veorq_u32(veorq_u32(SW_SHA256_NEON_ROTR(r[0], 2), SW_SHA256_NEON_ROTR(r[0], 13)), SW_SHA256_NEON_ROTR(r[0], 22));
+        t2 = veorq_u32(vandq_u32(r[0], veorq_u32(r[1], r[2])), vandq_u32(r[1], r[2]));
+        t2 = vaddq_u32(s0, t2);
+
+        r[7] = r[6];
+        r[6] = r[5];
+        r[5] = r[4];
+        r[4] = vaddq_u32(r[3], t1);
+        r[3] = r[2];
+        r[2] = r[1];
+        r[1] = r[0];
+        r[0] = vaddq_u32(t1, t2);
+    }
+
+    for (i = 0; i < 8; i++)
+    {
+        vst1q_u32(hash[i], vaddq_u32(r[i], vld1q_u32(hash[i])));
+    }
+}
+#endif
+
+/** \brief Writes a hash state out as a digest */
+static void sw_sha256_digest(const uint32_t hash[8], uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        digest[i * 4 + 0] = (uint8_t)(hash[i] >> 24);
+        digest[i * 4 + 1] = (uint8_t)(hash[i] >> 16);
+        digest[i * 4 + 2] = (uint8_t)(hash[i] >> 8);
+        digest[i * 4 + 3] = (uint8_t)(hash[i] >> 0);
+    }
+}
+
+#if defined(SW_SHA256_AVX2) || defined(SW_SHA256_NEON)
+/** \brief Starts hashing a message in a lane */
+static void sw_sha256_lane_start(sw_sha256_lane* lane, uint32_t hash[8][SW_SHA256_LANES_MAX], int idx,
+                                 const uint8_t* message, uint32_t len, uint8_t* digest)
+{
+    uint32_t rem_size = len % SHA256_BLOCK_SIZE;
+    uint64_t msg_size_bits = (uint64_t)len * 8;
+    uint8_t* tail_end;
+    int i;
+
+    sw_sha256_ctx init;
+
+    sw_sha256_init(&init);
+    for (i = 0; i < 8; i++)
+    {
+        hash[i][idx] = init.hash[i];
+    }
+
+    lane->msg = message;
+    lane->msg_blocks = len / SHA256_BLOCK_SIZE;
+    lane->tail_blocks = (rem_size + 9 > SHA256_BLOCK_SIZE) ? 2 : 1;
+    lane->tail_next = lane->tail;
+    lane->digest = digest;
+
+    memset(lane->tail, 0, sizeof(lane->tail));
+    if (rem_size)
+    {
+        memcpy(lane->tail, &message[len - rem_size], rem_size);
+    }
+    lane->tail[rem_size] = 0x80;
+
+    tail_end = &lane->tail[lane->tail_blocks * SHA256_BLOCK_SIZE];
+    for (i = 1; i <= 8; i++)
+    {
+        tail_end[-i] = (uint8_t)(msg_size_bits >> ((i - 1) * 8));
+    }
+}
+
+/** \brief Takes the next block of a lane */
+static const uint8_t* sw_sha256_lane_next(sw_sha256_lane* lane)
+{
+    const uint8_t* block;
+
+    if (lane->msg_blocks)
+    {
+        block = lane->msg;
+        lane->msg += SHA256_BLOCK_SIZE;
+        lane->msg_blocks--;
+    }
+    else
+    {
+        block = lane->tail_next;
+        lane->tail_next += SHA256_BLOCK_SIZE;
+        lane->tail_blocks--;
+    }
+    return block;
+}
+
+/** \brief Finishes a lane's message with the single message block function */
+static void sw_sha256_lane_finish(sw_sha256_lane* lane, uint32_t hash[8][SW_SHA256_LANES_MAX], int idx)
+{
+    sw_sha256_ctx ctx;
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        ctx.hash[i] = hash[i][idx];
+    }
+    sw_sha256_blocks(&ctx, lane->msg, lane->msg_blocks);
+    sw_sha256_blocks(&ctx, lane->tail_next, lane->tail_blocks);
+    sw_sha256_digest(ctx.hash, lane->digest);
+}
+
+/** \brief Hashes messages across the lanes of the given block function */
+static void sw_sha256_multi_lanes(sw_sha256_lanes_fn lanes_fn, int lane_count, const uint8_t* const* messages,
+                                  const size_t* lengths, size_t count, uint8_t* digests)
+{
+    uint32_t hash[8][SW_SHA256_LANES_MAX];
+    sw_sha256_lane lanes[SW_SHA256_LANES_MAX];
+    const uint8_t* blocks[SW_SHA256_LANES_MAX];
+    int busy[SW_SHA256_LANES_MAX];
+    size_t next = 0;
+    int active = 0;
+    int i;
+
+    for (i = 0; i < SW_SHA256_LANES_MAX; i++)
+    {
+        busy[i] = 0;
+        blocks[i] = sw_sha256_idle_block;
+        if (i < lane_count && next < count)
+        {
+            sw_sha256_lane_start(&lanes[i], hash, i, messages[next], (uint32_t)lengths[next], &digests[next * SHA256_DIGEST_SIZE]);
+            next++;
+            busy[i] = 1;
+            active++;
+        }
+    }
+
+    while (active)
+    {
+        /* Once nothing is waiting and most lanes are idle the rest finish
+           faster one at a time */
+        if (next == count && active * 2 <= lane_count)
+        {
+            for (i = 0; i < lane_count; i++)
+            {
+                if (busy[i])
+                {
+                    sw_sha256_lane_finish(&lanes[i], hash, i);
+                }
+            }
+            break;
+        }
+
+        for (i = 0; i < lane_count; i++)
+        {
+            blocks[i] = busy[i] ? sw_sha256_lane_next(&lanes[i]) : sw_sha256_idle_block;
+        }
+        lanes_fn(hash, blocks);
+
+        for (i = 0; i < lane_count; i++)
+        {
+            if (busy[i] && 0 == lanes[i].msg_blocks && 0 == lanes[i].tail_blocks)
+            {
+                uint32_t lane_hash[8];
+                int j;
+
+                for (j = 0; j < 8; j++)
+                {
+                    lane_hash[j] = hash[j][i];
+                }
+                sw_sha256_digest(lane_hash, lanes[i].digest);
+
+                if (next < count)
+                {
+                    sw_sha256_lane_start(&lanes[i], hash, i, messages[next], (uint32_t)lengths[next], &digests[next * SHA256_DIGEST_SIZE]);
+                    next++;
+                }
+                else
+                {
+                    busy[i] = 0;
+                    active--;
+                }
+            }
+        }
+    }
+}
+
+/** \brief Picks the widest lane function the processor supports
+ *
+ * \param[out] lanes_fn  Lane function
+ *
+ * \return Number of lanes or 0 if there is no lane function
+ */
+static int sw_sha256_lanes_select(sw_sha256_lanes_fn* lanes_fn)
+{
+#ifdef SW_SHA256_AVX2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        *lanes_fn = sw_sha256_lanes_avx2;
+        return 8;
+    }
+#endif
+#ifdef SW_SHA256_NEON
+    *lanes_fn = sw_sha256_lanes_neon;
+    return 4;
+#else
+    (void)lanes_fn;
+    return 0;
+#endif
+}
+#endif
+
+/** \brief Processes one block for each of several hash contexts. This is the
+ *         block function for callers that run many hashes in step, such as
+ *         the iterations of PBKDF2 for several output blocks.
+ *
+ * \param[in,out] ctx     Hash contexts. Only the hash state is updated.
+ * \param[in]     blocks  Block to process for each context
+ * \param[in]     count   Number of contexts
+ */
+void sw_sha256_process_multi(sw_sha256_ctx* const* ctx, const uint8_t* const* blocks, uint32_t count)
+{
+    uint32_t i = 0;
+
+#if defined(SW_SHA256_AVX2) || defined(SW_SHA256_NEON)
+    sw_sha256_lanes_fn lanes_fn = NULL;
+    uint32_t lane_count = (uint32_t)sw_sha256_lanes_select(&lanes_fn);
+
+    /* A lone context is faster through the single block function */
+    for (; lane_count && i + 1 < count; i += lane_count)
+    {
+        uint32_t hash[8][SW_SHA256_LANES_MAX];
+        const uint8_t* lane_blocks[SW_SHA256_LANES_MAX];
+        uint32_t used = (count - i < lane_count) ? count - i : lane_count;
+        uint32_t lane;
+        int j;
+
+        memset(hash, 0, sizeof(hash));
+        for (lane = 0; lane < SW_SHA256_LANES_MAX; lane++)
+        {
+            lane_blocks[lane] = (lane < used) ? blocks[i + lane] : sw_sha256_idle_block;
+            for (j = 0; j < 8 && lane < used; j++)
+            {
+                hash[j][lane] = ctx[i + lane]->hash[j];
+            }
+        }
+
+        lanes_fn(hash, lane_blocks);
+
+        for (lane = 0; lane < used; lane++)
+        {
+            for (j = 0; j < 8; j++)
+            {
+                ctx[i + lane]->hash[j] = hash[j][lane];
+            }
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        sw_sha256_blocks(ctx[i], blocks[i], 1);
+    }
+}
+
+/** \brief Computes the SHA256 digests of many independent messages. Where the
+ *         processor has wide enough vectors several messages are hashed at
+ *         once, one per lane, which suits batches of short messages such as
+ *         certificate TBS sections.
+ *
+ * \param[in]  messages  Messages to hash
+ * \param[in]  lengths   Size of each message in bytes
+ * \param[in]  count     Number of messages
+ * \param[out] digests   count digests of SHA256_DIGEST_SIZE bytes one after
+ *                       another
+ */
+void sw_sha256_multi(const uint8_t* const* messages, const size_t* lengths, size_t count, uint8_t* digests)
+{
+    size_t i;
+
+#if defined(SW_SHA256_AVX2) || defined(SW_SHA256_NEON)
+    sw_sha256_lanes_fn lanes_fn = NULL;
+    int lane_count = sw_sha256_lanes_select(&lanes_fn);
+
+    if (count > 1 && lane_count)
+    {
+        sw_sha256_multi_lanes(lanes_fn, lane_count, messages, lengths, count, digests);
+        return;
+    }
+#endif
+
+    for (i = 0; i < count; i++)
+    {
+        sw_sha256(messages[i], (unsigned int)lengths[i], &digests[i * SHA256_DIGEST_SIZE]);
+    }
+}
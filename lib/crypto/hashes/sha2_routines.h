@@ -29,6 +29,7 @@
 #define SHA2_ROUTINES_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 #define SHA256_DIGEST_SIZE (32)
 #define SHA256_BLOCK_SIZE  (64)
@@ -45,6 +46,18 @@ typedef struct
     uint32_t hash[8];                       //!< Hash state
 } sw_sha256_ctx;
 
+/** \brief Implementations of the SHA256 block function */
+typedef enum
+{
+    SW_SHA256_IMPL_AUTO = 0,    //!< Fastest implementation the processor supports
+    SW_SHA256_IMPL_PORTABLE,    //!< Portable C
+    SW_SHA256_IMPL_SHA_NI,      //!< x86 SHA extensions
+    SW_SHA256_IMPL_ARMV8        //!< ARMv8 cryptography extensions
+} sw_sha256_impl_t;
+
+int sw_sha256_select(sw_sha256_impl_t impl);
+sw_sha256_impl_t sw_sha256_get_impl(void);
+
 void sw_sha256_init(sw_sha256_ctx* ctx);
 
 void sw_sha256_update(sw_sha256_ctx* ctx, const uint8_t* message, uint32_t len);
@@ -53,6 +66,10 @@ void sw_sha256_final(sw_sha256_ctx * ctx, uint8_t digest[SHA256_DIGEST_SIZE]);
 
 void sw_sha256(const uint8_t * message, unsigned int len, uint8_t digest[SHA256_DIGEST_SIZE]);
 
+void sw_sha256_multi(const uint8_t* const* messages, const size_t* lengths, size_t count, uint8_t* digests);
+
+void sw_sha256_process_multi(sw_sha256_ctx* const* ctx, const uint8_t* const* blocks, uint32_t count);
+
 #ifdef __cplusplus
 }
 #endif
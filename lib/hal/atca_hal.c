@@ -166,6 +166,9 @@ static atca_hal_list_entry_t atca_registered_hal_list[ATCA_MAX_HAL_CACHE] = {
 #if ATCA_HAL_SWI_GPIO
     { ATCA_SWI_GPIO_IFACE, &hal_gpio,       NULL      },
 #endif
+    /* Free entries for hals registered at runtime with hal_iface_register_hal */
+    { ATCA_UNKNOWN_IFACE,  NULL,            NULL      },
+    { ATCA_UNKNOWN_IFACE,  NULL,            NULL      },
 };
 
 static const size_t atca_registered_hal_list_size = sizeof(atca_registered_hal_list) / sizeof(atca_hal_list_entry_t);
@@ -185,7 +188,7 @@ static ATCA_STATUS hal_iface_get_registered(ATCAIfaceType iface_type, ATCAHAL_t*
         size_t i;
         for (i = 0; i < atca_registered_hal_list_size; i++)
         {
-            if (iface_type == atca_registered_hal_list[i].iface_type)
+            if (iface_type == atca_registered_hal_list[i].iface_type && atca_registered_hal_list[i].hal)
             {
                 break;
             }
@@ -208,49 +211,56 @@ static ATCA_STATUS hal_iface_get_registered(ATCAIfaceType iface_type, ATCAHAL_t*
 
 /** \brief Internal function to set a value in the hal cache
  * \param[in] iface_type - the type of physical interface to register
- * \param[in] hal pointer to the existing ATCAHAL_t structure
+ * \param[in] hal pointer to the existing ATCAHAL_t structure - NULL removes
+ *                the entry for the interface type
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
 static ATCA_STATUS hal_iface_set_registered(ATCAIfaceType iface_type, ATCAHAL_t* hal, ATCAHAL_t* phy)
 {
-    ATCA_STATUS status = ATCA_BAD_PARAM;
+    ATCA_STATUS status;
+    size_t i;
+    size_t empty = atca_registered_hal_list_size;
 
-    if (hal)
+    for (i = 0; i < atca_registered_hal_list_size; i++)
     {
-        size_t i;
-        size_t empty = atca_registered_hal_list_size;
-        for (i = 0; i < atca_registered_hal_list_size; i++)
+        if (iface_type == atca_registered_hal_list[i].iface_type && atca_registered_hal_list[i].hal)
         {
-            if (iface_type == atca_registered_hal_list[i].iface_type)
-            {
-                break;
-            }
-            else if (empty == atca_registered_hal_list_size)
+            break;
+        }
+        else if (empty == atca_registered_hal_list_size)
+        {
+            if (!atca_registered_hal_list[i].hal && !atca_registered_hal_list[i].phy)
             {
-                if (!atca_registered_hal_list[i].hal && !atca_registered_hal_list[i].phy)
-                {
-                    empty = i;
-                }
+                empty = i;
             }
         }
+    }
 
-        if (i < atca_registered_hal_list_size)
-        {
-            atca_registered_hal_list[i].hal = hal;
-            atca_registered_hal_list[i].phy = phy;
-            status = ATCA_SUCCESS;
-        }
-        else if (empty < atca_registered_hal_list_size)
-        {
-            atca_registered_hal_list[empty].hal = hal;
-            atca_registered_hal_list[empty].hal = phy;
-            status = ATCA_SUCCESS;
-        }
-        else
+    if (i < atca_registered_hal_list_size)
+    {
+        atca_registered_hal_list[i].hal = hal;
+        atca_registered_hal_list[i].phy = hal ? phy : NULL;
+        if (!hal)
         {
-            status = ATCA_ALLOC_FAILURE;
+            atca_registered_hal_list[i].iface_type = ATCA_UNKNOWN_IFACE;
         }
-
+        status = ATCA_SUCCESS;
+    }
+    else if (!hal)
+    {
+        /* Nothing to remove */
+        status = ATCA_SUCCESS;
+    }
+    else if (empty < atca_registered_hal_list_size)
+    {
+        atca_registered_hal_list[empty].iface_type = iface_type;
+        atca_registered_hal_list[empty].hal = hal;
+        atca_registered_hal_list[empty].phy = phy;
+        status = ATCA_SUCCESS;
+    }
+    else
+    {
+        status = ATCA_ALLOC_FAILURE;
     }
 
     return status;
@@ -258,8 +268,10 @@ static ATCA_STATUS hal_iface_set_registered(ATCAIfaceType iface_type, ATCAHAL_t*
 
 /** \brief Register/Replace a HAL with a
  * \param[in] iface_type - the type of physical interface to register
- * \param[in] hal pointer to the new ATCAHAL_t structure to register
- * \param[out] old pointer to the existing ATCAHAL_t structure
+ * \param[in] hal pointer to the new ATCAHAL_t structure to register - NULL
+ *                removes the registration for the interface type
+ * \param[out] old pointer to the existing ATCAHAL_t structure (NULL if
+ *             there was none registered for the interface type)
  *  \return ATCA_SUCCESS on success, otherwise an error code.
  */
 ATCA_STATUS hal_iface_register_hal(ATCAIfaceType iface_type, ATCAHAL_t *hal, ATCAHAL_t **old_hal, ATCAHAL_t* phy, ATCAHAL_t** old_phy)
@@ -268,12 +280,20 @@ ATCA_STATUS hal_iface_register_hal(ATCAIfaceType iface_type, ATCAHAL_t *hal, ATC
 
     status = (old_hal && old_phy) ? hal_iface_get_registered(iface_type, old_hal, old_phy) : ATCA_SUCCESS;
 
+    if (ATCA_GEN_FAIL == status)
+    {
+        /* Nothing registered for this interface type yet */
+        *old_hal = NULL;
+        *old_phy = NULL;
+        status = ATCA_SUCCESS;
+    }
+
     if (ATCA_SUCCESS == status)
     {
         status = hal_iface_set_registered(iface_type, hal, phy);
     }
 
-    return ATCA_SUCCESS;
+    return status;
 }
 
 /** \brief Standard HAL API for ATCA to initialize a physical interface
@@ -314,6 +334,19 @@ ATCA_STATUS hal_iface_init(ATCAIfaceCfg *cfg, ATCAHAL_t **hal, ATCAHAL_t **phy)
     return status;
 }
 
+/** \brief Check if a hal keeps its own hal_data and releases its physical
+ *         interface itself
+ */
+static bool hal_iface_owns_phy(const ATCAHAL_t* hal)
+{
+#if defined(ATCA_HAL_KIT_HID) || defined(ATCA_HAL_KIT_UART)
+    return &hal_kit_v1 == hal;
+#else
+    ((void)hal);
+    return false;
+#endif
+}
+
 /** \brief releases a physical interface, HAL knows how to interpret hal_data
  * \param[in] iface_type - the type of physical interface to release
  * \param[in] hal_data - pointer to opaque hal data maintained by HAL implementation for this interface type
@@ -331,6 +364,13 @@ ATCA_STATUS hal_iface_release(ATCAIfaceType iface_type, void *hal_data)
     if (ATCA_SUCCESS == status)
     {
         status = hal->halrelease ? hal->halrelease(hal_data) : ATCA_BAD_PARAM;
+
+        /* A hal layered on a physical interface shares its hal_data unless it
+           keeps its own state - the kit protocol releases its phy itself */
+        if (ATCA_SUCCESS == status && phy && phy->halrelease && hal_data && !hal_iface_owns_phy(hal))
+        {
+            status = phy->halrelease(hal_data);
+        }
     }
 
     return status;
@@ -168,6 +168,23 @@ ATCA_STATUS hal_custom_control(ATCAIface iface, uint8_t option, void* param, siz
 #define ATCA_POLLING_MAX_TIME_MSEC        2500
 #endif
 
+/* Adaptive polling - how far ahead of the expected completion the first poll
+   is issued and the upper limit of the poll interval backoff */
+#ifndef ATCA_POLLING_GUARD_TIME_MSEC
+#define ATCA_POLLING_GUARD_TIME_MSEC      1
+#endif
+
+#ifndef ATCA_POLLING_BACKOFF_MAX_MSEC
+#define ATCA_POLLING_BACKOFF_MAX_MSEC     16
+#endif
+
+/* Time allowed while the device is held awake before it is idled and woken
+   again - kept below the ~1.3s watchdog to leave room for host time between
+   commands, which is only measured with ATCA_HAL_CLOCK */
+#ifndef ATCA_AWAKE_BUDGET_MSEC
+#define ATCA_AWAKE_BUDGET_MSEC            1000
+#endif
+
 /*  */
 typedef enum
 {
@@ -200,6 +217,9 @@ ATCA_STATUS hal_create_mutex(void ** ppMutex, char* pName);
 ATCA_STATUS hal_destroy_mutex(void * pMutex);
 ATCA_STATUS hal_lock_mutex(void * pMutex);
 ATCA_STATUS hal_unlock_mutex(void * pMutex);
+#ifdef ATCA_HAL_CLOCK
+uint32_t hal_get_time_ms(void);
+#endif
 
 #ifndef ATCA_NO_HEAP
 #ifdef ATCA_TESTS_ENABLED
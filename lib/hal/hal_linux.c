@@ -33,6 +33,7 @@
 #include <fcntl.h>
 #include <pthread.h>
 #include <errno.h>
+#include <time.h>
 
 #include "atca_hal.h"
 
@@ -76,6 +77,17 @@ void hal_delay_ms(uint32_t delay)
     hal_delay_us(delay * 1000);
 }
 
+/** \brief Returns a millisecond count from a monotonic clock. Only the
+ *         difference between two counts is meaningful and it wraps.
+ */
+uint32_t hal_get_time_ms(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec * 1000u + (uint32_t)(ts.tv_nsec / 1000000);
+}
+
 #ifndef ATCA_USE_RTOS_TIMER
 #if ATCA_USE_SHARED_MUTEX
 
@@ -151,6 +163,10 @@ ATCA_STATUS hal_create_mutex(void ** ppMutex, char* pName)
             pthread_mutexattr_setpshared(&muattr, PTHREAD_PROCESS_SHARED);
             ((hal_mutex_t*)*ppMutex)->shared = 1;
         }
+        else
+        {
+            ((hal_mutex_t*)*ppMutex)->shared = 0;
+        }
 
         if (pthread_mutex_init(*ppMutex, &muattr))
         {
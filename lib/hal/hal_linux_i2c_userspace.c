@@ -27,6 +27,7 @@
 
 #include <cryptoauthlib.h>
 
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
@@ -34,6 +35,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <pthread.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -50,10 +52,90 @@
 
 typedef struct atca_i2c_host_s
 {
-    char i2c_file[16];
-    int  ref_ct;
+    struct atca_i2c_host_s* next;       /* Next bus in use */
+    int                     bus;        /* 0-based logical bus number */
+    int                     f_i2c;      /* I2C file descriptor kept open while the bus is in use */
+    int                     ref_ct;
+    pthread_mutex_t         lock;       /* Held for each transfer and the bus state below */
+    bool                    rdwr;       /* Adapter takes combined I2C_RDWR transfers */
+    int                     slave;      /* 7 bit address last set with I2C_SLAVE, -1 for none */
+    uint8_t                 pending;    /* 8 bit address of a deferred word address write, 0 for none */
 } atca_i2c_host_t;
 
+/** \brief Buses in use - devices on the same bus share its descriptor */
+static atca_i2c_host_t* g_i2c_hosts;
+
+/** \brief Protects g_i2c_hosts and the reference counts of its entries */
+static pthread_mutex_t g_i2c_hosts_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/** \brief Transfer to or from a device
+ *
+ * With I2C_RDWR a transfer is a single ioctl and carries its own address, so
+ * a descriptor shared by several devices never has to be readdressed. A
+ * pending word address write is sent in the same ioctl as a read from the
+ * same device, with a repeated start in between.
+ *
+ * Called with the host's lock held.
+ */
+static ATCA_STATUS hal_i2c_transfer(atca_i2c_host_t* hal, uint8_t address, uint8_t* data, uint16_t length, bool rx)
+{
+    uint8_t word_address = 0x00;
+
+    /* A pending write that can't be combined goes on its own */
+    if (hal->pending && (!hal->rdwr || !rx || hal->pending != address))
+    {
+        uint8_t pending = hal->pending;
+
+        hal->pending = 0;
+        if (ATCA_SUCCESS != hal_i2c_transfer(hal, pending, &word_address, sizeof(word_address), false))
+        {
+            return ATCA_COMM_FAIL;
+        }
+    }
+
+    if (hal->rdwr)
+    {
+        struct i2c_msg msgs[2];
+        struct i2c_rdwr_ioctl_data xfer = { msgs, 0 };
+
+        if (hal->pending)
+        {
+            msgs[xfer.nmsgs].addr = hal->pending >> 1;
+            msgs[xfer.nmsgs].flags = 0;
+            msgs[xfer.nmsgs].len = sizeof(word_address);
+            msgs[xfer.nmsgs].buf = &word_address;
+            xfer.nmsgs++;
+            hal->pending = 0;
+        }
+
+        msgs[xfer.nmsgs].addr = address >> 1;
+        msgs[xfer.nmsgs].flags = rx ? I2C_M_RD : 0;
+        msgs[xfer.nmsgs].len = length;
+        msgs[xfer.nmsgs].buf = data;
+        xfer.nmsgs++;
+
+        return (ioctl(hal->f_i2c, I2C_RDWR, &xfer) == (int)xfer.nmsgs) ? ATCA_SUCCESS : ATCA_COMM_FAIL;
+    }
+
+    /* Plain read() and write() with the address changed only when it
+       differs from the last one used on the bus */
+    if (hal->slave != address >> 1)
+    {
+        if (ioctl(hal->f_i2c, I2C_SLAVE, address >> 1) < 0)
+        {
+            hal->slave = -1;
+            return ATCA_COMM_FAIL;
+        }
+        hal->slave = address >> 1;
+    }
+
+    if (rx)
+    {
+        return (read(hal->f_i2c, data, length) == length) ? ATCA_SUCCESS : ATCA_COMM_FAIL;
+    }
+    return (write(hal->f_i2c, data, length) == length) ? ATCA_SUCCESS : ATCA_COMM_FAIL;
+}
+
 /** \brief HAL implementation of I2C init
  *
  * this implementation assumes I2C peripheral has been enabled by user. It only initialize an
@@ -67,41 +149,76 @@ typedef struct atca_i2c_host_s
 ATCA_STATUS hal_i2c_init(ATCAIface iface, ATCAIfaceCfg* cfg)
 {
     ATCA_STATUS ret = ATCA_BAD_PARAM;
+    atca_i2c_host_t * hal_data;
+    int bus;
 
     if (!iface || !cfg)
     {
         return ret;
     }
 
+    (void)pthread_mutex_lock(&g_i2c_hosts_lock);
+
     if (iface->hal_data)
     {
-        atca_i2c_host_t * hal_data = (atca_i2c_host_t*)iface->hal_data;
+        hal_data = (atca_i2c_host_t*)iface->hal_data;
 
         // Assume the bus had already been initialized
         hal_data->ref_ct++;
 
-        ret = ATCA_SUCCESS;
+        (void)pthread_mutex_unlock(&g_i2c_hosts_lock);
+        return ATCA_SUCCESS;
     }
-    else
-    {
-        atca_i2c_host_t * hal_data = malloc(sizeof(atca_i2c_host_t));
-        int bus = cfg->atcai2c.bus; // 0-based logical bus number
 
-        if (hal_data)
+    bus = cfg->atcai2c.bus; // 0-based logical bus number
+    for (hal_data = g_i2c_hosts; hal_data; hal_data = hal_data->next)
+    {
+        if (hal_data->bus == bus)
         {
-            hal_data->ref_ct = 1;  // buses are shared, this is the first instance
+            break;
+        }
+    }
 
-            (void)snprintf(hal_data->i2c_file, sizeof(hal_data->i2c_file) - 1, "/dev/i2c-%d", bus);
+    if (hal_data)
+    {
+        // Another device on the bus has it open
+        hal_data->ref_ct++;
+        iface->hal_data = hal_data;
+        ret = ATCA_SUCCESS;
+    }
+    else if (NULL != (hal_data = malloc(sizeof(atca_i2c_host_t))))
+    {
+        char i2c_file[16];
+        unsigned long funcs = 0;
 
-            iface->hal_data = hal_data;
+        (void)snprintf(i2c_file, sizeof(i2c_file), "/dev/i2c-%d", bus);
 
-            ret = ATCA_SUCCESS;
-        }
-        else
+        if ((hal_data->f_i2c = open(i2c_file, O_RDWR)) < 0)
         {
-            ret = ATCA_ALLOC_FAILURE;
+            free(hal_data);
+            (void)pthread_mutex_unlock(&g_i2c_hosts_lock);
+            return ATCA_COMM_FAIL;
         }
+        (void)pthread_mutex_init(&hal_data->lock, NULL);
+
+        hal_data->bus = bus;
+        hal_data->ref_ct = 1;  // buses are shared, this is the first instance
+        hal_data->rdwr = (ioctl(hal_data->f_i2c, I2C_FUNCS, &funcs) >= 0) && (funcs & I2C_FUNC_I2C);
+        hal_data->slave = -1;
+        hal_data->pending = 0;
+        hal_data->next = g_i2c_hosts;
+        g_i2c_hosts = hal_data;
+
+        iface->hal_data = hal_data;
+
+        ret = ATCA_SUCCESS;
     }
+    else
+    {
+        ret = ATCA_ALLOC_FAILURE;
+    }
+
+    (void)pthread_mutex_unlock(&g_i2c_hosts_lock);
 
     return ret;
 
@@ -118,6 +235,10 @@ ATCA_STATUS hal_i2c_post_init(ATCAIface iface)
 }
 
 /** \brief HAL implementation of I2C send
+ *
+ * A single word address 0x00 ahead of reading a response is held back and
+ * sent together with the read.
+ *
  * \param[in] iface         instance
  * \param[in] word_address  device transaction type
  * \param[in] txdata        pointer to space to bytes to send
@@ -128,35 +249,31 @@ ATCA_STATUS hal_i2c_post_init(ATCAIface iface)
 ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t address, uint8_t *txdata, int txlength)
 {
     atca_i2c_host_t * hal_data = (atca_i2c_host_t*)atgetifacehaldat(iface);
-    int f_i2c;  // I2C file descriptor
+    ATCA_STATUS status;
 
     if (!hal_data)
     {
         return ATCA_NOT_INITIALIZED;
     }
 
-    // Initiate I2C communication
-    if ( (f_i2c = open(hal_data->i2c_file, O_RDWR)) < 0)
+    if (txlength < 0 || txlength > UINT16_MAX || (txlength && !txdata))
     {
-        return ATCA_COMM_FAIL;
+        return ATCA_BAD_PARAM;
     }
 
-    // Set Device Address
-    if (ioctl(f_i2c, I2C_SLAVE, address >> 1) < 0)
+    (void)pthread_mutex_lock(&hal_data->lock);
+    if (address && 1 == txlength && 0x00 == txdata[0] && !hal_data->pending)
     {
-        close(f_i2c);
-        return ATCA_COMM_FAIL;
+        hal_data->pending = address;
+        status = ATCA_SUCCESS;
     }
-
-    // Send data
-    if (write(f_i2c, txdata, txlength) != txlength)
+    else
     {
-        close(f_i2c);
-        return ATCA_COMM_FAIL;
+        status = hal_i2c_transfer(hal_data, address, txdata, (uint16_t)txlength, false);
     }
+    (void)pthread_mutex_unlock(&hal_data->lock);
 
-    close(f_i2c);
-    return ATCA_SUCCESS;
+    return status;
 }
 
 /** \brief HAL implementation of I2C receive function
@@ -170,34 +287,24 @@ ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t address, uint8_t *txdata, int
 ATCA_STATUS hal_i2c_receive(ATCAIface iface, uint8_t address, uint8_t *rxdata, uint16_t *rxlength)
 {
     atca_i2c_host_t * hal_data = (atca_i2c_host_t*)atgetifacehaldat(iface);
-    int f_i2c;  // I2C file descriptor
+    ATCA_STATUS status;
 
     if (!hal_data)
     {
         return ATCA_NOT_INITIALIZED;
     }
 
-    // Initiate I2C communication
-    if ( (f_i2c = open(hal_data->i2c_file, O_RDWR)) < 0)
+    if (!rxdata || !rxlength)
     {
-        return ATCA_COMM_FAIL;
+        return ATCA_BAD_PARAM;
     }
 
-    // Set Device Address
-    if (ioctl(f_i2c, I2C_SLAVE, address >> 1) < 0)
-    {
-        close(f_i2c);
-        return ATCA_COMM_FAIL;
-    }
+    /* The deferred word address write and the read go out under one lock */
+    (void)pthread_mutex_lock(&hal_data->lock);
+    status = hal_i2c_transfer(hal_data, address, rxdata, *rxlength, true);
+    (void)pthread_mutex_unlock(&hal_data->lock);
 
-    if (read(f_i2c, rxdata, *rxlength) != *rxlength)
-    {
-        close(f_i2c);
-        return ATCA_COMM_FAIL;
-    }
-
-    close(f_i2c);
-    return ATCA_SUCCESS;
+    return status;
 }
 
 /** \brief Perform control operations for the kit protocol
@@ -230,12 +337,29 @@ ATCA_STATUS hal_i2c_release(void *hal_data)
 {
     atca_i2c_host_t *hal = (atca_i2c_host_t*)hal_data;
 
+    (void)pthread_mutex_lock(&g_i2c_hosts_lock);
+
     // if the use count for this bus has gone to 0 references, disable it.  protect against an unbracketed release
     if (hal && --(hal->ref_ct) <= 0)
     {
+        atca_i2c_host_t** link = &g_i2c_hosts;
+
+        while (*link && *link != hal)
+        {
+            link = &(*link)->next;
+        }
+        if (*link)
+        {
+            *link = hal->next;
+        }
+
+        close(hal->f_i2c);
+        (void)pthread_mutex_destroy(&hal->lock);
         free(hal);
     }
 
+    (void)pthread_mutex_unlock(&g_i2c_hosts_lock);
+
     return ATCA_SUCCESS;
 }
 
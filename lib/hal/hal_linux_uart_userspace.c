@@ -0,0 +1,355 @@
+/**
+ * \file
+ * \brief ATCA Hardware abstraction layer for Linux using a serial port (kit
+ *        protocol over USB CDC or a UART).
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include <cryptoauthlib.h>
+
+#include <termios.h>
+#include <unistd.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "atca_hal.h"
+
+/** \defgroup hal_ Hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ *
+   @{ */
+
+/** \brief Time to wait for the first byte of a receive */
+#ifndef ATCA_UART_RX_TIMEOUT_MSEC
+#define ATCA_UART_RX_TIMEOUT_MSEC   (2000)
+#endif
+
+typedef struct
+{
+    int f_uart;         /* Serial port file descriptor */
+} atca_uart_host_t;
+
+/** \brief Convert a baud rate into its termios speed */
+static speed_t hal_uart_speed(uint32_t baud)
+{
+    switch (baud)
+    {
+    case 9600:
+        return B9600;
+    case 19200:
+        return B19200;
+    case 38400:
+        return B38400;
+    case 57600:
+        return B57600;
+    case 230400:
+        return B230400;
+    case 460800:
+        return B460800;
+    case 921600:
+        return B921600;
+    default:
+        return B115200;
+    }
+}
+
+/** \brief Put the port into raw mode with the configured framing */
+static ATCA_STATUS hal_uart_setup(int fd, ATCAIfaceCfg* cfg, uint32_t baud)
+{
+    struct termios tty;
+
+    if (tcgetattr(fd, &tty) < 0)
+    {
+        return ATCA_COMM_FAIL;
+    }
+
+    cfmakeraw(&tty);
+    tty.c_cflag |= CLOCAL | CREAD;
+
+    tty.c_cflag &= ~CSIZE;
+    switch (cfg->atcauart.wordsize)
+    {
+    case 5:
+        tty.c_cflag |= CS5;
+        break;
+    case 6:
+        tty.c_cflag |= CS6;
+        break;
+    case 7:
+        tty.c_cflag |= CS7;
+        break;
+    default:
+        tty.c_cflag |= CS8;
+        break;
+    }
+
+    /* 0 == even, 1 == odd, 2 == none */
+    tty.c_cflag &= ~(PARENB | PARODD);
+    if (0 == cfg->atcauart.parity)
+    {
+        tty.c_cflag |= PARENB;
+    }
+    else if (1 == cfg->atcauart.parity)
+    {
+        tty.c_cflag |= PARENB | PARODD;
+    }
+
+    if (2 == cfg->atcauart.stopbits)
+    {
+        tty.c_cflag |= CSTOPB;
+    }
+    else
+    {
+        tty.c_cflag &= ~CSTOPB;
+    }
+
+    /* Reads return whatever is available - timeouts are handled with poll */
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 0;
+
+    (void)cfsetispeed(&tty, hal_uart_speed(baud));
+    (void)cfsetospeed(&tty, hal_uart_speed(baud));
+
+    return (tcsetattr(fd, TCSANOW, &tty) < 0) ? ATCA_COMM_FAIL : ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of UART init
+ *
+ * Opens the serial port named by cfg->cfg_data when it is set, otherwise
+ * /dev/ttyACM<port>, and puts it into raw mode.
+ *
+ *  \param[in] iface  instance
+ *  \param[in] cfg    pointer to HAL specific configuration data that is used to initialize this HAL
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS hal_uart_init(ATCAIface iface, ATCAIfaceCfg *cfg)
+{
+    atca_uart_host_t* hal;
+    char path[32];
+    const char* name = path;
+    ATCA_STATUS status;
+
+    if (!iface || !cfg)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (cfg->cfg_data)
+    {
+        name = (const char*)cfg->cfg_data;
+    }
+    else
+    {
+        (void)snprintf(path, sizeof(path), "/dev/ttyACM%d", cfg->atcauart.port);
+    }
+
+    if (NULL == (hal = malloc(sizeof(atca_uart_host_t))))
+    {
+        return ATCA_ALLOC_FAILURE;
+    }
+
+    if ((hal->f_uart = open(name, O_RDWR | O_NOCTTY)) < 0)
+    {
+        free(hal);
+        return ATCA_COMM_FAIL;
+    }
+
+    if (ATCA_SUCCESS != (status = hal_uart_setup(hal->f_uart, cfg, cfg->atcauart.baud)))
+    {
+        (void)close(hal->f_uart);
+        free(hal);
+        return status;
+    }
+
+    /* Drop anything the kit sent before the port was opened */
+    (void)tcflush(hal->f_uart, TCIOFLUSH);
+
+    iface->hal_data = hal;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of UART post init
+ *  \param[in] iface  instance
+ *  \return ATCA_SUCCESS
+ */
+ATCA_STATUS hal_uart_post_init(ATCAIface iface)
+{
+    ((void)iface);
+    return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of UART send
+ *  \param[in] iface         instance
+ *  \param[in] word_address  unused for the serial port
+ *  \param[in] txdata        pointer to bytes to send
+ *  \param[in] txlength      number of bytes to send
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS hal_uart_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata, int txlength)
+{
+    atca_uart_host_t* hal = (atca_uart_host_t*)atgetifacehaldat(iface);
+    ssize_t written;
+
+    ((void)word_address);
+
+    if (!hal || !txdata)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    while (txlength > 0)
+    {
+        if ((written = write(hal->f_uart, txdata, (size_t)txlength)) < 0)
+        {
+            if (EINTR == errno || EAGAIN == errno)
+            {
+                continue;
+            }
+            return ATCA_TX_FAIL;
+        }
+        txdata += written;
+        txlength -= (int)written;
+    }
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of UART receive. Returns as soon as any bytes
+ *         are available so a caller parsing a stream is not held up waiting
+ *         for a full buffer.
+ * \param[in]     iface         instance
+ * \param[in]     word_address  unused for the serial port
+ * \param[out]    rxdata        pointer to space to receive the data
+ * \param[in,out] rxlength      As input, the size of the rxdata buffer.
+ *                              As output, the number of bytes received.
+ * \return ATCA_SUCCESS on success, ATCA_RX_TIMEOUT if nothing arrived in time,
+ *         otherwise an error code.
+ */
+ATCA_STATUS hal_uart_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxdata, uint16_t *rxlength)
+{
+    atca_uart_host_t* hal = (atca_uart_host_t*)atgetifacehaldat(iface);
+    struct pollfd pfd;
+    ssize_t count;
+    int ret;
+
+    ((void)word_address);
+
+    if (!hal || !rxdata || !rxlength)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    pfd.fd = hal->f_uart;
+    pfd.events = POLLIN;
+
+    do
+    {
+        ret = poll(&pfd, 1, ATCA_UART_RX_TIMEOUT_MSEC);
+    }
+    while (ret < 0 && EINTR == errno);
+
+    if (0 == ret)
+    {
+        *rxlength = 0;
+        return ATCA_RX_TIMEOUT;
+    }
+    if (ret < 0 || (pfd.revents & (POLLERR | POLLNVAL)))
+    {
+        *rxlength = 0;
+        return ATCA_RX_FAIL;
+    }
+
+    if ((count = read(hal->f_uart, rxdata, *rxlength)) < 0)
+    {
+        *rxlength = 0;
+        return ATCA_RX_FAIL;
+    }
+    *rxlength = (uint16_t)count;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Perform control operations for the UART
+ * \param[in]     iface          Interface to interact with.
+ * \param[in]     option         Control parameter identifier
+ * \param[in]     param          Optional pointer to parameter value
+ * \param[in]     paramlen       Length of the parameter
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS hal_uart_control(ATCAIface iface, uint8_t option, void* param, size_t paramlen)
+{
+    atca_uart_host_t* hal = (atca_uart_host_t*)atgetifacehaldat(iface);
+
+    if (hal && iface->mIfaceCFG)
+    {
+        switch (option)
+        {
+        case ATCA_HAL_CHANGE_BAUD:
+            if (!param || paramlen < sizeof(uint32_t))
+            {
+                return ATCA_BAD_PARAM;
+            }
+            return hal_uart_setup(hal->f_uart, iface->mIfaceCFG, *(uint32_t*)param);
+        case ATCA_HAL_FLUSH_BUFFER:
+            return (tcflush(hal->f_uart, TCIFLUSH) < 0) ? ATCA_COMM_FAIL : ATCA_SUCCESS;
+        case ATCA_HAL_CONTROL_SELECT:
+        /* fallthrough */
+        case ATCA_HAL_CONTROL_DESELECT:
+            return ATCA_SUCCESS;
+        default:
+            return ATCA_UNIMPLEMENTED;
+        }
+    }
+    return ATCA_BAD_PARAM;
+}
+
+/** \brief Close the serial port
+ * \param[in] hal_data  opaque pointer to hal data structure - known only
+ *                      to the HAL implementation
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS hal_uart_release(void *hal_data)
+{
+    atca_uart_host_t* hal = (atca_uart_host_t*)hal_data;
+
+    if (!hal)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    (void)close(hal->f_uart);
+    free(hal);
+
+    return ATCA_SUCCESS;
+}
+
+/** @} */
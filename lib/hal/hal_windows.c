@@ -78,6 +78,14 @@ void hal_delay_ms(uint32_t delay)
     Sleep(delay);
 }
 
+/** \brief Returns a millisecond count from a monotonic clock. Only the
+ *         difference between two counts is meaningful and it wraps.
+ */
+uint32_t hal_get_time_ms(void)
+{
+    return (uint32_t)GetTickCount();
+}
+
 #ifndef ATCA_USE_RTOS_TIMER
 /**
  * \brief Application callback for creating a mutex object
@@ -102,72 +102,578 @@ const char * kit_interface_from_kittype(ATCAKitType kittype)
     }
 }
 
-/** \brief HAL implementation of send over USB HID
- *  \param[in] iface     instance
- *  \param[in] txdata    pointer to bytes to send
- *  \param[in] txlength  number of bytes to send
+/** \brief Parser states for a kit response "SS(HEX)\n" */
+enum
+{
+    KIT_FRAME_STATUS_HI,
+    KIT_FRAME_STATUS_LO,
+    KIT_FRAME_OPEN,
+    KIT_FRAME_DATA_HI,
+    KIT_FRAME_DATA_LO,
+    KIT_FRAME_DONE,
+    KIT_FRAME_SYNC,
+    KIT_FRAME_LEN_LO,
+    KIT_FRAME_LEN_HI,
+    KIT_FRAME_STATUS,
+    KIT_FRAME_DATA,
+    KIT_FRAME_CRC_LO,
+    KIT_FRAME_CRC_HI
+};
+
+/** \brief Kit protocol state of an interface, kept in its hal_data. The
+ *         physical layer is driven through a copy of the interface that
+ *         carries the physical layer's own hal_data.
+ */
+typedef struct
+{
+    atca_iface_t phy;       /**< Interface handed to the physical layer */
+    bool         binary;    /**< Binary framing negotiated with the kit */
+#ifdef ATCA_NO_HEAP
+    bool         in_use;
+#endif
+} kit_hal_t;
+
+#ifdef ATCA_NO_HEAP
+/* Without a heap the kit protocol drives a single interface */
+static kit_hal_t g_kit_hal;
+#endif
+
+/** \brief A piece of a kit message - raw text or binary sent as hex */
+typedef struct
+{
+    const uint8_t* data;
+    size_t         len;
+    bool           hex;
+} kit_seg_t;
+
+/** \brief Packet being filled for the physical interface */
+typedef struct
+{
+    ATCAIface iface;
+    uint8_t*  buf;
+    size_t    pos;          /* Next byte to fill */
+    size_t    start;        /* First payload byte - 1 for the HID report id */
+    size_t    end;          /* One past the last payload byte */
+    bool      fixed;        /* Every packet is sent at full size (HID reports) */
+    bool      crc_on;       /* Bytes put are added to the CRC */
+    uint16_t  crc;
+} kit_packet_t;
+
+/** \brief Add a byte to a CRC-16 computed the same way as atCRC */
+static uint16_t kit_crc16_update(uint16_t crc, uint8_t data)
+{
+    uint8_t bit;
+
+    for (bit = 0x01; bit; bit <<= 1)
+    {
+        if (((data & bit) ? 1u : 0u) != (unsigned)(crc >> 15))
+        {
+            crc = (uint16_t)((crc << 1) ^ 0x8005);
+        }
+        else
+        {
+            crc = (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/** \brief Kit protocol state of an interface set up by kit_init */
+static kit_hal_t* kit_get_hal(ATCAIface iface)
+{
+    return (iface && iface->mIfaceCFG) ? (kit_hal_t*)iface->hal_data : NULL;
+}
+
+/** \brief Value of a hex digit or -1 if the character isn't one */
+static int kit_hex_nibble(uint8_t c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+/** \brief Start parsing a kit response
+ * \param[out] frame  Parser state
+ * \param[in]  data   Buffer the response data is decoded into
+ * \param[in]  size   Size of the data buffer
+ */
+void kit_frame_init(kit_frame_t* frame, uint8_t* data, size_t size)
+{
+    frame->state = KIT_FRAME_STATUS_HI;
+    frame->status = 0;
+    frame->nibble = 0;
+    frame->overflow = false;
+    frame->binary = false;
+    frame->remaining = 0;
+    frame->crc = 0;
+    frame->data = data;
+    frame->size = size;
+    frame->len = 0;
+}
+
+/** \brief Start parsing a binary kit response frame
+ * \param[out] frame  Parser state
+ * \param[in]  data   Buffer the response data is copied into
+ * \param[in]  size   Size of the data buffer
+ */
+void kit_frame_init_binary(kit_frame_t* frame, uint8_t* data, size_t size)
+{
+    kit_frame_init(frame, data, size);
+    frame->binary = true;
+    frame->state = KIT_FRAME_SYNC;
+}
+
+/** \brief Parse the next bytes of a binary kit response
+ * \return ATCA_SUCCESS once the frame is complete, ATCA_RX_NO_RESPONSE while
+ *         more bytes are needed, ATCA_SMALL_BUFFER if the data didn't fit,
+ *         ATCA_RX_CRC_ERROR if the frame was corrupted and ATCA_RX_FAIL for
+ *         a malformed frame.
+ */
+static ATCA_STATUS kit_frame_parse_binary(kit_frame_t* frame, const uint8_t* buf, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len && KIT_FRAME_DONE != frame->state; i++)
+    {
+        uint8_t c = buf[i];
+
+        if (KIT_FRAME_LEN_LO <= frame->state && KIT_FRAME_DATA >= frame->state)
+        {
+            frame->crc = kit_crc16_update(frame->crc, c);
+        }
+
+        switch (frame->state)
+        {
+        case KIT_FRAME_SYNC:
+            /* Padding of HID reports and anything else ahead of a frame */
+            if (KIT_BIN_SYNC == c)
+            {
+                frame->crc = 0;
+                frame->state = KIT_FRAME_LEN_LO;
+            }
+            break;
+        case KIT_FRAME_LEN_LO:
+            frame->remaining = c;
+            frame->state = KIT_FRAME_LEN_HI;
+            break;
+        case KIT_FRAME_LEN_HI:
+            frame->remaining |= (uint16_t)(c << 8);
+            if (0 == frame->remaining)
+            {
+                return ATCA_RX_FAIL;
+            }
+            frame->state = KIT_FRAME_STATUS;
+            break;
+        case KIT_FRAME_STATUS:
+            frame->status = c;
+            frame->state = (0 == --frame->remaining) ? KIT_FRAME_CRC_LO : KIT_FRAME_DATA;
+            break;
+        case KIT_FRAME_DATA:
+            if (frame->len < frame->size)
+            {
+                frame->data[frame->len++] = c;
+            }
+            else
+            {
+                frame->overflow = true;
+            }
+            if (0 == --frame->remaining)
+            {
+                frame->state = KIT_FRAME_CRC_LO;
+            }
+            break;
+        case KIT_FRAME_CRC_LO:
+            frame->nibble = c;
+            frame->state = KIT_FRAME_CRC_HI;
+            break;
+        case KIT_FRAME_CRC_HI:
+            if (frame->crc != (uint16_t)(frame->nibble | (c << 8)))
+            {
+                return ATCA_RX_CRC_ERROR;
+            }
+            frame->state = KIT_FRAME_DONE;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (KIT_FRAME_DONE != frame->state)
+    {
+        return ATCA_RX_NO_RESPONSE;
+    }
+    return frame->overflow ? ATCA_SMALL_BUFFER : ATCA_SUCCESS;
+}
+
+/** \brief Parse the next bytes of a kit response. Hex data is decoded
+ *         straight into the frame's buffer as it arrives so a response
+ *         split across any number of reads is never gathered into a
+ *         separate text buffer first.
+ *
+ * Padding and line endings ahead of the status are skipped and the frame is
+ * complete at the closing parenthesis. Bytes after it are ignored.
+ *
+ * \param[in,out] frame  Parser state from kit_frame_init
+ * \param[in]     buf    Bytes received
+ * \param[in]     len    Number of bytes received
+ * \return ATCA_SUCCESS once the frame is complete, ATCA_RX_NO_RESPONSE while
+ *         more bytes are needed, ATCA_SMALL_BUFFER if the data didn't fit
+ *         and ATCA_RX_FAIL for a malformed frame.
+ */
+ATCA_STATUS kit_frame_parse(kit_frame_t* frame, const uint8_t* buf, size_t len)
+{
+    size_t i;
+    int nibble;
+
+    if (frame->binary)
+    {
+        return kit_frame_parse_binary(frame, buf, len);
+    }
+
+    for (i = 0; i < len && KIT_FRAME_DONE != frame->state; i++)
+    {
+        uint8_t c = buf[i];
+
+        switch (frame->state)
+        {
+        case KIT_FRAME_STATUS_HI:
+            if ('\0' == c || '\r' == c || '\n' == c || ' ' == c)
+            {
+                break;
+            }
+        /* fallthrough */
+        case KIT_FRAME_STATUS_LO:
+        case KIT_FRAME_DATA_LO:
+            if (0 > (nibble = kit_hex_nibble(c)))
+            {
+                return ATCA_RX_FAIL;
+            }
+            if (KIT_FRAME_STATUS_HI == frame->state)
+            {
+                frame->nibble = (uint8_t)(nibble << 4);
+                frame->state = KIT_FRAME_STATUS_LO;
+            }
+            else if (KIT_FRAME_STATUS_LO == frame->state)
+            {
+                frame->status = frame->nibble | (uint8_t)nibble;
+                frame->state = KIT_FRAME_OPEN;
+            }
+            else
+            {
+                if (frame->len < frame->size)
+                {
+                    frame->data[frame->len++] = frame->nibble | (uint8_t)nibble;
+                }
+                else
+                {
+                    /* Keep consuming the frame so nothing is left behind */
+                    frame->overflow = true;
+                }
+                frame->state = KIT_FRAME_DATA_HI;
+            }
+            break;
+        case KIT_FRAME_OPEN:
+            if ('(' != c)
+            {
+                return ATCA_RX_FAIL;
+            }
+            frame->state = KIT_FRAME_DATA_HI;
+            break;
+        case KIT_FRAME_DATA_HI:
+            if (')' == c)
+            {
+                frame->state = KIT_FRAME_DONE;
+            }
+            else if (0 > (nibble = kit_hex_nibble(c)))
+            {
+                return ATCA_RX_FAIL;
+            }
+            else
+            {
+                frame->nibble = (uint8_t)(nibble << 4);
+                frame->state = KIT_FRAME_DATA_LO;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (KIT_FRAME_DONE != frame->state)
+    {
+        return ATCA_RX_NO_RESPONSE;
+    }
+    return frame->overflow ? ATCA_SMALL_BUFFER : ATCA_SUCCESS;
+}
+
+/** \brief Hand a filled packet to the physical interface. HID reports are
+ *         always sent at full size so only their unused tail is cleared.
+ */
+static ATCA_STATUS kit_packet_flush(kit_packet_t* packet)
+{
+    ATCA_STATUS status;
+
+    if (packet->pos == packet->start)
+    {
+        return ATCA_SUCCESS;
+    }
+
+    if (packet->fixed)
+    {
+        memset(&packet->buf[packet->pos], 0, packet->end - packet->pos);
+    }
+
+#ifdef KIT_DEBUG
+    printf("Kit Write: %.*s", (int)(packet->pos - packet->start), (char*)&packet->buf[packet->start]);
+#endif
+
+    status = packet->iface->phy->halsend(packet->iface, 0xFF, packet->buf,
+                                         (int)((packet->fixed ? packet->end : packet->pos) - packet->start));
+    packet->pos = packet->start;
+
+    return status;
+}
+
+/** \brief Add a byte to the packet, sending it once it is full */
+static ATCA_STATUS kit_packet_put(kit_packet_t* packet, uint8_t c)
+{
+    if (packet->crc_on)
+    {
+        packet->crc = kit_crc16_update(packet->crc, c);
+    }
+    packet->buf[packet->pos++] = c;
+
+    return (packet->pos == packet->end) ? kit_packet_flush(packet) : ATCA_SUCCESS;
+}
+
+/** \brief Send a kit message made of several segments. Each segment is
+ *         written (or hex encoded) directly into the outgoing packet so the
+ *         message is never assembled in an intermediate buffer.
+ *  \param[in] iface   instance
+ *  \param[in] segs    segments in the order they are sent
+ *  \param[in] count   number of segments
+ *  \param[in] framed  wrap the segments in a binary frame
  *  \return ATCA_STATUS
  */
-ATCA_STATUS kit_phy_send(ATCAIface iface, uint8_t* txdata, int txlength)
+static ATCA_STATUS kit_phy_sendv(ATCAIface iface, const kit_seg_t* segs, size_t count, bool framed)
 {
+    static const char hex[] = "0123456789ABCDEF";
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
-    int bytes_written = 0;
-    int bytes_left = 0;
-    int bytes_to_send = 0;
-    int packetsize = 0;
-    uint8_t buffer[512]; //! Maximum number of bytes for a HID send/receive packet (typically 64)
+    uint8_t buffer[KIT_MAX_PACKET_SIZE + 1];
+    kit_packet_t packet;
     ATCA_STATUS status = ATCA_SUCCESS;
+    size_t i;
+    size_t j;
 
-    if ((NULL == cfg) || (NULL == iface) || (NULL == iface->phy) ||
-        (NULL == iface->phy->halsend) || (NULL == txdata))
+    if ((NULL == cfg) || (NULL == iface->phy) || (NULL == iface->phy->halsend) || (NULL == segs))
     {
         return ATCA_BAD_PARAM;
     }
 
-    if (ATCA_HID_IFACE == iface->mIfaceCFG->iface_type)
+    packet.iface = iface;
+    packet.buf = buffer;
+
+    if (ATCA_HID_IFACE == cfg->iface_type)
     {
 #ifdef ATCA_HAL_KIT_HID
-        packetsize = (int)cfg->atcahid.packetsize;
+        if ((0 == cfg->atcahid.packetsize) || (KIT_MAX_PACKET_SIZE < cfg->atcahid.packetsize))
+        {
+            return ATCA_BAD_PARAM;
+        }
+        /* Byte 0 is the report id */
+        buffer[0] = 0;
+        packet.start = 1;
+        packet.end = 1 + cfg->atcahid.packetsize;
+        packet.fixed = true;
+#else
+        return ATCA_BAD_PARAM;
 #endif
     }
-    else if (ATCA_UART_IFACE == iface->mIfaceCFG->iface_type)
+    else if (ATCA_UART_IFACE == cfg->iface_type)
     {
-#ifdef ATCA_HAL_KIT_UART
-        packetsize = 1;
-#endif
+        packet.start = 0;
+        packet.end = KIT_MAX_PACKET_SIZE;
+        packet.fixed = false;
     }
     else
     {
         return ATCA_BAD_PARAM;
     }
+    packet.pos = packet.start;
+    packet.crc_on = false;
+    packet.crc = 0;
 
-    bytes_left = txlength;
-    while (bytes_left > 0)
+    if (framed)
     {
-        memset(buffer, 0, sizeof(buffer));
+        size_t length = 0;
 
-        if (bytes_left >= packetsize)
+        for (i = 0; i < count; i++)
         {
-            bytes_to_send = packetsize;
+            length += segs[i].hex ? 2 * segs[i].len : segs[i].len;
         }
-        else
+        if (UINT16_MAX < length)
+        {
+            return ATCA_INVALID_SIZE;
+        }
+
+        (void)kit_packet_put(&packet, KIT_BIN_SYNC);
+        packet.crc_on = true;
+        (void)kit_packet_put(&packet, (uint8_t)length);
+        status = kit_packet_put(&packet, (uint8_t)(length >> 8));
+    }
+
+    for (i = 0; i < count && ATCA_SUCCESS == status; i++)
+    {
+        for (j = 0; j < segs[i].len && ATCA_SUCCESS == status; j++)
+        {
+            if (segs[i].hex)
+            {
+                if (ATCA_SUCCESS == (status = kit_packet_put(&packet, (uint8_t)hex[segs[i].data[j] >> 4])))
+                {
+                    status = kit_packet_put(&packet, (uint8_t)hex[segs[i].data[j] & 0x0F]);
+                }
+            }
+            else
+            {
+                status = kit_packet_put(&packet, segs[i].data[j]);
+            }
+        }
+    }
+
+    if (framed && ATCA_SUCCESS == status)
+    {
+        uint16_t crc = packet.crc;
+
+        packet.crc_on = false;
+        if (ATCA_SUCCESS == (status = kit_packet_put(&packet, (uint8_t)crc)))
         {
-            bytes_to_send = bytes_left;
+            status = kit_packet_put(&packet, (uint8_t)(crc >> 8));
         }
+    }
+
+    if (ATCA_SUCCESS == status)
+    {
+        status = kit_packet_flush(&packet);
+    }
+
+    return status;
+}
+
+/** \brief HAL implementation of send over USB HID
+ *  \param[in] iface     instance
+ *  \param[in] txdata    pointer to bytes to send
+ *  \param[in] txlength  number of bytes to send
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS kit_phy_send(ATCAIface iface, uint8_t* txdata, int txlength)
+{
+    kit_seg_t seg = { txdata, (size_t)txlength, false };
+
+    if ((NULL == iface) || (NULL == txdata) || (0 > txlength))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    return kit_phy_sendv(iface, &seg, 1, false);
+}
+
+/** \brief Receive a kit response, decoding it as each read completes
+ * \param[in]     iface  instance
+ * \param[in,out] frame  parser started with kit_frame_init
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS kit_phy_receive_frame(ATCAIface iface, kit_frame_t* frame)
+{
+    uint8_t chunk[KIT_MAX_PACKET_SIZE];
+    ATCA_STATUS status;
+    uint16_t rxlen;
 
-        memcpy(&buffer[1], &txdata[(txlength - bytes_left)], bytes_to_send);
+    if ((NULL == iface) || (NULL == iface->phy) || (NULL == iface->phy->halreceive))
+    {
+        return ATCA_BAD_PARAM;
+    }
 
-        if (ATCA_SUCCESS != (status = iface->phy->halsend(iface, 0xFF, buffer, packetsize)))
+    do
+    {
+        rxlen = sizeof(chunk);
+        if (ATCA_SUCCESS != (status = iface->phy->halreceive(iface, 0x00, chunk, &rxlen)))
+        {
+            break;
+        }
+        if (0 == rxlen)
         {
+            status = ATCA_RX_TIMEOUT;
             break;
         }
 
-        bytes_left -= bytes_to_send;
+#ifdef KIT_DEBUG
+        printf("Kit Read: %.*s\r", (int)rxlen, (char*)chunk);
+#endif
+
+        status = kit_frame_parse(frame, chunk, rxlen);
     }
+    while (ATCA_RX_NO_RESPONSE == status);
 
     return status;
 }
 
+/** \brief Start parsing a response in the framing used by the interface */
+static void kit_frame_start(kit_hal_t* kit, kit_frame_t* frame, uint8_t* data, size_t size)
+{
+    if (kit->binary)
+    {
+        kit_frame_init_binary(frame, data, size);
+    }
+    else
+    {
+        kit_frame_init(frame, data, size);
+    }
+}
+
+/** \brief Send a kit command with no data ("d:w()\n" etc) addressed to the
+ *         configured device type and receive its response
+ * \param[in]     kit    kit protocol state of the interface
+ * \param[in]     cmd    command character ('w', 'i' or 's')
+ * \param[in,out] frame  parser for the response
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS kit_phy_command(kit_hal_t* kit, char cmd, kit_frame_t* frame)
+{
+    ATCAIface iface = &kit->phy;
+    const char* target = kit_id_from_devtype(iface->mIfaceCFG->devtype);
+    char ascii[] = ":?()\n";
+    kit_seg_t segs[] = {
+        { (const uint8_t*)target, 1,                 false },
+        { (const uint8_t*)ascii,  sizeof(ascii) - 1, false }
+    };
+    bool framed = kit->binary;
+    ATCA_STATUS status;
+
+    if (framed)
+    {
+        segs[1].data = (const uint8_t*)&cmd;
+        segs[1].len = 1;
+    }
+    else
+    {
+        ascii[1] = cmd;
+    }
+
+    if (ATCA_SUCCESS != (status = kit_phy_sendv(iface, segs, sizeof(segs) / sizeof(segs[0]), framed)))
+    {
+        return status;
+    }
+
+    return kit_phy_receive_frame(iface, frame);
+}
+
 /** \brief HAL implementation of kit protocol send over USB HID
  * \param[in]    iface   instance
  * \param[out]   rxdata  pointer to space to receive the data
@@ -224,6 +730,70 @@ ATCA_STATUS kit_phy_receive(ATCAIface iface, uint8_t* rxdata, int* rxsize)
     return ATCA_SUCCESS;
 }
 
+/** \brief Ask the kit to switch to binary framing. Kits that don't know the
+ *         command answer with an error status (or not at all) and stay in
+ *         the ASCII protocol.
+ * \return ATCA_SUCCESS if the kit is now using binary frames
+ */
+static ATCA_STATUS kit_negotiate_binary(kit_hal_t* kit)
+{
+    ATCAIface iface = &kit->phy;
+    char kit_binary[] = "board:binary(00)\n";
+    char rxbuf[KIT_RX_WRAP_SIZE];
+    int rxlen = sizeof(rxbuf);
+    uint8_t kitstatus = 0xFF;
+    uint8_t data[4];
+    int datasize = sizeof(data);
+    ATCA_STATUS status;
+
+    (void)snprintf(kit_binary, sizeof(kit_binary), "board:binary(%02X)\n", KIT_BIN_VERSION);
+
+    if (ATCA_SUCCESS == (status = kit_phy_send(iface, (uint8_t*)kit_binary, (int)strlen(kit_binary))))
+    {
+        memset(rxbuf, 0, sizeof(rxbuf));
+        if (ATCA_SUCCESS == (status = kit_phy_receive(iface, (uint8_t*)rxbuf, &rxlen)))
+        {
+            status = kit_parse_rsp(rxbuf, rxlen, &kitstatus, data, &datasize);
+        }
+    }
+
+    if ((ATCA_SUCCESS != status) || (0 != kitstatus))
+    {
+        /* Drop anything left of the rejection */
+        if (iface->phy->halcontrol)
+        {
+            (void)iface->phy->halcontrol(iface, ATCA_HAL_FLUSH_BUFFER, NULL, 0);
+        }
+        return ATCA_UNIMPLEMENTED;
+    }
+
+    kit->binary = true;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Ask a kit using binary framing to go back to the ASCII protocol.
+ *         Sent as a frame so the kit can't mistake it for device data.
+ * \return ATCA_SUCCESS if the kit is back in the ASCII protocol
+ */
+static ATCA_STATUS kit_leave_binary(kit_hal_t* kit)
+{
+    const uint8_t payload[] = { KIT_BIN_TARGET_BOARD, KIT_BIN_CMD_ASCII };
+    const kit_seg_t seg = { payload, sizeof(payload), false };
+    uint8_t rxdata[4];
+    kit_frame_t frame;
+    ATCA_STATUS status;
+
+    kit_frame_init_binary(&frame, rxdata, sizeof(rxdata));
+    if (ATCA_SUCCESS == (status = kit_phy_sendv(&kit->phy, &seg, 1, true)))
+    {
+        status = kit_phy_receive_frame(&kit->phy, &frame);
+    }
+    kit->binary = false;
+
+    return (ATCA_SUCCESS == status && 0 != frame.status) ? ATCA_COMM_FAIL : status;
+}
+
 /** \brief HAL implementation of kit protocol init.  This function calls back to the physical protocol to send the bytes
  *  \param[in] iface  instance
  *  \return ATCA_SUCCESS on success, otherwise an error code.
@@ -243,11 +813,47 @@ ATCA_STATUS kit_init(ATCAIface iface, ATCAIfaceCfg* cfg)
     char *token; /* string token */
     int i;
     int address;
+    ATCAKitType kit_interface = ATCA_KIT_AUTO_IFACE;
+    uint8_t kit_identity = 0;
+    kit_hal_t* kit;
+    ATCAIface phy;
 
     ((void)cfg);
 
+    /* The physical layer has just opened the port into hal_data - keep it
+       with the kit protocol state that replaces it */
+#ifndef ATCA_NO_HEAP
+    kit = hal_malloc(sizeof(kit_hal_t));
+#else
+    kit = g_kit_hal.in_use ? NULL : &g_kit_hal;
+#endif
+    if (NULL == kit)
+    {
+        if (iface->phy->halrelease)
+        {
+            (void)iface->phy->halrelease(iface->hal_data);
+        }
+        iface->hal_data = NULL;
+        return ATCA_ALLOC_FAILURE;
+    }
+    memset(kit, 0, sizeof(*kit));
+    kit->phy = *iface;
+    kit->phy.hal = iface->phy;
+#ifdef ATCA_NO_HEAP
+    kit->in_use = true;
+#endif
+    iface->hal_data = kit;
+    phy = &kit->phy;
+
+    /* A serial port reaches a single kit - select the first matching device on it */
+    if (ATCA_HID_IFACE == iface->mIfaceCFG->iface_type)
+    {
+        kit_interface = iface->mIfaceCFG->atcahid.dev_interface;
+        kit_identity = iface->mIfaceCFG->atcahid.dev_identity;
+    }
+
     device_match = kit_id_from_devtype(iface->mIfaceCFG->devtype);
-    interface_match = kit_interface_from_kittype(iface->mIfaceCFG->atcahid.dev_interface);
+    interface_match = kit_interface_from_kittype(kit_interface);
 
     /* Iterate to find the target device */
     for (i = 0; i < KIT_MAX_SCAN_COUNT; i++)
@@ -260,14 +866,14 @@ ATCA_STATUS kit_init(ATCAIface iface, ATCAIfaceCfg* cfg)
             break;
         }
 
-        if (ATCA_SUCCESS != (status = kit_phy_send(iface, txbuf, txlen)))
+        if (ATCA_SUCCESS != (status = kit_phy_send(phy, txbuf, txlen)))
         {
             break;
         }
 
         rxlen = sizeof(rxbuf);
         memset(rxbuf, 0, rxlen);
-        if (ATCA_SUCCESS != (status = kit_phy_receive(iface, rxbuf, &rxlen)))
+        if (ATCA_SUCCESS != (status = kit_phy_receive(phy, rxbuf, &rxlen)))
         {
             break;
         }
@@ -292,7 +898,7 @@ ATCA_STATUS kit_init(ATCAIface iface, ATCAIfaceCfg* cfg)
         }
 
         /*Selects the first device type if both device interface and device identity is not defined*/
-        if (iface->mIfaceCFG->atcahid.dev_interface == ATCA_KIT_AUTO_IFACE && iface->mIfaceCFG->atcahid.dev_identity == 0 && (strncmp(device_match, dev_type, 3) == 0))
+        if (kit_interface == ATCA_KIT_AUTO_IFACE && kit_identity == 0 && (strncmp(device_match, dev_type, 3) == 0))
         {
 
             txlen = snprintf(txbuf, sizeof(txbuf) - 1, kit_device_select, device_match[0], address);
@@ -303,13 +909,13 @@ ATCA_STATUS kit_init(ATCAIface iface, ATCAIfaceCfg* cfg)
                 break;
             }
 
-            if (ATCA_SUCCESS != (status = kit_phy_send(iface, txbuf, txlen)))
+            if (ATCA_SUCCESS != (status = kit_phy_send(phy, txbuf, txlen)))
             {
                 break;
             }
 
             rxlen = sizeof(rxbuf);
-            status = kit_phy_receive(iface, rxbuf, &rxlen);
+            status = kit_phy_receive(phy, rxbuf, &rxlen);
             break;
 
 
@@ -320,7 +926,7 @@ ATCA_STATUS kit_init(ATCAIface iface, ATCAIfaceCfg* cfg)
 
 
             /*Selects the device only if the device type, device interface and device identity matches*/
-            if ((strncmp(device_match, dev_type, 4) == 0) && (iface->mIfaceCFG->atcahid.dev_identity == address) && (strcmp(interface_match, dev_interface) == 0))
+            if ((strncmp(device_match, dev_type, 4) == 0) && (kit_identity == address) && (strcmp(interface_match, dev_interface) == 0))
             {
 
 
@@ -332,13 +938,13 @@ ATCA_STATUS kit_init(ATCAIface iface, ATCAIfaceCfg* cfg)
                     break;
                 }
 
-                if (ATCA_SUCCESS != (status = kit_phy_send(iface, txbuf, txlen)))
+                if (ATCA_SUCCESS != (status = kit_phy_send(phy, txbuf, txlen)))
                 {
                     break;
                 }
 
                 rxlen = sizeof(rxbuf);
-                status = kit_phy_receive(iface, rxbuf, &rxlen);
+                status = kit_phy_receive(phy, rxbuf, &rxlen);
                 break;
             }
         }
@@ -349,6 +955,12 @@ ATCA_STATUS kit_init(ATCAIface iface, ATCAIfaceCfg* cfg)
         status = ATCA_NO_DEVICES;
     }
 
+    /* Use binary frames (no hex encoding) when the kit supports them */
+    if ((ATCA_SUCCESS == status) && ('T' != device_match[0]))
+    {
+        (void)kit_negotiate_binary(kit);
+    }
+
     return status;
 }
 
@@ -370,20 +982,15 @@ ATCA_STATUS kit_post_init(ATCAIface iface)
  */
 static ATCA_STATUS kit_ta_send_to_receive(ATCAIface iface, uint8_t word_address, uint16_t* rxsize)
 {
-    ATCA_STATUS status;
-    char send_instrcode[] = "T:receive(%02X%02X%02X)\n";
-    char txbuf[KIT_MAX_TX_BUF];
-    int txbuf_size = sizeof(txbuf);
-
-    // Get instruction code and response length
-    snprintf(txbuf, sizeof(txbuf), send_instrcode, word_address, (uint8_t)(*rxsize >> 8), (uint8_t)
-             *rxsize);
-    txbuf[sizeof(txbuf) - 1] = '\0';
-
-    // Send the word address bytes
-    status = kit_phy_send(iface, txbuf, txbuf_size);
-
-    return status;
+    const uint8_t args[] = { word_address, (uint8_t)(*rxsize >> 8), (uint8_t)*rxsize };
+    const kit_seg_t segs[] = {
+        { (const uint8_t*)"T:receive(", 10,           false },
+        { args,                         sizeof(args), true  },
+        { (const uint8_t*)")\n",        2,            false }
+    };
+
+    // Send the instruction code and response length
+    return kit_phy_sendv(iface, segs, sizeof(segs) / sizeof(segs[0]), false);
 }
 
 /** \brief The function receive a response for send command from kit protocol whether success or not.
@@ -394,31 +1001,16 @@ static ATCA_STATUS kit_ta_send_to_receive(ATCAIface iface, uint8_t word_address,
 static ATCA_STATUS kit_ta_receive_send_rsp(ATCAIface iface)
 {
     ATCA_STATUS status;
-    uint8_t kitstatus = 0;
-    char reply[KIT_RX_WRAP_SIZE];
-    int replysize = sizeof(reply);
     uint8_t rxdata[(KIT_RX_WRAP_SIZE + 1) / 2];
-    int rxsize = sizeof(rxdata);
+    kit_frame_t frame;
 
     // Receive the reply to send "00()\n"
-    memset(reply, 0, replysize);
-    if (ATCA_SUCCESS != (status = kit_phy_receive(iface, reply, &replysize)))
+    kit_frame_init(&frame, rxdata, sizeof(rxdata));
+    if (ATCA_SUCCESS != (status = kit_phy_receive_frame(iface, &frame)))
     {
         return ATCA_GEN_FAIL;
     }
-
-#ifdef KIT_DEBUG
-    // Print the bytes
-    printf("Kit Read: %s\r", reply);
-#endif
-
-    // Unwrap from kit protocol
-    memset(rxdata, 0, rxsize);
-    if (ATCA_SUCCESS != (status = kit_parse_rsp(reply, replysize, &kitstatus, rxdata, &rxsize)))
-    {
-        status = ATCA_GEN_FAIL;
-    }
-    if (ATCA_SUCCESS != kitstatus)
+    if (ATCA_SUCCESS != frame.status)
     {
         status = ATCA_TX_FAIL;
     }
@@ -435,17 +1027,24 @@ static ATCA_STATUS kit_ta_receive_send_rsp(ATCAIface iface)
  */
 ATCA_STATUS kit_send(ATCAIface iface, uint8_t word_address, uint8_t* txdata, int txlength)
 {
-    ATCA_STATUS status = ATCA_SUCCESS;
-    int nkitbuf;
-    char* pkitbuf = NULL;
+    ATCA_STATUS status;
+    char ca_cmdpre[] = "d:t(";
+    char ta_cmdpre[] = "t:send(";
+    char* cmdpre;
     const char *target;
     uint8_t* kit_data = txdata;
+    char bin_cmdpre[] = "dt";
+    kit_hal_t* kit = kit_get_hal(iface);
+    bool framed;
+    kit_seg_t segs[3];
 
     // Check the pointers
-    if (txdata == NULL)
+    if ((kit == NULL) || (txdata == NULL) || (txlength < 0))
     {
         return ATCA_BAD_PARAM;
     }
+    framed = kit->binary;
+    iface = &kit->phy;
 
     if (0xFF != word_address)
     {
@@ -457,43 +1056,47 @@ ATCA_STATUS kit_send(ATCAIface iface, uint8_t word_address, uint8_t* txdata, int
         kit_data = &txdata[1];
     }
 
-    do
-    {
-        // Wrap in kit protocol
-        nkitbuf = txlength * 2 + KIT_TX_WRAP_SIZE;
-        pkitbuf = malloc(nkitbuf);
-        memset(pkitbuf, 0, nkitbuf);
-
-        target = kit_id_from_devtype(iface->mIfaceCFG->devtype);
-
-        if (ATCA_SUCCESS != (status = kit_wrap_cmd(kit_data, txlength, pkitbuf, &nkitbuf, target[0])))
-        {
-            status = ATCA_GEN_FAIL;
-            break;
-        }
-
-    #ifdef KIT_DEBUG
-        // Print the bytes
-        printf("\nKit Write: %s", pkitbuf);
-    #endif
-
-        // Send the bytes
-        if (ATCA_SUCCESS != (status = kit_phy_send(iface, pkitbuf, nkitbuf)))
-        {
-            break;
-        }
+    target = kit_id_from_devtype(iface->mIfaceCFG->devtype);
+    cmdpre = ('T' == target[0]) ? ta_cmdpre : ca_cmdpre;
+    cmdpre[0] = target[0];
 
-        // Receive the reply to send "00()\n"
-        if ('T' == target[0])
-        {
-            status = kit_ta_receive_send_rsp(iface);
-        }
+    if (framed)
+    {
+        // Binary frame payload is the target, the transmit command and the raw bytes
+        bin_cmdpre[0] = target[0];
+        segs[0].data = (const uint8_t*)bin_cmdpre;
+        segs[0].len = 2;
+        segs[0].hex = false;
+        segs[1].data = kit_data;
+        segs[1].len = (size_t)txlength;
+        segs[1].hex = false;
+        status = kit_phy_sendv(iface, segs, 2, true);
+    }
+    else
+    {
+        // Wrap in kit protocol as the bytes are sent
+        segs[0].data = (const uint8_t*)cmdpre;
+        segs[0].len = strlen(cmdpre);
+        segs[0].hex = false;
+        segs[1].data = kit_data;
+        segs[1].len = (size_t)txlength;
+        segs[1].hex = true;
+        segs[2].data = (const uint8_t*)")\n";
+        segs[2].len = 2;
+        segs[2].hex = false;
+        status = kit_phy_sendv(iface, segs, sizeof(segs) / sizeof(segs[0]), false);
+    }
 
+    if (ATCA_SUCCESS != status)
+    {
+        return status;
     }
-    while (0);
 
-    // Free the bytes
-    free(pkitbuf);
+    // Receive the reply to send "00()\n"
+    if ('T' == target[0])
+    {
+        status = kit_ta_receive_send_rsp(iface);
+    }
 
     return status;
 }
@@ -509,20 +1112,19 @@ ATCA_STATUS kit_send(ATCAIface iface, uint8_t word_address, uint8_t* txdata, int
 ATCA_STATUS kit_receive(ATCAIface iface, uint8_t word_address, uint8_t* rxdata, uint16_t* rxsize)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
-    uint8_t kitstatus = 0;
-    int nkitbuf = 0;
-    int dataSize;
-    char *pkitbuf = NULL;
+    kit_hal_t* kit = kit_get_hal(iface);
+    kit_frame_t frame;
     const char* target;
 
     do
     {
         // Check the pointers
-        if ((rxdata == NULL) || (rxsize == NULL))
+        if ((kit == NULL) || (rxdata == NULL) || (rxsize == NULL))
         {
             status = ATCA_BAD_PARAM;
             break;
         }
+        iface = &kit->phy;
 
         target = kit_id_from_devtype(iface->mIfaceCFG->devtype);
         if ('T' == target[0])
@@ -534,38 +1136,18 @@ ATCA_STATUS kit_receive(ATCAIface iface, uint8_t word_address, uint8_t* rxdata,
             }
         }
 
-        // Receive the response bytes
-        nkitbuf = (*rxsize * 2) + KIT_RX_WRAP_SIZE;
-        pkitbuf = malloc(nkitbuf);
-        memset(pkitbuf, 0, nkitbuf);
-
-        if (ATCA_SUCCESS != (status = kit_phy_receive(iface, pkitbuf, &nkitbuf)))
-        {
-            status = ATCA_GEN_FAIL;
-            break;
-        }
-
-    #ifdef KIT_DEBUG
-        // Print the bytes
-        printf("Kit Read: %s\r", pkitbuf);
-    #endif
-
-        // Unwrap from kit protocol
-        dataSize = *rxsize;
+        // Receive the response and unwrap it from kit protocol in one pass
+        kit_frame_start(kit, &frame, rxdata, *rxsize);
         *rxsize = 0;
-        if (ATCA_SUCCESS != (status = kit_parse_rsp(pkitbuf, nkitbuf, &kitstatus, rxdata, &dataSize)))
+        if (ATCA_SUCCESS != (status = kit_phy_receive_frame(iface, &frame)))
         {
             break;
         }
 
-        *rxsize = (uint16_t)dataSize;
-
+        *rxsize = (uint16_t)frame.len;
     }
     while (0);
 
-    // Free the bytes
-    free(pkitbuf);
-
     return status;
 }
 
@@ -575,44 +1157,24 @@ ATCA_STATUS kit_receive(ATCAIface iface, uint8_t word_address, uint8_t* rxdata,
  */
 ATCA_STATUS kit_wake(ATCAIface iface)
 {
-    ATCA_STATUS status = ATCA_SUCCESS;
-    uint8_t kitstatus = 0;
-    char wake[] = "d:w()\n";
-    int wakesize = sizeof(wake);
-    char reply[KIT_RX_WRAP_SIZE + 4];
-    int replysize = sizeof(reply);
+    ATCA_STATUS status;
+    kit_hal_t* kit = kit_get_hal(iface);
     uint8_t rxdata[10];
-    int rxsize = sizeof(rxdata);
-    const char *target;
-
-    target = kit_id_from_devtype(iface->mIfaceCFG->devtype);
-    wake[0] = target[0];
-
-    // Send the bytes
-    status = kit_phy_send(iface, wake, wakesize);
+    kit_frame_t frame;
 
-#ifdef KIT_DEBUG
-    // Print the bytes
-    printf("\nKit Write: %s", wake);
-#endif
+    if (NULL == kit)
+    {
+        return ATCA_BAD_PARAM;
+    }
 
-    // Receive the reply to wake "00(04...)\n"
-    memset(reply, 0, replysize);
-    if (ATCA_SUCCESS != (status = kit_phy_receive(iface, reply, &replysize)))
+    // Send the wake and receive the reply "00(04...)\n"
+    kit_frame_start(kit, &frame, rxdata, sizeof(rxdata));
+    if (ATCA_SUCCESS != (status = kit_phy_command(kit, 'w', &frame)))
     {
         return ATCA_GEN_FAIL;
     }
 
-#ifdef KIT_DEBUG
-    // Print the bytes
-    printf("Kit Read: %s\n", reply);
-#endif
-
-    // Unwrap from kit protocol
-    memset(rxdata, 0, rxsize);
-    status = kit_parse_rsp(reply, replysize, &kitstatus, rxdata, &rxsize);
-
-    return hal_check_wake(rxdata, rxsize);
+    return hal_check_wake(rxdata, (int)frame.len);
 }
 
 /** \brief Call the idle for kit protocol
@@ -621,44 +1183,19 @@ ATCA_STATUS kit_wake(ATCAIface iface)
  */
 ATCA_STATUS kit_idle(ATCAIface iface)
 {
-    ATCA_STATUS status = ATCA_SUCCESS;
-    uint8_t kitstatus = 0;
-    char idle[] = "d:i()\n";
-    int idlesize = sizeof(idle);
-    char reply[KIT_RX_WRAP_SIZE];
-    int replysize = sizeof(reply);
+    kit_hal_t* kit = kit_get_hal(iface);
     uint8_t rxdata[10];
-    int rxsize = sizeof(rxdata);
-    const char *target;
-
-    target = kit_id_from_devtype(iface->mIfaceCFG->devtype);
-    idle[0] = target[0];
-
-    // Send the bytes
-    status = kit_phy_send(iface, idle, idlesize);
+    kit_frame_t frame;
 
-#ifdef KIT_DEBUG
-    // Print the bytes
-    printf("\nKit Write: %s", idle);
-#endif
-
-    // Receive the reply to sleep "00()\n"
-    memset(reply, 0, replysize);
-    if (ATCA_SUCCESS != (status = kit_phy_receive(iface, reply, &replysize)))
+    if (NULL == kit)
     {
-        return ATCA_GEN_FAIL;
+        return ATCA_BAD_PARAM;
     }
 
-#ifdef KIT_DEBUG
-    // Print the bytes
-    printf("Kit Read: %s\r", reply);
-#endif
-
-    // Unwrap from kit protocol
-    memset(rxdata, 0, rxsize);
-    status = kit_parse_rsp(reply, replysize, &kitstatus, rxdata, &rxsize);
+    // Send the idle and receive the reply "00()\n"
+    kit_frame_start(kit, &frame, rxdata, sizeof(rxdata));
 
-    return status;
+    return kit_phy_command(kit, 'i', &frame);
 }
 
 /** \brief Call the sleep for kit protocol
@@ -667,47 +1204,20 @@ ATCA_STATUS kit_idle(ATCAIface iface)
  */
 ATCA_STATUS kit_sleep(ATCAIface iface)
 {
-    ATCA_STATUS status = ATCA_SUCCESS;
-    uint8_t kitstatus = 0;
-
-    char sleep[] = "d:s()\n";
-    int sleepsize = sizeof(sleep);
-    char reply[KIT_RX_WRAP_SIZE];
-    int replysize = sizeof(reply);
+    kit_hal_t* kit = kit_get_hal(iface);
     uint8_t rxdata[10];
-    int rxsize = sizeof(rxdata);
-    const char* target;
-
-    target = kit_id_from_devtype(iface->mIfaceCFG->devtype);
-    sleep[0] = target[0];
-
-    // Send the bytes
-    status = kit_phy_send(iface, sleep, sleepsize);
-
-#ifdef KIT_DEBUG
-    // Print the bytes
-    printf("\nKit Write: %s", sleep);
-#endif
+    kit_frame_t frame;
 
-    // Receive the reply to sleep "00()\n"
-    memset(reply, 0, replysize);
-    if (ATCA_SUCCESS != (status = kit_phy_receive(iface, reply, &replysize)))
+    if (NULL == kit)
     {
-        return ATCA_GEN_FAIL;
+        return ATCA_BAD_PARAM;
     }
 
-#ifdef KIT_DEBUG
-    // Print the bytes
-    printf("Kit Read: %s\r", reply);
-#endif
-
-    // Unwrap from kit protocol
-    memset(rxdata, 0, rxsize);
-    status = kit_parse_rsp(reply, replysize, &kitstatus, rxdata, &rxsize);
+    // Send the sleep and receive the reply "00()\n"
+    kit_frame_start(kit, &frame, rxdata, sizeof(rxdata));
 
-    return status;
+    return kit_phy_command(kit, 's', &frame);
 }
-
 /** \brief Wrap binary bytes in ascii kit protocol
  * \param[in]    txdata   Binary data to wrap.
  * \param[in]    txlen    Length of binary data in bytes.
@@ -769,43 +1279,37 @@ ATCA_STATUS kit_wrap_cmd(const uint8_t* txdata, int txlen, char* pkitcmd, int* n
 }
 
 /** \brief Parse the response ascii from the kit
- * \param[out] pkitbuf pointer to ascii kit protocol data to parse
- * \param[in] nkitbuf length of the ascii kit protocol data
- * \param[in] kitstatus status of the ascii device
- * \param[in] rxdata pointer to the binary data buffer
- * \param[in] datasize size of the pointer to the binary data buffer
+ * \param[in]     pkitbuf    pointer to ascii kit protocol data to parse
+ * \param[in]     nkitbuf    length of the ascii kit protocol data
+ * \param[out]    kitstatus  status of the ascii device
+ * \param[out]    rxdata     pointer to the binary data buffer
+ * \param[in,out] datasize   As input, the size of the rxdata buffer.
+ *                           As output, the number of bytes decoded.
  * \return ATCA_SUCCESS on success, otherwise an error code.
  */
 ATCA_STATUS kit_parse_rsp(const char* pkitbuf, int nkitbuf, uint8_t* kitstatus, uint8_t* rxdata, int* datasize)
 {
-    ATCA_STATUS status = ATCA_SUCCESS;
-    int statusId = 0;
-    int dataId = 3;
-    size_t binSize = 1;
-    size_t asciiDataSize = 0;
-    size_t datasizeTemp = *datasize;
-    char* endDataPtr = 0;
+    ATCA_STATUS status;
+    kit_frame_t frame;
 
-    // First get the kit status
-    if (ATCA_SUCCESS != (status = atcab_hex2bin(&pkitbuf[statusId], 2, kitstatus, &binSize)))
+    if ((NULL == pkitbuf) || (0 > nkitbuf) || (NULL == kitstatus) || (NULL == rxdata) || (NULL == datasize) || (0 > *datasize))
     {
-        return status;
+        return ATCA_BAD_PARAM;
     }
 
-    // Next get the binary data bytes
-    endDataPtr = strnchr((char*)pkitbuf, nkitbuf, ')');
-    if (endDataPtr < (&pkitbuf[dataId]))
+    kit_frame_init(&frame, rxdata, (size_t)*datasize);
+    if (ATCA_RX_NO_RESPONSE == (status = kit_frame_parse(&frame, (const uint8_t*)pkitbuf, (size_t)nkitbuf)))
     {
-        return ATCA_GEN_FAIL;
+        // No closing parenthesis
+        status = ATCA_GEN_FAIL;
     }
-    asciiDataSize = endDataPtr - (&pkitbuf[dataId]);
-    status = atcab_hex2bin(&pkitbuf[dataId], asciiDataSize, rxdata, &datasizeTemp);
-    *datasize = (int)datasizeTemp;
+
+    *kitstatus = frame.status;
+    *datasize = (int)frame.len;
 
     return status;
 }
 
-
 /** \brief Perform control operations for the kit protocol
  * \param[in]     iface          Interface to interact with.
  * \param[in]     option         Control parameter identifier
@@ -839,9 +1343,37 @@ ATCA_STATUS kit_control(ATCAIface iface, uint8_t option, void* param, size_t par
     return ATCA_BAD_PARAM;
 }
 
+/** \brief Return a kit using binary framing to the ASCII protocol, then
+ *         release the physical interface and the kit protocol state
+ * \param[in] hal_data  kit protocol state set up by kit_init
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
 ATCA_STATUS kit_release(void* hal_data)
 {
-    return ATCA_SUCCESS;
+    kit_hal_t* kit = (kit_hal_t*)hal_data;
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    if (kit)
+    {
+        if (kit->binary)
+        {
+            /* Best effort - the port is closed either way */
+            (void)kit_leave_binary(kit);
+        }
+
+        if (kit->phy.hal->halrelease)
+        {
+            status = kit->phy.hal->halrelease(kit->phy.hal_data);
+        }
+
+#ifndef ATCA_NO_HEAP
+        hal_free(kit);
+#else
+        kit->in_use = false;
+#endif
+    }
+
+    return status;
 }
 
 /** @} */
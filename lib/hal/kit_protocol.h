@@ -48,6 +48,48 @@
 #define KIT_MSG_SIZE        (32)
 #define KIT_RX_WRAP_SIZE    (KIT_MSG_SIZE + 6)
 
+// Largest packet handed to the physical interface (HID report or serial write)
+#define KIT_MAX_PACKET_SIZE (512)
+
+/* Binary framing offered with "board:binary(01)\n" once a device is selected.
+ * Kits that accept it answer "00()\n" and from then on both directions carry
+ * frames rather than ASCII hex:
+ *
+ * Byte    Definition
+ * ----    -----------------
+ * 0       KIT_BIN_SYNC
+ * 1..2    Payload length, little endian
+ * 3..     Payload - request:  target, command ('t', 'w', 'i', 's'), data
+ *                   response: kit status, data
+ * last 2  CRC-16 of the length and payload (device CRC, little endian)
+ *
+ * The sync byte can't start an ASCII line so the kit still accepts ASCII
+ * commands. The frame with payload "ba" (board, ascii) ends binary framing.
+ */
+#define KIT_BIN_SYNC        (0xA5)
+#define KIT_BIN_VERSION     (0x01)
+#define KIT_BIN_WRAP_SIZE   (5)
+
+#define KIT_BIN_TARGET_BOARD ('b')
+#define KIT_BIN_CMD_ASCII    ('a')
+
+/** \brief State of the streaming parser for a kit response - "SS(HEX)\n" or
+ *         a binary frame
+ */
+typedef struct
+{
+    uint8_t  state;     /**< Position within the frame */
+    uint8_t  status;    /**< Kit status byte of the response */
+    uint8_t  nibble;    /**< Upper nibble of the byte being decoded, low CRC byte of a binary frame */
+    bool     overflow;  /**< The response had more data than fits in the buffer */
+    bool     binary;    /**< Parse a binary frame rather than ASCII hex */
+    uint16_t remaining; /**< Binary payload bytes still to come */
+    uint16_t crc;       /**< CRC of the binary frame so far */
+    uint8_t* data;      /**< Response data is decoded into this buffer as it arrives */
+    size_t   size;      /**< Size of the data buffer */
+    size_t   len;       /**< Number of bytes decoded */
+} kit_frame_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -62,6 +104,10 @@ ATCA_STATUS kit_release(void* hal_data);
 ATCA_STATUS kit_wrap_cmd(const uint8_t* txdata, int txlength, char* pkitbuf, int* nkitbuf, char target);
 ATCA_STATUS kit_parse_rsp(const char* pkitbuf, int nkitbuf, uint8_t* kitstatus, uint8_t* rxdata, int* nrxdata);
 
+void kit_frame_init(kit_frame_t* frame, uint8_t* data, size_t size);
+void kit_frame_init_binary(kit_frame_t* frame, uint8_t* data, size_t size);
+ATCA_STATUS kit_frame_parse(kit_frame_t* frame, const uint8_t* buf, size_t len);
+
 ATCA_STATUS kit_wake(ATCAIface iface);
 ATCA_STATUS kit_idle(ATCAIface iface);
 ATCA_STATUS kit_sleep(ATCAIface iface);
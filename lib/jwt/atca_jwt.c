@@ -28,6 +28,7 @@
 #include "cryptoauthlib.h"
 #include "atca_helpers.h"
 #include "crypto/atca_crypto_sw_sha2.h"
+#include "crypto/atca_crypto_sw_ecdsa.h"
 #include "jwt/atca_jwt.h"
 #include <stdio.h>
 
@@ -279,6 +280,52 @@ ATCA_STATUS atca_jwt_add_claim_numeric(
     }
 }
 
+/**
+ * \brief Splits a jwt into the digest of its header and payload and its
+ * signature. The token ends at the end of the buffer or at a terminator
+ * before it.
+ */
+static ATCA_STATUS atca_jwt_parse(
+    const char* buf,        /**< [in] Buffer holding an encoded jwt */
+    size_t      buflen,     /**< [in] Length of the buffer/jwt */
+    uint8_t*    digest,     /**< [out] Digest of the header and payload */
+    uint8_t*    signature   /**< [out] Signature (raw byte format) */
+    )
+{
+    ATCA_STATUS status;
+    size_t sig_len = ATCA_ECCP256_SIG_SIZE;
+    const char* pStr;
+
+    if (NULL != (pStr = memchr(buf, '\0', buflen)))
+    {
+        buflen = (size_t)(pStr - buf);
+    }
+
+    /* Payload */
+    if (NULL == (pStr = memchr(buf, '.', buflen)))
+    {
+        return ATCA_BAD_PARAM;
+    }
+    pStr++;
+
+    /* Signature */
+    if (NULL == (pStr = memchr(pStr, '.', buflen - (size_t)(pStr - buf))))
+    {
+        return ATCA_BAD_PARAM;
+    }
+    pStr++;
+
+    /* Extract the signature */
+    if (ATCA_SUCCESS != (status = atcab_base64decode_(pStr, buflen - (size_t)(pStr - buf),
+                                                      signature, &sig_len, atcab_b64rules_urlsafe)))
+    {
+        return status;
+    }
+
+    /* Digest the token */
+    return (ATCA_STATUS)atcac_sw_sha2_256((const uint8_t*)buf, (size_t)(pStr - buf - 1), digest);
+}
+
 /**
  * \brief Verifies the signature of a jwt using the provided public key
  */
@@ -291,8 +338,6 @@ ATCA_STATUS atca_jwt_verify(
     ATCA_STATUS status = ATCA_GEN_FAIL;
     uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
     uint8_t signature[ATCA_ECCP256_SIG_SIZE];
-    size_t sig_len = sizeof(signature);
-    const char* pStr = buf;
 
     bool verified = false;
 
@@ -303,46 +348,118 @@ ATCA_STATUS atca_jwt_verify(
 
     do
     {
-        /* Payload */
-        pStr = strchr(pStr, '.') + 1;
-        if (!pStr)
+        if (ATCA_SUCCESS != (status = atca_jwt_parse(buf, buflen, digest, signature)))
         {
             break;
         }
 
-        /* Signature */
-        pStr = strchr(pStr, '.') + 1;
-        if (!pStr)
+        /* Do a signature verification using the device */
+        if (ATCA_SUCCESS != (status = atcab_verify_extern(digest, signature,
+                                                          pubkey, &verified)))
         {
             break;
         }
 
-        /* Extract the signature */
-        if (ATCA_SUCCESS != (status = atcab_base64decode_(pStr, strlen(pStr),
-                                                          signature, &sig_len, atcab_b64rules_urlsafe)))
+        if (!verified)
         {
-            break;
+            status = ATCA_CHECKMAC_VERIFY_FAILED;
+        }
+    }
+    while (0);
+
+    return status;
+}
+
+/**
+ * \brief Verifies the signatures of several jwts in software. The signatures
+ * are verified together, which is faster than verifying each on its own.
+ * Returns ATCA_SUCCESS if every jwt verifies, otherwise the result of the
+ * first that did not.
+ */
+ATCA_STATUS atca_jwt_verify_batch(
+    const char* const*    bufs,     /**< [in] Buffers holding the encoded jwts */
+    const uint16_t*       buflens,  /**< [in] Length of each buffer/jwt */
+    const uint8_t* const* pubkeys,  /**< [in] Public key of each jwt (raw byte format) */
+    size_t                count,    /**< [in] Number of jwts */
+    ATCA_STATUS*          results   /**< [out] Optional result of each jwt as for atca_jwt_verify */
+    )
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint8_t digests[ATCA_ECC_P256_VERIFY_BATCH][ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signatures[ATCA_ECC_P256_VERIFY_BATCH][ATCA_ECCP256_SIG_SIZE];
+    const uint8_t* msgs[ATCA_ECC_P256_VERIFY_BATCH];
+    const uint8_t* sigs[ATCA_ECC_P256_VERIFY_BATCH];
+    const uint8_t* keys[ATCA_ECC_P256_VERIFY_BATCH];
+    int verified[ATCA_ECC_P256_VERIFY_BATCH];
+    ATCA_STATUS parsed[ATCA_ECC_P256_VERIFY_BATCH];
+    size_t done;
+    size_t chunk;
+    size_t valid;
+    size_t i;
+
+    if (count && (!bufs || !buflens || !pubkeys))
+    {
+        return ATCA_BAD_PARAM;
+    }
+    for (i = 0; i < count; i++)
+    {
+        if (!bufs[i] || !buflens[i] || !pubkeys[i])
+        {
+            return ATCA_BAD_PARAM;
         }
+    }
 
-        /* Digest the token */
-        if (ATCA_SUCCESS != (status = (ATCA_STATUS)atcac_sw_sha2_256((const uint8_t*)buf, pStr - buf - 1, digest)))
+    for (done = 0; done < count; done += chunk)
+    {
+        chunk = count - done;
+        if (chunk > ATCA_ECC_P256_VERIFY_BATCH)
         {
-            break;
+            chunk = ATCA_ECC_P256_VERIFY_BATCH;
         }
 
-        /* Do a signature verification using the device */
-        if (ATCA_SUCCESS != (status = atcab_verify_extern(digest, signature,
-                                                          pubkey, &verified)))
+        /* Malformed tokens are left out of the verify */
+        valid = 0;
+        for (i = 0; i < chunk; i++)
         {
-            break;
+            parsed[i] = atca_jwt_parse(bufs[done + i], buflens[done + i], digests[valid], signatures[valid]);
+            if (ATCA_SUCCESS == parsed[i])
+            {
+                msgs[valid] = digests[valid];
+                sigs[valid] = signatures[valid];
+                keys[valid] = pubkeys[done + i];
+                valid++;
+            }
         }
 
-        if (!verified)
+        (void)atcac_sw_ecdsa_verify_p256_batch(msgs, sigs, keys, valid, verified);
+
+        valid = 0;
+        for (i = 0; i < chunk; i++)
         {
-            status = ATCA_CHECKMAC_VERIFY_FAILED;
+            if (ATCA_SUCCESS == parsed[i])
+            {
+                switch (verified[valid++])
+                {
+                case ATCA_SUCCESS:
+                    break;
+                case ATCA_FUNC_FAIL:
+                    parsed[i] = ATCA_CHECKMAC_VERIFY_FAILED;
+                    break;
+                default:
+                    parsed[i] = ATCA_BAD_PARAM;
+                    break;
+                }
+            }
+            if (ATCA_SUCCESS == status)
+            {
+                status = parsed[i];
+            }
+            if (results)
+            {
+                results[done + i] = parsed[i];
+            }
         }
     }
-    while (0);
 
     return status;
 }
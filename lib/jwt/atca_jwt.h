@@ -52,6 +52,8 @@ ATCA_STATUS atca_jwt_add_claim_numeric(atca_jwt_t* jwt, const char* claim, int32
 ATCA_STATUS atca_jwt_finalize(atca_jwt_t* jwt, uint16_t key_id);
 void atca_jwt_check_payload_start(atca_jwt_t* jwt);
 ATCA_STATUS atca_jwt_verify(const char* buf, uint16_t buflen, const uint8_t* pubkey);
+ATCA_STATUS atca_jwt_verify_batch(const char* const* bufs, const uint16_t* buflens, const uint8_t* const* pubkeys,
+                                  size_t count, ATCA_STATUS* results);
 
 /** @} */
 #ifdef __cplusplus
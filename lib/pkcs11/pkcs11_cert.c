@@ -70,6 +70,7 @@ static void pkcs11_cert_check_trust_data(pkcs11_object_ptr pObject)
 static CK_RV pkcs11_cert_load_ca(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAttribute)
 {
 #if ATCA_CA_SUPPORT
+    ATCADevice device = pkcs11_object_get_device(pObject);
     ATCA_STATUS status = ATCA_SUCCESS;
 
     if (pObject->data)
@@ -80,17 +81,18 @@ static CK_RV pkcs11_cert_load_ca(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAt
         if (pAttribute->pValue && pAttribute->ulValueLen)
         {
             uint8_t ca_key[64];
+            uint8_t scratch[ATCACERT_READ_SCRATCH_SIZE];
             status = ATCA_SUCCESS;
 
             if (cert_cfg->ca_cert_def)
             {
                 if (cert_cfg->ca_cert_def->public_key_dev_loc.is_genkey)
                 {
-                    status = atcab_get_pubkey(cert_cfg->ca_cert_def->public_key_dev_loc.slot, ca_key);
+                    status = atcab_get_pubkey_ext(device, cert_cfg->ca_cert_def->public_key_dev_loc.slot, ca_key);
                 }
                 else
                 {
-                    status = atcab_read_pubkey(cert_cfg->ca_cert_def->public_key_dev_loc.slot, ca_key);
+                    status = atcab_read_pubkey_ext(device, cert_cfg->ca_cert_def->public_key_dev_loc.slot, ca_key);
                 }
             }
 
@@ -100,7 +102,8 @@ static CK_RV pkcs11_cert_load_ca(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAt
             }
 
             size_t temp = pAttribute->ulValueLen;
-            status = atcacert_read_cert(pObject->data, cert_cfg->ca_cert_def ? ca_key : NULL, pAttribute->pValue, &temp);
+            status = atcacert_read_cert_ext(device, pObject->data, cert_cfg->ca_cert_def ? ca_key : NULL, pAttribute->pValue, &temp,
+                                            scratch, sizeof(scratch));
             pAttribute->ulValueLen = (uint32_t)temp;
 
             if (ATCACERT_E_DECODING_ERROR == status)
@@ -116,7 +119,7 @@ static CK_RV pkcs11_cert_load_ca(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAt
         {
             size_t cert_size;
 
-            if (atcacert_read_cert_size(cert_cfg, &cert_size))
+            if (atcacert_read_cert_size_ext(device, cert_cfg, &cert_size))
             {
                 return CKR_DEVICE_ERROR;
             }
@@ -138,8 +141,9 @@ static CK_RV pkcs11_cert_load_ca(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAt
 static CK_RV pkcs11_cert_load_ta(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAttribute)
 {
 #if ATCA_TA_SUPPORT
+    ATCADevice device = pkcs11_object_get_device(pObject);
     uint8_t handle_info[TA_HANDLE_INFO_SIZE];
-    ATCA_STATUS status = talib_info_get_handle_info(atcab_get_device(), pObject->slot, handle_info);
+    ATCA_STATUS status = talib_info_get_handle_info(device, pObject->slot, handle_info);
 
     if (ATCA_SUCCESS == status)
     {
@@ -147,7 +151,7 @@ static CK_RV pkcs11_cert_load_ta(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAt
 
         if (pAttribute->pValue && (pAttribute->ulValueLen >= cert_size))
         {
-            status = talib_read_element(atcab_get_device(), pObject->slot, &cert_size, pAttribute->pValue);
+            status = talib_read_element(device, pObject->slot, &cert_size, pAttribute->pValue);
             pAttribute->ulValueLen = cert_size;
         }
         else
@@ -166,10 +170,10 @@ static CK_RV pkcs11_cert_load_ta(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAt
 }
 
 
-static CK_RV pkcs11_cert_load(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAttribute)
+static CK_RV pkcs11_cert_load_device(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAttribute)
 {
     CK_RV ret = CKR_GENERAL_ERROR;
-    ATCADeviceType dev_type = atcab_get_device_type();
+    ATCADeviceType dev_type = atcab_get_device_type_ext(pkcs11_object_get_device(pObject));
 
     if (atcab_is_ca_device(dev_type))
     {
@@ -183,6 +187,50 @@ static CK_RV pkcs11_cert_load(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAttri
     return ret;
 }
 
+static CK_RV pkcs11_cert_load(pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAttribute)
+{
+#if PKCS11_ATTRIB_CACHE_ENABLE
+    CK_VOID_PTR cached = NULL;
+    CK_ULONG cached_len = 0;
+    CK_RV ret;
+
+    if (!pkcs11_object_cache_get_attrib(pObject, CKA_VALUE, &cached, &cached_len))
+    {
+        /* Read and rebuild the whole certificate once so size queries and
+           every later lookup are answered from memory */
+        CK_ATTRIBUTE cert_attr = { CKA_VALUE, NULL, 0 };
+
+        if (CKR_OK != (ret = pkcs11_cert_load_device(pObject, &cert_attr)))
+        {
+            return ret;
+        }
+
+        if (!cert_attr.ulValueLen)
+        {
+            return pkcs11_cert_load_device(pObject, pAttribute);
+        }
+
+        if (NULL == (cert_attr.pValue = pkcs11_os_malloc(cert_attr.ulValueLen)))
+        {
+            return CKR_HOST_MEMORY;
+        }
+
+        if (CKR_OK == (ret = pkcs11_cert_load_device(pObject, &cert_attr)))
+        {
+            (void)pkcs11_object_cache_put_attrib(pObject, CKA_VALUE, cert_attr.pValue, cert_attr.ulValueLen);
+            ret = pkcs11_attrib_fill(pAttribute, cert_attr.pValue, cert_attr.ulValueLen);
+        }
+
+        pkcs11_os_free(cert_attr.pValue);
+        return ret;
+    }
+
+    return pkcs11_attrib_fill(pAttribute, cached, cached_len);
+#else
+    return pkcs11_cert_load_device(pObject, pAttribute);
+#endif
+}
+
 CK_RV pkcs11_cert_get_encoded(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAttribute)
 {
     pkcs11_object_ptr obj_ptr = (pkcs11_object_ptr)pObject;
@@ -233,7 +281,7 @@ CK_RV pkcs11_cert_get_type(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAttribute)
 {
     CK_RV rv;
 
-    if (atcab_is_ca_device(atcab_get_device_type()))
+    if (atcab_is_ca_device(atcab_get_device_type_ext(pkcs11_object_get_device((pkcs11_object_ptr)pObject))))
     {
         rv = pkcs11_cert_get_type_ca(pObject, pAttribute);
     }
@@ -323,7 +371,7 @@ CK_RV pkcs11_cert_get_subject_key_id(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAttr
                 uint8_t subj_key_id[20];
                 ATCA_STATUS status;
 
-                status = atcacert_read_subj_key_id(cert_cfg, subj_key_id);
+                status = atcacert_read_subj_key_id_ext(pkcs11_object_get_device(obj_ptr), cert_cfg, subj_key_id);
 
                 if (status)
                 {
@@ -558,17 +606,28 @@ const CK_ULONG pkcs11_cert_x509_attributes_count = PKCS11_UTIL_ARRAY_SIZE(pkcs11
 CK_RV pkcs11_cert_x509_write(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAttribute)
 {
     pkcs11_object_ptr obj_ptr = (pkcs11_object_ptr)pObject;
+    pkcs11_lib_ctx_ptr pLibCtx = pkcs11_get_context();
+    ATCADevice device;
     ATCA_STATUS status;
+    CK_RV rv;
 
     if (!obj_ptr || !pAttribute || !pAttribute->pValue || pAttribute->type != CKA_VALUE)
     {
         return CKR_ARGUMENTS_BAD;
     }
 
-    if (atcab_is_ca_device(atcab_get_device_type()))
+    if (CKR_OK != (rv = pkcs11_lock_context(pLibCtx)))
+    {
+        return rv;
+    }
+    pkcs11_object_cache_invalidate(obj_ptr);
+    (void)pkcs11_unlock_context(pLibCtx);
+    device = pkcs11_object_get_device(obj_ptr);
+
+    if (atcab_is_ca_device(atcab_get_device_type_ext(device)))
     {
 #if ATCA_CA_SUPPORT
-        status = atcacert_write_cert(obj_ptr->data, pAttribute->pValue, pAttribute->ulValueLen);
+        status = atcacert_write_cert_ext(device, obj_ptr->data, pAttribute->pValue, pAttribute->ulValueLen);
 #else
         status = ATCA_NO_DEVICES;
 #endif
@@ -576,7 +635,6 @@ CK_RV pkcs11_cert_x509_write(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAttribute)
     else
     {
 #if ATCA_TA_SUPPORT
-        ATCADevice device = atcab_get_device();
         uint8_t handle_info[TA_HANDLE_INFO_SIZE];
         status = talib_info_get_handle_info(device, obj_ptr->slot, handle_info);
 
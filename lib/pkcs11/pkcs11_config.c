@@ -760,6 +760,7 @@ CK_RV pkcs11_config_load_objects(pkcs11_slot_ctx_ptr slot_ctx)
     char* argv[PKCS11_MAX_OBJECTS_ALLOWED + 1];
     int argc = 0;
     char filename[200];
+    int ret;
     int i;
     int j;
     pkcs11_lib_ctx_ptr pLibCtx = pkcs11_get_context();
@@ -797,11 +798,58 @@ CK_RV pkcs11_config_load_objects(pkcs11_slot_ctx_ptr slot_ctx)
         }
     }
 
+    /* Each slot reads only its own files */
+    i = (int)slot_ctx->slot_id;
     rv = 0;
-    for (i = 0; i < PKCS11_MAX_SLOTS_ALLOWED && !rv; i++)
+    ret = snprintf(filename, sizeof(filename), "%s%d.conf", pLibCtx->config_path, i);
+
+    if (ret > 0 && ret < sizeof(filename))
+    {
+        fp = fopen(filename, "rb");
+    }
+    else
+    {
+        fp = NULL;
+    }
+
+    if (fp)
+    {
+        buflen = pkcs11_config_load_file(fp, &buffer);
+        fclose(fp);
+        fp = NULL;
+
+        if (0 < buflen)
+        {
+            if (0 < (argc = pkcs11_config_parse_buffer(buffer, buflen, sizeof(argv) / sizeof(argv[0]), argv)))
+            {
+                rv = pkcs11_config_parse_slot_file(slot_ctx, argc, argv);
+            }
+            else
+            {
+                PKCS11_DEBUG("Failed to parse the slot configuration file");
+            }
+#ifndef PKCS11_LABEL_IS_SERNUM
+            if (CKR_OK == rv)
+            {
+                /* If a label wasn't set - configure a default */
+                if (!slot_ctx->label[0])
+                {
+                    snprintf((char*)slot_ctx->label, sizeof(slot_ctx->label) - 1, "%02XABC", (uint8_t)i);
+                }
+            }
+#endif
+            pkcs11_os_free(buffer);
+        }
+    }
+    else if (i)
     {
-        int ret = snprintf(filename, sizeof(filename), "%s%d.conf", pLibCtx->config_path, i);
+        /* Only the first slot has a default device configuration */
+        return CKR_TOKEN_NOT_PRESENT;
+    }
 
+    for (j = 0; j < 16; j++)
+    {
+        ret = snprintf(filename, sizeof(filename), "%s%d.%d.conf", pLibCtx->config_path, i, j);
         if (ret > 0 && ret < sizeof(filename))
         {
             fp = fopen(filename, "rb");
@@ -817,65 +865,22 @@ CK_RV pkcs11_config_load_objects(pkcs11_slot_ctx_ptr slot_ctx)
             fclose(fp);
             fp = NULL;
 
+            /* Remove the slot from the free list*/
+            slot_ctx->flags &= ~(1 << j);
+
             if (0 < buflen)
             {
                 if (0 < (argc = pkcs11_config_parse_buffer(buffer, buflen, sizeof(argv) / sizeof(argv[0]), argv)))
                 {
-                    rv = pkcs11_config_parse_slot_file(slot_ctx, argc, argv);
+                    rv = pkcs11_config_parse_object_file(slot_ctx, j, argc, argv);
                 }
                 else
                 {
                     PKCS11_DEBUG("Failed to parse the slot configuration file");
                 }
-#ifndef PKCS11_LABEL_IS_SERNUM
-                if (CKR_OK == rv)
-                {
-                    /* If a label wasn't set - configure a default */
-                    if (!slot_ctx->label[0])
-                    {
-                        snprintf((char*)slot_ctx->label, sizeof(slot_ctx->label) - 1, "%02XABC", (uint8_t)i);
-                    }
-                }
-#endif
                 pkcs11_os_free(buffer);
             }
         }
-
-        for (j = 0; j < 16; j++)
-        {
-            int ret = snprintf(filename, sizeof(filename), "%s%d.%d.conf", pLibCtx->config_path, i, j);
-            if (ret > 0 && ret < sizeof(filename))
-            {
-                fp = fopen(filename, "rb");
-            }
-            else
-            {
-                fp = NULL;
-            }
-
-            if (fp)
-            {
-                buflen = pkcs11_config_load_file(fp, &buffer);
-                fclose(fp);
-                fp = NULL;
-
-                /* Remove the slot from the free list*/
-                slot_ctx->flags &= ~(1 << j);
-
-                if (0 < buflen)
-                {
-                    if (0 < (argc = pkcs11_config_parse_buffer(buffer, buflen, sizeof(argv) / sizeof(argv[0]), argv)))
-                    {
-                        rv = pkcs11_config_parse_object_file(slot_ctx, j, argc, argv);
-                    }
-                    else
-                    {
-                        PKCS11_DEBUG("Failed to parse the slot configuration file");
-                    }
-                    pkcs11_os_free(buffer);
-                }
-            }
-        }
     }
 
     return rv;
@@ -913,6 +918,21 @@ CK_RV pkcs11_config_load(pkcs11_slot_ctx_ptr slot_ctx)
         rv = pkcs11_config_load_objects(slot_ctx);
     }
 
+    /* Everything loaded so far without a slot belongs to this one */
+    for (int i = 0; i < PKCS11_MAX_OBJECTS_ALLOWED; i++)
+    {
+        if (pkcs11_object_cache[i].object && !pkcs11_object_cache[i].object->slot_ctx)
+        {
+            pkcs11_object_cache[i].object->slot_ctx = slot_ctx;
+        }
+    }
+
+    /* Objects were labelled after they were allocated so index them again */
+    if (CKR_OK == rv)
+    {
+        rv = pkcs11_object_index_rebuild();
+    }
+
     return rv;
 }
 
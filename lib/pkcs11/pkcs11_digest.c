@@ -1,15 +1,107 @@
-
 #include "pkcs11_init.h"
 #include "pkcs11_digest.h"
 #include "pkcs11_object.h"
 #include "pkcs11_session.h"
+#include "pkcs11_slot.h"
 #include "pkcs11_util.h"
 #include "cryptoauthlib.h"
 
-#if !PKCS11_HARDWARE_SHA256
-#include "crypto/atca_crypto_sw_sha2.h"
-static atcac_sha2_256_ctx pkcs11_digest_ctx;
-static bool pkcs11_digest_initalized;
+#if PKCS11_HARDWARE_SHA256
+/**
+ * \brief Take the device SHA engine from the session digest loaded in it,
+ * saving the engine context if that digest is unfinished. Must be called with
+ * the slot locked.
+ */
+CK_RV pkcs11_digest_evict(pkcs11_slot_ctx_ptr pSlot)
+{
+    pkcs11_session_ctx_ptr pOwner = (pkcs11_session_ctx_ptr)pSlot->digest_owner;
+    ATCA_STATUS status;
+
+    if (pOwner && pOwner->digest.active && pOwner->digest.started)
+    {
+        /* Only the ATECC608 can save and restore the engine context */
+        if (ATECC608 != atcab_get_device_type_ext(pSlot->device_ctx))
+        {
+            return CKR_OPERATION_ACTIVE;
+        }
+
+        pOwner->digest.engine_size = sizeof(pOwner->digest.engine);
+        if (ATCA_SUCCESS != (status = atcab_sha_read_context_ext(pSlot->device_ctx, pOwner->digest.engine, &pOwner->digest.engine_size)))
+        {
+            return pkcs11_util_convert_rv(status);
+        }
+    }
+    pSlot->digest_owner = NULL;
+
+    return CKR_OK;
+}
+
+/**
+ * \brief Load the digest of a session into the device SHA engine, saving the
+ * engine context of the session that was using it if that digest is unfinished.
+ * Must be called with the slot locked.
+ */
+static CK_RV pkcs11_digest_acquire(pkcs11_session_ctx_ptr pSession)
+{
+    pkcs11_slot_ctx_ptr pSlot = pSession->slot;
+    ATCA_STATUS status;
+    CK_RV rv;
+
+    if (pSlot->digest_owner == pSession)
+    {
+        return CKR_OK;
+    }
+
+    /* A multi-part HMAC can't be saved so it keeps the engine until it ends */
+    if (pSlot->hmac_owner)
+    {
+        return CKR_OPERATION_ACTIVE;
+    }
+
+    if (CKR_OK != (rv = pkcs11_digest_evict(pSlot)))
+    {
+        return rv;
+    }
+
+    if (pSession->digest.started)
+    {
+        status = atcab_sha_write_context_ext(pSlot->device_ctx, pSession->digest.engine, pSession->digest.engine_size);
+    }
+    else
+    {
+        status = atcab_sha_start_ext(pSlot->device_ctx);
+        pSession->digest.started = TRUE;
+    }
+
+    if (ATCA_SUCCESS == status)
+    {
+        pSlot->digest_owner = pSession;
+    }
+
+    return pkcs11_util_convert_rv(status);
+}
+
+/**
+ * \brief Ends the digest operation of a session and releases the engine
+ */
+static void pkcs11_digest_release(pkcs11_session_ctx_ptr pSession)
+{
+    pkcs11_slot_ctx_ptr pSlot = pSession->slot;
+
+    if (pSlot && pSlot->digest_owner == pSession)
+    {
+        pSlot->digest_owner = NULL;
+    }
+    pSession->digest.active = FALSE;
+}
+#else
+/**
+ * \brief Ends the digest operation of a session
+ */
+static void pkcs11_digest_release(pkcs11_session_ctx_ptr pSession)
+{
+    pSession->digest.active = FALSE;
+}
 #endif
 
 /**
@@ -41,18 +133,27 @@ CK_RV pkcs11_digest_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanism
     {
         return rv;
     }
+
+    if (pSession->digest.active)
+    {
+        return CKR_OPERATION_ACTIVE;
+    }
+
 #if PKCS11_HARDWARE_SHA256
-    return CKR_FUNCTION_NOT_SUPPORTED;
+    /* The device engine is started on the first use */
+    (void)pkcs11_util_memset(&pSession->digest.context, sizeof(pSession->digest.context), 0, sizeof(pSession->digest.context));
+    pSession->digest.started = FALSE;
+    pSession->digest.engine_size = 0;
 #else
-    rv = atcac_sw_sha2_256_init(&pkcs11_digest_ctx);
+    rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_init(&pSession->digest.context));
+#endif
 
-    if (ATCA_SUCCESS == rv)
+    if (CKR_OK == rv)
     {
-        pkcs11_digest_initalized = TRUE;
+        pSession->digest.active = TRUE;
     }
 
-    return pkcs11_util_convert_rv(rv);
-#endif
+    return rv;
 }
 
 /**
@@ -60,10 +161,11 @@ CK_RV pkcs11_digest_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanism
  */
 CK_RV pkcs11_digest(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulDataLen, CK_BYTE_PTR pDigest, CK_ULONG_PTR pulDigestLen)
 {
+    pkcs11_lib_ctx_ptr pLibCtx = NULL;
     pkcs11_session_ctx_ptr pSession;
     CK_RV rv;
 
-    rv = pkcs11_init_check(NULL_PTR, FALSE);
+    rv = pkcs11_init_check(&pLibCtx, FALSE);
     if (rv)
     {
         return rv;
@@ -90,26 +192,54 @@ CK_RV pkcs11_digest(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulDa
         return rv;
     }
 
-#if PKCS11_HARDWARE_SHA256
-    ((void)hSession);
-    ((void)pData);
-    ((void)ulDataLen);
-    ((void)pDigest);
-    ((void)pulDigestLen);
-
-    return CKR_FUNCTION_NOT_SUPPORTED;
-#else
-    if (!pkcs11_digest_initalized)
+    if (!pSession->digest.active)
     {
         return CKR_OPERATION_NOT_INITIALIZED;
     }
 
-    rv = atcac_sw_sha2_256(pData, ulDataLen, pDigest);
+#if PKCS11_HARDWARE_SHA256
+    if (CKR_OK != (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
+    {
+        return rv;
+    }
 
-    pkcs11_digest_initalized = FALSE;
+#if ATCA_CA_SUPPORT
+    /* The whole message is known so the device offload policy decides where
+       it is hashed - off the device the SHA engine is left to its owner */
+    if (!pSession->digest.started && ATCA_SHA_OFFLOAD_DEVICE != calib_sha_get_offload(pSession->slot->device_ctx, ulDataLen))
+    {
+        rv = pkcs11_util_convert_rv(calib_hw_sha2_256(pSession->slot->device_ctx, pData, ulDataLen, pDigest));
+    }
+    else
+#endif
+    {
+        if (CKR_OK == (rv = pkcs11_digest_acquire(pSession)))
+        {
+            rv = pkcs11_util_convert_rv(atcab_hw_sha2_256_update_ext(pSession->slot->device_ctx, &pSession->digest.context, pData, ulDataLen));
+        }
+        if (CKR_OK == rv)
+        {
+            rv = pkcs11_util_convert_rv(atcab_hw_sha2_256_finish_ext(pSession->slot->device_ctx, &pSession->digest.context, pDigest));
+        }
+    }
+    pkcs11_digest_release(pSession);
 
-    return pkcs11_util_convert_rv(rv);
+    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
+#else
+    rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_update(&pSession->digest.context, pData, ulDataLen));
+    if (CKR_OK == rv)
+    {
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_finish(&pSession->digest.context, pDigest));
+    }
+    pkcs11_digest_release(pSession);
 #endif
+
+    if (CKR_OK == rv)
+    {
+        *pulDigestLen = ATCA_SHA2_256_DIGEST_SIZE;
+    }
+
+    return rv;
 }
 
 /**
@@ -117,10 +247,11 @@ CK_RV pkcs11_digest(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulDa
  */
 CK_RV pkcs11_digest_update(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULONG ulPartLen)
 {
+    pkcs11_lib_ctx_ptr pLibCtx = NULL;
     pkcs11_session_ctx_ptr pSession;
     CK_RV rv;
 
-    rv = pkcs11_init_check(NULL_PTR, FALSE);
+    rv = pkcs11_init_check(&pLibCtx, FALSE);
     if (rv)
     {
         return rv;
@@ -137,23 +268,39 @@ CK_RV pkcs11_digest_update(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULO
         return rv;
     }
 
+    if (!pSession->digest.active)
+    {
+        return CKR_OPERATION_NOT_INITIALIZED;
+    }
+
 #if PKCS11_HARDWARE_SHA256
-    ((void)hSession);
-    ((void)pPart);
-    ((void)ulPartLen);
+    if (CKR_OK != (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
+    {
+        return rv;
+    }
 
-    return CKR_FUNCTION_NOT_SUPPORTED;
-#else
-    if (!pkcs11_digest_initalized)
+    if (CKR_OK == (rv = pkcs11_digest_acquire(pSession)))
     {
-        return CKR_OPERATION_NOT_INITIALIZED;
+        rv = pkcs11_util_convert_rv(atcab_hw_sha2_256_update_ext(pSession->slot->device_ctx, &pSession->digest.context, pPart, ulPartLen));
+    }
+
+    /* A failed update ends the operation - the engine is left to whoever has it */
+    if (CKR_OK != rv && CKR_OPERATION_ACTIVE != rv)
+    {
+        pkcs11_digest_release(pSession);
     }
 
-    rv = atcac_sw_sha2_256_update(&pkcs11_digest_ctx, pPart, ulPartLen);
+    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
+#else
+    rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_update(&pSession->digest.context, pPart, ulPartLen));
 
-    return pkcs11_util_convert_rv(rv);
+    if (CKR_OK != rv)
+    {
+        pkcs11_digest_release(pSession);
+    }
 #endif
 
+    return rv;
 }
 
 /**
@@ -161,10 +308,11 @@ CK_RV pkcs11_digest_update(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULO
  */
 CK_RV pkcs11_digest_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pDigest, CK_ULONG_PTR pulDigestLen)
 {
+    pkcs11_lib_ctx_ptr pLibCtx = NULL;
     pkcs11_session_ctx_ptr pSession;
     CK_RV rv;
 
-    rv = pkcs11_init_check(NULL_PTR, FALSE);
+    rv = pkcs11_init_check(&pLibCtx, FALSE);
     if (rv)
     {
         return rv;
@@ -191,22 +339,49 @@ CK_RV pkcs11_digest_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pDigest, CK_UL
         return rv;
     }
 
+    if (!pSession->digest.active)
+    {
+        return CKR_OPERATION_NOT_INITIALIZED;
+    }
+
 #if PKCS11_HARDWARE_SHA256
-    ((void)hSession);
-    ((void)pDigest);
-    ((void)pulDigestLen);
+    if (CKR_OK != (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
+    {
+        return rv;
+    }
 
-    return CKR_FUNCTION_NOT_SUPPORTED;
-#else
-    if (!pkcs11_digest_initalized)
+    if (CKR_OK == (rv = pkcs11_digest_acquire(pSession)))
     {
-        return CKR_OPERATION_NOT_INITIALIZED;
+        rv = pkcs11_util_convert_rv(atcab_hw_sha2_256_finish_ext(pSession->slot->device_ctx, &pSession->digest.context, pDigest));
     }
 
-    rv = atcac_sw_sha2_256_finish(&pkcs11_digest_ctx, pDigest);
+    if (CKR_OPERATION_ACTIVE != rv)
+    {
+        pkcs11_digest_release(pSession);
+    }
 
-    pkcs11_digest_initalized = FALSE;
+    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
+#else
+    rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_finish(&pSession->digest.context, pDigest));
 
-    return pkcs11_util_convert_rv(rv);
+    pkcs11_digest_release(pSession);
 #endif
+
+    if (CKR_OK == rv)
+    {
+        *pulDigestLen = ATCA_SHA2_256_DIGEST_SIZE;
+    }
+
+    return rv;
+}
+
+/**
+ * \brief Ends any digest operation of a session being closed
+ */
+void pkcs11_digest_session_close(pkcs11_session_ctx_ptr pSession)
+{
+    if (pSession && pSession->digest.active)
+    {
+        pkcs11_digest_release(pSession);
+    }
 }
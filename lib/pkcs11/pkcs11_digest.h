@@ -29,6 +29,7 @@
 #define PKCS11_DIGEST_H_
 
 #include "cryptoki.h"
+#include "pkcs11_session.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,5 +43,9 @@ CK_RV pkcs11_digest_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanism
 CK_RV pkcs11_digest(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulDataLen, CK_BYTE_PTR pDigest, CK_ULONG_PTR pulDigestLen);
 CK_RV pkcs11_digest_update(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULONG ulPartLen);
 CK_RV pkcs11_digest_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pDigest, CK_ULONG_PTR pulDigestLen);
+void pkcs11_digest_session_close(pkcs11_session_ctx_ptr pSession);
+#if PKCS11_HARDWARE_SHA256
+CK_RV pkcs11_digest_evict(pkcs11_slot_ctx_ptr pSlot);
+#endif
 
 #endif /* PKCS11_DIGEST_H_ */
\ No newline at end of file
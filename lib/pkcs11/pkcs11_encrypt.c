@@ -33,6 +33,7 @@
 #include "pkcs11_init.h"
 #include "pkcs11_object.h"
 #include "pkcs11_session.h"
+#include "pkcs11_slot.h"
 #include "pkcs11_util.h"
 
 
@@ -84,10 +85,10 @@ CK_RV pkcs11_encrypt_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanis
                 if (pParams->ulTagBits % 8 == 0)
                 {
                     pSession->active_mech_data.gcm.tag_len = pParams->ulTagBits / 8;
-                    if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_aes_gcm_init(&pSession->active_mech_data.gcm.context,
-                                                                                  pObject->slot, 0, pParams->pIv, pParams->ulIvLen))))
+                    if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_aes_gcm_init_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context,
+                                                                                      pObject->slot, 0, pParams->pIv, pParams->ulIvLen))))
                     {
-                        rv = pkcs11_util_convert_rv(atcab_aes_gcm_aad_update(&pSession->active_mech_data.gcm.context, pParams->pAAD, pParams->ulAADLen));
+                        rv = pkcs11_util_convert_rv(atcab_aes_gcm_aad_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pParams->pAAD, pParams->ulAADLen));
                     }
                 }
                 else
@@ -157,7 +158,7 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
     case CKM_AES_ECB:
         if (ulDataLen == ATCA_AES128_BLOCK_SIZE && *pulEncryptedDataLen > ATCA_AES128_BLOCK_SIZE)
         {
-            status = atcab_aes_encrypt(pKey->slot, 0, pData, pEncryptedData);
+            status = atcab_aes_encrypt_ext(pSession->slot->device_ctx, pKey->slot, 0, pData, pEncryptedData);
             *pulEncryptedDataLen = ATCA_AES128_BLOCK_SIZE;
         }
         else
@@ -166,10 +167,10 @@ CK_RV pkcs11_encrypt(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulD
         }
         break;
     case CKM_AES_GCM:
-        if (ATCA_SUCCESS == (status = atcab_aes_gcm_encrypt_update(&pSession->active_mech_data.gcm.context, pData, ulDataLen, pEncryptedData)))
+        if (ATCA_SUCCESS == (status = atcab_aes_gcm_encrypt_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pData, ulDataLen, pEncryptedData)))
         {
-            status = atcab_aes_gcm_encrypt_finish(&pSession->active_mech_data.gcm.context, &pEncryptedData[ulDataLen],
-                                                  pSession->active_mech_data.gcm.tag_len);
+            status = atcab_aes_gcm_encrypt_finish_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, &pEncryptedData[ulDataLen],
+                                                      pSession->active_mech_data.gcm.tag_len);
             *pulEncryptedDataLen = ulDataLen + pSession->active_mech_data.gcm.tag_len;
         }
         break;
@@ -230,7 +231,7 @@ CK_RV pkcs11_encrypt_update
     case CKM_AES_ECB:
         if (ulDataLen == ATCA_AES128_BLOCK_SIZE && *pulEncryptedDataLen > ATCA_AES128_BLOCK_SIZE)
         {
-            status = atcab_aes_encrypt(pKey->slot, 0, pData, pEncryptedData);
+            status = atcab_aes_encrypt_ext(pSession->slot->device_ctx, pKey->slot, 0, pData, pEncryptedData);
             *pulEncryptedDataLen = ATCA_AES128_BLOCK_SIZE;
         }
         else
@@ -239,7 +240,7 @@ CK_RV pkcs11_encrypt_update
         }
         break;
     case CKM_AES_GCM:
-        status = atcab_aes_gcm_encrypt_update(&pSession->active_mech_data.gcm.context, pData, ulDataLen, pEncryptedData);
+        status = atcab_aes_gcm_encrypt_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pData, ulDataLen, pEncryptedData);
         break;
     default:
         rv = CKR_MECHANISM_INVALID;
@@ -293,8 +294,8 @@ CK_RV pkcs11_encrypt_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pEncryptedDat
     case CKM_AES_ECB:
         break;
     case CKM_AES_GCM:
-        status = atcab_aes_gcm_encrypt_finish(&pSession->active_mech_data.gcm.context, pEncryptedData,
-                                              pSession->active_mech_data.gcm.tag_len);
+        status = atcab_aes_gcm_encrypt_finish_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pEncryptedData,
+                                                  pSession->active_mech_data.gcm.tag_len);
         *pulEncryptedDataLen = pSession->active_mech_data.gcm.tag_len;
         break;
     default:
@@ -356,10 +357,10 @@ CK_RV pkcs11_decrypt_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pMechanis
                 if (pParams->ulTagBits % 8 == 0)
                 {
                     pSession->active_mech_data.gcm.tag_len = pParams->ulTagBits / 8;
-                    if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_aes_gcm_init(&pSession->active_mech_data.gcm.context,
-                                                                                  pObject->slot, 0, pParams->pIv, pParams->ulIvLen))))
+                    if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_aes_gcm_init_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context,
+                                                                                      pObject->slot, 0, pParams->pIv, pParams->ulIvLen))))
                     {
-                        rv = pkcs11_util_convert_rv(atcab_aes_gcm_aad_update(&pSession->active_mech_data.gcm.context, pParams->pAAD, pParams->ulAADLen));
+                        rv = pkcs11_util_convert_rv(atcab_aes_gcm_aad_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pParams->pAAD, pParams->ulAADLen));
                     }
                 }
                 else
@@ -435,7 +436,7 @@ CK_RV pkcs11_decrypt
     case CKM_AES_ECB:
         if (ulEncryptedDataLen == ATCA_AES128_BLOCK_SIZE && *pulDataLen >= ATCA_AES128_BLOCK_SIZE)
         {
-            status = atcab_aes_decrypt(pKey->slot, 0, pEncryptedData, pData);
+            status = atcab_aes_decrypt_ext(pSession->slot->device_ctx, pKey->slot, 0, pEncryptedData, pData);
             *pulDataLen = ATCA_AES128_BLOCK_SIZE;
         }
         else
@@ -445,12 +446,12 @@ CK_RV pkcs11_decrypt
         break;
     case CKM_AES_GCM:
         *pulDataLen = ulEncryptedDataLen - pSession->active_mech_data.gcm.tag_len;
-        if (ATCA_SUCCESS == (status = atcab_aes_gcm_decrypt_update(&pSession->active_mech_data.gcm.context, pEncryptedData,
-                                                                   *pulDataLen, pData)))
+        if (ATCA_SUCCESS == (status = atcab_aes_gcm_decrypt_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pEncryptedData,
+                                                                       *pulDataLen, pData)))
         {
             bool is_verified = FALSE;
-            status = atcab_aes_gcm_decrypt_finish(&pSession->active_mech_data.gcm.context, &pEncryptedData[*pulDataLen],
-                                                  pSession->active_mech_data.gcm.tag_len, &is_verified);
+            status = atcab_aes_gcm_decrypt_finish_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, &pEncryptedData[*pulDataLen],
+                                                      pSession->active_mech_data.gcm.tag_len, &is_verified);
             if (!is_verified)
             {
                 rv = CKR_ENCRYPTED_DATA_INVALID;
@@ -515,7 +516,7 @@ CK_RV pkcs11_decrypt_update
     case CKM_AES_ECB:
         if (ulEncryptedDataLen == ATCA_AES128_BLOCK_SIZE && *pulDataLen > ATCA_AES128_BLOCK_SIZE)
         {
-            status = atcab_aes_decrypt(pKey->slot, 0, pData, pEncryptedData);
+            status = atcab_aes_decrypt_ext(pSession->slot->device_ctx, pKey->slot, 0, pData, pEncryptedData);
             *pulDataLen = ATCA_AES128_BLOCK_SIZE;
         }
         else
@@ -524,8 +525,8 @@ CK_RV pkcs11_decrypt_update
         }
         break;
     case CKM_AES_GCM:
-        status = atcab_aes_gcm_decrypt_update(&pSession->active_mech_data.gcm.context, pEncryptedData,
-                                              *pulDataLen, pData);
+        status = atcab_aes_gcm_decrypt_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pEncryptedData,
+                                                  *pulDataLen, pData);
         break;
     default:
         rv = CKR_MECHANISM_INVALID;
@@ -581,8 +582,8 @@ CK_RV pkcs11_decrypt_final(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULO
     case CKM_AES_GCM:
     {
         bool is_verified = FALSE;
-        status = atcab_aes_gcm_decrypt_finish(&pSession->active_mech_data.gcm.context, pData,
-                                              pSession->active_mech_data.gcm.tag_len, &is_verified);
+        status = atcab_aes_gcm_decrypt_finish_ext(pSession->slot->device_ctx, &pSession->active_mech_data.gcm.context, pData,
+                                                  pSession->active_mech_data.gcm.tag_len, &is_verified);
         if (!is_verified)
         {
             rv = CKR_ENCRYPTED_DATA_INVALID;
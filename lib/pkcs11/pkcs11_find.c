@@ -34,6 +34,9 @@
 #include "pkcs11_session.h"
 #include "pkcs11_find.h"
 #include "pkcs11_util.h"
+#include "pkcs11_attrib.h"
+#include "pkcs11_object.h"
+#include "pkcs11_token.h"
 
 /**
  * \defgroup pkcs11 Find (pkcs11_find_)
@@ -43,6 +46,38 @@
 static CK_BYTE pkcs11_find_template_cache[PKCS11_SEARCH_CACHE_SIZE];
 //#endif
 
+/**
+ * \brief Attribute functions that only read the object cache or the cached
+ * device configuration. These never wait for a device that is busy with a
+ * command sequence.
+ */
+static const attrib_f pkcs11_find_cached_attrib_funcs[] = {
+    pkcs11_attrib_true,
+    pkcs11_attrib_false,
+    pkcs11_attrib_empty,
+    pkcs11_object_get_name,
+    pkcs11_object_get_class,
+    pkcs11_object_get_type,
+    pkcs11_object_get_destroyable,
+    pkcs11_token_get_access_type,
+    pkcs11_token_get_writable,
+    pkcs11_token_get_storage,
+};
+
+static CK_BBOOL pkcs11_find_attrib_is_cached(attrib_f func)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(pkcs11_find_cached_attrib_funcs) / sizeof(pkcs11_find_cached_attrib_funcs[0]); i++)
+    {
+        if (func == pkcs11_find_cached_attrib_funcs[i])
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
 /**
  * \brief Copy an array of CK_ATTRIBUTE structures
  */
@@ -132,6 +167,26 @@ static pkcs11_attrib_model_ptr pkcs11_find_attrib(const pkcs11_attrib_model_ptr
     return NULL_PTR;
 }
 
+static CK_RV pkcs11_find_get_value(attrib_f func, pkcs11_object_ptr pObject, CK_ATTRIBUTE_PTR pAttribute)
+{
+    pkcs11_lib_ctx_ptr pLibCtx;
+    CK_RV rv;
+
+    if (pkcs11_find_attrib_is_cached(func))
+    {
+        return func(pObject, pAttribute);
+    }
+
+    pLibCtx = pkcs11_get_context();
+    if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
+    {
+        rv = func(pObject, pAttribute);
+        (void)pkcs11_unlock_context(pLibCtx);
+    }
+
+    return rv;
+}
+
 static pkcs11_attrib_model_ptr pkcs11_find_attrib_match(pkcs11_object_ptr pObject, const pkcs11_attrib_model_ptr pAttributeList, const CK_ULONG ulCount, const CK_ATTRIBUTE_PTR pTemplate)
 {
     CK_BBOOL found = FALSE;
@@ -165,8 +220,9 @@ static pkcs11_attrib_model_ptr pkcs11_find_attrib_match(pkcs11_object_ptr pObjec
             temp.ulValueLen = pTemplate->ulValueLen;
 #endif
 
-            /* Get the attribute */
-            if (!pAttribute->func(pObject, &temp))
+            /* Get the attribute - values from the device and the attribute
+               cache are shared with the other sessions */
+            if (!pkcs11_find_get_value(pAttribute->func, pObject, &temp))
             {
                 if ((temp.ulValueLen == pTemplate->ulValueLen))
                 {
@@ -203,8 +259,10 @@ static CK_OBJECT_HANDLE pkcs11_find_handle(const CK_ATTRIBUTE_PTR pTemplate, CK_
     CK_ULONG j;
     CK_OBJECT_HANDLE rv = NULL_PTR;
 
-    /* Finds the first or next match - Iterate through objects */
-    for (i = (index) ? *index : 0; i < PKCS11_MAX_OBJECTS_ALLOWED; i++)
+    /* Finds the first or next match - Iterate through the objects indexed
+       under the label or class being searched for */
+    for (i = pkcs11_object_index_next(pTemplate, ulCount, (index) ? *index : 0); i < PKCS11_MAX_OBJECTS_ALLOWED;
+         i = pkcs11_object_index_next(pTemplate, ulCount, i + 1))
     {
         pkcs11_object_ptr pObject = pkcs11_object_cache[i].object;
         if (pObject)
@@ -423,6 +481,15 @@ CK_RV pkcs11_find_get_attribute(CK_SESSION_HANDLE hSession, CK_OBJECT_HANDLE hOb
                 rv = CKR_ATTRIBUTE_TYPE_INVALID;
             }
         }
+        else if (pAttribute->func && pkcs11_find_attrib_is_cached(pAttribute->func))
+        {
+            /* Nothing to ask the device so don't wait behind other operations */
+            CK_RV temp = pAttribute->func(pObject, &pTemplate[i]);
+            if (!rv)
+            {
+                rv = temp;
+            }
+        }
         else if (pAttribute->func)
         {
             if (CKR_OK == pkcs11_lock_context(pLibCtx))
@@ -35,6 +35,7 @@
 #include "pkcs11_object.h"
 #include "pkcs11_session.h"
 #include "cryptoauthlib.h"
+#include "atcacert/atcacert_cache.h"
 
 #ifdef CreateMutex
 #undef CreateMutex /* CreateMutex is defined to CreateMutexW in synchapi.h in Windows. */
@@ -67,9 +68,14 @@ pkcs11_lib_ctx_ptr pkcs11_get_context(void)
     return &pkcs11_context;
 }
 
+/**
+ * \brief Lock the library context and every slot so the caller has exclusive
+ * use of the library and all of the devices
+ */
 CK_RV pkcs11_lock_context(pkcs11_lib_ctx_ptr pContext)
 {
     CK_RV rv = CKR_ARGUMENTS_BAD;
+    CK_ULONG i;
 
 //    PKCS11_DEBUG("%p\r\n", pkcs11_context.lock_mutex);
 
@@ -84,12 +90,26 @@ CK_RV pkcs11_lock_context(pkcs11_lib_ctx_ptr pContext)
             rv = CKR_CANT_LOCK;
         }
     }
+
+    /* Slots are always taken in order after the library mutex */
+    for (i = 0; CKR_OK == rv && i < pContext->slot_cnt && pContext->slots; i++)
+    {
+        if (CKR_OK != (rv = pkcs11_lock_device(pContext, &((pkcs11_slot_ctx_ptr)pContext->slots)[i])))
+        {
+            while (i--)
+            {
+                (void)pkcs11_unlock_device(pContext, &((pkcs11_slot_ctx_ptr)pContext->slots)[i]);
+            }
+            (void)pContext->unlock_mutex(pContext->mutex);
+        }
+    }
     return rv;
 }
 
 CK_RV pkcs11_unlock_context(pkcs11_lib_ctx_ptr pContext)
 {
     CK_RV rv = CKR_CRYPTOKI_NOT_INITIALIZED;
+    CK_ULONG i;
 
 //    PKCS11_DEBUG("%p\r\n", pkcs11_context.unlock_mutex);
 
@@ -102,6 +122,10 @@ CK_RV pkcs11_unlock_context(pkcs11_lib_ctx_ptr pContext)
     {
         if (pContext->unlock_mutex)
         {
+            for (i = pContext->slot_cnt; i > 0 && pContext->slots; i--)
+            {
+                (void)pkcs11_unlock_device(pContext, &((pkcs11_slot_ctx_ptr)pContext->slots)[i - 1]);
+            }
             rv = pContext->unlock_mutex(pContext->mutex);
         }
         else
@@ -113,6 +137,47 @@ CK_RV pkcs11_unlock_context(pkcs11_lib_ctx_ptr pContext)
     return rv;
 }
 
+/**
+ * \brief Lock a single slot for a command sequence on its device. Operations
+ * on other slots and those that only read the object cache continue to run.
+ */
+CK_RV pkcs11_lock_device(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot)
+{
+    CK_RV rv = CKR_ARGUMENTS_BAD;
+
+    if (pContext && pSlot)
+    {
+        if (pContext->lock_mutex)
+        {
+            /* A slot that failed to initialize has no mutex and no device */
+            rv = pSlot->mutex ? pContext->lock_mutex(pSlot->mutex) : CKR_OK;
+        }
+        else
+        {
+            rv = CKR_CANT_LOCK;
+        }
+    }
+    return rv;
+}
+
+CK_RV pkcs11_unlock_device(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot)
+{
+    CK_RV rv = CKR_ARGUMENTS_BAD;
+
+    if (pContext && pSlot)
+    {
+        if (pContext->unlock_mutex)
+        {
+            rv = pSlot->mutex ? pContext->unlock_mutex(pSlot->mutex) : CKR_OK;
+        }
+        else
+        {
+            rv = CKR_CANT_LOCK;
+        }
+    }
+    return rv;
+}
+
 /**
  * \brief Check if the library is initialized properly
  */
@@ -251,6 +316,24 @@ CK_RV pkcs11_init(CK_C_INITIALIZE_ARGS_PTR pInitArgs)
 
     if (CKR_OK == rv)
     {
+        CK_SLOT_ID slotID;
+
+        /* Additional devices each get their own slot - one that is missing
+           is left uninitialized and reports that no token is present */
+        for (slotID = 1; slotID < lib_ctx->slot_cnt; slotID++)
+        {
+            if (CKR_OK == pkcs11_slot_config(slotID))
+            {
+                (void)pkcs11_slot_init(slotID);
+            }
+        }
+
+#ifdef ATCA_CERT_CACHE
+        /* Certificates are read from several threads - the cache is only
+           used with its lock */
+        (void)atcacert_cache_init();
+#endif
+
         lib_ctx->initialized = TRUE;
     }
 
@@ -298,12 +381,17 @@ CK_RV pkcs11_deinit(CK_VOID_PTR pReserved)
         if (slot_ctx_ptr)
         {
             (void)pkcs11_session_closeall(slot_ctx_ptr->slot_id);
+            pkcs11_slot_deinit(slot_ctx_ptr);
         }
     }
 
     /* Clear the object cache */
     (void)pkcs11_object_deinit(&pkcs11_context);
 
+#ifdef ATCA_CERT_CACHE
+    atcacert_cache_release();
+#endif
+
     /** \todo If other threads are waiting for something to happen this call should
        cause those calls to unblock and return CKR_CRYPTOKI_NOT_INITIALIZED - How
        that is done by this simplified mutex API is yet to be determined */
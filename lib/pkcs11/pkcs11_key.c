@@ -188,6 +188,57 @@ static const uint8_t ec_x962_asn1_header[] = {
     0x04, 0x41, 0x04
 };
 
+/**
+ * \brief Read the raw public key of the object from the device or from the
+ * attribute cache if it has already been read
+ */
+static CK_RV pkcs11_key_read_public_key(pkcs11_object_ptr obj_ptr, uint8_t * public_key)
+{
+    CK_BBOOL is_private = false;
+    CK_RV rv;
+
+#if PKCS11_ATTRIB_CACHE_ENABLE
+    CK_VOID_PTR cached;
+    CK_ULONG cached_len;
+
+    if (pkcs11_object_cache_get_attrib(obj_ptr, CKA_EC_POINT, &cached, &cached_len) && (ATCA_ECCP256_PUBKEY_SIZE == cached_len))
+    {
+        memcpy(public_key, cached, ATCA_ECCP256_PUBKEY_SIZE);
+        return CKR_OK;
+    }
+#endif
+
+    if (CKR_OK == (rv = pkcs11_object_is_private(obj_ptr, &is_private)))
+    {
+        ATCA_STATUS status;
+
+        if (is_private)
+        {
+            status = atcab_get_pubkey_ext(pkcs11_object_get_device(obj_ptr), obj_ptr->slot, public_key);
+            PKCS11_DEBUG("atcab_get_pubkey: %x\r\n", status);
+        }
+        else
+        {
+            status = atcab_read_pubkey_ext(pkcs11_object_get_device(obj_ptr), obj_ptr->slot, public_key);
+            PKCS11_DEBUG("atcab_read_pubkey: %x\r\n", status);
+        }
+
+        if (ATCA_SUCCESS == status)
+        {
+#if PKCS11_ATTRIB_CACHE_ENABLE
+            /* A failure to cache only costs another read next time */
+            (void)pkcs11_object_cache_put_attrib(obj_ptr, CKA_EC_POINT, public_key, ATCA_ECCP256_PUBKEY_SIZE);
+#endif
+        }
+        else
+        {
+            rv = CKR_FUNCTION_FAILED;
+        }
+    }
+
+    return rv;
+}
+
 /**
  * \brief Extract a public key and convert it to the asn.1 format
  */
@@ -198,32 +249,13 @@ static CK_RV pkcs11_key_get_public_key(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAt
 
     if (obj_ptr)
     {
-        CK_BBOOL is_private = false;
-
-        if (CKR_OK == (rv = pkcs11_object_is_private(obj_ptr, &is_private)))
-        {
-            CK_UTF8CHAR ec_asn1_key[sizeof(ec_pubkey_asn1_header) + ATCA_ECCP256_PUBKEY_SIZE];
-            ATCA_STATUS status;
+        CK_UTF8CHAR ec_asn1_key[sizeof(ec_pubkey_asn1_header) + ATCA_ECCP256_PUBKEY_SIZE];
 
-            memcpy(ec_asn1_key, ec_pubkey_asn1_header, sizeof(ec_pubkey_asn1_header));
-
-            if (is_private)
-            {
-                status = atcab_get_pubkey(obj_ptr->slot, &ec_asn1_key[sizeof(ec_pubkey_asn1_header)]);
-            }
-            else
-            {
-                status = atcab_read_pubkey(obj_ptr->slot, &ec_asn1_key[sizeof(ec_pubkey_asn1_header)]);
-            }
+        memcpy(ec_asn1_key, ec_pubkey_asn1_header, sizeof(ec_pubkey_asn1_header));
 
-            if (ATCA_SUCCESS == status)
-            {
-                rv = pkcs11_attrib_fill(pAttribute, ec_asn1_key, sizeof(ec_asn1_key));
-            }
-            else
-            {
-                rv = CKR_FUNCTION_FAILED;
-            }
+        if (CKR_OK == (rv = pkcs11_key_read_public_key(obj_ptr, &ec_asn1_key[sizeof(ec_pubkey_asn1_header)])))
+        {
+            rv = pkcs11_attrib_fill(pAttribute, ec_asn1_key, sizeof(ec_asn1_key));
         }
     }
 
@@ -244,38 +276,18 @@ static CK_RV pkcs11_key_get_ec_point(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAttr
 
     if (obj_ptr)
     {
-        ATCA_STATUS status = ATCA_SUCCESS;
         CK_UTF8CHAR ec_asn1_key[3 + ATCA_ECCP256_PUBKEY_SIZE] = { 0x04, 0x41, 0x04 };
 
+        rv = CKR_OK;
         if (pAttribute->pValue)
         {
-            CK_BBOOL is_private;
-
-            if (CKR_OK == (rv = pkcs11_object_is_private(obj_ptr, &is_private)))
-            {
-                
-
-                if (is_private)
-                {
-                    status = atcab_get_pubkey(obj_ptr->slot, &ec_asn1_key[3]);
-                    PKCS11_DEBUG("atcab_get_pubkey: %x\r\n", status);
-                }
-                else
-                {
-                    status = atcab_read_pubkey(obj_ptr->slot, &ec_asn1_key[3]);
-                    PKCS11_DEBUG("atcab_read_pubkey: %x\r\n", status);
-                }
-            }
+            rv = pkcs11_key_read_public_key(obj_ptr, &ec_asn1_key[3]);
         }
 
-        if (ATCA_SUCCESS == status)
+        if (CKR_OK == rv)
         {
             rv = pkcs11_attrib_fill(pAttribute, ec_asn1_key, sizeof(ec_asn1_key));
         }
-        else
-        {
-            rv = CKR_FUNCTION_FAILED;
-        }
     }
 
     return rv;
@@ -341,7 +353,7 @@ static CK_RV pkcs11_key_auth_required(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAtt
 
     if (obj_ptr)
     {
-        if (atcab_is_ca_device(atcab_get_device_type()))
+        if (atcab_is_ca_device(atcab_get_device_type_ext(pkcs11_object_get_device(obj_ptr))))
         {
 #if ATCA_CA_SUPPORT
 #endif
@@ -680,7 +692,8 @@ static CK_RV pkcs11_key_privwrite_ca(CK_VOID_PTR pSession, pkcs11_object_ptr pOb
         /* Requires the io protection secret to be configured previously and for the
             configuration to support this - should only be enabled for testing purposes.
             Production devices should never have this feature enabled. */
-        rv = pkcs11_util_convert_rv(atcab_priv_write(pObject->slot, key_buf, write_key_id, session_ctx->slot->read_key, NULL));
+        rv = pkcs11_util_convert_rv(calib_priv_write(session_ctx->slot->device_ctx, pObject->slot, key_buf, write_key_id,
+                                                     session_ctx->slot->read_key, NULL));
     }
 
     return rv;
@@ -697,6 +710,18 @@ CK_RV pkcs11_key_write(CK_VOID_PTR pSession, CK_VOID_PTR pObject, CK_ATTRIBUTE_P
 
     if (obj_ptr && pAttribute && pAttribute->pValue)
     {
+        ATCADevice device = pkcs11_object_get_device(obj_ptr);
+        pkcs11_lib_ctx_ptr pLibCtx = pkcs11_get_context();
+
+        /* Whatever was read from the slot before is about to be stale */
+        if (CKR_OK != (rv = pkcs11_lock_context(pLibCtx)))
+        {
+            return rv;
+        }
+        pkcs11_object_cache_invalidate(obj_ptr);
+        (void)pkcs11_unlock_context(pLibCtx);
+        rv = CKR_ARGUMENTS_BAD;
+
         if (obj_ptr->class_id == CKO_PUBLIC_KEY && pAttribute->type == CKA_EC_POINT)
         {
             if (!memcmp(ec_x962_asn1_header, pAttribute->pValue, sizeof(ec_x962_asn1_header)))
@@ -713,21 +738,21 @@ CK_RV pkcs11_key_write(CK_VOID_PTR pSession, CK_VOID_PTR pObject, CK_ATTRIBUTE_P
                     else
                     {
                         /* Actually write the public key into the slot */
-                        rv = pkcs11_util_convert_rv(atcab_write_pubkey(obj_ptr->slot, &(((uint8_t*)pAttribute->pValue)[sizeof(ec_x962_asn1_header)])));
+                        rv = pkcs11_util_convert_rv(atcab_write_pubkey_ext(device, obj_ptr->slot, &(((uint8_t*)pAttribute->pValue)[sizeof(ec_x962_asn1_header)])));
                     }
                 }
             }
         }
         else if (obj_ptr->class_id == CKO_PRIVATE_KEY && pAttribute->type == CKA_VALUE)
         {
-            if (atcab_is_ca_device(atcab_get_device_type()))
+            if (atcab_is_ca_device(atcab_get_device_type_ext(device)))
             {
                 rv = pkcs11_key_privwrite_ca(pSession, obj_ptr, pAttribute->pValue, pAttribute->ulValueLen);
             }
         }
         else if (obj_ptr->class_id == CKO_SECRET_KEY && pAttribute->type == CKA_VALUE)
         {
-            if (atcab_is_ca_device(atcab_get_device_type()) && ((pAttribute->ulValueLen % 32) != 0))
+            if (atcab_is_ca_device(atcab_get_device_type_ext(device)) && ((pAttribute->ulValueLen % 32) != 0))
             {
                 uint8_t buf[64] = { 0 };
                 uint16_t buflen = (pAttribute->ulValueLen / 32) ? 64 : 32;
@@ -736,11 +761,11 @@ CK_RV pkcs11_key_write(CK_VOID_PTR pSession, CK_VOID_PTR pObject, CK_ATTRIBUTE_P
                     return CKR_ATTRIBUTE_VALUE_INVALID;
                 }
                 memcpy(buf, pAttribute->pValue, pAttribute->ulValueLen);
-                rv = pkcs11_util_convert_rv(atcab_write_bytes_zone(ATCA_ZONE_DATA, obj_ptr->slot, 0, buf, buflen));
+                rv = pkcs11_util_convert_rv(atcab_write_bytes_zone_ext(device, ATCA_ZONE_DATA, obj_ptr->slot, 0, buf, buflen));
             }
             else
             {
-                rv = pkcs11_util_convert_rv(atcab_write_bytes_zone(ATCA_ZONE_DATA, obj_ptr->slot, 0, pAttribute->pValue, pAttribute->ulValueLen));
+                rv = pkcs11_util_convert_rv(atcab_write_bytes_zone_ext(device, ATCA_ZONE_DATA, obj_ptr->slot, 0, pAttribute->pValue, pAttribute->ulValueLen));
             }
         }
     }
@@ -816,6 +841,7 @@ CK_RV pkcs11_key_generate
     if (CKR_OK == rv)
     {
         pKey->class_id = CKO_SECRET_KEY;
+        pKey->slot_ctx = pSession->slot;
         rv = pkcs11_config_key(pLibCtx, pSession->slot, pKey, pName);
     }
 
@@ -824,21 +850,22 @@ CK_RV pkcs11_key_generate
         if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
         {
             atecc508a_config_t * pConfig = (atecc508a_config_t*)pKey->config;
+            ATCADevice device = pSession->slot->device_ctx;
 
             if (pConfig->KeyConfig[pKey->slot] & 0x0018)
             {
                 if (pConfig->SlotConfig[pKey->slot] & 0x2000)
                 {
-                    if (ATCA_SUCCESS == (status = atcab_nonce_rand(buf, NULL)))
+                    if (ATCA_SUCCESS == (status = calib_nonce_rand(device, buf, NULL)))
                     {
-                        status = atcab_derivekey(0, pKey->slot, NULL);
+                        status = calib_derivekey(device, 0, pKey->slot, NULL);
                     }
                 }
                 else
                 {
-                    if (ATCA_SUCCESS == (status = atcab_random(buf)))
+                    if (ATCA_SUCCESS == (status = atcab_random_ext(device, buf)))
                     {
-                        status = atcab_write_bytes_zone(ATCA_ZONE_DATA, pKey->slot, 0, buf, 32);
+                        status = atcab_write_bytes_zone_ext(device, ATCA_ZONE_DATA, pKey->slot, 0, buf, 32);
                     }
                 }
             }
@@ -852,6 +879,11 @@ CK_RV pkcs11_key_generate
         rv = pkcs11_util_convert_rv(status);
     }
 
+    if (CKR_OK == rv)
+    {
+        rv = pkcs11_object_index_rebuild();
+    }
+
     if (CKR_OK == rv)
     {
         pkcs11_object_get_handle(pKey, phKey);
@@ -951,12 +983,14 @@ CK_RV pkcs11_key_generate_pair
     if (CKR_OK == rv)
     {
         pPrivate->class_id = CKO_PRIVATE_KEY;
+        pPrivate->slot_ctx = pSession->slot;
         rv = pkcs11_config_key(pLibCtx, pSession->slot, pPrivate, pName);
     }
 
     if (CKR_OK == rv)
     {
         pPublic->slot = pPrivate->slot;
+        pPublic->slot_ctx = pPrivate->slot_ctx;
         pPublic->flags = pPrivate->flags;
         memcpy(pPublic->name, pName->pValue, pName->ulValueLen);
         pPublic->class_id = CKO_PUBLIC_KEY;
@@ -970,7 +1004,8 @@ CK_RV pkcs11_key_generate_pair
 
         if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
         {
-            rv = pkcs11_util_convert_rv(atcab_genkey(pPrivate->slot, NULL));
+            rv = pkcs11_util_convert_rv(atcab_genkey_ext(pSession->slot->device_ctx, pPrivate->slot, NULL));
+            pkcs11_object_cache_invalidate(pPrivate);
             if (rv)
             {
                 (void)pkcs11_config_remove_object(pLibCtx, pSession->slot, pPrivate);
@@ -979,6 +1014,11 @@ CK_RV pkcs11_key_generate_pair
         }
     }
 
+    if (CKR_OK == rv)
+    {
+        rv = pkcs11_object_index_rebuild();
+    }
+
     if (CKR_OK == rv)
     {
         pkcs11_object_get_handle(pPrivate, phPrivateKey);
@@ -1033,6 +1073,7 @@ static CK_RV pkcs11_key_derive_ca(pkcs11_session_ctx_ptr pSession, pkcs11_object
         pSecretKey->count = pkcs11_key_secret_attributes_count;
         pSecretKey->size = 32;
         pSecretKey->config = &((pkcs11_slot_ctx_ptr)pSession->slot)->cfg_zone;
+        pSecretKey->slot_ctx = pSession->slot;
         pSecretKey->flags = PKCS11_OBJECT_FLAG_DESTROYABLE | PKCS11_OBJECT_FLAG_SENSITIVE;
 #ifdef ATCA_NO_HEAP
         if (!pkcs11_key_used(pkcs11_key_cache, sizeof(pkcs11_key_cache)))
@@ -1049,6 +1090,7 @@ static CK_RV pkcs11_key_derive_ca(pkcs11_session_ctx_ptr pSession, pkcs11_object
 
         if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
         {
+            ATCADevice device = pSession->slot->device_ctx;
             ATCA_STATUS status = ATCA_SUCCESS;
 
             /* Because of the number of ECDH options this function unfortunately has a complex bit of logic
@@ -1059,11 +1101,11 @@ static CK_RV pkcs11_key_derive_ca(pkcs11_session_ctx_ptr pSession, pkcs11_object
             {
                 if (pSession->slot->logged_in)
                 {
-                    status = atcab_ecdh_tempkey_ioenc(&pEcdhParameters->pPublicData[1], pSecretKey->data, pSession->slot->read_key);
+                    status = calib_ecdh_tempkey_ioenc(device, &pEcdhParameters->pPublicData[1], pSecretKey->data, pSession->slot->read_key);
                 }
                 else
                 {
-                    status = atcab_ecdh_tempkey(&pEcdhParameters->pPublicData[1], pSecretKey->data);
+                    status = calib_ecdh_tempkey(device, &pEcdhParameters->pPublicData[1], pSecretKey->data);
                 }
             }
             else if (16 > pBaseKey->slot)
@@ -1072,18 +1114,18 @@ static CK_RV pkcs11_key_derive_ca(pkcs11_session_ctx_ptr pSession, pkcs11_object
                 {
                     uint16_t read_key_id = (ATCA_SLOT_CONFIG_READKEY_MASK & pSession->slot->cfg_zone.SlotConfig[pBaseKey->slot | 0x01])
                                            >> ATCA_SLOT_CONFIG_READKEY_SHIFT;
-                    status = atcab_ecdh_enc(pBaseKey->slot, &pEcdhParameters->pPublicData[1], pSecretKey->data,
+                    status = calib_ecdh_enc(device, pBaseKey->slot, &pEcdhParameters->pPublicData[1], pSecretKey->data,
                                             pSession->slot->read_key, read_key_id, NULL);
                 }
                 else if ((ATECC508A != pSession->slot->interface_config.devtype) &&
                          (ATCA_CHIP_OPT_IO_PROT_EN_MASK & pSession->slot->cfg_zone.ChipOptions) &&
                          pSession->slot->logged_in)
                 {
-                    status = atcab_ecdh_ioenc(pBaseKey->slot, &pEcdhParameters->pPublicData[1], pSecretKey->data, pSession->slot->read_key);
+                    status = calib_ecdh_ioenc(device, pBaseKey->slot, &pEcdhParameters->pPublicData[1], pSecretKey->data, pSession->slot->read_key);
                 }
                 else
                 {
-                    status = atcab_ecdh(pBaseKey->slot, &pEcdhParameters->pPublicData[1], pSecretKey->data);
+                    status = calib_ecdh(device, pBaseKey->slot, &pEcdhParameters->pPublicData[1], pSecretKey->data);
                 }
             }
             else
@@ -1209,12 +1251,17 @@ CK_RV pkcs11_key_derive
 
     if (CKR_OK == rv)
     {
-        if (atcab_is_ca_device(atcab_get_device_type()))
+        if (atcab_is_ca_device(atcab_get_device_type_ext(pSession->slot->device_ctx)))
         {
             rv = pkcs11_key_derive_ca(pSession, pBaseKey, pSecretKey, pEcdhParameters);
         }
     }
 
+    if (CKR_OK == rv)
+    {
+        rv = pkcs11_object_index_rebuild();
+    }
+
     if (CKR_OK == rv)
     {
         pkcs11_object_get_handle(pSecretKey, phKey);
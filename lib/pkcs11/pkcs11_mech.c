@@ -30,6 +30,7 @@
 #include "pkcs11_init.h"
 #include "pkcs11_mech.h"
 #include "pkcs11_slot.h"
+#include "pkcs11_signature.h"
 #include "cryptoauthlib.h"
 
 /**
@@ -99,6 +100,7 @@ static pcks11_mech_table_e pkcs11_mech_list_ecc508[] = {
     //CKM_SEED_CBC_ENCRYPT_DATA,
     { CKM_EC_KEY_PAIR_GEN,                                              { 0,   0,   CKF_HW | CKF_GENERATE | CKF_GENERATE_KEY_PAIR | PCKS11_MECH_ECC508_EC_CAPABILITY   } },
     { CKM_ECDSA,                                                        { 256, 256, CKF_HW | CKF_SIGN | CKF_VERIFY | PCKS11_MECH_ECC508_EC_CAPABILITY                  } },
+    { CKM_ATCA_ECDSA_BATCH,                                             { 256, 256, CKF_HW | CKF_SIGN | PCKS11_MECH_ECC508_EC_CAPABILITY                               } },
     { CKM_ECDSA_SHA256,                                                 { 256, 256, CKF_HW | CKF_SIGN | CKF_VERIFY | PCKS11_MECH_ECC508_EC_CAPABILITY                  } },
     { CKM_ECDH1_DERIVE,                                                 { 0,   0,   CKF_HW | CKF_DERIVE | PCKS11_MECH_ECC508_EC_CAPABILITY                             } },
     { CKM_ECDH1_COFACTOR_DERIVE,                                        { 0,   0,   CKF_HW | CKF_DERIVE | PCKS11_MECH_ECC508_EC_CAPABILITY                             } },
@@ -187,7 +189,8 @@ static pcks11_mech_table_e pkcs11_mech_list_ecc608[] = {
     //CKM_SEED_CBC_ENCRYPT_DATA,
     { CKM_EC_KEY_PAIR_GEN,                           { 256, 256, CKF_HW | CKF_GENERATE | CKF_GENERATE_KEY_PAIR | PCKS11_MECH_ECC508_EC_CAPABILITY } },
     { CKM_ECDSA,                                     { 256, 256, CKF_HW | CKF_SIGN | CKF_VERIFY | PCKS11_MECH_ECC508_EC_CAPABILITY                } },
-    //{ CKM_ECDSA_SHA256,{ 256, 256, CKF_HW | CKF_SIGN | CKF_VERIFY | PCKS11_MECH_ECC508_EC_CAPABILITY } },
+    { CKM_ATCA_ECDSA_BATCH,                          { 256, 256, CKF_HW | CKF_SIGN | PCKS11_MECH_ECC508_EC_CAPABILITY                             } },
+    { CKM_ECDSA_SHA256,                              { 256, 256, CKF_HW | CKF_SIGN | CKF_VERIFY | PCKS11_MECH_ECC508_EC_CAPABILITY                } },
     //{ CKM_ECDH1_DERIVE,{ 0,   0,   CKF_HW | CKF_DERIVE | PCKS11_MECH_ECC508_EC_CAPABILITY } },
     //{ CKM_ECDH1_COFACTOR_DERIVE,{ 0,   0,   CKF_HW | CKF_DERIVE | PCKS11_MECH_ECC508_EC_CAPABILITY } },
     //{ CKM_ECMQV_DERIVE,{ 0,   0,   CKF_HW | CKF_DERIVE | PCKS11_MECH_ECC508_EC_CAPABILITY } },
@@ -31,6 +31,7 @@
 #include "pkcs11_debug.h"
 #include "pkcs11_init.h"
 #include "pkcs11_session.h"
+#include "pkcs11_slot.h"
 #include "pkcs11_util.h"
 #include "pkcs11_object.h"
 #include "pkcs11_os.h"
@@ -49,6 +50,17 @@ static pkcs11_object pkcs11_object_store[PKCS11_MAX_OBJECTS_ALLOWED];
 
 pkcs11_object_cache_t pkcs11_object_cache[PKCS11_MAX_OBJECTS_ALLOWED];
 
+#if PKCS11_ATTRIB_CACHE_ENABLE
+static pkcs11_attrib_cache_stats pkcs11_object_attrib_stats;
+#endif
+
+/* Index of object table positions by label and by class. Each bucket holds a
+   chain of positions in ascending order ending with PKCS11_MAX_OBJECTS_ALLOWED */
+static CK_ULONG pkcs11_object_label_head[PKCS11_MAX_OBJECTS_ALLOWED];
+static CK_ULONG pkcs11_object_label_next[PKCS11_MAX_OBJECTS_ALLOWED];
+static CK_ULONG pkcs11_object_class_head[PKCS11_MAX_OBJECTS_ALLOWED];
+static CK_ULONG pkcs11_object_class_next[PKCS11_MAX_OBJECTS_ALLOWED];
+
 /** For object handle tracking */
 static CK_OBJECT_HANDLE pkcs11_object_alloc_handle(void)
 {
@@ -117,8 +129,172 @@ const CK_ULONG pkcs11_object_monotonic_attributes_count = PKCS11_UTIL_ARRAY_SIZE
 //
 //};
 
+static CK_ULONG pkcs11_object_index_hash(const CK_VOID_PTR pData, CK_ULONG ulLen)
+{
+    const CK_BYTE * data = (const CK_BYTE*)pData;
+    uint32_t hash = 2166136261u;
+
+    while (ulLen--)
+    {
+        hash ^= *data++;
+        hash *= 16777619u;
+    }
+    return (CK_ULONG)(hash % PKCS11_MAX_OBJECTS_ALLOWED);
+}
+
+/* The object table and its index are only changed or walked under the library
+   mutex once the library is initialized. While it initializes the caller
+   already holds the mutex and nothing else can reach the table. */
+static CK_RV pkcs11_object_table_lock(pkcs11_lib_ctx_ptr * ppContext)
+{
+    pkcs11_lib_ctx_ptr pContext = pkcs11_get_context();
+    CK_RV rv = CKR_OK;
+
+    *ppContext = NULL_PTR;
+
+    if (pContext && pContext->initialized)
+    {
+        if (!pContext->lock_mutex)
+        {
+            rv = CKR_CANT_LOCK;
+        }
+        else if (CKR_OK == (rv = pContext->lock_mutex(pContext->mutex)))
+        {
+            *ppContext = pContext;
+        }
+    }
+    return rv;
+}
+
+static void pkcs11_object_table_unlock(pkcs11_lib_ctx_ptr pContext)
+{
+    if (pContext)
+    {
+        (void)pContext->unlock_mutex(pContext->mutex);
+    }
+}
+
+static void pkcs11_object_index_build(void)
+{
+    CK_ULONG i;
+
+    for (i = 0; i < PKCS11_MAX_OBJECTS_ALLOWED; i++)
+    {
+        pkcs11_object_label_head[i] = PKCS11_MAX_OBJECTS_ALLOWED;
+        pkcs11_object_class_head[i] = PKCS11_MAX_OBJECTS_ALLOWED;
+    }
+
+    /* Inserting from the end keeps every chain in ascending order */
+    for (i = PKCS11_MAX_OBJECTS_ALLOWED; i--; )
+    {
+        pkcs11_object_ptr pObj = pkcs11_object_cache[i].object;
+
+        if (pObj)
+        {
+            CK_ULONG bucket = pkcs11_object_index_hash(pObj->name, (CK_ULONG)strlen((char*)pObj->name));
+
+            pkcs11_object_label_next[i] = pkcs11_object_label_head[bucket];
+            pkcs11_object_label_head[bucket] = i;
+
+            bucket = pkcs11_object_index_hash(&pObj->class_id, sizeof(pObj->class_id));
+            pkcs11_object_class_next[i] = pkcs11_object_class_head[bucket];
+            pkcs11_object_class_head[bucket] = i;
+        }
+    }
+}
+
+/**
+ * \brief Rebuild the label and class index of the object table.
+ *
+ * Objects are indexed when they are allocated or freed but are labelled
+ * afterwards so whoever labels an object rebuilds the index once it is done.
+ * Must not be called with the library mutex held after initialization.
+ */
+CK_RV pkcs11_object_index_rebuild(void)
+{
+    pkcs11_lib_ctx_ptr pContext;
+    CK_RV rv;
+
+    if (CKR_OK == (rv = pkcs11_object_table_lock(&pContext)))
+    {
+        pkcs11_object_index_build();
+        pkcs11_object_table_unlock(pContext);
+    }
+    return rv;
+}
+
+/**
+ * \brief Get the next object table position that could match the label or
+ * class in the template
+ *
+ * Only positions of objects with the same label hash (or class hash if the
+ * template has no label) are returned so the caller must still compare the
+ * template against the object. The index is only read here - it is kept
+ * current by the functions that change the object table.
+ *
+ * \param[in] pTemplate  Search template
+ * \param[in] ulCount    Number of attributes in the template
+ * \param[in] index      First table position to consider
+ * \return Table position or PKCS11_MAX_OBJECTS_ALLOWED if there are no more
+ */
+CK_ULONG pkcs11_object_index_next(const CK_ATTRIBUTE_PTR pTemplate, CK_ULONG ulCount, CK_ULONG index)
+{
+    CK_ATTRIBUTE_PTR pLabel = NULL_PTR;
+    CK_ATTRIBUTE_PTR pClass = NULL_PTR;
+    const CK_ULONG * next = NULL;
+    pkcs11_lib_ctx_ptr pContext;
+    CK_ULONG i;
+
+    for (i = 0; pTemplate && i < ulCount; i++)
+    {
+        if (CKA_LABEL == pTemplate[i].type && pTemplate[i].pValue)
+        {
+            pLabel = &pTemplate[i];
+        }
+        else if (CKA_CLASS == pTemplate[i].type && pTemplate[i].pValue && sizeof(CK_OBJECT_CLASS) == pTemplate[i].ulValueLen)
+        {
+            pClass = &pTemplate[i];
+        }
+    }
+
+    if (CKR_OK != pkcs11_object_table_lock(&pContext))
+    {
+        return PKCS11_MAX_OBJECTS_ALLOWED;
+    }
+
+    if (pLabel)
+    {
+        i = pkcs11_object_label_head[pkcs11_object_index_hash(pLabel->pValue, pLabel->ulValueLen)];
+        next = pkcs11_object_label_next;
+    }
+    else if (pClass)
+    {
+        i = pkcs11_object_class_head[pkcs11_object_index_hash(pClass->pValue, pClass->ulValueLen)];
+        next = pkcs11_object_class_next;
+    }
+    else
+    {
+        /* Nothing indexed to search on so every object is a candidate */
+        i = index;
+        while (i < PKCS11_MAX_OBJECTS_ALLOWED && !pkcs11_object_cache[i].object)
+        {
+            i++;
+        }
+    }
+
+    while (next && i < index)
+    {
+        i = next[i];
+    }
+
+    pkcs11_object_table_unlock(pContext);
+
+    return i;
+}
+
 CK_RV pkcs11_object_alloc(pkcs11_object_ptr * ppObject)
 {
+    pkcs11_lib_ctx_ptr pContext = NULL_PTR;
     CK_ULONG i;
     CK_RV rv = CKR_OK;
 
@@ -129,6 +305,7 @@ CK_RV pkcs11_object_alloc(pkcs11_object_ptr * ppObject)
     else
     {
         *ppObject = NULL;
+        rv = pkcs11_object_table_lock(&pContext);
     }
 
     for (i = 0; i < PKCS11_MAX_OBJECTS_ALLOWED && CKR_OK == rv; i++)
@@ -145,6 +322,7 @@ CK_RV pkcs11_object_alloc(pkcs11_object_ptr * ppObject)
                 memset(*ppObject, 0, sizeof(pkcs11_object));
                 pkcs11_object_cache[i].handle = pkcs11_object_alloc_handle();
                 pkcs11_object_cache[i].object = *ppObject;
+                pkcs11_object_index_build();
             }
             else
             {
@@ -160,12 +338,21 @@ CK_RV pkcs11_object_alloc(pkcs11_object_ptr * ppObject)
         rv = CKR_HOST_MEMORY;
     }
 
+    pkcs11_object_table_unlock(pContext);
+
     return rv;
 }
 
 CK_RV pkcs11_object_free(pkcs11_object_ptr pObject)
 {
+    pkcs11_lib_ctx_ptr pContext;
     CK_ULONG i;
+    CK_RV rv;
+
+    if (CKR_OK != (rv = pkcs11_object_table_lock(&pContext)))
+    {
+        return rv;
+    }
 
     for (i = 0; i < PKCS11_MAX_OBJECTS_ALLOWED; i++)
     {
@@ -176,9 +363,15 @@ CK_RV pkcs11_object_free(pkcs11_object_ptr pObject)
             pkcs11_object_cache[i].handle = 0;
         }
     }
+    pkcs11_object_index_build();
+
+    pkcs11_object_table_unlock(pContext);
 
     if (pObject)
     {
+#if PKCS11_ATTRIB_CACHE_ENABLE
+        pkcs11_object_cache_clear_attribs(pObject);
+#endif
 #if ATCA_CA_SUPPORT
         if (pObject->data)
         {
@@ -258,6 +451,156 @@ CK_RV pkcs11_object_get_handle(pkcs11_object_ptr pObject, CK_OBJECT_HANDLE_PTR p
     return CKR_OK;
 }
 
+#if PKCS11_ATTRIB_CACHE_ENABLE
+/* The cached values, like the statistics, are only touched with the library
+   context locked (pkcs11_lock_context) - attribute functions get it from
+   pkcs11_find_get_value and writes take it around the invalidation */
+
+/**
+ * \brief Look up an attribute value previously read from the device. The
+ * caller must hold pkcs11_lock_context for as long as it uses the value.
+ *
+ * \param[in]  pObject  Object the attribute belongs to
+ * \param[in]  type     Attribute type the value was stored under
+ * \param[out] ppValue  Set to the cached value which remains owned by the
+ *                      object and is freed when the object is invalidated
+ * \param[out] pulLen   Set to the length of the cached value
+ * \return TRUE if the value was cached
+ */
+CK_BBOOL pkcs11_object_cache_get_attrib(pkcs11_object_ptr pObject, CK_ATTRIBUTE_TYPE type, CK_VOID_PTR * ppValue, CK_ULONG_PTR pulLen)
+{
+    pkcs11_attrib_cache_ptr entry;
+
+    if (!pObject || !ppValue || !pulLen)
+    {
+        return FALSE;
+    }
+
+    for (entry = pObject->attrib_cache; entry; entry = entry->next)
+    {
+        if (type == entry->type)
+        {
+            *ppValue = entry->value;
+            *pulLen = entry->len;
+            pkcs11_object_attrib_stats.hits++;
+            return TRUE;
+        }
+    }
+
+    pkcs11_object_attrib_stats.misses++;
+    return FALSE;
+}
+
+/**
+ * \brief Keep a copy of an attribute value read from the device with the object.
+ * The caller must hold pkcs11_lock_context.
+ */
+CK_RV pkcs11_object_cache_put_attrib(pkcs11_object_ptr pObject, CK_ATTRIBUTE_TYPE type, const CK_VOID_PTR pValue, CK_ULONG ulLen)
+{
+    pkcs11_attrib_cache_ptr entry;
+
+    if (!pObject || !pValue || !ulLen)
+    {
+        return CKR_ARGUMENTS_BAD;
+    }
+
+    if (NULL == (entry = pkcs11_os_malloc(sizeof(pkcs11_attrib_cache) + ulLen)))
+    {
+        return CKR_HOST_MEMORY;
+    }
+
+    entry->type = type;
+    entry->len = ulLen;
+    memcpy(entry->value, pValue, ulLen);
+    entry->next = pObject->attrib_cache;
+    pObject->attrib_cache = entry;
+
+    return CKR_OK;
+}
+
+/**
+ * \brief Drop every cached attribute value of the object. The caller must hold
+ * pkcs11_lock_context unless the object can't be reached by any other thread.
+ */
+void pkcs11_object_cache_clear_attribs(pkcs11_object_ptr pObject)
+{
+    if (pObject)
+    {
+        while (pObject->attrib_cache)
+        {
+            pkcs11_attrib_cache_ptr entry = pObject->attrib_cache;
+            pObject->attrib_cache = entry->next;
+            pkcs11_os_free(entry);
+        }
+    }
+}
+
+/**
+ * \brief Get the number of cached attribute lookups that were served from
+ * memory (hits) and from the device (misses)
+ */
+void pkcs11_object_cache_get_stats(pkcs11_attrib_cache_stats * pStats)
+{
+    pkcs11_lib_ctx_ptr pContext;
+
+    if (pStats && CKR_OK == pkcs11_object_table_lock(&pContext))
+    {
+        *pStats = pkcs11_object_attrib_stats;
+        pkcs11_object_table_unlock(pContext);
+    }
+}
+
+void pkcs11_object_cache_reset_stats(void)
+{
+    pkcs11_lib_ctx_ptr pContext;
+
+    if (CKR_OK == pkcs11_object_table_lock(&pContext))
+    {
+        memset(&pkcs11_object_attrib_stats, 0, sizeof(pkcs11_object_attrib_stats));
+        pkcs11_object_table_unlock(pContext);
+    }
+}
+#endif
+
+/**
+ * \brief Drop the cached attribute values of an object whose device contents
+ * changed along with those of every other object backed by the same device slot
+ * (e.g. the public key object paired with a private key). Certificates on the
+ * device are rebuilt from several slots, such as the signer public key, so
+ * their values are dropped on any write to the device. The caller must hold
+ * pkcs11_lock_context.
+ */
+void pkcs11_object_cache_invalidate(pkcs11_object_ptr pObject)
+{
+#if PKCS11_ATTRIB_CACHE_ENABLE
+    CK_ULONG i;
+
+    if (!pObject)
+    {
+        return;
+    }
+
+    for (i = 0; i < PKCS11_MAX_OBJECTS_ALLOWED; i++)
+    {
+        pkcs11_object_ptr pObj = pkcs11_object_cache[i].object;
+
+        if (pObj && pObj != pObject && (pObj->slot == pObject->slot || CKO_CERTIFICATE == pObj->class_id))
+        {
+#if ATCA_CA_SUPPORT
+            if (pObj->config != pObject->config)
+            {
+                continue;
+            }
+#endif
+            pkcs11_object_cache_clear_attribs(pObj);
+        }
+    }
+    pkcs11_object_cache_clear_attribs(pObject);
+#else
+    ((void)pObject);
+#endif
+}
+
 
 CK_RV pkcs11_object_get_name(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAttribute)
 {
@@ -383,7 +726,7 @@ CK_RV pkcs11_object_find(pkcs11_object_ptr * ppObject, CK_ATTRIBUTE_PTR pTemplat
 
     if (pName)
     {
-        for (i = 0; i < PKCS11_MAX_OBJECTS_ALLOWED; i++)
+        for (i = pkcs11_object_index_next(pName, 1, 0); i < PKCS11_MAX_OBJECTS_ALLOWED; i = pkcs11_object_index_next(pName, 1, i + 1))
         {
             pkcs11_object_ptr pObj = pkcs11_object_cache[i].object;
             if (pObj)
@@ -475,6 +818,8 @@ CK_RV pkcs11_object_create
 
     if (pObject)
     {
+        pObject->slot_ctx = pSession->slot;
+
         switch (*pClass)
         {
         case CKO_CERTIFICATE:
@@ -510,6 +855,10 @@ CK_RV pkcs11_object_create
             break;
         }
         if (CKR_OK == rv)
+        {
+            rv = pkcs11_object_index_rebuild();
+        }
+        if (CKR_OK == rv)
         {
             rv = pkcs11_object_get_handle(pObject, phObject);
         }
@@ -588,7 +937,7 @@ CK_RV pkcs11_object_deinit(pkcs11_lib_ctx_ptr pContext)
 }
 
 #if ATCA_TA_SUPPORT
-CK_RV pkcs11_object_load_handle_info(pkcs11_lib_ctx_ptr pContext)
+CK_RV pkcs11_object_load_handle_info(pkcs11_slot_ctx_ptr pSlot)
 {
     CK_RV rv = CKR_OK;
     uint8_t handle_info[TA_HANDLE_INFO_SIZE];
@@ -596,10 +945,10 @@ CK_RV pkcs11_object_load_handle_info(pkcs11_lib_ctx_ptr pContext)
     for (int i = 0; i < PKCS11_MAX_OBJECTS_ALLOWED; i++)
     {
         pkcs11_object_ptr pObj = pkcs11_object_cache[i].object;
-        if (pObj)
+        if (pObj && pSlot == pObj->slot_ctx)
         {
             pObj->flags |= PKCS11_OBJECT_FLAG_TA_TYPE;
-            if (ATCA_SUCCESS == talib_info_get_handle_info(atcab_get_device(), pObj->slot, handle_info))
+            if (ATCA_SUCCESS == talib_info_get_handle_info(pSlot->device_ctx, pObj->slot, handle_info))
             {
                 memcpy(&pObj->handle_info, handle_info, sizeof(ta_element_attributes_t));
             }
@@ -615,6 +964,17 @@ CK_RV pkcs11_object_load_handle_info(pkcs11_lib_ctx_ptr pContext)
 #endif
 
 
+/** \brief Get the device of the token the object is stored on. Objects not
+    bound to a slot belong to the first slot which uses the global device */
+ATCADevice pkcs11_object_get_device(pkcs11_object_ptr pObject)
+{
+    if (pObject && pObject->slot_ctx)
+    {
+        return pObject->slot_ctx->device_ctx;
+    }
+    return atcab_get_device();
+}
+
 /** \brief Checks the attributes of the underlying cryptographic asset to
     determine if it is a private key - this changes the way the associated
     public key is referenced */
@@ -624,7 +984,7 @@ CK_RV pkcs11_object_is_private(pkcs11_object_ptr pObject, CK_BBOOL * is_private)
 
     if (pObject && is_private)
     {
-        ATCADeviceType dev_type = atcab_get_device_type();
+        ATCADeviceType dev_type = atcab_get_device_type_ext(pkcs11_object_get_device(pObject));
 
         *is_private = false;
         rv = CKR_GENERAL_ERROR;
@@ -38,6 +38,30 @@
 extern "C" {
 #endif
 
+/* Cached attribute values are allocated as they are read */
+#ifdef ATCA_NO_HEAP
+#undef PKCS11_ATTRIB_CACHE_ENABLE
+#define PKCS11_ATTRIB_CACHE_ENABLE      0
+#endif
+
+#if PKCS11_ATTRIB_CACHE_ENABLE
+/** An attribute value read from the device and kept with its object */
+typedef struct _pkcs11_attrib_cache
+{
+    struct _pkcs11_attrib_cache * next;
+    CK_ATTRIBUTE_TYPE             type;
+    CK_ULONG                      len;
+    CK_BYTE                       value[1];
+} pkcs11_attrib_cache, *pkcs11_attrib_cache_ptr;
+
+/** Counts of attribute lookups served from memory and from the device */
+typedef struct _pkcs11_attrib_cache_stats
+{
+    CK_ULONG hits;
+    CK_ULONG misses;
+} pkcs11_attrib_cache_stats;
+#endif
+
 typedef struct _pkcs11_object
 {
     /** The Class Identifier */
@@ -51,6 +75,8 @@ typedef struct _pkcs11_object
     CK_ULONG    size;
     uint16_t    slot;
     CK_FLAGS    flags;
+    /** Slot of the token holding the object */
+    pkcs11_slot_ctx_ptr slot_ctx;
     CK_UTF8CHAR name[PKCS11_MAX_LABEL_SIZE + 1];
 #if ATCA_CA_SUPPORT
     CK_VOID_PTR config;
@@ -59,6 +85,10 @@ typedef struct _pkcs11_object
 #if ATCA_TA_SUPPORT
     ta_element_attributes_t handle_info;
 #endif
+#if PKCS11_ATTRIB_CACHE_ENABLE
+    /** Attribute values already read from the device */
+    pkcs11_attrib_cache_ptr attrib_cache;
+#endif
 } pkcs11_object, *pkcs11_object_ptr;
 
 typedef struct _pkcs11_object_cache_t
@@ -86,6 +116,7 @@ CK_RV pkcs11_object_free(pkcs11_object_ptr pObject);
 CK_RV pkcs11_object_check(pkcs11_object_ptr * ppObject, CK_OBJECT_HANDLE handle);
 CK_RV pkcs11_object_find(pkcs11_object_ptr * ppObject, CK_ATTRIBUTE_PTR pTemplate, CK_ULONG ulCount);
 CK_RV pkcs11_object_is_private(pkcs11_object_ptr pObject, CK_BBOOL* is_private);
+ATCADevice pkcs11_object_get_device(pkcs11_object_ptr pObject);
 
 CK_RV pkcs11_object_get_class(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAttribute);
 CK_RV pkcs11_object_get_name(CK_VOID_PTR pObject, CK_ATTRIBUTE_PTR pAttribute);
@@ -99,8 +130,20 @@ CK_RV pkcs11_object_destroy(CK_SESSION_HANDLE hSession, CK_OBJECT_HANDLE hObject
 
 CK_RV pkcs11_object_deinit(pkcs11_lib_ctx_ptr pContext);
 
+CK_RV pkcs11_object_index_rebuild(void);
+CK_ULONG pkcs11_object_index_next(const CK_ATTRIBUTE_PTR pTemplate, CK_ULONG ulCount, CK_ULONG index);
+
+#if PKCS11_ATTRIB_CACHE_ENABLE
+CK_BBOOL pkcs11_object_cache_get_attrib(pkcs11_object_ptr pObject, CK_ATTRIBUTE_TYPE type, CK_VOID_PTR * ppValue, CK_ULONG_PTR pulLen);
+CK_RV pkcs11_object_cache_put_attrib(pkcs11_object_ptr pObject, CK_ATTRIBUTE_TYPE type, const CK_VOID_PTR pValue, CK_ULONG ulLen);
+void pkcs11_object_cache_clear_attribs(pkcs11_object_ptr pObject);
+void pkcs11_object_cache_get_stats(pkcs11_attrib_cache_stats * pStats);
+void pkcs11_object_cache_reset_stats(void);
+#endif
+void pkcs11_object_cache_invalidate(pkcs11_object_ptr pObject);
+
 #if ATCA_TA_SUPPORT
-CK_RV pkcs11_object_load_handle_info(pkcs11_lib_ctx_ptr pContext);
+CK_RV pkcs11_object_load_handle_info(pkcs11_slot_ctx_ptr pSlot);
 #endif
 
 #ifdef __cplusplus
@@ -28,6 +28,8 @@
 #include "pkcs11_os.h"
 #include "pkcs11_util.h"
 
+#include <stdio.h>
+
 /**
  * \defgroup pkcs11 OS Abstraction (pkcs11_so_)
    @{ */
@@ -50,6 +52,20 @@ CK_RV pkcs11_os_create_mutex(CK_VOID_PTR_PTR ppMutex)
     return pkcs11_os_convert_rv(hal_create_mutex(ppMutex, "atpkcs11"));
 }
 
+/**
+ * \brief Create the mutex of a slot. Each slot has its own name so processes
+ * using the same device exclude each other while different devices don't.
+ * \param[in,out] ppMutex location to receive ptr to mutex
+ * \param[in]     slotID  slot the mutex protects
+ */
+CK_RV pkcs11_os_create_slot_mutex(CK_VOID_PTR_PTR ppMutex, CK_SLOT_ID slotID)
+{
+    char name[24];
+
+    (void)snprintf(name, sizeof(name), "atpkcs11_slot%u", (unsigned int)slotID);
+    return pkcs11_os_convert_rv(hal_create_mutex(ppMutex, name));
+}
+
 /*
  * \brief Application callback for destroying a mutex object
  * \param[IN] pMutex pointer to mutex
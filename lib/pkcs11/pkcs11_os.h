@@ -32,6 +32,7 @@
 #include "cryptoauthlib.h"
 
 CK_RV pkcs11_os_create_mutex(CK_VOID_PTR_PTR ppMutex);
+CK_RV pkcs11_os_create_slot_mutex(CK_VOID_PTR_PTR ppMutex, CK_SLOT_ID slotID);
 CK_RV pkcs11_os_destroy_mutex(CK_VOID_PTR pMutex);
 CK_RV pkcs11_os_lock_mutex(CK_VOID_PTR pMutex);
 CK_RV pkcs11_os_unlock_mutex(CK_VOID_PTR pMutex);
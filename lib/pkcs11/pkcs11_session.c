@@ -31,6 +31,8 @@
 
 #include "pkcs11_config.h"
 #include "pkcs11_debug.h"
+#include "pkcs11_digest.h"
+#include "pkcs11_signature.h"
 #include "pkcs11_session.h"
 #include "pkcs11_token.h"
 #include "pkcs11_init.h"
@@ -233,6 +235,7 @@ CK_RV pkcs11_session_open(
     }
 
     /* Initialize the session */
+    (void)pkcs11_util_memset(session_ctx, sizeof(pkcs11_session_ctx), 0, sizeof(pkcs11_session_ctx));
     session_ctx->slot = slot_ctx;
     session_ctx->initialized = TRUE;
     session_ctx->active_mech = CKM_VENDOR_DEFINED;
@@ -250,6 +253,7 @@ CK_RV pkcs11_session_close(CK_SESSION_HANDLE hSession)
     pkcs11_lib_ctx_ptr lib_ctx = pkcs11_get_context();
     pkcs11_session_ctx_ptr session_ctx = pkcs11_get_session_context(hSession);
     pkcs11_slot_ctx_ptr slot_ctx;
+    CK_RV lock_rv;
 
     if (!lib_ctx || !lib_ctx->initialized)
     {
@@ -279,6 +283,16 @@ CK_RV pkcs11_session_close(CK_SESSION_HANDLE hSession)
            that would be a pkcs11_slot_* function to find a slot given a session */
     }
 
+    /* End any operation holding resources beyond the session - the owners of
+       the device SHA engine are guarded by the slot lock */
+    lock_rv = slot_ctx ? pkcs11_lock_device(lib_ctx, slot_ctx) : CKR_SLOT_ID_INVALID;
+    pkcs11_digest_session_close(session_ctx);
+    pkcs11_signature_session_close(session_ctx);
+    if (CKR_OK == lock_rv)
+    {
+        (void)pkcs11_unlock_device(lib_ctx, slot_ctx);
+    }
+
     /* Free the session */
     (void)pkcs11_session_free_session_context(session_ctx);
 
@@ -410,33 +424,33 @@ CK_RV pkcs11_session_login(CK_SESSION_HANDLE hSession, CK_USER_TYPE userType, CK
         {
             uint8_t sn[ATCA_SERIAL_NUM_SIZE];
 
-            if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_read_serial_number(sn))))
+            if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_read_serial_number_ext(session_ctx->slot->device_ctx, sn))))
             {
                 rv = pkcs11_token_convert_pin_to_key(pPin, ulPinLen, sn, (CK_LONG)sizeof(sn), session_ctx->slot->read_key, key_len);
             }
         }
 
 #if ATCA_TA_SUPPORT
-        if (CKR_OK == rv && atcab_is_ta_device(atcab_get_device_type()))
+        if (CKR_OK == rv && atcab_is_ta_device(atcab_get_device_type_ext(session_ctx->slot->device_ctx)))
         {
             uint8_t auth_i_nonce[16];
             uint8_t auth_r_nonce[16];
 
             (void)atcac_sw_random(auth_r_nonce, sizeof(auth_r_nonce));
 
-            status = talib_auth_generate_nonce(_gDevice, 0x4100,
+            status = talib_auth_generate_nonce(session_ctx->slot->device_ctx, 0x4100,
                                                TA_AUTH_GENERATE_OPT_NONCE_SRC_MASK | TA_AUTH_GENERATE_OPT_RANDOM_MASK, auth_i_nonce);
 
             if (CKR_OK == (rv = pkcs11_util_convert_rv(status)))
             {
-                status = talib_auth_startup(atcab_get_device(), session_ctx->slot->user_pin_handle,
+                status = talib_auth_startup(session_ctx->slot->device_ctx, session_ctx->slot->user_pin_handle,
                                             TA_AUTH_ALG_ID_GCM, 0x1FFF, 16, session_ctx->slot->read_key, auth_i_nonce, auth_r_nonce);
                 rv = pkcs11_util_convert_rv(status);
             }
 
             if (CKR_OK != rv)
             {
-                (void)talib_auth_terminate(atcab_get_device());
+                (void)talib_auth_terminate(session_ctx->slot->device_ctx);
             }
         }
 #endif
@@ -473,9 +487,9 @@ CK_RV pkcs11_session_logout(CK_SESSION_HANDLE hSession)
     }
 
 #if ATCA_TA_SUPPORT
-    if (session_ctx->slot->logged_in && atcab_is_ta_device(atcab_get_device_type()))
+    if (session_ctx->slot->logged_in && atcab_is_ta_device(atcab_get_device_type_ext(session_ctx->slot->device_ctx)))
     {
-        (void)talib_auth_terminate(atcab_get_device());
+        (void)talib_auth_terminate(session_ctx->slot->device_ctx);
     }
 #endif
 
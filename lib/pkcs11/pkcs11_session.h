@@ -30,6 +30,8 @@
 
 #include "cryptoki.h"
 #include "pkcs11_config.h"
+#include "cryptoauthlib.h"
+#include "crypto/atca_crypto_sw_sha2.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,8 +44,13 @@ typedef union _pkcs11_session_mech_ctx
     struct
     {
         atca_hmac_sha256_ctx_t context;
+        CK_BBOOL               started;     /**< Multi-part HMAC is running in the device SHA engine */
     } hmac;
     struct
+    {
+        atcac_sha2_256_ctx context;         /**< Message hashed in software ahead of signing with the device */
+    } sha256;
+    struct
     {
         atca_aes_cmac_ctx_t context;
     } cmac;
@@ -54,6 +61,21 @@ typedef union _pkcs11_session_mech_ctx
     } gcm;
 } pkcs11_session_mech_ctx, *pkcs11_session_mech_ctx_ptr;
 
+/** Digest operation of a session - held apart from the active mechanism since
+    it runs independently of the other operations */
+typedef struct _pkcs11_session_digest_ctx
+{
+    CK_BBOOL           active;
+#if PKCS11_HARDWARE_SHA256
+    CK_BBOOL           started;                             /**< The device engine has been started for this digest */
+    atca_sha256_ctx_t  context;                             /**< Message not yet passed to the device */
+    uint8_t            engine[SHA_CONTEXT_MAX_SIZE];        /**< Device engine context saved while another session uses it */
+    uint16_t           engine_size;
+#else
+    atcac_sha2_256_ctx context;
+#endif
+} pkcs11_session_digest_ctx;
+
 /** Session Context */
 typedef struct _pkcs11_session_ctx
 {
@@ -69,6 +91,7 @@ typedef struct _pkcs11_session_ctx
     CK_OBJECT_HANDLE        active_object;
     CK_MECHANISM_TYPE       active_mech;
     pkcs11_session_mech_ctx active_mech_data;
+    pkcs11_session_digest_ctx digest;
 } pkcs11_session_ctx, *pkcs11_session_ctx_ptr;
 
 #ifdef __cplusplus
@@ -27,10 +27,12 @@
 
 #include "pkcs11_config.h"
 #include "pkcs11_debug.h"
+#include "pkcs11_digest.h"
 #include "pkcs11_init.h"
 #include "pkcs11_signature.h"
 #include "pkcs11_object.h"
 #include "pkcs11_session.h"
+#include "pkcs11_slot.h"
 #include "pkcs11_util.h"
 #include "cryptoauthlib.h"
 
@@ -40,6 +42,261 @@
  * \defgroup pkcs11 Signature (pkcs11_signature_)
    @{ */
 
+/**
+ * \brief Start a sign or verify operation, preparing the state the mechanism
+ * keeps between the parts of the message
+ */
+static CK_RV pkcs11_signature_start(pkcs11_session_ctx_ptr pSession, CK_MECHANISM_PTR pMechanism, CK_OBJECT_HANDLE hKey)
+{
+    CK_RV rv = CKR_OK;
+
+    if (CKM_VENDOR_DEFINED != pSession->active_mech)
+    {
+        return CKR_OPERATION_ACTIVE;
+    }
+
+    switch (pMechanism->mechanism)
+    {
+    case CKM_ECDSA_SHA256:
+        /* The message is hashed on the host and only the digest is signed by the device */
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_init(&pSession->active_mech_data.sha256.context));
+        break;
+    case CKM_SHA256_HMAC:
+        /* The device engine is claimed once the first part arrives */
+        pSession->active_mech_data.hmac.started = FALSE;
+        break;
+    default:
+        break;
+    }
+
+    if (CKR_OK == rv)
+    {
+        pSession->active_object = hKey;
+        pSession->active_mech = pMechanism->mechanism;
+    }
+
+    return rv;
+}
+
+/**
+ * \brief End the sign or verify operation of a session and release the device
+ * SHA engine if a multi-part HMAC was holding it
+ */
+static void pkcs11_signature_end(pkcs11_session_ctx_ptr pSession)
+{
+    pkcs11_slot_ctx_ptr pSlot = pSession->slot;
+
+    if (pSlot && pSlot->hmac_owner == pSession)
+    {
+        pSlot->hmac_owner = NULL;
+    }
+    pSession->active_mech = CKM_VENDOR_DEFINED;
+}
+
+/**
+ * \brief Make the device SHA engine available to an HMAC of the session. Must
+ * be called with the slot locked.
+ */
+static CK_RV pkcs11_signature_claim_engine(pkcs11_session_ctx_ptr pSession)
+{
+    pkcs11_slot_ctx_ptr pSlot = pSession->slot;
+
+    /* The engine context of an HMAC can't be read back so the session that
+       started one keeps the engine until it finishes */
+    if (pSlot->hmac_owner && pSlot->hmac_owner != pSession)
+    {
+        return CKR_OPERATION_ACTIVE;
+    }
+
+#if PKCS11_HARDWARE_SHA256
+    return pkcs11_digest_evict(pSlot);
+#else
+    return CKR_OK;
+#endif
+}
+
+/**
+ * \brief Start a multi-part HMAC in the device SHA engine if it is not already
+ * running. Must be called with the slot locked.
+ */
+static CK_RV pkcs11_signature_hmac_start(pkcs11_session_ctx_ptr pSession, pkcs11_object_ptr pKey)
+{
+    pkcs11_session_mech_ctx_ptr pCtx = &pSession->active_mech_data;
+    CK_RV rv = CKR_OK;
+
+    if (!pCtx->hmac.started)
+    {
+        if (CKR_OK == (rv = pkcs11_signature_claim_engine(pSession)))
+        {
+            rv = pkcs11_util_convert_rv(atcab_sha_hmac_init_ext(pSession->slot->device_ctx, &pCtx->hmac.context, pKey->slot));
+        }
+        if (CKR_OK == rv)
+        {
+            pSession->slot->hmac_owner = pSession;
+            pCtx->hmac.started = TRUE;
+        }
+    }
+
+    return rv;
+}
+
+/**
+ * \brief Size of the signature or MAC produced by a mechanism
+ */
+static CK_ULONG pkcs11_signature_size(CK_MECHANISM_TYPE mechanism)
+{
+    return (CKM_SHA256_HMAC == mechanism) ? ATCA_SHA256_DIGEST_SIZE : ATCA_SIG_SIZE;
+}
+
+/**
+ * \brief Pass the next part of the message to a multi-part operation
+ */
+static CK_RV pkcs11_signature_update(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULONG ulPartLen)
+{
+    pkcs11_lib_ctx_ptr pLibCtx = NULL;
+    pkcs11_session_ctx_ptr pSession;
+    pkcs11_object_ptr pKey;
+    CK_RV rv;
+
+    rv = pkcs11_init_check(&pLibCtx, FALSE);
+    if (rv)
+    {
+        return rv;
+    }
+
+    rv = pkcs11_session_check(&pSession, hSession);
+    if (rv)
+    {
+        return rv;
+    }
+
+    if (CKM_VENDOR_DEFINED == pSession->active_mech)
+    {
+        return CKR_OPERATION_NOT_INITIALIZED;
+    }
+
+    rv = pkcs11_object_check(&pKey, pSession->active_object);
+    if (rv)
+    {
+        return rv;
+    }
+
+    if (!pPart && ulPartLen)
+    {
+        pkcs11_signature_end(pSession);
+        return CKR_ARGUMENTS_BAD;
+    }
+
+    switch (pSession->active_mech)
+    {
+    case CKM_ECDSA_SHA256:
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_update(&pSession->active_mech_data.sha256.context, pPart, ulPartLen));
+        break;
+    case CKM_SHA256_HMAC:
+        if (CKR_OK != (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
+        {
+            break;
+        }
+        if (CKR_OK == (rv = pkcs11_signature_hmac_start(pSession, pKey)))
+        {
+            rv = pkcs11_util_convert_rv(atcab_sha_hmac_update_ext(pSession->slot->device_ctx, &pSession->active_mech_data.hmac.context, pPart, ulPartLen));
+        }
+        (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
+        break;
+    default:
+        /* Remaining mechanisms operate on a digest provided in a single part */
+        rv = CKR_FUNCTION_NOT_SUPPORTED;
+        break;
+    }
+
+    if (CKR_OK != rv)
+    {
+        pkcs11_signature_end(pSession);
+    }
+
+    return rv;
+}
+
+/**
+ * \brief Complete the message of a multi-part operation, producing either the
+ * digest to sign or verify or the HMAC. Must be called with the slot
+ * locked.
+ */
+static CK_RV pkcs11_signature_final(pkcs11_session_ctx_ptr pSession, pkcs11_object_ptr pKey, uint8_t* digest)
+{
+    CK_RV rv;
+
+    switch (pSession->active_mech)
+    {
+    case CKM_ECDSA_SHA256:
+        rv = pkcs11_util_convert_rv(atcac_sw_sha2_256_finish(&pSession->active_mech_data.sha256.context, digest));
+        break;
+    case CKM_SHA256_HMAC:
+        /* An empty message never started the engine */
+        if (CKR_OK == (rv = pkcs11_signature_hmac_start(pSession, pKey)))
+        {
+            rv = pkcs11_util_convert_rv(atcab_sha_hmac_finish_ext(pSession->slot->device_ctx, &pSession->active_mech_data.hmac.context, digest, SHA_MODE_TARGET_OUT_ONLY));
+        }
+        break;
+    default:
+        rv = CKR_FUNCTION_NOT_SUPPORTED;
+        break;
+    }
+
+    return rv;
+}
+
+/**
+ * \brief Check a signature or HMAC against the digest or HMAC computed for
+ * the message. Must be called with the slot locked.
+ */
+static CK_RV pkcs11_signature_check(pkcs11_session_ctx_ptr pSession, pkcs11_object_ptr pKey, uint8_t* digest, CK_BYTE_PTR pSignature)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    CK_BBOOL is_private;
+    bool verified = FALSE;
+    CK_RV rv;
+
+    if (CKM_SHA256_HMAC == pSession->active_mech)
+    {
+        return memcmp(pSignature, digest, ATCA_SHA256_DIGEST_SIZE) ? CKR_SIGNATURE_INVALID : CKR_OK;
+    }
+
+    if (CKR_OK != (rv = pkcs11_object_is_private(pKey, &is_private)))
+    {
+        return rv;
+    }
+
+    if (is_private)
+    {
+        /* Device can't verify against a private key so ask the device for
+            the public key first then perform an external verify */
+        uint8_t pub_key[ATCA_ECCP256_PUBKEY_SIZE];
+
+        if (ATCA_SUCCESS == (status = atcab_get_pubkey_ext(pSession->slot->device_ctx, pKey->slot, pub_key)))
+        {
+            status = atcab_verify_extern_ext(pSession->slot->device_ctx, digest, pSignature, pub_key, &verified);
+        }
+    }
+    else
+    {
+        /* Assume Public Key has been stored properly and verify against
+            whatever is stored */
+        status = atcab_verify_stored_ext(pSession->slot->device_ctx, digest, pSignature, pKey->slot, &verified);
+    }
+
+    if (ATCA_SUCCESS == status)
+    {
+        rv = verified ? CKR_OK : CKR_SIGNATURE_INVALID;
+    }
+    else
+    {
+        rv = CKR_DEVICE_ERROR;
+    }
+
+    return rv;
+}
+
 /**
  * \brief Initialize a signing operation using the specified key and mechanism
  */
@@ -72,17 +329,7 @@ CK_RV pkcs11_signature_sign_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR pM
         return rv;
     }
 
-    if (CKM_VENDOR_DEFINED == pSession->active_mech)
-    {
-        pSession->active_object = hKey;
-        pSession->active_mech = pMechanism->mechanism;
-    }
-    else
-    {
-        rv = CKR_OPERATION_ACTIVE;
-    }
-
-    return rv;
+    return pkcs11_signature_start(pSession, pMechanism, hKey);
 }
 
 /**
@@ -94,9 +341,7 @@ CK_RV pkcs11_signature_sign(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_UL
     pkcs11_session_ctx_ptr pSession;
     pkcs11_object_ptr pKey;
     CK_RV rv;
-    ATCA_STATUS status;
-
-    ((void)ulDataLen);
+    ATCA_STATUS status = ATCA_SUCCESS;
 
     rv = pkcs11_init_check(&pLibCtx, FALSE);
     if (rv)
@@ -119,9 +364,33 @@ CK_RV pkcs11_signature_sign(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_UL
     /* Check parameters */
     if (pulSignatureLen)
     {
+        if (CKM_ATCA_ECDSA_BATCH == pSession->active_mech)
+        {
+            /* Every digest gets a signature */
+            if (!pData || !ulDataLen || (ulDataLen % ATCA_SHA256_DIGEST_SIZE))
+            {
+                return CKR_DATA_LEN_RANGE;
+            }
+            if (!pSignature)
+            {
+                *pulSignatureLen = (ulDataLen / ATCA_SHA256_DIGEST_SIZE) * ATCA_SIG_SIZE;
+                return CKR_OK;
+            }
+            if (*pulSignatureLen < (ulDataLen / ATCA_SHA256_DIGEST_SIZE) * ATCA_SIG_SIZE)
+            {
+                *pulSignatureLen = (ulDataLen / ATCA_SHA256_DIGEST_SIZE) * ATCA_SIG_SIZE;
+                return CKR_BUFFER_TOO_SMALL;
+            }
+        }
+        else if (!pSignature)
+        {
+            *pulSignatureLen = pkcs11_signature_size(pSession->active_mech);
+            return CKR_OK;
+        }
+
         if (pSignature)
         {
-            if (CKR_OK != (rv = pkcs11_lock_context(pLibCtx)))
+            if (CKR_OK != (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
             {
                 return rv;
             }
@@ -129,23 +398,45 @@ CK_RV pkcs11_signature_sign(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_UL
             switch (pSession->active_mech)
             {
             case CKM_SHA256_HMAC:
-                status = atcab_sha_hmac(pData, ulDataLen, pKey->slot, pSignature, SHA_MODE_TARGET_OUT_ONLY);
+                if (CKR_OK == (rv = pkcs11_signature_claim_engine(pSession)))
+                {
+                    status = atcab_sha_hmac_ext(pSession->slot->device_ctx, pData, ulDataLen, pKey->slot, pSignature, SHA_MODE_TARGET_OUT_ONLY);
+                }
                 *pulSignatureLen = ATCA_SHA256_DIGEST_SIZE;
                 break;
             case CKM_ECDSA:
-                status = atcab_sign(pKey->slot, pData, pSignature);
+                status = atcab_sign_ext(pSession->slot->device_ctx, pKey->slot, pData, pSignature);
                 *pulSignatureLen = ATCA_SIG_SIZE;
                 break;
+            case CKM_ECDSA_SHA256:
+            {
+                uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+                atcac_sha2_256_ctx* ctx = &pSession->active_mech_data.sha256.context;
+
+                if (ATCA_SUCCESS == (status = atcac_sw_sha2_256_update(ctx, pData, ulDataLen)))
+                {
+                    if (ATCA_SUCCESS == (status = atcac_sw_sha2_256_finish(ctx, digest)))
+                    {
+                        status = atcab_sign_ext(pSession->slot->device_ctx, pKey->slot, digest, pSignature);
+                    }
+                }
+                *pulSignatureLen = ATCA_SIG_SIZE;
+                break;
+            }
+            case CKM_ATCA_ECDSA_BATCH:
+                status = atcab_sign_batch_ext(pSession->slot->device_ctx, pKey->slot, pData, ulDataLen / ATCA_SHA256_DIGEST_SIZE, pSignature, NULL);
+                *pulSignatureLen = (ulDataLen / ATCA_SHA256_DIGEST_SIZE) * ATCA_SIG_SIZE;
+                break;
             default:
                 status = ATCA_GEN_FAIL;
                 break;
             }
-            pSession->active_mech = CKM_VENDOR_DEFINED;
+            pkcs11_signature_end(pSession);
 
-            (void)pkcs11_unlock_context(pLibCtx);
+            (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
             if (CKR_OK == rv && ATCA_SUCCESS != status)
             {
-                return pkcs11_util_convert_rv(status);
+                rv = pkcs11_util_convert_rv(status);
             }
         }
     }
@@ -154,7 +445,7 @@ CK_RV pkcs11_signature_sign(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_UL
         return CKR_ARGUMENTS_BAD;
     }
 
-    return CKR_OK;
+    return rv;
 }
 
 /**
@@ -162,11 +453,7 @@ CK_RV pkcs11_signature_sign(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_UL
  */
 CK_RV pkcs11_signature_sign_continue(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULONG ulPartLen)
 {
-    ((void)hSession);
-    ((void)pPart);
-    ((void)ulPartLen);
-
-    return CKR_FUNCTION_NOT_SUPPORTED;
+    return pkcs11_signature_update(hSession, pPart, ulPartLen);
 }
 
 /**
@@ -174,11 +461,80 @@ CK_RV pkcs11_signature_sign_continue(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPa
  */
 CK_RV pkcs11_signature_sign_finish(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pSignature, CK_ULONG_PTR pulSignatureLen)
 {
-    ((void)hSession);
-    ((void)pSignature);
-    ((void)pulSignatureLen);
+    pkcs11_lib_ctx_ptr pLibCtx = NULL;
+    pkcs11_session_ctx_ptr pSession;
+    pkcs11_object_ptr pKey;
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    CK_ULONG sig_len;
+    CK_RV rv;
+
+    rv = pkcs11_init_check(&pLibCtx, FALSE);
+    if (rv)
+    {
+        return rv;
+    }
+
+    rv = pkcs11_session_check(&pSession, hSession);
+    if (rv)
+    {
+        return rv;
+    }
+
+    if (CKM_VENDOR_DEFINED == pSession->active_mech)
+    {
+        return CKR_OPERATION_NOT_INITIALIZED;
+    }
+
+    rv = pkcs11_object_check(&pKey, pSession->active_object);
+    if (rv)
+    {
+        return rv;
+    }
+
+    if (!pulSignatureLen)
+    {
+        return CKR_ARGUMENTS_BAD;
+    }
 
-    return CKR_FUNCTION_NOT_SUPPORTED;
+    /* A length query leaves the operation running */
+    sig_len = pkcs11_signature_size(pSession->active_mech);
+    if (!pSignature)
+    {
+        *pulSignatureLen = sig_len;
+        return CKR_OK;
+    }
+    if (*pulSignatureLen < sig_len)
+    {
+        *pulSignatureLen = sig_len;
+        return CKR_BUFFER_TOO_SMALL;
+    }
+
+    if (CKR_OK != (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
+    {
+        return rv;
+    }
+
+    if (CKR_OK == (rv = pkcs11_signature_final(pSession, pKey, digest)))
+    {
+        if (CKM_ECDSA_SHA256 == pSession->active_mech)
+        {
+            rv = pkcs11_util_convert_rv(atcab_sign_ext(pSession->slot->device_ctx, pKey->slot, digest, pSignature));
+        }
+        else
+        {
+            memcpy(pSignature, digest, ATCA_SHA256_DIGEST_SIZE);
+        }
+    }
+    pkcs11_signature_end(pSession);
+
+    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
+
+    if (CKR_OK == rv)
+    {
+        *pulSignatureLen = sig_len;
+    }
+
+    return rv;
 }
 
 /**
@@ -213,18 +569,7 @@ CK_RV pkcs11_signature_verify_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR
         return rv;
     }
 
-    if (CKM_VENDOR_DEFINED == pSession->active_mech)
-    {
-        pSession->active_object = hKey;
-        pSession->active_mech = pMechanism->mechanism;
-        rv = CKR_OK;
-    }
-    else
-    {
-        rv = CKR_OPERATION_ACTIVE;
-    }
-
-    return rv;
+    return pkcs11_signature_start(pSession, pMechanism, hKey);
 }
 
 /**
@@ -235,10 +580,9 @@ CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_
     pkcs11_lib_ctx_ptr pLibCtx = NULL;
     pkcs11_session_ctx_ptr pSession;
     pkcs11_object_ptr pKey;
-    CK_BBOOL is_private;
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
     CK_RV rv;
-    ATCA_STATUS status = ATCA_GEN_FAIL;
-    bool verified = FALSE;
+    ATCA_STATUS status = ATCA_SUCCESS;
 
     rv = pkcs11_init_check(&pLibCtx, FALSE);
     if (rv)
@@ -258,13 +602,14 @@ CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_
         return rv;
     }
 
-    /* Check parameters */
-    if (!pData || ulDataLen != ATCA_SHA256_DIGEST_SIZE || !pSignature || ulSignatureLen != ATCA_ECCP256_SIG_SIZE)
+    /* Check parameters - only raw ECDSA takes a digest rather than the message */
+    if (!pData || !pSignature || ulSignatureLen != pkcs11_signature_size(pSession->active_mech)
+        || (CKM_ECDSA == pSession->active_mech && ulDataLen != ATCA_SHA256_DIGEST_SIZE))
     {
         return CKR_ARGUMENTS_BAD;
     }
 
-    if (CKR_OK != (rv = pkcs11_lock_context(pLibCtx)))
+    if (CKR_OK != (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
     {
         return rv;
     }
@@ -272,55 +617,32 @@ CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_
     switch (pSession->active_mech)
     {
     case CKM_SHA256_HMAC:
-    {
-        uint8_t buf[ATCA_SHA256_DIGEST_SIZE];
-        if (ATCA_SUCCESS == (status = atcab_sha_hmac(pData, ulDataLen, pKey->slot, buf, SHA_MODE_TARGET_OUT_ONLY)))
+        if (CKR_OK == (rv = pkcs11_signature_claim_engine(pSession)))
         {
-            if (!memcmp(pSignature, buf, ATCA_SHA256_DIGEST_SIZE))
-            {
-                verified = TRUE;
-            }
+            status = atcab_sha_hmac_ext(pSession->slot->device_ctx, pData, ulDataLen, pKey->slot, digest, SHA_MODE_TARGET_OUT_ONLY);
         }
-    }
-    break;
+        break;
     case CKM_ECDSA:
-        if (CKR_OK == (rv = pkcs11_object_is_private(pKey, &is_private)))
+        memcpy(digest, pData, ATCA_SHA256_DIGEST_SIZE);
+        break;
+    case CKM_ECDSA_SHA256:
+        if (ATCA_SUCCESS == (status = atcac_sw_sha2_256_update(&pSession->active_mech_data.sha256.context, pData, ulDataLen)))
         {
-            if (is_private)
-            {
-                /* Device can't verify against a private key so ask the device for
-                    the public key first then perform an external verify */
-                uint8_t pub_key[ATCA_ECCP256_PUBKEY_SIZE];
-
-                if (ATCA_SUCCESS == (status = atcab_get_pubkey(pKey->slot, pub_key)))
-                {
-                    status = atcab_verify_extern(pData, pSignature, pub_key, &verified);
-                }
-            }
-            else
-            {
-                /* Assume Public Key has been stored properly and verify against
-                    whatever is stored */
-                status = atcab_verify_stored(pData, pSignature, pKey->slot, &verified);
-            }
+            status = atcac_sw_sha2_256_finish(&pSession->active_mech_data.sha256.context, digest);
         }
         break;
     default:
         status = ATCA_GEN_FAIL;
         break;
     }
-    pSession->active_mech = CKM_VENDOR_DEFINED;
 
-    (void)pkcs11_unlock_context(pLibCtx);
-
-    if (ATCA_SUCCESS == status)
+    if (CKR_OK == rv)
     {
-        rv = verified ? CKR_OK : CKR_SIGNATURE_INVALID;
-    }
-    else
-    {
-        rv = CKR_DEVICE_ERROR;
+        rv = (ATCA_SUCCESS == status) ? pkcs11_signature_check(pSession, pKey, digest, pSignature) : CKR_DEVICE_ERROR;
     }
+    pkcs11_signature_end(pSession);
+
+    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
 
     return rv;
 }
@@ -330,11 +652,7 @@ CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_
  */
 CK_RV pkcs11_signature_verify_continue(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULONG ulPartLen)
 {
-    ((void)hSession);
-    ((void)pPart);
-    ((void)ulPartLen);
-
-    return CKR_FUNCTION_NOT_SUPPORTED;
+    return pkcs11_signature_update(hSession, pPart, ulPartLen);
 }
 
 /**
@@ -342,13 +660,64 @@ CK_RV pkcs11_signature_verify_continue(CK_SESSION_HANDLE hSession, CK_BYTE_PTR p
  */
 CK_RV pkcs11_signature_verify_finish(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pSignature, CK_ULONG ulSignatureLen)
 {
-    ((void)hSession);
-    ((void)pSignature);
-    ((void)ulSignatureLen);
+    pkcs11_lib_ctx_ptr pLibCtx = NULL;
+    pkcs11_session_ctx_ptr pSession;
+    pkcs11_object_ptr pKey;
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    CK_RV rv;
 
-    return CKR_FUNCTION_NOT_SUPPORTED;
+    rv = pkcs11_init_check(&pLibCtx, FALSE);
+    if (rv)
+    {
+        return rv;
+    }
+
+    rv = pkcs11_session_check(&pSession, hSession);
+    if (rv)
+    {
+        return rv;
+    }
+
+    if (CKM_VENDOR_DEFINED == pSession->active_mech)
+    {
+        return CKR_OPERATION_NOT_INITIALIZED;
+    }
+
+    rv = pkcs11_object_check(&pKey, pSession->active_object);
+    if (rv)
+    {
+        return rv;
+    }
+
+    if (CKR_OK != (rv = pkcs11_lock_device(pLibCtx, pSession->slot)))
+    {
+        return rv;
+    }
+
+    if (!pSignature || ulSignatureLen != pkcs11_signature_size(pSession->active_mech))
+    {
+        rv = CKR_ARGUMENTS_BAD;
+    }
+    else if (CKR_OK == (rv = pkcs11_signature_final(pSession, pKey, digest)))
+    {
+        rv = pkcs11_signature_check(pSession, pKey, digest, pSignature);
+    }
+    pkcs11_signature_end(pSession);
+
+    (void)pkcs11_unlock_device(pLibCtx, pSession->slot);
+
+    return rv;
 }
 
+/**
+ * \brief Ends the sign or verify operation of a session that is being closed
+ */
+void pkcs11_signature_session_close(pkcs11_session_ctx_ptr pSession)
+{
+    if (pSession)
+    {
+        pkcs11_signature_end(pSession);
+    }
+}
 
 /** @} */
-
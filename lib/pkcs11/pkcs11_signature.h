@@ -29,11 +29,17 @@
 #define PKCS11_SIGNATURE_H_
 
 #include "cryptoki.h"
+#include "pkcs11_session.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Vendor mechanism signing several 32 byte digests with a single C_Sign. The
+    digests are passed back to back as the data and the 64 byte signatures are
+    returned in the same order */
+#define CKM_ATCA_ECDSA_BATCH        (CKM_VENDOR_DEFINED | 0x00000001UL)
+
 #ifdef __cplusplus
 }
 #endif
@@ -46,5 +52,6 @@ CK_RV pkcs11_signature_verify_init(CK_SESSION_HANDLE hSession, CK_MECHANISM_PTR
 CK_RV pkcs11_signature_verify(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pData, CK_ULONG ulDataLen, CK_BYTE_PTR pSignature, CK_ULONG ulSignatureLen);
 CK_RV pkcs11_signature_verify_continue(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pPart, CK_ULONG ulPartLen);
 CK_RV pkcs11_signature_verify_finish(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pSignature, CK_ULONG ulSignatureLen);
+void pkcs11_signature_session_close(pkcs11_session_ctx_ptr pSession);
 
 #endif /* PKCS11_SIGNATURE_H_ */
@@ -110,6 +110,7 @@ CK_RV pkcs11_slot_config(CK_SLOT_ID slotID)
     }
 
     /* Set Defaults */
+    slot_ctx->slot_id = slotID;
     slot_ctx->user_pin_handle = 0xFFFF;
     slot_ctx->so_pin_handle = 0xFFFF;
 
@@ -155,6 +156,49 @@ static ATCA_STATUS pkcs11_slot_check_device_type(ATCAIfaceCfg * ifacecfg)
 }
 #endif
 
+/**
+ * \brief Start the device of a slot. The first slot uses the global device so
+ * the basic API keeps working for the paths that still rely on it.
+ */
+static ATCA_STATUS pkcs11_slot_device_init(pkcs11_slot_ctx_ptr slot_ctx, CK_SLOT_ID slotID)
+{
+    ATCA_STATUS status;
+
+    if (0 == slotID)
+    {
+        if (ATCA_SUCCESS == (status = atcab_init(&slot_ctx->interface_config)))
+        {
+            slot_ctx->device_ctx = atcab_get_device();
+        }
+    }
+    else
+    {
+#ifndef ATCA_NO_HEAP
+        status = atcab_init_ext(&slot_ctx->device_ctx, &slot_ctx->interface_config);
+#else
+        /* Without a heap there is only a single device context */
+        status = ATCA_ALLOC_FAILURE;
+#endif
+    }
+    return status;
+}
+
+/**
+ * \brief Release the device of a slot
+ */
+void pkcs11_slot_device_release(pkcs11_slot_ctx_ptr slot_ctx, CK_SLOT_ID slotID)
+{
+    if (0 == slotID)
+    {
+        (void)atcab_release();
+    }
+    else if (slot_ctx->device_ctx)
+    {
+        (void)atcab_release_ext(&slot_ctx->device_ctx);
+    }
+    slot_ctx->device_ctx = NULL;
+}
+
 CK_RV pkcs11_slot_init(CK_SLOT_ID slotID)
 {
     pkcs11_lib_ctx_ptr lib_ctx = pkcs11_get_context();
@@ -184,7 +228,7 @@ CK_RV pkcs11_slot_init(CK_SLOT_ID slotID)
             /* If a PKCS11 was killed an left the device in the idle state then
                starting up again will require the device to go back to a known state
                that is accomplished here by retrying the initalization */
-            status = atcab_init(ifacecfg);
+            status = pkcs11_slot_device_init(slot_ctx, slotID);
         }
         while (retries-- && status);
 
@@ -195,13 +239,13 @@ CK_RV pkcs11_slot_init(CK_SLOT_ID slotID)
             {
                 /* Try the default address */
                 ifacecfg->atcai2c.address = 0xC0;
-                atcab_release();
+                pkcs11_slot_device_release(slot_ctx, slotID);
                 atca_delay_ms(1);
                 retries = 2;
                 do
                 {
                     /* Same as the above */
-                    status = atcab_init(ifacecfg);
+                    status = pkcs11_slot_device_init(slot_ctx, slotID);
                 }
                 while (retries-- && status);
             }
@@ -223,7 +267,7 @@ CK_RV pkcs11_slot_init(CK_SLOT_ID slotID)
 #if ATCA_CA_SUPPORT
                 /* Only the classic cryptoauth devices require the configuration
                    to be loaded into memory */
-                status = atcab_read_config_zone((uint8_t*)&slot_ctx->cfg_zone);
+                status = atcab_read_config_zone_ext(slot_ctx->device_ctx, (uint8_t*)&slot_ctx->cfg_zone);
 #else
                 status = ATCA_GEN_FAIL;
 #endif
@@ -231,24 +275,74 @@ CK_RV pkcs11_slot_init(CK_SLOT_ID slotID)
             else
             {
 #if ATCA_TA_SUPPORT
-                /* Iterate through all objects and attach handle info */
-                status = pkcs11_object_load_handle_info(lib_ctx);
+                /* Iterate through the objects of the slot and attach handle info */
+                status = pkcs11_object_load_handle_info(slot_ctx);
 #else
                 status = ATCA_GEN_FAIL;
 #endif
             }
         }
 
+        if (ATCA_SUCCESS == status && lib_ctx->create_mutex && !slot_ctx->mutex)
+        {
+            CK_RV rv;
+
+            /* The native library mutex is shared by name so the slots need
+               names of their own */
+            if (pkcs11_os_create_mutex == lib_ctx->create_mutex)
+            {
+                rv = pkcs11_os_create_slot_mutex(&slot_ctx->mutex, slotID);
+            }
+            else
+            {
+                rv = lib_ctx->create_mutex(&slot_ctx->mutex);
+            }
+
+            if (CKR_OK != rv)
+            {
+                status = ATCA_GEN_FAIL;
+            }
+        }
+
         if (ATCA_SUCCESS == status)
         {
             slot_ctx->slot_id = slotID;
             slot_ctx->initialized = TRUE;
         }
+        else if (slotID)
+        {
+            pkcs11_slot_device_release(slot_ctx, slotID);
+        }
     }
 
     return (ATCA_SUCCESS == status) ? CKR_OK : CKR_DEVICE_ERROR;
 }
 
+/**
+ * \brief Release the device and mutex of a slot. The global device of the
+ * first slot is released by the caller.
+ */
+void pkcs11_slot_deinit(pkcs11_slot_ctx_ptr slot_ctx)
+{
+    pkcs11_lib_ctx_ptr lib_ctx = pkcs11_get_context();
+
+    if (slot_ctx)
+    {
+        if (slot_ctx->slot_id)
+        {
+            pkcs11_slot_device_release(slot_ctx, slot_ctx->slot_id);
+        }
+        slot_ctx->device_ctx = NULL;
+
+        if (slot_ctx->mutex && lib_ctx && lib_ctx->destroy_mutex)
+        {
+            (void)lib_ctx->destroy_mutex(slot_ctx->mutex);
+        }
+        slot_ctx->mutex = NULL;
+        slot_ctx->initialized = FALSE;
+    }
+}
+
 static CK_ULONG pkcs11_slot_get_active_count(pkcs11_lib_ctx_ptr lib_ctx)
 {
     CK_ULONG active_cnt = 0;
@@ -397,7 +491,7 @@ CK_RV pkcs11_slot_get_info(CK_SLOT_ID slotID, CK_SLOT_INFO_PTR pInfo)
     {
         (void)pkcs11_lock_context(lib_ctx);
 
-        if (!atcab_info(buf))
+        if (!atcab_info_ext(slot_ctx->device_ctx, buf))
         {
             /* SHA204 = 00 02 00 09, ECC508 = 00 00 50 00, AES132 = 0A 07*/
             pInfo->hardwareVersion.major = 0;
@@ -42,6 +42,7 @@ typedef struct _pkcs11_slot_ctx
     CK_BBOOL          initialized;
     CK_SLOT_ID        slot_id;
     ATCADevice        device_ctx;
+    CK_VOID_PTR       mutex;                    /**< Serializes command sequences to the device of the slot */
     ATCAIfaceCfg      interface_config;
     CK_SESSION_HANDLE session;
 #if ATCA_CA_SUPPORT
@@ -55,6 +56,10 @@ typedef struct _pkcs11_slot_ctx
 #endif
     CK_BBOOL logged_in;
     CK_BYTE  read_key[32];                      /**< Accepted through C_Login as the user pin */
+    CK_VOID_PTR hmac_owner;                     /**< Session running a multi-part HMAC in the device SHA engine */
+#if PKCS11_HARDWARE_SHA256
+    CK_VOID_PTR digest_owner;                   /**< Session whose digest is loaded in the device SHA engine */
+#endif
 } pkcs11_slot_ctx, *pkcs11_slot_ctx_ptr;
 
 #ifdef __cplusplus
@@ -62,10 +67,15 @@ typedef struct _pkcs11_slot_ctx
 #endif
 
 CK_RV pkcs11_slot_init(CK_SLOT_ID slotID);
+void pkcs11_slot_deinit(pkcs11_slot_ctx_ptr slot_ctx);
+void pkcs11_slot_device_release(pkcs11_slot_ctx_ptr slot_ctx, CK_SLOT_ID slotID);
 CK_RV pkcs11_slot_config(CK_SLOT_ID slotID);
 CK_VOID_PTR pkcs11_slot_initslots(CK_ULONG pulCount);
 pkcs11_slot_ctx_ptr pkcs11_slot_get_context(pkcs11_lib_ctx_ptr lib_ctx, CK_SLOT_ID slotID);
 
+CK_RV pkcs11_lock_device(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot);
+CK_RV pkcs11_unlock_device(pkcs11_lib_ctx_ptr pContext, pkcs11_slot_ctx_ptr pSlot);
+
 
 CK_RV pkcs11_slot_get_list(CK_BBOOL tokenPresent, CK_SLOT_ID_PTR pSlotList, CK_ULONG_PTR pulCount);
 CK_RV pkcs11_slot_get_info(CK_SLOT_ID slotID, CK_SLOT_INFO_PTR pInfo);
@@ -152,7 +152,7 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
     if (CKR_OK == rv)
     {
         /* Check the config zone lock status */
-        rv = pkcs11_util_convert_rv(atcab_is_config_locked(&lock));
+        rv = pkcs11_util_convert_rv(atcab_is_config_locked_ext(pSlotCtx->device_ctx, &lock));
     }
 
     if (atcab_is_ca_device(pSlotCtx->interface_config.devtype))
@@ -160,7 +160,7 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
         if (ATCA_SUCCESS == rv)
         {
             /* Get the device type */
-            rv = atcab_info(buf);
+            rv = atcab_info_ext(pSlotCtx->device_ctx, buf);
         }
 
         switch (buf[2])
@@ -196,20 +196,20 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
 
             if (ATCA_SUCCESS == rv)
             {
-                rv = atcab_write_config_zone(pConfig);
+                rv = atcab_write_config_zone_ext(pSlotCtx->device_ctx, pConfig);
             }
         }
 
         if (ATCA_SUCCESS == rv)
         {
-            rv = atcab_lock_config_zone();
+            rv = atcab_lock_config_zone_ext(pSlotCtx->device_ctx);
         }
     }
 
     if (ATCA_SUCCESS == rv)
     {
         /* Check data zone lock */
-        rv = pkcs11_util_convert_rv(atcab_is_data_locked(&lock));
+        rv = pkcs11_util_convert_rv(atcab_is_data_locked_ext(pSlotCtx->device_ctx, &lock));
     }
 
     if (!lock && ATCA_SUCCESS == rv)
@@ -223,7 +223,7 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
             {
                 if (ATCA_KEY_CONFIG_PRIVATE_MASK & ((atecc608_config_t*)pConfig)->KeyConfig[i])
                 {
-                    rv = atcab_genkey(i, NULL);
+                    rv = atcab_genkey_ext(pSlotCtx->device_ctx, i, NULL);
                 }
             }
         }
@@ -231,10 +231,10 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
         {
 #if ATCA_TA_SUPPORT
             const ta_element_attributes_t attr_ecc_private_deletable = { 1, 0x1700, 0, 0, 0, 0x41, 0 };
-            rv = talib_create_element_with_handle(atcab_get_device(), 0x8102, &attr_ecc_private_deletable);
+            rv = talib_create_element_with_handle(pSlotCtx->device_ctx, 0x8102, &attr_ecc_private_deletable);
             if (!rv)
             {
-                rv = talib_genkey_compat(atcab_get_device(), 0x8102, NULL);
+                rv = talib_genkey_compat(pSlotCtx->device_ctx, 0x8102, NULL);
             }
 #endif
         }
@@ -245,7 +245,7 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
             {
                 if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
                 {
-                    rv = pkcs11_util_convert_rv(atcab_read_serial_number(buf));
+                    rv = pkcs11_util_convert_rv(atcab_read_serial_number_ext(pSlotCtx->device_ctx, buf));
                     (void)pkcs11_unlock_context(pLibCtx);
                 }
 
@@ -267,7 +267,7 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
                     /* Write the default pin */
                     if (CKR_OK == rv)
                     {
-                        rv = atcab_write_zone(ATCA_ZONE_DATA, pSlotCtx->so_pin_handle, 0, 0, buf, buflen);
+                        rv = atcab_write_zone_ext(pSlotCtx->device_ctx, ATCA_ZONE_DATA, pSlotCtx->so_pin_handle, 0, 0, buf, buflen);
                     }
                 }
             }
@@ -276,13 +276,13 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
         /* Lock the data zone */
         if (ATCA_SUCCESS == rv)
         {
-            rv = atcab_lock_data_zone();
+            rv = atcab_lock_data_zone_ext(pSlotCtx->device_ctx);
         }
     }
 
     /* If the I2C address changed it'll have to be put back to sleep before it'll
        change */
-    (void)atcab_release();
+    pkcs11_slot_device_release(pSlotCtx, slotID);
 
     /* Release the lock on the library */
     (void)pkcs11_unlock_context(pLibCtx);
@@ -291,7 +291,7 @@ CK_RV pkcs11_token_init(CK_SLOT_ID slotID, CK_UTF8CHAR_PTR pPin, CK_ULONG ulPinL
     if (ATCA_SUCCESS == rv)
     {
         pSlotCtx->initialized = FALSE;
-        rv = pkcs11_slot_init(0);
+        rv = pkcs11_slot_init(slotID);
     }
 
     if (ATCA_SUCCESS != rv)
@@ -442,7 +442,7 @@ CK_RV pkcs11_token_get_info(CK_SLOT_ID slotID, CK_TOKEN_INFO_PTR pInfo)
         (void)pkcs11_lock_context(lib_ctx);
 
         /* Read the serial number */
-        if (!atcab_read_serial_number(buf))
+        if (!atcab_read_serial_number_ext(slot_ctx->device_ctx, buf))
         {
 #ifdef PKCS11_LABEL_IS_SERNUM
             size_t len = sizeof(pInfo->label);
@@ -459,7 +459,7 @@ CK_RV pkcs11_token_get_info(CK_SLOT_ID slotID, CK_TOKEN_INFO_PTR pInfo)
 #endif
 
         /* Read the hardware revision data */
-        if (!atcab_info(buf))
+        if (!atcab_info_ext(slot_ctx->device_ctx, buf))
         {
             /* SHA204 = 00 02 00 09, ECC508 = 00 00 50 00, AES132 = 0A 07*/
             pInfo->hardwareVersion.major = 0;
@@ -468,7 +468,7 @@ CK_RV pkcs11_token_get_info(CK_SLOT_ID slotID, CK_TOKEN_INFO_PTR pInfo)
         }
 
         /* Check if the device locks are set */
-        if (ATCA_SUCCESS == atcab_is_data_locked(&lock))
+        if (ATCA_SUCCESS == atcab_is_data_locked_ext(slot_ctx->device_ctx, &lock))
         {
             if (lock)
             {
@@ -480,7 +480,7 @@ CK_RV pkcs11_token_get_info(CK_SLOT_ID slotID, CK_TOKEN_INFO_PTR pInfo)
         /* Check if the device locks are set */
         if (slot_ctx->user_pin_handle != 0xFFFF)
         {
-            if (ATCA_SUCCESS == atcab_is_slot_locked(slot_ctx->user_pin_handle, &lock))
+            if (ATCA_SUCCESS == atcab_is_slot_locked_ext(slot_ctx->device_ctx, slot_ctx->user_pin_handle, &lock))
             {
                 if (lock)
                 {
@@ -493,7 +493,7 @@ CK_RV pkcs11_token_get_info(CK_SLOT_ID slotID, CK_TOKEN_INFO_PTR pInfo)
 
         if (slot_ctx->so_pin_handle != 0xFFFF)
         {
-            if (ATCA_SUCCESS == atcab_is_slot_locked(slot_ctx->so_pin_handle, &lock))
+            if (ATCA_SUCCESS == atcab_is_slot_locked_ext(slot_ctx->device_ctx, slot_ctx->so_pin_handle, &lock))
             {
                 if (lock)
                 {
@@ -550,7 +550,7 @@ CK_RV pkcs11_token_random(CK_SESSION_HANDLE hSession, CK_BYTE_PTR pRandomData, C
     {
         (void)pkcs11_lock_context(lib_ctx);
 
-        status = atcab_random(buf);
+        status = atcab_random_ext(pSession->slot->device_ctx, buf);
 
         (void)pkcs11_unlock_context(lib_ctx);
 
@@ -638,8 +638,8 @@ CK_RV pkcs11_token_set_pin(CK_SESSION_HANDLE hSession, CK_UTF8CHAR_PTR pOldPin,
     uint16_t pin_slot;
     uint8_t buf[32];
     CK_RV rv;
-    bool is_ca_device = atcab_is_ca_device(atcab_get_device_type());
-    uint16_t key_len = is_ca_device ? 32 : 16;
+    bool is_ca_device;
+    uint16_t key_len;
 
     rv = pkcs11_init_check(&pLibCtx, FALSE);
     if (rv)
@@ -658,6 +658,9 @@ CK_RV pkcs11_token_set_pin(CK_SESSION_HANDLE hSession, CK_UTF8CHAR_PTR pOldPin,
         return rv;
     }
 
+    is_ca_device = atcab_is_ca_device(atcab_get_device_type_ext(pSession->slot->device_ctx));
+    key_len = is_ca_device ? 32 : 16;
+
     if (CKR_OK == (rv = pkcs11_lock_context(pLibCtx)))
     {
 #ifndef PKCS11_PIN_KDF_ALWAYS
@@ -668,7 +671,7 @@ CK_RV pkcs11_token_set_pin(CK_SESSION_HANDLE hSession, CK_UTF8CHAR_PTR pOldPin,
         else
 #endif
         {
-            if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_read_serial_number(buf))))
+            if (CKR_OK == (rv = pkcs11_util_convert_rv(atcab_read_serial_number_ext(pSession->slot->device_ctx, buf))))
             {
                 rv = pkcs11_token_convert_pin_to_key(pNewPin, ulNewLen, buf, ATCA_SERIAL_NUM_SIZE,
                                                      buf, key_len);
@@ -690,7 +693,7 @@ CK_RV pkcs11_token_set_pin(CK_SESSION_HANDLE hSession, CK_UTF8CHAR_PTR pOldPin,
 
         if (CKR_OK == rv)
         {
-            rv = atcab_write_zone(ATCA_ZONE_DATA, pin_slot, 0, 0, buf, sizeof(buf));
+            rv = atcab_write_zone_ext(pSession->slot->device_ctx, ATCA_ZONE_DATA, pin_slot, 0, 0, buf, sizeof(buf));
         }
 
         (void)pkcs11_unlock_context(pLibCtx);
@@ -700,7 +703,7 @@ CK_RV pkcs11_token_set_pin(CK_SESSION_HANDLE hSession, CK_UTF8CHAR_PTR pOldPin,
 #if PKCS11_LOCK_PIN_SLOT
     if (CKR_OK == rv)
     {
-        rv = atcab_lock_data_slot(pin_slot);
+        rv = atcab_lock_data_slot_ext(pSession->slot->device_ctx, pin_slot);
     }
 #endif
 
@@ -0,0 +1,77 @@
+/**
+ * \file
+ * \brief Runner for the unit tests that use the simulated device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#pragma GCC diagnostic ignored "-Wmissing-prototypes"
+#endif
+
+void RunAllMockTests(void)
+{
+#if ATCA_CA_SUPPORT
+    RUN_TEST_GROUP(calib_async);
+    RUN_TEST_GROUP(calib_keep_awake);
+    RUN_TEST_GROUP(calib_sign_batch);
+    RUN_TEST_GROUP(calib_read_plan);
+    RUN_TEST_GROUP(calib_sha_offload);
+    RUN_TEST_GROUP(atca_crypto_aes_ctr_bulk);
+#ifndef ATCA_NO_HEAP
+    RUN_TEST_GROUP(atca_router);
+#endif
+#if defined(ATCA_POLL_ADAPTIVE) && !defined(ATCA_NO_POLL)
+    RUN_TEST_GROUP(calib_poll);
+#endif
+#if defined(ATCA_CERT_CACHE) && !defined(DO_NOT_TEST_CERT)
+    RUN_TEST_GROUP(atcacert_cache);
+#endif
+#if !defined(DO_NOT_TEST_CERT) && !defined(_WIN32)
+    RUN_TEST_GROUP(atcacert_read_ext);
+#endif
+#if defined(ATCA_HAL_I2C) && defined(__linux__) && !defined(ATCA_HAL_LEGACY_API)
+    RUN_TEST_GROUP(hal_linux_i2c);
+#endif
+#if defined(ATCA_HAL_KIT_UART) && defined(__linux__) && !defined(ATCA_HAL_LEGACY_API)
+    RUN_TEST_GROUP(hal_kit_uart);
+#endif
+#if defined(ATCA_TNGTLS_SUPPORT) && !defined(DO_NOT_TEST_CERT)
+    RUN_TEST_GROUP(tng_atcacert_chain);
+#endif
+#ifdef ATCA_TEST_PKCS11
+    RUN_TEST_GROUP(pkcs11_signature);
+    RUN_TEST_GROUP(pkcs11_digest);
+    RUN_TEST_GROUP(pkcs11_find);
+#ifndef ATCA_NO_HEAP
+    RUN_TEST_GROUP(pkcs11_attrib_cache);
+#endif
+#ifndef _WIN32
+    RUN_TEST_GROUP(pkcs11_slot_lock);
+#endif
+#endif
+#endif
+}
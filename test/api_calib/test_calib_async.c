@@ -0,0 +1,193 @@
+/**
+ * \file
+ * \brief Tests for the asynchronous command API run against the simulated
+ *        device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define ASYNC_TEST_DEVICES      (3)
+
+static atca_mock_bus_t g_async_bus;
+static atca_mock_device_t* g_async_mock[ASYNC_TEST_DEVICES];
+static ATCAIfaceCfg g_async_cfg[ASYNC_TEST_DEVICES];
+static ATCADevice g_async_device[ASYNC_TEST_DEVICES];
+
+static void async_build_random(ATCAPacket* packet)
+{
+    packet->param1 = RANDOM_SEED_UPDATE;
+    packet->param2 = 0x0000;
+    TEST_ASSERT_SUCCESS(atRandom(ATECC608, packet));
+}
+
+static void async_count_callback(calib_async_cmd_t* cmd)
+{
+    (*(int*)cmd->user_data)++;
+}
+
+TEST_GROUP(calib_async);
+
+TEST_SETUP(calib_async)
+{
+    int i;
+
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_async_bus));
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+
+    for (i = 0; i < ASYNC_TEST_DEVICES; i++)
+    {
+        g_async_device[i] = NULL;
+        TEST_ASSERT_NOT_NULL(g_async_mock[i] = atca_mock_bus_add_device(&g_async_bus, (uint8_t)(0xC0 + 2 * i)));
+        atca_mock_cfg_init(&g_async_cfg[i], &g_async_bus, ATECC608, (uint8_t)(0xC0 + 2 * i));
+        TEST_ASSERT_SUCCESS(atcab_init_ext(&g_async_device[i], &g_async_cfg[i]));
+        atca_mock_reset_stats(g_async_mock[i]);
+    }
+}
+
+TEST_TEAR_DOWN(calib_async)
+{
+    int i;
+
+    for (i = 0; i < ASYNC_TEST_DEVICES; i++)
+    {
+        (void)atcab_release_ext(&g_async_device[i]);
+    }
+    (void)atca_mock_hal_unregister();
+    atca_mock_bus_release(&g_async_bus);
+}
+
+TEST(calib_async, submit_poll)
+{
+    ATCAPacket packet;
+    calib_async_cmd_t cmd;
+    uint32_t delay;
+
+    atca_mock_set_exec_time(g_async_mock[0], ATCA_RANDOM, 20000);
+    async_build_random(&packet);
+
+    TEST_ASSERT_SUCCESS(calib_async_submit(&cmd, g_async_device[0], &packet, NULL, NULL));
+    TEST_ASSERT_EQUAL(1, g_async_mock[0]->stats.commands);
+
+    /* Nothing is read from the device before the first poll is due */
+    delay = calib_async_get_delay(&cmd);
+    TEST_ASSERT_TRUE(delay > 0);
+    TEST_ASSERT_EQUAL(ATCA_RX_NO_RESPONSE, calib_async_poll(&cmd, 0));
+    TEST_ASSERT_EQUAL(0, g_async_mock[0]->stats.polls);
+
+    TEST_ASSERT_SUCCESS(calib_async_wait(&cmd));
+    TEST_ASSERT_EQUAL(RANDOM_RSP_SIZE, packet.data[ATCA_COUNT_IDX]);
+    TEST_ASSERT_EQUAL(0, calib_async_get_delay(&cmd));
+
+    /* The device is idled once the response has been read */
+    TEST_ASSERT_EQUAL(1, g_async_mock[0]->stats.idles);
+    TEST_ASSERT_SUCCESS(calib_async_poll(&cmd, 0));
+}
+
+TEST(calib_async, callback)
+{
+    ATCAPacket packet;
+    calib_async_cmd_t cmd;
+    int completions = 0;
+
+    async_build_random(&packet);
+
+    TEST_ASSERT_SUCCESS(calib_async_submit(&cmd, g_async_device[0], &packet, async_count_callback, &completions));
+    TEST_ASSERT_EQUAL(0, completions);
+    TEST_ASSERT_SUCCESS(calib_async_wait(&cmd));
+    TEST_ASSERT_EQUAL(1, completions);
+
+    /* Polling a completed command does not report it again */
+    TEST_ASSERT_SUCCESS(calib_async_poll(&cmd, 10));
+    TEST_ASSERT_EQUAL(1, completions);
+}
+
+TEST(calib_async, device_error)
+{
+    ATCAPacket packet;
+    calib_async_cmd_t cmd;
+
+    /* Sign with nothing loaded in the message digest buffer fails on the device */
+    packet.param1 = SIGN_MODE_EXTERNAL | SIGN_MODE_SOURCE_MSGDIGBUF;
+    packet.param2 = 0;
+    TEST_ASSERT_SUCCESS(atSign(ATECC608, &packet));
+
+    TEST_ASSERT_SUCCESS(calib_async_submit(&cmd, g_async_device[0], &packet, NULL, NULL));
+    TEST_ASSERT_EQUAL(ATCA_EXECUTION_ERROR, calib_async_wait(&cmd));
+    TEST_ASSERT_EQUAL(ATCA_EXECUTION_ERROR, cmd.status);
+}
+
+TEST(calib_async, concurrent_devices)
+{
+    ATCAPacket packet[ASYNC_TEST_DEVICES];
+    calib_async_cmd_t cmd[ASYNC_TEST_DEVICES];
+    calib_async_cmd_t* cmds[ASYNC_TEST_DEVICES];
+    uint64_t start;
+    uint64_t elapsed;
+    int completions = 0;
+    int i;
+
+    for (i = 0; i < ASYNC_TEST_DEVICES; i++)
+    {
+        atca_mock_set_exec_time(g_async_mock[i], ATCA_RANDOM, 50000);
+        async_build_random(&packet[i]);
+        cmds[i] = &cmd[i];
+    }
+
+    /* One thread keeps every device busy at the same time */
+    start = atca_mock_time_usec();
+    for (i = 0; i < ASYNC_TEST_DEVICES; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_async_submit(&cmd[i], g_async_device[i], &packet[i], async_count_callback, &completions));
+    }
+    TEST_ASSERT_SUCCESS(calib_async_service(cmds, ASYNC_TEST_DEVICES));
+    elapsed = atca_mock_time_usec() - start;
+
+    TEST_ASSERT_EQUAL(ASYNC_TEST_DEVICES, completions);
+    for (i = 0; i < ASYNC_TEST_DEVICES; i++)
+    {
+        TEST_ASSERT_EQUAL(RANDOM_RSP_SIZE, packet[i].data[ATCA_COUNT_IDX]);
+        TEST_ASSERT_EQUAL(1, g_async_mock[i]->stats.opcode_count[ATCA_RANDOM]);
+    }
+
+    /* Run back to back the commands would take at least 150ms */
+    TEST_ASSERT_TRUE(elapsed < 2 * 50000);
+}
+
+TEST_GROUP_RUNNER(calib_async)
+{
+    RUN_TEST_CASE(calib_async, submit_poll);
+    RUN_TEST_CASE(calib_async, callback);
+    RUN_TEST_CASE(calib_async, device_error);
+    RUN_TEST_CASE(calib_async, concurrent_devices);
+}
+
+#endif
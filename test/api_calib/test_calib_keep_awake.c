@@ -0,0 +1,214 @@
+/**
+ * \file
+ * \brief Tests for keep-awake sessions run against the simulated device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define KEEP_AWAKE_COMMANDS     (5)
+
+static atca_mock_bus_t g_awake_bus;
+static atca_mock_device_t* g_awake_mock;
+static ATCAIfaceCfg g_awake_cfg;
+static ATCADevice g_awake_device;
+
+TEST_GROUP(calib_keep_awake);
+
+TEST_SETUP(calib_keep_awake)
+{
+    g_awake_device = NULL;
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_awake_bus));
+    TEST_ASSERT_NOT_NULL(g_awake_mock = atca_mock_bus_add_device(&g_awake_bus, 0xC0));
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+
+    atca_mock_cfg_init(&g_awake_cfg, &g_awake_bus, ATECC608, 0xC0);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&g_awake_device, &g_awake_cfg));
+    atca_mock_reset_stats(g_awake_mock);
+}
+
+TEST_TEAR_DOWN(calib_keep_awake)
+{
+    (void)atcab_release_ext(&g_awake_device);
+    (void)atca_mock_hal_unregister();
+    atca_mock_bus_release(&g_awake_bus);
+}
+
+TEST(calib_keep_awake, idle_after_each_command)
+{
+    uint8_t random[RANDOM_NUM_SIZE];
+    int i;
+
+    for (i = 0; i < KEEP_AWAKE_COMMANDS; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_random(g_awake_device, random));
+    }
+
+    TEST_ASSERT_EQUAL(KEEP_AWAKE_COMMANDS, g_awake_mock->stats.wakes);
+    TEST_ASSERT_EQUAL(KEEP_AWAKE_COMMANDS, g_awake_mock->stats.idles);
+}
+
+TEST(calib_keep_awake, single_wake)
+{
+    uint8_t random[RANDOM_NUM_SIZE];
+    uint8_t data[ATCA_BLOCK_SIZE];
+    int i;
+
+    TEST_ASSERT_SUCCESS(calib_keep_awake_begin(g_awake_device));
+    for (i = 0; i < KEEP_AWAKE_COMMANDS; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_random(g_awake_device, random));
+        TEST_ASSERT_SUCCESS(calib_read_zone(g_awake_device, ATCA_ZONE_CONFIG, 0, 0, 0, data, sizeof(data)));
+    }
+    TEST_ASSERT_EQUAL(1, g_awake_mock->stats.wakes);
+    TEST_ASSERT_EQUAL(0, g_awake_mock->stats.idles);
+    TEST_ASSERT_EQUAL(ATCA_MOCK_STATE_ACTIVE, g_awake_mock->state);
+
+    /* The device is idled once the session ends */
+    TEST_ASSERT_SUCCESS(calib_keep_awake_end(g_awake_device));
+    TEST_ASSERT_EQUAL(1, g_awake_mock->stats.idles);
+    TEST_ASSERT_EQUAL(ATCA_MOCK_STATE_IDLE, g_awake_mock->state);
+}
+
+TEST(calib_keep_awake, nested)
+{
+    uint8_t random[RANDOM_NUM_SIZE];
+
+    TEST_ASSERT_EQUAL(ATCA_NOT_INITIALIZED, calib_keep_awake_end(g_awake_device));
+
+    TEST_ASSERT_SUCCESS(calib_keep_awake_begin(g_awake_device));
+    TEST_ASSERT_SUCCESS(calib_keep_awake_begin(g_awake_device));
+    TEST_ASSERT_SUCCESS(calib_random(g_awake_device, random));
+    TEST_ASSERT_SUCCESS(calib_keep_awake_end(g_awake_device));
+    TEST_ASSERT_EQUAL(0, g_awake_mock->stats.idles);
+
+    TEST_ASSERT_SUCCESS(calib_random(g_awake_device, random));
+    TEST_ASSERT_SUCCESS(calib_keep_awake_end(g_awake_device));
+    TEST_ASSERT_EQUAL(1, g_awake_mock->stats.wakes);
+    TEST_ASSERT_EQUAL(1, g_awake_mock->stats.idles);
+}
+
+TEST(calib_keep_awake, watchdog_budget)
+{
+    uint8_t random[RANDOM_NUM_SIZE];
+    int i;
+
+    /* A short watchdog with commands that would run into it if the device
+       were kept awake for all of them */
+    g_awake_mock->watchdog_usec = 200000;
+    atca_mock_set_exec_time(g_awake_mock, ATCA_RANDOM, 40000);
+    TEST_ASSERT_SUCCESS(calib_keep_awake_set_budget(g_awake_device, 120));
+
+    TEST_ASSERT_SUCCESS(calib_keep_awake_begin(g_awake_device));
+    for (i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_random(g_awake_device, random));
+    }
+    TEST_ASSERT_SUCCESS(calib_keep_awake_end(g_awake_device));
+
+    TEST_ASSERT_EQUAL(0, g_awake_mock->stats.watchdog_expiries);
+    TEST_ASSERT_TRUE(g_awake_mock->stats.wakes >= 3);
+    TEST_ASSERT_TRUE(g_awake_mock->stats.wakes < 10);
+    TEST_ASSERT_EQUAL(g_awake_mock->stats.wakes, g_awake_mock->stats.idles);
+}
+
+#ifdef ATCA_HAL_CLOCK
+TEST(calib_keep_awake, host_time)
+{
+    uint8_t random[RANDOM_NUM_SIZE];
+    int i;
+
+    /* Commands that finish quickly with the host busy in between would run
+       into the watchdog if only the time waited for them was counted. The
+       watchdog leaves room for the budget and one more pass of the loop, as a
+       command can start just inside the budget. */
+    g_awake_mock->watchdog_usec = 300000;
+    TEST_ASSERT_SUCCESS(calib_keep_awake_set_budget(g_awake_device, 120));
+
+    TEST_ASSERT_SUCCESS(calib_keep_awake_begin(g_awake_device));
+    for (i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_random(g_awake_device, random));
+        hal_delay_ms(80);
+    }
+    TEST_ASSERT_SUCCESS(calib_keep_awake_end(g_awake_device));
+
+    TEST_ASSERT_EQUAL(0, g_awake_mock->stats.watchdog_expiries);
+    TEST_ASSERT_TRUE(g_awake_mock->stats.wakes >= 2);
+    TEST_ASSERT_EQUAL(g_awake_mock->stats.wakes, g_awake_mock->stats.idles);
+}
+#endif
+
+TEST(calib_keep_awake, explicit_sleep)
+{
+    uint8_t random[RANDOM_NUM_SIZE];
+
+    /* Putting the device to sleep in a session means the next command wakes it */
+    TEST_ASSERT_SUCCESS(calib_keep_awake_begin(g_awake_device));
+    TEST_ASSERT_SUCCESS(calib_random(g_awake_device, random));
+    TEST_ASSERT_SUCCESS(calib_sleep(g_awake_device));
+    TEST_ASSERT_SUCCESS(calib_random(g_awake_device, random));
+    TEST_ASSERT_SUCCESS(calib_keep_awake_end(g_awake_device));
+
+    TEST_ASSERT_EQUAL(2, g_awake_mock->stats.wakes);
+    TEST_ASSERT_EQUAL(1, g_awake_mock->stats.sleeps);
+}
+
+TEST(calib_keep_awake, atcab)
+{
+    uint8_t random[RANDOM_NUM_SIZE];
+    int i;
+
+    TEST_ASSERT_SUCCESS(atcab_keep_awake_begin_ext(g_awake_device));
+    for (i = 0; i < KEEP_AWAKE_COMMANDS; i++)
+    {
+        TEST_ASSERT_SUCCESS(atcab_random_ext(g_awake_device, random));
+    }
+    TEST_ASSERT_SUCCESS(atcab_keep_awake_end_ext(g_awake_device));
+
+    TEST_ASSERT_EQUAL(1, g_awake_mock->stats.wakes);
+    TEST_ASSERT_EQUAL(1, g_awake_mock->stats.idles);
+}
+
+TEST_GROUP_RUNNER(calib_keep_awake)
+{
+    RUN_TEST_CASE(calib_keep_awake, idle_after_each_command);
+    RUN_TEST_CASE(calib_keep_awake, single_wake);
+    RUN_TEST_CASE(calib_keep_awake, nested);
+    RUN_TEST_CASE(calib_keep_awake, watchdog_budget);
+#ifdef ATCA_HAL_CLOCK
+    RUN_TEST_CASE(calib_keep_awake, host_time);
+#endif
+    RUN_TEST_CASE(calib_keep_awake, explicit_sleep);
+    RUN_TEST_CASE(calib_keep_awake, atcab);
+}
+
+#endif
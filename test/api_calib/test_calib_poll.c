@@ -0,0 +1,159 @@
+/**
+ * \file
+ * \brief Tests for the adaptive response polling scheduler run against the
+ *        simulated device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_POLL_ADAPTIVE) && !defined(ATCA_NO_POLL)
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+static atca_mock_bus_t g_poll_bus;
+static atca_mock_device_t* g_poll_mock;
+static ATCAIfaceCfg g_poll_cfg;
+static ATCADevice g_poll_device;
+
+TEST_GROUP(calib_poll);
+
+TEST_SETUP(calib_poll)
+{
+    g_poll_device = NULL;
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_poll_bus));
+    TEST_ASSERT_NOT_NULL(g_poll_mock = atca_mock_bus_add_device(&g_poll_bus, 0xC0));
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+
+    atca_mock_cfg_init(&g_poll_cfg, &g_poll_bus, ATECC608, 0xC0);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&g_poll_device, &g_poll_cfg));
+}
+
+TEST_TEAR_DOWN(calib_poll)
+{
+    (void)atcab_release_ext(&g_poll_device);
+    (void)atca_mock_hal_unregister();
+    atca_mock_bus_release(&g_poll_bus);
+}
+
+TEST(calib_poll, seeded_from_table)
+{
+    uint32_t estimate = 0;
+
+    /* ATECC608 at the M0 clock divider */
+    TEST_ASSERT_SUCCESS(calib_poll_get_estimate(g_poll_device, ATCA_SIGN, &estimate));
+    TEST_ASSERT_EQUAL(115, estimate);
+    TEST_ASSERT_SUCCESS(calib_poll_get_estimate(g_poll_device, ATCA_RANDOM, &estimate));
+    TEST_ASSERT_EQUAL(23, estimate);
+
+    /* Commands without a table entry start from the fixed polling schedule */
+    TEST_ASSERT_SUCCESS(calib_poll_get_estimate(g_poll_device, 0x7F, &estimate));
+    TEST_ASSERT_EQUAL(ATCA_POLLING_INIT_TIME_MSEC + ATCA_POLLING_GUARD_TIME_MSEC, estimate);
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, calib_poll_get_estimate(g_poll_device, ATCA_SIGN, NULL));
+}
+
+TEST(calib_poll, backoff)
+{
+    uint32_t delay = ATCA_POLLING_FREQUENCY_TIME_MSEC;
+    int i;
+
+    for (i = 0; i < 10; i++)
+    {
+        uint32_t next = calib_poll_next_delay(delay);
+        TEST_ASSERT_TRUE(next >= delay);
+        TEST_ASSERT_TRUE(next <= ATCA_POLLING_BACKOFF_MAX_MSEC);
+        delay = next;
+    }
+    TEST_ASSERT_EQUAL(ATCA_POLLING_BACKOFF_MAX_MSEC, delay);
+}
+
+TEST(calib_poll, converges_on_faster_device)
+{
+    uint8_t msg[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signature[ATCA_ECCP256_SIG_SIZE];
+    uint32_t estimate = 0;
+    uint32_t nacks;
+    int i;
+
+    memset(msg, 0x5A, sizeof(msg));
+
+    /* The simulated device signs in 40ms rather than the 115ms in the table */
+    atca_mock_set_exec_time(g_poll_mock, ATCA_SIGN, 40000);
+
+    for (i = 0; i < 16; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_sign(g_poll_device, 0, msg, signature));
+    }
+
+    TEST_ASSERT_SUCCESS(calib_poll_get_estimate(g_poll_device, ATCA_SIGN, &estimate));
+    TEST_ASSERT_TRUE(estimate < 60);
+
+    atca_mock_reset_stats(g_poll_mock);
+    for (i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_sign(g_poll_device, 0, msg, signature));
+    }
+
+    /* The fixed schedule polls every 2ms from 1ms so would be turned away ~19
+       times per sign - once learned only a few polls should be early */
+    nacks = g_poll_mock->stats.nacks;
+    TEST_ASSERT_EQUAL(30, g_poll_mock->stats.commands);
+    TEST_ASSERT_TRUE_MESSAGE(nacks <= 10 * 3, "Too many polls while the device was busy");
+}
+
+TEST(calib_poll, tracks_slower_device)
+{
+    uint8_t data[ATCA_BLOCK_SIZE];
+    uint32_t before = 0;
+    uint32_t after = 0;
+    int i;
+
+    TEST_ASSERT_SUCCESS(calib_poll_get_estimate(g_poll_device, ATCA_READ, &before));
+
+    /* Reads take longer than the table says - they must still complete and
+       the schedule should move out towards the real time */
+    atca_mock_set_exec_time(g_poll_mock, ATCA_READ, 30000);
+    for (i = 0; i < 8; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_read_zone(g_poll_device, ATCA_ZONE_CONFIG, 0, 0, 0, data, sizeof(data)));
+    }
+
+    TEST_ASSERT_SUCCESS(calib_poll_get_estimate(g_poll_device, ATCA_READ, &after));
+    TEST_ASSERT_TRUE(after > before);
+    TEST_ASSERT_TRUE(after <= 40);
+}
+
+TEST_GROUP_RUNNER(calib_poll)
+{
+    RUN_TEST_CASE(calib_poll, seeded_from_table);
+    RUN_TEST_CASE(calib_poll, backoff);
+    RUN_TEST_CASE(calib_poll, converges_on_faster_device);
+    RUN_TEST_CASE(calib_poll, tracks_slower_device);
+}
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * \file
+ * \brief Tests for planned zone reads run against the simulated device
+ *        hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define READ_PLAN_CERT_SLOT         (8)
+#define READ_PLAN_SHORT_SLOT        (9)     /* 72 bytes so the last block is read a word at a time */
+
+static atca_mock_bus_t g_plan_bus;
+static atca_mock_device_t* g_plan_mock;
+static ATCAIfaceCfg g_plan_cfg;
+static ATCADevice g_plan_device;
+static uint8_t g_plan_cert_slot[ATCA_MOCK_SLOT_SIZE];
+static uint8_t g_plan_short_slot[72];
+
+TEST_GROUP(calib_read_plan);
+
+TEST_SETUP(calib_read_plan)
+{
+    size_t i;
+
+    g_plan_device = NULL;
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_plan_bus));
+    TEST_ASSERT_NOT_NULL(g_plan_mock = atca_mock_bus_add_device(&g_plan_bus, 0xC0));
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+
+    atca_mock_cfg_init(&g_plan_cfg, &g_plan_bus, ATECC608, 0xC0);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&g_plan_device, &g_plan_cfg));
+
+    for (i = 0; i < sizeof(g_plan_cert_slot); i++)
+    {
+        g_plan_cert_slot[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (i = 0; i < sizeof(g_plan_short_slot); i++)
+    {
+        g_plan_short_slot[i] = (uint8_t)(0xA0 ^ i);
+    }
+    TEST_ASSERT_SUCCESS(calib_write_bytes_zone(g_plan_device, ATCA_ZONE_DATA, READ_PLAN_CERT_SLOT, 0, g_plan_cert_slot, sizeof(g_plan_cert_slot)));
+    TEST_ASSERT_SUCCESS(calib_write_bytes_zone(g_plan_device, ATCA_ZONE_DATA, READ_PLAN_SHORT_SLOT, 0, g_plan_short_slot, sizeof(g_plan_short_slot)));
+    atca_mock_reset_stats(g_plan_mock);
+}
+
+TEST_TEAR_DOWN(calib_read_plan)
+{
+    (void)atcab_release_ext(&g_plan_device);
+    (void)atca_mock_hal_unregister();
+    atca_mock_bus_release(&g_plan_bus);
+}
+
+TEST(calib_read_plan, full_slot_single_wake)
+{
+    uint8_t data[ATCA_MOCK_SLOT_SIZE];
+
+    TEST_ASSERT_SUCCESS(calib_read_bytes_zone(g_plan_device, ATCA_ZONE_DATA, READ_PLAN_CERT_SLOT, 0, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_MEMORY(g_plan_cert_slot, data, sizeof(data));
+
+    /* 13 block reads in one awake window instead of 13 wake/idle cycles */
+    TEST_ASSERT_EQUAL(13, g_plan_mock->stats.commands);
+    TEST_ASSERT_EQUAL(13, g_plan_mock->stats.opcode_count[ATCA_READ]);
+    TEST_ASSERT_EQUAL(1, g_plan_mock->stats.wakes);
+    TEST_ASSERT_EQUAL(1, g_plan_mock->stats.idles);
+
+    atca_mock_reset_stats(g_plan_mock);
+    TEST_ASSERT_SUCCESS(calib_read_config_zone(g_plan_device, data));
+    TEST_ASSERT_EQUAL(ATCA_ECC_CONFIG_SIZE / ATCA_BLOCK_SIZE, g_plan_mock->stats.commands);
+    TEST_ASSERT_EQUAL(1, g_plan_mock->stats.wakes);
+}
+
+TEST(calib_read_plan, merged_ranges)
+{
+    uint8_t cert_a[40];
+    uint8_t cert_b[30];
+    uint8_t cert_c[50];
+    uint8_t cert_dup[30];
+    uint8_t short_tail[12];
+    uint8_t serial[13];
+    uint8_t serial_part[4];
+    calib_read_range_t ranges[] = {
+        { ATCA_ZONE_DATA,   READ_PLAN_CERT_SLOT,  100, sizeof(cert_c),      cert_c      },
+        { ATCA_ZONE_CONFIG, 0,                    0,   sizeof(serial),      serial      },
+        { ATCA_ZONE_DATA,   READ_PLAN_CERT_SLOT,  0,   sizeof(cert_a),      cert_a      },
+        { ATCA_ZONE_DATA,   READ_PLAN_SHORT_SLOT, 60,  sizeof(short_tail),  short_tail  },
+        { ATCA_ZONE_DATA,   READ_PLAN_CERT_SLOT,  40,  sizeof(cert_b),      cert_b      },
+        { ATCA_ZONE_CONFIG, 7,                    8,   sizeof(serial_part), serial_part },
+        { ATCA_ZONE_DATA,   READ_PLAN_CERT_SLOT,  40,  sizeof(cert_dup),    cert_dup    },
+    };
+    uint8_t config[ATCA_BLOCK_SIZE];
+    uint32_t separate = 0;
+    size_t i;
+
+    /* Read one range at a time for comparison */
+    for (i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++)
+    {
+        atca_mock_reset_stats(g_plan_mock);
+        TEST_ASSERT_SUCCESS(calib_read_bytes_zone(g_plan_device, ranges[i].zone, ranges[i].slot, ranges[i].offset,
+                                                  ranges[i].data, ranges[i].length));
+        separate += g_plan_mock->stats.commands;
+    }
+    TEST_ASSERT_EQUAL(13, separate);
+    memset(cert_a, 0, sizeof(cert_a));
+    memset(cert_b, 0, sizeof(cert_b));
+    memset(cert_c, 0, sizeof(cert_c));
+    memset(cert_dup, 0, sizeof(cert_dup));
+    memset(short_tail, 0, sizeof(short_tail));
+    memset(serial, 0, sizeof(serial));
+
+    /* Blocks 0-4 of the certificate slot, block 1 and two words of the short
+       slot and config block 0 - each read once */
+    atca_mock_reset_stats(g_plan_mock);
+    TEST_ASSERT_SUCCESS(calib_read_ranges(g_plan_device, ranges, sizeof(ranges) / sizeof(ranges[0])));
+    TEST_ASSERT_EQUAL(9, g_plan_mock->stats.commands);
+    TEST_ASSERT_EQUAL(1, g_plan_mock->stats.wakes);
+    TEST_ASSERT_EQUAL(1, g_plan_mock->stats.idles);
+
+    TEST_ASSERT_EQUAL_MEMORY(&g_plan_cert_slot[0], cert_a, sizeof(cert_a));
+    TEST_ASSERT_EQUAL_MEMORY(&g_plan_cert_slot[40], cert_b, sizeof(cert_b));
+    TEST_ASSERT_EQUAL_MEMORY(&g_plan_cert_slot[40], cert_dup, sizeof(cert_dup));
+    TEST_ASSERT_EQUAL_MEMORY(&g_plan_cert_slot[100], cert_c, sizeof(cert_c));
+    TEST_ASSERT_EQUAL_MEMORY(&g_plan_short_slot[60], short_tail, sizeof(short_tail));
+
+    TEST_ASSERT_SUCCESS(calib_read_zone(g_plan_device, ATCA_ZONE_CONFIG, 0, 0, 0, config, sizeof(config)));
+    TEST_ASSERT_EQUAL_MEMORY(config, serial, sizeof(serial));
+    TEST_ASSERT_EQUAL_MEMORY(&config[8], serial_part, sizeof(serial_part));
+}
+
+TEST(calib_read_plan, errors)
+{
+    uint8_t data[ATCA_BLOCK_SIZE];
+    calib_read_range_t ranges[] = {
+        { ATCA_ZONE_DATA, READ_PLAN_CERT_SLOT,  0,  sizeof(data), data },
+        { ATCA_ZONE_DATA, READ_PLAN_SHORT_SLOT, 64, sizeof(data), data },
+    };
+
+    /* Nothing is read when any range is invalid */
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, calib_read_ranges(g_plan_device, ranges, 2));
+    ranges[1].zone = 7;
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, calib_read_ranges(g_plan_device, ranges, 2));
+    TEST_ASSERT_EQUAL(0, g_plan_mock->stats.commands);
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, calib_read_ranges(NULL, ranges, 1));
+    TEST_ASSERT_SUCCESS(calib_read_ranges(g_plan_device, NULL, 0));
+}
+
+TEST_GROUP_RUNNER(calib_read_plan)
+{
+    RUN_TEST_CASE(calib_read_plan, full_slot_single_wake);
+    RUN_TEST_CASE(calib_read_plan, merged_ranges);
+    RUN_TEST_CASE(calib_read_plan, errors);
+}
+
+#endif
@@ -0,0 +1,192 @@
+/**
+ * \file
+ * \brief Tests and a throughput benchmark for the SHA-256 offload policy run
+ *        against the simulated device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define SHA_OFFLOAD_MAX_SIZE        (1024 * 1024)
+#define SHA_OFFLOAD_DEVICE_RUN      (16 * 1024)
+
+static atca_mock_bus_t g_offload_bus;
+static atca_mock_device_t* g_offload_mock;
+static ATCAIfaceCfg g_offload_cfg;
+static ATCADevice g_offload_device;
+static uint8_t g_offload_message[SHA_OFFLOAD_MAX_SIZE];
+
+/** \brief Hash the start of the test message with the given policy */
+static void offload_hash(atca_sha_offload_t policy, size_t size, uint8_t* digest)
+{
+    TEST_ASSERT_SUCCESS(calib_sha_set_offload(g_offload_device, policy, 0));
+    atca_mock_reset_stats(g_offload_mock);
+    TEST_ASSERT_SUCCESS(calib_hw_sha2_256(g_offload_device, g_offload_message, size, digest));
+}
+
+TEST_GROUP(calib_sha_offload);
+
+TEST_SETUP(calib_sha_offload)
+{
+    size_t i;
+
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_offload_bus));
+    TEST_ASSERT_NOT_NULL(g_offload_mock = atca_mock_bus_add_device(&g_offload_bus, 0xC0));
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+
+    /* Only the bus and the host are measured by the benchmark */
+    atca_mock_set_exec_time(g_offload_mock, ATCA_SHA, 0);
+
+    g_offload_device = NULL;
+    atca_mock_cfg_init(&g_offload_cfg, &g_offload_bus, ATECC608, 0xC0);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&g_offload_device, &g_offload_cfg));
+
+    for (i = 0; i < sizeof(g_offload_message); i++)
+    {
+        g_offload_message[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+}
+
+TEST_TEAR_DOWN(calib_sha_offload)
+{
+    (void)atcab_release_ext(&g_offload_device);
+    (void)atca_mock_hal_unregister();
+    atca_mock_bus_release(&g_offload_bus);
+}
+
+TEST(calib_sha_offload, policies)
+{
+    uint8_t expected[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+
+    TEST_ASSERT_SUCCESS(atcac_sw_sha2_256(g_offload_message, 1000, expected));
+
+    offload_hash(ATCA_SHA_OFFLOAD_DEVICE, 1000, digest);
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(digest));
+    TEST_ASSERT_EQUAL(17, g_offload_mock->stats.opcode_count[ATCA_SHA]);
+    TEST_ASSERT_EQUAL_MEMORY(expected, g_offload_mock->tempkey, sizeof(expected));
+
+    /* Nothing is sent to the device */
+    memset(g_offload_mock->tempkey, 0, sizeof(g_offload_mock->tempkey));
+    offload_hash(ATCA_SHA_OFFLOAD_HOST, 1000, digest);
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(digest));
+    TEST_ASSERT_EQUAL(0, g_offload_mock->stats.commands);
+
+    /* The device is left as the SHA command leaves it with one command */
+    offload_hash(ATCA_SHA_OFFLOAD_HYBRID, 1000, digest);
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(digest));
+    TEST_ASSERT_EQUAL(1, g_offload_mock->stats.commands);
+    TEST_ASSERT_EQUAL(1, g_offload_mock->stats.opcode_count[ATCA_NONCE]);
+    TEST_ASSERT_EQUAL_MEMORY(expected, g_offload_mock->tempkey, sizeof(expected));
+}
+
+TEST(calib_sha_offload, threshold)
+{
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+
+    TEST_ASSERT_SUCCESS(calib_sha_set_offload(g_offload_device, ATCA_SHA_OFFLOAD_HOST, 1024));
+
+    /* Short messages stay on the device */
+    atca_mock_reset_stats(g_offload_mock);
+    TEST_ASSERT_SUCCESS(calib_hw_sha2_256(g_offload_device, g_offload_message, 64, digest));
+    TEST_ASSERT_EQUAL(3, g_offload_mock->stats.opcode_count[ATCA_SHA]);
+
+    atca_mock_reset_stats(g_offload_mock);
+    TEST_ASSERT_SUCCESS(calib_hw_sha2_256(g_offload_device, g_offload_message, 1024, digest));
+    TEST_ASSERT_EQUAL(0, g_offload_mock->stats.commands);
+
+    /* Messages of exactly the threshold are offloaded */
+    TEST_ASSERT_EQUAL(ATCA_SHA_OFFLOAD_DEVICE, calib_sha_get_offload(g_offload_device, 1023));
+    TEST_ASSERT_EQUAL(ATCA_SHA_OFFLOAD_HOST, calib_sha_get_offload(g_offload_device, 1024));
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, calib_sha_set_offload(NULL, ATCA_SHA_OFFLOAD_HOST, 0));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, calib_sha_set_offload(g_offload_device, (atca_sha_offload_t)7, 0));
+}
+
+TEST(calib_sha_offload, throughput)
+{
+    const size_t sizes[] = { 64, 1024, SHA_OFFLOAD_MAX_SIZE };
+    const atca_sha_offload_t policies[] = { ATCA_SHA_OFFLOAD_DEVICE, ATCA_SHA_OFFLOAD_HOST, ATCA_SHA_OFFLOAD_HYBRID };
+    const char* names[] = { "device", "host", "hybrid" };
+    uint64_t elapsed[3];
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    char line[112];
+    size_t i;
+    size_t j;
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        for (j = 0; j < sizeof(policies) / sizeof(policies[0]); j++)
+        {
+            size_t run_size = sizes[i];
+            uint32_t commands;
+            uint64_t start;
+
+            /* A megabyte through the device takes most of a minute so its
+               time is projected from a shorter run at the same rate */
+            if (ATCA_SHA_OFFLOAD_DEVICE == policies[j] && run_size > SHA_OFFLOAD_DEVICE_RUN)
+            {
+                run_size = SHA_OFFLOAD_DEVICE_RUN;
+            }
+
+            start = atca_mock_time_usec();
+            offload_hash(policies[j], run_size, digest);
+            elapsed[j] = (atca_mock_time_usec() - start) * (sizes[i] / run_size);
+            commands = g_offload_mock->stats.commands;
+            if (run_size != sizes[i])
+            {
+                commands = (uint32_t)(sizes[i] / ATCA_SHA256_BLOCK_SIZE + 2);
+            }
+
+            (void)snprintf(line, sizeof(line), "sha256 %7lu bytes %-6s %6lu commands %9lu usec %9lu KB/s%s",
+                           (unsigned long)sizes[i], names[j], (unsigned long)commands, (unsigned long)elapsed[j],
+                           (unsigned long)(elapsed[j] ? (uint64_t)sizes[i] * 1000000 / 1024 / elapsed[j] : 0),
+                           run_size != sizes[i] ? " (projected)" : "");
+            TEST_MESSAGE(line);
+        }
+
+        /* Hashing on the host wins as soon as there is more than a block */
+        if (sizes[i] > ATCA_SHA256_BLOCK_SIZE)
+        {
+            TEST_ASSERT_TRUE(elapsed[1] < elapsed[0]);
+            TEST_ASSERT_TRUE(elapsed[2] < elapsed[0]);
+        }
+    }
+}
+
+TEST_GROUP_RUNNER(calib_sha_offload)
+{
+    RUN_TEST_CASE(calib_sha_offload, policies);
+    RUN_TEST_CASE(calib_sha_offload, threshold);
+    RUN_TEST_CASE(calib_sha_offload, throughput);
+}
+
+#endif
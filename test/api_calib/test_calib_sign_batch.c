@@ -0,0 +1,167 @@
+/**
+ * \file
+ * \brief Tests for batch signing run against the simulated device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define SIGN_BATCH_COUNT        (8)
+
+static atca_mock_bus_t g_batch_bus;
+static atca_mock_device_t* g_batch_mock;
+static ATCAIfaceCfg g_batch_cfg;
+static ATCADevice g_batch_device;
+
+static void batch_fill_digests(uint8_t* digests, size_t count)
+{
+    size_t i;
+
+    for (i = 0; i < count * ATCA_SHA256_DIGEST_SIZE; i++)
+    {
+        digests[i] = (uint8_t)(i * 7 + i / ATCA_SHA256_DIGEST_SIZE);
+    }
+}
+
+TEST_GROUP(calib_sign_batch);
+
+TEST_SETUP(calib_sign_batch)
+{
+    g_batch_device = NULL;
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_batch_bus));
+    TEST_ASSERT_NOT_NULL(g_batch_mock = atca_mock_bus_add_device(&g_batch_bus, 0xC0));
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+
+    atca_mock_cfg_init(&g_batch_cfg, &g_batch_bus, ATECC608, 0xC0);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&g_batch_device, &g_batch_cfg));
+    atca_mock_reset_stats(g_batch_mock);
+}
+
+TEST_TEAR_DOWN(calib_sign_batch)
+{
+    (void)atcab_release_ext(&g_batch_device);
+    (void)atca_mock_hal_unregister();
+    atca_mock_bus_release(&g_batch_bus);
+}
+
+TEST(calib_sign_batch, single_wake)
+{
+    uint8_t digests[SIGN_BATCH_COUNT * ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signatures[SIGN_BATCH_COUNT * ATCA_ECCP256_SIG_SIZE];
+    uint8_t expected[ATCA_ECCP256_SIG_SIZE];
+    ATCA_STATUS item_status[SIGN_BATCH_COUNT];
+    size_t i;
+
+    batch_fill_digests(digests, SIGN_BATCH_COUNT);
+
+    TEST_ASSERT_SUCCESS(calib_sign_batch(g_batch_device, 0, digests, SIGN_BATCH_COUNT, signatures, item_status));
+
+    /* One wake and idle and one seed update for the whole batch */
+    TEST_ASSERT_EQUAL(1, g_batch_mock->stats.wakes);
+    TEST_ASSERT_EQUAL(1, g_batch_mock->stats.idles);
+    TEST_ASSERT_EQUAL(1, g_batch_mock->stats.opcode_count[ATCA_RANDOM]);
+    TEST_ASSERT_EQUAL(SIGN_BATCH_COUNT, g_batch_mock->stats.opcode_count[ATCA_NONCE]);
+    TEST_ASSERT_EQUAL(SIGN_BATCH_COUNT, g_batch_mock->stats.opcode_count[ATCA_SIGN]);
+
+    /* Each signature matches signing the digest on its own */
+    for (i = 0; i < SIGN_BATCH_COUNT; i++)
+    {
+        TEST_ASSERT_SUCCESS(item_status[i]);
+        TEST_ASSERT_SUCCESS(calib_sign(g_batch_device, 0, &digests[i * ATCA_SHA256_DIGEST_SIZE], expected));
+        TEST_ASSERT_EQUAL_MEMORY(expected, &signatures[i * ATCA_ECCP256_SIG_SIZE], sizeof(expected));
+    }
+}
+
+TEST(calib_sign_batch, item_status)
+{
+    uint8_t digests[SIGN_BATCH_COUNT * ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signatures[SIGN_BATCH_COUNT * ATCA_ECCP256_SIG_SIZE];
+    ATCA_STATUS item_status[SIGN_BATCH_COUNT];
+    size_t i;
+
+    batch_fill_digests(digests, SIGN_BATCH_COUNT);
+
+    /* The fourth signature fails on the device and the rest still complete */
+    atca_mock_fail_command(g_batch_mock, ATCA_SIGN, 4);
+    TEST_ASSERT_EQUAL(ATCA_EXECUTION_ERROR, calib_sign_batch(g_batch_device, 0, digests, SIGN_BATCH_COUNT, signatures, item_status));
+
+    for (i = 0; i < SIGN_BATCH_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(3 == i ? ATCA_EXECUTION_ERROR : ATCA_SUCCESS, item_status[i]);
+    }
+    TEST_ASSERT_EQUAL(SIGN_BATCH_COUNT, g_batch_mock->stats.opcode_count[ATCA_SIGN]);
+}
+
+TEST(calib_sign_batch, watchdog)
+{
+    uint8_t digests[6 * ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signatures[6 * ATCA_ECCP256_SIG_SIZE];
+    ATCA_STATUS item_status[6];
+    size_t i;
+
+    batch_fill_digests(digests, 6);
+
+    /* Six 250ms signatures would run the device past its watchdog in one
+       awake period so it has to be idled and woken part way through */
+    atca_mock_set_exec_time(g_batch_mock, ATCA_SIGN, 250000);
+    TEST_ASSERT_SUCCESS(calib_sign_batch(g_batch_device, 0, digests, 6, signatures, item_status));
+
+    for (i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_SUCCESS(item_status[i]);
+    }
+    TEST_ASSERT_EQUAL(0, g_batch_mock->stats.watchdog_expiries);
+    TEST_ASSERT_TRUE(g_batch_mock->stats.wakes > 1);
+    TEST_ASSERT_TRUE(g_batch_mock->stats.wakes < 6);
+}
+
+TEST(calib_sign_batch, atcab)
+{
+    uint8_t digests[2 * ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signatures[2 * ATCA_ECCP256_SIG_SIZE];
+
+    batch_fill_digests(digests, 2);
+
+    TEST_ASSERT_SUCCESS(atcab_sign_batch_ext(g_batch_device, 0, digests, 2, signatures, NULL));
+    TEST_ASSERT_EQUAL(1, g_batch_mock->stats.wakes);
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcab_sign_batch_ext(g_batch_device, 0, NULL, 2, signatures, NULL));
+}
+
+TEST_GROUP_RUNNER(calib_sign_batch)
+{
+    RUN_TEST_CASE(calib_sign_batch, single_wake);
+    RUN_TEST_CASE(calib_sign_batch, item_status);
+    RUN_TEST_CASE(calib_sign_batch, watchdog);
+    RUN_TEST_CASE(calib_sign_batch, atcab);
+}
+
+#endif
@@ -0,0 +1,198 @@
+/**
+ * \file
+ * \brief Tests for bulk AES CTR processing run against the simulated device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define CTR_BULK_KEY_ID         (5)
+#define CTR_BULK_BLOCKS         (64)
+
+static atca_mock_bus_t g_ctr_bulk_bus;
+static atca_mock_device_t* g_ctr_bulk_mock;
+static ATCAIfaceCfg g_ctr_bulk_cfg;
+static ATCADevice g_ctr_bulk_device;
+static const uint8_t g_ctr_bulk_iv[ATCA_AES128_BLOCK_SIZE] = {
+    0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFD
+};
+
+static void ctr_bulk_fill(uint8_t* data, size_t size)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        data[i] = (uint8_t)(i * 13 + 7);
+    }
+}
+
+/** \brief Process data a block at a time with atcab_aes_ctr_block */
+static void ctr_bulk_reference(const uint8_t* input, uint8_t* output, size_t size)
+{
+    atca_aes_ctr_ctx_t ctx;
+    uint8_t block[ATCA_AES128_BLOCK_SIZE];
+    size_t i;
+
+    TEST_ASSERT_SUCCESS(atcab_aes_ctr_init_ext(g_ctr_bulk_device, &ctx, CTR_BULK_KEY_ID, 0, 4, g_ctr_bulk_iv));
+    for (i = 0; i < size; i += ATCA_AES128_BLOCK_SIZE)
+    {
+        size_t count = (size - i < sizeof(block)) ? size - i : sizeof(block);
+
+        memset(block, 0, sizeof(block));
+        memcpy(block, &input[i], count);
+        TEST_ASSERT_SUCCESS(atcab_aes_ctr_block(&ctx, block, block));
+        memcpy(&output[i], block, count);
+    }
+}
+
+TEST_GROUP(atca_crypto_aes_ctr_bulk);
+
+TEST_SETUP(atca_crypto_aes_ctr_bulk)
+{
+    g_ctr_bulk_device = NULL;
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_ctr_bulk_bus));
+    TEST_ASSERT_NOT_NULL(g_ctr_bulk_mock = atca_mock_bus_add_device(&g_ctr_bulk_bus, 0xC0));
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+
+    atca_mock_cfg_init(&g_ctr_bulk_cfg, &g_ctr_bulk_bus, ATECC608, 0xC0);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&g_ctr_bulk_device, &g_ctr_bulk_cfg));
+    atca_mock_reset_stats(g_ctr_bulk_mock);
+}
+
+TEST_TEAR_DOWN(atca_crypto_aes_ctr_bulk)
+{
+    (void)atcab_release_ext(&g_ctr_bulk_device);
+    (void)atca_mock_hal_unregister();
+    atca_mock_bus_release(&g_ctr_bulk_bus);
+}
+
+TEST(atca_crypto_aes_ctr_bulk, any_length)
+{
+    const size_t splits[] = { 1, 15, 33, 0, 51 };
+    atca_aes_ctr_ctx_t ctr;
+    atca_aes_ctr_bulk_ctx_t ctx;
+    uint8_t plaintext[100];
+    uint8_t ciphertext[sizeof(plaintext)];
+    uint8_t expected[sizeof(plaintext)];
+    size_t offset = 0;
+    size_t i;
+
+    ctr_bulk_fill(plaintext, sizeof(plaintext));
+    ctr_bulk_reference(plaintext, expected, sizeof(plaintext));
+
+    /* The data may be split anywhere and still uses the keystream in order */
+    TEST_ASSERT_SUCCESS(atcab_aes_ctr_init_ext(g_ctr_bulk_device, &ctr, CTR_BULK_KEY_ID, 0, 4, g_ctr_bulk_iv));
+    TEST_ASSERT_SUCCESS(atcab_aes_ctr_bulk_init(&ctx, &ctr));
+    for (i = 0; i < sizeof(splits) / sizeof(splits[0]); i++)
+    {
+        TEST_ASSERT_SUCCESS(atcab_aes_ctr_bulk(&ctx, &plaintext[offset], &ciphertext[offset], splits[i]));
+        offset += splits[i];
+    }
+    TEST_ASSERT_EQUAL(sizeof(plaintext), offset);
+    TEST_ASSERT_EQUAL_MEMORY(expected, ciphertext, sizeof(expected));
+
+    /* Decrypting in place restores the plaintext */
+    TEST_ASSERT_SUCCESS(atcab_aes_ctr_bulk_init(&ctx, &ctr));
+    TEST_ASSERT_SUCCESS(atcab_aes_ctr_bulk(&ctx, ciphertext, ciphertext, sizeof(ciphertext)));
+    TEST_ASSERT_EQUAL_MEMORY(plaintext, ciphertext, sizeof(plaintext));
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcab_aes_ctr_bulk(&ctx, NULL, ciphertext, 1));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcab_aes_ctr_bulk_init(&ctx, NULL));
+}
+
+TEST(atca_crypto_aes_ctr_bulk, single_wake)
+{
+    atca_aes_ctr_ctx_t ctr;
+    atca_aes_ctr_bulk_ctx_t ctx;
+    uint8_t plaintext[CTR_BULK_BLOCKS * ATCA_AES128_BLOCK_SIZE];
+    uint8_t ciphertext[sizeof(plaintext)];
+    uint8_t expected[sizeof(plaintext)];
+    uint64_t start;
+    uint64_t bulk_usec;
+    uint64_t block_usec;
+    char msg[128];
+
+    ctr_bulk_fill(plaintext, sizeof(plaintext));
+
+    start = atca_mock_time_usec();
+    ctr_bulk_reference(plaintext, expected, sizeof(plaintext));
+    block_usec = atca_mock_time_usec() - start;
+
+    /* Every block is woken for and idled after on its own */
+    TEST_ASSERT_EQUAL(CTR_BULK_BLOCKS, g_ctr_bulk_mock->stats.wakes);
+    atca_mock_reset_stats(g_ctr_bulk_mock);
+
+    TEST_ASSERT_SUCCESS(atcab_aes_ctr_init_ext(g_ctr_bulk_device, &ctr, CTR_BULK_KEY_ID, 0, 4, g_ctr_bulk_iv));
+    TEST_ASSERT_SUCCESS(atcab_aes_ctr_bulk_init(&ctx, &ctr));
+    start = atca_mock_time_usec();
+    TEST_ASSERT_SUCCESS(atcab_aes_ctr_bulk(&ctx, plaintext, ciphertext, sizeof(plaintext)));
+    bulk_usec = atca_mock_time_usec() - start;
+
+    TEST_ASSERT_EQUAL_MEMORY(expected, ciphertext, sizeof(expected));
+
+    /* The whole buffer is one awake period. The block after the data is
+       computed while the last one is used and kept for the next call. */
+    TEST_ASSERT_EQUAL(1, g_ctr_bulk_mock->stats.wakes);
+    TEST_ASSERT_EQUAL(1, g_ctr_bulk_mock->stats.idles);
+    TEST_ASSERT_EQUAL(CTR_BULK_BLOCKS + 1, g_ctr_bulk_mock->stats.opcode_count[ATCA_AES]);
+    TEST_ASSERT_EQUAL(1, ctx.count);
+
+    (void)snprintf(msg, sizeof(msg), "%u blocks: %.0f usec per block bulk, %.0f usec per block one at a time",
+                   CTR_BULK_BLOCKS, (double)bulk_usec / CTR_BULK_BLOCKS, (double)block_usec / CTR_BULK_BLOCKS);
+    TEST_MESSAGE(msg);
+}
+
+TEST(atca_crypto_aes_ctr_bulk, device_error)
+{
+    atca_aes_ctr_ctx_t ctr;
+    atca_aes_ctr_bulk_ctx_t ctx;
+    uint8_t data[8 * ATCA_AES128_BLOCK_SIZE];
+
+    ctr_bulk_fill(data, sizeof(data));
+
+    /* A failed block is reported and the device is still idled */
+    atca_mock_fail_command(g_ctr_bulk_mock, ATCA_AES, 3);
+    TEST_ASSERT_SUCCESS(atcab_aes_ctr_init_ext(g_ctr_bulk_device, &ctr, CTR_BULK_KEY_ID, 0, 4, g_ctr_bulk_iv));
+    TEST_ASSERT_SUCCESS(atcab_aes_ctr_bulk_init(&ctx, &ctr));
+    TEST_ASSERT_EQUAL(ATCA_EXECUTION_ERROR, atcab_aes_ctr_bulk(&ctx, data, data, sizeof(data)));
+    TEST_ASSERT_EQUAL(3, g_ctr_bulk_mock->stats.opcode_count[ATCA_AES]);
+    TEST_ASSERT_EQUAL(1, g_ctr_bulk_mock->stats.idles);
+}
+
+TEST_GROUP_RUNNER(atca_crypto_aes_ctr_bulk)
+{
+    RUN_TEST_CASE(atca_crypto_aes_ctr_bulk, any_length);
+    RUN_TEST_CASE(atca_crypto_aes_ctr_bulk, single_wake);
+    RUN_TEST_CASE(atca_crypto_aes_ctr_bulk, device_error);
+}
+
+#endif
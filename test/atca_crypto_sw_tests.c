@@ -31,12 +31,16 @@
 #include "crypto/atca_crypto_sw.h"
 #include "crypto/atca_crypto_sw_sha1.h"
 #include "crypto/atca_crypto_sw_sha2.h"
+#include "crypto/atca_crypto_sw_ecdsa.h"
+#include "crypto/hashes/sha2_routines.h"
+#include <time.h>
 
 
 #include "vectors/aes_gcm_nist_vectors.h"
 #include "vectors/aes_cmac_nist_vectors.h"
 #include "vectors/ecdsa_nist_vectors.h"
 #include "vectors/ecdh_nist_vectors.h"
+#include "vectors/pbkdf2_sha256_vectors.h"
 
 static const uint8_t nist_hash_msg1[] = "abc";
 static const uint8_t nist_hash_msg2[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
@@ -62,6 +66,16 @@ int atca_crypto_sw_tests(int argc, char * argv[])
     RUN_TEST(test_atcac_sw_sha2_256_nist_short);
     RUN_TEST(test_atcac_sw_sha2_256_nist_long);
     RUN_TEST(test_atcac_sw_sha2_256_nist_monte);
+#if ATCA_ENABLE_SHA256_IMPL
+    RUN_TEST(test_sw_sha256_impl_nist);
+#endif
+    RUN_TEST(test_atcac_sw_sha2_256_multi);
+    RUN_TEST(test_atcac_sw_sha2_256_multi_speed);
+    RUN_TEST(test_atcac_pbkdf2_sha256);
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256_nist);
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256_speed);
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256_batch);
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256_batch_speed);
 
     RUN_TEST(test_atcac_sha256_hmac);
     RUN_TEST(test_atcac_sha256_hmac_nist);
@@ -529,6 +543,430 @@ void test_atcac_sw_sha2_256_nist_monte(void)
 #endif
 }
 
+#if ATCA_ENABLE_SHA256_IMPL
+/** \brief Runs the SHA-256 vectors against each block implementation the
+ *         processor supports rather than only the one picked automatically
+ */
+void test_sw_sha256_impl_nist(void)
+{
+    static const sw_sha256_impl_t impls[] = { SW_SHA256_IMPL_PORTABLE, SW_SHA256_IMPL_SHA_NI, SW_SHA256_IMPL_ARMV8 };
+    size_t tested = 0;
+    size_t i;
+
+    for (i = 0; i < sizeof(impls) / sizeof(impls[0]); i++)
+    {
+        if (0 != sw_sha256_select(impls[i]))
+        {
+            continue;
+        }
+        TEST_ASSERT_EQUAL(impls[i], sw_sha256_get_impl());
+
+        test_atcac_sw_sha2_256_nist1();
+        test_atcac_sw_sha2_256_nist2();
+        test_atcac_sw_sha2_256_nist_short();
+        test_atcac_sw_sha2_256_nist_long();
+        test_atcac_sw_sha2_256_nist_monte();
+        tested++;
+    }
+
+    TEST_ASSERT_EQUAL(0, sw_sha256_select(SW_SHA256_IMPL_AUTO));
+    TEST_ASSERT_TRUE(tested > 0);
+}
+#endif
+
+#define SHA256_MULTI_MAX_MSGS       (1024)
+#define SHA256_MULTI_MSG_SIZE       (256)
+
+static uint8_t g_sha256_multi_data[SHA256_MULTI_MAX_MSGS + SHA256_MULTI_MSG_SIZE];
+static uint8_t g_sha256_multi_digests[SHA256_MULTI_MAX_MSGS * ATCA_SHA2_256_DIGEST_SIZE];
+
+void test_atcac_sw_sha2_256_multi(void)
+{
+    static const size_t counts[] = { 0, 1, 2, 7, 8, 9, 37 };
+    const uint8_t* msgs[64];
+    size_t sizes[64];
+    uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE];
+    size_t c;
+    size_t i;
+
+    for (i = 0; i < sizeof(g_sha256_multi_data); i++)
+    {
+        g_sha256_multi_data[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    /* Lengths around the padding boundaries, mixed so lanes finish at
+       different blocks */
+    for (i = 0; i < sizeof(msgs) / sizeof(msgs[0]); i++)
+    {
+        static const size_t lengths[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 200, 300 };
+        sizes[i] = lengths[(i * 5) % (sizeof(lengths) / sizeof(lengths[0]))];
+        msgs[i] = &g_sha256_multi_data[i * 11];
+    }
+
+    for (c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        memset(g_sha256_multi_digests, 0, sizeof(g_sha256_multi_digests));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_sha2_256_multi(msgs, sizes, counts[c], g_sha256_multi_digests));
+
+        for (i = 0; i < counts[c]; i++)
+        {
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_sha2_256(msgs[i], sizes[i], digest));
+            TEST_ASSERT_EQUAL_MEMORY(digest, &g_sha256_multi_digests[i * ATCA_SHA2_256_DIGEST_SIZE], sizeof(digest));
+        }
+    }
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_sha2_256_multi(NULL, sizes, 1, g_sha256_multi_digests));
+}
+
+void test_atcac_sw_sha2_256_multi_speed(void)
+{
+    static const size_t counts[] = { 32, 128, 1024 };
+    static const uint8_t* msgs[SHA256_MULTI_MAX_MSGS];
+    static size_t sizes[SHA256_MULTI_MAX_MSGS];
+    char msg[128];
+    size_t c;
+    size_t i;
+    int rep;
+
+    for (i = 0; i < SHA256_MULTI_MAX_MSGS; i++)
+    {
+        msgs[i] = &g_sha256_multi_data[i];
+        sizes[i] = SHA256_MULTI_MSG_SIZE;
+    }
+
+    for (c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        int reps = (int)(8192 / counts[c]);
+        clock_t start;
+        double single_sec;
+        double multi_sec;
+
+        start = clock();
+        for (rep = 0; rep < reps; rep++)
+        {
+            for (i = 0; i < counts[c]; i++)
+            {
+                (void)atcac_sw_sha2_256(msgs[i], sizes[i], &g_sha256_multi_digests[i * ATCA_SHA2_256_DIGEST_SIZE]);
+            }
+        }
+        single_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (rep = 0; rep < reps; rep++)
+        {
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_sha2_256_multi(msgs, sizes, counts[c], g_sha256_multi_digests));
+        }
+        multi_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        (void)snprintf(msg, sizeof(msg), "%4u x %u bytes: %.0f msgs/s one at a time, %.0f msgs/s batched",
+                       (unsigned)counts[c], SHA256_MULTI_MSG_SIZE,
+                       single_sec > 0 ? reps * counts[c] / single_sec : 0.0,
+                       multi_sec > 0 ? reps * counts[c] / multi_sec : 0.0);
+        TEST_MESSAGE(msg);
+    }
+}
+
+/** \brief PBKDF2 with a full HMAC for every iteration */
+static void pbkdf2_sha256_reference(uint32_t iter, const uint8_t* password, size_t password_len,
+                                    const uint8_t* salt, size_t salt_len, uint8_t* result, size_t result_len)
+{
+    atcac_hmac_sha256_ctx ctx;
+    uint8_t t[ATCA_SHA2_256_DIGEST_SIZE];
+    uint8_t u[ATCA_SHA2_256_DIGEST_SIZE];
+    size_t u_size = sizeof(u);
+    uint32_t counter;
+    uint32_t i, j;
+
+    for (counter = 1; result_len > 0; counter++)
+    {
+        uint8_t counter_be[4] = { (uint8_t)(counter >> 24), (uint8_t)(counter >> 16), (uint8_t)(counter >> 8), (uint8_t)counter };
+        size_t copy_len = result_len < sizeof(t) ? result_len : sizeof(t);
+
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sha256_hmac_init(&ctx, password, (uint8_t)password_len));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sha256_hmac_update(&ctx, salt, salt_len));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sha256_hmac_update(&ctx, counter_be, sizeof(counter_be)));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sha256_hmac_finish(&ctx, u, &u_size));
+        memcpy(t, u, sizeof(t));
+
+        for (i = 1; i < iter; i++)
+        {
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sha256_hmac_init(&ctx, password, (uint8_t)password_len));
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sha256_hmac_update(&ctx, u, sizeof(u)));
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sha256_hmac_finish(&ctx, u, &u_size));
+            for (j = 0; j < sizeof(t); j++)
+            {
+                t[j] ^= u[j];
+            }
+        }
+
+        memcpy(result, t, copy_len);
+        result += copy_len;
+        result_len -= copy_len;
+    }
+}
+
+void test_atcac_pbkdf2_sha256(void)
+{
+    static const uint8_t password[] = "a PIN that is longer than one SHA256 block so the key is hashed first";
+    static const uint8_t salt[] = "0123456789ABCDEF";
+    const pbkdf2_sha256_test_vector* pVector = pbkdf2_sha256_test_vectors;
+    uint8_t result[ATCA_SHA2_256_DIGEST_SIZE * 10];
+    uint8_t expected[ATCA_SHA2_256_DIGEST_SIZE * 10];
+    char msg[128];
+    clock_t start;
+    double reference_sec;
+    double fast_sec;
+    size_t i;
+
+    for (i = 0; i < pbkdf2_sha256_test_vectors_count; i++, pVector++)
+    {
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_pbkdf2_sha256(pVector->c, (const uint8_t*)pVector->p, pVector->plen,
+                                                            (const uint8_t*)pVector->s, pVector->slen, result, pVector->dklen));
+        TEST_ASSERT_EQUAL_MEMORY(pVector->dk, result, pVector->dklen);
+    }
+
+    /* More output blocks than are derived together and a partial last block */
+    start = clock();
+    pbkdf2_sha256_reference(4096, password, sizeof(password) - 1, salt, sizeof(salt) - 1, expected, sizeof(expected) - 5);
+    reference_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_pbkdf2_sha256(4096, password, sizeof(password) - 1, salt, sizeof(salt) - 1,
+                                                        result, sizeof(result) - 5));
+    fast_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+    TEST_ASSERT_EQUAL_MEMORY(expected, result, sizeof(result) - 5);
+
+    (void)snprintf(msg, sizeof(msg), "4096 iterations, %u bytes: %.1f ms with a full HMAC per iteration, %.1f ms",
+                   (unsigned)(sizeof(result) - 5), reference_sec * 1000, fast_sec * 1000);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_pbkdf2_sha256(1, NULL, 4, salt, sizeof(salt) - 1, result, 32));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_pbkdf2_sha256(1, password, 4, salt, sizeof(salt) - 1, result, 0));
+}
+
+#define ECDSA_BATCH_TEST_MAX    (32)
+#define ECDSA_BATCH_SPEED_MAX   (256)
+
+static void ecdsa_p256_vector(size_t i, uint8_t digest[32], uint8_t signature[64], uint8_t pubkey[64])
+{
+    memcpy(pubkey, ecdsa_p256_test_vectors[i].Qx, 32);
+    memcpy(&pubkey[32], ecdsa_p256_test_vectors[i].Qy, 32);
+    memcpy(signature, ecdsa_p256_test_vectors[i].R, 32);
+    memcpy(&signature[32], ecdsa_p256_test_vectors[i].S, 32);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_sha2_256(ecdsa_p256_test_vectors[i].Msg, sizeof(ecdsa_p256_test_vectors[i].Msg), digest));
+}
+
+void test_atcac_sw_ecdsa_verify_p256_nist(void)
+{
+    uint8_t pubkey[64];
+    uint8_t signature[64];
+    uint8_t digest[32];
+    atcac_sw_ecdsa_p256_key key;
+    int status;
+    size_t passed = 0;
+    size_t i;
+
+    for (i = 0; i < ecdsa_p256_test_vectors_count; i++)
+    {
+        ecdsa_p256_vector(i, digest, signature, pubkey);
+
+        status = atcac_sw_ecdsa_verify_p256(digest, signature, pubkey);
+        if (ecdsa_p256_test_vectors[i].Result)
+        {
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+            passed++;
+        }
+        else
+        {
+            TEST_ASSERT_NOT_EQUAL(ATCA_SUCCESS, status);
+        }
+
+        /* A prepared key gives the same result */
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256_init(&key, pubkey));
+        TEST_ASSERT_EQUAL(status, atcac_sw_ecdsa_verify_p256_key(&key, digest, signature));
+    }
+    TEST_ASSERT_TRUE(passed > 0);
+
+    /* Signature values outside 1..n-1 and keys off the curve */
+    ecdsa_p256_vector(0, digest, signature, pubkey);
+    memset(signature, 0, 32);
+    TEST_ASSERT_EQUAL(ATCA_FUNC_FAIL, atcac_sw_ecdsa_verify_p256(digest, signature, pubkey));
+    memset(&signature[32], 0xFF, 32);
+    TEST_ASSERT_EQUAL(ATCA_FUNC_FAIL, atcac_sw_ecdsa_verify_p256(digest, signature, pubkey));
+
+    ecdsa_p256_vector(0, digest, signature, pubkey);
+    pubkey[63] ^= 0x01;
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_ecdsa_verify_p256(digest, signature, pubkey));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_ecdsa_verify_p256(NULL, signature, pubkey));
+}
+
+void test_atcac_sw_ecdsa_verify_p256_speed(void)
+{
+    uint8_t pubkey[64];
+    uint8_t signature[64];
+    uint8_t digest[32];
+    atcac_sw_ecdsa_p256_key key;
+    char msg[128];
+    clock_t start;
+    double oneshot_sec;
+    double prepared_sec;
+    int count = 200;
+    int i;
+
+    for (i = 0; i < (int)ecdsa_p256_test_vectors_count && !ecdsa_p256_test_vectors[i].Result; i++)
+    {
+    }
+    TEST_ASSERT_TRUE(i < (int)ecdsa_p256_test_vectors_count);
+    ecdsa_p256_vector((size_t)i, digest, signature, pubkey);
+
+    start = clock();
+    for (i = 0; i < count; i++)
+    {
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256(digest, signature, pubkey));
+    }
+    oneshot_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256_init(&key, pubkey));
+    start = clock();
+    for (i = 0; i < count; i++)
+    {
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256_key(&key, digest, signature));
+    }
+    prepared_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    (void)snprintf(msg, sizeof(msg), "P-256 verify: %.0f/s, %.0f/s with a prepared key",
+                   oneshot_sec > 0 ? count / oneshot_sec : 0.0, prepared_sec > 0 ? count / prepared_sec : 0.0);
+    TEST_MESSAGE(msg);
+}
+
+void test_atcac_sw_ecdsa_verify_p256_batch(void)
+{
+    static uint8_t pubkeys[ECDSA_BATCH_TEST_MAX][64];
+    static uint8_t signatures[ECDSA_BATCH_TEST_MAX][64];
+    static uint8_t digests[ECDSA_BATCH_TEST_MAX][32];
+    const uint8_t* msg_list[ECDSA_BATCH_TEST_MAX] = { NULL };
+    const uint8_t* sig_list[ECDSA_BATCH_TEST_MAX] = { NULL };
+    const uint8_t* key_list[ECDSA_BATCH_TEST_MAX] = { NULL };
+    int results[ECDSA_BATCH_TEST_MAX];
+    int expected = ATCA_SUCCESS;
+    size_t count = ecdsa_p256_test_vectors_count;
+    size_t i;
+
+    if (count > ECDSA_BATCH_TEST_MAX)
+    {
+        count = ECDSA_BATCH_TEST_MAX;
+    }
+
+    /* Each signature gets the result it would get on its own */
+    for (i = 0; i < count; i++)
+    {
+        ecdsa_p256_vector(i, digests[i], signatures[i], pubkeys[i]);
+        msg_list[i] = digests[i];
+        sig_list[i] = signatures[i];
+        key_list[i] = pubkeys[i];
+        if (!ecdsa_p256_test_vectors[i].Result)
+        {
+            expected = ATCA_FUNC_FAIL;
+        }
+    }
+    TEST_ASSERT_EQUAL(expected, atcac_sw_ecdsa_verify_p256_batch(msg_list, sig_list, key_list, count, results));
+    for (i = 0; i < count; i++)
+    {
+        TEST_ASSERT_EQUAL(atcac_sw_ecdsa_verify_p256(digests[i], signatures[i], pubkeys[i]), results[i]);
+    }
+
+    /* One key shared by a batch, as for certificates from the same issuer,
+       with one bad signature and one key off the curve */
+    for (i = 0; i < ECDSA_BATCH_TEST_MAX; i++)
+    {
+        msg_list[i] = digests[0];
+        sig_list[i] = signatures[0];
+        key_list[i] = pubkeys[0];
+    }
+    TEST_ASSERT_EQUAL(ecdsa_p256_test_vectors[0].Result ? ATCA_SUCCESS : ATCA_FUNC_FAIL,
+                      atcac_sw_ecdsa_verify_p256_batch(msg_list, sig_list, key_list, ECDSA_BATCH_TEST_MAX, NULL));
+
+    memcpy(digests[1], digests[0], 32);
+    digests[1][0] ^= 0x01;
+    memcpy(pubkeys[2], pubkeys[0], 64);
+    pubkeys[2][63] ^= 0x01;
+    msg_list[3] = digests[1];
+    key_list[5] = pubkeys[2];
+    TEST_ASSERT_EQUAL(ATCA_FUNC_FAIL, atcac_sw_ecdsa_verify_p256_batch(msg_list, sig_list, key_list, ECDSA_BATCH_TEST_MAX, results));
+    TEST_ASSERT_EQUAL(ATCA_FUNC_FAIL, results[3]);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, results[5]);
+    for (i = 0; i < ECDSA_BATCH_TEST_MAX; i++)
+    {
+        if (i != 3 && i != 5)
+        {
+            TEST_ASSERT_EQUAL(results[0], results[i]);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256_batch(NULL, NULL, NULL, 0, NULL));
+    key_list[1] = NULL;
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_ecdsa_verify_p256_batch(msg_list, sig_list, key_list, 2, results));
+}
+
+void test_atcac_sw_ecdsa_verify_p256_batch_speed(void)
+{
+    static const size_t batch_sizes[] = { 1, 16, 256 };
+    static uint8_t pubkeys[ECDSA_BATCH_SPEED_MAX][64];
+    static uint8_t signatures[ECDSA_BATCH_SPEED_MAX][64];
+    static uint8_t digests[ECDSA_BATCH_SPEED_MAX][32];
+    static const uint8_t* msg_list[ECDSA_BATCH_SPEED_MAX];
+    static const uint8_t* sig_list[ECDSA_BATCH_SPEED_MAX];
+    static const uint8_t* key_list[ECDSA_BATCH_SPEED_MAX];
+    char msg[128];
+    clock_t start;
+    double single_sec;
+    double batch_sec;
+    size_t valid = 0;
+    size_t total;
+    size_t i, j, k;
+
+    /* Cycle through the valid vectors so the keys differ */
+    for (i = 0; i < ECDSA_BATCH_SPEED_MAX; i++)
+    {
+        do
+        {
+            j = valid++ % ecdsa_p256_test_vectors_count;
+        }
+        while (!ecdsa_p256_test_vectors[j].Result);
+        ecdsa_p256_vector(j, digests[i], signatures[i], pubkeys[i]);
+        msg_list[i] = digests[i];
+        sig_list[i] = signatures[i];
+        key_list[i] = pubkeys[i];
+    }
+
+    for (k = 0; k < sizeof(batch_sizes) / sizeof(batch_sizes[0]); k++)
+    {
+        size_t batch = batch_sizes[k];
+        size_t rounds = ECDSA_BATCH_SPEED_MAX / batch;
+
+        total = rounds * batch;
+
+        start = clock();
+        for (i = 0; i < total; i++)
+        {
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256(msg_list[i], sig_list[i], key_list[i]));
+        }
+        single_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (i = 0; i < rounds; i++)
+        {
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256_batch(&msg_list[i * batch], &sig_list[i * batch],
+                                                                             &key_list[i * batch], batch, NULL));
+        }
+        batch_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        (void)snprintf(msg, sizeof(msg), "P-256 verify batch of %u: %.0f/s, %.0f/s one at a time", (unsigned)batch,
+                       batch_sec > 0 ? total / batch_sec : 0.0, single_sec > 0 ? total / single_sec : 0.0);
+        TEST_MESSAGE(msg);
+    }
+}
+
 #if defined(ATCA_OPENSSL) || defined(ATCA_MBEDTLS) || defined(ATCA_WOLFSSL)
 
 void test_atcac_aes128_gcm(void)
@@ -44,6 +44,14 @@ void test_atcac_sw_sha2_256_nist3(void);
 void test_atcac_sw_sha2_256_nist_short(void);
 void test_atcac_sw_sha2_256_nist_long(void);
 void test_atcac_sw_sha2_256_nist_monte(void);
+void test_sw_sha256_impl_nist(void);
+void test_atcac_sw_sha2_256_multi(void);
+void test_atcac_sw_sha2_256_multi_speed(void);
+void test_atcac_pbkdf2_sha256(void);
+void test_atcac_sw_ecdsa_verify_p256_nist(void);
+void test_atcac_sw_ecdsa_verify_p256_speed(void);
+void test_atcac_sw_ecdsa_verify_p256_batch(void);
+void test_atcac_sw_ecdsa_verify_p256_batch_speed(void);
 
 void test_atcac_aes128_gcm(void);
 void test_atcac_aes128_cmac(void);
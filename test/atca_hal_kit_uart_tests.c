@@ -0,0 +1,663 @@
+/**
+ * \file
+ * \brief Tests for the kit protocol over a serial port, run against a kit
+ *        emulated on a pseudo terminal that forwards to a simulated device
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_HAL_KIT_UART) && defined(__linux__) && !defined(ATCA_HAL_LEGACY_API)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "hal/kit_protocol.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define KIT_EMU_ADDRESS             (0xC0)
+#define KIT_EMU_LINE_SIZE           (512)
+#define KIT_EMU_COMMANDS            (200)
+
+/** \brief A kit emulated on the master side of a pseudo terminal. It speaks
+ *         the ASCII protocol and, when binary_capable is set, accepts the
+ *         switch to binary frames. ASCII lines are still accepted once
+ *         binary framing is on and are answered in ASCII.
+ */
+typedef struct
+{
+    int             master;
+    char            slave[64];
+    pthread_t       thread;
+    volatile bool   stop;
+    volatile bool   fragment;       /**< Send replies a byte at a time */
+    volatile bool   binary_capable; /**< Accept "board:binary(01)" */
+    volatile bool   binary;         /**< Binary frames negotiated */
+    bool            framed;         /**< Command being answered was a frame */
+    atca_mock_bus_t bus;
+    uint32_t        frames;         /**< Kit commands received */
+    uint32_t        rx_bytes;       /**< Bytes received from the host */
+    uint32_t        tx_bytes;       /**< Bytes sent to the host */
+} kit_emu_t;
+
+static kit_emu_t g_kit_emu;
+
+static void kit_emu_reply(kit_emu_t* emu, uint8_t status, const uint8_t* data, size_t len)
+{
+    char reply[KIT_EMU_LINE_SIZE];
+    size_t reply_len = 0;
+    size_t i;
+
+    if (emu->framed)
+    {
+        reply[reply_len++] = (char)KIT_BIN_SYNC;
+        reply[reply_len++] = (char)(len + 1);
+        reply[reply_len++] = (char)((len + 1) >> 8);
+        reply[reply_len++] = (char)status;
+        if (len)
+        {
+            memcpy(&reply[reply_len], data, len);
+            reply_len += len;
+        }
+        atCRC(reply_len - 1, (const uint8_t*)&reply[1], (uint8_t*)&reply[reply_len]);
+        reply_len += 2;
+    }
+    else
+    {
+        reply_len += (size_t)snprintf(&reply[reply_len], sizeof(reply) - reply_len, "%02X(", status);
+        for (i = 0; i < len; i++)
+        {
+            reply_len += (size_t)snprintf(&reply[reply_len], sizeof(reply) - reply_len, "%02X", data[i]);
+        }
+        reply_len += (size_t)snprintf(&reply[reply_len], sizeof(reply) - reply_len, ")\n");
+    }
+    emu->tx_bytes += (uint32_t)reply_len;
+
+    if (emu->fragment)
+    {
+        for (i = 0; i < reply_len; i++)
+        {
+            (void)write(emu->master, &reply[i], 1);
+            (void)usleep(50);
+        }
+    }
+    else
+    {
+        (void)write(emu->master, reply, reply_len);
+    }
+}
+
+/** \brief Wait for the device to complete a command and read its response */
+static size_t kit_emu_response(kit_emu_t* emu, uint8_t* rsp, size_t size)
+{
+    const uint8_t word_address = 0x00;
+    uint16_t rxlen;
+    int i;
+
+    for (i = 0; i < 10000; i++)
+    {
+        rxlen = 1;
+        if (ATCA_SUCCESS == atca_mock_bus_write(&emu->bus, KIT_EMU_ADDRESS, &word_address, 1)
+            && ATCA_SUCCESS == atca_mock_bus_read(&emu->bus, KIT_EMU_ADDRESS, rsp, &rxlen))
+        {
+            break;
+        }
+        (void)usleep(100);
+    }
+
+    if (rsp[0] < 4 || rsp[0] > size)
+    {
+        return 0;
+    }
+    rxlen = (uint16_t)(rsp[0] - 1);
+
+    return (ATCA_SUCCESS == atca_mock_bus_read(&emu->bus, KIT_EMU_ADDRESS, &rsp[1], &rxlen)) ? rxlen + 1u : 0;
+}
+
+/** \brief Carry out a device command ('w', 'i', 's' or 't' with a packet) */
+static void kit_emu_device(kit_emu_t* emu, char cmd, const uint8_t* data, size_t len)
+{
+    uint8_t packet[ATCA_CMD_SIZE_MAX + 1];
+    uint8_t rsp[ATCA_RSP_SIZE_MAX];
+    uint16_t rxlen;
+
+    if ('w' == cmd && 0 == len)
+    {
+        rxlen = 4;
+        (void)atca_mock_bus_write(&emu->bus, 0x00, NULL, 0);
+        if (ATCA_SUCCESS == atca_mock_bus_read(&emu->bus, KIT_EMU_ADDRESS, rsp, &rxlen))
+        {
+            kit_emu_reply(emu, 0x00, rsp, rxlen);
+        }
+        else
+        {
+            kit_emu_reply(emu, 0xE1, NULL, 0);
+        }
+    }
+    else if (('i' == cmd || 's' == cmd) && 0 == len)
+    {
+        packet[0] = ('i' == cmd) ? 0x02 : 0x01;
+        (void)atca_mock_bus_write(&emu->bus, KIT_EMU_ADDRESS, packet, 1);
+        kit_emu_reply(emu, 0x00, NULL, 0);
+    }
+    else if ('t' == cmd && 0 < len && len < sizeof(packet))
+    {
+        packet[0] = 0x03;
+        memcpy(&packet[1], data, len);
+        if (ATCA_SUCCESS == atca_mock_bus_write(&emu->bus, KIT_EMU_ADDRESS, packet, (int)len + 1))
+        {
+            kit_emu_reply(emu, 0x00, rsp, kit_emu_response(emu, rsp, sizeof(rsp)));
+        }
+        else
+        {
+            kit_emu_reply(emu, 0xE0, NULL, 0);
+        }
+    }
+    else
+    {
+        kit_emu_reply(emu, 0xE0, NULL, 0);
+    }
+}
+
+/** \brief Carry out one kit command line */
+static void kit_emu_command(kit_emu_t* emu, char* line)
+{
+    uint8_t data[ATCA_CMD_SIZE_MAX];
+    size_t data_size = sizeof(data);
+    char* args;
+
+    emu->frames++;
+    emu->framed = false;
+
+    if (0 == strncmp(line, "board:device(", 13))
+    {
+        const char* reply = (0 == strncmp(&line[13], "00)", 3)) ? "ECC608A TWI C0(C0)\n" : "no_device\n";
+
+        emu->tx_bytes += (uint32_t)strlen(reply);
+        (void)write(emu->master, reply, strlen(reply));
+    }
+    else if (0 == strncmp(line, "E:physical:select(", 18))
+    {
+        kit_emu_reply(emu, 0x00, NULL, 0);
+    }
+    else if (0 == strcmp(line, "board:binary(01)") && emu->binary_capable)
+    {
+        kit_emu_reply(emu, 0x00, NULL, 0);
+        emu->binary = true;
+    }
+    else if (0 == strncmp(line, "E:", 2) && '(' == line[3] && NULL != (args = strchr(line, ')')))
+    {
+        if (&line[4] == args)
+        {
+            data_size = 0;
+        }
+        else if (ATCA_SUCCESS != atcab_hex2bin(&line[4], (size_t)(args - &line[4]), data, &data_size))
+        {
+            data_size = sizeof(data) + 1;
+        }
+        kit_emu_device(emu, line[2], data, data_size);
+    }
+    else
+    {
+        kit_emu_reply(emu, 0xE0, NULL, 0);
+    }
+}
+
+/** \brief Carry out a binary frame once all of it has arrived
+ * \return true once the frame has been carried out
+ */
+static bool kit_emu_frame(kit_emu_t* emu, const uint8_t* buf, size_t len)
+{
+    uint8_t crc[2];
+    size_t length;
+
+    if (len < 3 || len < (length = (size_t)(buf[1] | (buf[2] << 8))) + KIT_BIN_WRAP_SIZE)
+    {
+        return false;
+    }
+
+    emu->frames++;
+    emu->framed = true;
+
+    atCRC(length + 2, &buf[1], crc);
+    if (length < 2 || memcmp(crc, &buf[length + 3], sizeof(crc)))
+    {
+        kit_emu_reply(emu, 0xE2, NULL, 0);
+    }
+    else if (KIT_BIN_TARGET_BOARD == buf[3] && KIT_BIN_CMD_ASCII == buf[4])
+    {
+        /* Back to the ASCII protocol - the reply is still a frame */
+        emu->binary = false;
+        kit_emu_reply(emu, 0x00, NULL, 0);
+    }
+    else if ('E' != buf[3])
+    {
+        kit_emu_reply(emu, 0xE2, NULL, 0);
+    }
+    else
+    {
+        kit_emu_device(emu, (char)buf[4], &buf[5], length - 2);
+    }
+
+    return true;
+}
+
+/** \brief Read command lines from the host and answer them */
+static void* kit_emu_thread(void* arg)
+{
+    kit_emu_t* emu = (kit_emu_t*)arg;
+    char line[KIT_EMU_LINE_SIZE];
+    size_t line_len = 0;
+    bool in_frame = false;
+    struct pollfd pfd = { emu->master, POLLIN, 0 };
+    char buf[128];
+    ssize_t count;
+    ssize_t i;
+
+    while (!emu->stop)
+    {
+        if (poll(&pfd, 1, 10) <= 0)
+        {
+            continue;
+        }
+        if ((count = read(emu->master, buf, sizeof(buf))) <= 0)
+        {
+            /* Nothing has the slave side open */
+            (void)usleep(1000);
+            continue;
+        }
+
+        emu->rx_bytes += (uint32_t)count;
+        for (i = 0; i < count; i++)
+        {
+            /* The sync byte can't start an ASCII line */
+            if (in_frame || (emu->binary && 0 == line_len && KIT_BIN_SYNC == (uint8_t)buf[i]))
+            {
+                in_frame = true;
+                if (line_len < sizeof(line))
+                {
+                    line[line_len++] = buf[i];
+                }
+                if (kit_emu_frame(emu, (const uint8_t*)line, line_len))
+                {
+                    in_frame = false;
+                    line_len = 0;
+                }
+            }
+            else if ('\n' == buf[i])
+            {
+                line[line_len] = '\0';
+                kit_emu_command(emu, line);
+                line_len = 0;
+            }
+            else if ('\0' != buf[i] && line_len < sizeof(line) - 1)
+            {
+                line[line_len++] = buf[i];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void kit_emu_cfg_init(ATCAIfaceCfg* cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->iface_type = ATCA_UART_IFACE;
+    cfg->devtype = ATECC608;
+    cfg->atcauart.port = 0;
+    cfg->atcauart.baud = 115200;
+    cfg->atcauart.wordsize = 8;
+    cfg->atcauart.parity = 2;
+    cfg->atcauart.stopbits = 1;
+    cfg->wake_delay = 1500;
+    cfg->rx_retries = 20;
+    cfg->cfg_data = g_kit_emu.slave;
+}
+
+/** \brief CPU time used by the calling thread */
+static uint64_t kit_emu_thread_usec(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+TEST_GROUP(hal_kit_uart);
+
+TEST_SETUP(hal_kit_uart)
+{
+    memset(&g_kit_emu, 0, sizeof(g_kit_emu));
+
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_kit_emu.bus));
+    TEST_ASSERT_NOT_NULL(atca_mock_bus_add_device(&g_kit_emu.bus, KIT_EMU_ADDRESS));
+
+    TEST_ASSERT_TRUE(0 <= (g_kit_emu.master = posix_openpt(O_RDWR | O_NOCTTY)));
+    TEST_ASSERT_EQUAL(0, grantpt(g_kit_emu.master));
+    TEST_ASSERT_EQUAL(0, unlockpt(g_kit_emu.master));
+    TEST_ASSERT_EQUAL(0, ptsname_r(g_kit_emu.master, g_kit_emu.slave, sizeof(g_kit_emu.slave)));
+
+    TEST_ASSERT_EQUAL(0, pthread_create(&g_kit_emu.thread, NULL, kit_emu_thread, &g_kit_emu));
+}
+
+TEST_TEAR_DOWN(hal_kit_uart)
+{
+    g_kit_emu.stop = true;
+    (void)pthread_join(g_kit_emu.thread, NULL);
+    (void)close(g_kit_emu.master);
+    atca_mock_bus_release(&g_kit_emu.bus);
+}
+
+TEST(hal_kit_uart, frame_parser)
+{
+    const char rsp[] = "\n00(0411 3343)\n";
+    const char split[] = "\0\0" "00(07A1B2C3D4E5F6)\n";
+    uint8_t data[8];
+    uint8_t kitstatus = 0xFF;
+    int datasize = sizeof(data);
+    kit_frame_t frame;
+    size_t i;
+
+    /* Whitespace inside the data isn't hex */
+    TEST_ASSERT_EQUAL(ATCA_RX_FAIL, kit_parse_rsp(rsp, (int)strlen(rsp), &kitstatus, data, &datasize));
+
+    /* A frame is decoded however it is split across reads and complete at
+       the closing parenthesis */
+    kit_frame_init(&frame, data, sizeof(data));
+    for (i = 0; i < sizeof(split) - 3; i++)
+    {
+        TEST_ASSERT_EQUAL(ATCA_RX_NO_RESPONSE, kit_frame_parse(&frame, (const uint8_t*)&split[i], 1));
+    }
+    TEST_ASSERT_SUCCESS(kit_frame_parse(&frame, (const uint8_t*)&split[i], 1));
+    TEST_ASSERT_EQUAL(0x00, frame.status);
+    TEST_ASSERT_EQUAL(7, frame.len);
+    TEST_ASSERT_EQUAL_HEX8(0x07, data[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xF6, data[6]);
+
+    /* The status and data of a complete response, with or without the newline */
+    datasize = sizeof(data);
+    TEST_ASSERT_SUCCESS(kit_parse_rsp("E1(0A0b)", 8, &kitstatus, data, &datasize));
+    TEST_ASSERT_EQUAL_HEX8(0xE1, kitstatus);
+    TEST_ASSERT_EQUAL(2, datasize);
+    TEST_ASSERT_EQUAL_HEX8(0x0B, data[1]);
+
+    datasize = 2;
+    TEST_ASSERT_EQUAL(ATCA_SMALL_BUFFER, kit_parse_rsp("00(010203)\n", 11, &kitstatus, data, &datasize));
+    TEST_ASSERT_EQUAL(2, datasize);
+
+    datasize = sizeof(data);
+    TEST_ASSERT_EQUAL(ATCA_RX_FAIL, kit_parse_rsp("00(012)\n", 8, &kitstatus, data, &datasize));
+    TEST_ASSERT_EQUAL(ATCA_GEN_FAIL, kit_parse_rsp("00(0102", 7, &kitstatus, data, &datasize));
+}
+
+TEST(hal_kit_uart, binary_frame_parser)
+{
+    uint8_t rsp[] = { 0x00, 0x00, KIT_BIN_SYNC, 0x04, 0x00, 0x00, 0x0D, 0x0A, 0x29, 0x00, 0x00 };
+    uint8_t data[4];
+    kit_frame_t frame;
+    size_t i;
+
+    atCRC(sizeof(rsp) - 5, &rsp[3], &rsp[sizeof(rsp) - 2]);
+
+    /* Padding ahead of the sync byte is skipped and bytes that mean something
+       in the ASCII protocol are just data */
+    kit_frame_init_binary(&frame, data, sizeof(data));
+    for (i = 0; i < sizeof(rsp) - 1; i++)
+    {
+        TEST_ASSERT_EQUAL(ATCA_RX_NO_RESPONSE, kit_frame_parse(&frame, &rsp[i], 1));
+    }
+    TEST_ASSERT_SUCCESS(kit_frame_parse(&frame, &rsp[i], 1));
+    TEST_ASSERT_EQUAL(0x00, frame.status);
+    TEST_ASSERT_EQUAL(3, frame.len);
+    TEST_ASSERT_EQUAL_HEX8(0x0D, data[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x29, data[2]);
+
+    kit_frame_init_binary(&frame, data, 2);
+    TEST_ASSERT_EQUAL(ATCA_SMALL_BUFFER, kit_frame_parse(&frame, rsp, sizeof(rsp)));
+    TEST_ASSERT_EQUAL(2, frame.len);
+
+    /* A corrupted frame is caught by its CRC */
+    rsp[7] ^= 0x01;
+    kit_frame_init_binary(&frame, data, sizeof(data));
+    TEST_ASSERT_EQUAL(ATCA_RX_CRC_ERROR, kit_frame_parse(&frame, rsp, sizeof(rsp)));
+}
+
+TEST(hal_kit_uart, commands)
+{
+    ATCAIfaceCfg cfg;
+    ATCADevice device = NULL;
+    uint8_t revision[4];
+    uint8_t block[ATCA_BLOCK_SIZE];
+    uint8_t readback[ATCA_BLOCK_SIZE];
+    uint8_t random[RANDOM_NUM_SIZE];
+    uint8_t zero[RANDOM_NUM_SIZE];
+
+    kit_emu_cfg_init(&cfg);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&device, &cfg));
+
+    TEST_ASSERT_SUCCESS(calib_info(device, revision));
+    memset(zero, 0, sizeof(zero));
+    TEST_ASSERT_SUCCESS(calib_random(device, random));
+    TEST_ASSERT_TRUE(memcmp(random, zero, sizeof(zero)));
+
+    /* Data goes through the kit unchanged in both directions */
+    memset(block, 0x5A, sizeof(block));
+    block[0] = 0xA5;
+    TEST_ASSERT_SUCCESS(calib_write_zone(device, ATCA_ZONE_DATA, 8, 0, 0, block, sizeof(block)));
+    TEST_ASSERT_SUCCESS(calib_read_zone(device, ATCA_ZONE_DATA, 8, 0, 0, readback, sizeof(readback)));
+    TEST_ASSERT_EQUAL_MEMORY(block, readback, sizeof(block));
+
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device));
+}
+
+TEST(hal_kit_uart, binary_commands)
+{
+    ATCAIfaceCfg cfg;
+    ATCADevice device = NULL;
+    uint8_t revision[4];
+    uint8_t block[ATCA_BLOCK_SIZE];
+    uint8_t readback[ATCA_BLOCK_SIZE];
+    uint8_t random[RANDOM_NUM_SIZE];
+    uint32_t frames;
+
+    g_kit_emu.binary_capable = true;
+    kit_emu_cfg_init(&cfg);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&device, &cfg));
+    TEST_ASSERT_TRUE(g_kit_emu.binary);
+
+    frames = g_kit_emu.frames;
+    TEST_ASSERT_SUCCESS(calib_info(device, revision));
+    TEST_ASSERT_SUCCESS(calib_random(device, random));
+
+    /* Block data that contains the sync byte, newlines and parentheses */
+    memset(block, 0x29, sizeof(block));
+    block[0] = KIT_BIN_SYNC;
+    block[1] = '\n';
+    TEST_ASSERT_SUCCESS(calib_write_zone(device, ATCA_ZONE_DATA, 8, 0, 0, block, sizeof(block)));
+    TEST_ASSERT_SUCCESS(calib_read_zone(device, ATCA_ZONE_DATA, 8, 0, 0, readback, sizeof(readback)));
+    TEST_ASSERT_EQUAL_MEMORY(block, readback, sizeof(block));
+
+    /* Wake, command and idle each still take one frame */
+    TEST_ASSERT_EQUAL(3 * 4, g_kit_emu.frames - frames);
+
+    /* Releasing the interface returns the kit to the ASCII protocol */
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device));
+    TEST_ASSERT_FALSE(g_kit_emu.binary);
+}
+
+TEST(hal_kit_uart, binary_fallback)
+{
+    ATCAIfaceCfg cfg;
+    ATCADevice device = NULL;
+    uint8_t random[RANDOM_NUM_SIZE];
+
+    /* A kit without binary framing rejects the switch and the host keeps
+       using the ASCII protocol */
+    kit_emu_cfg_init(&cfg);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&device, &cfg));
+    TEST_ASSERT_FALSE(g_kit_emu.binary);
+    TEST_ASSERT_SUCCESS(calib_random(device, random));
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device));
+}
+
+TEST(hal_kit_uart, fragmented_replies)
+{
+    ATCAIfaceCfg cfg;
+    ATCADevice device = NULL;
+    uint8_t random[RANDOM_NUM_SIZE];
+    int i;
+
+    /* Replies arriving a byte at a time are decoded as they come in */
+    g_kit_emu.fragment = true;
+    kit_emu_cfg_init(&cfg);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&device, &cfg));
+
+    for (i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_random(device, random));
+    }
+
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device));
+
+    /* And so are binary frames */
+    g_kit_emu.binary_capable = true;
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&device, &cfg));
+    TEST_ASSERT_TRUE(g_kit_emu.binary);
+
+    for (i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_random(device, random));
+    }
+
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device));
+}
+
+TEST(hal_kit_uart, host_cpu)
+{
+    ATCAIfaceCfg cfg;
+    ATCADevice device = NULL;
+    uint8_t random[RANDOM_NUM_SIZE];
+    uint32_t frames;
+    uint64_t start;
+    uint64_t elapsed;
+    char msg[128];
+    int i;
+
+    kit_emu_cfg_init(&cfg);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&device, &cfg));
+    TEST_ASSERT_SUCCESS(calib_random(device, random));
+
+    frames = g_kit_emu.frames;
+    start = kit_emu_thread_usec();
+    for (i = 0; i < KIT_EMU_COMMANDS; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_random(device, random));
+    }
+    elapsed = kit_emu_thread_usec() - start;
+
+    /* Wake, command and idle for each */
+    TEST_ASSERT_EQUAL(3 * KIT_EMU_COMMANDS, g_kit_emu.frames - frames);
+
+    (void)snprintf(msg, sizeof(msg), "%u commands over the kit: %.1f usec host CPU per command",
+                   KIT_EMU_COMMANDS, (double)elapsed / KIT_EMU_COMMANDS);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device));
+}
+
+/** \brief Run random commands over the kit in one of its modes
+ * \param[in]  binary  Let the kit accept binary framing
+ * \param[out] bytes   Bytes on the wire per command
+ * \param[out] usec    Elapsed time per command
+ */
+static void kit_emu_throughput(bool binary, double* bytes, double* usec)
+{
+    ATCAIfaceCfg cfg;
+    ATCADevice device = NULL;
+    uint8_t random[RANDOM_NUM_SIZE];
+    uint32_t wire;
+    uint64_t start;
+    int i;
+
+    g_kit_emu.binary_capable = binary;
+    kit_emu_cfg_init(&cfg);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&device, &cfg));
+    TEST_ASSERT_EQUAL(binary, g_kit_emu.binary);
+    TEST_ASSERT_SUCCESS(calib_random(device, random));
+
+    wire = g_kit_emu.rx_bytes + g_kit_emu.tx_bytes;
+    start = atca_mock_time_usec();
+    for (i = 0; i < KIT_EMU_COMMANDS; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_random(device, random));
+    }
+    *usec = (double)(atca_mock_time_usec() - start) / KIT_EMU_COMMANDS;
+    *bytes = (double)(g_kit_emu.rx_bytes + g_kit_emu.tx_bytes - wire) / KIT_EMU_COMMANDS;
+
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device));
+}
+
+TEST(hal_kit_uart, throughput)
+{
+    double ascii_bytes;
+    double ascii_usec;
+    double binary_bytes;
+    double binary_usec;
+    char msg[160];
+
+    kit_emu_throughput(false, &ascii_bytes, &ascii_usec);
+    kit_emu_throughput(true, &binary_bytes, &binary_usec);
+
+    /* Hex doubles the command and response - the frames carry them as is */
+    TEST_ASSERT_TRUE(4 * binary_bytes < 3 * ascii_bytes);
+
+    (void)snprintf(msg, sizeof(msg), "random over the kit: ascii %.0f bytes %.0f usec, binary %.0f bytes %.0f usec per command",
+                   ascii_bytes, ascii_usec, binary_bytes, binary_usec);
+    TEST_MESSAGE(msg);
+}
+
+TEST_GROUP_RUNNER(hal_kit_uart)
+{
+    RUN_TEST_CASE(hal_kit_uart, frame_parser);
+    RUN_TEST_CASE(hal_kit_uart, binary_frame_parser);
+    RUN_TEST_CASE(hal_kit_uart, commands);
+    RUN_TEST_CASE(hal_kit_uart, binary_commands);
+    RUN_TEST_CASE(hal_kit_uart, binary_fallback);
+    RUN_TEST_CASE(hal_kit_uart, fragmented_replies);
+    RUN_TEST_CASE(hal_kit_uart, host_cpu);
+    RUN_TEST_CASE(hal_kit_uart, throughput);
+}
+
+#endif
@@ -0,0 +1,403 @@
+/**
+ * \file
+ * \brief Tests for the Linux I2C hal run against simulated devices behind an
+ *        i2c-dev node emulated in process
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_HAL_I2C) && defined(__linux__) && !defined(ATCA_HAL_LEGACY_API)
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define I2C_SHIM_BUS                (9)
+#define I2C_SHIM_FILE               "/dev/i2c-9"
+#define I2C_SHIM_FD                 (0x4000)
+#define I2C_SHIM_COMMANDS           (20)
+
+/** \brief Calls made on the emulated i2c-dev node */
+typedef struct
+{
+    uint32_t opens;
+    uint32_t closes;
+    uint32_t ioctls;
+    uint32_t slave_ioctls;
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t transfers;     /**< Reads and writes on the bus */
+} i2c_shim_stats_t;
+
+static atca_mock_bus_t g_i2c_shim_bus;
+static i2c_shim_stats_t g_i2c_shim;
+static bool g_i2c_shim_rdwr;
+static int g_i2c_shim_slave;
+static useconds_t g_i2c_shim_slave_delay;   /**< Time the adapter takes to readdress */
+
+/* The hal calls into libc are redirected here. Anything other than the
+   emulated node is passed on. */
+
+static int i2c_shim_transfer(uint16_t addr, bool rx, uint8_t* buf, uint16_t len)
+{
+    ATCA_STATUS status;
+
+    g_i2c_shim.transfers++;
+    if (rx)
+    {
+        status = atca_mock_bus_read(&g_i2c_shim_bus, (uint8_t)(addr << 1), buf, &len);
+    }
+    else
+    {
+        status = atca_mock_bus_write(&g_i2c_shim_bus, (uint8_t)(addr << 1), buf, len);
+    }
+    return (ATCA_SUCCESS == status) ? 0 : -1;
+}
+
+int open(const char* pathname, int flags, ...)
+{
+    static int (*real_open)(const char*, int, ...);
+    mode_t mode = 0;
+    va_list args;
+
+    if (0 == strcmp(pathname, I2C_SHIM_FILE))
+    {
+        g_i2c_shim.opens++;
+        return I2C_SHIM_FD;
+    }
+
+    va_start(args, flags);
+    if (flags & (O_CREAT | O_TMPFILE))
+    {
+        mode = va_arg(args, mode_t);
+    }
+    va_end(args);
+
+    if (!real_open)
+    {
+        *(void**)&real_open = dlsym(RTLD_NEXT, "open");
+    }
+    return real_open(pathname, flags, mode);
+}
+
+int close(int fd)
+{
+    static int (*real_close)(int);
+
+    if (I2C_SHIM_FD == fd)
+    {
+        g_i2c_shim.closes++;
+        return 0;
+    }
+
+    if (!real_close)
+    {
+        *(void**)&real_close = dlsym(RTLD_NEXT, "close");
+    }
+    return real_close(fd);
+}
+
+int ioctl(int fd, unsigned long request, ...)
+{
+    static int (*real_ioctl)(int, unsigned long, ...);
+    unsigned long arg;
+    va_list args;
+
+    va_start(args, request);
+    arg = va_arg(args, unsigned long);
+    va_end(args);
+
+    if (I2C_SHIM_FD == fd)
+    {
+        g_i2c_shim.ioctls++;
+        switch (request)
+        {
+        case I2C_FUNCS:
+            *(unsigned long*)arg = g_i2c_shim_rdwr ? (I2C_FUNC_I2C | I2C_FUNC_SMBUS_EMUL) : I2C_FUNC_SMBUS_EMUL;
+            return 0;
+        case I2C_SLAVE:
+            g_i2c_shim.slave_ioctls++;
+            g_i2c_shim_slave = (int)arg;
+            if (g_i2c_shim_slave_delay)
+            {
+                (void)usleep(g_i2c_shim_slave_delay);
+            }
+            return 0;
+        case I2C_RDWR:
+            if (g_i2c_shim_rdwr)
+            {
+                struct i2c_rdwr_ioctl_data* xfer = (struct i2c_rdwr_ioctl_data*)arg;
+                uint32_t i;
+
+                for (i = 0; i < xfer->nmsgs; i++)
+                {
+                    if (i2c_shim_transfer(xfer->msgs[i].addr, 0 != (xfer->msgs[i].flags & I2C_M_RD), xfer->msgs[i].buf, xfer->msgs[i].len))
+                    {
+                        errno = EREMOTEIO;
+                        return -1;
+                    }
+                }
+                return (int)xfer->nmsgs;
+            }
+        /* fallthrough */
+        default:
+            errno = EINVAL;
+            return -1;
+        }
+    }
+
+    if (!real_ioctl)
+    {
+        *(void**)&real_ioctl = dlsym(RTLD_NEXT, "ioctl");
+    }
+    return real_ioctl(fd, request, arg);
+}
+
+ssize_t read(int fd, void* buf, size_t count)
+{
+    static ssize_t (*real_read)(int, void*, size_t);
+
+    if (I2C_SHIM_FD == fd)
+    {
+        g_i2c_shim.reads++;
+        return i2c_shim_transfer((uint16_t)g_i2c_shim_slave, true, buf, (uint16_t)count) ? -1 : (ssize_t)count;
+    }
+
+    if (!real_read)
+    {
+        *(void**)&real_read = dlsym(RTLD_NEXT, "read");
+    }
+    return real_read(fd, buf, count);
+}
+
+ssize_t write(int fd, const void* buf, size_t count)
+{
+    static ssize_t (*real_write)(int, const void*, size_t);
+
+    if (I2C_SHIM_FD == fd)
+    {
+        g_i2c_shim.writes++;
+        return i2c_shim_transfer((uint16_t)g_i2c_shim_slave, false, (uint8_t*)buf, (uint16_t)count) ? -1 : (ssize_t)count;
+    }
+
+    if (!real_write)
+    {
+        *(void**)&real_write = dlsym(RTLD_NEXT, "write");
+    }
+    return real_write(fd, buf, count);
+}
+
+static uint32_t i2c_shim_syscalls(void)
+{
+    return g_i2c_shim.opens + g_i2c_shim.closes + g_i2c_shim.ioctls + g_i2c_shim.reads + g_i2c_shim.writes;
+}
+
+static void i2c_shim_cfg_init(ATCAIfaceCfg* cfg, uint8_t address)
+{
+    atca_mock_cfg_init(cfg, &g_i2c_shim_bus, ATECC608, address);
+    cfg->atcai2c.bus = I2C_SHIM_BUS;
+}
+
+TEST_GROUP(hal_linux_i2c);
+
+TEST_SETUP(hal_linux_i2c)
+{
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_i2c_shim_bus));
+    TEST_ASSERT_NOT_NULL(atca_mock_bus_add_device(&g_i2c_shim_bus, 0xC0));
+    TEST_ASSERT_NOT_NULL(atca_mock_bus_add_device(&g_i2c_shim_bus, 0xC2));
+    memset(&g_i2c_shim, 0, sizeof(g_i2c_shim));
+    g_i2c_shim_rdwr = true;
+    g_i2c_shim_slave = -1;
+    g_i2c_shim_slave_delay = 0;
+}
+
+TEST_TEAR_DOWN(hal_linux_i2c)
+{
+    atca_mock_bus_release(&g_i2c_shim_bus);
+}
+
+TEST(hal_linux_i2c, shared_descriptor)
+{
+    ATCAIfaceCfg cfg[2];
+    ATCADevice device[2] = { NULL, NULL };
+    uint8_t random[RANDOM_NUM_SIZE];
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        i2c_shim_cfg_init(&cfg[i], (uint8_t)(0xC0 + 2 * i));
+        TEST_ASSERT_SUCCESS(atcab_init_ext(&device[i], &cfg[i]));
+        TEST_ASSERT_SUCCESS(calib_random(device[i], random));
+    }
+
+    /* Both devices use the descriptor opened for the bus */
+    TEST_ASSERT_EQUAL(1, g_i2c_shim.opens);
+
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device[0]));
+    TEST_ASSERT_EQUAL(0, g_i2c_shim.closes);
+    TEST_ASSERT_SUCCESS(calib_random(device[1], random));
+
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device[1]));
+    TEST_ASSERT_EQUAL(1, g_i2c_shim.closes);
+}
+
+TEST(hal_linux_i2c, combined_transfers)
+{
+    ATCAIfaceCfg cfg;
+    ATCADevice device = NULL;
+    uint8_t random[RANDOM_NUM_SIZE];
+    uint32_t syscalls;
+    char msg[128];
+    int i;
+
+    i2c_shim_cfg_init(&cfg, 0xC0);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&device, &cfg));
+    TEST_ASSERT_SUCCESS(calib_random(device, random));
+
+    memset(&g_i2c_shim, 0, sizeof(g_i2c_shim));
+    for (i = 0; i < I2C_SHIM_COMMANDS; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_random(device, random));
+    }
+    syscalls = i2c_shim_syscalls();
+
+    /* Each command is one ioctl per transfer with the word address ahead of
+       a read in the same ioctl. Opening, addressing and closing the node for
+       every transfer took four calls each. */
+    TEST_ASSERT_EQUAL(0, g_i2c_shim.opens);
+    TEST_ASSERT_EQUAL(0, g_i2c_shim.slave_ioctls);
+    TEST_ASSERT_TRUE(syscalls < g_i2c_shim.transfers);
+
+    (void)snprintf(msg, sizeof(msg), "%u commands: %u syscalls for %u transfers, %u opening the node per transfer",
+                   I2C_SHIM_COMMANDS, (unsigned)syscalls, (unsigned)g_i2c_shim.transfers, 4u * g_i2c_shim.transfers);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device));
+}
+
+TEST(hal_linux_i2c, no_rdwr)
+{
+    ATCAIfaceCfg cfg;
+    ATCADevice device = NULL;
+    uint8_t random[RANDOM_NUM_SIZE];
+    int i;
+
+    /* Adapters without I2C_RDWR use read and write, readdressed only when
+       the address changes - here for the wake general call ahead of each
+       command */
+    g_i2c_shim_rdwr = false;
+    i2c_shim_cfg_init(&cfg, 0xC2);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&device, &cfg));
+
+    memset(&g_i2c_shim, 0, sizeof(g_i2c_shim));
+    for (i = 0; i < I2C_SHIM_COMMANDS; i++)
+    {
+        TEST_ASSERT_SUCCESS(calib_random(device, random));
+    }
+    TEST_ASSERT_EQUAL(2 * I2C_SHIM_COMMANDS, g_i2c_shim.slave_ioctls);
+    TEST_ASSERT_EQUAL(g_i2c_shim.transfers, g_i2c_shim.reads + g_i2c_shim.writes);
+
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&device));
+}
+
+/** \brief Run random commands on one device of the shared bus */
+static void* i2c_shim_random_thread(void* arg)
+{
+    ATCADevice device = (ATCADevice)arg;
+    uint8_t random[RANDOM_NUM_SIZE];
+    intptr_t failures = 0;
+    int i;
+
+    for (i = 0; i < I2C_SHIM_COMMANDS; i++)
+    {
+        if (ATCA_SUCCESS != calib_random(device, random))
+        {
+            failures++;
+        }
+    }
+
+    return (void*)failures;
+}
+
+TEST(hal_linux_i2c, concurrent_devices)
+{
+    ATCAIfaceCfg cfg[2];
+    ATCADevice device[2] = { NULL, NULL };
+    pthread_t thread[2];
+    void* failures;
+    int i;
+
+    /* Without I2C_RDWR a transfer is an I2C_SLAVE followed by a read or a
+       write, so threads on the same bus readdress each other's transfers
+       unless each one holds the bus */
+    g_i2c_shim_rdwr = false;
+    g_i2c_shim_slave_delay = 200;
+    for (i = 0; i < 2; i++)
+    {
+        i2c_shim_cfg_init(&cfg[i], (uint8_t)(0xC0 + 2 * i));
+        TEST_ASSERT_SUCCESS(atcab_init_ext(&device[i], &cfg[i]));
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        TEST_ASSERT_EQUAL(0, pthread_create(&thread[i], NULL, i2c_shim_random_thread, device[i]));
+    }
+    for (i = 0; i < 2; i++)
+    {
+        TEST_ASSERT_EQUAL(0, pthread_join(thread[i], &failures));
+        TEST_ASSERT_EQUAL(0, (intptr_t)failures);
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        TEST_ASSERT_SUCCESS(atcab_release_ext(&device[i]));
+    }
+    TEST_ASSERT_EQUAL(1, g_i2c_shim.opens);
+    TEST_ASSERT_EQUAL(1, g_i2c_shim.closes);
+}
+
+TEST_GROUP_RUNNER(hal_linux_i2c)
+{
+    RUN_TEST_CASE(hal_linux_i2c, shared_descriptor);
+    RUN_TEST_CASE(hal_linux_i2c, combined_transfers);
+    RUN_TEST_CASE(hal_linux_i2c, no_rdwr);
+    RUN_TEST_CASE(hal_linux_i2c, concurrent_devices);
+}
+
+#endif
@@ -0,0 +1,344 @@
+/**
+ * \file
+ * \brief Tests for the multi-device request router run against simulated
+ *        devices on two buses
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+#include "atca_router.h"
+
+#if ATCA_CA_SUPPORT && !defined(ATCA_NO_HEAP)
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define ROUTER_TEST_BUSES           (2)
+#define ROUTER_TEST_DEVICES         (4)
+#define ROUTER_TEST_SIGN_USEC       (100000)
+
+static atca_mock_bus_t g_router_bus[ROUTER_TEST_BUSES];
+static atca_mock_device_t* g_router_mock[ROUTER_TEST_DEVICES];
+static ATCAIfaceCfg g_router_cfg[ROUTER_TEST_DEVICES];
+static atca_router_t g_router;
+
+static void router_count_callback(atca_router_req_t* req)
+{
+    (*(int*)req->user_data)++;
+}
+
+TEST_GROUP(atca_router);
+
+TEST_SETUP(atca_router)
+{
+    int i;
+
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+    for (i = 0; i < ROUTER_TEST_BUSES; i++)
+    {
+        TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_router_bus[i]));
+    }
+    TEST_ASSERT_SUCCESS(atca_router_init(&g_router));
+
+    /* Two devices on each of two buses */
+    for (i = 0; i < ROUTER_TEST_DEVICES; i++)
+    {
+        atca_mock_bus_t* bus = &g_router_bus[i % ROUTER_TEST_BUSES];
+        uint8_t address = (uint8_t)(0xC0 + 2 * (i / ROUTER_TEST_BUSES));
+
+        TEST_ASSERT_NOT_NULL(g_router_mock[i] = atca_mock_bus_add_device(bus, address));
+        atca_mock_set_exec_time(g_router_mock[i], ATCA_SIGN, ROUTER_TEST_SIGN_USEC);
+        atca_mock_cfg_init(&g_router_cfg[i], bus, ATECC608, address);
+        TEST_ASSERT_SUCCESS(atca_router_add_cfg(&g_router, &g_router_cfg[i]));
+    }
+}
+
+TEST_TEAR_DOWN(atca_router)
+{
+    int i;
+
+    (void)atca_router_release(&g_router);
+    for (i = 0; i < ROUTER_TEST_BUSES; i++)
+    {
+        atca_mock_bus_release(&g_router_bus[i]);
+    }
+    (void)atca_mock_hal_unregister();
+}
+
+TEST(atca_router, least_loaded_dispatch)
+{
+    atca_router_req_t req[2 * ROUTER_TEST_DEVICES];
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signature[2 * ROUTER_TEST_DEVICES][ATCA_ECCP256_SIG_SIZE];
+    size_t per_device[ROUTER_TEST_DEVICES];
+    size_t i;
+
+    memset(digest, 0xA5, sizeof(digest));
+    memset(per_device, 0, sizeof(per_device));
+
+    for (i = 0; i < 2 * ROUTER_TEST_DEVICES; i++)
+    {
+        memset(&req[i], 0, sizeof(req[i]));
+        req[i].op = ATCA_ROUTER_SIGN;
+        req[i].input = digest;
+        req[i].output = signature[i];
+        TEST_ASSERT_SUCCESS(atca_router_submit(&g_router, &req[i]));
+        TEST_ASSERT_EQUAL(ATCA_RX_NO_RESPONSE, req[i].status);
+        per_device[req[i].device_idx]++;
+    }
+
+    /* Equal devices share the queued work evenly */
+    for (i = 0; i < ROUTER_TEST_DEVICES; i++)
+    {
+        TEST_ASSERT_EQUAL(2, per_device[i]);
+    }
+
+    TEST_ASSERT_SUCCESS(atca_router_run(&g_router));
+    for (i = 0; i < 2 * ROUTER_TEST_DEVICES; i++)
+    {
+        TEST_ASSERT_SUCCESS(req[i].status);
+    }
+}
+
+TEST(atca_router, concurrent_signatures)
+{
+    atca_router_req_t req[2 * ROUTER_TEST_DEVICES];
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signature[2 * ROUTER_TEST_DEVICES][ATCA_ECCP256_SIG_SIZE];
+    uint8_t zero[ATCA_ECCP256_SIG_SIZE];
+    uint64_t start;
+    uint64_t elapsed;
+    int completions = 0;
+    size_t i;
+
+    memset(digest, 0x3C, sizeof(digest));
+    memset(zero, 0, sizeof(zero));
+    memset(signature, 0, sizeof(signature));
+
+    start = atca_mock_time_usec();
+    for (i = 0; i < 2 * ROUTER_TEST_DEVICES; i++)
+    {
+        memset(&req[i], 0, sizeof(req[i]));
+        req[i].op = ATCA_ROUTER_SIGN;
+        req[i].key_id = 0;
+        req[i].input = digest;
+        req[i].output = signature[i];
+        req[i].callback = router_count_callback;
+        req[i].user_data = &completions;
+        TEST_ASSERT_SUCCESS(atca_router_submit(&g_router, &req[i]));
+    }
+    TEST_ASSERT_SUCCESS(atca_router_run(&g_router));
+    elapsed = atca_mock_time_usec() - start;
+
+    TEST_ASSERT_EQUAL(2 * ROUTER_TEST_DEVICES, completions);
+    for (i = 0; i < 2 * ROUTER_TEST_DEVICES; i++)
+    {
+        TEST_ASSERT_SUCCESS(req[i].status);
+        TEST_ASSERT_TRUE(memcmp(signature[i], zero, sizeof(zero)));
+    }
+    for (i = 0; i < ROUTER_TEST_DEVICES; i++)
+    {
+        TEST_ASSERT_EQUAL(2, g_router_mock[i]->stats.opcode_count[ATCA_SIGN]);
+        TEST_ASSERT_EQUAL(2, g_router.workers[i].completed);
+    }
+
+    /* One device would need at least 800ms for eight signatures */
+    TEST_ASSERT_TRUE(elapsed < 4 * ROUTER_TEST_SIGN_USEC);
+}
+
+#if defined(ATCA_NO_POLL) || defined(ATCA_POLL_ADAPTIVE)
+TEST(atca_router, shared_bus)
+{
+    atca_mock_bus_t bus;
+    atca_mock_device_t* mock[ATCA_MOCK_MAX_DEVICES];
+    ATCAIfaceCfg cfg[ATCA_MOCK_MAX_DEVICES];
+    atca_router_t router;
+    atca_router_req_t req[ATCA_MOCK_MAX_DEVICES];
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signature[ATCA_MOCK_MAX_DEVICES][ATCA_ECCP256_SIG_SIZE];
+    uint32_t expected = 0;
+    uint64_t start;
+    uint64_t elapsed;
+    size_t i;
+
+    /* Four devices at different addresses on one bus */
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&bus));
+    TEST_ASSERT_SUCCESS(atca_router_init(&router));
+    for (i = 0; i < ATCA_MOCK_MAX_DEVICES; i++)
+    {
+        TEST_ASSERT_NOT_NULL(mock[i] = atca_mock_bus_add_device(&bus, (uint8_t)(0xC0 + 2 * i)));
+        atca_mock_cfg_init(&cfg[i], &bus, ATECC608, (uint8_t)(0xC0 + 2 * i));
+        TEST_ASSERT_SUCCESS(atca_router_add_cfg(&router, &cfg[i]));
+    }
+
+    /* Devices that take as long as the execution time tables say */
+    for (i = 0; i < ATCA_MOCK_MAX_DEVICES; i++)
+    {
+        ATCADevice device = router.workers[i].device;
+        uint8_t opcodes[] = { ATCA_RANDOM, ATCA_NONCE, ATCA_SIGN };
+        size_t j;
+
+        TEST_ASSERT_TRUE(router.workers[i].shared_bus);
+
+        expected = 0;
+        for (j = 0; j < sizeof(opcodes); j++)
+        {
+            TEST_ASSERT_SUCCESS(calib_get_execution_time(opcodes[j], device));
+            atca_mock_set_exec_time(mock[i], opcodes[j], 1000u * device->execution_time_msec - 500u);
+            expected += device->execution_time_msec;
+        }
+        atca_mock_reset_stats(mock[i]);
+    }
+
+    memset(digest, 0x6E, sizeof(digest));
+    start = atca_mock_time_usec();
+    for (i = 0; i < ATCA_MOCK_MAX_DEVICES; i++)
+    {
+        memset(&req[i], 0, sizeof(req[i]));
+        req[i].op = ATCA_ROUTER_SIGN;
+        req[i].input = digest;
+        req[i].output = signature[i];
+        TEST_ASSERT_SUCCESS(atca_router_submit(&router, &req[i]));
+    }
+    TEST_ASSERT_SUCCESS(atca_router_run(&router));
+    elapsed = atca_mock_time_usec() - start;
+
+    for (i = 0; i < ATCA_MOCK_MAX_DEVICES; i++)
+    {
+        TEST_ASSERT_SUCCESS(req[i].status);
+        TEST_ASSERT_EQUAL(1, mock[i]->stats.opcode_count[ATCA_SIGN]);
+
+        /* Each command is polled once, when the device is expected to be done */
+        TEST_ASSERT_EQUAL(mock[i]->stats.commands, mock[i]->stats.polls);
+    }
+
+    /* The four signs share the bus instead of running one after another */
+    TEST_ASSERT_TRUE(elapsed < 2000u * expected);
+
+    (void)atca_router_release(&router);
+    atca_mock_bus_release(&bus);
+}
+#endif
+
+TEST(atca_router, ecdh_random)
+{
+    uint8_t public_key[ATCA_ECCP256_PUBKEY_SIZE];
+    uint8_t pms[ATCA_KEY_SIZE];
+    uint8_t random[RANDOM_NUM_SIZE];
+    uint8_t zero[ATCA_KEY_SIZE];
+
+    memset(public_key, 0x11, sizeof(public_key));
+    memset(zero, 0, sizeof(zero));
+    memset(pms, 0, sizeof(pms));
+    memset(random, 0, sizeof(random));
+
+    TEST_ASSERT_SUCCESS(atca_router_ecdh(&g_router, 0, public_key, pms));
+    TEST_ASSERT_TRUE(memcmp(pms, zero, sizeof(zero)));
+
+    TEST_ASSERT_SUCCESS(atca_router_random(&g_router, random));
+    TEST_ASSERT_TRUE(memcmp(random, zero, sizeof(zero)));
+}
+
+#ifdef __linux__
+#define ROUTER_TEST_THREADS         (4)
+#define ROUTER_TEST_THREAD_SIGNS    (2)
+
+static void* router_sign_thread(void* arg)
+{
+    ATCA_STATUS* status = (ATCA_STATUS*)arg;
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signature[ATCA_ECCP256_SIG_SIZE];
+    int i;
+
+    memset(digest, 0x5A, sizeof(digest));
+    *status = ATCA_SUCCESS;
+    for (i = 0; i < ROUTER_TEST_THREAD_SIGNS && ATCA_SUCCESS == *status; i++)
+    {
+        *status = atca_router_sign(&g_router, 0, digest, signature);
+    }
+    return NULL;
+}
+
+TEST(atca_router, threads)
+{
+    pthread_t thread[ROUTER_TEST_THREADS];
+    ATCA_STATUS status[ROUTER_TEST_THREADS];
+    uint32_t signs = 0;
+    size_t i;
+
+    /* Each thread waits on its own signs while one of them drives the devices */
+    for (i = 0; i < ROUTER_TEST_THREADS; i++)
+    {
+        TEST_ASSERT_EQUAL(0, pthread_create(&thread[i], NULL, router_sign_thread, &status[i]));
+    }
+    for (i = 0; i < ROUTER_TEST_THREADS; i++)
+    {
+        TEST_ASSERT_EQUAL(0, pthread_join(thread[i], NULL));
+        TEST_ASSERT_SUCCESS(status[i]);
+    }
+
+    for (i = 0; i < ROUTER_TEST_DEVICES; i++)
+    {
+        signs += g_router_mock[i]->stats.opcode_count[ATCA_SIGN];
+    }
+    TEST_ASSERT_EQUAL(ROUTER_TEST_THREADS * ROUTER_TEST_THREAD_SIGNS, signs);
+    TEST_ASSERT_FALSE(g_router.running);
+}
+#endif
+
+TEST(atca_router, errors)
+{
+    atca_router_t empty;
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signature[ATCA_ECCP256_SIG_SIZE];
+
+    memset(digest, 0, sizeof(digest));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atca_router_sign(&g_router, 0, NULL, signature));
+
+    TEST_ASSERT_SUCCESS(atca_router_init(&empty));
+    TEST_ASSERT_EQUAL(ATCA_NO_DEVICES, atca_router_sign(&empty, 0, digest, signature));
+    TEST_ASSERT_SUCCESS(atca_router_release(&empty));
+}
+
+TEST_GROUP_RUNNER(atca_router)
+{
+    RUN_TEST_CASE(atca_router, least_loaded_dispatch);
+    RUN_TEST_CASE(atca_router, concurrent_signatures);
+#if defined(ATCA_NO_POLL) || defined(ATCA_POLL_ADAPTIVE)
+    RUN_TEST_CASE(atca_router, shared_bus);
+#endif
+    RUN_TEST_CASE(atca_router, ecdh_random);
+#ifdef __linux__
+    RUN_TEST_CASE(atca_router, threads);
+#endif
+    RUN_TEST_CASE(atca_router, errors);
+}
+
+#endif
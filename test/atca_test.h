@@ -217,6 +217,7 @@ int select_ecc204(int argc, char* argv[]);
 
 int certdata_unit_tests(int argc, char* argv[]);
 int certio_unit_tests(int argc, char* argv[]);
+int run_mock_tests(int argc, char* argv[]);
 ATCA_STATUS is_config_locked(bool* isLocked);
 ATCA_STATUS is_data_locked(bool* isLocked);
 int lock_status(int argc, char* argv[]);
@@ -260,6 +260,13 @@ int certio_unit_tests(int argc, char* argv[])
 }
 #endif
 
+void RunAllMockTests(void);
+int run_mock_tests(int argc, char* argv[])
+{
+    UnityMain(argc, (const char**)argv, RunAllMockTests);
+    return ATCA_SUCCESS;
+}
+
 ATCA_STATUS is_config_locked(bool* isLocked)
 {
     ATCA_STATUS status;
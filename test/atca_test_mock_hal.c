@@ -0,0 +1,781 @@
+/**
+ * \file
+ * \brief Simulated CryptoAuth I2C bus used to test the library without hardware
+ *
+ * The mock hal is registered in place of the I2C hal and models the parts of
+ * the device behavior the library depends on: sleep/idle/active states, the
+ * wake sequence, devices NACKing their address while a command executes, the
+ * watchdog and enough of the command set to run the basic API flows.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "atca_test_mock_hal.h"
+#include "crypto/hashes/sha2_routines.h"
+
+#if ATCA_CA_SUPPORT
+
+/* Device status codes returned in a 4 byte response */
+#define MOCK_STATUS_SUCCESS         ((uint8_t)0x00)
+#define MOCK_STATUS_CHECKMAC_FAIL   ((uint8_t)0x01)
+#define MOCK_STATUS_PARSE_ERROR     ((uint8_t)0x03)
+#define MOCK_STATUS_EXECUTION_ERROR ((uint8_t)0x0F)
+#define MOCK_STATUS_CRC_ERROR       ((uint8_t)0xFF)
+
+static ATCAHAL_t* mock_old_hal;
+static ATCAHAL_t* mock_old_phy;
+static bool mock_registered;
+
+/** \brief Monotonic time in microseconds */
+uint64_t atca_mock_time_usec(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+
+    (void)QueryPerformanceFrequency(&freq);
+    (void)QueryPerformanceCounter(&count);
+    return (uint64_t)(count.QuadPart / (freq.QuadPart / 1000000));
+#else
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+#endif
+}
+
+static void mock_clear_volatile(atca_mock_device_t* device)
+{
+    device->tempkey_valid = false;
+    device->msgdigbuf_valid = false;
+    memset(device->tempkey, 0, sizeof(device->tempkey));
+    memset(device->msgdigbuf, 0, sizeof(device->msgdigbuf));
+}
+
+/** \brief Apply the watchdog - an active device goes to sleep once the period expires */
+static void mock_update_state(atca_mock_device_t* device, uint64_t now)
+{
+    if (ATCA_MOCK_STATE_ACTIVE == device->state && device->watchdog_usec
+        && (now - device->wake_time) >= device->watchdog_usec)
+    {
+        device->state = ATCA_MOCK_STATE_SLEEP;
+        device->response_len = 0;
+        device->stats.watchdog_expiries++;
+        mock_clear_volatile(device);
+    }
+}
+
+static void mock_wake(atca_mock_device_t* device, uint64_t now)
+{
+    static const uint8_t wake_response[] = { 0x04, 0x11, 0x33, 0x43 };
+
+    mock_update_state(device, now);
+    if (ATCA_MOCK_STATE_ACTIVE != device->state)
+    {
+        if (ATCA_MOCK_STATE_SLEEP == device->state)
+        {
+            mock_clear_volatile(device);
+        }
+        device->state = ATCA_MOCK_STATE_ACTIVE;
+        device->wake_time = now;
+        device->busy_until = now;
+        memcpy(device->response, wake_response, sizeof(wake_response));
+        device->response_len = sizeof(wake_response);
+        device->response_offset = 0;
+        device->stats.wakes++;
+    }
+}
+
+static void mock_set_response(atca_mock_device_t* device, const uint8_t* data, size_t length)
+{
+    device->response_len = (uint8_t)(length + 1 + ATCA_CRC_SIZE);
+    device->response[ATCA_COUNT_IDX] = device->response_len;
+    memcpy(&device->response[1], data, length);
+    atCRC(device->response_len - ATCA_CRC_SIZE, device->response, &device->response[device->response_len - ATCA_CRC_SIZE]);
+    device->response_offset = 0;
+}
+
+static void mock_set_status(atca_mock_device_t* device, uint8_t status)
+{
+    mock_set_response(device, &status, 1);
+}
+
+/** \brief Deterministic data the device returns in place of random numbers and keys */
+static void mock_fill(uint8_t* buf, size_t length, uint8_t seed1, uint16_t seed2)
+{
+    atcac_sha2_256_ctx ctx;
+    uint8_t block[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t seed[3] = { seed1, (uint8_t)seed2, (uint8_t)(seed2 >> 8) };
+    size_t offset;
+
+    memset(block, 0, sizeof(block));
+    for (offset = 0; offset < length; offset += sizeof(block))
+    {
+        size_t copy = (length - offset > sizeof(block)) ? sizeof(block) : length - offset;
+        (void)atcac_sw_sha2_256_init(&ctx);
+        (void)atcac_sw_sha2_256_update(&ctx, seed, sizeof(seed));
+        (void)atcac_sw_sha2_256_update(&ctx, block, sizeof(block));
+        (void)atcac_sw_sha2_256_finish(&ctx, block);
+        memcpy(&buf[offset], block, copy);
+    }
+}
+
+/** \brief Not a real signature - R is derived from the digest and key and S from R */
+static void mock_sign(uint8_t* signature, const uint8_t* digest, uint16_t key_id)
+{
+    mock_fill(signature, ATCA_SIG_SIZE, digest[0] ^ digest[31], key_id);
+    signature[0] ^= digest[1];
+}
+
+/** \brief Locate the memory addressed by a read or write command */
+static uint8_t* mock_get_memory(atca_mock_device_t* device, uint8_t zone, uint16_t address, size_t length)
+{
+    size_t offset;
+
+    switch (zone & 0x03)
+    {
+    case ATCA_ZONE_CONFIG:
+        offset = ((address >> 3) & 0x1F) * 32 + (address & 0x07) * 4;
+        return (offset + length <= sizeof(device->config)) ? &device->config[offset] : NULL;
+    case ATCA_ZONE_OTP:
+        offset = ((address >> 3) & 0x1F) * 32 + (address & 0x07) * 4;
+        return (offset + length <= sizeof(device->otp)) ? &device->otp[offset] : NULL;
+    case ATCA_ZONE_DATA:
+        offset = (address >> 8) * 32 + (address & 0x07) * 4;
+        return (offset + length <= ATCA_MOCK_SLOT_SIZE) ? &device->data[(address >> 3) & 0x0F][offset] : NULL;
+    default:
+        return NULL;
+    }
+}
+
+/** \brief Execute a command packet and prepare the response */
+static void mock_execute(atca_mock_device_t* device, const uint8_t* packet)
+{
+    uint8_t opcode = packet[ATCA_OPCODE_IDX];
+    uint8_t param1 = packet[ATCA_PARAM1_IDX];
+    uint16_t param2 = (uint16_t)(packet[ATCA_PARAM2_IDX] | (packet[ATCA_PARAM2_IDX + 1] << 8));
+    const uint8_t* data = &packet[ATCA_DATA_IDX];
+    size_t data_len = packet[ATCA_COUNT_IDX] - ATCA_CMD_SIZE_MIN;
+    uint8_t out[ATCA_RSP_SIZE_MAX];
+    uint8_t* mem;
+    size_t length;
+
+    switch (opcode)
+    {
+    case ATCA_READ:
+        length = (param1 & ATCA_ZONE_READWRITE_32) ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE;
+        if (NULL != (mem = mock_get_memory(device, param1, param2, length)))
+        {
+            mock_set_response(device, mem, length);
+        }
+        else
+        {
+            mock_set_status(device, MOCK_STATUS_PARSE_ERROR);
+        }
+        break;
+
+    case ATCA_WRITE:
+        length = (param1 & ATCA_ZONE_READWRITE_32) ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE;
+        if (data_len >= length && NULL != (mem = mock_get_memory(device, param1, param2, length)))
+        {
+            memcpy(mem, data, length);
+            mock_set_status(device, MOCK_STATUS_SUCCESS);
+        }
+        else
+        {
+            mock_set_status(device, MOCK_STATUS_PARSE_ERROR);
+        }
+        break;
+
+    case ATCA_INFO:
+        memcpy(out, &device->config[4], 4);
+        mock_set_response(device, out, 4);
+        break;
+
+    case ATCA_RANDOM:
+        mock_fill(out, RANDOM_NUM_SIZE, opcode, (uint16_t)device->random_state++);
+        mock_set_response(device, out, RANDOM_NUM_SIZE);
+        break;
+
+    case ATCA_NONCE:
+        if (NONCE_MODE_PASSTHROUGH == (param1 & NONCE_MODE_MASK))
+        {
+            length = (param1 & NONCE_MODE_INPUT_LEN_64) ? 64 : 32;
+            if (NONCE_MODE_TARGET_MSGDIGBUF == (param1 & NONCE_MODE_TARGET_MASK))
+            {
+                memcpy(device->msgdigbuf, data, length);
+                device->msgdigbuf_valid = true;
+            }
+            else
+            {
+                memcpy(device->tempkey, data, ATCA_SHA256_DIGEST_SIZE);
+                device->tempkey_valid = true;
+            }
+            mock_set_status(device, MOCK_STATUS_SUCCESS);
+        }
+        else
+        {
+            mock_fill(out, RANDOM_NUM_SIZE, opcode, (uint16_t)device->random_state++);
+            memcpy(device->tempkey, out, ATCA_SHA256_DIGEST_SIZE);
+            device->tempkey_valid = true;
+            mock_set_response(device, out, RANDOM_NUM_SIZE);
+        }
+        break;
+
+    case ATCA_SIGN:
+    {
+        bool use_msgdigbuf = (param1 & SIGN_MODE_SOURCE_MSGDIGBUF) ? true : false;
+        const uint8_t* digest = use_msgdigbuf ? device->msgdigbuf : device->tempkey;
+
+        if ((use_msgdigbuf && !device->msgdigbuf_valid) || (!use_msgdigbuf && !device->tempkey_valid))
+        {
+            mock_set_status(device, MOCK_STATUS_EXECUTION_ERROR);
+            break;
+        }
+        mock_sign(out, digest, param2);
+        mock_set_response(device, out, ATCA_SIG_SIZE);
+        mock_clear_volatile(device);
+        break;
+    }
+
+    case ATCA_VERIFY:
+    {
+        bool use_msgdigbuf = (param1 & VERIFY_MODE_SOURCE_MSGDIGBUF) ? true : false;
+        const uint8_t* digest = use_msgdigbuf ? device->msgdigbuf : device->tempkey;
+        uint8_t status = MOCK_STATUS_CHECKMAC_FAIL;
+        uint16_t key_id;
+
+        if (VERIFY_MODE_EXTERNAL != (param1 & VERIFY_MODE_MASK) || data_len < ATCA_SIG_SIZE + ATCA_PUB_KEY_SIZE)
+        {
+            mock_set_status(device, MOCK_STATUS_PARSE_ERROR);
+            break;
+        }
+        if ((use_msgdigbuf && !device->msgdigbuf_valid) || (!use_msgdigbuf && !device->tempkey_valid))
+        {
+            mock_set_status(device, MOCK_STATUS_EXECUTION_ERROR);
+            break;
+        }
+        /* The public key identifies the slot that would have made the signature */
+        for (key_id = 0; key_id < 16; key_id++)
+        {
+            mock_fill(out, ATCA_PUB_KEY_SIZE, ATCA_GENKEY, key_id);
+            if (!memcmp(out, &data[ATCA_SIG_SIZE], ATCA_PUB_KEY_SIZE))
+            {
+                mock_sign(out, digest, key_id);
+                if (!memcmp(out, data, ATCA_SIG_SIZE))
+                {
+                    status = MOCK_STATUS_SUCCESS;
+                }
+                break;
+            }
+        }
+        mock_set_status(device, status);
+        mock_clear_volatile(device);
+        break;
+    }
+
+    case ATCA_GENKEY:
+        mock_fill(out, ATCA_PUB_KEY_SIZE, opcode, param2);
+        mock_set_response(device, out, ATCA_PUB_KEY_SIZE);
+        break;
+
+    case ATCA_ECDH:
+        if (ECDH_MODE_OUTPUT_CLEAR == (param1 & ECDH_MODE_OUTPUT_MASK))
+        {
+            mock_fill(out, ATCA_KEY_SIZE, data[0], param2);
+            mock_set_response(device, out, ATCA_KEY_SIZE);
+        }
+        else
+        {
+            mock_set_status(device, MOCK_STATUS_SUCCESS);
+        }
+        break;
+
+    case ATCA_SHA:
+        switch (param1 & SHA_MODE_MASK)
+        {
+        case SHA_MODE_SHA256_START:
+        case SHA_MODE_HMAC_START:
+            (void)atcac_sw_sha2_256_init(&device->sha_ctx);
+            mock_set_status(device, MOCK_STATUS_SUCCESS);
+            break;
+        case SHA_MODE_SHA256_UPDATE:
+            (void)atcac_sw_sha2_256_update(&device->sha_ctx, data, data_len);
+            mock_set_status(device, MOCK_STATUS_SUCCESS);
+            break;
+        case SHA_MODE_SHA256_END:
+        case SHA_MODE_HMAC_END:
+            (void)atcac_sw_sha2_256_update(&device->sha_ctx, data, data_len);
+            (void)atcac_sw_sha2_256_finish(&device->sha_ctx, out);
+            if (SHA_MODE_TARGET_TEMPKEY == (param1 & SHA_MODE_TARGET_MASK))
+            {
+                memcpy(device->tempkey, out, ATCA_SHA256_DIGEST_SIZE);
+                device->tempkey_valid = true;
+            }
+            mock_set_response(device, out, ATCA_SHA256_DIGEST_SIZE);
+            break;
+        case SHA_MODE_READ_CONTEXT:
+        {
+            /* The host only sends whole blocks so the context is the hash
+               state and the length processed */
+            sw_sha256_ctx* ctx = (sw_sha256_ctx*)&device->sha_ctx;
+
+            if (ctx->block_size)
+            {
+                mock_set_status(device, MOCK_STATUS_EXECUTION_ERROR);
+                break;
+            }
+            memcpy(out, ctx->hash, sizeof(ctx->hash));
+            memcpy(&out[sizeof(ctx->hash)], &ctx->total_msg_size, sizeof(ctx->total_msg_size));
+            mock_set_response(device, out, sizeof(ctx->hash) + sizeof(ctx->total_msg_size));
+            break;
+        }
+        case SHA_MODE_WRITE_CONTEXT:
+        {
+            sw_sha256_ctx* ctx = (sw_sha256_ctx*)&device->sha_ctx;
+
+            if (data_len != sizeof(ctx->hash) + sizeof(ctx->total_msg_size))
+            {
+                mock_set_status(device, MOCK_STATUS_PARSE_ERROR);
+                break;
+            }
+            (void)atcac_sw_sha2_256_init(&device->sha_ctx);
+            memcpy(ctx->hash, data, sizeof(ctx->hash));
+            memcpy(&ctx->total_msg_size, &data[sizeof(ctx->hash)], sizeof(ctx->total_msg_size));
+            mock_set_status(device, MOCK_STATUS_SUCCESS);
+            break;
+        }
+        default:
+            mock_set_status(device, MOCK_STATUS_SUCCESS);
+            break;
+        }
+        break;
+
+    case ATCA_AES:
+        /* Keystream XOR stands in for the block cipher */
+        mock_fill(out, AES_DATA_SIZE, opcode, param2);
+        for (length = 0; length < AES_DATA_SIZE; length++)
+        {
+            out[length] ^= data[length];
+        }
+        mock_set_response(device, out, AES_DATA_SIZE);
+        break;
+
+    case ATCA_COUNTER:
+        if (COUNTER_MODE_INCREMENT == param1)
+        {
+            device->counter[param2 & 0x01]++;
+        }
+        out[0] = (uint8_t)device->counter[param2 & 0x01];
+        out[1] = (uint8_t)(device->counter[param2 & 0x01] >> 8);
+        out[2] = (uint8_t)(device->counter[param2 & 0x01] >> 16);
+        out[3] = (uint8_t)(device->counter[param2 & 0x01] >> 24);
+        mock_set_response(device, out, 4);
+        break;
+
+    default:
+        mock_set_status(device, MOCK_STATUS_SUCCESS);
+        break;
+    }
+}
+
+static atca_mock_device_t* mock_find_device(atca_mock_bus_t* bus, uint8_t address)
+{
+    int i;
+
+    for (i = 0; i < ATCA_MOCK_MAX_DEVICES; i++)
+    {
+        if (bus->devices[i].present && address == bus->devices[i].address)
+        {
+            return &bus->devices[i];
+        }
+    }
+    return NULL;
+}
+
+/** \brief Get the device addressed by a transfer if it is able to acknowledge it */
+static ATCA_STATUS mock_select(atca_mock_bus_t* bus, uint8_t address, uint64_t now, atca_mock_device_t** device)
+{
+    if (NULL == (*device = mock_find_device(bus, address)))
+    {
+        return ATCA_COMM_FAIL;
+    }
+
+    mock_update_state(*device, now);
+    if (ATCA_MOCK_STATE_ACTIVE != (*device)->state)
+    {
+        return ATCA_COMM_FAIL;
+    }
+
+    if (now < (*device)->busy_until)
+    {
+        (*device)->stats.nacks++;
+        return ATCA_COMM_FAIL;
+    }
+    return ATCA_SUCCESS;
+}
+
+static ATCA_STATUS mock_wake_all(atca_mock_bus_t* bus, uint64_t now)
+{
+    int i;
+
+    bus->general_calls++;
+    for (i = 0; i < ATCA_MOCK_MAX_DEVICES; i++)
+    {
+        if (bus->devices[i].present)
+        {
+            mock_wake(&bus->devices[i], now);
+        }
+    }
+    return ATCA_SUCCESS;
+}
+
+static ATCA_STATUS mock_hal_init(ATCAIface iface, ATCAIfaceCfg* cfg)
+{
+    if (!cfg->cfg_data)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    iface->hal_data = cfg->cfg_data;
+    return ATCA_SUCCESS;
+}
+
+static ATCA_STATUS mock_hal_post_init(ATCAIface iface)
+{
+    ((void)iface);
+    return ATCA_SUCCESS;
+}
+
+/** \brief Write to the bus as an I2C master would. Address 0x00 is the
+ *         general call that wakes every device. */
+ATCA_STATUS atca_mock_bus_write(atca_mock_bus_t* bus, uint8_t address, const uint8_t* txdata, int txlength)
+{
+    atca_mock_device_t* device;
+    uint64_t now = atca_mock_time_usec();
+    ATCA_STATUS status;
+
+    if (!bus)
+    {
+        return ATCA_NOT_INITIALIZED;
+    }
+
+    (void)hal_lock_mutex(bus->mutex);
+
+    do
+    {
+        if (0x00 == address)
+        {
+            /* General call - the wake pulse */
+            status = mock_wake_all(bus, now);
+            break;
+        }
+
+        if (ATCA_SUCCESS != (status = mock_select(bus, address, now, &device)))
+        {
+            break;
+        }
+
+        if (!txdata || txlength < 1)
+        {
+            break;
+        }
+
+        switch (txdata[0])
+        {
+        case 0x00:
+            /* Reset the read pointer ahead of reading a response */
+            device->stats.polls++;
+            device->response_offset = 0;
+            break;
+        case 0x01:
+            device->state = ATCA_MOCK_STATE_SLEEP;
+            device->stats.sleeps++;
+            mock_clear_volatile(device);
+            break;
+        case 0x02:
+            device->state = ATCA_MOCK_STATE_IDLE;
+            device->stats.idles++;
+            break;
+        case 0x03:
+            device->stats.commands++;
+            if (txlength < ATCA_CMD_SIZE_MIN + 1 || txdata[1] != txlength - 1)
+            {
+                mock_set_status(device, MOCK_STATUS_PARSE_ERROR);
+            }
+            else if (ATCA_SUCCESS != atCheckCrc(&txdata[1]))
+            {
+                mock_set_status(device, MOCK_STATUS_CRC_ERROR);
+            }
+            else
+            {
+                device->stats.opcode_count[txdata[1 + ATCA_OPCODE_IDX]]++;
+                if (device->command_hook)
+                {
+                    device->command_hook(device, txdata[1 + ATCA_OPCODE_IDX], device->command_hook_arg);
+                }
+                if (device->fail_countdown && device->fail_opcode == txdata[1 + ATCA_OPCODE_IDX]
+                    && 0 == --device->fail_countdown)
+                {
+                    mock_set_status(device, MOCK_STATUS_EXECUTION_ERROR);
+                }
+                else
+                {
+                    mock_execute(device, &txdata[1]);
+                }
+                device->busy_until = now + device->exec_usec[txdata[1 + ATCA_OPCODE_IDX]];
+            }
+            break;
+        default:
+            status = ATCA_COMM_FAIL;
+            break;
+        }
+    }
+    while (0);
+
+    (void)hal_unlock_mutex(bus->mutex);
+
+    return status;
+}
+
+/** \brief Read from the bus as an I2C master would */
+ATCA_STATUS atca_mock_bus_read(atca_mock_bus_t* bus, uint8_t address, uint8_t* rxdata, uint16_t* rxlength)
+{
+    atca_mock_device_t* device;
+    ATCA_STATUS status;
+
+    if (!bus || !rxdata || !rxlength)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    (void)hal_lock_mutex(bus->mutex);
+
+    if (ATCA_SUCCESS == (status = mock_select(bus, address, atca_mock_time_usec(), &device)))
+    {
+        if (device->response_offset + *rxlength <= device->response_len)
+        {
+            memcpy(rxdata, &device->response[device->response_offset], *rxlength);
+            device->response_offset += (uint8_t)*rxlength;
+        }
+        else
+        {
+            status = ATCA_RX_NO_RESPONSE;
+        }
+    }
+
+    (void)hal_unlock_mutex(bus->mutex);
+
+    return status;
+}
+
+static ATCA_STATUS mock_hal_send(ATCAIface iface, uint8_t word_address, uint8_t* txdata, int txlength)
+{
+    return atca_mock_bus_write((atca_mock_bus_t*)atgetifacehaldat(iface), word_address, txdata, txlength);
+}
+
+static ATCA_STATUS mock_hal_receive(ATCAIface iface, uint8_t word_address, uint8_t* rxdata, uint16_t* rxlength)
+{
+    return atca_mock_bus_read((atca_mock_bus_t*)atgetifacehaldat(iface), word_address, rxdata, rxlength);
+}
+
+static ATCA_STATUS mock_hal_control(ATCAIface iface, uint8_t option, void* param, size_t paramlen)
+{
+    atca_mock_bus_t* bus = (atca_mock_bus_t*)atgetifacehaldat(iface);
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    ((void)param);
+    ((void)paramlen);
+
+    switch (option)
+    {
+    case ATCA_HAL_CONTROL_WAKE:
+        (void)hal_lock_mutex(bus->mutex);
+        status = mock_wake_all(bus, atca_mock_time_usec());
+        (void)hal_unlock_mutex(bus->mutex);
+        break;
+    case ATCA_HAL_CHANGE_BAUD:
+    case ATCA_HAL_CONTROL_SELECT:
+    case ATCA_HAL_CONTROL_DESELECT:
+        break;
+    default:
+        status = ATCA_UNIMPLEMENTED;
+        break;
+    }
+    return status;
+}
+
+static ATCA_STATUS mock_hal_release(void* hal_data)
+{
+    /* The bus belongs to the test */
+    ((void)hal_data);
+    return ATCA_SUCCESS;
+}
+
+static ATCAHAL_t mock_hal = {
+    mock_hal_init,
+    mock_hal_post_init,
+    mock_hal_send,
+    mock_hal_receive,
+    mock_hal_control,
+    mock_hal_release
+};
+
+/** \brief Initialize an empty simulated bus */
+ATCA_STATUS atca_mock_bus_init(atca_mock_bus_t* bus)
+{
+    memset(bus, 0, sizeof(*bus));
+    return hal_create_mutex(&bus->mutex, NULL);
+}
+
+void atca_mock_bus_release(atca_mock_bus_t* bus)
+{
+    if (bus->mutex)
+    {
+        (void)hal_destroy_mutex(bus->mutex);
+        bus->mutex = NULL;
+    }
+}
+
+/** \brief Add an unlocked ATECC608 style device with default timing to the bus */
+atca_mock_device_t* atca_mock_bus_add_device(atca_mock_bus_t* bus, uint8_t address)
+{
+    atca_mock_device_t* device = NULL;
+    int i;
+
+    for (i = 0; i < ATCA_MOCK_MAX_DEVICES; i++)
+    {
+        if (!bus->devices[i].present)
+        {
+            device = &bus->devices[i];
+            break;
+        }
+    }
+
+    if (device)
+    {
+        memset(device, 0, sizeof(*device));
+        device->present = true;
+        device->address = address;
+        device->state = ATCA_MOCK_STATE_SLEEP;
+        device->watchdog_usec = ATCA_MOCK_WATCHDOG_USEC;
+        device->random_state = address;
+
+        /* Serial number, revision and I2C address in the config zone */
+        device->config[0] = 0x01;
+        device->config[1] = 0x23;
+        device->config[2] = (uint8_t)i;
+        device->config[3] = address;
+        device->config[6] = 0x60;
+        device->config[7] = 0x02;
+        device->config[12] = 0xEE;
+        device->config[16] = address;
+        device->config[ATCA_CHIPMODE_OFFSET] = 0x00;
+        device->config[86] = 0x55;
+        device->config[87] = 0x55;
+
+        for (i = 0; i < 256; i++)
+        {
+            device->exec_usec[i] = ATCA_MOCK_DEFAULT_EXEC_USEC;
+        }
+    }
+    return device;
+}
+
+void atca_mock_set_exec_time(atca_mock_device_t* device, uint8_t opcode, uint32_t usec)
+{
+    device->exec_usec[opcode] = usec;
+}
+
+/** \brief Make the nth following command with the opcode fail with an execution error */
+void atca_mock_fail_command(atca_mock_device_t* device, uint8_t opcode, uint32_t nth)
+{
+    device->fail_opcode = opcode;
+    device->fail_countdown = nth;
+}
+
+/** \brief Call a function as each command arrives at the device. Tests use it
+ *         to hold a command on the device while they check what else can run. */
+void atca_mock_set_command_hook(atca_mock_device_t* device, atca_mock_command_hook_t hook, void* arg)
+{
+    device->command_hook_arg = arg;
+    device->command_hook = hook;
+}
+
+void atca_mock_reset_stats(atca_mock_device_t* device)
+{
+    memset(&device->stats, 0, sizeof(device->stats));
+}
+
+/** \brief Configure an interface to talk to a device on a simulated bus */
+void atca_mock_cfg_init(ATCAIfaceCfg* cfg, atca_mock_bus_t* bus, ATCADeviceType devtype, uint8_t address)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->iface_type = ATCA_I2C_IFACE;
+    cfg->devtype = devtype;
+#ifdef ATCA_ENABLE_DEPRECATED
+    cfg->atcai2c.slave_address = address;
+#else
+    cfg->atcai2c.address = address;
+#endif
+    cfg->atcai2c.baud = 100000;
+    cfg->wake_delay = 1500;
+    cfg->rx_retries = 20;
+    cfg->cfg_data = bus;
+}
+
+/** \brief Install the mock hal in place of the I2C hal */
+ATCA_STATUS atca_mock_hal_register(void)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    if (!mock_registered)
+    {
+        status = hal_iface_register_hal(ATCA_I2C_IFACE, &mock_hal, &mock_old_hal, NULL, &mock_old_phy);
+        mock_registered = (ATCA_SUCCESS == status);
+    }
+    return status;
+}
+
+/** \brief Restore the I2C hal that was registered before the mock hal */
+ATCA_STATUS atca_mock_hal_unregister(void)
+{
+    ATCAHAL_t* hal;
+    ATCAHAL_t* phy;
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    if (mock_registered)
+    {
+        status = hal_iface_register_hal(ATCA_I2C_IFACE, mock_old_hal, &hal, mock_old_phy, &phy);
+        mock_registered = false;
+    }
+    return status;
+}
+
+#endif /* ATCA_CA_SUPPORT */
@@ -0,0 +1,130 @@
+/**
+ * \file
+ * \brief Simulated CryptoAuth I2C bus used to test the library without hardware
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#ifndef ATCA_TEST_MOCK_HAL_H_
+#define ATCA_TEST_MOCK_HAL_H_
+
+#include "cryptoauthlib.h"
+#include "crypto/atca_crypto_sw_sha2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ATCA_MOCK_MAX_DEVICES           (4)
+#define ATCA_MOCK_DEFAULT_EXEC_USEC     (1000)
+#define ATCA_MOCK_WATCHDOG_USEC         (1300000)
+#define ATCA_MOCK_SLOT_SIZE             (416)
+
+typedef enum
+{
+    ATCA_MOCK_STATE_SLEEP,
+    ATCA_MOCK_STATE_IDLE,
+    ATCA_MOCK_STATE_ACTIVE
+} atca_mock_state_t;
+
+/** \brief Bus activity seen by a simulated device */
+typedef struct
+{
+    uint32_t wakes;                     /**< Transitions from sleep or idle to active */
+    uint32_t idles;                     /**< Idle commands received */
+    uint32_t sleeps;                    /**< Sleep commands received */
+    uint32_t commands;                  /**< Command packets received */
+    uint32_t polls;                     /**< Attempts to read a response (word address 0) */
+    uint32_t nacks;                     /**< Transfers rejected while a command was executing */
+    uint32_t watchdog_expiries;         /**< Times the watchdog put the device to sleep */
+    uint32_t opcode_count[256];         /**< Commands received by opcode */
+} atca_mock_stats_t;
+
+struct atca_mock_device_s;
+
+/** \brief Called as a command arrives at a device, with its bus locked */
+typedef void (*atca_mock_command_hook_t)(struct atca_mock_device_s* device, uint8_t opcode, void* arg);
+
+/** \brief A simulated ATECC device on the mock bus */
+typedef struct atca_mock_device_s
+{
+    bool              present;
+    uint8_t           address;                  /**< 8 bit I2C address */
+    atca_mock_state_t state;
+    uint64_t          wake_time;                /**< usec timestamp the device last woke */
+    uint64_t          busy_until;               /**< usec timestamp the current command completes */
+    uint32_t          watchdog_usec;            /**< Watchdog period - 0 disables it */
+    uint32_t          exec_usec[256];           /**< Simulated execution time by opcode */
+    uint8_t           fail_opcode;              /**< Opcode of a command to fail */
+    uint32_t          fail_countdown;           /**< Commands with fail_opcode until the failure - 0 for none */
+    atca_mock_command_hook_t command_hook;     /**< Observes every command received - NULL for none */
+    void*             command_hook_arg;
+
+    uint8_t           response[ATCA_RSP_SIZE_MAX];
+    uint8_t           response_len;
+    uint8_t           response_offset;
+
+    uint8_t           config[ATCA_ECC_CONFIG_SIZE];
+    uint8_t           otp[ATCA_OTP_SIZE];
+    uint8_t           data[16][ATCA_MOCK_SLOT_SIZE];
+    uint32_t          counter[2];
+    uint32_t          random_state;
+
+    uint8_t           tempkey[ATCA_SHA256_DIGEST_SIZE];
+    bool              tempkey_valid;
+    uint8_t           msgdigbuf[ATCA_SHA256_DIGEST_SIZE * 2];
+    bool              msgdigbuf_valid;
+    atcac_sha2_256_ctx sha_ctx;
+
+    atca_mock_stats_t stats;
+} atca_mock_device_t;
+
+/** \brief A simulated I2C bus - passed to the mock hal through ATCAIfaceCfg.cfg_data */
+typedef struct
+{
+    atca_mock_device_t devices[ATCA_MOCK_MAX_DEVICES];
+    uint32_t           general_calls;
+    void*              mutex;
+} atca_mock_bus_t;
+
+uint64_t atca_mock_time_usec(void);
+
+ATCA_STATUS atca_mock_bus_init(atca_mock_bus_t* bus);
+void atca_mock_bus_release(atca_mock_bus_t* bus);
+atca_mock_device_t* atca_mock_bus_add_device(atca_mock_bus_t* bus, uint8_t address);
+void atca_mock_set_exec_time(atca_mock_device_t* device, uint8_t opcode, uint32_t usec);
+void atca_mock_reset_stats(atca_mock_device_t* device);
+void atca_mock_fail_command(atca_mock_device_t* device, uint8_t opcode, uint32_t nth);
+void atca_mock_set_command_hook(atca_mock_device_t* device, atca_mock_command_hook_t hook, void* arg);
+ATCA_STATUS atca_mock_bus_write(atca_mock_bus_t* bus, uint8_t address, const uint8_t* txdata, int txlength);
+ATCA_STATUS atca_mock_bus_read(atca_mock_bus_t* bus, uint8_t address, uint8_t* rxdata, uint16_t* rxlength);
+
+void atca_mock_cfg_init(ATCAIfaceCfg* cfg, atca_mock_bus_t* bus, ATCADeviceType devtype, uint8_t address);
+ATCA_STATUS atca_mock_hal_register(void);
+ATCA_STATUS atca_mock_hal_unregister(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATCA_TEST_MOCK_HAL_H_ */
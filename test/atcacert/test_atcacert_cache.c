@@ -0,0 +1,289 @@
+/**
+ * \file
+ * \brief Tests for the certificate cache run against the simulated device
+ *        hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_CERT_CACHE) && !defined(DO_NOT_TEST_CERT)
+
+#include "atcacert/atcacert_cache.h"
+#include "atcacert/atcacert_client.h"
+#include "test_cert_def_0_device.h"
+#include "test_cert_def_1_signer.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define CERT_CACHE_READS            (10)
+
+static atca_mock_bus_t g_cert_cache_bus;
+static atca_mock_device_t* g_cert_cache_mock;
+static ATCAIfaceCfg g_cert_cache_cfg;
+static uint8_t g_cert_cache_ca_key[ATCA_ECCP256_PUBKEY_SIZE];
+
+/** \brief Device commands needed by one atcacert_read_cert */
+static uint32_t cert_cache_read(const atcacert_def_t* cert_def, uint8_t* cert, size_t* cert_size)
+{
+    size_t max_size = *cert_size;
+
+    atca_mock_reset_stats(g_cert_cache_mock);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_read_cert(cert_def, g_cert_cache_ca_key, cert, cert_size));
+    TEST_ASSERT_TRUE(*cert_size <= max_size);
+
+    return g_cert_cache_mock->stats.commands;
+}
+
+/** \brief Store a compressed certificate the cert_def can decode */
+static void cert_cache_write_comp_cert(const atcacert_def_t* cert_def)
+{
+    const atcacert_device_loc_t* loc = &cert_def->comp_cert_dev_loc;
+    const atcacert_tm_utc_t issue_date = { 0, 0, 12, 18, 9, 120 };
+    uint8_t comp_cert[ATCACERT_CACHE_COMP_CERT_SIZE];
+
+    memset(comp_cert, 0, sizeof(comp_cert));
+    memset(comp_cert, 0x5C, ATCA_ECCP256_SIG_SIZE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_date_enc_compcert(&issue_date, 10, &comp_cert[64]));
+    comp_cert[67] = 0x4A;
+    comp_cert[68] = 0x7D;
+    comp_cert[69] = (uint8_t)((cert_def->template_id << 4) | (cert_def->chain_id & 0x0F));
+    comp_cert[70] = (uint8_t)(cert_def->sn_source << 4);
+
+    TEST_ASSERT_SUCCESS(atcab_write_bytes_zone(ATCA_ZONE_DATA, loc->slot, loc->offset, comp_cert, loc->count));
+}
+
+/** \brief Change one byte of the compressed certificate stored on the device */
+static void cert_cache_touch_comp_cert(const atcacert_def_t* cert_def)
+{
+    const atcacert_device_loc_t* loc = &cert_def->comp_cert_dev_loc;
+    uint8_t block[ATCA_BLOCK_SIZE];
+
+    TEST_ASSERT_SUCCESS(atcab_read_zone(ATCA_ZONE_DATA, loc->slot, 0, 0, block, sizeof(block)));
+    block[5] ^= 0x01;
+    TEST_ASSERT_SUCCESS(atcab_write_zone(ATCA_ZONE_DATA, loc->slot, 0, 0, block, sizeof(block)));
+}
+
+TEST_GROUP(atcacert_cache);
+
+TEST_SETUP(atcacert_cache)
+{
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_cert_cache_bus));
+    TEST_ASSERT_NOT_NULL(g_cert_cache_mock = atca_mock_bus_add_device(&g_cert_cache_bus, 0xC0));
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+
+    atca_mock_cfg_init(&g_cert_cache_cfg, &g_cert_cache_bus, ATECC608, 0xC0);
+    TEST_ASSERT_SUCCESS(atcab_init(&g_cert_cache_cfg));
+
+    cert_cache_write_comp_cert(&g_test_cert_def_0_device);
+    cert_cache_write_comp_cert(&g_test_cert_def_1_signer);
+    atca_mock_reset_stats(g_cert_cache_mock);
+
+    memset(g_cert_cache_ca_key, 0x42, sizeof(g_cert_cache_ca_key));
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_cache_init());
+    atcacert_cache_clear();
+    atcacert_cache_reset_stats();
+}
+
+TEST_TEAR_DOWN(atcacert_cache)
+{
+    atcacert_cache_clear();
+    atcacert_cache_release();
+    (void)atcab_release();
+    (void)atca_mock_hal_unregister();
+    atca_mock_bus_release(&g_cert_cache_bus);
+}
+
+TEST(atcacert_cache, device_reads)
+{
+    const atcacert_def_t* cert_defs[] = { &g_test_cert_def_1_signer, &g_test_cert_def_0_device };
+    uint8_t first[ATCACERT_CACHE_CERT_MAX_SIZE];
+    uint8_t cert[ATCACERT_CACHE_CERT_MAX_SIZE];
+    atcacert_cache_stats_t stats;
+    size_t i;
+    int j;
+
+    for (i = 0; i < sizeof(cert_defs) / sizeof(cert_defs[0]); i++)
+    {
+        size_t first_size = sizeof(first);
+        uint32_t rebuild_cmds;
+        uint32_t cached_cmds = 0;
+
+        rebuild_cmds = cert_cache_read(cert_defs[i], first, &first_size);
+
+        for (j = 0; j < CERT_CACHE_READS; j++)
+        {
+            size_t cert_size = sizeof(cert);
+
+            cached_cmds += cert_cache_read(cert_defs[i], cert, &cert_size);
+            TEST_ASSERT_EQUAL(first_size, cert_size);
+            TEST_ASSERT_EQUAL_MEMORY(first, cert, cert_size);
+        }
+
+        /* Validating a cached certificate only reads the serial number and
+           the compressed certificate */
+        TEST_ASSERT_TRUE(cached_cmds / CERT_CACHE_READS < rebuild_cmds);
+        TEST_ASSERT_EQUAL(0, g_cert_cache_mock->stats.opcode_count[ATCA_GENKEY]);
+    }
+
+    atcacert_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2 * CERT_CACHE_READS, stats.hits);
+    TEST_ASSERT_EQUAL(2, stats.misses);
+}
+
+TEST(atcacert_cache, invalidation)
+{
+    uint8_t cert[ATCACERT_CACHE_CERT_MAX_SIZE];
+    uint8_t other[ATCACERT_CACHE_CERT_MAX_SIZE];
+    size_t cert_size = sizeof(cert);
+    size_t other_size = sizeof(other);
+    atcacert_cache_stats_t stats;
+
+    (void)cert_cache_read(&g_test_cert_def_0_device, cert, &cert_size);
+    (void)cert_cache_read(&g_test_cert_def_0_device, cert, &cert_size);
+
+    /* A rewritten compressed certificate is a different certificate */
+    cert_cache_touch_comp_cert(&g_test_cert_def_0_device);
+    (void)cert_cache_read(&g_test_cert_def_0_device, other, &other_size);
+    TEST_ASSERT_TRUE(other_size != cert_size || memcmp(cert, other, cert_size));
+
+    /* So is one built with a different CA key */
+    g_cert_cache_ca_key[0] ^= 0xFF;
+    other_size = sizeof(other);
+    (void)cert_cache_read(&g_test_cert_def_0_device, other, &other_size);
+
+    atcacert_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+    TEST_ASSERT_EQUAL(3, stats.misses);
+
+    /* Too small a buffer is reported as for a rebuilt certificate */
+    other_size -= 1;
+    TEST_ASSERT_EQUAL(ATCACERT_E_BUFFER_TOO_SMALL, atcacert_read_cert(&g_test_cert_def_0_device, g_cert_cache_ca_key, other, &other_size));
+}
+
+TEST(atcacert_cache, key_fields)
+{
+    atcacert_cert_element_t elements[2][1];
+    atcacert_def_t cert_def[2];
+    atcacert_cache_key_t key[2];
+    ATCADevice device = atcab_get_device();
+
+    /* Bytes that are not part of any field don't change the key */
+    memset(elements, 0x00, sizeof(elements[0]));
+    memset(elements[1], 0xA5, sizeof(elements[1]));
+    strcpy(elements[0][0].id, "SN03");
+    strcpy(elements[1][0].id, "SN03");
+    elements[0][0].device_loc = elements[1][0].device_loc = g_test_cert_def_0_device.comp_cert_dev_loc;
+    elements[0][0].cert_loc.offset = elements[1][0].cert_loc.offset = 15;
+    elements[0][0].cert_loc.count = elements[1][0].cert_loc.count = 16;
+    elements[0][0].transforms[0] = elements[1][0].transforms[0] = TF_BIN2HEX_UC;
+    elements[0][0].transforms[1] = elements[1][0].transforms[1] = TF_NONE;
+
+    memcpy(&cert_def[0], &g_test_cert_def_0_device, sizeof(cert_def[0]));
+    cert_def[0].cert_elements = elements[0];
+    cert_def[0].cert_elements_count = 1;
+    memcpy(&cert_def[1], &cert_def[0], sizeof(cert_def[1]));
+    cert_def[1].cert_elements = elements[1];
+
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_cache_get_key(device, &cert_def[0], g_cert_cache_ca_key, &key[0]));
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_cache_get_key(device, &cert_def[1], g_cert_cache_ca_key, &key[1]));
+    TEST_ASSERT_EQUAL_MEMORY(key[0].def_id, key[1].def_id, sizeof(key[0].def_id));
+
+    /* while every field does */
+    elements[1][0].cert_loc.count = 17;
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_cache_get_key(device, &cert_def[1], g_cert_cache_ca_key, &key[1]));
+    TEST_ASSERT_TRUE(memcmp(key[0].def_id, key[1].def_id, sizeof(key[0].def_id)));
+
+    elements[1][0].cert_loc.count = 16;
+    cert_def[1].expire_years = (uint8_t)(cert_def[0].expire_years + 1);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_cache_get_key(device, &cert_def[1], g_cert_cache_ca_key, &key[1]));
+    TEST_ASSERT_TRUE(memcmp(key[0].def_id, key[1].def_id, sizeof(key[0].def_id)));
+}
+
+TEST(atcacert_cache, persistence)
+{
+    const char* filename = "atcacert_cache_test.bin";
+    uint8_t cert[ATCACERT_CACHE_CERT_MAX_SIZE];
+    size_t cert_size = sizeof(cert);
+    atcacert_cache_stats_t stats;
+
+    (void)cert_cache_read(&g_test_cert_def_1_signer, cert, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_cache_save(filename));
+
+    /* A restarted process starts from the saved certificates */
+    atcacert_cache_clear();
+    atcacert_cache_reset_stats();
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_cache_load(filename));
+    cert_size = sizeof(cert);
+    (void)cert_cache_read(&g_test_cert_def_1_signer, cert, &cert_size);
+
+    atcacert_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+    TEST_ASSERT_EQUAL(0, stats.misses);
+
+    (void)remove(filename);
+    TEST_ASSERT_EQUAL(ATCACERT_E_ERROR, atcacert_cache_load(filename));
+}
+
+TEST(atcacert_cache, unused_without_lock)
+{
+    uint8_t first[ATCACERT_CACHE_CERT_MAX_SIZE];
+    uint8_t cert[ATCACERT_CACHE_CERT_MAX_SIZE];
+    size_t first_size = sizeof(first);
+    size_t cert_size = sizeof(cert);
+    atcacert_cache_stats_t stats;
+    uint32_t rebuild_cmds;
+
+    /* Holds are counted - the cache stays in use until the last release */
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_cache_init());
+    atcacert_cache_release();
+    TEST_ASSERT_TRUE(atcacert_cache_enabled());
+
+    /* Without the lock every read rebuilds the certificate */
+    atcacert_cache_release();
+    TEST_ASSERT_FALSE(atcacert_cache_enabled());
+    rebuild_cmds = cert_cache_read(&g_test_cert_def_0_device, first, &first_size);
+    TEST_ASSERT_EQUAL(rebuild_cmds, cert_cache_read(&g_test_cert_def_0_device, cert, &cert_size));
+    TEST_ASSERT_EQUAL(first_size, cert_size);
+    TEST_ASSERT_EQUAL_MEMORY(first, cert, cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_ERROR, atcacert_cache_save("atcacert_cache_unused.bin"));
+
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_cache_init());
+    atcacert_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.hits + stats.misses);
+}
+
+TEST_GROUP_RUNNER(atcacert_cache)
+{
+    RUN_TEST_CASE(atcacert_cache, device_reads);
+    RUN_TEST_CASE(atcacert_cache, invalidation);
+    RUN_TEST_CASE(atcacert_cache, key_fields);
+    RUN_TEST_CASE(atcacert_cache, persistence);
+    RUN_TEST_CASE(atcacert_cache, unused_without_lock);
+}
+
+#endif
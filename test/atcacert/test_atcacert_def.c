@@ -3315,6 +3315,45 @@ TEST(atcacert_get_tbs_digest, good)
     TEST_ASSERT_EQUAL_MEMORY(tbs_digest_ref, tbs_digest, sizeof(tbs_digest_ref));
 }
 
+TEST(atcacert_get_tbs_digest, batch)
+{
+    int ret = 0;
+    const atcacert_def_t* cert_defs[ATCACERT_TBS_DIGEST_BATCH + 3];
+    const uint8_t* certs[ATCACERT_TBS_DIGEST_BATCH + 3];
+    size_t cert_sizes[ATCACERT_TBS_DIGEST_BATCH + 3];
+    uint8_t tbs_digests[ATCACERT_TBS_DIGEST_BATCH + 3][32];
+    uint8_t tbs_digest[32];
+    size_t i;
+
+    // More certificates than are hashed together, alternating the definition
+    for (i = 0; i < sizeof(certs) / sizeof(certs[0]); i++)
+    {
+        cert_defs[i] = (i & 1) ? &g_test_cert_def_0_device : &g_test_cert_def_1_signer;
+        certs[i] = cert_defs[i]->cert_template;
+        cert_sizes[i] = cert_defs[i]->cert_template_size;
+    }
+
+    ret = atcacert_get_tbs_digests(cert_defs, certs, cert_sizes, sizeof(certs) / sizeof(certs[0]), &tbs_digests[0][0]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    for (i = 0; i < sizeof(certs) / sizeof(certs[0]); i++)
+    {
+        ret = atcacert_get_tbs_digest(cert_defs[i], certs[i], cert_sizes[i], tbs_digest);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_MEMORY(tbs_digest, tbs_digests[i], sizeof(tbs_digest));
+    }
+
+    ret = atcacert_get_tbs_digests(cert_defs, certs, cert_sizes, 0, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    cert_sizes[1] = 10;
+    ret = atcacert_get_tbs_digests(cert_defs, certs, cert_sizes, 2, &tbs_digests[0][0]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_CERT, ret);
+
+    ret = atcacert_get_tbs_digests(NULL, certs, cert_sizes, 1, &tbs_digests[0][0]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+}
+
 TEST(atcacert_get_tbs_digest, bad_params)
 {
     int ret = 0;
@@ -0,0 +1,244 @@
+/**
+ * \file
+ * \brief Tests for reading certificates from several simulated devices at
+ *        once with atcacert_read_cert_ext
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && !defined(DO_NOT_TEST_CERT) && !defined(_WIN32)
+
+#include <pthread.h>
+#include "atcacert/atcacert_cache.h"
+#include "atcacert/atcacert_client.h"
+#include "test_cert_def_0_device.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define READ_EXT_TEST_DEVICES       (4)
+#define READ_EXT_TEST_READS         (5)
+#define READ_EXT_TEST_CERT_SIZE     (1024)
+
+typedef struct
+{
+    ATCADevice device;
+    uint8_t    cert[READ_EXT_TEST_CERT_SIZE];
+    size_t     cert_size;
+    int        matches;
+    int        ret;
+} read_ext_reader_t;
+
+static atca_mock_bus_t g_read_ext_bus[READ_EXT_TEST_DEVICES];
+static atca_mock_device_t* g_read_ext_mock[READ_EXT_TEST_DEVICES];
+static ATCAIfaceCfg g_read_ext_cfg[READ_EXT_TEST_DEVICES];
+static ATCADevice g_read_ext_device[READ_EXT_TEST_DEVICES];
+
+/** \brief Store a compressed certificate the cert_def can decode */
+static void read_ext_write_comp_cert(ATCADevice device, const atcacert_def_t* cert_def)
+{
+    const atcacert_device_loc_t* loc = &cert_def->comp_cert_dev_loc;
+    const atcacert_tm_utc_t issue_date = { 0, 0, 12, 18, 9, 120 };
+    uint8_t comp_cert[72];
+
+    memset(comp_cert, 0, sizeof(comp_cert));
+    memset(comp_cert, 0x5C, ATCA_ECCP256_SIG_SIZE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_date_enc_compcert(&issue_date, 10, &comp_cert[64]));
+    comp_cert[69] = (uint8_t)((cert_def->template_id << 4) | (cert_def->chain_id & 0x0F));
+    comp_cert[70] = (uint8_t)(cert_def->sn_source << 4);
+
+    TEST_ASSERT_SUCCESS(calib_write_bytes_zone(device, ATCA_ZONE_DATA, loc->slot, loc->offset, comp_cert, loc->count));
+}
+
+/** \brief Make the next read rebuild the certificate from the device */
+static void read_ext_clear_cache(void)
+{
+#ifdef ATCA_CERT_CACHE
+    atcacert_cache_clear();
+#endif
+}
+
+static void* read_ext_thread(void* arg)
+{
+    read_ext_reader_t* reader = (read_ext_reader_t*)arg;
+    uint8_t scratch[ATCACERT_READ_SCRATCH_SIZE];
+    uint8_t cert[READ_EXT_TEST_CERT_SIZE];
+    size_t cert_size;
+    int i;
+
+    reader->ret = ATCACERT_E_SUCCESS;
+    for (i = 0; i < READ_EXT_TEST_READS && ATCACERT_E_SUCCESS == reader->ret; i++)
+    {
+        cert_size = sizeof(cert);
+        reader->ret = atcacert_read_cert_ext(reader->device, &g_test_cert_def_0_device, NULL, cert, &cert_size,
+                                             scratch, sizeof(scratch));
+        if (ATCACERT_E_SUCCESS == reader->ret && cert_size == reader->cert_size && !memcmp(cert, reader->cert, cert_size))
+        {
+            reader->matches++;
+        }
+    }
+    return NULL;
+}
+
+TEST_GROUP(atcacert_read_ext);
+
+TEST_SETUP(atcacert_read_ext)
+{
+    int i;
+
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+    for (i = 0; i < READ_EXT_TEST_DEVICES; i++)
+    {
+        uint8_t address = (uint8_t)(0xC0 + 2 * i);
+
+        g_read_ext_device[i] = NULL;
+        TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_read_ext_bus[i]));
+        TEST_ASSERT_NOT_NULL(g_read_ext_mock[i] = atca_mock_bus_add_device(&g_read_ext_bus[i], address));
+        atca_mock_cfg_init(&g_read_ext_cfg[i], &g_read_ext_bus[i], ATECC608, address);
+        TEST_ASSERT_SUCCESS(atcab_init_ext(&g_read_ext_device[i], &g_read_ext_cfg[i]));
+        read_ext_write_comp_cert(g_read_ext_device[i], &g_test_cert_def_0_device);
+    }
+
+#ifdef ATCA_CERT_CACHE
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_cache_init());
+#endif
+    read_ext_clear_cache();
+}
+
+TEST_TEAR_DOWN(atcacert_read_ext)
+{
+    int i;
+
+    read_ext_clear_cache();
+#ifdef ATCA_CERT_CACHE
+    atcacert_cache_release();
+#endif
+    for (i = 0; i < READ_EXT_TEST_DEVICES; i++)
+    {
+        (void)atcab_release_ext(&g_read_ext_device[i]);
+        atca_mock_bus_release(&g_read_ext_bus[i]);
+    }
+    (void)atca_mock_hal_unregister();
+}
+
+TEST(atcacert_read_ext, concurrent_devices)
+{
+    read_ext_reader_t readers[READ_EXT_TEST_DEVICES];
+    pthread_t threads[READ_EXT_TEST_DEVICES];
+    uint8_t scratch[ATCACERT_READ_SCRATCH_SIZE];
+    int i;
+
+    /* Reference certificates read one device at a time */
+    memset(readers, 0, sizeof(readers));
+    for (i = 0; i < READ_EXT_TEST_DEVICES; i++)
+    {
+        readers[i].device = g_read_ext_device[i];
+        readers[i].cert_size = sizeof(readers[i].cert);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_read_cert_ext(readers[i].device, &g_test_cert_def_0_device, NULL,
+                                                                     readers[i].cert, &readers[i].cert_size,
+                                                                     scratch, sizeof(scratch)));
+    }
+
+    /* Each device has its own serial number so its own certificate */
+    TEST_ASSERT_TRUE(readers[0].cert_size != readers[1].cert_size || memcmp(readers[0].cert, readers[1].cert, readers[0].cert_size));
+
+    for (i = 0; i < READ_EXT_TEST_DEVICES; i++)
+    {
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, read_ext_thread, &readers[i]));
+    }
+    for (i = 0; i < READ_EXT_TEST_DEVICES; i++)
+    {
+        TEST_ASSERT_EQUAL(0, pthread_join(threads[i], NULL));
+    }
+
+    for (i = 0; i < READ_EXT_TEST_DEVICES; i++)
+    {
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, readers[i].ret);
+        TEST_ASSERT_EQUAL(READ_EXT_TEST_READS, readers[i].matches);
+    }
+}
+
+TEST(atcacert_read_ext, merged_locations)
+{
+    /* Three blocks of slot 8 where the last bridges the first two */
+    atcacert_cert_element_t elements[3];
+    atcacert_def_t cert_def;
+    uint8_t scratch[ATCACERT_READ_SCRATCH_SIZE];
+    uint8_t expected[READ_EXT_TEST_CERT_SIZE];
+    uint8_t cert[READ_EXT_TEST_CERT_SIZE];
+    size_t expected_size = sizeof(expected);
+    size_t cert_size = sizeof(cert);
+    uint32_t base_reads;
+    int i;
+
+    memset(elements, 0, sizeof(elements));
+    for (i = 0; i < 3; i++)
+    {
+        elements[i].device_loc.zone = DEVZONE_DATA;
+        elements[i].device_loc.slot = 8;
+        elements[i].device_loc.count = ATCA_BLOCK_SIZE;
+    }
+    elements[1].device_loc.offset = 2 * ATCA_BLOCK_SIZE;
+    elements[2].device_loc.offset = ATCA_BLOCK_SIZE;
+
+    memcpy(&cert_def, &g_test_cert_def_0_device, sizeof(cert_def));
+    cert_def.cert_elements = elements;
+    cert_def.cert_elements_count = 3;
+
+    atca_mock_reset_stats(g_read_ext_mock[0]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_read_cert_ext(g_read_ext_device[0], &g_test_cert_def_0_device, NULL,
+                                                                 expected, &expected_size, scratch, sizeof(scratch)));
+    base_reads = g_read_ext_mock[0]->stats.opcode_count[ATCA_READ];
+
+    /* Every block is read once and the elements leave the certificate alone */
+    atca_mock_reset_stats(g_read_ext_mock[0]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_read_cert_ext(g_read_ext_device[0], &cert_def, NULL,
+                                                                 cert, &cert_size, scratch, sizeof(scratch)));
+    TEST_ASSERT_EQUAL(base_reads + 3, g_read_ext_mock[0]->stats.opcode_count[ATCA_READ]);
+    TEST_ASSERT_EQUAL(expected_size, cert_size);
+    TEST_ASSERT_EQUAL_MEMORY(expected, cert, cert_size);
+
+    /* Merging stops at the size of the scratch buffer */
+    read_ext_clear_cache();
+    cert_size = sizeof(cert);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_read_cert_ext(g_read_ext_device[0], &cert_def, NULL,
+                                                                 cert, &cert_size, scratch, 3 * ATCA_BLOCK_SIZE));
+    read_ext_clear_cache();
+    cert_size = sizeof(cert);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BUFFER_TOO_SMALL, atcacert_read_cert_ext(g_read_ext_device[0], &cert_def, NULL,
+                                                                          cert, &cert_size, scratch, ATCA_BLOCK_SIZE));
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, atcacert_read_cert_ext(g_read_ext_device[0], &cert_def, NULL,
+                                                                    cert, &cert_size, NULL, 0));
+}
+
+TEST_GROUP_RUNNER(atcacert_read_ext)
+{
+    RUN_TEST_CASE(atcacert_read_ext, concurrent_devices);
+    RUN_TEST_CASE(atcacert_read_ext, merged_locations);
+}
+
+#endif
@@ -105,6 +105,7 @@ static t_menu_info mas_menu_info[] =
     { "crypto",   "Run Unit Tests for Software Crypto Functions",   atca_crypto_sw_tests                 },
 #endif
     { "pbkdf2",   "Run pbkdf2 tests",                               run_pbkdf2_tests                     },
+    { "mock",     "Run Unit Tests using the simulated device hal",  run_mock_tests                       },
 #if defined(ATCA_MBEDTLS)
     { "crypto_int", "Run crypto library integration tests",         run_crypto_integration_tests         },
 #endif
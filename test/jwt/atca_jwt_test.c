@@ -309,6 +309,50 @@ TEST(atca_jwt_crypto, verify_invalid)
                                                                    atca_jwt_test_vector_pubkey));
 }
 
+TEST(atca_jwt_crypto, verify_batch)
+{
+    char buf[3][512];
+    const char* bufs[3] = { buf[0], buf[1], buf[2] };
+    uint16_t buflens[3] = { sizeof(buf[0]), sizeof(buf[1]), sizeof(buf[2]) };
+    const uint8_t* pubkeys[3] = { atca_jwt_test_vector_pubkey, atca_jwt_test_vector_pubkey, atca_jwt_test_vector_pubkey };
+    ATCA_STATUS results[3];
+
+    snprintf(buf[0], sizeof(buf[0]), "%s%s%s",
+             atca_jwt_test_vector_header,
+             atca_jwt_test_vector_payload,
+             atca_jwt_test_vector_sig);
+    snprintf(buf[1], sizeof(buf[1]), "%s%s%s",
+             atca_jwt_test_vector_header,
+             atca_jwt_test_vector_payload,
+             atca_jwt_test_vector_invalid_sig);
+    snprintf(buf[2], sizeof(buf[2]), "%s", atca_jwt_test_vector_header);
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atca_jwt_verify_batch(bufs, buflens, pubkeys, 1, results));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, results[0]);
+
+    /* Every token gets its own result */
+    TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, atca_jwt_verify_batch(bufs, buflens, pubkeys, 3, results));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, results[0]);
+    TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, results[1]);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, results[2]);
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atca_jwt_verify_batch(NULL, buflens, pubkeys, 3, results));
+
+    /* A token needs no terminator and nothing past its length is read */
+    buflens[0] = (uint16_t)strlen(buf[0]);
+    memcpy(buf[2], buf[0], buflens[0]);
+    memset(&buf[2][buflens[0]], 'A', sizeof(buf[2]) - buflens[0]);
+    bufs[1] = buf[2];
+    buflens[1] = buflens[0];
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atca_jwt_verify_batch(bufs, buflens, pubkeys, 2, results));
+
+    /* and a length that ends before the signature leaves the token without one */
+    buflens[1] = (uint16_t)(strchr(buf[2], '.') - buf[2] + 1);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atca_jwt_verify_batch(bufs, buflens, pubkeys, 2, results));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, results[0]);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, results[1]);
+}
+
 TEST(atca_jwt_crypto, finalize)
 {
     atca_jwt_t jwt;
@@ -364,6 +408,7 @@ t_test_case_info jwt_unit_test_info[] =
 
     { REGISTER_TEST_CASE(atca_jwt_crypto, verify),                                    ATCA_JWT_TEST_DEVICES},
     { REGISTER_TEST_CASE(atca_jwt_crypto, verify_invalid),                            ATCA_JWT_TEST_DEVICES},
+    { REGISTER_TEST_CASE(atca_jwt_crypto, verify_batch),                              ATCA_JWT_TEST_DEVICES},
     { REGISTER_TEST_CASE(atca_jwt_crypto, finalize),                                  ATCA_JWT_TEST_DEVICES},
 
     { (fp_test_case)NULL,                 (uint8_t)0 },                               /* Array Termination element*/
@@ -0,0 +1,111 @@
+/**
+ * \file
+ * \brief Brings the PKCS11 library up on simulated devices for the PKCS11
+ *        tests
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_TEST_PKCS11)
+
+#include "pkcs11_init.h"
+#include "pkcs11_object.h"
+#include "pkcs11_os.h"
+#include "pkcs11_slot.h"
+#include "test_pkcs11.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+/** \brief Initialize the library with one slot per simulated device without
+ *         reading any configuration files. Every slot gets a private key
+ *         object for device slot 0.
+ */
+void test_pkcs11_setup(test_pkcs11_slot_t* slots, CK_ULONG count)
+{
+    pkcs11_lib_ctx_ptr lib_ctx = pkcs11_get_context();
+    CK_SLOT_ID i;
+
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+
+    lib_ctx->create_mutex = pkcs11_os_create_mutex;
+    lib_ctx->destroy_mutex = pkcs11_os_destroy_mutex;
+    lib_ctx->lock_mutex = pkcs11_os_lock_mutex;
+    lib_ctx->unlock_mutex = pkcs11_os_unlock_mutex;
+    TEST_ASSERT_EQUAL(CKR_OK, lib_ctx->create_mutex(&lib_ctx->mutex));
+    TEST_ASSERT_NOT_NULL(lib_ctx->slots = pkcs11_slot_initslots(count));
+    lib_ctx->slot_cnt = count;
+
+    for (i = 0; i < count; i++)
+    {
+        pkcs11_slot_ctx_ptr slot_ctx = pkcs11_slot_get_context(lib_ctx, i);
+        pkcs11_object_ptr key = NULL;
+
+        TEST_ASSERT_SUCCESS(atca_mock_bus_init(&slots[i].bus));
+        TEST_ASSERT_NOT_NULL(slots[i].mock = atca_mock_bus_add_device(&slots[i].bus, 0xC0));
+
+        TEST_ASSERT_NOT_NULL(slot_ctx);
+        atca_mock_cfg_init(&slot_ctx->interface_config, &slots[i].bus, ATECC608, 0xC0);
+        TEST_ASSERT_EQUAL(CKR_OK, pkcs11_slot_init(i));
+
+        slot_ctx->cfg_zone.KeyConfig[0] = ATCA_KEY_CONFIG_PRIVATE_MASK;
+        TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_alloc(&key));
+        pkcs11_config_init_private(key, "device", 6);
+        key->slot = 0;
+        key->config = &slot_ctx->cfg_zone;
+        key->slot_ctx = slot_ctx;
+        TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_get_handle(key, &slots[i].key));
+
+        atca_mock_reset_stats(slots[i].mock);
+    }
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_index_rebuild());
+
+    lib_ctx->initialized = TRUE;
+}
+
+void test_pkcs11_teardown(test_pkcs11_slot_t* slots, CK_ULONG count)
+{
+    pkcs11_lib_ctx_ptr lib_ctx = pkcs11_get_context();
+    CK_ULONG i;
+
+    /* Closes the sessions, frees the objects and releases the devices */
+    (void)C_Finalize(NULL);
+
+    (void)lib_ctx->destroy_mutex(lib_ctx->mutex);
+    pkcs11_os_free(lib_ctx->slots);
+    lib_ctx->slots = NULL;
+    lib_ctx->slot_cnt = 0;
+    lib_ctx->mutex = NULL;
+
+    (void)atca_mock_hal_unregister();
+    for (i = 0; i < count; i++)
+    {
+        atca_mock_bus_release(&slots[i].bus);
+    }
+}
+
+#endif
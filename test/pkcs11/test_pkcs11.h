@@ -0,0 +1,46 @@
+/**
+ * \file
+ * \brief Brings the PKCS11 library up on simulated devices for the PKCS11
+ *        tests
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#ifndef TEST_PKCS11_H_
+#define TEST_PKCS11_H_
+
+#include "atca_test_mock_hal.h"
+#include "cryptoki.h"
+
+/** \brief A PKCS11 slot backed by a simulated device on a bus of its own */
+typedef struct
+{
+    atca_mock_bus_t     bus;
+    atca_mock_device_t* mock;
+    CK_OBJECT_HANDLE    key;        /**< Private key in device slot 0 */
+} test_pkcs11_slot_t;
+
+void test_pkcs11_setup(test_pkcs11_slot_t* slots, CK_ULONG count);
+void test_pkcs11_teardown(test_pkcs11_slot_t* slots, CK_ULONG count);
+
+#endif /* TEST_PKCS11_H_ */
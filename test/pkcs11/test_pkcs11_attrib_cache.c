@@ -0,0 +1,245 @@
+/**
+ * \file
+ * \brief Tests for the PKCS11 object attribute cache run against the
+ *        simulated device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_TEST_PKCS11) && !defined(ATCA_NO_HEAP)
+
+#include "pkcs11_init.h"
+#include "pkcs11_key.h"
+#include "pkcs11_session.h"
+#include "pkcs11_slot.h"
+#include "test_pkcs11.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#if PKCS11_ATTRIB_CACHE_ENABLE
+
+#define P11_CACHE_LOOKUPS           (10)
+#define P11_CACHE_DATA_SLOT         (10)
+#define P11_CACHE_CERT_SLOT         (12)
+
+static test_pkcs11_slot_t g_p11_cache_slot;
+static atca_mock_device_t* g_p11_cache_mock;
+static CK_SESSION_HANDLE g_p11_cache_session;
+static CK_OBJECT_HANDLE g_p11_cache_pubkey;
+static CK_OBJECT_HANDLE g_p11_cache_datakey;
+
+/** \brief Add a public key object for a device slot to the object cache */
+static CK_OBJECT_HANDLE p11_cache_add_public(char* label, uint16_t slot)
+{
+    pkcs11_slot_ctx_ptr slot_ctx = pkcs11_slot_get_context(pkcs11_get_context(), 0);
+    pkcs11_object_ptr obj = NULL;
+    CK_OBJECT_HANDLE handle = 0;
+
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_alloc(&obj));
+    pkcs11_config_init_public(obj, label, strlen(label));
+    obj->slot = slot;
+    obj->config = &slot_ctx->cfg_zone;
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_index_rebuild());
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_get_handle(obj, &handle));
+    return handle;
+}
+
+static void p11_cache_get_ec_point(CK_OBJECT_HANDLE hObject, CK_BYTE_PTR point)
+{
+    CK_ATTRIBUTE attr = { CKA_EC_POINT, point, 3 + ATCA_ECCP256_PUBKEY_SIZE };
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_GetAttributeValue(g_p11_cache_session, hObject, &attr, 1));
+    TEST_ASSERT_EQUAL(3 + ATCA_ECCP256_PUBKEY_SIZE, attr.ulValueLen);
+}
+
+TEST_GROUP(pkcs11_attrib_cache);
+
+TEST_SETUP(pkcs11_attrib_cache)
+{
+    test_pkcs11_setup(&g_p11_cache_slot, 1);
+    g_p11_cache_mock = g_p11_cache_slot.mock;
+
+    /* Public key paired with the private key in slot 0 and one stored in a data slot */
+    g_p11_cache_pubkey = p11_cache_add_public("device_pub", 0);
+    g_p11_cache_datakey = p11_cache_add_public("stored_pub", P11_CACHE_DATA_SLOT);
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_OpenSession(0, CKF_SERIAL_SESSION, NULL, NULL, &g_p11_cache_session));
+    atca_mock_reset_stats(g_p11_cache_mock);
+    pkcs11_object_cache_reset_stats();
+}
+
+TEST_TEAR_DOWN(pkcs11_attrib_cache)
+{
+    (void)C_CloseSession(g_p11_cache_session);
+    test_pkcs11_teardown(&g_p11_cache_slot, 1);
+}
+
+TEST(pkcs11_attrib_cache, device_reads)
+{
+    CK_BYTE point[3 + ATCA_ECCP256_PUBKEY_SIZE];
+    CK_BYTE first[3 + ATCA_ECCP256_PUBKEY_SIZE];
+    pkcs11_object_ptr obj = NULL;
+    pkcs11_attrib_cache_stats stats;
+    uint32_t uncached_reads;
+    int i;
+
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_check(&obj, g_p11_cache_datakey));
+
+    /* Without the cache every lookup goes back to the device */
+    for (i = 0; i < P11_CACHE_LOOKUPS; i++)
+    {
+        pkcs11_object_cache_clear_attribs(obj);
+        p11_cache_get_ec_point(g_p11_cache_datakey, first);
+    }
+    uncached_reads = g_p11_cache_mock->stats.opcode_count[ATCA_READ];
+    TEST_ASSERT_TRUE(uncached_reads >= P11_CACHE_LOOKUPS);
+
+    /* With it only the first */
+    pkcs11_object_cache_clear_attribs(obj);
+    atca_mock_reset_stats(g_p11_cache_mock);
+    pkcs11_object_cache_reset_stats();
+    for (i = 0; i < P11_CACHE_LOOKUPS; i++)
+    {
+        p11_cache_get_ec_point(g_p11_cache_datakey, point);
+        TEST_ASSERT_EQUAL_MEMORY(first, point, sizeof(point));
+    }
+    TEST_ASSERT_EQUAL(uncached_reads / P11_CACHE_LOOKUPS, g_p11_cache_mock->stats.opcode_count[ATCA_READ]);
+
+    pkcs11_object_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(P11_CACHE_LOOKUPS - 1, stats.hits);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+}
+
+TEST(pkcs11_attrib_cache, find_objects)
+{
+    CK_BYTE point[3 + ATCA_ECCP256_PUBKEY_SIZE];
+    CK_OBJECT_CLASS key_class = CKO_PUBLIC_KEY;
+    CK_ATTRIBUTE search[] = {
+        { CKA_CLASS,    &key_class, sizeof(key_class) },
+        { CKA_EC_POINT, point,      sizeof(point)     }
+    };
+    CK_OBJECT_HANDLE found[2];
+    CK_ULONG count;
+    int i;
+
+    p11_cache_get_ec_point(g_p11_cache_pubkey, point);
+    TEST_ASSERT_EQUAL(1, g_p11_cache_mock->stats.opcode_count[ATCA_GENKEY]);
+
+    /* Comparing the key of each public key object needs a device read only
+       the first time the object is matched */
+    for (i = 0; i < P11_CACHE_LOOKUPS; i++)
+    {
+        TEST_ASSERT_EQUAL(CKR_OK, C_FindObjectsInit(g_p11_cache_session, search, 2));
+        TEST_ASSERT_EQUAL(CKR_OK, C_FindObjects(g_p11_cache_session, found, 2, &count));
+        TEST_ASSERT_EQUAL(CKR_OK, C_FindObjectsFinal(g_p11_cache_session));
+        TEST_ASSERT_EQUAL(1, count);
+        TEST_ASSERT_EQUAL(g_p11_cache_pubkey, found[0]);
+    }
+
+    TEST_ASSERT_EQUAL(1, g_p11_cache_mock->stats.opcode_count[ATCA_GENKEY]);
+    TEST_ASSERT_TRUE(g_p11_cache_mock->stats.opcode_count[ATCA_READ] <= 3);
+}
+
+TEST(pkcs11_attrib_cache, invalidate_on_write)
+{
+    CK_BYTE point[3 + ATCA_ECCP256_PUBKEY_SIZE];
+    CK_BYTE info[91];
+    CK_ATTRIBUTE key_info = { CKA_PUBLIC_KEY_INFO, info, sizeof(info) };
+    CK_ATTRIBUTE key_point = { CKA_EC_POINT, point, sizeof(point) };
+    pkcs11_object_ptr pub = NULL;
+    pkcs11_session_ctx_ptr session = NULL;
+    pkcs11_attrib_cache_stats stats;
+
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_check(&pub, g_p11_cache_pubkey));
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_session_check(&session, g_p11_cache_session));
+
+    p11_cache_get_ec_point(g_p11_cache_pubkey, point);
+    TEST_ASSERT_EQUAL(CKR_OK, C_GetAttributeValue(g_p11_cache_session, g_p11_cache_slot.key, &key_info, 1));
+    TEST_ASSERT_EQUAL(CKR_OK, C_GetAttributeValue(g_p11_cache_session, g_p11_cache_slot.key, &key_info, 1));
+    TEST_ASSERT_EQUAL(2, g_p11_cache_mock->stats.opcode_count[ATCA_GENKEY]);
+
+    /* Writing the public key drops the values cached for both halves of the pair */
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_key_write(session, pub, &key_point));
+    pkcs11_object_cache_reset_stats();
+
+    p11_cache_get_ec_point(g_p11_cache_pubkey, point);
+    TEST_ASSERT_EQUAL(CKR_OK, C_GetAttributeValue(g_p11_cache_session, g_p11_cache_slot.key, &key_info, 1));
+    TEST_ASSERT_EQUAL(4, g_p11_cache_mock->stats.opcode_count[ATCA_GENKEY]);
+
+    pkcs11_object_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.hits);
+    TEST_ASSERT_EQUAL(2, stats.misses);
+
+    /* The key in the data slot is not affected */
+    p11_cache_get_ec_point(g_p11_cache_datakey, point);
+    pkcs11_object_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(3, stats.misses);
+}
+
+TEST(pkcs11_attrib_cache, invalidate_certificates)
+{
+    pkcs11_slot_ctx_ptr slot_ctx = pkcs11_slot_get_context(pkcs11_get_context(), 0);
+    CK_BYTE point[3 + ATCA_ECCP256_PUBKEY_SIZE];
+    CK_ATTRIBUTE key_point = { CKA_EC_POINT, point, sizeof(point) };
+    CK_BYTE value[] = { 0x30, 0x03, 0x02, 0x01, 0x01 };
+    CK_VOID_PTR cached = NULL;
+    CK_ULONG cached_len = 0;
+    pkcs11_object_ptr cert = NULL;
+    pkcs11_object_ptr pub = NULL;
+    pkcs11_session_ctx_ptr session = NULL;
+
+    /* A certificate in a slot of its own that is built with the stored key */
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_alloc(&cert));
+    pkcs11_config_init_cert(cert, "device_cert", 11);
+    cert->slot = P11_CACHE_CERT_SLOT;
+    cert->config = &slot_ctx->cfg_zone;
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_index_rebuild());
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_cache_put_attrib(cert, CKA_VALUE, value, sizeof(value)));
+    TEST_ASSERT_TRUE(pkcs11_object_cache_get_attrib(cert, CKA_VALUE, &cached, &cached_len));
+
+    /* Writing a key in any other slot of the device drops it */
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_check(&pub, g_p11_cache_datakey));
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_session_check(&session, g_p11_cache_session));
+    p11_cache_get_ec_point(g_p11_cache_datakey, point);
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_key_write(session, pub, &key_point));
+    TEST_ASSERT_FALSE(pkcs11_object_cache_get_attrib(cert, CKA_VALUE, &cached, &cached_len));
+}
+
+#endif /* PKCS11_ATTRIB_CACHE_ENABLE */
+
+TEST_GROUP_RUNNER(pkcs11_attrib_cache)
+{
+#if PKCS11_ATTRIB_CACHE_ENABLE
+    RUN_TEST_CASE(pkcs11_attrib_cache, device_reads);
+    RUN_TEST_CASE(pkcs11_attrib_cache, find_objects);
+    RUN_TEST_CASE(pkcs11_attrib_cache, invalidate_on_write);
+    RUN_TEST_CASE(pkcs11_attrib_cache, invalidate_certificates);
+#endif
+}
+
+#endif
@@ -0,0 +1,179 @@
+/**
+ * \file
+ * \brief Tests for PKCS11 digests sharing the SHA engine of a slot's device
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_TEST_PKCS11)
+
+#include "test_pkcs11.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+/* The digests run on the second slot so a call on the global device shows up
+   on the wrong mock */
+#define P11_DIGEST_TEST_SLOTS       (2)
+#define P11_DIGEST_TEST_SLOT        (1)
+#define P11_DIGEST_TEST_SIZE        (300)
+
+static test_pkcs11_slot_t g_p11_digest_slot[P11_DIGEST_TEST_SLOTS];
+static CK_SESSION_HANDLE g_p11_digest_session[2];
+static uint8_t g_p11_digest_message[2][P11_DIGEST_TEST_SIZE];
+
+TEST_GROUP(pkcs11_digest);
+
+TEST_SETUP(pkcs11_digest)
+{
+    size_t i;
+
+    test_pkcs11_setup(g_p11_digest_slot, P11_DIGEST_TEST_SLOTS);
+
+    for (i = 0; i < 2; i++)
+    {
+        TEST_ASSERT_EQUAL(CKR_OK, C_OpenSession(P11_DIGEST_TEST_SLOT, CKF_SERIAL_SESSION, NULL, NULL, &g_p11_digest_session[i]));
+    }
+    for (i = 0; i < P11_DIGEST_TEST_SIZE; i++)
+    {
+        g_p11_digest_message[0][i] = (uint8_t)(i * 7 + 3);
+        g_p11_digest_message[1][i] = (uint8_t)(i * 13 + 1);
+    }
+}
+
+TEST_TEAR_DOWN(pkcs11_digest)
+{
+    size_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        (void)C_CloseSession(g_p11_digest_session[i]);
+    }
+    test_pkcs11_teardown(g_p11_digest_slot, P11_DIGEST_TEST_SLOTS);
+}
+
+TEST(pkcs11_digest, interleaved_sessions)
+{
+    CK_MECHANISM mech = { CKM_SHA256, NULL, 0 };
+    uint8_t expected[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    CK_ULONG digest_len;
+    size_t offset;
+    size_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        TEST_ASSERT_EQUAL(CKR_OK, C_DigestInit(g_p11_digest_session[i], &mech));
+    }
+
+    /* Parts that straddle the block size take the engine back and forth */
+    for (offset = 0; offset < P11_DIGEST_TEST_SIZE; offset += 100)
+    {
+        for (i = 0; i < 2; i++)
+        {
+            TEST_ASSERT_EQUAL(CKR_OK, C_DigestUpdate(g_p11_digest_session[i], &g_p11_digest_message[i][offset], 100));
+        }
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        digest_len = sizeof(digest);
+        TEST_ASSERT_EQUAL(CKR_OK, C_DigestFinal(g_p11_digest_session[i], digest, &digest_len));
+        TEST_ASSERT_SUCCESS(atcac_sw_sha2_256(g_p11_digest_message[i], P11_DIGEST_TEST_SIZE, expected));
+        TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(digest));
+    }
+
+#if PKCS11_HARDWARE_SHA256
+    /* Everything ran on the device of the slot the sessions are open on */
+    TEST_ASSERT_TRUE(g_p11_digest_slot[P11_DIGEST_TEST_SLOT].mock->stats.opcode_count[ATCA_SHA] > 0);
+    TEST_ASSERT_EQUAL(0, g_p11_digest_slot[0].mock->stats.opcode_count[ATCA_SHA]);
+#endif
+}
+
+#if PKCS11_HARDWARE_SHA256
+TEST(pkcs11_digest, hmac_holds_engine)
+{
+    CK_MECHANISM hmac = { CKM_SHA256_HMAC, NULL, 0 };
+    CK_MECHANISM mech = { CKM_SHA256, NULL, 0 };
+    uint8_t expected[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t mac[ATCA_SHA256_DIGEST_SIZE];
+    CK_ULONG len;
+
+    /* An HMAC can't be saved off the engine so a digest waits for it */
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_digest_session[0], &hmac, g_p11_digest_slot[P11_DIGEST_TEST_SLOT].key));
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignUpdate(g_p11_digest_session[0], g_p11_digest_message[0], 100));
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestInit(g_p11_digest_session[1], &mech));
+    TEST_ASSERT_EQUAL(CKR_OPERATION_ACTIVE, C_DigestUpdate(g_p11_digest_session[1], g_p11_digest_message[1], 100));
+
+    /* The digest is still running once the HMAC gives the engine back */
+    len = sizeof(mac);
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignFinal(g_p11_digest_session[0], mac, &len));
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestUpdate(g_p11_digest_session[1], g_p11_digest_message[1], 100));
+    len = sizeof(digest);
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestFinal(g_p11_digest_session[1], digest, &len));
+
+    TEST_ASSERT_SUCCESS(atcac_sw_sha2_256(g_p11_digest_message[1], 100, expected));
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(digest));
+}
+#endif
+
+TEST(pkcs11_digest, close_in_progress)
+{
+    CK_MECHANISM mech = { CKM_SHA256, NULL, 0 };
+    uint8_t expected[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    CK_ULONG digest_len = sizeof(digest);
+    CK_SESSION_HANDLE closed = g_p11_digest_session[0];
+
+    /* The first session has the engine when it goes away */
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestInit(closed, &mech));
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestUpdate(closed, g_p11_digest_message[0], 200));
+    TEST_ASSERT_EQUAL(CKR_OK, C_CloseSession(closed));
+    TEST_ASSERT_EQUAL(CKR_SESSION_HANDLE_INVALID, C_DigestUpdate(closed, g_p11_digest_message[0], 100));
+
+    /* The other session takes the engine without saving the closed digest */
+    TEST_ASSERT_EQUAL(CKR_OK, C_OpenSession(P11_DIGEST_TEST_SLOT, CKF_SERIAL_SESSION, NULL, NULL, &g_p11_digest_session[0]));
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestInit(g_p11_digest_session[1], &mech));
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestUpdate(g_p11_digest_session[1], g_p11_digest_message[1], 200));
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestFinal(g_p11_digest_session[1], digest, &digest_len));
+
+    TEST_ASSERT_SUCCESS(atcac_sw_sha2_256(g_p11_digest_message[1], 200, expected));
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(digest));
+}
+
+TEST_GROUP_RUNNER(pkcs11_digest)
+{
+    RUN_TEST_CASE(pkcs11_digest, interleaved_sessions);
+#if PKCS11_HARDWARE_SHA256
+    RUN_TEST_CASE(pkcs11_digest, hmac_holds_engine);
+#endif
+    RUN_TEST_CASE(pkcs11_digest, close_in_progress);
+}
+
+#endif
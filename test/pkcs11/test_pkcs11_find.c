@@ -0,0 +1,198 @@
+/**
+ * \file
+ * \brief Tests for the PKCS11 object index used by searches run against the
+ *        simulated device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_TEST_PKCS11)
+
+#include "pkcs11_init.h"
+#include "pkcs11_object.h"
+#include "pkcs11_slot.h"
+#include "test_pkcs11.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+/* The slot helper already adds one private key */
+#define P11_FIND_OBJECTS            (PKCS11_MAX_OBJECTS_ALLOWED - 1)
+
+static test_pkcs11_slot_t g_p11_find_slot;
+static CK_SESSION_HANDLE g_p11_find_session;
+static CK_OBJECT_HANDLE g_p11_find_handle[P11_FIND_OBJECTS];
+
+static void p11_find_label(char* label, size_t size, CK_ULONG i)
+{
+    (void)snprintf(label, size, "key%lu", (unsigned long)i);
+}
+
+/** \brief Run a search returning up to max handles a few at a time */
+static CK_ULONG p11_find(CK_ATTRIBUTE_PTR pTemplate, CK_ULONG ulCount, CK_OBJECT_HANDLE_PTR found, CK_ULONG max)
+{
+    CK_ULONG total = 0;
+    CK_ULONG count;
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_FindObjectsInit(g_p11_find_session, pTemplate, ulCount));
+    do
+    {
+        CK_ULONG chunk = (max - total < 3) ? max - total : 3;
+        TEST_ASSERT_EQUAL(CKR_OK, C_FindObjects(g_p11_find_session, &found[total], chunk, &count));
+        total += count;
+    }
+    while (count && total < max);
+    TEST_ASSERT_EQUAL(CKR_OK, C_FindObjectsFinal(g_p11_find_session));
+
+    return total;
+}
+
+TEST_GROUP(pkcs11_find);
+
+TEST_SETUP(pkcs11_find)
+{
+    pkcs11_slot_ctx_ptr slot_ctx;
+    char label[PKCS11_MAX_LABEL_SIZE];
+    CK_ULONG i;
+
+    test_pkcs11_setup(&g_p11_find_slot, 1);
+    slot_ctx = pkcs11_slot_get_context(pkcs11_get_context(), 0);
+
+    /* Alternate public key and certificate objects */
+    for (i = 0; i < P11_FIND_OBJECTS; i++)
+    {
+        pkcs11_object_ptr obj = NULL;
+
+        p11_find_label(label, sizeof(label), i);
+        TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_alloc(&obj));
+        if (i & 1)
+        {
+            pkcs11_config_init_cert(obj, label, strlen(label));
+        }
+        else
+        {
+            pkcs11_config_init_public(obj, label, strlen(label));
+        }
+        obj->slot = (uint16_t)(i % 16);
+        obj->config = &slot_ctx->cfg_zone;
+        TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_get_handle(obj, &g_p11_find_handle[i]));
+    }
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_index_rebuild());
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_OpenSession(0, CKF_SERIAL_SESSION, NULL, NULL, &g_p11_find_session));
+}
+
+TEST_TEAR_DOWN(pkcs11_find)
+{
+    (void)C_CloseSession(g_p11_find_session);
+    test_pkcs11_teardown(&g_p11_find_slot, 1);
+}
+
+TEST(pkcs11_find, by_label)
+{
+    char label[PKCS11_MAX_LABEL_SIZE];
+    CK_OBJECT_CLASS key_class = CKO_CERTIFICATE;
+    CK_ATTRIBUTE search[] = {
+        { CKA_LABEL, label,      0                 },
+        { CKA_CLASS, &key_class, sizeof(key_class) }
+    };
+    CK_OBJECT_HANDLE found[P11_FIND_OBJECTS];
+    CK_ULONG i;
+
+    for (i = 0; i < P11_FIND_OBJECTS; i++)
+    {
+        p11_find_label(label, sizeof(label), i);
+        search[0].ulValueLen = (CK_ULONG)strlen(label);
+
+        TEST_ASSERT_EQUAL(1, p11_find(search, 1, found, P11_FIND_OBJECTS));
+        TEST_ASSERT_EQUAL(g_p11_find_handle[i], found[0]);
+
+        /* The label only matches a certificate for odd objects */
+        TEST_ASSERT_EQUAL((i & 1) ? 1 : 0, p11_find(search, 2, found, P11_FIND_OBJECTS));
+    }
+
+    /* A prefix of an existing label is a different label */
+    search[0].ulValueLen = 3;
+    TEST_ASSERT_EQUAL(0, p11_find(search, 1, found, P11_FIND_OBJECTS));
+}
+
+TEST(pkcs11_find, by_class)
+{
+    CK_OBJECT_CLASS key_class = CKO_PUBLIC_KEY;
+    CK_ATTRIBUTE search = { CKA_CLASS, &key_class, sizeof(key_class) };
+    CK_OBJECT_HANDLE found[P11_FIND_OBJECTS + 1];
+    CK_ULONG count;
+    CK_ULONG i;
+
+    /* Returned in the order the objects were created */
+    count = p11_find(&search, 1, found, P11_FIND_OBJECTS);
+    TEST_ASSERT_EQUAL((P11_FIND_OBJECTS + 1) / 2, count);
+    for (i = 0; i < count; i++)
+    {
+        TEST_ASSERT_EQUAL(g_p11_find_handle[2 * i], found[i]);
+    }
+
+    /* Everything including the private key from the slot helper */
+    TEST_ASSERT_EQUAL(P11_FIND_OBJECTS + 1, p11_find(NULL, 0, found, P11_FIND_OBJECTS + 1));
+}
+
+TEST(pkcs11_find, add_remove)
+{
+    char label[PKCS11_MAX_LABEL_SIZE];
+    CK_ATTRIBUTE search = { CKA_LABEL, label, 0 };
+    CK_OBJECT_HANDLE found[P11_FIND_OBJECTS];
+    pkcs11_object_ptr obj = NULL;
+    CK_OBJECT_HANDLE handle;
+
+    p11_find_label(label, sizeof(label), 4);
+    search.ulValueLen = (CK_ULONG)strlen(label);
+    TEST_ASSERT_EQUAL(1, p11_find(&search, 1, found, P11_FIND_OBJECTS));
+
+    /* Removed objects drop out of the index */
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_check(&obj, g_p11_find_handle[4]));
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_free(obj));
+    TEST_ASSERT_EQUAL(0, p11_find(&search, 1, found, P11_FIND_OBJECTS));
+
+    /* and new ones once whoever labelled them has indexed them again */
+    memcpy(label, "renamed", 7);
+    search.ulValueLen = 7;
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_alloc(&obj));
+    pkcs11_config_init_public(obj, label, 7);
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_get_handle(obj, &handle));
+    TEST_ASSERT_EQUAL(CKR_OK, pkcs11_object_index_rebuild());
+    TEST_ASSERT_EQUAL(1, p11_find(&search, 1, found, P11_FIND_OBJECTS));
+    TEST_ASSERT_EQUAL(handle, found[0]);
+}
+
+TEST_GROUP_RUNNER(pkcs11_find)
+{
+    RUN_TEST_CASE(pkcs11_find, by_label);
+    RUN_TEST_CASE(pkcs11_find, by_class);
+    RUN_TEST_CASE(pkcs11_find, add_remove);
+}
+
+#endif
@@ -0,0 +1,314 @@
+/**
+ * \file
+ * \brief Tests for multi-part PKCS11 sign and verify run against the simulated
+ *        device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_TEST_PKCS11)
+
+#include "pkcs11_signature.h"
+#include "test_pkcs11.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define P11_TEST_MESSAGE_SIZE       (1000)
+
+static test_pkcs11_slot_t g_p11_slot;
+static atca_mock_device_t* g_p11_mock;
+static CK_SESSION_HANDLE g_p11_session;
+static CK_OBJECT_HANDLE g_p11_key;
+static uint8_t g_p11_message[P11_TEST_MESSAGE_SIZE];
+
+/** \brief Pass the message in uneven parts that straddle the SHA block size */
+static CK_RV p11_stream(CK_SESSION_HANDLE hSession, CK_RV (*update)(CK_SESSION_HANDLE, CK_BYTE_PTR, CK_ULONG))
+{
+    static const size_t parts[] = { 1, 63, 64, 65, 7, 300 };
+    size_t offset = 0;
+    size_t i = 0;
+    CK_RV rv = CKR_OK;
+
+    while (CKR_OK == rv && offset < sizeof(g_p11_message))
+    {
+        size_t len = parts[i++ % (sizeof(parts) / sizeof(parts[0]))];
+
+        if (len > sizeof(g_p11_message) - offset)
+        {
+            len = sizeof(g_p11_message) - offset;
+        }
+        rv = update(hSession, &g_p11_message[offset], (CK_ULONG)len);
+        offset += len;
+    }
+    return rv;
+}
+
+TEST_GROUP(pkcs11_signature);
+
+TEST_SETUP(pkcs11_signature)
+{
+    size_t i;
+
+    test_pkcs11_setup(&g_p11_slot, 1);
+    g_p11_mock = g_p11_slot.mock;
+    g_p11_key = g_p11_slot.key;
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_OpenSession(0, CKF_SERIAL_SESSION, NULL, NULL, &g_p11_session));
+
+    for (i = 0; i < sizeof(g_p11_message); i++)
+    {
+        g_p11_message[i] = (uint8_t)(i * 7 + 3);
+    }
+    atca_mock_reset_stats(g_p11_mock);
+}
+
+TEST_TEAR_DOWN(pkcs11_signature)
+{
+    (void)C_CloseSession(g_p11_session);
+    test_pkcs11_teardown(&g_p11_slot, 1);
+}
+
+TEST(pkcs11_signature, ecdsa_sha256_multipart)
+{
+    CK_MECHANISM mech_sha256 = { CKM_ECDSA_SHA256, NULL, 0 };
+    CK_MECHANISM mech_raw = { CKM_ECDSA, NULL, 0 };
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signature[ATCA_SIG_SIZE];
+    uint8_t expected[ATCA_SIG_SIZE];
+    CK_ULONG sig_len = 0;
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_session, &mech_sha256, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, p11_stream(g_p11_session, C_SignUpdate));
+
+    /* A length query leaves the operation running */
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignFinal(g_p11_session, NULL, &sig_len));
+    TEST_ASSERT_EQUAL(ATCA_SIG_SIZE, sig_len);
+    sig_len = ATCA_SIG_SIZE - 1;
+    TEST_ASSERT_EQUAL(CKR_BUFFER_TOO_SMALL, C_SignFinal(g_p11_session, signature, &sig_len));
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignFinal(g_p11_session, signature, &sig_len));
+    TEST_ASSERT_EQUAL(ATCA_SIG_SIZE, sig_len);
+
+    /* The message is hashed on the host and only the digest goes to the device */
+    TEST_ASSERT_EQUAL(0, g_p11_mock->stats.opcode_count[ATCA_SHA]);
+    TEST_ASSERT_EQUAL(1, g_p11_mock->stats.opcode_count[ATCA_SIGN]);
+
+    /* Same signature as raw ECDSA over the digest */
+    TEST_ASSERT_SUCCESS(atcac_sw_sha2_256(g_p11_message, sizeof(g_p11_message), digest));
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_session, &mech_raw, g_p11_key));
+    sig_len = sizeof(expected);
+    TEST_ASSERT_EQUAL(CKR_OK, C_Sign(g_p11_session, digest, sizeof(digest), expected, &sig_len));
+    TEST_ASSERT_EQUAL_MEMORY(expected, signature, ATCA_SIG_SIZE);
+
+    /* And as single-part CKM_ECDSA_SHA256 */
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_session, &mech_sha256, g_p11_key));
+    sig_len = sizeof(expected);
+    TEST_ASSERT_EQUAL(CKR_OK, C_Sign(g_p11_session, g_p11_message, sizeof(g_p11_message), expected, &sig_len));
+    TEST_ASSERT_EQUAL_MEMORY(expected, signature, ATCA_SIG_SIZE);
+
+    /* The operation ended with the signature */
+    TEST_ASSERT_EQUAL(CKR_OPERATION_NOT_INITIALIZED, C_SignUpdate(g_p11_session, g_p11_message, 1));
+}
+
+TEST(pkcs11_signature, ecdsa_sha256_verify)
+{
+    CK_MECHANISM mech = { CKM_ECDSA_SHA256, NULL, 0 };
+    uint8_t signature[ATCA_SIG_SIZE];
+    CK_ULONG sig_len = sizeof(signature);
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, C_Sign(g_p11_session, g_p11_message, sizeof(g_p11_message), signature, &sig_len));
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_VerifyInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, p11_stream(g_p11_session, C_VerifyUpdate));
+    TEST_ASSERT_EQUAL(CKR_OK, C_VerifyFinal(g_p11_session, signature, sizeof(signature)));
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_VerifyInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, C_Verify(g_p11_session, g_p11_message, sizeof(g_p11_message), signature, sizeof(signature)));
+
+    /* A changed message no longer matches */
+    g_p11_message[500] ^= 0x01;
+    TEST_ASSERT_EQUAL(CKR_OK, C_VerifyInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, p11_stream(g_p11_session, C_VerifyUpdate));
+    TEST_ASSERT_EQUAL(CKR_SIGNATURE_INVALID, C_VerifyFinal(g_p11_session, signature, sizeof(signature)));
+}
+
+TEST(pkcs11_signature, hmac_multipart)
+{
+    CK_MECHANISM mech = { CKM_SHA256_HMAC, NULL, 0 };
+    uint8_t mac[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t expected[ATCA_SHA256_DIGEST_SIZE];
+    CK_ULONG mac_len = sizeof(mac);
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, C_Sign(g_p11_session, g_p11_message, sizeof(g_p11_message), expected, &mac_len));
+    TEST_ASSERT_EQUAL(ATCA_SHA256_DIGEST_SIZE, mac_len);
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, p11_stream(g_p11_session, C_SignUpdate));
+    mac_len = 0;
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignFinal(g_p11_session, NULL, &mac_len));
+    TEST_ASSERT_EQUAL(ATCA_SHA256_DIGEST_SIZE, mac_len);
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignFinal(g_p11_session, mac, &mac_len));
+    TEST_ASSERT_EQUAL_MEMORY(expected, mac, sizeof(mac));
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_VerifyInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, p11_stream(g_p11_session, C_VerifyUpdate));
+    TEST_ASSERT_EQUAL(CKR_OK, C_VerifyFinal(g_p11_session, mac, sizeof(mac)));
+
+    mac[0] ^= 0x80;
+    TEST_ASSERT_EQUAL(CKR_OK, C_VerifyInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, p11_stream(g_p11_session, C_VerifyUpdate));
+    TEST_ASSERT_EQUAL(CKR_SIGNATURE_INVALID, C_VerifyFinal(g_p11_session, mac, sizeof(mac)));
+}
+
+TEST(pkcs11_signature, hmac_engine_owner)
+{
+    CK_MECHANISM mech = { CKM_SHA256_HMAC, NULL, 0 };
+    CK_SESSION_HANDLE other;
+    uint8_t mac[ATCA_SHA256_DIGEST_SIZE];
+    CK_ULONG mac_len = sizeof(mac);
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_OpenSession(0, CKF_SERIAL_SESSION, NULL, NULL, &other));
+
+    /* The first session holds the device SHA engine until its HMAC ends */
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignUpdate(g_p11_session, g_p11_message, 100));
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(other, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OPERATION_ACTIVE, C_SignUpdate(other, g_p11_message, 100));
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignFinal(g_p11_session, mac, &mac_len));
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(other, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignUpdate(other, g_p11_message, 100));
+
+    /* Closing the session gives the engine back */
+    TEST_ASSERT_EQUAL(CKR_OK, C_CloseSession(other));
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignUpdate(g_p11_session, g_p11_message, 100));
+    mac_len = sizeof(mac);
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignFinal(g_p11_session, mac, &mac_len));
+}
+
+TEST(pkcs11_signature, single_part_only)
+{
+    CK_MECHANISM mech = { CKM_ECDSA, NULL, 0 };
+    uint8_t signature[ATCA_SIG_SIZE];
+    CK_ULONG sig_len = sizeof(signature);
+
+    /* Raw ECDSA signs a digest so there is nothing to stream */
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_session, &mech, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_FUNCTION_NOT_SUPPORTED, C_SignUpdate(g_p11_session, g_p11_message, 32));
+    TEST_ASSERT_EQUAL(CKR_OPERATION_NOT_INITIALIZED, C_SignFinal(g_p11_session, signature, &sig_len));
+}
+
+TEST(pkcs11_signature, ecdsa_batch)
+{
+    CK_MECHANISM mech_batch = { CKM_ATCA_ECDSA_BATCH, NULL, 0 };
+    CK_MECHANISM mech_raw = { CKM_ECDSA, NULL, 0 };
+    uint8_t digests[3][ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signatures[3][ATCA_SIG_SIZE];
+    CK_ULONG sig_len = 0;
+    size_t i;
+
+    for (i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_SUCCESS(atcac_sw_sha2_256(g_p11_message, 100 * (i + 1), digests[i]));
+    }
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_SignInit(g_p11_session, &mech_batch, g_p11_key));
+
+    /* The data has to be whole digests and each gets a signature */
+    TEST_ASSERT_EQUAL(CKR_DATA_LEN_RANGE, C_Sign(g_p11_session, (CK_BYTE_PTR)digests, sizeof(digests) - 1, NULL, &sig_len));
+    TEST_ASSERT_EQUAL(CKR_OK, C_Sign(g_p11_session, (CK_BYTE_PTR)digests, sizeof(digests), NULL, &sig_len));
+    TEST_ASSERT_EQUAL(sizeof(signatures), sig_len);
+    sig_len = sizeof(signatures) - 1;
+    TEST_ASSERT_EQUAL(CKR_BUFFER_TOO_SMALL, C_Sign(g_p11_session, (CK_BYTE_PTR)digests, sizeof(digests), (CK_BYTE_PTR)signatures, &sig_len));
+    TEST_ASSERT_EQUAL(sizeof(signatures), sig_len);
+    TEST_ASSERT_EQUAL(CKR_OK, C_Sign(g_p11_session, (CK_BYTE_PTR)digests, sizeof(digests), (CK_BYTE_PTR)signatures, &sig_len));
+    TEST_ASSERT_EQUAL(sizeof(signatures), sig_len);
+
+    /* One wake for the whole batch */
+    TEST_ASSERT_EQUAL(3, g_p11_mock->stats.opcode_count[ATCA_SIGN]);
+    TEST_ASSERT_EQUAL(1, g_p11_mock->stats.wakes);
+
+    /* Signatures come back in the order of the digests */
+    for (i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQUAL(CKR_OK, C_VerifyInit(g_p11_session, &mech_raw, g_p11_key));
+        TEST_ASSERT_EQUAL(CKR_OK, C_Verify(g_p11_session, digests[i], sizeof(digests[i]), signatures[i], sizeof(signatures[i])));
+    }
+    TEST_ASSERT_EQUAL(CKR_OK, C_VerifyInit(g_p11_session, &mech_raw, g_p11_key));
+    TEST_ASSERT_EQUAL(CKR_SIGNATURE_INVALID, C_Verify(g_p11_session, digests[0], sizeof(digests[0]), signatures[1], sizeof(signatures[1])));
+}
+
+#if PKCS11_HARDWARE_SHA256
+TEST(pkcs11_signature, digest_offload)
+{
+    CK_MECHANISM mech = { CKM_SHA256, NULL, 0 };
+    uint8_t expected[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    CK_ULONG digest_len = sizeof(digest);
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestInit(g_p11_session, &mech));
+    TEST_ASSERT_EQUAL(CKR_OK, C_Digest(g_p11_session, g_p11_message, sizeof(g_p11_message), expected, &digest_len));
+    TEST_ASSERT_TRUE(g_p11_mock->stats.opcode_count[ATCA_SHA] > 0);
+
+    /* The device policy moves a single part digest to the host */
+    TEST_ASSERT_SUCCESS(atcab_sha_set_offload(ATCA_SHA_OFFLOAD_HOST, 0));
+    atca_mock_reset_stats(g_p11_mock);
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestInit(g_p11_session, &mech));
+    TEST_ASSERT_EQUAL(CKR_OK, C_Digest(g_p11_session, g_p11_message, sizeof(g_p11_message), digest, &digest_len));
+    TEST_ASSERT_EQUAL(0, g_p11_mock->stats.commands);
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(digest));
+
+    /* A multi-part digest stays on the device */
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestInit(g_p11_session, &mech));
+    TEST_ASSERT_EQUAL(CKR_OK, p11_stream(g_p11_session, C_DigestUpdate));
+    TEST_ASSERT_EQUAL(CKR_OK, C_DigestFinal(g_p11_session, digest, &digest_len));
+    TEST_ASSERT_TRUE(g_p11_mock->stats.opcode_count[ATCA_SHA] > 0);
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, sizeof(digest));
+
+    TEST_ASSERT_SUCCESS(atcab_sha_set_offload(ATCA_SHA_OFFLOAD_DEVICE, 0));
+}
+#endif
+
+TEST_GROUP_RUNNER(pkcs11_signature)
+{
+    RUN_TEST_CASE(pkcs11_signature, ecdsa_sha256_multipart);
+    RUN_TEST_CASE(pkcs11_signature, ecdsa_sha256_verify);
+    RUN_TEST_CASE(pkcs11_signature, hmac_multipart);
+    RUN_TEST_CASE(pkcs11_signature, hmac_engine_owner);
+    RUN_TEST_CASE(pkcs11_signature, single_part_only);
+    RUN_TEST_CASE(pkcs11_signature, ecdsa_batch);
+#if PKCS11_HARDWARE_SHA256
+    RUN_TEST_CASE(pkcs11_signature, digest_offload);
+#endif
+}
+
+#endif
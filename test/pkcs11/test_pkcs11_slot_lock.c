@@ -0,0 +1,329 @@
+/**
+ * \file
+ * \brief Tests for per slot locking in the PKCS11 layer run from several
+ *        threads against simulated devices
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_TEST_PKCS11) && !defined(_WIN32)
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include "test_pkcs11.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define P11_LOCK_TEST_SLOTS         (4)
+#define P11_LOCK_TEST_SIGNS         (4)
+#define P11_LOCK_TEST_TIMEOUT_SEC   (5)
+
+typedef struct
+{
+    CK_SESSION_HANDLE session;
+    CK_OBJECT_HANDLE  key;
+    int               count;
+    int               completed;
+    CK_RV             rv;
+} p11_lock_signer_t;
+
+/** \brief Sign commands wait here for each other or for the test to let them go */
+typedef struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    int             arrived;        /**< Sign commands that reached a device */
+    int             expected;       /**< Sign commands to hold until they are all in flight */
+    bool            released;       /**< The test lets held commands complete */
+    bool            timed_out;      /**< A held command gave up waiting */
+} p11_lock_gate_t;
+
+static test_pkcs11_slot_t g_p11_lock_slot[P11_LOCK_TEST_SLOTS];
+static CK_SESSION_HANDLE g_p11_lock_session[P11_LOCK_TEST_SLOTS];
+static p11_lock_gate_t g_p11_lock_gate;
+
+static void p11_lock_gate_hook(atca_mock_device_t* device, uint8_t opcode, void* arg)
+{
+    p11_lock_gate_t* gate = (p11_lock_gate_t*)arg;
+    struct timespec deadline;
+
+    ((void)device);
+
+    if (ATCA_SIGN != opcode)
+    {
+        return;
+    }
+
+    (void)clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += P11_LOCK_TEST_TIMEOUT_SEC;
+
+    (void)pthread_mutex_lock(&gate->mutex);
+    if (gate->expected)
+    {
+        gate->arrived++;
+        (void)pthread_cond_broadcast(&gate->cond);
+        while (!gate->released && gate->arrived < gate->expected && !gate->timed_out)
+        {
+            if (ETIMEDOUT == pthread_cond_timedwait(&gate->cond, &gate->mutex, &deadline))
+            {
+                gate->timed_out = true;
+            }
+        }
+    }
+    (void)pthread_mutex_unlock(&gate->mutex);
+}
+
+/** \brief Hold sign commands until count of them reach the devices or the test releases them */
+static void p11_lock_gate_arm(int count)
+{
+    CK_SLOT_ID i;
+
+    (void)pthread_mutex_lock(&g_p11_lock_gate.mutex);
+    g_p11_lock_gate.arrived = 0;
+    g_p11_lock_gate.expected = count;
+    g_p11_lock_gate.released = false;
+    g_p11_lock_gate.timed_out = false;
+    (void)pthread_mutex_unlock(&g_p11_lock_gate.mutex);
+
+    for (i = 0; i < P11_LOCK_TEST_SLOTS; i++)
+    {
+        atca_mock_set_command_hook(g_p11_lock_slot[i].mock, p11_lock_gate_hook, &g_p11_lock_gate);
+    }
+}
+
+/** \brief Wait for the first held sign command to reach a device */
+static bool p11_lock_gate_wait_arrival(void)
+{
+    struct timespec deadline;
+    bool arrived;
+
+    (void)clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += P11_LOCK_TEST_TIMEOUT_SEC;
+
+    (void)pthread_mutex_lock(&g_p11_lock_gate.mutex);
+    while (!g_p11_lock_gate.arrived)
+    {
+        if (ETIMEDOUT == pthread_cond_timedwait(&g_p11_lock_gate.cond, &g_p11_lock_gate.mutex, &deadline))
+        {
+            break;
+        }
+    }
+    arrived = (0 != g_p11_lock_gate.arrived);
+    (void)pthread_mutex_unlock(&g_p11_lock_gate.mutex);
+
+    return arrived;
+}
+
+/** \brief Let held sign commands complete and report whether any gave up first */
+static bool p11_lock_gate_release(void)
+{
+    bool timed_out;
+
+    (void)pthread_mutex_lock(&g_p11_lock_gate.mutex);
+    g_p11_lock_gate.released = true;
+    timed_out = g_p11_lock_gate.timed_out;
+    (void)pthread_cond_broadcast(&g_p11_lock_gate.cond);
+    (void)pthread_mutex_unlock(&g_p11_lock_gate.mutex);
+
+    return !timed_out;
+}
+
+static void* p11_lock_sign_thread(void* arg)
+{
+    p11_lock_signer_t* signer = (p11_lock_signer_t*)arg;
+    CK_MECHANISM mech = { CKM_ECDSA, NULL, 0 };
+    uint8_t digest[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signature[ATCA_SIG_SIZE];
+    CK_ULONG sig_len;
+    int i;
+
+    memset(digest, 0x5C, sizeof(digest));
+    signer->rv = CKR_OK;
+    for (i = 0; i < signer->count && CKR_OK == signer->rv; i++)
+    {
+        sig_len = sizeof(signature);
+        if (CKR_OK == (signer->rv = C_SignInit(signer->session, &mech, signer->key)))
+        {
+            signer->rv = C_Sign(signer->session, digest, sizeof(digest), signature, &sig_len);
+        }
+        if (CKR_OK == signer->rv)
+        {
+            signer->completed++;
+        }
+    }
+    return NULL;
+}
+
+/** \brief Sign from one thread per session */
+static void p11_lock_run_signers(p11_lock_signer_t* signers, size_t count)
+{
+    pthread_t threads[P11_LOCK_TEST_SLOTS];
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, p11_lock_sign_thread, &signers[i]));
+    }
+    for (i = 0; i < count; i++)
+    {
+        TEST_ASSERT_EQUAL(0, pthread_join(threads[i], NULL));
+    }
+}
+
+TEST_GROUP(pkcs11_slot_lock);
+
+TEST_SETUP(pkcs11_slot_lock)
+{
+    CK_SLOT_ID i;
+
+    test_pkcs11_setup(g_p11_lock_slot, P11_LOCK_TEST_SLOTS);
+
+    TEST_ASSERT_EQUAL(0, pthread_mutex_init(&g_p11_lock_gate.mutex, NULL));
+    TEST_ASSERT_EQUAL(0, pthread_cond_init(&g_p11_lock_gate.cond, NULL));
+    g_p11_lock_gate.expected = 0;
+
+    for (i = 0; i < P11_LOCK_TEST_SLOTS; i++)
+    {
+        TEST_ASSERT_EQUAL(CKR_OK, C_OpenSession(i, CKF_SERIAL_SESSION, NULL, NULL, &g_p11_lock_session[i]));
+    }
+}
+
+TEST_TEAR_DOWN(pkcs11_slot_lock)
+{
+    CK_SLOT_ID i;
+
+    for (i = 0; i < P11_LOCK_TEST_SLOTS; i++)
+    {
+        (void)C_CloseSession(g_p11_lock_session[i]);
+    }
+    test_pkcs11_teardown(g_p11_lock_slot, P11_LOCK_TEST_SLOTS);
+
+    (void)pthread_cond_destroy(&g_p11_lock_gate.cond);
+    (void)pthread_mutex_destroy(&g_p11_lock_gate.mutex);
+}
+
+TEST(pkcs11_slot_lock, independent_slots_scale)
+{
+    p11_lock_signer_t signers[P11_LOCK_TEST_SLOTS];
+    size_t i;
+
+    memset(signers, 0, sizeof(signers));
+    for (i = 0; i < P11_LOCK_TEST_SLOTS; i++)
+    {
+        signers[i].session = g_p11_lock_session[i];
+        signers[i].key = g_p11_lock_slot[i].key;
+        signers[i].count = P11_LOCK_TEST_SIGNS;
+    }
+
+    /* Every first sign command waits on its device until the others reach
+       theirs - with one lock for the library only one could ever get there */
+    p11_lock_gate_arm(P11_LOCK_TEST_SLOTS);
+    p11_lock_run_signers(signers, P11_LOCK_TEST_SLOTS);
+    TEST_ASSERT_TRUE_MESSAGE(p11_lock_gate_release(), "Slots did not run in parallel");
+
+    for (i = 0; i < P11_LOCK_TEST_SLOTS; i++)
+    {
+        TEST_ASSERT_EQUAL(CKR_OK, signers[i].rv);
+        TEST_ASSERT_EQUAL(P11_LOCK_TEST_SIGNS, signers[i].completed);
+        TEST_ASSERT_EQUAL(P11_LOCK_TEST_SIGNS, g_p11_lock_slot[i].mock->stats.opcode_count[ATCA_SIGN]);
+    }
+}
+
+TEST(pkcs11_slot_lock, shared_slot_serialized)
+{
+    p11_lock_signer_t signers[2];
+    CK_SESSION_HANDLE other;
+    size_t i;
+
+    TEST_ASSERT_EQUAL(CKR_OK, C_OpenSession(1, CKF_SERIAL_SESSION, NULL, NULL, &other));
+
+    /* Two sessions on the same slot take turns on the device */
+    memset(signers, 0, sizeof(signers));
+    signers[0].session = g_p11_lock_session[1];
+    signers[1].session = other;
+    for (i = 0; i < 2; i++)
+    {
+        signers[i].key = g_p11_lock_slot[1].key;
+        signers[i].count = P11_LOCK_TEST_SIGNS;
+    }
+    p11_lock_run_signers(signers, 2);
+
+    for (i = 0; i < 2; i++)
+    {
+        TEST_ASSERT_EQUAL(CKR_OK, signers[i].rv);
+        TEST_ASSERT_EQUAL(P11_LOCK_TEST_SIGNS, signers[i].completed);
+    }
+    TEST_ASSERT_EQUAL(2 * P11_LOCK_TEST_SIGNS, g_p11_lock_slot[1].mock->stats.opcode_count[ATCA_SIGN]);
+    TEST_ASSERT_EQUAL(0, g_p11_lock_slot[0].mock->stats.opcode_count[ATCA_SIGN]);
+}
+
+TEST(pkcs11_slot_lock, attributes_during_sign)
+{
+    p11_lock_signer_t signer;
+    pthread_t thread;
+    CK_OBJECT_CLASS key_class = 0;
+    CK_BYTE label[16];
+    CK_ATTRIBUTE attrs[] = {
+        { CKA_CLASS, &key_class, sizeof(key_class) },
+        { CKA_LABEL, label,      sizeof(label)     },
+    };
+    CK_RV rv;
+
+    memset(&signer, 0, sizeof(signer));
+    signer.session = g_p11_lock_session[0];
+    signer.key = g_p11_lock_slot[0].key;
+    signer.count = 1;
+
+    /* Hold the sign command on the device until the test releases it */
+    p11_lock_gate_arm(P11_LOCK_TEST_SLOTS + 1);
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, p11_lock_sign_thread, &signer));
+    TEST_ASSERT_TRUE(p11_lock_gate_wait_arrival());
+
+    /* Reading attributes held in memory does not wait for the signature - if
+       it did the held command would give up before being released */
+    rv = C_GetAttributeValue(g_p11_lock_session[1], g_p11_lock_slot[0].key, attrs, 2);
+    TEST_ASSERT_TRUE_MESSAGE(p11_lock_gate_release(), "Attribute read waited for the device");
+
+    TEST_ASSERT_EQUAL(0, pthread_join(thread, NULL));
+    TEST_ASSERT_EQUAL(CKR_OK, signer.rv);
+
+    TEST_ASSERT_EQUAL(CKR_OK, rv);
+    TEST_ASSERT_EQUAL(CKO_PRIVATE_KEY, key_class);
+    TEST_ASSERT_EQUAL(6, attrs[1].ulValueLen);
+    TEST_ASSERT_EQUAL_MEMORY("device", label, 6);
+}
+
+TEST_GROUP_RUNNER(pkcs11_slot_lock)
+{
+    RUN_TEST_CASE(pkcs11_slot_lock, independent_slots_scale);
+    RUN_TEST_CASE(pkcs11_slot_lock, shared_slot_serialized);
+    RUN_TEST_CASE(pkcs11_slot_lock, attributes_during_sign);
+}
+
+#endif
@@ -0,0 +1,233 @@
+/**
+ * \file
+ * \brief Tests for reading the TNG certificate chain in one pass run against
+ *        the simulated device hal
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include "atca_test.h"
+#include "atca_test_mock_hal.h"
+
+#if ATCA_CA_SUPPORT && defined(ATCA_TNGTLS_SUPPORT) && !defined(DO_NOT_TEST_CERT)
+
+#include "app/tng/tng_atca.h"
+#include "app/tng/tng_atcacert_client.h"
+#include "app/tng/tngtls_cert_def_1_signer.h"
+#include "app/tng/tngtls_cert_def_3_device.h"
+#include "atcacert/atcacert_cache.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+#define TNG_CHAIN_CERT_SIZE         (1024)
+
+static atca_mock_bus_t g_chain_bus;
+static atca_mock_device_t* g_chain_mock;
+static ATCAIfaceCfg g_chain_cfg;
+
+/** \brief Store a compressed certificate the cert_def can decode */
+static void tng_chain_store_comp_cert(atca_mock_device_t* mock, const atcacert_def_t* cert_def, uint8_t fill)
+{
+    const atcacert_tm_utc_t issue_date = { 0, 0, 12, 18, 9, 120 };
+    uint8_t* comp_cert = &mock->data[cert_def->comp_cert_dev_loc.slot][cert_def->comp_cert_dev_loc.offset];
+
+    memset(comp_cert, 0, cert_def->comp_cert_dev_loc.count);
+    memset(comp_cert, fill, ATCA_ECCP256_SIG_SIZE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_date_enc_compcert(&issue_date, 0, &comp_cert[64]));
+    comp_cert[67] = 0x1A;
+    comp_cert[68] = 0x2B;
+    comp_cert[69] = (uint8_t)((cert_def->template_id << 4) | (cert_def->chain_id & 0x0F));
+    comp_cert[70] = (uint8_t)(cert_def->sn_source << 4);
+}
+
+/** \brief Provision a device as a TNG TLS part */
+static void tng_chain_provision(atca_mock_device_t* mock)
+{
+    const atcacert_device_loc_t* signer_key = &g_tngtls_cert_def_1_signer.public_key_dev_loc;
+    size_t i;
+
+    memcpy(mock->otp, "KQp2ZkD8", 8);
+    tng_chain_store_comp_cert(mock, &g_tngtls_cert_def_1_signer, 0x3D);
+    tng_chain_store_comp_cert(mock, &g_tngtls_cert_def_3_device, 0x6E);
+    for (i = 0; i < signer_key->count; i++)
+    {
+        /* Padded X and Y with 4 zero bytes in front of each */
+        mock->data[signer_key->slot][signer_key->offset + i] = (i % 36 < 4) ? 0 : (uint8_t)(i + 0x11);
+    }
+}
+
+/** \brief Device commands and wakes used by the sequential read */
+static void tng_chain_read_sequential(uint8_t* signer_cert, size_t* signer_cert_size, uint8_t* device_cert, size_t* device_cert_size)
+{
+#ifdef ATCA_CERT_CACHE
+    atcacert_cache_clear();
+#endif
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, tng_atcacert_read_signer_cert(signer_cert, signer_cert_size));
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, tng_atcacert_read_device_cert(device_cert, device_cert_size, NULL));
+}
+
+TEST_GROUP(tng_atcacert_chain);
+
+TEST_SETUP(tng_atcacert_chain)
+{
+    TEST_ASSERT_SUCCESS(atca_mock_bus_init(&g_chain_bus));
+    TEST_ASSERT_NOT_NULL(g_chain_mock = atca_mock_bus_add_device(&g_chain_bus, 0xC0));
+    TEST_ASSERT_SUCCESS(atca_mock_hal_register());
+
+    atca_mock_cfg_init(&g_chain_cfg, &g_chain_bus, ATECC608, 0xC0);
+    TEST_ASSERT_SUCCESS(atcab_init(&g_chain_cfg));
+
+    tng_chain_provision(g_chain_mock);
+
+    atca_mock_reset_stats(g_chain_mock);
+}
+
+TEST_TEAR_DOWN(tng_atcacert_chain)
+{
+#ifdef ATCA_CERT_CACHE
+    atcacert_cache_clear();
+#endif
+    (void)atcab_release();
+    (void)atca_mock_hal_unregister();
+    atca_mock_bus_release(&g_chain_bus);
+}
+
+TEST(tng_atcacert_chain, matches_sequential_reads)
+{
+    uint8_t root[TNG_CHAIN_CERT_SIZE];
+    uint8_t signer[TNG_CHAIN_CERT_SIZE];
+    uint8_t device[TNG_CHAIN_CERT_SIZE];
+    uint8_t expected_root[TNG_CHAIN_CERT_SIZE];
+    uint8_t expected_signer[TNG_CHAIN_CERT_SIZE];
+    uint8_t expected_device[TNG_CHAIN_CERT_SIZE];
+    size_t root_size = sizeof(root);
+    size_t signer_size = sizeof(signer);
+    size_t device_size = sizeof(device);
+    size_t expected_root_size = sizeof(expected_root);
+    size_t expected_signer_size = sizeof(expected_signer);
+    size_t expected_device_size = sizeof(expected_device);
+    uint32_t sequential_cmds;
+    uint32_t sequential_wakes;
+
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, tng_atcacert_root_cert(expected_root, &expected_root_size));
+    tng_chain_read_sequential(expected_signer, &expected_signer_size, expected_device, &expected_device_size);
+    sequential_cmds = g_chain_mock->stats.commands;
+    sequential_wakes = g_chain_mock->stats.wakes;
+
+    atca_mock_reset_stats(g_chain_mock);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, tng_atcacert_read_chain(root, &root_size, signer, &signer_size, device, &device_size));
+
+    TEST_ASSERT_EQUAL(expected_root_size, root_size);
+    TEST_ASSERT_EQUAL_MEMORY(expected_root, root, root_size);
+    TEST_ASSERT_EQUAL(expected_signer_size, signer_size);
+    TEST_ASSERT_EQUAL_MEMORY(expected_signer, signer, signer_size);
+    TEST_ASSERT_EQUAL(expected_device_size, device_size);
+    TEST_ASSERT_EQUAL_MEMORY(expected_device, device, device_size);
+
+    /* The OTP and signer public key are read once and the rest of the reads
+       share a single wake */
+    TEST_ASSERT_TRUE(g_chain_mock->stats.commands < sequential_cmds);
+    TEST_ASSERT_EQUAL(1, g_chain_mock->stats.opcode_count[ATCA_GENKEY]);
+    TEST_ASSERT_TRUE(g_chain_mock->stats.wakes < sequential_wakes);
+    TEST_ASSERT_EQUAL(1, g_chain_mock->stats.wakes);
+}
+
+TEST(tng_atcacert_chain, errors)
+{
+    uint8_t signer[TNG_CHAIN_CERT_SIZE];
+    uint8_t device[TNG_CHAIN_CERT_SIZE];
+    size_t signer_size = sizeof(signer);
+    size_t device_size = 16;
+
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, tng_atcacert_read_chain(NULL, NULL, NULL, &signer_size, device, &device_size));
+    TEST_ASSERT_NOT_EQUAL(ATCACERT_E_SUCCESS, tng_atcacert_read_chain(NULL, NULL, signer, &signer_size, device, &device_size));
+
+    /* A device that is not a TNG part */
+    signer_size = sizeof(signer);
+    memcpy(g_chain_mock->otp, "00000000", 8);
+    device_size = sizeof(device);
+    TEST_ASSERT_EQUAL(ATCACERT_E_WRONG_CERT_DEF, tng_atcacert_read_chain(NULL, NULL, signer, &signer_size, device, &device_size));
+}
+
+TEST(tng_atcacert_chain, other_device)
+{
+    uint8_t scratch[TNG_ATCACERT_CHAIN_SCRATCH_SIZE];
+    uint8_t signer[TNG_CHAIN_CERT_SIZE];
+    uint8_t device[TNG_CHAIN_CERT_SIZE];
+    uint8_t expected_signer[TNG_CHAIN_CERT_SIZE];
+    uint8_t expected_device[TNG_CHAIN_CERT_SIZE];
+    uint8_t expected_key[ATCA_ECCP256_PUBKEY_SIZE];
+    uint8_t key[ATCA_ECCP256_PUBKEY_SIZE];
+    size_t signer_size = sizeof(signer);
+    size_t device_size = sizeof(device);
+    size_t expected_signer_size = sizeof(expected_signer);
+    size_t expected_device_size = sizeof(expected_device);
+    atca_mock_device_t* other_mock;
+    ATCAIfaceCfg other_cfg;
+    ATCADevice other = NULL;
+
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, tng_atcacert_read_chain(NULL, NULL, expected_signer, &expected_signer_size,
+                                                                  expected_device, &expected_device_size));
+
+    TEST_ASSERT_NOT_NULL(other_mock = atca_mock_bus_add_device(&g_chain_bus, 0xC2));
+    tng_chain_provision(other_mock);
+    atca_mock_cfg_init(&other_cfg, &g_chain_bus, ATECC608, 0xC2);
+    TEST_ASSERT_SUCCESS(atcab_init_ext(&other, &other_cfg));
+
+    /* Everything comes from the device passed in, read into the caller's
+       scratch */
+    atca_mock_reset_stats(g_chain_mock);
+    atca_mock_reset_stats(other_mock);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, tng_atcacert_read_chain_ext(other, NULL, NULL, signer, &signer_size, device, &device_size,
+                                                                      scratch, sizeof(scratch)));
+    TEST_ASSERT_EQUAL(0, g_chain_mock->stats.commands);
+    TEST_ASSERT_TRUE(other_mock->stats.commands > 0);
+
+    /* The signer is provisioned the same and the device certificate
+       carries the other device's key */
+    TEST_ASSERT_EQUAL(expected_signer_size, signer_size);
+    TEST_ASSERT_EQUAL_MEMORY(expected_signer, signer, signer_size);
+    TEST_ASSERT_EQUAL(expected_device_size, device_size);
+    TEST_ASSERT_SUCCESS(calib_get_pubkey(other, g_tngtls_cert_def_3_device.private_key_slot, expected_key));
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, atcacert_get_subj_public_key(&g_tngtls_cert_def_3_device, device, device_size, key));
+    TEST_ASSERT_EQUAL_MEMORY(expected_key, key, sizeof(key));
+
+    /* Scratch too small for the device data */
+    signer_size = sizeof(signer);
+    device_size = sizeof(device);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BUFFER_TOO_SMALL, tng_atcacert_read_chain_ext(other, NULL, NULL, signer, &signer_size, device, &device_size,
+                                                                               scratch, 64));
+
+    TEST_ASSERT_SUCCESS(atcab_release_ext(&other));
+}
+
+TEST_GROUP_RUNNER(tng_atcacert_chain)
+{
+    RUN_TEST_CASE(tng_atcacert_chain, matches_sequential_reads);
+    RUN_TEST_CASE(tng_atcacert_chain, errors);
+    RUN_TEST_CASE(tng_atcacert_chain, other_device);
+}
+
+#endif